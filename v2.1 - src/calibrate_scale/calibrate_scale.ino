@@ -6,12 +6,22 @@
  * Realiza múltiples lecturas y calcula una nueva escala para la celda de carga, mostrando los 
  * resultados en el monitor serie.
  *
+ * Con CALIBRACION_MULTIPUNTO activado, se mide la báscula vacía y con varios pesos de referencia
+ * (PESOS_REFERENCIA), se ajusta una recta (cuentas = offset + factor * gramos) por mínimos cuadrados
+ * y el resultado se guarda directamente en la flash del Due y en la SD ('data/calib.dat'), donde
+ * lo lee smartcloth_v2 al arrancar (Scale_Calibration.h). La copia en la SD es necesaria porque
+ * la flash se borra al subir smartcloth_v2.
+ *
  * @author Irene Casares Rodríguez
  * @date 22/04/25
  */
 
 
 #include "HX711.h"
+#include <DueFlashStorage.h>
+#include <SD.h>
+
+#define CALIBRACION_MULTIPUNTO      // Comentar para usar el modo antiguo de un solo peso conocido
 
 
 // -------------------------------------------------------------------------------------------------------
@@ -40,6 +50,28 @@ float         medidas[MUESTRAS_CALIBRACION];
 int           contador_medidas = 0;
 unsigned long ultima_medicion = 0;
 bool          modo_calibracion = true;
+
+// Parámetros de la calibración multipunto
+const float PESOS_REFERENCIA[] = { 100.0, 226.0, 500.0 };      // Pesos de referencia en gramos (además de la báscula vacía)
+const byte  N_PESOS_REFERENCIA = sizeof(PESOS_REFERENCIA) / sizeof(PESOS_REFERENCIA[0]);
+const byte  LECTURAS_POR_PUNTO = 20;                            // Lecturas brutas promediadas en cada punto
+
+// Calibración guardada. Debe coincidir con 'calibracion_t' de Scale_Calibration.h (smartcloth_v2)
+#define SD_CARD_SCS                 13
+#define CALIBRACION_FLASH_ADDRESS   4
+#define CALIBRACION_MAGIC           0x53434C31  // "SCL1"
+char    fileCalibracion[30] = "data/calib.dat";
+
+typedef struct {
+    uint32_t  magic;
+    float     factor;
+    long      offset;
+    long      deriva;
+    uint16_t  nArranques;
+    uint16_t  checksum;
+} calibracion_t;
+
+DueFlashStorage dueFlashStorage;
 // -------------------------------------------------------------------------------------------------------
 
 
@@ -50,6 +82,11 @@ bool          modo_calibracion = true;
 void  setupScale();           // Configura la celda de carga
 float weighScale();           // Devuelve el peso en gramos 
 void  calcularNuevaEscala();  // Calcula la nueva escala
+void  calibracionMultipunto();          // Calibra con báscula vacía y varios pesos, y guarda el resultado
+long  medirPunto(float gramos);         // Pide colocar un peso y devuelve la media de sus lecturas brutas
+void  esperarEnter();                   // Espera a que se envíe una línea por el monitor serie
+void  guardarCalibracion(float factor, long offset);  // Guarda la calibración en flash y SD
+uint16_t checksumCalibracion(calibracion_t &cal);     // Fletcher-16 (igual que en Scale_Calibration.h)
 // -------------------------------------------------------------------------------------------------------
 
 
@@ -73,8 +110,13 @@ void setup()
 
   setupScale(); 
 
+#if defined(CALIBRACION_MULTIPUNTO)
+  if (!SD.begin(SD_CARD_SCS)) Serial.println("SD no disponible: la calibración solo se guardará en flash");
+  calibracionMultipunto();
+#else
   Serial.println("Coloque un objeto de peso conocido en la báscula");
   Serial.print("Peso de referencia: "); Serial.print(PESO_CONOCIDO); Serial.println(" g\n\n");
+#endif
 }
 // -------------------------------------------------------------------------------------------------------
 
@@ -91,6 +133,13 @@ void setup()
  */
 void loop()
 {
+#if defined(CALIBRACION_MULTIPUNTO)
+  // Tras calibrar, se muestra el peso con la nueva calibración para comprobarla
+  Serial.print("Peso: "); Serial.print(weighScale()); Serial.println(" g");
+  delay(TIEMPO_ENTRE_MEDICIONES);
+  return;
+#endif
+
   float peso = weighScale();
   Serial.print("\nPeso: "); Serial.print(peso); Serial.println(" g");
   
@@ -200,4 +249,147 @@ void calcularNuevaEscala()
   // Pequeña pausa para leer los resultados
   delay(3000);
 }
-// -------------------------------------------------------------------------------------------------------
\ No newline at end of file
+// -------------------------------------------------------------------------------------------------------
+
+
+
+// -------------------------------------------------------------------------------------------------------
+/**
+ * @brief Calibración multipunto.
+ * 
+ * Mide la báscula vacía y cada peso de PESOS_REFERENCIA, ajusta por mínimos cuadrados la recta
+ * 
+ *     cuentas = offset + factor * gramos
+ * 
+ * y guarda factor y offset en la flash y en la SD. También muestra el error de cada punto con la
+ * recta ajustada para comprobar la linealidad de la célula.
+ */
+void calibracionMultipunto()
+{
+  const byte N = N_PESOS_REFERENCIA + 1;
+  float gramos[N];
+  long  cuentas[N];
+
+  Serial.println("\n----- CALIBRACIÓN MULTIPUNTO -----");
+  gramos[0] = 0.0;
+  cuentas[0] = medirPunto(0.0);
+  for (byte i = 0; i < N_PESOS_REFERENCIA; i++) {
+    gramos[i+1] = PESOS_REFERENCIA[i];
+    cuentas[i+1] = medirPunto(PESOS_REFERENCIA[i]);
+  }
+
+  // Mínimos cuadrados (respecto a la primera medida para no perder precisión en float)
+  double mediaX = 0, mediaY = 0;
+  for (byte i = 0; i < N; i++) { mediaX += gramos[i]; mediaY += (double)(cuentas[i] - cuentas[0]); }
+  mediaX /= N;  mediaY /= N;
+
+  double sxy = 0, sxx = 0;
+  for (byte i = 0; i < N; i++) {
+    double dx = gramos[i] - mediaX;
+    sxy += dx * ((double)(cuentas[i] - cuentas[0]) - mediaY);
+    sxx += dx * dx;
+  }
+  float factor = sxy / sxx;
+  long  offset = cuentas[0] + (long)(mediaY - factor * mediaX);
+
+  Serial.println("\n----- RESULTADO DE CALIBRACIÓN -----");
+  Serial.print("Factor: "); Serial.println(factor, 4);
+  Serial.print("Offset: "); Serial.println(offset);
+  for (byte i = 0; i < N; i++) {
+    float estimado = (cuentas[i] - offset) / factor;
+    Serial.print("  "); Serial.print(gramos[i]); Serial.print(" g -> "); Serial.print(estimado, 2);
+    Serial.print(" g (error "); Serial.print(estimado - gramos[i], 2); Serial.println(" g)");
+  }
+
+  guardarCalibracion(factor, offset);
+
+  scale.set_scale(factor);
+  scale.set_offset(offset);
+  Serial.println("Nueva calibración aplicada a la báscula.");
+  Serial.println("-------------------------------\n");
+}
+// -------------------------------------------------------------------------------------------------------
+
+
+// -------------------------------------------------------------------------------------------------------
+/**
+ * @brief Pide colocar un peso en la báscula y devuelve la media de LECTURAS_POR_PUNTO lecturas brutas.
+ * @param gramos Peso a colocar (0 = báscula vacía)
+ * @return Media de las lecturas brutas
+ */
+long medirPunto(float gramos)
+{
+  if (gramos == 0.0) Serial.println("\nVacíe la báscula y pulse Enter");
+  else { Serial.print("\nColoque "); Serial.print(gramos); Serial.println(" g y pulse Enter"); }
+  esperarEnter();
+
+  long media = scale.read_average(LECTURAS_POR_PUNTO);
+  Serial.print("  Lectura bruta: "); Serial.println(media);
+  return media;
+}
+// -------------------------------------------------------------------------------------------------------
+
+
+// -------------------------------------------------------------------------------------------------------
+/**
+ * @brief Espera a que se envíe una línea (Enter) por el monitor serie.
+ */
+void esperarEnter()
+{
+  while (Serial.available()) Serial.read(); // Descartar lo que hubiera antes
+  while (!Serial.available()) delay(10);
+  delay(50);
+  while (Serial.available()) Serial.read();
+}
+// -------------------------------------------------------------------------------------------------------
+
+
+// -------------------------------------------------------------------------------------------------------
+/**
+ * @brief Guarda la calibración en la flash y una copia en la SD.
+ * 
+ * La deriva se reinicia a 0 porque la tara se acaba de medir.
+ * 
+ * @param factor Factor de calibración (cuentas por gramo)
+ * @param offset Tara (cuentas brutas con la báscula vacía)
+ */
+void guardarCalibracion(float factor, long offset)
+{
+  calibracion_t cal;
+  cal.magic = CALIBRACION_MAGIC;
+  cal.factor = factor;
+  cal.offset = offset;
+  cal.deriva = 0;
+  cal.nArranques = 0;
+  cal.checksum = checksumCalibracion(cal);
+
+  dueFlashStorage.write(CALIBRACION_FLASH_ADDRESS, (byte*)&cal, sizeof(calibracion_t));
+  Serial.println("Calibración guardada en flash");
+
+  SD.remove(fileCalibracion);
+  File myFile = SD.open(fileCalibracion, FILE_WRITE);
+  if (myFile) {
+    myFile.write((byte*)&cal, sizeof(calibracion_t));
+    myFile.close();
+    Serial.println("Calibración guardada en SD");
+  }
+  else Serial.println("No se pudo guardar la calibración en SD");
+}
+// -------------------------------------------------------------------------------------------------------
+
+
+// -------------------------------------------------------------------------------------------------------
+/**
+ * @brief Fletcher-16 de la calibración sin el campo 'checksum' (igual que en Scale_Calibration.h).
+ */
+uint16_t checksumCalibracion(calibracion_t &cal)
+{
+  uint16_t sum1 = 0, sum2 = 0;
+  byte *datos = (byte*)&cal;
+  for (uint16_t i = 0; i < offsetof(calibracion_t, checksum); i++) {
+    sum1 = (sum1 + datos[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+// -------------------------------------------------------------------------------------------------------
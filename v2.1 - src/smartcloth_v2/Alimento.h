@@ -43,7 +43,7 @@ class Alimento{
 
   private:
   
-    Grupo                 _grupo;             /**< Grupo al que pertenece el alimento */
+    const Grupo           *_grupo;            /**< Grupo al que pertenece el alimento (del catálogo o grupoBarcode) */
     float                 _peso;              /**< Peso del alimento */
     ValoresNutricionales  _valoresAlimento;   /**< Valores nutricionales del alimento */
 
@@ -68,7 +68,7 @@ class Alimento{
      * @param grupo Grupo al que pertenece el alimento
      * @param peso Peso del alimento
      */
-    Alimento(Grupo grupo, float peso); 
+    Alimento(const Grupo *grupo, float peso); 
 
 
 
@@ -81,14 +81,14 @@ class Alimento{
      * 
      * @param grupo Grupo al que pertenece el alimento
      */
-    inline void setGrupoAlimento(Grupo grupo){ _grupo = grupo; };
+    inline void setGrupoAlimento(const Grupo *grupo){ _grupo = grupo; };
 
     /**
      * @brief Obtiene el grupo al que pertenece el alimento.
      * 
      * @return El grupo al que pertenece el alimento
      */
-    inline Grupo getGrupoAlimento(){ return _grupo; };
+    inline const Grupo* getGrupoAlimento() const { return _grupo; };
     
 
 
@@ -108,7 +108,7 @@ class Alimento{
      * 
      * @return El peso del alimento
      */
-    inline float getPesoAlimento(){ return _peso; };
+    inline float getPesoAlimento() const { return _peso; };
 
 
 
@@ -122,21 +122,21 @@ class Alimento{
      * @param grupo Grupo al que pertenece el alimento
      * @param peso Peso del alimento
      */
-    void updateValoresAlimento(Grupo grupo, float peso);
+    void updateValoresAlimento(const Grupo *grupo, float peso);
 
     /**
      * @brief Establece los valores nutricionales del alimento a partir de un objeto ValoresNutricionales.
      * 
      * @param val Objeto ValoresNutricionales a partir del cual se establecen los valores
      */
-    inline void setValoresAlimento(ValoresNutricionales val){ _valoresAlimento.setValores(val); };
+    inline void setValoresAlimento(const ValoresNutricionales &val){ _valoresAlimento.setValores(val); };
 
     /**
      * @brief Obtiene los valores nutricionales del alimento.
      * 
      * @return Los valores nutricionales del alimento
      */
-    inline ValoresNutricionales getValoresAlimento(){ return _valoresAlimento; };
+    inline const ValoresNutricionales& getValoresAlimento() const { return _valoresAlimento; };
 
 };
 
@@ -154,9 +154,10 @@ class Alimento{
 // --------------------------------------------------------------------------------------------------------------------------
 
 /*---------------------------------------------------------------------------------------------------------
-   Alimento(): Constructor de la clase Alimento que establece su peso a 0.0
+   Alimento(): Constructor de la clase Alimento que establece su peso a 0.0 (sin grupo seleccionado)
 ----------------------------------------------------------------------------------------------------------*/
 Alimento::Alimento(){
+    setGrupoAlimento(&grupoNoSeleccionado);
     setPesoAlimento(0.0);
 }
 
@@ -168,7 +169,7 @@ Alimento::Alimento(){
               grupo - Grupo al que pertenece el alimento
               peso - Peso de la porción de alimento
 ----------------------------------------------------------------------------------------------------------*/
-Alimento::Alimento(Grupo grupo, float peso){
+Alimento::Alimento(const Grupo *grupo, float peso){
     setGrupoAlimento(grupo);
     setPesoAlimento(peso);
     updateValoresAlimento(grupo, peso);
@@ -188,20 +189,20 @@ Alimento::Alimento(Grupo grupo, float peso){
                             Los valores de macronutrientes los calcula multiplicando el peso del alimento 
                             por el valor/gr preestablecido para el macronutriente correspondiente.
 
-                            La clase 'ValoresNutricionales' se encarga internamente de calcular las raciones
-                            de macronutrientes a partir de sus valores en gramos.
+                            Es el único redondeo de los valores (a milésimas, en 'ValoresNutricionales'):
+                            las sumas en el plato, la comida y el diario ya son exactas. Las raciones se
+                            calculan al pedirlas.
 
           Parámetros: 
                   grupo - Grupo al que pertenece el alimento
                   peso - Peso de la porción de alimento
 ----------------------------------------------------------------------------------------------------------*/
-void Alimento::updateValoresAlimento(Grupo grupo, float peso){
-    float carb = grupo.Carb_g * peso;
-    float lip = grupo.Lip_g * peso;
-    float prot = grupo.Prot_g * peso;
-    float kcal = grupo.Kcal_g * peso;
-    ValoresNutricionales valAux(carb, lip, prot, kcal);
-    setValoresAlimento(valAux); 
+void Alimento::updateValoresAlimento(const Grupo *grupo, float peso){
+    float carb = grupo->Carb_g * peso;
+    float lip = grupo->Lip_g * peso;
+    float prot = grupo->Prot_g * peso;
+    float kcal = grupo->Kcal_g * peso;
+    _valoresAlimento.setValores(carb, lip, prot, kcal);
 }
 
 
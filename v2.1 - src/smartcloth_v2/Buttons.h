@@ -74,6 +74,7 @@
 #define BUTTONS_H
 
 #include "debug.h" // SM_DEBUG --> SerialPC
+#include "Debug_Log.h" // LOG_SM()
 
 
 
@@ -162,9 +163,9 @@ void checkAllButtons()
     // Ignorar todas las pulsaciones durante los primeros 0.5 segundos tras el setup 
     if (!systemStabilized && (millis() - startupTime < 500)) {
         // Reiniciar todos los botones
-        buttonMain = 0;
-        pulsandoBarcode = false;
-        pulsandoGrande = false;
+        vaciarCola(colaMain);
+        vaciarCola(colaBarcode);
+        vaciarCola(colaGrande);
         return; // No procesar ningún botón durante el periodo de estabilización
     } else if (!systemStabilized) {
         systemStabilized = true; // Marcar el sistema como estabilizado después del periodo inicial
@@ -234,7 +235,8 @@ void checkAllButtons()
  *      Si el grupo está entre [7, 9] o [16, 19], se considera TIPO_A (necesita diferenciar entre crudo y cocinado).
  *      Si el grupo está entre [1, 6], [10, 15] o [20], se considera TIPO_B.
  * 
- *  Reestablece la flag 'pulsandoGrande' a false hasta la próxima pulsación.
+ *  Atiende todas las pulsaciones pendientes en 'colaGrande'. La tecla se lee de la matriz al
+ *  sacar la pulsación de la cola, así que debe seguir pulsada (como antes con la flag).
  * 
  *  @note Para la funcionalidad de borrar los ficheros del usuario, en determinados casos se marcará el evento DELETE_FILES
  *        en lugar del TIPO_B correspondiente a los botones de grupo 1 y 20 (usados en la combinación de borrado).
@@ -242,15 +244,13 @@ void checkAllButtons()
 /*-----------------------------------------------------------------------------*/
 void checkGrandeButton()
 {
-    if(grandeButtonInterruptOccurred()) // Se está pulsando un grupo de alimentos
+    eventoCola_t pulsacion;
+    while(popCola(colaGrande, pulsacion)) // Se está pulsando un grupo de alimentos
     {
         readButtonsGrande(); // Qué tecla se está pulsando 
         buttonGrande = buttons[iRow][iCol];
 
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("\n\n----------------------------------------------------------------------------------------------------"));       
-            SerialPC.print(F("Boton pulsado (grupo): ")); SerialPC.println(buttonGrande); 
-        #endif 
+        LOG_SM(LOG_BOTON_GRUPO, buttonGrande);
         
         // ----- ANALIZAR EVENTO --------------
         // TIPO_A (necesita crudo/cocinado): [7, 9] o [16, 19] 
@@ -259,14 +259,14 @@ void checkGrandeButton()
 
         if(((state_actual == STATE_CANCEL) && (buttonGrande == 1)) || ((state_actual == STATE_DELETE_FILES_CHECK) && (buttonGrande == 20)))
         {
-            addEventToBuffer(DELETE_FILES); // Evento de borrar ficheros del usuario
+            addEventoExterno(DELETE_FILES, pulsacion.tiempo); // Evento de borrar ficheros del usuario
         }
         else // Si estamos en STATE_CANCEL y se pulsa otra cosa, saltará error porque no hay regla para eso, pero externamente no se verá, solo en debug
         {    // Si estamos en STATE_DELETE_FILES_CHECK y se pulsa grupo distinto de 20, se marcará TIPO_A o TIPO_B y se cancelará el borrado, como marcan las reglas de transición
             if (isButtonGrandeTipoA()) eventoGrande = TIPO_A; // Grupo A (necesita crudo/cocinado)
             else eventoGrande = TIPO_B;  // Grupo B (no necesita crudo/cocinado pero se permite "escoger" de forma ficticia)  
             
-            addEventToBuffer(eventoGrande); // Evento de grupo de alimentos
+            addEventoExterno(eventoGrande, pulsacion.tiempo); // Evento de grupo de alimentos
 
             // ----- Actualizar grupo alimentos ----
             setGrupoAlimentos(buttonGrande);
@@ -274,8 +274,6 @@ void checkGrandeButton()
 
         flagEvent = true; // Activar flag de evento
         // ------------------------------------
-        
-        pulsandoGrande = false; // Reiniciar la flag de pulsación en la botonera
 
     }
         
@@ -295,8 +293,8 @@ void checkGrandeButton()
  *  crudo o cocinado porque sus valores nutricionales son diferentes según el caso. 
  *  Para los de TIPO_B no importa si los cocinas o no.
  * 
- *  Añade el evento correspondiente al búfer de eventos y reestablece la 
- *  flag 'pulsandoGrande' a false.
+ *  Añade el evento correspondiente a la cola de eventos por cada pulsación pendiente
+ *  en 'colaMain', en el orden en que ocurrieron.
  */
 /*-----------------------------------------------------------------------------*/
 void checkMainButton()
@@ -317,9 +315,10 @@ void checkMainButton()
     // si el alimento está crudo o cocinado.
     //
 
-    if(mainButtonInterruptOccurred()) // Se está pulsando un botón de la botonera principal
+    eventoCola_t pulsacion;
+    while(popCola(colaMain, pulsacion)) // Se está pulsando un botón de la botonera principal
     {
-        switch (buttonMain) 
+        switch (pulsacion.codigo) 
         {
             // Se comprueba el último eventoGrande para saber si el buttonGrande es tipo A o B, pero también se podría hacer isButtonGrandeTipoA()
             // Da igual que se pulsen varias veces seguidas COCINADO, no se irá sumando 20 cada vez al buttonGrande, sino que siempre se pasará
@@ -332,15 +331,10 @@ void checkMainButton()
             case 5:   eventoMain = GUARDAR;         break;  
         }
 
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("\n\n----------------------------------------------------------------------------------------------------"));       
-            SerialPC.print(F("Boton pulsado (accion): ")); printEventName(eventoMain); SerialPC.println();
-        #endif 
+        LOG_SM(LOG_BOTON_ACCION, eventoMain);
         
-        addEventToBuffer(eventoMain);
+        addEventoExterno(eventoMain, pulsacion.tiempo);
         flagEvent = true;
-
-        buttonMain = 0; // "Desactivar" el botón pulsado. Si usáramos 5 variables booleanas, pondríamos a false la correspondiente.
     }
 
 }
@@ -353,28 +347,24 @@ void checkMainButton()
 /**
  * @brief Verifica si se ha pulsado el botón de código de barras.
  * 
- *      Comprueba si se ha pulsado el botón de código de barras, indica el evento correspondiente.
- *      y desactiva la flag 'pulsandoBarcode' hasta la próxima pulsación.
+ *      Comprueba si se ha pulsado el botón de código de barras e indica el evento correspondiente
+ *      por cada pulsación pendiente en 'colaBarcode'.
  */
 /*-----------------------------------------------------------------------------*/
 void checkBarcodeButton()
 {
-    if(barcodeButtonInterruptOccurred()) // Se está pulsando el botón de código de barras
+    eventoCola_t pulsacion;
+    while(popCola(colaBarcode, pulsacion)) // Se está pulsando el botón de código de barras
     {
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("\n\n----------------------------------------------------------------------------------------------------"));       
-            SerialPC.println(F("Boton pulsado: BARCODE"));
-        #endif 
+        LOG_SM(LOG_BOTON_BARCODE);
         
-        addEventToBuffer(BARCODE);
+        addEventoExterno(BARCODE, pulsacion.tiempo);
         flagEvent = true;
 
         // Se actualizará 'grupoActual' si se lee barcode, se encuentra el producto y se confirma. 
         // Si se hiciera setGrupoAlimentos(BARCODE_PRODUCT_INDEX) aquí y luego no se encontrara el producto,
         // se mostraría en pantalla "Grupo Actual: " con el nombre vacío porque no se ha obtenido nada. Por eso
         // solo se actualiza si se encuentra producto.
-        
-        pulsandoBarcode = false; // Reiniciar flag
     }
 
 }
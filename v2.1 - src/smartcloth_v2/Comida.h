@@ -58,7 +58,7 @@ class Comida{
      * 
      * @return El número de platos de la comida
      */
-    inline byte _getNumPlatos(){ return _nPlatos; };
+    inline byte _getNumPlatos() const { return _nPlatos; };
   
   
 
@@ -87,7 +87,7 @@ class Comida{
     //inline bool isComidaEmpty(){ return _getNumPlatos() == 0; }; 
     // Creo que la mejor forma de comprobar si la comida está vacía es comprobando si el peso es 0.0
     // ya que la comida como mínimo tendrá 1 plato (he modificado para que el número de platos al inicio sea 1 por defecto)
-    inline bool isComidaEmpty(){ return getPesoComida() == 0.0; };
+    inline bool isComidaEmpty() const { return getPesoComida() == 0.0; };
 
 
 
@@ -107,7 +107,7 @@ class Comida{
      * 
      * @return El peso total de la comida
      */
-    inline float getPesoComida(){ return _peso; }; 
+    inline float getPesoComida() const { return _peso; }; 
 
 
 
@@ -120,7 +120,7 @@ class Comida{
      * 
      * @param alimento Objeto Alimento a agregar
      */
-    void addAlimentoComida(Alimento &alimento); 
+    void addAlimentoComida(const Alimento &alimento); 
 
 
 
@@ -133,14 +133,14 @@ class Comida{
      * 
      * @param plato Objeto Plato a agregar
      */
-    void addPlato(Plato plato);
+    void addPlato(const Plato &plato);
     
     /**
      * @brief Elimina un plato de la comida (solo el plato actual).
      * 
      * @param plato Plato a eliminar
      */
-    void deletePlato(Plato &plato); 
+    void deletePlato(const Plato &plato); 
 
 
 
@@ -153,14 +153,14 @@ class Comida{
      * 
      * @param val Objeto ValoresNutricionales a partir del cual se establecen los valores
      */
-    inline void setValoresComida(ValoresNutricionales val){ _valoresComida.setValores(val); };
+    inline void setValoresComida(const ValoresNutricionales &val){ _valoresComida.setValores(val); };
     
     /**
      * @brief Obtiene los valores nutricionales totales de la comida. 
      * 
      * @return Los valores nutricionales de la comida
      */
-    inline ValoresNutricionales getValoresComida(){ return _valoresComida; }; 
+    inline const ValoresNutricionales& getValoresComida() const { return _valoresComida; }; 
 
     /**
      * @brief Actualiza los valores nutricionales de la comida.
@@ -168,7 +168,7 @@ class Comida{
      * @param suma True si se quieren sumar los valores nutricionales (al agregar alimento), False si se quieren restar (al eliminar plato)
      * @param val Valores nutricionales con los que actualizar la comida
      */
-    void updateValoresComida(bool suma, ValoresNutricionales val); 
+    void updateValoresComida(bool suma, const ValoresNutricionales &val); 
 
 
 
@@ -180,7 +180,7 @@ class Comida{
      * @brief Copiar los valores de un objeto 'Comida' (valores nutricionales, platos y peso) en el objeto Comida tratado.
      * @param comida Objeto Comida a copiar
      */
-    void copyComida(Comida comida); 
+    void copyComida(const Comida &comida); 
 
     /**
      * @brief "Reinicia" la comida, eliminando todos los platos y reiniciando los valores nutricionales.
@@ -248,7 +248,7 @@ Comida::Comida(){
                   alimento - Objeto Alimento con la información nutricional y peso de la porción del 
                              alimento pesado.
 ----------------------------------------------------------------------------------------------------------*/
-void Comida::addAlimentoComida(Alimento &alimento){   
+void Comida::addAlimentoComida(const Alimento &alimento){   
     setPesoComida(getPesoComida() + alimento.getPesoAlimento());       // Incrementar peso de la comida
     updateValoresComida(true, alimento.getValoresAlimento());                // Sumar (suma = true) Valores Nutricionales de la comida
 }
@@ -267,8 +267,7 @@ void Comida::addAlimentoComida(Alimento &alimento){
           Parámetros: 
                   plato - Objeto Plato oficialmente "guardado".
 ----------------------------------------------------------------------------------------------------------*/
-void Comida::addPlato(Plato plato){
-//void Comida::addPlato(Plato &plato){
+void Comida::addPlato(const Plato &/*plato*/){
   // En realidad no hace falta guardar el objeto plato porque sus elementos
   // (valores nutricionales y peso de los alimentos) se han ido guardando uno a
   // uno. Solo haría falta aumentar el número de platos para indicar que se ha "guardado"
@@ -288,7 +287,7 @@ void Comida::addPlato(Plato plato){
           Parámetros: 
                   plato - Objeto Plato a borrar
 ----------------------------------------------------------------------------------------------------------*/
-void Comida::deletePlato(Plato &plato){
+void Comida::deletePlato(const Plato &plato){
        // No hace falta decrementar nPlatos porque no se ha llegado a guardar 
        // el plato ni, por tanto, incrementar el numero platos. 
     setPesoComida(getPesoComida() - plato.getPesoPlato());          // Decrementar peso de la comida según peso del plato
@@ -311,22 +310,9 @@ void Comida::deletePlato(Plato &plato){
                   suma - true: sumar valores    false: restar valores
                   val - Valores nutricionales del alimento pesado o del plato a eliminar
 ----------------------------------------------------------------------------------------------------------*/
-void Comida::updateValoresComida(bool suma, ValoresNutricionales val){
-    float carb, lip, prot, kcal;
-    if(suma){        // Añadir alimento
-        carb = _valoresComida.getCarbValores() + val.getCarbValores();
-        lip = _valoresComida.getLipValores() + val.getLipValores();
-        prot = _valoresComida.getProtValores() + val.getProtValores();
-        kcal = _valoresComida.getKcalValores() + val.getKcalValores();
-    }
-    else{            // Eliminar plato 
-        carb = _valoresComida.getCarbValores() - val.getCarbValores();
-        lip = _valoresComida.getLipValores() - val.getLipValores();
-        prot = _valoresComida.getProtValores() - val.getProtValores();
-        kcal = _valoresComida.getKcalValores() - val.getKcalValores();
-    }
-    ValoresNutricionales valAux(carb, lip, prot, kcal);
-    setValoresComida(valAux);
+void Comida::updateValoresComida(bool suma, const ValoresNutricionales &val){
+    if(suma) _valoresComida.sumar(val);     // Añadir alimento
+    else _valoresComida.restar(val);        // Eliminar plato 
 }
 
 
@@ -342,7 +328,7 @@ void Comida::updateValoresComida(bool suma, ValoresNutricionales val){
                  los valores guardados, pero se quiere mostrar la información guardada al usuario para que la
                  pueda analizar.
 ----------------------------------------------------------------------------------------------------------*/
-void Comida::copyComida(Comida comida){
+void Comida::copyComida(const Comida &comida){
     _setNumPlatos(comida._getNumPlatos());          // Nº platos 
     setPesoComida(comida.getPesoComida());          // Peso
     setValoresComida(comida.getValoresComida());    // Valores 
@@ -357,8 +343,7 @@ void Comida::copyComida(Comida comida){
 void Comida::restoreComida(){
     _setNumPlatos(0);                 // Nº platos = 0
     setPesoComida(0.0);               // Peso = 0.0
-    ValoresNutricionales valAux;            // Crea un objeto ValoresNutricionales con todos sus valores a 0.0
-    setValoresComida(valAux);         // Valores = 0.0
+    _valoresComida.setValoresMilesimas(0, 0, 0, 0);  // Valores = 0
 }
 
 
@@ -373,10 +358,16 @@ void Comida::restoreComida(){
                          incluye el peso
 ----------------------------------------------------------------------------------------------------------*/
 String Comida::getComidaAllValues(){
-    String dataString = String(_valoresComida.getCarbValores()) + ";" + String(_valoresComida.getCarbRaciones()) + ";" + 
-                        String(_valoresComida.getLipValores()) + ";" + String(_valoresComida.getLipRaciones()) + ";" + 
-                        String(_valoresComida.getProtValores()) + ";" + String(_valoresComida.getProtRaciones()) + ";" + 
-                        String(_valoresComida.getKcalValores()); 
+    char carb[LONGITUD_TEXTO_MILESIMAS], lip[LONGITUD_TEXTO_MILESIMAS], prot[LONGITUD_TEXTO_MILESIMAS], kcal[LONGITUD_TEXTO_MILESIMAS];
+    textoMilesimas(carb, _valoresComida.getCarbMilesimas(), DECIMALES_CSV);
+    textoMilesimas(lip, _valoresComida.getLipMilesimas(), DECIMALES_CSV);
+    textoMilesimas(prot, _valoresComida.getProtMilesimas(), DECIMALES_CSV);
+    textoMilesimas(kcal, _valoresComida.getKcalMilesimas(), DECIMALES_CSV);
+
+    String dataString = String(carb) + ";" + String(_valoresComida.getCarbRaciones()) + ";" + 
+                        String(lip) + ";" + String(_valoresComida.getLipRaciones()) + ";" + 
+                        String(prot) + ";" + String(_valoresComida.getProtRaciones()) + ";" + 
+                        String(kcal); 
 
     return dataString;
 }
@@ -388,10 +379,16 @@ String Comida::getComidaAllValues(){
                          el caracter '&' para poderlos insertar en la petición HTTP POST del esp32 directamente.
 ----------------------------------------------------------------------------------------------------------*/
 String Comida::getComidaAllValuesHttpRequest(){
-    String dataString = "&carb=" + String(_valoresComida.getCarbValores()) + "&carb_R=" + String(_valoresComida.getCarbRaciones()) + "&lip=" + 
-                        String(_valoresComida.getLipValores()) + "&lip_R=" + String(_valoresComida.getLipRaciones()) + "&prot=" + 
-                        String(_valoresComida.getProtValores()) + "&prot_R" + String(_valoresComida.getProtRaciones()) + "&kcal" + 
-                        String(_valoresComida.getKcalValores()) + "&peso=" + String(getPesoComida()); 
+    char carb[LONGITUD_TEXTO_MILESIMAS], lip[LONGITUD_TEXTO_MILESIMAS], prot[LONGITUD_TEXTO_MILESIMAS], kcal[LONGITUD_TEXTO_MILESIMAS];
+    textoMilesimas(carb, _valoresComida.getCarbMilesimas(), DECIMALES_CSV);
+    textoMilesimas(lip, _valoresComida.getLipMilesimas(), DECIMALES_CSV);
+    textoMilesimas(prot, _valoresComida.getProtMilesimas(), DECIMALES_CSV);
+    textoMilesimas(kcal, _valoresComida.getKcalMilesimas(), DECIMALES_CSV);
+
+    String dataString = "&carb=" + String(carb) + "&carb_R=" + String(_valoresComida.getCarbRaciones()) + "&lip=" + 
+                        String(lip) + "&lip_R=" + String(_valoresComida.getLipRaciones()) + "&prot=" + 
+                        String(prot) + "&prot_R" + String(_valoresComida.getProtRaciones()) + "&kcal" + 
+                        String(kcal) + "&peso=" + String(getPesoComida()); 
 
     return dataString;
 }
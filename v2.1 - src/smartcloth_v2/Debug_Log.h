@@ -0,0 +1,189 @@
+/**
+ * @file Debug_Log.h
+ * @brief Log de depuración binario con formato diferido: el Due solo envía el ID del mensaje y sus
+ *        argumentos, y el texto se reconstruye en el PC (tools/debug_log)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Con SM_DEBUG, cada evento imprimía varias líneas por SerialPC a 115200 baudios. SerialPC.print()
+ * bloquea en cuanto se llena el buffer de transmisión del UART, así que cada evento tardaba decenas
+ * de ms más que sin SM_DEBUG y la versión de depuración no se comportaba como la final.
+ *
+ * Ahora las funciones más frecuentes (botoneras, báscula, cola de eventos, transiciones y mensajes
+ * con el ESP32) llaman a LOG_SM(ID, argumentos...), que solo copia en un buffer circular de RAM:
+ *
+ *      [0xFE] [ID: 2 bytes] [millis(): 4 bytes] [argumentos]
+ *
+ * Cada argumento numérico ocupa 4 bytes (los float se copian tal cual) y cada texto, 1 byte de
+ * longitud y hasta LOG_MAX_TEXTO caracteres. Los textos de formato están en Log_Diccionario.h y en
+ * el Due solo se compilan sus ID, no ocupan flash. vaciarLog() envía por SerialPC solo los registros
+ * que caben enteros en el buffer del UART, sin esperar; lo llama el loop con TAREA_LOG (Scheduler.h).
+ * Nunca deja un registro a medias: un SerialPC.print() de texto entre dos TAREA_LOG caería dentro de
+ * él y el decodificador leería el texto como sus argumentos. Para eso, en el buffer de RAM cada
+ * registro va precedido de su longitud (1 byte, que no se envía).
+ *
+ * El resto de mensajes (arranque, SD, pantallas) siguen siendo texto por SerialPC, que el
+ * decodificador deja pasar tal cual: 0xFE no aparece nunca en texto ASCII ni UTF-8. Como los
+ * registros binarios salen más tarde que el texto, el orden entre unos y otros puede cambiar; el
+ * tiempo de cada registro es el del momento en que se generó.
+ *
+ * Los registros solo se añaden desde el loop (nunca desde una ISR). Si el buffer está lleno, se
+ * descartan y se envía un LOG_PERDIDOS con cuántos en cuanto vuelve a haber sitio.
+ *
+ * Sin SM_DEBUG, LOG_SM() no genera código.
+ */
+
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC
+#include "Log_Diccionario.h"
+
+
+#if defined(SM_DEBUG)
+
+#define LOG_SINCRONIA       0xFE        // Primer byte de cada registro
+#define LOG_BUFFER_SIZE     2048        // Potencia de 2
+#define LOG_BUFFER_MASK     (LOG_BUFFER_SIZE - 1)
+#define LOG_MAX_TEXTO       40          // Los textos más largos se recortan
+#define LOG_MAX_REGISTRO    120         // Bytes de un registro como máximo: tiene que caber en el buffer de TX del UART vacío (127 en el Due)
+
+#define LOG_SM(id, ...)     logBinario(id, ##__VA_ARGS__)
+
+
+// ------ ESTADO DEL LOG ---------------------------------------------------------
+byte            bufferLog[LOG_BUFFER_SIZE];
+uint16_t        headLog = 0;                // Próxima posición a escribir
+uint16_t        tailLog = 0;                // Próxima posición a enviar
+unsigned long   registrosLogPerdidos = 0;   // Descartados desde el último LOG_PERDIDOS
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+inline uint16_t libreLog(){ return (tailLog - headLog - 1) & LOG_BUFFER_MASK; };            // Bytes libres en el buffer
+inline void     ponerByteLog(byte b){ bufferLog[headLog] = b; headLog = (headLog + 1) & LOG_BUFFER_MASK; };
+inline void     ponerU32Log(uint32_t v){ for(byte i = 0; i < 4; i++){ ponerByteLog(v & 0xFF); v >>= 8; } };
+
+// Tamaño y copia de cada tipo de argumento
+template<class T> inline uint16_t tamArgLog(const T &){ return 4; };
+inline uint16_t tamArgLog(const char *s){ return 1 + min(strlen(s), (size_t)LOG_MAX_TEXTO); };
+inline uint16_t tamArgLog(const String &s){ return 1 + min((size_t)s.length(), (size_t)LOG_MAX_TEXTO); };
+
+template<class T> inline void ponerArgLog(const T &v){ ponerU32Log((uint32_t)v); };
+inline void     ponerArgLog(float v){ uint32_t u; memcpy(&u, &v, 4); ponerU32Log(u); };
+inline void     ponerArgLog(double v){ ponerArgLog((float)v); };
+void            ponerTextoLog(const char *s, size_t n);
+inline void     ponerArgLog(const char *s){ ponerTextoLog(s, strlen(s)); };
+inline void     ponerArgLog(char *s){ ponerTextoLog(s, strlen(s)); };
+inline void     ponerArgLog(const String &s){ ponerTextoLog(s.c_str(), s.length()); };
+
+inline uint16_t tamArgsLog(){ return 0; };
+template<class T, class... R> inline uint16_t tamArgsLog(const T &v, const R&... resto){ return tamArgLog(v) + tamArgsLog(resto...); };
+inline void     ponerArgsLog(){};
+template<class T, class... R> inline void ponerArgsLog(const T &v, const R&... resto){ ponerArgLog(v); ponerArgsLog(resto...); };
+
+template<class... A> void logBinario(uint16_t id, const A&... args);                        // Añadir un registro al buffer
+void            vaciarLog();                                                                // Enviar por SerialPC lo que quepa sin bloquear
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Copia un texto al buffer con su longitud delante (recortado a LOG_MAX_TEXTO).
+ */
+/*-----------------------------------------------------------------------------*/
+void ponerTextoLog(const char *s, size_t n)
+{
+    if(n > LOG_MAX_TEXTO) n = LOG_MAX_TEXTO;
+    ponerByteLog(n);
+    for(size_t i = 0; i < n; i++) ponerByteLog(s[i]);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade un registro al buffer, precedido de su longitud. Si no cabe, se descarta y se cuenta.
+ * @param id    ID del mensaje en Log_Diccionario.h
+ * @param args  Argumentos en el orden del formato
+ */
+/*-----------------------------------------------------------------------------*/
+template<class... A> void logBinario(uint16_t id, const A&... args)
+{
+    const uint16_t tamCabecera = 7;
+    uint16_t tamPerdidos = registrosLogPerdidos ? (1 + tamCabecera + 4) : 0;
+    uint16_t tam = tamCabecera + tamArgsLog(args...);
+
+    if((tam > LOG_MAX_REGISTRO) or (libreLog() < (tamPerdidos + 1 + tam))){ registrosLogPerdidos++; return; }
+
+    uint32_t ahora = millis();
+    if(registrosLogPerdidos)
+    {
+        ponerByteLog(tamCabecera + 4);
+        ponerByteLog(LOG_SINCRONIA); ponerByteLog(LOG_PERDIDOS & 0xFF); ponerByteLog(LOG_PERDIDOS >> 8);
+        ponerU32Log(ahora);
+        ponerU32Log(registrosLogPerdidos);
+        registrosLogPerdidos = 0;
+    }
+
+    ponerByteLog(tam);
+    ponerByteLog(LOG_SINCRONIA); ponerByteLog(id & 0xFF); ponerByteLog(id >> 8);
+    ponerU32Log(ahora);
+    ponerArgsLog(args...);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Envía por SerialPC los registros pendientes que caben enteros en el buffer de transmisión
+ *        del UART, sin esperar a que se vacíe. Se para en el primero que no cabe, que se envía en
+ *        la siguiente TAREA_LOG.
+ */
+/*-----------------------------------------------------------------------------*/
+void vaciarLog()
+{
+    while(tailLog != headLog)
+    {
+        uint16_t n = bufferLog[tailLog];   // Longitud del registro
+        if(SerialPC.availableForWrite() < (int)n) return;
+
+        uint16_t inicio = (tailLog + 1) & LOG_BUFFER_MASK;
+        uint16_t contiguos = min(n, (uint16_t)(LOG_BUFFER_SIZE - inicio));
+        SerialPC.write(&bufferLog[inicio], contiguos);
+        if(contiguos < n) SerialPC.write(bufferLog, n - contiguos); // El registro da la vuelta al buffer
+        tailLog = (inicio + n) & LOG_BUFFER_MASK;
+    }
+}
+
+
+#else
+
+#define LOG_SM(id, ...)
+inline void vaciarLog(){};
+
+#endif // SM_DEBUG
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
@@ -93,7 +93,7 @@ class Diario{
      * 
      * @return El peso total del diario
      */
-    inline float getPesoDiario(){ return _peso; };
+    inline float getPesoDiario() const { return _peso; };
 
 
     // ----------------------------------------------------------------------
@@ -105,7 +105,7 @@ class Diario{
      * 
      * @param comida Objeto Comida a agregar
      */
-    void addComida(Comida comida);      
+    void addComida(const Comida &comida);      
 
 
     // ----------------------------------------------------------------------
@@ -117,21 +117,21 @@ class Diario{
      * 
      * @param val Objeto ValoresNutricionales a partir del cual se establecen los valores
      */
-    void setValoresDiario(ValoresNutricionales val){ _valoresDiario.setValores(val); };
+    void setValoresDiario(const ValoresNutricionales &val){ _valoresDiario.setValores(val); };
     
     /**
      * @brief Obtiene los valores nutricionales del diario.
      * 
      * @return Los valores nutricionales del diario
      */
-    inline ValoresNutricionales getValoresDiario(){ return _valoresDiario; };
+    inline const ValoresNutricionales& getValoresDiario() const { return _valoresDiario; };
 
     /**
      * @brief Actualiza los valores nutricionales del diario.
      * 
      * @param val Valores nutricionales con los que actualizar el diario
      */
-    void updateValoresDiario(ValoresNutricionales val);
+    void updateValoresDiario(const ValoresNutricionales &val);
 
 };
 
@@ -171,7 +171,7 @@ Diario::Diario(){
           Parámetros: 
                   comida - Objeto Comida con la información nutricional y peso de la comida guardada.
 ----------------------------------------------------------------------------------------------------------*/
-void Diario::addComida(Comida comida){
+void Diario::addComida(const Comida &comida){
   setNumComidas(getNumComidas()+1);                           // Incrementar num comidas
   setPesoDiario(getPesoDiario() + comida.getPesoComida());    // Incrementar peso
   updateValoresDiario(comida.getValoresComida());                   // Actualizar Valores Nutricionales
@@ -186,18 +186,16 @@ void Diario::addComida(Comida comida){
 
 /*---------------------------------------------------------------------------------------------------------
    updateValoresDiario(): Actualiza los valores nutricionales del acumulado diario sumando los que ya tuviera 
-                          con los pasados como argumento, correspondientes a la comida guardada. 
+                          con los pasados como argumento, correspondientes a la comida guardada. Se suman
+                          redondeados a DECIMALES_CSV, como se han escrito en el CSV.
 
           Parámetros: 
                   val - Valores nutricionales de la comida guardada
 ----------------------------------------------------------------------------------------------------------*/
-void Diario::updateValoresDiario(ValoresNutricionales val){
-  float carb = _valoresDiario.getCarbValores() + val.getCarbValores();
-  float lip = _valoresDiario.getLipValores() + val.getLipValores();
-  float prot = _valoresDiario.getProtValores() + val.getProtValores();
-  float kcal = _valoresDiario.getKcalValores() + val.getKcalValores();
-  ValoresNutricionales valAux(carb, lip, prot, kcal);
-  setValoresDiario(valAux);
+void Diario::updateValoresDiario(const ValoresNutricionales &val){
+  ValoresNutricionales guardada(val);
+  guardada.redondear(DECIMALES_CSV);    // Como se ha escrito en el CSV, para que sea el mismo acumulado que al leerlo tras reiniciar
+  _valoresDiario.sumar(guardada);
 }
 
 
@@ -0,0 +1,118 @@
+/**
+ * @file Event_Queue.h
+ * @brief Colas de eventos sin bloqueo entre las ISR y el loop
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Cola circular de un solo productor y un solo consumidor (SPSC): el productor (una ISR
+ * o una función del loop) solo escribe 'head' y el consumidor (el loop) solo escribe
+ * 'tail'. Ambos índices son de tipo byte, cuya escritura es atómica en el Cortex-M3, así
+ * que no hace falta desactivar las interrupciones. Es el mismo esquema que el buffer de
+ * muestras de HX711_Sampler.h.
+ *
+ * Se usa una cola por cada fuente de interrupción (botonera main, botonera grande y botón
+ * barcode) y otra para los eventos de la Máquina de Estados, que el loop vacía entera en
+ * cada ciclo evaluando los eventos en el orden en que ocurrieron. Así dos eventos del
+ * mismo ciclo de 50 ms (p. ej. una pulsación y un INCREMENTO) ya no se pisan.
+ *
+ * Cada elemento guarda el millis() en que ocurrió, para medir la latencia hasta que se evalúa.
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+
+#define COLA_EVENTOS_SIZE   16      // Potencia de 2. Con el debounce de 300 ms, 16 pulsaciones son varios segundos de loop bloqueado
+#define COLA_EVENTOS_MASK   (COLA_EVENTOS_SIZE - 1)
+
+
+// ------ COLA DE EVENTOS -------------------------------------------------------
+typedef struct {
+    byte            codigo;     // Botón pulsado (colas de las ISR) o event_t (cola de la Máquina de Estados)
+    unsigned long   tiempo;     // millis() en que ocurrió
+} eventoCola_t;
+
+typedef struct {
+    volatile eventoCola_t   elementos[COLA_EVENTOS_SIZE];
+    volatile byte           head;       // Siguiente posición a escribir (solo la modifica el productor)
+    volatile byte           tail;       // Siguiente posición a leer (solo la modifica el consumidor)
+    volatile unsigned long  perdidos;   // Elementos descartados por cola llena (solo lo modifica el productor)
+} colaEventos_t;
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+inline bool     isColaVacia(colaEventos_t &cola){ return cola.head == cola.tail; };    // Comprobar si hay elementos pendientes
+bool            pushCola(colaEventos_t &cola, byte codigo, unsigned long tiempo);       // Añadir elemento (productor)
+bool            popCola(colaEventos_t &cola, eventoCola_t &elemento);                  // Sacar el elemento más antiguo (consumidor)
+inline void     vaciarCola(colaEventos_t &cola){ cola.tail = cola.head; };             // Descartar los elementos pendientes (consumidor)
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade un elemento a la cola. Solo debe llamarla el productor de esa cola.
+ * @param cola Cola
+ * @param codigo Botón pulsado o evento
+ * @param tiempo millis() en que ocurrió
+ * @return 'false' si la cola estaba llena y el elemento se ha descartado
+ */
+/*-----------------------------------------------------------------------------*/
+bool pushCola(colaEventos_t &cola, byte codigo, unsigned long tiempo)
+{
+    byte head = cola.head;
+    byte nextHead = (head + 1) & COLA_EVENTOS_MASK;
+    if(nextHead == cola.tail){ cola.perdidos++; return false; } // Llena
+
+    cola.elementos[head].codigo = codigo;
+    cola.elementos[head].tiempo = tiempo;
+    cola.head = nextHead; // Publicar el elemento después de escribirlo
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Saca el elemento más antiguo de la cola. Solo debe llamarla el consumidor de esa cola.
+ * @param cola Cola
+ * @param elemento Elemento sacado
+ * @return 'false' si la cola está vacía
+ */
+/*-----------------------------------------------------------------------------*/
+bool popCola(colaEventos_t &cola, eventoCola_t &elemento)
+{
+    byte tail = cola.tail;
+    if(tail == cola.head) return false; // Vacía
+
+    elemento.codigo = cola.elementos[tail].codigo;
+    elemento.tiempo = cola.elementos[tail].tiempo;
+    cola.tail = (tail + 1) & COLA_EVENTOS_MASK; // Liberar el hueco después de leerlo
+    return true;
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
@@ -24,10 +24,18 @@ char    historyFileCSV[30] = "data/data-sc.csv";       // Archivo CSV para guard
 char    mealsFileTXT[30] = "data/data-esp.txt";        // Fichero TXT para guardar las comidas realizadas y que están pendientes de subir a la database
 char    auxMealsFileTXT[20] = "data/aux_file.txt";     // Fichero TXT auxiliar para guardar las comidas no subidas a la database durante la sincronización
 
+// --- FICHERO CALIBRACIÓN BÁSCULA ---
+char    fileCalibracion[30] = "data/calib.dat";        // Copia binaria de la calibración (calibrate_scale.ino), por si se borra la flash al subir el sketch
+char    fileTrazaBascula[30] = "data/scale.trc";       // Traza binaria de la báscula (Scale_Trace.h, solo con SCALE_TRACE)
+char    fileRegistroVuelo[30] = "data/vuelo.rec";      // Volcados binarios del registro de vuelo (Flight_Recorder.h)
+
 // --- FICHERO GUARDAR INFO PRODUCTOS ---
 char    productsFileCSV[30] = "data/barcodes.csv";     // Archivo CSV para guardar la información de los barcodes ya leídos
 
 
+// --- ATLAS DE IMAGENES ---
+char    fileAtlas[30]     = "bin/atlas.bin";                    // Todas las imágenes en un fichero (tools/atlas). Si no está, se cargan las sueltas
+
 // --- IMAGENES RELOJ ARENA ---
 char    fileReloj1[30]    = "bin/carga/reloj1.bin";             // 65x103
 char    fileReloj2[30]    = "bin/carga/reloj2.bin";             // 65x103
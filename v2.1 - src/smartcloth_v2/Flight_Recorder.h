@@ -0,0 +1,249 @@
+/**
+ * @file Flight_Recorder.h
+ * @brief Registro de vuelo: anillo en RAM de registros binarios (transiciones, duración de las
+ *        actividades de cada estado y estadísticas de la báscula) que se vuelca a la SD
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Los mensajes de SM_DEBUG se envían por SerialPC de forma síncrona y cambian tanto los tiempos
+ * que el comportamiento en uso real no se puede reproducir con ellos. El registro de vuelo está
+ * siempre activo y cada registro solo es un micros() y copiar 16 bytes en RAM (unos pocos us).
+ *
+ * Se registra:
+ *      - Cada transición: evento, estado anterior y nuevo, y ms desde que ocurrió el evento.
+ *      - Cada llamada a doStateActions() que tarda al menos VUELO_UMBRAL_ACTIVIDAD_US, y siempre la
+ *        primera tras entrar en un estado. Las comprobaciones periódicas de timeouts (cada 50 ms)
+ *        tardan menos y llenarían el anillo en unos segundos.
+ *      - Cada evento que no cumple ninguna regla (actEventError()).
+ *      - Cada VUELO_PERIODO_BASCULA ms: muestras y muestras estables del HX711, ruido (máx - mín
+ *        de las cuentas brutas) y último peso.
+ *
+ * Los registros solo se añaden desde el loop (nunca desde una ISR), así que no hace falta
+ * deshabilitar las interrupciones.
+ *
+ * El anillo se vuelca a la SD ('fileRegistroVuelo') al entrar en STATE_ERROR y a petición (carácter
+ * 'V' por SerialPC, con SM_DEBUG). Cada volcado se añade al final del fichero con una cabecera
+ * 'cabeceraVuelo_t' seguida de los registros nuevos desde el volcado anterior (los que ya se
+ * hubieran sobrescrito se cuentan en 'perdidos'). Se decodifica en el PC con tools/flight_recorder.
+ *
+ * 'tiempo' es micros() del Due, que da la vuelta cada ~71 min. El decodificador calcula la
+ * antigüedad de cada registro respecto al millis()/micros() de la cabecera del volcado.
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC
+#include <SD.h>
+#include "Files.h" // fileRegistroVuelo
+
+
+#define VUELO_MAGIC                 0x52464353  // "SCFR"
+#define VUELO_VERSION               1
+#define VUELO_REGISTROS             512         // Potencia de 2. 8 KB de RAM
+#define VUELO_UMBRAL_ACTIVIDAD_US   200         // Actividades más cortas no se registran (salvo la primera de cada estado)
+#define VUELO_PERIODO_BASCULA       1000        // ms entre registros de estadísticas de la báscula
+#define VUELO_MAX_FICHERO           262144UL    // Al superarlo se empieza un fichero nuevo (256 KB)
+
+// ------ TIPOS DE REGISTRO ---------------------------------------------------
+#define VUELO_ARRANQUE      1   // a = estado inicial,                              valor = ms de setup()
+#define VUELO_TRANSICION    2   // a = evento, b = estado anterior, c = nuevo,      valor = ms desde el evento
+#define VUELO_ACTIVIDAD     3   // a = estado, b = 1 si es la primera del estado,   valor = us de doStateActions()
+#define VUELO_ERROR         4   // a = evento, b = estado
+#define VUELO_BASCULA       5   // a = muestras, b = estables,                      valor = ruido (cuentas), extra = peso (mg)
+// -----------------------------------------------------------------------------
+
+// ------ MOTIVOS DE VOLCADO --------------------------------------------------
+#define VOLCADO_ERROR       1   // Entrada en STATE_ERROR
+#define VOLCADO_PEDIDO      2   // Pedido por SerialPC
+// -----------------------------------------------------------------------------
+
+
+typedef struct __attribute__((packed)) {
+    uint32_t  tiempo;       // micros()
+    int32_t   valor;
+    int32_t   extra;
+    uint8_t   tipo;
+    uint8_t   a;
+    uint8_t   b;
+    uint8_t   c;
+} registroVuelo_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t  magic;            // VUELO_MAGIC
+    uint16_t  version;          // VUELO_VERSION
+    uint16_t  tamRegistro;      // sizeof(registroVuelo_t)
+    uint16_t  nRegistros;       // Registros que siguen a la cabecera
+    uint8_t   motivo;           // VOLCADO_ERROR o VOLCADO_PEDIDO
+    uint8_t   estado;           // Estado actual al volcar
+    uint32_t  millisVolcado;
+    uint32_t  microsVolcado;
+    uint32_t  primerRegistro;   // Número del primer registro desde el arranque
+    uint32_t  perdidos;         // Registros sobrescritos antes de volcarlos
+} cabeceraVuelo_t;
+
+
+// ------ ESTADO DEL REGISTRO --------------------------------------------------
+registroVuelo_t     anilloVuelo[VUELO_REGISTROS];
+uint32_t            nRegistrosVuelo = 0;            // Registros añadidos desde el arranque
+uint32_t            nVolcadosVuelo = 0;             // Registros ya volcados (o perdidos) desde el arranque
+bool                volcadoVueloActivo = false;     // SD disponible para volcar
+
+unsigned long       inicioVentanaBascula = 0;       // millis() de inicio de la ventana de estadísticas de la báscula
+byte                nMuestrasVentana = 0;
+byte                nEstablesVentana = 0;
+long                minRawVentana = 0;
+long                maxRawVentana = 0;
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+inline void addRegistroVuelo(byte tipo, byte a, byte b, byte c, long valor, long extra);    // Añadir registro al anillo en RAM
+inline void vueloArranque(byte estado, unsigned long msSetup){ addRegistroVuelo(VUELO_ARRANQUE, estado, 0, 0, msSetup, 0); };
+inline void vueloTransicion(byte evento, byte prev, byte nuevo, unsigned long msEvento){ addRegistroVuelo(VUELO_TRANSICION, evento, prev, nuevo, msEvento, 0); };
+inline void vueloActividad(byte estado, unsigned long us, bool primera){ if(primera or (us >= VUELO_UMBRAL_ACTIVIDAD_US)) addRegistroVuelo(VUELO_ACTIVIDAD, estado, primera, 0, us, 0); };
+inline void vueloError(byte evento, byte estado){ addRegistroVuelo(VUELO_ERROR, evento, estado, 0, 0, 0); };
+void        vueloMuestraBascula(long raw, float peso, bool estable);                        // Acumular una muestra en las estadísticas de la báscula
+void        setupRegistroVuelo();                                                           // Habilitar los volcados (si hay SD)
+bool        volcarRegistroVuelo(byte motivo, byte estado);                                  // Añadir a la SD los registros nuevos
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade un registro al anillo, sobrescribiendo el más antiguo si está lleno. No accede a la SD.
+ */
+/*-----------------------------------------------------------------------------*/
+inline void addRegistroVuelo(byte tipo, byte a, byte b, byte c, long valor, long extra)
+{
+    registroVuelo_t &reg = anilloVuelo[nRegistrosVuelo & (VUELO_REGISTROS - 1)];
+    reg.tiempo = micros();
+    reg.valor = valor;
+    reg.extra = extra;
+    reg.tipo = tipo;
+    reg.a = a;
+    reg.b = b;
+    reg.c = c;
+    nRegistrosVuelo++;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Acumula una muestra del HX711 y, cada VUELO_PERIODO_BASCULA ms, registra las estadísticas
+ *        de la ventana: muestras, estables, ruido y último peso.
+ */
+/*-----------------------------------------------------------------------------*/
+void vueloMuestraBascula(long raw, float peso, bool estable)
+{
+    if(nMuestrasVentana == 0){ minRawVentana = raw; maxRawVentana = raw; }
+    else if(raw < minRawVentana) minRawVentana = raw;
+    else if(raw > maxRawVentana) maxRawVentana = raw;
+
+    if(nMuestrasVentana < 255) nMuestrasVentana++;
+    if(estable and (nEstablesVentana < 255)) nEstablesVentana++;
+
+    if((millis() - inicioVentanaBascula) < VUELO_PERIODO_BASCULA) return;
+
+    addRegistroVuelo(VUELO_BASCULA, nMuestrasVentana, nEstablesVentana, 0, maxRawVentana - minRawVentana, (long)(peso * 1000.0));
+    inicioVentanaBascula = millis();
+    nMuestrasVentana = 0;
+    nEstablesVentana = 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Habilita los volcados a la SD. Sin SD se sigue registrando en RAM.
+ */
+/*-----------------------------------------------------------------------------*/
+void setupRegistroVuelo()
+{
+    volcadoVueloActivo = true;
+    inicioVentanaBascula = millis();
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade al final de 'fileRegistroVuelo' una cabecera y los registros nuevos desde el
+ *        volcado anterior. Si el fichero supera VUELO_MAX_FICHERO, se empieza uno nuevo.
+ * @return 'false' si no se ha podido escribir
+ */
+/*-----------------------------------------------------------------------------*/
+bool volcarRegistroVuelo(byte motivo, byte estado)
+{
+    if(!volcadoVueloActivo) return false;
+
+    uint32_t desde = nVolcadosVuelo;
+    if((nRegistrosVuelo - desde) > VUELO_REGISTROS) desde = nRegistrosVuelo - VUELO_REGISTROS; // Los más antiguos ya se han sobrescrito
+    uint32_t nRegistros = nRegistrosVuelo - desde;
+    if(nRegistros == 0) return true;
+
+    File myFile = SD.open(fileRegistroVuelo, FILE_WRITE);
+    if(myFile and (myFile.size() > VUELO_MAX_FICHERO))
+    {
+        myFile.close();
+        SD.remove(fileRegistroVuelo);
+        myFile = SD.open(fileRegistroVuelo, FILE_WRITE);
+    }
+    if(!myFile) return false;
+
+    cabeceraVuelo_t cabecera;
+    cabecera.magic = VUELO_MAGIC;
+    cabecera.version = VUELO_VERSION;
+    cabecera.tamRegistro = sizeof(registroVuelo_t);
+    cabecera.nRegistros = nRegistros;
+    cabecera.motivo = motivo;
+    cabecera.estado = estado;
+    cabecera.millisVolcado = millis();
+    cabecera.microsVolcado = micros();
+    cabecera.primerRegistro = desde;
+    cabecera.perdidos = desde - nVolcadosVuelo;
+    myFile.write((byte*)&cabecera, sizeof(cabeceraVuelo_t));
+
+    // Registros en orden: hasta el final del anillo y, si dan la vuelta, desde el principio
+    uint32_t inicio = desde & (VUELO_REGISTROS - 1);
+    uint32_t hastaFinal = min(nRegistros, (uint32_t)(VUELO_REGISTROS - inicio));
+    myFile.write((byte*)&anilloVuelo[inicio], hastaFinal * sizeof(registroVuelo_t));
+    if(nRegistros > hastaFinal) myFile.write((byte*)&anilloVuelo[0], (nRegistros - hastaFinal) * sizeof(registroVuelo_t));
+    myFile.close();
+
+    nVolcadosVuelo = desde + nRegistros;
+
+    #if defined(SM_DEBUG)
+        SerialPC.print(F("Registro de vuelo volcado: ")); SerialPC.print(nRegistros); SerialPC.print(F(" registros, "));
+        SerialPC.print(cabecera.perdidos); SerialPC.println(F(" perdidos"));
+    #endif
+
+    return true;
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
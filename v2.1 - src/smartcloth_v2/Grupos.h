@@ -19,6 +19,7 @@
 
 #include "COLORS.h" // Colores del texto de nombre de grupo y ejemplos
 #include "debug.h"  // SM_DEBUG --> SerialPC
+#include "Texto_Latin1.h" // TEXTO_LATIN1(), utf8ALatin1()
 
  
 #define NUM_GRUPOS 27 // 27 nuestros (crudos y cocinados), el de barcode se actualiza automáticamente con los valores buscado
@@ -34,10 +35,6 @@
 /******************************************************************************/
 void    setGrupoAlimentos(byte id);                             // Establece el grupo de alimentos seleccionado
 void    updateGrupoActualFromBarcode(String &productInfo);    // Actualiza el grupo de alimentos seleccionado con la info del producto barcode leído
-
-// --- CONVERSIÓN DE TEXTO ---
-void    convertSpecialCharactersToHEX_ref(String &input);       // Convierte a HEX caracteres especiales en una cadena de texto pasada por referencia
-String  convertSpecialCharactersToHEX(String input);            // Convierte a HEX caracteres especiales en una cadena de texto y devuelve la cadena modificada
 /******************************************************************************/
 /******************************************************************************/
 
@@ -58,14 +55,15 @@ String  convertSpecialCharactersToHEX(String input);            // Convierte a H
  * @brief Estructura que representa un grupo de alimentos.
  *
  * Esta estructura contiene información sobre un grupo de alimentos, como su ID, color, nombre,
- * ejemplos y contenido nutricional por gramo.
+ * ejemplos y contenido nutricional por gramo. Los del catálogo (gruposAlimentos) son constantes y
+ * están en flash con sus textos; solo el del producto barcode está en RAM (grupoBarcode).
  */
 /*-----------------------------------------------------------------------------*/
 typedef struct {
     byte          ID_grupo;         /**< ID del grupo */
     uint16_t      color_grupo;      /**< Color del texto del grupo */
-    String        Nombre_grupo;     /**< Nombre del grupo */
-    String        Ejemplos_grupo;   /**< Ejemplos del grupo */
+    const char    *Nombre_grupo;    /**< Nombre del grupo (Latin-1) */
+    const char    *Ejemplos_grupo;  /**< Ejemplos del grupo (Latin-1) */
     float         Kcal_g;           /**< Calorías por gramo */
     float         Prot_g;           /**< Proteínas por gramo */
     float         Lip_g;            /**< Lípidos por gramo */
@@ -96,52 +94,127 @@ typedef struct {
 
 
 
+// Textos del catálogo, pasados a Latin-1 al compilar (TEXTO_LATIN1()). Los grupos cocinados (ID + 20) usan
+// los del crudo correspondiente.
+constexpr auto NOMBRE_G1    = TEXTO_LATIN1("Lácteos enteros");
+constexpr auto EJEMPLOS_G1  = TEXTO_LATIN1("Leche entera de vaca (pasteurizada o UHT), de oveja, de cabra, yogurt\n   natural entero, cuajada, etc.");
+constexpr auto NOMBRE_G2    = TEXTO_LATIN1("Lácteos semidesnatados");
+constexpr auto EJEMPLOS_G2  = TEXTO_LATIN1("Leche semidesnatada pasteurizada y UHT");
+constexpr auto NOMBRE_G3    = TEXTO_LATIN1("Lácteos desnatados");
+constexpr auto EJEMPLOS_G3  = TEXTO_LATIN1("Leche desnatada pasteurizada y UHT, natural, con frutas, yogurt desnatado,\n   yogurt desnatado de sabores, etc.");
+constexpr auto NOMBRE_G4    = TEXTO_LATIN1("Lácteos azucarados");
+constexpr auto EJEMPLOS_G4  = TEXTO_LATIN1("Batidos lácteos de cacao y otros sabores, leche entera fermentada con\n   frutas, yogures enteros de sabores y azucarados, yogures líquidos de\n   sabores y azucarados");
+constexpr auto NOMBRE_G5    = TEXTO_LATIN1("Postres lácteos");
+constexpr auto EJEMPLOS_G5  = TEXTO_LATIN1("Arroz con leche, flan de huevo, flan de vainilla y natillas...");
+constexpr auto NOMBRE_G6    = TEXTO_LATIN1("Frutas frescas, desecadas y zumos");
+constexpr auto EJEMPLOS_G6  = TEXTO_LATIN1("Albaricoque, arándanos, cerezas, ciruelas, dátil seco, fresa, granada,\n   higos, kiwi, mandarina,manzana, melocotón, melón, naranja, pera, piña,\n   plátano, sandía, uvas...");
+constexpr auto NOMBRE_G7    = TEXTO_LATIN1("Verduras y hortalizas");
+constexpr auto EJEMPLOS_G7  = TEXTO_LATIN1("Acelgas, apio, alcachofa, berenjena, brócoli, calabacín, calabaza,\n   champiñones, col, espárragos, espinacas, guisantes, lechuga, judías,\n   pimientos, tomate, zanahoria, etc.");
+constexpr auto NOMBRE_G8    = TEXTO_LATIN1("Cereales y tubérculos");
+constexpr auto EJEMPLOS_G8  = TEXTO_LATIN1("Arroz, avena, boniato, castaña, cereales de desayuno ricos en fibra,\n   copos de maíz, harina, maíz, pan, pasta, patata, sémola de trigo, etc.");
+constexpr auto NOMBRE_G9    = TEXTO_LATIN1("Legumbres");
+constexpr auto EJEMPLOS_G9  = TEXTO_LATIN1("Alubias, garbanzos, lentejas, etc.");
+constexpr auto NOMBRE_G10   = TEXTO_LATIN1("Repostería, pastelería y otros");
+constexpr auto EJEMPLOS_G10 = TEXTO_LATIN1("Bizcocho, bollo, croissant, ensaimada, galletas (de cualquier tipo),\n   magdalena, muesli, pan de pasas, tartas, pasteles, bollería industrial...");
+constexpr auto NOMBRE_G11   = TEXTO_LATIN1("Alimentos ricos en grasas saludables");
+constexpr auto EJEMPLOS_G11 = TEXTO_LATIN1("Aceites de cacahuete, de oliva y de hígado de bacalao, aceitunas,\n   aguacate, almendras, avellanas, cacahuetes, pistachos, mayonesa de aceite\n   de oliva, etc.");
+constexpr auto NOMBRE_G12   = TEXTO_LATIN1("Alimentos ricos en grasas vegetales");
+constexpr auto EJEMPLOS_G12 = TEXTO_LATIN1("Aceite de girasol, aceite de maíz, aceite de soja, mayonesa light, nueces,\n   piñones, etc.");
+constexpr auto NOMBRE_G13   = TEXTO_LATIN1("Alimentos ricos en grasas saturadas");
+constexpr auto EJEMPLOS_G13 = TEXTO_LATIN1("Coco fresco o seco, aceite de coco, mantequilla, nata líquida para cocinar\n   o montar, etc.");
+constexpr auto NOMBRE_G14   = TEXTO_LATIN1("Alimentos muy grasos (mezclas)");
+constexpr auto EJEMPLOS_G14 = TEXTO_LATIN1("Margarina light, margarina vegetal enriquecida, manteca y tocino de cerdo");
+constexpr auto NOMBRE_G15   = TEXTO_LATIN1("Azúcares y dulces");
+constexpr auto EJEMPLOS_G15 = TEXTO_LATIN1("Azúcar blanco y moreno, miel, leche condensada, cacao soluble azucarado,\n   confitura de fruta baja en calorías");
+constexpr auto NOMBRE_G16   = TEXTO_LATIN1("Alimentos proteicos con muy poca grasa");
+constexpr auto EJEMPLOS_G16 = TEXTO_LATIN1("Pavo, pollo, ternera (entrecot y solomillo), jamón cocido, atún natural,\n   pescado no graso, marisco, queso granulado, clara de huevo, etc.");
+constexpr auto NOMBRE_G17   = TEXTO_LATIN1("Alimentos proteicos con poca grasa");
+constexpr auto EJEMPLOS_G17 = TEXTO_LATIN1("Lomo de cerdo, pollo sin piel, bistec de vaca/buey, jamón curado (sin\n   grasa), pescados grasos (atún, sardina, trucha, boquerón...), vísceras, pato\n   sin piel, codorniz, etc.");
+constexpr auto NOMBRE_G18   = TEXTO_LATIN1("Alimentos proteicos semigrasos");
+constexpr auto EJEMPLOS_G18 = TEXTO_LATIN1("Chuletas de cerdo, cordero, anchoas, atún o sardinas en aceite, caballa,\n   salmón, jamón curado con grasa, huevo, queso fresco, requesón, queso en\n   porciones, etc.");
+constexpr auto NOMBRE_G19   = TEXTO_LATIN1("Alimentos proteicos grasos");
+constexpr auto EJEMPLOS_G19 = TEXTO_LATIN1("Chuletas/costillas de cordero, chorizo, salchichas, fuet, quesos (azul,\n   babybel, camembert, cheddar, de cabra, emmental, gouda, gruyer, manchego...)");
+constexpr auto NOMBRE_G20   = TEXTO_LATIN1("Alimentos proteicos muy grasos");
+constexpr auto EJEMPLOS_G20 = TEXTO_LATIN1("Carne picada sazonada, panceta de cerdo, morcilla, mortadela, paté,\n   salami, salchichón, etc.");
+
+
+
+
                                     // ID | Color | Nombre | Ejemplos | Kcal | Proteinas | Lipidos | Carbohidratos
 /*-----------------------------------------------------------------------------*/
 /**
  * @var gruposAlimentos
- * @brief Arreglo de objetos Grupo que representa los grupos de alimentos.
+ * @brief Catálogo de grupos de alimentos, constante (en flash).
  *
- * Este array almacena los distintos grupos de alimentos y sus características.
+ * Este array almacena los distintos grupos de alimentos y sus características. Se busca por ID con
+ * buscarGrupo().
  */               
 /*-----------------------------------------------------------------------------*/                    
-Grupo gruposAlimentos[NUM_GRUPOS] = { 
-                                        {1,COLOR_G1,"Lácteos enteros","Leche entera de vaca (pasteurizada o UHT), de oveja, de cabra, yogurt\n   natural entero, cuajada, etc.",0.69584,0.03576,0.04156,0.04831},
-                                        {2,COLOR_G2,"Lácteos semidesnatados","Leche semidesnatada pasteurizada y UHT",0.4729,0.0332,0.0174,0.0495},
-                                        {3,COLOR_G3,"Lácteos desnatados","Leche desnatada pasteurizada y UHT, natural, con frutas, yogurt desnatado,\n   yogurt desnatado de sabores, etc.",0.3393,0.0338,0.0028,0.0478},
-                                        {4,COLOR_G4,"Lácteos azucarados","Batidos lácteos de cacao y otros sabores, leche entera fermentada con\n   frutas, yogures enteros de sabores y azucarados, yogures líquidos de\n   sabores y azucarados",0.8598,0.0301,0.0257,0.1316},
-                                        {5,COLOR_G5,"Postres lácteos","Arroz con leche, flan de huevo, flan de vainilla y natillas...",1.8484,0.0356,0.0806,0.2478},
-                                        {6,COLOR_G6,"Frutas frescas, desecadas y zumos","Albaricoque, arándanos, cerezas, ciruelas, dátil seco, fresa, granada,\n   higos, kiwi, mandarina,manzana, melocotón, melón, naranja, pera, piña,\n   plátano, sandía, uvas...",0.48055,0.00801,0.002497,0.11196},
-                                        {7,COLOR_G7,"Verduras y hortalizas","Acelgas, apio, alcachofa, berenjena, brócoli, calabacín, calabaza,\n   champiñones, col, espárragos, espinacas, guisantes, lechuga, judías,\n   pimientos, tomate, zanahoria, etc.",0.2454,0.0148,0.0037,0.0412},
-                                        {8,COLOR_G8,"Cereales y tubérculos","Arroz, avena, boniato, castaña, cereales de desayuno ricos en fibra,\n   copos de maíz, harina, maíz, pan, pasta, patata, sémola de trigo, etc.",2.1053,0.0622,0.0142,0.4452},
-                                        {9,COLOR_G9,"Legumbres","Alubias, garbanzos, lentejas, etc.",3.2236,0.2148,0.0327,0.5523},
-                                        {10,COLOR_G10,"Repostería, pastelería y otros","Bizcocho, bollo, croissant, ensaimada, galletas (de cualquier tipo),\n   magdalena, muesli, pan de pasas, tartas, pasteles, bollería industrial...",3.8946,0.0728,0.1420,0.5055},
-                                        {11,COLOR_G11,"Alimentos ricos en grasas saludables","Aceites de cacahuete, de oliva y de hígado de bacalao, aceitunas,\n   aguacate, almendras, avellanas, cacahuetes, pistachos, mayonesa de aceite\n   de oliva, etc.",7.2833,0.0289,0.7881,0.0343},
-                                        {12,COLOR_G12,"Alimentos ricos en grasas vegetales","Aceite de girasol, aceite de maíz, aceite de soja, mayonesa light, nueces,\n   piñones, etc.",8.4623,0.0249,0.9329,0.0249},
-                                        {13,COLOR_G13,"Alimentos ricos en grasas saturadas","Coco fresco o seco, aceite de coco, mantequilla, nata líquida para cocinar\n   o montar, etc.",5.6178,0.0126,0.6115,0.0178},
-                                        {14,COLOR_G14,"Alimentos muy grasos (mezclas)","Margarina light, margarina vegetal enriquecida, manteca y tocino de cerdo",8.2686,0.0107,0.9136,0.0007},
-                                        {15,COLOR_G15,"Azúcares y dulces","Azúcar blanco y moreno, miel, leche condensada, cacao soluble azucarado,\n   confitura de fruta baja en calorías",3.5162,0.0262,0.0247,0.8446},
-                                        {16,COLOR_G16,"Alimentos proteicos con muy poca grasa","Pavo, pollo, ternera (entrecot y solomillo), jamón cocido, atún natural,\n   pescado no graso, marisco, queso granulado, clara de huevo, etc.",0.9947,0.1930,0.0176,0.0101},
-                                        {17,COLOR_G17,"Alimentos proteicos con poca grasa","Lomo de cerdo, pollo sin piel, bistec de vaca/buey, jamón curado (sin\n   grasa), pescados grasos (atún, sardina, trucha, boquerón...), vísceras, pato\n   sin piel, codorniz, etc.",1.3896,0.1848,0.0705,0.0044},
-                                        {18,COLOR_G18,"Alimentos proteicos semigrasos","Chuletas de cerdo, cordero, anchoas, atún o sardinas en aceite, caballa,\n   salmón, jamón curado con grasa, huevo, queso fresco, requesón, queso en\n   porciones, etc.",1.4769,0.1298,0.1067,0.0064},
-                                        {19,COLOR_G19,"Alimentos proteicos grasos","Chuletas/costillas de cordero, chorizo, salchichas, fuet, quesos (azul,\n   babybel, camembert, cheddar, de cabra, emmental, gouda, gruyer, manchego...)",2.7904,0.2061,0.2160,0.0},
-                                        {20,COLOR_G20,"Alimentos proteicos muy grasos","Carne picada sazonada, panceta de cerdo, morcilla, mortadela, paté,\n   salami, salchichón, etc.",3.1911,0.1335,0.2848,0.0351},
-                                        {27,COLOR_G7,"Verduras y hortalizas","Acelgas, apio, alcachofa, berenjena, brócoli, calabacín, calabaza,\n   champiñones, col, espárragos, espinacas, guisantes, lechuga, judías,\n   pimientos, tomate, zanahoria, etc.",0.2282,0.0158,0.0037,0.0235},
-                                        {28,COLOR_G8,"Cereales y tubérculos","Arroz, avena, boniato, castaña, cereales de desayuno ricos en fibra,\n   copos de maíz, harina, maíz, pan, pasta, patata, sémola de trigo, etc.",0.9617,0.0195,0.0051,0.2375},
-                                        {29,COLOR_G9,"Legumbres","Alubias, garbanzos, lentejas, etc.",1.1762,0.0858,0.0146,0.1868},
-                                        {36,COLOR_G16,"Alimentos proteicos con muy poca grasa","Pavo, pollo, ternera (entrecot y solomillo), jamón cocido, atún natural,\n   pescado no graso, marisco, queso granulado, clara de huevo, etc.",0.9450,0.1978,0.0131,0.0013},
-                                        {37,COLOR_G17,"Alimentos proteicos con poca grasa","Lomo de cerdo, pollo sin piel, bistec de vaca/buey, jamón curado (sin\n   grasa), pescados grasos (atún, sardina, trucha, boquerón...), vísceras, pato\n   sin piel, codorniz, etc.",1.7312,0.2288,0.0838,0.0074},
-                                        {38,COLOR_G18,"Alimentos proteicos semigrasos","Chuletas de cerdo, cordero, anchoas, atún o sardinas en aceite, caballa,\n   salmón, jamón curado con grasa, huevo, queso fresco, requesón, queso en\n   porciones, etc.",1.5525,0.1347,0.1126,0.0064},
-                                        {39,COLOR_G19,"Alimentos proteicos grasos","Chuletas/costillas de cordero, chorizo, salchichas, fuet, quesos (azul,\n   babybel, camembert, cheddar, de cabra, emmental, gouda, gruyer, manchego...)",2.8156,0.1869,0.2260,0.0}
+constexpr Grupo gruposAlimentos[NUM_GRUPOS] = { 
+                                        {1,COLOR_G1,NOMBRE_G1.c,EJEMPLOS_G1.c,0.69584,0.03576,0.04156,0.04831},
+                                        {2,COLOR_G2,NOMBRE_G2.c,EJEMPLOS_G2.c,0.4729,0.0332,0.0174,0.0495},
+                                        {3,COLOR_G3,NOMBRE_G3.c,EJEMPLOS_G3.c,0.3393,0.0338,0.0028,0.0478},
+                                        {4,COLOR_G4,NOMBRE_G4.c,EJEMPLOS_G4.c,0.8598,0.0301,0.0257,0.1316},
+                                        {5,COLOR_G5,NOMBRE_G5.c,EJEMPLOS_G5.c,1.8484,0.0356,0.0806,0.2478},
+                                        {6,COLOR_G6,NOMBRE_G6.c,EJEMPLOS_G6.c,0.48055,0.00801,0.002497,0.11196},
+                                        {7,COLOR_G7,NOMBRE_G7.c,EJEMPLOS_G7.c,0.2454,0.0148,0.0037,0.0412},
+                                        {8,COLOR_G8,NOMBRE_G8.c,EJEMPLOS_G8.c,2.1053,0.0622,0.0142,0.4452},
+                                        {9,COLOR_G9,NOMBRE_G9.c,EJEMPLOS_G9.c,3.2236,0.2148,0.0327,0.5523},
+                                        {10,COLOR_G10,NOMBRE_G10.c,EJEMPLOS_G10.c,3.8946,0.0728,0.1420,0.5055},
+                                        {11,COLOR_G11,NOMBRE_G11.c,EJEMPLOS_G11.c,7.2833,0.0289,0.7881,0.0343},
+                                        {12,COLOR_G12,NOMBRE_G12.c,EJEMPLOS_G12.c,8.4623,0.0249,0.9329,0.0249},
+                                        {13,COLOR_G13,NOMBRE_G13.c,EJEMPLOS_G13.c,5.6178,0.0126,0.6115,0.0178},
+                                        {14,COLOR_G14,NOMBRE_G14.c,EJEMPLOS_G14.c,8.2686,0.0107,0.9136,0.0007},
+                                        {15,COLOR_G15,NOMBRE_G15.c,EJEMPLOS_G15.c,3.5162,0.0262,0.0247,0.8446},
+                                        {16,COLOR_G16,NOMBRE_G16.c,EJEMPLOS_G16.c,0.9947,0.1930,0.0176,0.0101},
+                                        {17,COLOR_G17,NOMBRE_G17.c,EJEMPLOS_G17.c,1.3896,0.1848,0.0705,0.0044},
+                                        {18,COLOR_G18,NOMBRE_G18.c,EJEMPLOS_G18.c,1.4769,0.1298,0.1067,0.0064},
+                                        {19,COLOR_G19,NOMBRE_G19.c,EJEMPLOS_G19.c,2.7904,0.2061,0.2160,0.0},
+                                        {20,COLOR_G20,NOMBRE_G20.c,EJEMPLOS_G20.c,3.1911,0.1335,0.2848,0.0351},
+                                        {27,COLOR_G7,NOMBRE_G7.c,EJEMPLOS_G7.c,0.2282,0.0158,0.0037,0.0235},
+                                        {28,COLOR_G8,NOMBRE_G8.c,EJEMPLOS_G8.c,0.9617,0.0195,0.0051,0.2375},
+                                        {29,COLOR_G9,NOMBRE_G9.c,EJEMPLOS_G9.c,1.1762,0.0858,0.0146,0.1868},
+                                        {36,COLOR_G16,NOMBRE_G16.c,EJEMPLOS_G16.c,0.9450,0.1978,0.0131,0.0013},
+                                        {37,COLOR_G17,NOMBRE_G17.c,EJEMPLOS_G17.c,1.7312,0.2288,0.0838,0.0074},
+                                        {38,COLOR_G18,NOMBRE_G18.c,EJEMPLOS_G18.c,1.5525,0.1347,0.1126,0.0064},
+                                        {39,COLOR_G19,NOMBRE_G19.c,EJEMPLOS_G19.c,2.8156,0.1869,0.2260,0.0}
                                     };
 
 
-// Grupo de alimentos seleccionado
-Grupo grupoActual {ID_GRUPO_NOT_SELECTED,WHITE,"","",0.0,0.0,0.0,0.0}; 
+// Posición en gruposAlimentos de cada ID (0..MAX_ID_GRUPO), calculada al compilar: buscarGrupo() no recorre el catálogo
+#define MAX_ID_GRUPO            39      // Último ID del catálogo
+#define GRUPO_NO_ENCONTRADO     0xFF
+
+constexpr byte posicionGrupo(size_t id, byte i){ 
+    return (i >= NUM_GRUPOS) ? GRUPO_NO_ENCONTRADO : ((gruposAlimentos[i].ID_grupo == id) ? i : posicionGrupo(id, i + 1)); 
+}
+
+template<size_t N> struct tablaPosicionesGrupo_t { byte posicion[N]; };
+template<size_t... I> constexpr tablaPosicionesGrupo_t<sizeof...(I)> crearTablaPosicionesGrupo(secuenciaIndices<I...>){ 
+    return {{ posicionGrupo(I, 0)... }}; 
+}
+
+constexpr tablaPosicionesGrupo_t<MAX_ID_GRUPO + 1> posicionesGrupos = crearTablaPosicionesGrupo(crearSecuenciaIndices<MAX_ID_GRUPO + 1>::tipo());
+
+
+// Grupo "ninguno", para que grupoActual y grupoAnterior siempre apunten a un grupo
+constexpr Grupo grupoNoSeleccionado {ID_GRUPO_NOT_SELECTED,WHITE,"","",0.0,0.0,0.0,0.0};
+
+
+// Producto barcode confirmado, superpuesto al catálogo. Hay dos y se usa el que no es 'grupoActual',
+// para que 'grupoAnterior' siga siendo el producto anterior si se confirma otro seguido.
+#define LONGITUD_NOMBRE_PRODUCTO    100     // Caracteres Latin-1. Los nombres más largos se recortan
+
+Grupo   grupoBarcode[2];
+char    nombreProductoBarcode[2][LONGITUD_NOMBRE_PRODUCTO + 1];
+
+
+// Grupo de alimentos seleccionado (del catálogo o grupoBarcode)
+const Grupo *grupoActual = &grupoNoSeleccionado;
 
 // Grupo de alimentos seleccionado anteriormente, necesario para saber qué valores guardar al
 // poner peso y luego escoger otro grupo, lo que confirma el peso puesto.
-Grupo grupoAnterior {ID_GRUPO_NOT_SELECTED,WHITE,"","",0.0,0.0,0.0,0.0};
+const Grupo *grupoAnterior = &grupoNoSeleccionado;
 
 
 /******************************************************************************/
@@ -160,29 +233,29 @@ Grupo grupoAnterior {ID_GRUPO_NOT_SELECTED,WHITE,"","",0.0,0.0,0.0,0.0};
 
 /*-----------------------------------------------------------------------------*/
 /**
- * @brief Establece el grupo de alimentos seleccionado.
- * @param id ID del grupo a seleccionar ('buttonGrande' o 50 si es el de barcode).
+ * @brief Busca un grupo del catálogo por su ID en la tabla de posiciones (O(1)).
+ * @param id ID del grupo
+ * @return Grupo con ese ID o, si no existe, el primero del catálogo (como hacía la búsqueda lineal)
  */
 /*-----------------------------------------------------------------------------*/
-void setGrupoAlimentos(byte id)      
+inline const Grupo* buscarGrupo(byte id)
 {
-    // Obtener posición del grupo en el array
-    byte posGrupo = 0;
-    for(byte i = 0; i < NUM_GRUPOS; i++){ 
-        if(gruposAlimentos[i].ID_grupo == id){ 
-            posGrupo = i;
-            break;
-        }
-    }
-    grupoAnterior = grupoActual;
-    grupoActual = gruposAlimentos[posGrupo]; 
+    byte posGrupo = (id <= MAX_ID_GRUPO) ? posicionesGrupos.posicion[id] : GRUPO_NO_ENCONTRADO;
+    return &gruposAlimentos[(posGrupo == GRUPO_NO_ENCONTRADO) ? 0 : posGrupo];
+}
 
-    // Convertir caracteres especiales a HEX en grupoActual
-    convertSpecialCharactersToHEX_ref(grupoActual.Nombre_grupo);
-    convertSpecialCharactersToHEX_ref(grupoActual.Ejemplos_grupo);
-    // No hace falta para el grupoAnterior porque no se muestra en pantalla, 
-    // solo se usa para guardar los valores al poner peso y luego escoger otro grupo.
 
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Establece el grupo de alimentos seleccionado. Solo cambian los punteros: los textos y
+ *        valores se leen del catálogo en flash al usarlos.
+ * @param id ID del grupo a seleccionar ('buttonGrande' o 'buttonGrande' + 20 si es cocinado).
+ */
+/*-----------------------------------------------------------------------------*/
+void setGrupoAlimentos(byte id)      
+{
+    grupoAnterior = grupoActual;
+    grupoActual = buscarGrupo(id);
 }
 
 
@@ -240,24 +313,32 @@ void updateGrupoActualFromBarcode(String &productInfo)
 
     // ----- ACTUALIZAR GRUPO ACTUAL CON INFO DEL BARCODE -----
 
-    // Modificar datos con info del producto:
-    grupoActual.ID_grupo = BARCODE_PRODUCT_INDEX; // ID = 50
-    grupoActual.color_grupo = COLOR_G50;
-    grupoActual.Nombre_grupo = convertSpecialCharactersToHEX(nombre_producto); // Convertir caracteres especiales en el nombre a HEX
-    grupoActual.Ejemplos_grupo = ""; // No hay ejemplos para el producto barcode
-    grupoActual.Carb_g = carb_1g;
-    grupoActual.Lip_g = lip_1g;
-    grupoActual.Prot_g = prot_1g;
-    grupoActual.Kcal_g = kcal_1g;
+    // Rellenar el grupoBarcode que no está en uso con la info del producto:
+    byte libre = (grupoActual == &grupoBarcode[0]) ? 1 : 0;
+    Grupo &producto = grupoBarcode[libre];
+
+    utf8ALatin1(nombre_producto); // Convertir caracteres especiales en el nombre a Latin-1
+    nombre_producto.toCharArray(nombreProductoBarcode[libre], LONGITUD_NOMBRE_PRODUCTO + 1);
+
+    producto.ID_grupo = BARCODE_PRODUCT_INDEX; // ID = 50
+    producto.color_grupo = COLOR_G50;
+    producto.Nombre_grupo = nombreProductoBarcode[libre];
+    producto.Ejemplos_grupo = ""; // No hay ejemplos para el producto barcode
+    producto.Carb_g = carb_1g;
+    producto.Lip_g = lip_1g;
+    producto.Prot_g = prot_1g;
+    producto.Kcal_g = kcal_1g;
+
+    grupoActual = &producto;
 
     #ifdef SM_DEBUG
         SerialPC.println("\nCodigo: " + barcode);
-        SerialPC.println("ID grupo: " + String(grupoActual.ID_grupo));
-        SerialPC.println("Nombre: " + grupoActual.Nombre_grupo);
-        SerialPC.println("Carb_1g: " + String(grupoActual.Carb_g));
-        SerialPC.println("Lip_1g: " + String(grupoActual.Lip_g));
-        SerialPC.println("Prot_1g: " + String(grupoActual.Prot_g));
-        SerialPC.println("Kcal_1g: " + String(grupoActual.Kcal_g));
+        SerialPC.println("ID grupo: " + String(grupoActual->ID_grupo));
+        SerialPC.print("Nombre: "); SerialPC.println(grupoActual->Nombre_grupo);
+        SerialPC.println("Carb_1g: " + String(grupoActual->Carb_g));
+        SerialPC.println("Lip_1g: " + String(grupoActual->Lip_g));
+        SerialPC.println("Prot_1g: " + String(grupoActual->Prot_g));
+        SerialPC.println("Kcal_1g: " + String(grupoActual->Kcal_g));
     #endif
     // ---------------------------------------------------------
 
@@ -267,77 +348,6 @@ void updateGrupoActualFromBarcode(String &productInfo)
 
 
 
-/*-----------------------------------------------------------------------------*/
-/**
- * @brief Convierte los caracteres especiales en una cadena de texto.
- * 
- * Esta función reemplaza los caracteres especiales en una cadena de texto con sus correspondientes
- * códigos de caracteres en formato hexadecimal. Los caracteres especiales que se reemplazan son:
- * 
- * - Minúsculas: vocales acentuadas (á, é, í, ó, ú) y la letra 'ñ'.
- * - Mayúsculas: vocales acentuadas (Á, É, Í, Ó, Ú) y la letra 'Ñ'.
- * - Signos de interrogación (¿), exclamación (¡), escape (/) y puntos suspensivos (...).
- * 
- * Se utilizan los caracteres especiales en ISO 8859-1 (Latin-1) en HEX.
- * 
- * @param input La cadena de texto en la que se reemplazarán los caracteres especiales.
- * 
- * @see https://cs.stanford.edu/people/miles/iso8859.html Colección de caracteres ASCII/ISO 8859-1 (Latin-1) en HEX
- * @see https://www.raio.com.tw/data_raio/Datasheet/RA887677/RA8876_Brief_DS_V11_Eng.pdf Table 14-1 (pag 99) del datasheet de RA8876 para caracteres Latin-1
- */
-/*-----------------------------------------------------------------------------*/
-void convertSpecialCharactersToHEX_ref(String &input) 
-{
-    // Minúsculas: vocales y 'ñ'
-    input.replace("á", "\xE1");
-    input.replace("é", "\xE9");
-    input.replace("í", "\xED");
-    input.replace("ó", "\xF3");
-    input.replace("ú", "\xFA");
-    input.replace("ñ", "\xF1");
-
-    // Mayúsculas: vocales y 'Ñ'
-    input.replace("Á", "\xC1");
-    input.replace("É", "\xC9");
-    input.replace("Í", "\xCD");
-    input.replace("Ó", "\xD3");
-    input.replace("Ú", "\xDA");
-    input.replace("Ñ", "\xD1");
-
-    // Signos de interrogación y exclamación
-    input.replace("¿", "\xBF");
-    input.replace("¡", "\xA1");
-
-    // Caracter especial '/'
-    input.replace("/", "\x2F");
-
-    // Puntos suspensivos
-    input.replace("...", "\x85");
-}
-
-
-
-/*-----------------------------------------------------------------------------*/
-/**
- * @brief Convierte los caracteres especiales en una cadena de texto utilizando una función auxiliar.
- * 
- * Esta función llama a `convertSpecialCharactersToHEX_ref` para realizar la conversión de los caracteres
- * especiales en la cadena de texto. La función auxiliar modifica la cadena directamente a través de una
- * referencia.
- * 
- * @param input La cadena de texto en la que se van a reemplazar los caracteres especiales.
- * @return La cadena de texto con los caracteres especiales reemplazados.
- */
-/*-----------------------------------------------------------------------------*/
-String convertSpecialCharactersToHEX(String input) 
-{
-    convertSpecialCharactersToHEX_ref(input);
-    return input;
-}
-
-
-
-
 /******************************************************************************/
 /******************************************************************************/
 
@@ -0,0 +1,113 @@
+/**
+ * @file HAL.h
+ * @brief Capa de abstracción del hardware: lo único del sketch que depende directamente del SAM3X8E
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Casi todo el sketch habla con el hardware a través de las librerías de Arduino (SD, SPI, Serial1,
+ * millis(), attachInterrupt()...), que tienen una implementación para el PC en el simulador
+ * (tools/host_sim). Solo quedan cuatro accesos directos al micro:
+ *
+ *      - Los registros PIO con los que la ISR de DRDY saca los 24 bits del HX711 (HX711_Sampler.h).
+ *      - El registro PIO de la CS de la pantalla, que sube y baja en cada trama SPI (RA8876_v2.cpp).
+ *      - La instrucción WFI con la que el planificador duerme el núcleo (Scheduler.h).
+ *      - La DMA con la que se envían por SPI los bloques de las imágenes a la pantalla (RA8876_v2.cpp).
+ *
+ * Aquí se reúnen detrás de unas pocas funciones inline. En el Due compilan a los mismos accesos a
+ * registros que antes; con HOST_SIM (lo define la orden de compilación del simulador) pasan por
+ * digitalRead()/digitalWrite() y por el reloj virtual del simulador.
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <SPI.h> // halSpiEnviar()
+
+
+#if defined(HOST_SIM)
+// ------ SIMULADOR EN PC (tools/host_sim) -----------------------------------------
+typedef struct {
+    byte    pin;
+} halPin_t;
+
+void hostDormir(); // Definida en el simulador: avanza el reloj virtual hasta la próxima interrupción
+
+inline halPin_t halPinRapido(byte pin){ halPin_t p = { pin }; return p; };
+inline bool     halLeerPin(const halPin_t &p){ return digitalRead(p.pin) == HIGH; };
+inline void     halPinAlto(const halPin_t &p){ digitalWrite(p.pin, HIGH); };
+inline void     halPinBajo(const halPin_t &p){ digitalWrite(p.pin, LOW); };
+inline void     halDormir(){ hostDormir(); };
+inline void     halSpiEnviar(byte *buf, uint16_t n){ SPI.transfer(buf, n); };
+// -----------------------------------------------------------------------------
+
+#else
+// ------ ARDUINO DUE (SAM3X8E) ----------------------------------------------------
+typedef struct {
+    Pio*        pio;    // Puerto PIO del pin
+    uint32_t    mask;   // Máscara del pin en su puerto
+} halPin_t;
+
+inline halPin_t halPinRapido(byte pin){ halPin_t p = { g_APinDescription[pin].pPort, g_APinDescription[pin].ulPin }; return p; };
+inline bool     halLeerPin(const halPin_t &p){ return (p.pio->PIO_PDSR & p.mask) != 0; };  // Nivel del pin (PDSR)
+inline void     halPinAlto(const halPin_t &p){ p.pio->PIO_SODR = p.mask; };                // Salida a nivel alto (SODR)
+inline void     halPinBajo(const halPin_t &p){ p.pio->PIO_CODR = p.mask; };                // Salida a nivel bajo (CODR)
+inline void     halDormir(){ __WFI(); };                                                    // Dormir el núcleo hasta la siguiente interrupción
+inline void     halSpiEnviar(byte *buf, uint16_t n);                                        // Enviar un bloque por SPI0 con la DMA
+// -----------------------------------------------------------------------------
+
+
+#define HAL_DMAC_CANAL_SPI      0   // Canal del DMAC para el envío por SPI0
+#define HAL_DMAC_PER_SPI0_TX    1   // Interfaz de handshake de SPI0 TX (datasheet SAM3X, 22.5)
+#define HAL_SPI_PCS_SS_DEFECTO  0x7 // PCS del NPCS3 (pin 78), el que usa SPI.transfer() sin pin
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Envía 'n' bytes (máx. 4095) por SPI0 con el DMAC y espera a que salga el último. El CS lo
+ *        gestiona quien llama, igual que con SPI.transfer().
+ *
+ *        La librería SPI trabaja con selección de periférico variable (el PCS va en cada escritura
+ *        de TDR), pero la DMA solo escribe el dato. Durante el envío se fija el PCS del NPCS3 en
+ *        SPI_MR para que se use la configuración de la última beginTransaction() (reloj y modo).
+ *        Lo recibido se descarta.
+ */
+/*-----------------------------------------------------------------------------*/
+inline void halSpiEnviar(byte *buf, uint16_t n)
+{
+    static bool dmacIniciado = false;
+    if(!dmacIniciado)
+    {
+        pmc_enable_periph_clk(ID_DMAC);
+        DMAC->DMAC_EN = 0;
+        DMAC->DMAC_GCFG = DMAC_GCFG_ARB_CFG_FIXED;
+        DMAC->DMAC_EN = DMAC_EN_ENABLE;
+        dmacIniciado = true;
+    }
+
+    uint32_t mr = SPI0->SPI_MR;
+    SPI0->SPI_MR = (mr & ~(SPI_MR_PS | SPI_MR_PCS_Msk)) | SPI_MR_PCS(HAL_SPI_PCS_SS_DEFECTO);
+
+    DmacCh_num &canal = DMAC->DMAC_CH_NUM[HAL_DMAC_CANAL_SPI];
+    DMAC->DMAC_CHDR = DMAC_CHDR_DIS0 << HAL_DMAC_CANAL_SPI;
+    canal.DMAC_SADDR = (uint32_t)buf;
+    canal.DMAC_DADDR = (uint32_t)&SPI0->SPI_TDR;
+    canal.DMAC_DSCR = 0;
+    canal.DMAC_CTRLA = n | DMAC_CTRLA_SRC_WIDTH_BYTE | DMAC_CTRLA_DST_WIDTH_BYTE;
+    canal.DMAC_CTRLB = DMAC_CTRLB_SRC_DSCR | DMAC_CTRLB_DST_DSCR | DMAC_CTRLB_FC_MEM2PER_DMA_FC |
+                       DMAC_CTRLB_SRC_INCR_INCREMENTING | DMAC_CTRLB_DST_INCR_FIXED;
+    canal.DMAC_CFG = DMAC_CFG_DST_PER(HAL_DMAC_PER_SPI0_TX) | DMAC_CFG_DST_H2SEL | DMAC_CFG_SOD | DMAC_CFG_FIFOCFG_ALAP_CFG;
+    DMAC->DMAC_CHER = DMAC_CHER_ENA0 << HAL_DMAC_CANAL_SPI;
+
+    while(DMAC->DMAC_CHSR & (DMAC_CHSR_ENA0 << HAL_DMAC_CANAL_SPI));   // Todo copiado a TDR
+    while(!(SPI0->SPI_SR & SPI_SR_TXEMPTY));                            // Último byte fuera del bus
+    (void)SPI0->SPI_RDR;                                                // Descartar lo recibido y el overrun
+    (void)SPI0->SPI_SR;
+
+    SPI0->SPI_MR = mr;
+}
+
+#endif
+
+
+#endif
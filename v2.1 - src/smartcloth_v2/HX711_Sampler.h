@@ -0,0 +1,220 @@
+/**
+ * @file HX711_Sampler.h
+ * @brief Muestreo no bloqueante del HX711 dirigido por la señal DRDY (DOUT)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * El HX711 baja DOUT cuando tiene una conversión lista (DRDY). En lugar de pedir
+ * lecturas bloqueantes desde el timer (scale.get_units(3), cientos de ms a 10 SPS
+ * dentro de una ISR), se adjunta una interrupción al flanco de bajada de DOUT que
+ * saca los 24 bits de la muestra con acceso directo a los registros PIO (HAL.h) y
+ * guarda la cuenta bruta en un buffer circular.
+ *
+ * El buffer circular es de un solo productor (ISR de DOUT) y un solo consumidor
+ * (loop, a través de checkBascula()), por lo que no necesita deshabilitar
+ * interrupciones: la ISR solo escribe 'headMuestras' y el loop solo escribe
+ * 'tailMuestras'. Ambos índices son de tipo byte, cuya escritura es atómica en el Cortex-M3.
+ *
+ * @note La tara y la conversión a gramos se siguen haciendo con el offset y la escala
+ *       del objeto 'scale' de la librería HX711, pero sin volver a leer del HX711
+ *       (lo que competiría con la ISR por el reloj SCK).
+ *
+ * @see Scale.h
+ */
+
+#ifndef HX711_SAMPLER_H
+#define HX711_SAMPLER_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC
+#include "HAL.h"   // Acceso directo a los pines DOUT y SCK
+#include "Debug_Log.h" // LOG_SM()
+
+
+#define SAMPLER_BUFFER_SIZE     64      // Tamaño del buffer circular de muestras (potencia de 2). A 10 SPS son 6.4 seg de margen
+#define SAMPLER_BUFFER_MASK     (SAMPLER_BUFFER_SIZE - 1)
+#define SAMPLER_PULSOS_GAIN_128 25      // 24 bits de dato + 1 pulso para seleccionar canal A con ganancia 128
+
+
+// ------ BUFFER CIRCULAR DE MUESTRAS (ISR --> loop) ----------------------------
+volatile long     bufferMuestras[SAMPLER_BUFFER_SIZE];  // Cuentas brutas del HX711 (24 bits con signo extendido)
+volatile byte     headMuestras = 0;                     // Siguiente posición a escribir (solo la modifica la ISR)
+volatile byte     tailMuestras = 0;                     // Siguiente posición a leer (solo la modifica el loop)
+// ------------------------------------------------------------------------------
+
+// ------ ESTADÍSTICAS DEL MUESTREO ---------------------------------------------
+volatile unsigned long  nMuestrasTotales  = 0;      // Muestras leídas por la ISR desde el arranque
+volatile unsigned long  nMuestrasPerdidas = 0;      // Muestras descartadas por tener el buffer lleno
+volatile unsigned long  maxTiempoISRMuestra = 0;    // Tiempo máximo (us) de una ISR de muestreo
+// ------------------------------------------------------------------------------
+
+// ------ ACCESO DIRECTO A PINES (PIO) ------------------------------------------
+halPin_t  pinDOUT;          // Pin DOUT del HX711
+halPin_t  pinSCK;           // Pin SCK del HX711
+// ------------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+void            setupSampler(byte doutPin, byte sckPin);    // Preparar acceso directo a pines y adjuntar interrupción de DRDY
+void            ISR_muestraHX711();                         // ISR de flanco de bajada de DOUT: leer una muestra y guardarla en el buffer
+inline bool     isSamplerBufferEmpty(){ return headMuestras == tailMuestras; };     // Comprobar si hay muestras pendientes
+bool            popMuestraSampler(long &raw);               // Extraer la muestra más antigua del buffer
+void            printSamplerStats();                        // Mostrar tasa de muestreo, tiempo de ISR y muestras perdidas
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Prepara el acceso directo a los pines del HX711 y adjunta la interrupción
+ *        al flanco de bajada de DOUT (conversión lista).
+ *
+ * Debe llamarse tras scale.begin(), que configura los pines y la ganancia, y tras
+ * la tara inicial, que todavía lee del HX711 mediante la librería.
+ *
+ * @param doutPin Pin DOUT del HX711
+ * @param sckPin Pin SCK del HX711
+ */
+/*-----------------------------------------------------------------------------*/
+void setupSampler(byte doutPin, byte sckPin)
+{
+    pinDOUT = halPinRapido(doutPin);
+    pinSCK  = halPinRapido(sckPin);
+
+    headMuestras = 0;
+    tailMuestras = 0;
+
+    attachInterrupt(digitalPinToInterrupt(doutPin), ISR_muestraHX711, FALLING);
+
+    #if defined(SM_DEBUG)
+        SerialPC.println(F("Sampler HX711 por DRDY activado"));
+    #endif
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief ISR del flanco de bajada de DOUT. Saca una muestra de 24 bits del HX711
+ *        y la guarda en el buffer circular.
+ *
+ * Los propios bits del dato provocan flancos en DOUT mientras se leen, que vuelven
+ * a disparar esta ISR. Por eso se comprueba primero que DOUT siga en bajo: si está
+ * en alto no hay conversión pendiente y se descarta la interrupción.
+ *
+ * Cada pulso de SCK dura ~1 us en alto (mín. 0.2 us y máx. 60 us según datasheet),
+ * por lo que la ISR completa ronda los 50 us.
+ */
+/*-----------------------------------------------------------------------------*/
+void ISR_muestraHX711()
+{
+    if(halLeerPin(pinDOUT)) return; // DOUT en alto --> flanco espurio provocado por la lectura anterior
+
+    unsigned long inicioISR = micros();
+
+    unsigned long valor = 0;
+    for(byte i = 0; i < SAMPLER_PULSOS_GAIN_128; i++)
+    {
+        halPinAlto(pinSCK);             // SCK alto
+        delayMicroseconds(1);
+        if(i < 24)
+        {
+            valor <<= 1;
+            if(halLeerPin(pinDOUT)) valor |= 1;
+        }
+        halPinBajo(pinSCK);             // SCK bajo
+        delayMicroseconds(1);
+    }
+
+    // Extender el signo del complemento a 2 de 24 bits (~0xFFFFFF: también con 'long' de 64 bits en el PC)
+    if(valor & 0x800000UL) valor |= ~0xFFFFFFUL;
+
+    byte nextHead = (headMuestras + 1) & SAMPLER_BUFFER_MASK;
+    if(nextHead != tailMuestras)
+    {
+        bufferMuestras[headMuestras] = (long)valor;
+        headMuestras = nextHead;
+    }
+    else nMuestrasPerdidas++; // Buffer lleno: se pierde la muestra más reciente
+
+    nMuestrasTotales++;
+    postTarea(TAREA_BASCULA); // Despertar al loop para que filtre la muestra (Scheduler.h)
+
+    unsigned long tiempoISR = micros() - inicioISR;
+    if(tiempoISR > maxTiempoISRMuestra) maxTiempoISRMuestra = tiempoISR;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Extrae la muestra más antigua del buffer circular.
+ *
+ * Si DOUT está en bajo con el buffer vacío, se ha perdido el flanco de una
+ * conversión (p.ej. llegó mientras otra ISR del mismo puerto estaba en curso),
+ * así que se lee la muestra desde aquí con las interrupciones deshabilitadas.
+ *
+ * @param raw Cuenta bruta extraída
+ * @return 'true' si había alguna muestra pendiente
+ */
+/*-----------------------------------------------------------------------------*/
+bool popMuestraSampler(long &raw)
+{
+    if(isSamplerBufferEmpty() and !halLeerPin(pinDOUT))
+    {
+        noInterrupts();
+        ISR_muestraHX711();
+        interrupts();
+    }
+
+    if(isSamplerBufferEmpty()) return false;
+
+    raw = bufferMuestras[tailMuestras];
+    tailMuestras = (tailMuestras + 1) & SAMPLER_BUFFER_MASK;
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra las estadísticas del muestreo: tasa de muestreo desde el arranque,
+ *        tiempo máximo de ISR y muestras perdidas.
+ */
+/*-----------------------------------------------------------------------------*/
+void printSamplerStats()
+{
+    #if defined(SM_DEBUG)
+        noInterrupts();
+        unsigned long total = nMuestrasTotales;
+        unsigned long perdidas = nMuestrasPerdidas;
+        unsigned long maxISR = maxTiempoISRMuestra;
+        interrupts();
+
+        LOG_SM(LOG_SAMPLER, total, perdidas, maxISR);
+    #endif
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
@@ -8,8 +8,8 @@
  *
  * Este archivo contiene las definiciones de las funciones utilizadas para la 
  * activación y detección de interrupciones causadas por la pulsación de algún
- * botón en cualquiera de las botoneras (grande y main) y por el timer de interrupción
- * utilizado para la lectura de la báscula cada 0.5 seg.
+ * botón en cualquiera de las botoneras (grande y main). La báscula se lee desde la
+ * interrupción de dato listo (DRDY) del HX711, definida en HX711_Sampler.h.
  *
  * @note Este archivo asume la existencia del siguiente archivo de encabezado:
  *       - "Scale.h" para la definición de las funciones de la báscula
@@ -39,19 +39,16 @@ const byte intPinBarcode = 53;
 // -----------------------------------------------
 
 
-// ------------ FLAGS DE INTERRUPCIÓN ------------
-// Flag de botón pulsado en Main (botonera B)
-volatile byte buttonMain = 0; // Variable que almacena el botón pulsado
-// En lugar de una sola variable cuyo valor indique el botón pulsado, podríamos tener 5 variables booleanas
-// que indiquen si se ha pulsado cada botón. Pero como no deberían pulsar varios a la vez, no es necesario.
-// Es más rápido usar una sola variable tipo byte que almacenar 5 booleanas. Para "desactivar" el botón pulsado
-// se pone a 0 y ya está.
+// ------------ COLAS DE INTERRUPCIÓN ------------
+// Cada ISR añade sus pulsaciones (con su millis()) a su propia cola y el loop las saca
+// en orden, así que una pulsación no se pierde aunque el loop tarde en atenderla. Además
+// publica TAREA_BOTONES para despertar al loop, que la atiende sin esperar a ningún periodo.
+#include "Event_Queue.h"
+#include "Scheduler.h"
 
-// Flag de botón pulsado en Grande (botonera A)
-volatile bool pulsandoGrande  = false;    
-
-// Flag de botón pulsado en Barcode
-volatile bool pulsandoBarcode = false;
+colaEventos_t colaMain;       // Botón pulsado en Main (botonera B): 1 cocinado, 2 crudo, 3 añadir, 4 borrar, 5 guardar
+colaEventos_t colaGrande;     // Pulsación en Grande (botonera A). El botón se lee de la matriz al sacarla de la cola
+colaEventos_t colaBarcode;    // Pulsación en Barcode
 //volatile bool firstInterruptBarcode = true; // Al encender, por fluctuaciones de voltaje se detecta una pulsación fantasma
 // -----------------------------------------------
 
@@ -66,12 +63,10 @@ volatile bool pulsandoBarcode = false;
 #include "SAMDUE_ISR_Timer.h"
 
 #define HW_TIMER_INTERVAL_MS     10
-#define TIMER_INTERVAL_5MS       500L
 
 SAMDUE_ISR_Timer ISR_Timer;
 
-volatile float  actualWeight = 0.0;   ///< Peso real tomado por ISR
-volatile bool   pesado = false;       // Flag de haber pesado por ISR
+volatile float  actualWeight = 0.0;   ///< Peso real (filtrado) calculado en checkBascula() a partir de las muestras del sampler
 // ------------------------------------------------------
 
 
@@ -100,7 +95,6 @@ void ISR_barcode();                       // ISR de botón de barcode
 
 // Báscula
 void TimerHandler();                      // Activar timer de interrupción de la báscula
-void ISR_pesarBascula();                  // Activar báscula para pesar cuando salte timer de interrupción
 uint16_t attachDueInterrupt(double microseconds, timerCallback callback, const char* TimerName);     // Adjuntar interrupción al timer
 
 // Avisos de interrupción
@@ -135,7 +129,7 @@ void ISR_cocinado()
 { 
     static unsigned long last_interrupt_time = 0;
     unsigned long interrupt_time = millis();
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) buttonMain = 1;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaMain, 1, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -149,7 +143,7 @@ void ISR_crudo()
 { 
     static unsigned long last_interrupt_time = 0;
     unsigned long interrupt_time = millis();
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) buttonMain = 2;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaMain, 2, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -164,7 +158,7 @@ void ISR_addPlato()
 { 
     static unsigned long last_interrupt_time = 0;
     unsigned long interrupt_time = millis();
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) buttonMain = 3;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaMain, 3, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -179,7 +173,7 @@ void ISR_deletePlato()
 { 
     static unsigned long last_interrupt_time = 0;
     unsigned long interrupt_time = millis();
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) buttonMain = 4;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaMain, 4, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -194,7 +188,7 @@ void ISR_guardar()
 { 
     static unsigned long last_interrupt_time = 0;
     unsigned long interrupt_time = millis();
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) buttonMain = 5;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaMain, 5, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -216,7 +210,7 @@ void ISR_pulsandoButtonsGrande()
 {
     static unsigned long last_interrupt_time = 0;
     unsigned long interrupt_time = millis();
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) pulsandoGrande = true;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaGrande, 0, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -239,7 +233,7 @@ void ISR_barcode()
     // el programa final. De hecho, creo que está haciendo que se ignore la primera pulsación real.
     //if (firstInterruptBarcode) { firstInterruptBarcode = false; return; } // Descartar la primera interrupción por fluctuaciones de voltaje
     
-    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME) pulsandoBarcode = true;
+    if ((interrupt_time - last_interrupt_time) > DEBOUNCE_TIME){ pushCola(colaBarcode, 0, interrupt_time); postTarea(TAREA_BOTONES); }
     last_interrupt_time = interrupt_time;
 }
 
@@ -257,18 +251,6 @@ void ISR_barcode()
 void TimerHandler() { ISR_Timer.run(); }
 
 
-/*-----------------------------------------------------------------------------*/
-/**
- * @brief Activar báscula para pesar cuando salte timer de interrupción
- */
- /*-----------------------------------------------------------------------------*/
- void ISR_pesarBascula()
- {  
-    actualWeight = weighScale();
-    pesado = true; 
-}
-
-
 /*-----------------------------------------------------------------------------*/
 /**
  * @brief Adjuntar interrupción al timer
@@ -309,7 +291,7 @@ void TimerHandler() { ISR_Timer.run(); }
  /*-----------------------------------------------------------------------------*/
  bool interruptionOccurred()
  {
-    if((buttonMain != 0) or (pulsandoGrande)  or (pulsandoBarcode) or (scaleEventOccurred)) return true;
+    if(buttonInterruptOccurred() or (scaleEventOccurred)) return true;
     else return false;
  }
 
@@ -322,7 +304,7 @@ void TimerHandler() { ISR_Timer.run(); }
  /*-----------------------------------------------------------------------------*/
  bool buttonInterruptOccurred()
  {
-    if((buttonMain != 0) or (pulsandoGrande) or (pulsandoBarcode)) return true;
+    if(!isColaVacia(colaMain) or !isColaVacia(colaGrande) or !isColaVacia(colaBarcode)) return true;
     else return false;
  }
 
@@ -335,7 +317,7 @@ void TimerHandler() { ISR_Timer.run(); }
  /*-----------------------------------------------------------------------------*/
  bool mainButtonInterruptOccurred()
  {
-    if(buttonMain != 0) return true;
+    if(!isColaVacia(colaMain)) return true;
     else return false;
  }
 
@@ -347,7 +329,7 @@ void TimerHandler() { ISR_Timer.run(); }
  /*-----------------------------------------------------------------------------*/
  bool grandeButtonInterruptOccurred()
  {
-    if(pulsandoGrande) return true;
+    if(!isColaVacia(colaGrande)) return true;
     else return false;
  }
 
@@ -359,7 +341,7 @@ void TimerHandler() { ISR_Timer.run(); }
  /*-----------------------------------------------------------------------------*/
  bool barcodeButtonInterruptOccurred()
  {
-    if(pulsandoBarcode) return true;
+    if(!isColaVacia(colaBarcode)) return true;
     else return false;
  }
 
@@ -0,0 +1,85 @@
+/**
+ * @file Log_Diccionario.h
+ * @brief Diccionario de mensajes del log binario (Debug_Log.h): ID y texto de formato de cada uno
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * En el Due solo se compilan los ID (enum 'idLog_t'); los textos solo los usa el decodificador del
+ * PC (tools/debug_log), que incluye este fichero con LOG_CON_TEXTOS definido.
+ *
+ * Para añadir un mensaje se añade una línea X(ID, "formato") AL FINAL (los ID son la posición en
+ * la lista y así los logs grabados antes se siguen pudiendo decodificar) y se llama a
+ * LOG_SM(ID, argumentos...) con los argumentos en el orden del formato:
+ *
+ *      %d %u %x    Entero (4 bytes)
+ *      %f %.Nf     float (4 bytes)
+ *      %E          event_t, se muestra su nombre
+ *      %S          state_t, se muestra su nombre
+ *      %s          Texto (char* o String), hasta LOG_MAX_TEXTO caracteres
+ */
+
+#ifndef LOG_DICCIONARIO_H
+#define LOG_DICCIONARIO_H
+
+
+#define LOG_DICCIONARIO(X) \
+    X(LOG_PERDIDOS,                 "*** %u mensajes del log descartados (buffer lleno) ***") \
+    X(LOG_BOTON_GRUPO,              "Boton pulsado (grupo): %u") \
+    X(LOG_BOTON_ACCION,             "Boton pulsado (accion): %E") \
+    X(LOG_BOTON_BARCODE,            "Boton pulsado: BARCODE") \
+    X(LOG_BASCULA_TARANDO,          "TARANDO") \
+    X(LOG_BASCULA_EVENTO,           "Bascula: %E | Peso anterior: %.2f  Peso actual: %.2f  Peso bascula: %.2f  Peso a retirar: %.2f  Peso recipiente: %.2f  Peso plato: %.2f") \
+    X(LOG_SAMPLER,                  "Sampler HX711 | Muestras: %u  Perdidas: %u  Max ISR: %u us") \
+    X(LOG_EVENTO_ANADIDO,           "EVENTO --> ACTIVANDO MAQUINA DE ESTADOS: %E  (eventos pendientes: %u)") \
+    X(LOG_COLA_LLENA,               "Cola de eventos llena. Evento %E descartado") \
+    X(LOG_EVALUANDO_EVENTO,         "Evaluando evento: %E (ocurrido hace %u ms)") \
+    X(LOG_ERROR_EVENTO,             "ERROR... Ninguna regla para %E en %S") \
+    X(LOG_TRANSICION,               "Estado anterior: %S --> Nuevo estado: %S  (ultimo estado valido: %S)") \
+    X(LOG_ESP32_MENSAJE,            "---> Mensaje completo del ESP32: \"%s\"") \
+    X(LOG_ESP32_NO_RECONOCIDO,      "Mensaje incompleto o no reconocido: %s") \
+    X(LOG_ESP32_TIMEOUT,            "TIMEOUT. No se ha recibido respuesta del ESP32") \
+    X(LOG_ESP32_INTERRUPCION,       "Interrupcion mientras se leia barcode") \
+    X(LOG_WIFI_COMPROBANDO,         "Comprobando la conexion WiFi del ESP32...") \
+    X(LOG_WIFI_OK,                  "Dice que hay wifi") \
+    X(LOG_WIFI_NO,                  "Dice que NO hay wifi") \
+    X(LOG_WIFI_TIMEOUT,             "TIMEOUT. Sin respuesta del ESP32 al comprobar la conexion WiFi") \
+    X(LOG_WIFI_DESCONOCIDO,         "Error desconocido al comprobar la conexion WiFi...") \
+    X(LOG_GUARDAR_INDICANDO,        "Indicando que se quiere guardar...") \
+    X(LOG_GUARDAR_ESPERANDO,        "El ESP32 esta esperando la info...") \
+    X(LOG_GUARDAR_NO_WIFI,          "Se ha perdido la conexion WiFi...") \
+    X(LOG_GUARDAR_HTTP_ERROR,       "Error HTTP al autenticarse en la database...") \
+    X(LOG_GUARDAR_TIMEOUT,          "TIMEOUT. Sin respuesta del ESP32 al indicar guardado") \
+    X(LOG_GUARDAR_DESCONOCIDO,      "Error desconocido al indicar que se quiere guardar...") \
+    X(LOG_BARCODE_PIDIENDO,         "Pidiendo escanear barcode...") \
+    X(LOG_BARCODE_CANCELANDO,       "Indicando al ESP32 que cancele la lectura...") \
+    X(LOG_BARCODE_LEIDO,            "Codigo de barras leido: %s") \
+    X(LOG_BARCODE_NO_LEIDO,         "No se ha podido leer el codigo de barras") \
+    X(LOG_BARCODE_TIMEOUT,          "TIMEOUT. Sin respuesta del ESP32 al pedir leer barcode") \
+    X(LOG_BARCODE_DESCONOCIDO,      "Mensaje o error desconocido al pedir leer barcode...") \
+    X(LOG_PRODUCTO_PIDIENDO,        "Pidiendo buscar producto...") \
+    X(LOG_PRODUCTO_INFO,            "Informacion del producto: %s") \
+    X(LOG_PRODUCTO_NO_ENCONTRADO,   "No se ha encontrado el producto %s en OpenFoodFacts") \
+    X(LOG_PRODUCTO_SIN_SERVIDOR,    "El servidor de OpenFoodFacts no responde") \
+    X(LOG_PRODUCTO_HTTP_ERROR,      "Error al buscar info del producto (peticion HTTP GET): %s") \
+    X(LOG_PRODUCTO_TIMEOUT,         "TIMEOUT. Sin respuesta del ESP32 al pedir buscar info de producto") \
+    X(LOG_PRODUCTO_DESCONOCIDO,     "Mensaje no reconocido: %s") \
+    X(LOG_DASHBOARD_ZONA,           "Dashboard zona %u (%s) | Campos redibujados: %u  Bytes SPI: %u") \
+    X(LOG_DASHBOARD_ZONA_US,        "Dashboard zona %u (%s) | Campos redibujados: %u  Bytes SPI: %u  Tiempo: %u us") \
+    X(LOG_TIMELINE,                 "Animacion %s | %u ms, %u fotogramas (%u fps)  CPU por fotograma: media %u us, max %u us  SPI: %u bytes/fotograma  Pasos saltados: %u") \
+    X(LOG_LISTA_LLENA,              "Lista de la comida llena (%u de %u bytes). Registro de %u bytes descartado")
+
+
+#define LOG_ID(id, formato)     id,
+typedef enum { LOG_DICCIONARIO(LOG_ID) NUM_MENSAJES_LOG } idLog_t;
+#undef LOG_ID
+
+#if defined(LOG_CON_TEXTOS)
+    #define LOG_TEXTO(id, formato)  formato,
+    const char *formatosLog[NUM_MENSAJES_LOG] = { LOG_DICCIONARIO(LOG_TEXTO) };
+    #undef LOG_TEXTO
+#endif
+
+
+#endif
@@ -104,7 +104,7 @@ class Plato{
      * 
      * @return Peso del plato
      */
-    inline float getPesoPlato(){ return _peso; };
+    inline float getPesoPlato() const { return _peso; };
     
 
 
@@ -117,7 +117,7 @@ class Plato{
      * 
      * @param alimento Alimento a añadir
      */
-    void addAlimentoPlato(Alimento alimento);         
+    void addAlimentoPlato(const Alimento &alimento);         
 
 
 
@@ -130,21 +130,21 @@ class Plato{
      * 
      * @param val Objeto ValoresNutricionales a partir del cual se establecen los valores
      */
-    inline void setValoresPlato(ValoresNutricionales val){ _valoresPlato.setValores(val); };
+    inline void setValoresPlato(const ValoresNutricionales &val){ _valoresPlato.setValores(val); };
 
     /**
      * @brief Obtiene los valores nutricionales del plato.
      * 
      * @return Los valores nutricionales del plato
      */
-    inline ValoresNutricionales getValoresPlato(){ return _valoresPlato; };
+    inline const ValoresNutricionales& getValoresPlato() const { return _valoresPlato; };
 
     /**
      * @brief Actualiza los valores nutricionales del plato según los valores de la porción de alimento pesado.
      * 
      * @param val Valores nutricionales del alimento
      */
-    void updateValoresPlato(ValoresNutricionales val); 
+    void updateValoresPlato(const ValoresNutricionales &val); 
 
 
 
@@ -198,7 +198,7 @@ Plato::Plato(){
                   alimento - Objeto Alimento con la información nutricional y peso de la porción del 
                              alimento pesado.
 ----------------------------------------------------------------------------------------------------------*/
-void Plato::addAlimentoPlato(Alimento alimento){
+void Plato::addAlimentoPlato(const Alimento &alimento){
     _setNumAlimentos(_getNumAlimentos() + 1);                        // Incrementar num alimentos
     setPesoPlato(getPesoPlato() + alimento.getPesoAlimento());       // Incrementar peso del plato
     updateValoresPlato(alimento.getValoresAlimento());                     // Actualizar Valores Nutricionales
@@ -218,13 +218,8 @@ void Plato::addAlimentoPlato(Alimento alimento){
           Parámetros: 
                   val - Valores nutricionales del alimento añadido al plato
 ----------------------------------------------------------------------------------------------------------*/
-void Plato::updateValoresPlato(ValoresNutricionales val){
-    float carb = _valoresPlato.getCarbValores() + val.getCarbValores();  
-    float lip = _valoresPlato.getLipValores() + val.getLipValores();
-    float prot = _valoresPlato.getProtValores() + val.getProtValores();
-    float kcal = _valoresPlato.getKcalValores() + val.getKcalValores();
-    ValoresNutricionales valAux(carb, lip, prot, kcal);
-    setValoresPlato(valAux);
+void Plato::updateValoresPlato(const ValoresNutricionales &val){
+    _valoresPlato.sumar(val);
 }
 
 
@@ -241,8 +236,7 @@ void Plato::updateValoresPlato(ValoresNutricionales val){
 void Plato::restorePlato(){
     _setNumAlimentos(0);                          // Nº alimentos = 0
     setPesoPlato(0.0);                            // Peso = 0.0
-    ValoresNutricionales valAux(0.0, 0.0, 0.0, 0.0);    // Crea un objeto ValoresNutricionales con todos sus valores a 0.0
-    setValoresPlato(valAux);                      // Valores = 0
+    _valoresPlato.setValoresMilesimas(0, 0, 0, 0);  // Valores = 0
 }
 
 
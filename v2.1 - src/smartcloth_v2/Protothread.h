@@ -0,0 +1,88 @@
+/**
+ * @file Protothread.h
+ * @brief Protohilos (protothreads): funciones reanudables que ceden la CPU entre pasos sin usar delay()
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Versión reducida de los protothreads de Adam Dunkels. El compilador del Due (gcc 4.8, C++11) no
+ * tiene corrutinas de C++20, así que una función reanudable guarda en 'pt_t' el punto por el que
+ * iba (la dirección de una etiqueta, extensión "labels as values" de gcc) y, al volver a llamarla,
+ * salta directamente ahí. Se usan etiquetas en lugar del 'switch' de la versión original para poder
+ * ceder dentro de los 'switch(option)' de las pantallas.
+ *
+ * Forma de una función reanudable:
+ *
+ *      char miPantalla(pt_t *pt, byte option)
+ *      {
+ *          static byte i;              // Lo que deba sobrevivir a una espera tiene que ser 'static'
+ *          PT_BEGIN(pt);
+ *          dibujarAlgo();
+ *          PT_ESPERAR(pt, 400);        // Cede la CPU y continúa aquí pasados 400 ms
+ *          for(i = 0; i < 4; i++){ dibujarPaso(i); PT_CEDER_SI_AGOTADO(pt); }
+ *          PT_END(pt);
+ *      }
+ *
+ * Devuelve PT_ESPERANDO mientras no haya terminado y PT_TERMINADA al acabar. Las variables locales
+ * no 'static' se pierden en cada espera; no se puede declarar una variable con inicializador entre
+ * dos puntos de espera (el salto la cruzaría). Cada etiqueta se nombra con __LINE__, así que solo
+ * puede haber un punto de espera por línea.
+ */
+
+#ifndef PROTOTHREAD_H
+#define PROTOTHREAD_H
+
+#include <stdint.h> // uintptr_t
+
+
+#define PT_ESPERANDO    0
+#define PT_TERMINADA    1
+
+#define PRESUPUESTO_PT_US   5000    // Tiempo máximo (us) que debería ocupar la CPU un protohilo antes de ceder
+
+
+typedef struct {
+    uintptr_t       lc;         // Dirección del punto por el que continuar (0 --> desde el principio)
+    unsigned long   espera;     // millis() de inicio de la espera en curso (PT_ESPERAR)
+} pt_t;
+
+
+unsigned long inicioRodajaPT = 0;   // micros() en que se ha reanudado el protohilo (lo fija quien lo reanuda)
+
+
+#define PT_CONCAT2(a, b)    a ## b
+#define PT_CONCAT(a, b)     PT_CONCAT2(a, b)
+#define PT_ETIQUETA         PT_CONCAT(pt_linea_, __LINE__)
+
+
+// ------ INICIO Y FIN --------------------------------------------------------------
+#define PT_INIT(pt)         ((pt)->lc = 0)
+#define PT_BEGIN(pt)        { if((pt)->lc != 0) goto *(void*)((pt)->lc);
+#define PT_END(pt)          (pt)->lc = 0; return PT_TERMINADA; }
+#define PT_EXIT(pt)         do{ (pt)->lc = 0; return PT_TERMINADA; }while(0)
+// -----------------------------------------------------------------------------
+
+// ------ ESPERAS -------------------------------------------------------------------
+// La dirección de la etiqueta se guarda como entero: guardada como puntero, gcc 12 la toma por la
+// de una variable local que sale de ámbito (-Wdangling-pointer), aunque el código es siempre válido.
+#define PT_GUARDAR(pt)      ((pt)->lc = (uintptr_t)&&PT_ETIQUETA)
+
+// Ceder la CPU y continuar en la siguiente reanudación
+#define PT_YIELD(pt)        do{ PT_GUARDAR(pt); return PT_ESPERANDO; PT_ETIQUETA: ; }while(0)
+
+// Ceder la CPU hasta que se cumpla la condición (se vuelve a evaluar en cada reanudación)
+#define PT_WAIT_UNTIL(pt, condicion)    do{ PT_GUARDAR(pt); PT_ETIQUETA: if(!(condicion)) return PT_ESPERANDO; }while(0)
+
+// Esperar 'ms' milisegundos sin bloquear: sustituye a delay()
+#define PT_ESPERAR(pt, ms)  do{ (pt)->espera = millis(); PT_WAIT_UNTIL(pt, (millis() - (pt)->espera) >= (unsigned long)(ms)); }while(0)
+
+// Ceder solo si ya se ha agotado el presupuesto de esta reanudación
+#define PT_CEDER_SI_AGOTADO(pt)         do{ if((micros() - inicioRodajaPT) >= PRESUPUESTO_PT_US) PT_YIELD(pt); }while(0)
+
+// Ejecutar otro protohilo (hijo) hasta que termine, cediendo la CPU cada vez que él la ceda
+#define PT_SPAWN(pt, hijo, llamada)     do{ PT_INIT(hijo); PT_WAIT_UNTIL(pt, (llamada) != PT_ESPERANDO); }while(0)
+// -----------------------------------------------------------------------------
+
+
+#endif
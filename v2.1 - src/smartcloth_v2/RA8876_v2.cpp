@@ -19,6 +19,11 @@ Version   : v2.0
 /* ************************************************************ */
 #pragma GCC diagnostic warning "-Wall"
 #include "RA8876_v2.h"
+#include "HAL.h" // halSpiEnviar() --> DMA
+
+// Bloque de píxeles de sdCardDraw16bppBINBurst(), sdCardDraw16bppQ565() y checksum16bpp(). En RAM estática: la DMA lee de aquí
+// Uno solo: la SD comparte SPI0 con la pantalla, así que un segundo bloque solo solaparía la descompresión Q565 con la DMA (2 KB más, sin medir aún en el Due)
+static uint8_t bloqueImagen[RA8876_BLOQUE_IMAGEN];
 
 /* ************************************************************ */
 /* Datasheet 8.1.2 SDRAM Connection: 
@@ -70,6 +75,8 @@ DisplayInfo defaultDisplayInfo =
    ************************************************************* */
 void RA8876::_hardReset(void)
 {
+    _forgetRegs();
+
     delay(5);
     digitalWrite(_resetPin, LOW);
     delay(5);
@@ -86,10 +93,12 @@ void RA8876::_hardReset(void)
    ************************************************************* */
 void RA8876::_softReset(void)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // Trigger soft reset
     _writeReg(RA8876_REG_SRR, 0x01);
+    _flushCmds();
+    _forgetRegs();
     delay(5);
 
     /* --- Esta parte es checkIcReady() en RA8876_Lite ------ */
@@ -103,7 +112,7 @@ void RA8876::_softReset(void)
         break;
     }
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return;
 }
@@ -113,10 +122,14 @@ void RA8876::_softReset(void)
    ************************************************************* */
 void RA8876::_writeCmd(uint8_t reg)
 {
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_CMD_WRITE);
     SPI.transfer(reg);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 2;
+    _selectedReg = reg;
 }
 
 /* *************************************************************
@@ -124,10 +137,19 @@ void RA8876::_writeCmd(uint8_t reg)
    ************************************************************* */
 void RA8876::_writeData(uint8_t data)
 {
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_DATA_WRITE);
     SPI.transfer(data);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 2;
+
+    if (_regCacheable(_selectedReg))
+    {
+      _regCache[_selectedReg] = data;
+      _regCacheValid[_selectedReg >> 5] |= 1UL << (_selectedReg & 31);
+    }
 }
 
 /* *************************************************************
@@ -140,11 +162,14 @@ void RA8876::_writeData(uint8_t data)
 void RA8876::_writeData16bits(uint16_t data) 
 {
     // Parecido a _writeData() de RA8876_v2, pero para 16bbp
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_DATA_WRITE);
     SPI.transfer(data);
     SPI.transfer(data>>8);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 3;
 }
 
 /* *************************************************************
@@ -152,10 +177,13 @@ void RA8876::_writeData16bits(uint16_t data)
    ************************************************************* */
 void RA8876::_writeData64bits(uint64_t data) 
 {
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_DATA_WRITE);
     SPI.transfer(&data, 8);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 9;
 }
 
 
@@ -164,13 +192,37 @@ void RA8876::_writeData64bits(uint64_t data)
    ************************************************************* */
 void RA8876::_writeData256bits(uint64_t *data) 
 {
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_DATA_WRITE);
     SPI.transfer(&data[0], 8);
     SPI.transfer(&data[1], 8);
     SPI.transfer(&data[2], 8);
     SPI.transfer(&data[3], 8);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 33;
+}
+
+
+/* *************************************************************
+    Enviar 'len' bytes tras ramAccessPrepare() en una sola ráfaga:
+    un único RA8876_DATA_WRITE con el CS activo todo el bloque, 
+    y los datos por DMA (halSpiEnviar()). 'data' se puede sobrescribir.
+    Abre su propia transacción porque entre bloques la librería SD 
+    deja el bus con su reloj.
+   ************************************************************* */
+void RA8876::_writeDataBurst(uint8_t *data, uint16_t len) 
+{
+    _beginTransaction();
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
+    SPI.transfer(RA8876_DATA_WRITE);
+    halSpiEnviar(data, len);
+    halPinAlto(_cs);
+    _bytesSPI += 1 + len;
+    _endTransaction();
 }
 
 
@@ -179,13 +231,34 @@ void RA8876::_writeData256bits(uint64_t *data)
    ************************************************************* */
 uint8_t RA8876::_readData(void)
 {
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_DATA_READ);
     uint8_t x = SPI.transfer(0);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 2;
     return x;
 }
 
+/* *************************************************************
+    Leer 'len' bytes tras _memoryReadPrepare() en una sola ráfaga:
+    un único RA8876_DATA_READ con el CS activo todo el bloque, 
+    igual que _writeDataBurst() al escribir.
+   ************************************************************* */
+void RA8876::_readDataBurst(uint8_t *data, uint16_t len)
+{
+    _beginTransaction();
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
+    SPI.transfer(RA8876_DATA_READ);
+    for (uint16_t i = 0; i < len; i++) data[i] = SPI.transfer(0);
+    halPinAlto(_cs);
+    _bytesSPI += 1 + len;
+    _endTransaction();
+}
+
 /* *************************************************************
     Reads the special status register.
     This register uses a special cycle type instead of having an 
@@ -196,20 +269,42 @@ uint8_t RA8876::_readData(void)
    ************************************************************* */
 uint8_t RA8876::_readStatus(void)
 {
-    digitalWrite(_csPin, LOW);
+    if (_nCmds) _flushCmds();
+
+    halPinBajo(_cs);
     SPI.transfer(RA8876_STATUS_READ);
     uint8_t x = SPI.transfer(0);
-    digitalWrite(_csPin, HIGH);
+    halPinAlto(_cs);
+    _bytesSPI += 2;
     return x;
 }
 
 /* *************************************************************
     lcdRegDataWrite() en RA8876_Lite
+
+    No se envía enseguida: se añade a la lista de comandos, que 
+    sale entera al cerrar la transacción más externa o antes del 
+    siguiente acceso de cualquier otro tipo (ver _flushCmds()). 
+    Si el registro es cacheable y ya tiene ese dato, no se añade.
    ************************************************************* */
 void RA8876::_writeReg(uint8_t reg, uint8_t data)
 {
-    _writeCmd(reg);
-    _writeData(data);
+    if (_regCacheable(reg))
+    {
+      if (_regCached(reg) && (_regCache[reg] == data))
+        return;
+
+      _regCache[reg] = data;
+      _regCacheValid[reg >> 5] |= 1UL << (reg & 31);
+    }
+
+    _beginTransaction();
+    if (_nCmds == RA8876_MAX_COMANDOS)
+      _flushCmds();
+    _cmds[_nCmds][0] = reg;
+    _cmds[_nCmds][1] = data;
+    _nCmds++;
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -218,10 +313,8 @@ void RA8876::_writeReg(uint8_t reg, uint8_t data)
    ************************************************************* */
 void RA8876::_writeReg16(uint8_t reg, uint16_t data)
 {
-    _writeCmd(reg);
-    _writeData(data & 0xFF);
-    _writeCmd(reg + 1);
-    _writeData(data >> 8);
+    _writeReg(reg, data & 0xFF);
+    _writeReg(reg + 1, data >> 8);
 }
 
 /* *************************************************************
@@ -230,21 +323,22 @@ void RA8876::_writeReg16(uint8_t reg, uint16_t data)
    ************************************************************* */
 void RA8876::_writeReg32(uint8_t reg, uint32_t data)
 {
-    _writeCmd(reg);
-    _writeData(data & 0xFF);
-    _writeCmd(reg + 1);
-    _writeData((data >> 8) & 0xFF);
-    _writeCmd(reg + 2);
-    _writeData((data >> 16) & 0xFF);
-    _writeCmd(reg + 3);
-    _writeData(data >> 24);
+    _writeReg(reg, data & 0xFF);
+    _writeReg(reg + 1, (data >> 8) & 0xFF);
+    _writeReg(reg + 2, (data >> 16) & 0xFF);
+    _writeReg(reg + 3, data >> 24);
 }
 
 /* *************************************************************
     lcdRegDataRead() en RA8876_Lite
+
+    Los registros cacheables ya escritos no se leen del chip.
    ************************************************************* */
 uint8_t RA8876::_readReg(uint8_t reg)
 {
+    if (_regCacheable(reg) && _regCached(reg))
+      return _regCache[reg];
+
     _writeCmd(reg);
     return _readData();
 }
@@ -257,15 +351,87 @@ uint16_t RA8876::_readReg16(uint8_t reg)
 {
     uint16_t v;
 
-    _writeCmd(reg);
-    v = _readData();
-    _writeCmd(reg + 1);
-    v |= _readData() << 8;
+    v = _readReg(reg);
+    v |= _readReg(reg + 1) << 8;
 
     return v;
 }
 
 
+/* *************************************************************
+    Abrir una transacción SPI con _spiSettings. Se pueden anidar: 
+    solo la más externa llama a SPI.beginTransaction(), así que 
+    dentro no se puede cambiar la velocidad ni usar la SD.
+   ************************************************************* */
+void RA8876::_beginTransaction(void)
+{
+    if (_transactionDepth++ == 0)
+      SPI.beginTransaction(_spiSettings);
+}
+
+/* *************************************************************
+    Cerrar una transacción. Al cerrar la más externa se envían las 
+    escrituras de registro que queden en la lista.
+   ************************************************************* */
+void RA8876::_endTransaction(void)
+{
+    if (--_transactionDepth == 0)
+    {
+      if (_nCmds) _flushCmds();
+      SPI.endTransaction();
+    }
+}
+
+/* *************************************************************
+    Enviar las escrituras de registro pendientes, en orden y dentro 
+    de la transacción abierta. La trama de comando se omite si el 
+    registro ya está seleccionado (p. ej. MRWDP dos veces seguidas 
+    en drawPixel()).
+   ************************************************************* */
+void RA8876::_flushCmds(void)
+{
+    uint8_t n = _nCmds;
+    _nCmds = 0; // Antes de _writeCmd() y _writeData(), que también vacían la lista
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+      if (_cmds[i][0] != _selectedReg)
+        _writeCmd(_cmds[i][0]);
+      _writeData(_cmds[i][1]);
+    }
+}
+
+/* *************************************************************
+    Olvidar el contenido de la caché de registros y el registro 
+    seleccionado (tras un reset del chip).
+   ************************************************************* */
+void RA8876::_forgetRegs(void)
+{
+    _nCmds = 0;
+    _selectedReg = 0xFFFF;
+    memset(_regCacheValid, 0, sizeof(_regCacheValid));
+}
+
+/* *************************************************************
+    Registros de configuración que el chip no cambia por su cuenta: 
+    modo texto (ICR), ventana principal, canvas y ventana activa, 
+    puntos de las figuras, BTE (menos BTE_CTRL0, que se borra al 
+    terminar) y texto (menos el cursor F_CURX/F_CURY). Quedan fuera 
+    los de estado, el cursor de memoria y los de arranque (DCR0, 
+    DCR1, BTE_CTRL0), que el chip modifica al avanzar o terminar.
+   ************************************************************* */
+bool RA8876::_regCacheable(uint16_t reg)
+{
+    return (reg == RA8876_REG_ICR) ||
+           ((reg >= RA8876_REG_MISA0) && (reg <= RA8876_REG_MWULY1)) ||
+           ((reg >= RA8876_REG_CVSSA0) && (reg <= RA8876_REG_AW_COLOR)) ||
+           ((reg >= RA8876_REG_DLHSR0) && (reg <= RA8876_REG_DTPV1)) ||
+           ((reg >= RA8876_REG_ELL_A0) && (reg <= RA8876_REG_DEVR1)) ||
+           ((reg >= RA8876_BTE_CTRL1) && (reg <= RA8876_BTE_HIG1)) ||
+           ((reg >= RA8876_REG_CCR0) && (reg <= RA8876_REG_BGCB));
+}
+
+
 //**************************************************************//
 /*[Status Register] bit7  Host Memory Write FIFO full
 0: Memory Write FIFO is not full.
@@ -274,12 +440,12 @@ Only when Memory Write FIFO is not full, MPU may write another one pixel.*/
 //**************************************************************//
 void RA8876::_checkWriteFifoNotFull(void)
 {  
-    SPI.beginTransaction(_spiSettings);  
+    _beginTransaction();  
     for(uint16_t i=0;i<10000;i++) //Please according to your usage to modify i value.
     {
       if( (_readStatus()&0x80)==0 ){break;} //lcdStatusRead() en RA8876_Lite
     }
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 //**************************************************************//
@@ -291,12 +457,12 @@ pixels, or 16bpp data 32 pixels, 24bpp data 16 pixels directly.*/
 //**************************************************************//
 void RA8876::_checkWriteFifoEmpty(void)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     for(uint16_t i=0;i<10000;i++)   //Please according to your usage to modify i value.
     {
       if( (_readStatus()&0x40)==0x40 ){break;} //lcdStatusRead() en RA8876_Lite
     }
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -446,7 +612,7 @@ bool RA8876::_initPLL(void)
     SerialPC.println("init PLL");
     #endif // RA8876_DEBUG
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     //SerialPC.print("DRAM_FREQ "); SerialPC.println(_memPll.freq);
     //SerialPC.print("7: "); SerialPC.println(_memPll.k << 1);
@@ -469,14 +635,17 @@ bool RA8876::_initPLL(void)
     _writeReg(RA8876_REG_PPLLC2, _scanPll.n);
 
     // Toggle bit 7 of the CCR register to trigger a reconfiguration of the PLLs
+    // (las esperas tienen que empezar con la escritura ya enviada)
     _writeReg(RA8876_REG_CCR, 0x00);
+    _flushCmds();
     delay(2);
     _writeReg(RA8876_REG_CCR, 0x80);
+    _flushCmds();
     delay(2);
 
     uint8_t ccr = _readReg(RA8876_REG_CCR);
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return (ccr & 0x80) ? true : false;
 }
@@ -523,7 +692,7 @@ bool RA8876::_initMemory(SdramInfo *info)
     else
       sdrmd |= info->casLatency & 0x03;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     #if defined(RA8876_DEBUG)
     SerialPC.print("SDRAR: "); SerialPC.println(sdrar);  // Expected: 0x29 (41 decimal)
@@ -543,6 +712,7 @@ bool RA8876::_initMemory(SdramInfo *info)
 
     // Trigger SDRAM initialization
     _writeReg(RA8876_REG_SDRCR, 0x01);
+    _flushCmds();
 
     // Wait for SDRAM to be ready
     uint8_t status;
@@ -554,7 +724,7 @@ bool RA8876::_initMemory(SdramInfo *info)
         break;
     }
 
-    SPI.endTransaction();
+    _endTransaction();
 
     #if defined(RA8876_DEBUG)
     SerialPC.println(status);
@@ -567,7 +737,7 @@ bool RA8876::_initMemory(SdramInfo *info)
    ************************************************************* */
 bool RA8876::_initDisplay()
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     
     // Set chip config register
     uint8_t ccr = _readReg(RA8876_REG_CCR);
@@ -671,7 +841,7 @@ bool RA8876::_initDisplay()
 
     // TODO: Track backlight pin and turn on backlight ==> se hace manualmente
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return true;
 }
@@ -738,7 +908,7 @@ void RA8876::_drawTwoPointShape(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
 {
     //SerialPC.println("_drawTwoPointShape");
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // First point
     _writeReg16(RA8876_REG_DLHSR0, x1);
@@ -765,7 +935,7 @@ void RA8876::_drawTwoPointShape(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
 
     //SerialPC.print(iter); SerialPC.println(" iterations");
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -774,7 +944,7 @@ void RA8876::_drawThreePointShape(uint16_t x1, uint16_t y1, uint16_t x2, uint16_
 {
     //SerialPC.println("_drawThreePointShape");
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // First point
     _writeReg16(RA8876_REG_DLHSR0, x1);
@@ -805,7 +975,7 @@ void RA8876::_drawThreePointShape(uint16_t x1, uint16_t y1, uint16_t x2, uint16_
 
     //SerialPC.print(iter); SerialPC.println(" iterations");
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -814,7 +984,7 @@ void RA8876::_drawEllipseShape(uint16_t x, uint16_t y, uint16_t xrad, uint16_t y
 {
     //SerialPC.println("_drawEllipseShape");
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // First point
     _writeReg16(RA8876_REG_DEHR0, x);
@@ -841,7 +1011,7 @@ void RA8876::_drawEllipseShape(uint16_t x, uint16_t y, uint16_t xrad, uint16_t y
 
     //SerialPC.print(iter); SerialPC.println(" iterations");
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -856,7 +1026,7 @@ void RA8876::_drawRoundRectShape(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
         //if (w > h && (radius * 2) >= h) radius = (h / 2) - 1;
         //if (radius == w || radius == h) drawRect(x1,y1,x2,y2,color);
         //else{
-            SPI.beginTransaction(_spiSettings);
+            _beginTransaction();
 
             // First point
             _writeReg16(RA8876_REG_DLHSR0, x1);
@@ -885,7 +1055,7 @@ void RA8876::_drawRoundRectShape(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
               iter++;
             }
 
-            SPI.endTransaction();
+            _endTransaction();
         //}
     }
 }
@@ -937,6 +1107,11 @@ RA8876::RA8876(int csPin, int resetPin)
 
     _oscClock = 10000;  // 10000kHz or 10MHz
 
+    _bytesSPI = 0;
+
+    _transactionDepth = 0;
+    _forgetRegs();
+
     _sdramInfo = &defaultSdramInfo;
 
     _displayInfo = &defaultDisplayInfo;
@@ -959,6 +1134,7 @@ bool RA8876::init(void)
     // Set up chip select pin
     pinMode(_csPin, OUTPUT);
     digitalWrite(_csPin, HIGH);
+    _cs = halPinRapido(_csPin);
 
     // Set up reset pin, if provided
     if (_resetPin >= 0)
@@ -1041,7 +1217,7 @@ void RA8876::initExternalFontRom(int spiIf, enum ExternalFontRom chip)
     SerialPC.print("External font SPI divisor: "); SerialPC.println(divisor);
     #endif // RA8876_DEBUG
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // Ensure SPI is enabled in chip config register
     uint8_t ccr = _readReg(RA8876_REG_CCR);
@@ -1061,7 +1237,7 @@ void RA8876::initExternalFontRom(int spiIf, enum ExternalFontRom chip)
     #endif // RA8876_DEBUG
     _writeReg(RA8876_REG_GTFNT_SEL, (chip & 0x07) << 5);
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1075,7 +1251,7 @@ bool RA8876::setCanvasRegion(uint32_t address, uint16_t width)
     else if ((width & 0x03) || (width > 0x1FFF))
       return false;  // Width must be multiple of 4 and fit in 13 bits
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // Set canvas start address
     _writeReg32(RA8876_REG_CVSSA0, address);
@@ -1094,7 +1270,7 @@ bool RA8876::setCanvasRegion(uint32_t address, uint16_t width)
 
     _writeReg(RA8876_REG_AW_COLOR, aw_color);
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return true;
 }
@@ -1109,7 +1285,7 @@ bool RA8876::setCanvasWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t he
     else if (y + height > 8191)
       return false;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
       
     // Set active window offset
     _writeReg16(RA8876_REG_AWUL_X0, x);
@@ -1119,7 +1295,7 @@ bool RA8876::setCanvasWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t he
     _writeReg16(RA8876_REG_AW_WTH0, width);
     _writeReg16(RA8876_REG_AW_HT0, height);
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return true;
 }
@@ -1128,56 +1304,56 @@ bool RA8876::setCanvasWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t he
    ************************************************************* */
 void RA8876::displayImageStartAddress(uint32_t addr)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg(RA8876_REG_MISA0,addr);//20h
     _writeReg(RA8876_REG_MISA1,addr>>8);//21h 
     _writeReg(RA8876_REG_MISA2,addr>>16);//22h  
     _writeReg(RA8876_REG_MISA3,addr>>24);//23h 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
 ************************************************************* */
 void RA8876::displayImageWidth(uint16_t width)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg(RA8876_REG_MIW0,width); //24h
     _writeReg(RA8876_REG_MIW1,width>>8); //25h 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
 ************************************************************* */
 void RA8876::displayWindowStartXY(uint16_t x0,uint16_t y0)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg(RA8876_REG_MWULX0,x0);//26h
     _writeReg(RA8876_REG_MWULX1,x0>>8);//27h
     _writeReg(RA8876_REG_MWULY0,y0);//28h
     _writeReg(RA8876_REG_MWULY1,y0>>8);//29h
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
 ************************************************************* */
 void RA8876::canvasImageStartAddress(uint32_t addr)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg(RA8876_REG_CVSSA0,addr);//50h
     _writeReg(RA8876_REG_CVSSA1,addr>>8);//51h
     _writeReg(RA8876_REG_CVSSA2,addr>>16);//52h
     _writeReg(RA8876_REG_CVSSA3,addr>>24);//53h  
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
 ************************************************************* */
 void RA8876::canvasImageWidth(uint16_t width)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg(RA8876_REG_CVS_IMWTH0,width);//54h
     _writeReg(RA8876_REG_CVS_IMWTH1,width>>8); //55h
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1189,7 +1365,7 @@ bool RA8876::setDisplayRegion(uint32_t address, uint16_t width)
     else if ((width & 0x03) || (width > 8188))
       return false;  // Width must be multiple of 4 and max 8188
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     
     // Set main window start address
     _writeReg32(RA8876_REG_MISA0, address);
@@ -1197,7 +1373,7 @@ bool RA8876::setDisplayRegion(uint32_t address, uint16_t width)
     // Set main window image width
     _writeReg16(RA8876_REG_MIW0, width);
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return true;
 }
@@ -1211,13 +1387,13 @@ bool RA8876::setDisplayOffset(uint16_t x, uint16_t y)
     else if (y > 8191)
       return false;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     // Set main window offset
     _writeReg16(RA8876_REG_MWULX0, x & 0xFFFC);  // Low two bits must be zero
     _writeReg16(RA8876_REG_MWULY0, y);
 
-    SPI.endTransaction();
+    _endTransaction();
 
     return true;
 }
@@ -1230,7 +1406,7 @@ bool RA8876::setDisplayOffset(uint16_t x, uint16_t y)
    ************************************************************* */
 void RA8876::colorBarTest(bool enabled)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     uint8_t dpcr = _readReg(RA8876_REG_DPCR);
 
@@ -1241,7 +1417,7 @@ void RA8876::colorBarTest(bool enabled)
 
     _writeReg(RA8876_REG_DPCR, dpcr);
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1249,9 +1425,9 @@ void RA8876::colorBarTest(bool enabled)
    ************************************************************* */
 void RA8876::ramAccessPrepare(void)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeCmd(RA8876_REG_MRWDP); //lcdRegWrite()  en RA8876_Lite
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1263,7 +1439,7 @@ void RA8876::selectInternalFont(enum FontSize size, enum FontEncoding enc)
     _fontSize   = size;
     _fontFlags  = 0;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _writeReg(RA8876_REG_CCR0, 0x00 | ((size & 0x03) << 4) | _internalFontEncoding(enc));
 
@@ -1271,7 +1447,7 @@ void RA8876::selectInternalFont(enum FontSize size, enum FontEncoding enc)
     ccr1 |= 0x40;  // Transparent background
     _writeReg(RA8876_REG_CCR1, ccr1);
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1283,7 +1459,7 @@ void RA8876::selectExternalFont(enum ExternalFontFamily family, enum FontSize si
     _fontSize   = size;
     _fontFlags  = flags;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     #if defined(RA8876_DEBUG)
     SerialPC.print("CCR0: "); SerialPC.println(0x40 | ((size & 0x03) << 4), HEX);
@@ -1306,7 +1482,7 @@ void RA8876::selectExternalFont(enum ExternalFontFamily family, enum FontSize si
     
     _writeReg(RA8876_REG_GTFNT_CR, (enc << 3) | (family & 0x03));  // Character encoding and family
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1316,9 +1492,9 @@ void RA8876::setTextScale(uint8_t X_scale, uint8_t Y_scale)
     if((X_scale != _textScaleX) || (Y_scale != _textScaleY)){
         _textScaleX = X_scale;
         _textScaleY = Y_scale;
-        SPI.beginTransaction(_spiSettings);
+        _beginTransaction();
         _writeReg(RA8876_REG_CCR1,X_scale<<2|Y_scale);//cdh
-        SPI.endTransaction();
+        _endTransaction();
     }
 }
 
@@ -1327,16 +1503,16 @@ void RA8876::setTextScale(uint8_t X_scale, uint8_t Y_scale)
    ************************************************************* */
 void RA8876::setCursor(uint16_t x, uint16_t y)
 {
-    if(x < 0) x = 0; if(x >= _width) x = _width-1;
-    if(y < 0) y = 0; if(y >= _height) y = _height-1;
+    if(x >= _width) x = _width-1;   // x e y son unsigned: no pueden ser negativas
+    if(y >= _height) y = _height-1;
 
     if((x != _cursorX) || (y != _cursorY)){
         _cursorX = x;
         _cursorY = y;
-        SPI.beginTransaction(_spiSettings);
+        _beginTransaction();
         _writeReg16(RA8876_REG_F_CURX0, x);  // Text cursor X-coordinate register 0
         _writeReg16(RA8876_REG_F_CURY0, y);  // Text cursor Y-coordinate register 0
-        SPI.endTransaction();
+        _endTransaction();
     }
 }
 
@@ -1347,13 +1523,13 @@ void RA8876::setTextForegroundColor(uint16_t color)
 {
     _textForeColor = color;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _writeReg(RA8876_REG_FGCR, color >> 11 << 3);
     _writeReg(RA8876_REG_FGCG, ((color >> 5) & 0x3F) << 2);
     _writeReg(RA8876_REG_FGCB, (color & 0x1F) << 3);
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1362,13 +1538,13 @@ void RA8876::setTextBackgroundColor(uint16_t color)
 {
     _textBackColor = color;
 
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _writeReg(RA8876_REG_BGCR, color >> 11 << 3);
     _writeReg(RA8876_REG_BGCG, ((color >> 5) & 0x3F) << 2);
     _writeReg(RA8876_REG_BGCB, (color & 0x1F) << 3);
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1377,9 +1553,9 @@ void RA8876::setTextBackgroundTrans(uint8_t trans)
 {
     //if(trans != _textBackTrans){
         _textBackTrans = trans; // ON or OFF
-        SPI.beginTransaction(_spiSettings);
+        _beginTransaction();
         _writeReg(RA8876_REG_CCR1,_align<<7|trans<<6|_textScaleX<<2|_textScaleY);//cdh
-        SPI.endTransaction();
+        _endTransaction();
     //}
 }
 
@@ -1407,7 +1583,7 @@ void RA8876::setTextColor(uint16_t f_color, uint16_t b_color, uint8_t trans)
    ************************************************************* */
 void RA8876::putChars(const char *buffer, size_t size)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _setTextMode();
 
@@ -1421,14 +1597,14 @@ void RA8876::putChars(const char *buffer, size_t size)
 
     _setGraphicsMode();
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void RA8876::putChars16(const uint16_t *buffer, unsigned int count)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _setTextMode();
 
@@ -1445,7 +1621,7 @@ void RA8876::putChars16(const uint16_t *buffer, unsigned int count)
 
     _setGraphicsMode();
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 //**************************************************************//
@@ -1453,7 +1629,7 @@ void RA8876::putChars16(const uint16_t *buffer, unsigned int count)
 //**************************************************************//
 void RA8876:: putString(uint16_t x0,uint16_t y0, char *str)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _setTextMode();
     setCursor(x0,y0);
@@ -1476,7 +1652,7 @@ void RA8876:: putString(uint16_t x0,uint16_t y0, char *str)
 
     _setGraphicsMode();
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1484,7 +1660,7 @@ void RA8876:: putString(uint16_t x0,uint16_t y0, char *str)
    ************************************************************* */
 size_t RA8876::write(const uint8_t *buffer, size_t size)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     _setTextMode();
 
@@ -1500,7 +1676,7 @@ size_t RA8876::write(const uint8_t *buffer, size_t size)
         setCursor(0, getCursorY() + getTextSizeY()+20);
         _writeCmd(RA8876_REG_MRWDP);  // Reset current register for writing to memory
       }
-      else if ((_fontFlags & RA8876_FONT_FLAG_XLAT_FULLWIDTH) && ((c >= 0x21) || (c <= 0x7F)))
+      else if ((_fontFlags & RA8876_FONT_FLAG_XLAT_FULLWIDTH) && (((uint8_t)c >= 0x21) && ((uint8_t)c <= 0x7F)))
       {
         // Translate ASCII to Unicode fullwidth form (for Chinese fonts that lack ASCII)
         uint16_t fwc = c - 0x21 + 0xFF01;
@@ -1523,7 +1699,7 @@ size_t RA8876::write(const uint8_t *buffer, size_t size)
     _cursorX = _readReg16(RA8876_REG_F_CURX0);
     _cursorY = _readReg16(RA8876_REG_F_CURY0);
 
-    SPI.endTransaction();
+    _endTransaction();
   
     return size;
 }
@@ -1534,12 +1710,12 @@ size_t RA8876::write(const uint8_t *buffer, size_t size)
    ************************************************************* */
 void RA8876::setPixelCursor(uint16_t x,uint16_t y)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     
     _writeReg16(RA8876_REG_CURH0, x);  // Graphic read/write horizontal position 0
     _writeReg16(RA8876_REG_CURV0, y);  // Graphic read/write vertical position 0
     
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1549,14 +1725,14 @@ void RA8876::drawPixel(uint16_t x, uint16_t y, uint16_t color)
     //SerialPC.println("drawPixel");
     //SerialPC.println(_readStatus());
     
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     setPixelCursor(x, y);
     
     _writeReg(RA8876_REG_MRWDP, color & 0xFF);
     _writeReg(RA8876_REG_MRWDP, color >> 8);
     
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1564,94 +1740,94 @@ void RA8876::drawPixel(uint16_t x, uint16_t y, uint16_t color)
    ************************************************************* */
 void RA8876::bte_Source0_MemoryStartAddr(uint32_t addr)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg32(RA8876_S0_STR0,addr);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void RA8876::bte_Source0_ImageWidth(uint16_t width)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_S0_WTH0,width);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void RA8876::bte_Source0_WindowStartXY(uint16_t x0,uint16_t y0)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_S0_X0,x0);
     _writeReg16(RA8876_S0_Y0,y0);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void RA8876::bte_Source1_MemoryStartAddr(uint32_t addr)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg32(RA8876_S1_STR0,addr);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void RA8876::bte_Source1_ImageWidth(uint16_t width)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_S1_WTH0,width);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void RA8876::bte_Source1_WindowStartXY(uint16_t x0,uint16_t y0)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_S1_X0,x0);
     _writeReg16(RA8876_S1_Y0,y0);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void  RA8876::bte_DestinationMemoryStartAddr(uint32_t addr)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg32(RA8876_DT_STR0,addr);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void  RA8876::bte_DestinationImageWidth(uint16_t width)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_DT_WTH0,width);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void  RA8876::bte_DestinationWindowStartXY(uint16_t x0,uint16_t y0)	
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_DT_X0,x0);
     _writeReg16(RA8876_DT_Y0,y0);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
    ************************************************************* */
 void  RA8876::bte_WindowSize(uint16_t width, uint16_t height)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
     _writeReg16(RA8876_BTE_WTH0,width);
     _writeReg16(RA8876_BTE_HIG0,height);
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1659,7 +1835,7 @@ void  RA8876::bte_WindowSize(uint16_t width, uint16_t height)
 void RA8876::bteMemoryCopy(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_x,uint16_t s0_y,uint32_t des_addr,uint16_t des_image_width, 
                     uint16_t des_x,uint16_t des_y,uint16_t copy_width,uint16_t copy_height)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     bte_Source0_MemoryStartAddr(s0_addr);
     bte_Source0_ImageWidth(s0_image_width);
@@ -1688,16 +1864,64 @@ void RA8876::bteMemoryCopy(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_
       iter++;
     }
 
-    SPI.endTransaction();
+    _endTransaction();
 }
  
 
+/* *************************************************************
+    Copiar 'n' glifos del mismo tamaño, todos de la fila 's0_y' de
+    la página 's0_addr' (en las columnas 's0_x[i]'), uno tras otro
+    en el destino a partir de (des_x, des_y). Las dos páginas tienen
+    el ancho de la pantalla.
+
+    Las direcciones, anchos, tamaño y modo del BTE se escriben una
+    sola vez; para cada glifo solo cambian las esquinas de origen y
+    destino. Los glifos con columna RA8876_GLYPH_SKIP se saltan 
+    (dejan su hueco en el destino) sin enviar nada. Los registros se escriben a RA8876_SPI_SPEED_IMG, igual
+    que los de sdCardDraw16bppBINBurst(): solo el motor de texto
+    necesita los 3MHz.
+   ************************************************************* */
+void RA8876::bteMemoryCopyGlyphs(uint32_t s0_addr,uint16_t s0_y,const uint16_t *s0_x,uint8_t n,uint32_t des_addr,uint16_t des_x,uint16_t des_y,
+                                 uint16_t glyph_width,uint16_t glyph_height)
+{
+    _spiSettings = SPISettings(RA8876_SPI_SPEED_IMG, MSBFIRST, SPI_MODE3); //Incremento velocidad SPI => 50MHz
+
+    _beginTransaction();
+
+    bte_Source0_MemoryStartAddr(s0_addr);
+    bte_Source0_ImageWidth(_width);
+    bte_DestinationMemoryStartAddr(des_addr);
+    bte_DestinationImageWidth(_width);
+    bte_WindowSize(glyph_width,glyph_height);
+
+    _writeReg(RA8876_BTE_CTRL1,RA8876_BTE_ROP_CODE_12<<4|RA8876_BTE_MEMORY_COPY_WITH_ROP);//91h
+    _writeReg(RA8876_BTE_COLR,RA8876_S0_COLOR_DEPTH_16BPP<<5|RA8876_S1_COLOR_DEPTH_16BPP<<2|RA8876_DESTINATION_COLOR_DEPTH_16BPP);//92h
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+      if (s0_x[i] == RA8876_GLYPH_SKIP) continue;
+
+      bte_Source0_WindowStartXY(s0_x[i],s0_y);
+      bte_DestinationWindowStartXY(des_x + i * glyph_width,des_y);
+      _writeReg(RA8876_BTE_CTRL0,RA8876_BTE_ENABLE<<4);//90h
+
+      // Wait for completion
+      while (_readStatus() & 0x08)
+        ;
+    }
+
+    _endTransaction();
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED, MSBFIRST, SPI_MODE3); //Decremento velocidad SPI para texto => 3MHz
+}
+
+
 /* *************************************************************
    ************************************************************* */
 void RA8876::bteMemoryCopyWithROP(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_x,uint16_t s0_y,uint32_t s1_addr,uint16_t s1_image_width,uint16_t s1_x,uint16_t s1_y,
                             uint32_t des_addr,uint16_t des_image_width, uint16_t des_x,uint16_t des_y,uint16_t copy_width,uint16_t copy_height,uint8_t rop_code)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     bte_Source0_MemoryStartAddr(s0_addr);
     bte_Source0_ImageWidth(s0_image_width);
@@ -1727,7 +1951,7 @@ void RA8876::bteMemoryCopyWithROP(uint32_t s0_addr,uint16_t s0_image_width,uint1
       iter++;
     }
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 /* *************************************************************
@@ -1735,7 +1959,7 @@ void RA8876::bteMemoryCopyWithROP(uint32_t s0_addr,uint16_t s0_image_width,uint1
 void RA8876::bteMemoryCopyWithChromaKey(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_x,uint16_t s0_y,
                                 uint32_t des_addr,uint16_t des_image_width, uint16_t des_x,uint16_t des_y,uint16_t copy_width,uint16_t copy_height,uint16_t chromakey_color)
 {
-    SPI.beginTransaction(_spiSettings);
+    _beginTransaction();
 
     bte_Source0_MemoryStartAddr(s0_addr);
     bte_Source0_ImageWidth(s0_image_width);
@@ -1763,7 +1987,7 @@ void RA8876::bteMemoryCopyWithChromaKey(uint32_t s0_addr,uint16_t s0_image_width
       iter++;
     }
 
-    SPI.endTransaction();
+    _endTransaction();
 }
 
 
@@ -1772,7 +1996,7 @@ void RA8876::bteMemoryCopyWithChromaKey(uint32_t s0_addr,uint16_t s0_image_width
 void RA8876::bteMemoryCopyWithOpacity(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_x,uint16_t s0_y,uint32_t s1_addr,uint16_t s1_image_width,uint16_t s1_x,uint16_t s1_y,
                             uint32_t des_addr,uint16_t des_image_width, uint16_t des_x,uint16_t des_y,uint16_t copy_width,uint16_t copy_height,uint8_t alpha_level)
 {
-  SPI.beginTransaction(_spiSettings);
+  _beginTransaction();
 
   bte_Source0_MemoryStartAddr(s0_addr);
   bte_Source0_ImageWidth(s0_image_width);
@@ -1803,7 +2027,7 @@ void RA8876::bteMemoryCopyWithOpacity(uint32_t s0_addr,uint16_t s0_image_width,u
     iter++;
   }
 
-  SPI.endTransaction();
+  _endTransaction();
 }
 
 
@@ -1847,6 +2071,80 @@ void RA8876::putPicture_16bpp(uint16_t x,uint16_t y,uint16_t width, uint16_t hei
 }
 
 
+/* *************************************************************
+    Preparar la lectura de los píxeles de un rectángulo del canvas
+    actual: ventana activa, cursor en su esquina y la primera 
+    lectura de la memoria, que no es válida (dummy read). Después 
+    los píxeles salen fila a fila, 2 bytes cada uno (low byte 
+    primero, igual que se escriben).
+
+    Hay que restaurar la ventana y la velocidad al terminar.
+   ************************************************************* */
+void RA8876::_memoryReadPrepare(uint16_t x,uint16_t y,uint16_t width, uint16_t height)
+{
+    _spiSettings = SPISettings(RA8876_SPI_SPEED_LECTURA, MSBFIRST, SPI_MODE3);
+
+    setCanvasWindow(x,y,width,height); // activeWindowXY() y activeWindowWH() de RA8876_Lite
+    setPixelCursor(x,y);
+    ramAccessPrepare();
+
+    _beginTransaction();
+    _readData(); // Dummy read
+    _endTransaction();
+}
+
+
+/* *************************************************************
+    Leer de la SDRAM los píxeles de un rectángulo del canvas
+    actual (RGB 5:6:5), en el mismo orden que putPicture_16bpp().
+   ************************************************************* */
+void RA8876::readPicture_16bpp(uint16_t x,uint16_t y,uint16_t width, uint16_t height, unsigned short *data)
+{
+    _memoryReadPrepare(x,y,width,height);
+
+    uint8_t *destino = (uint8_t*)data;
+    uint32_t pendientes = (uint32_t)width * height * 2;
+    while (pendientes > 0)
+    {
+        uint16_t n = min(pendientes, (uint32_t)RA8876_BLOQUE_IMAGEN);
+        _readDataBurst(destino, n);
+        destino += n;
+        pendientes -= n;
+    }
+
+    setCanvasWindow(0,0,_width,_height);
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED, MSBFIRST, SPI_MODE3); //Decremento velocidad SPI para texto => 3MHz
+}
+
+
+/* *************************************************************
+    FNV-1a de los píxeles de un rectángulo del canvas actual, 
+    leídos de la SDRAM por bloques de RA8876_BLOQUE_IMAGEN bytes,
+    continuando desde 'hash'. Sirve para comprobar que una imagen
+    cargada antes sigue intacta sin guardarla en RAM.
+   ************************************************************* */
+uint32_t RA8876::checksum16bpp(uint16_t x,uint16_t y,uint16_t width, uint16_t height, uint32_t hash)
+{
+    _memoryReadPrepare(x,y,width,height);
+
+    uint32_t pendientes = (uint32_t)width * height * 2;
+    while (pendientes > 0)
+    {
+        uint16_t n = min(pendientes, (uint32_t)RA8876_BLOQUE_IMAGEN);
+        _readDataBurst(bloqueImagen, n);
+        hash = fnv1a(bloqueImagen, n, hash);
+        pendientes -= n;
+    }
+
+    setCanvasWindow(0,0,_width,_height);
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED, MSBFIRST, SPI_MODE3); //Decremento velocidad SPI para texto => 3MHz
+
+    return hash;
+}
+
+
 /* *************************************************************
     Mostrar imagen de 16bpp (RGB 5:6:5) en formato BIN guardada en el
     fichero 'filename' de la SD.
@@ -1949,6 +2247,11 @@ void RA8876::sdCardDraw16bppBIN64bits(uint16_t x,uint16_t y,uint16_t width, uint
    ************************************************************* */
 void RA8876::sdCardDraw16bppBIN256bits(uint16_t x,uint16_t y,uint16_t width, uint16_t height,char *filename)
 {
+  #if defined(IMG_STATS)
+    unsigned long inicio = micros();
+    aperturasImagenes++;
+  #endif
+
     _spiSettings = SPISettings(RA8876_SPI_SPEED_IMG, MSBFIRST, SPI_MODE3); //Incremento velocidad SPI para imagen => 50MHz
 
     uint64_t data[4];
@@ -1973,6 +2276,9 @@ void RA8876::sdCardDraw16bppBIN256bits(uint16_t x,uint16_t y,uint16_t width, uin
           _writeData256bits(data); // 64 | 128 | 192 | 256
           //----
       }
+      #if defined(IMG_STATS)
+        bytesImagenes += dataFile.size();
+      #endif
       dataFile.close();
     }   
     else {
@@ -1983,5 +2289,249 @@ void RA8876::sdCardDraw16bppBIN256bits(uint16_t x,uint16_t y,uint16_t width, uin
     setCanvasWindow(0,0,_width,_height);
 
     _spiSettings = SPISettings(RA8876_SPI_SPEED, MSBFIRST, SPI_MODE3); //Decremento velocidad SPI para texto => 3MHz
+
+  #if defined(IMG_STATS)
+    usImagenes += micros() - inicio;
+  #endif
+}
+
+
+
+/* *************************************************************
+    Mostrar imagen de 16bpp (RGB 5:6:5) en formato BIN guardada en el
+    fichero 'filename' de la SD. Abre el fichero y lo envía entero con
+    la versión de sdCardDraw16bppBINBurst() que lee de un fichero ya
+    abierto.
+
+    Con RA8876_IMG_256BITS se usa sdCardDraw16bppBIN256bits() para
+    comparar ambas con IMG_STATS.
+   ************************************************************* */
+void RA8876::sdCardDraw16bppBINBurst(uint16_t x,uint16_t y,uint16_t width, uint16_t height,char *filename)
+{
+  #if defined(RA8876_IMG_256BITS)
+    sdCardDraw16bppBIN256bits(x,y,width,height,filename);
+  #else
+    #if defined(IMG_STATS)
+      unsigned long inicio = micros();
+      aperturasImagenes++;
+    #endif
+
+    File dataFile = SD.open(filename);
+    if (dataFile) {  
+        #if defined(IMG_STATS)
+          usImagenes += micros() - inicio; // Apertura. El envío lo mide la otra versión
+        #endif
+
+        sdCardDraw16bppBINBurst(x,y,width,height,dataFile);
+
+        #if defined(IMG_STATS)
+          inicio = micros();
+        #endif
+        dataFile.close();
+    }   
+    else {
+      #if defined(SM_DEBUG)
+        SerialPC.println(F("Fichero no encontrado"));
+      #endif
+    }
+
+    #if defined(IMG_STATS)
+      usImagenes += micros() - inicio;
+    #endif
+  #endif
+}
+
+
+/* *************************************************************
+    Mostrar imagen de 16bpp (RGB 5:6:5) leyendo width*height*2 bytes 
+    de 'dataFile' desde su posición actual (p.ej. una imagen del atlas
+    de imágenes, todas en un mismo fichero).
+    Se leen bloques de RA8876_BLOQUE_IMAGEN bytes (sectores completos,
+    que la librería SD copia directamente sin pasar por su caché si la
+    posición está alineada a 512) y cada bloque se envía en una sola 
+    ráfaga con _writeDataBurst(): un comando de escritura y CS activo 
+    por bloque en lugar de por cada 32 bytes, y sin huecos entre bytes 
+    gracias a la DMA.
+
+    La SD y la pantalla comparten el bus SPI0, así que la lectura del
+    siguiente bloque no puede solaparse con el envío del actual.
+
+    Devuelve 'false' si el fichero se acaba antes de la imagen.
+   ************************************************************* */
+bool RA8876::sdCardDraw16bppBINBurst(uint16_t x,uint16_t y,uint16_t width, uint16_t height,File &dataFile)
+{
+    #if defined(IMG_STATS)
+      unsigned long inicio = micros();
+    #endif
+
+    uint8_t *bloque = bloqueImagen;
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED_IMG, MSBFIRST, SPI_MODE3); //Incremento velocidad SPI para imagen => 50MHz
+
+    setCanvasWindow(x,y,width,height); // activeWindowXY() y activeWindowWH() de RA8876_Lite
+    setPixelCursor(x,y);
+    ramAccessPrepare();
+
+    uint32_t pendientes = (uint32_t)width * height * 2;
+    int leidos;
+    while ((pendientes > 0) && ((leidos = dataFile.read(bloque, min(pendientes, (uint32_t)RA8876_BLOQUE_IMAGEN))) > 0)) 
+    {
+        _writeDataBurst(bloque, leidos);
+        pendientes -= leidos;
+      #if defined(IMG_STATS)
+        bytesImagenes += leidos;
+      #endif
+    }
+
+    setCanvasWindow(0,0,_width,_height);
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED, MSBFIRST, SPI_MODE3); //Decremento velocidad SPI para texto => 3MHz
+
+    #if defined(IMG_STATS)
+      usImagenes += micros() - inicio;
+    #endif
+
+    return pendientes == 0;
+}
+
+
+/* *************************************************************
+    Lectura por sectores de los datos comprimidos de una imagen
+    Q565, byte a byte. Solo la usa sdCardDraw16bppQ565().
+   ************************************************************* */
+typedef struct {
+    File      *fichero;
+    uint32_t  pendientes;               // Bytes de la imagen aún sin leer de la SD
+    uint16_t  n;                        // Bytes válidos en 'datos'
+    uint16_t  pos;                      // Siguiente byte de 'datos'
+    uint8_t   datos[Q565_BLOQUE_SD];
+} lectorQ565_t;
+
+static inline bool leerByteQ565(lectorQ565_t &l, uint8_t &b)
+{
+    if (l.pos == l.n)
+    {
+      if (l.pendientes == 0) return false;
+      int leidos = l.fichero->read(l.datos, min(l.pendientes, (uint32_t)Q565_BLOQUE_SD));
+      if (leidos <= 0) return false;
+      l.n = leidos;
+      l.pos = 0;
+      l.pendientes -= leidos;
+    }
+    b = l.datos[l.pos++];
+    return true;
+}
+
+
+/* *************************************************************
+    Mostrar imagen de 16bpp (RGB 5:6:5) comprimida en formato Q565,
+    leyendo 'bytes' bytes de 'dataFile' desde su posición actual.
+
+    Q565 es una compresión sin pérdidas parecida a QOI, adaptada a
+    RGB565 (ver Q565_.. en RA8876_v2.h): cada píxel se codifica como
+    repetición del anterior, como uno de los 64 últimos colores, o
+    como diferencia pequeña con el anterior. Con las imágenes de la
+    interfaz (grandes zonas de color plano y bordes suavizados) ocupa
+    unas 4 veces menos que el .bin, así que se leen 4 veces menos
+    bytes de la SD.
+
+    Se descomprime sobre la marcha: se leen sectores de la SD y los
+    píxeles se van dejando en el bloque de RA8876_BLOQUE_IMAGEN bytes,
+    que se envía con _writeDataBurst() cada vez que se llena. No hace
+    falta memoria para la imagen entera.
+
+    Devuelve 'false' si los datos se acaban antes de la imagen o no
+    son válidos.
+   ************************************************************* */
+bool RA8876::sdCardDraw16bppQ565(uint16_t x,uint16_t y,uint16_t width, uint16_t height,File &dataFile,uint32_t bytes)
+{
+    #if defined(IMG_STATS)
+      unsigned long inicio = micros();
+    #endif
+
+    static lectorQ565_t lector;  // En RAM estática: 512 bytes
+    lector.fichero = &dataFile;
+    lector.pendientes = bytes;
+    lector.n = 0;
+    lector.pos = 0;
+
+    uint16_t tabla[64];
+    memset(tabla, 0, sizeof(tabla));
+    uint16_t pixel = 0;             // Píxel anterior (negro al empezar)
+
+    uint8_t *bloque = bloqueImagen;
+    uint16_t nBloque = 0;
+    uint32_t pixelesPendientes = (uint32_t)width * height;
+    bool valido = true;
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED_IMG, MSBFIRST, SPI_MODE3); //Incremento velocidad SPI para imagen => 50MHz
+
+    setCanvasWindow(x,y,width,height); // activeWindowXY() y activeWindowWH() de RA8876_Lite
+    setPixelCursor(x,y);
+    ramAccessPrepare();
+
+    while (pixelesPendientes > 0)
+    {
+        uint8_t op, b1, b2;
+        uint16_t repeticiones = 1;
+
+        if (!leerByteQ565(lector, op)) { valido = false; break; }
+
+        if (op == Q565_RGB)
+        {
+          if (!leerByteQ565(lector, b1) || !leerByteQ565(lector, b2)) { valido = false; break; }
+          pixel = b1 | (b2 << 8);
+        }
+        else if (op == 0xFF) { valido = false; break; }  // Código no usado
+        else if ((op & 0xC0) == Q565_RACHA) repeticiones = (op & 0x3F) + 1;
+        else if ((op & 0xC0) == Q565_INDICE) pixel = tabla[op];
+        else
+        {
+          uint8_t r = pixel >> 11, g = (pixel >> 5) & 0x3F, b = pixel & 0x1F;
+          if ((op & 0xC0) == Q565_DIF)
+          {
+            r += ((op >> 4) & 0x03) - 2;
+            g += ((op >> 2) & 0x03) - 2;
+            b += (op & 0x03) - 2;
+          }
+          else // Q565_LUMA
+          {
+            if (!leerByteQ565(lector, b1)) { valido = false; break; }
+            int8_t dg = (op & 0x3F) - 32;
+            r += dg + (b1 >> 4) - 8;
+            g += dg;
+            b += dg + (b1 & 0x0F) - 8;
+          }
+          pixel = ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+        }
+
+        if ((op & 0xC0) != Q565_RACHA || op == Q565_RGB) tabla[Q565_HASH(pixel >> 11, (pixel >> 5) & 0x3F, pixel & 0x1F)] = pixel;
+
+        if (repeticiones > pixelesPendientes) repeticiones = pixelesPendientes;
+        pixelesPendientes -= repeticiones;
+
+        while (repeticiones--)
+        {
+          bloque[nBloque++] = pixel & 0xFF;
+          bloque[nBloque++] = pixel >> 8;
+          if (nBloque == RA8876_BLOQUE_IMAGEN)
+          {
+            _writeDataBurst(bloque, nBloque);
+            nBloque = 0;
+          }
+        }
+    }
+    if (nBloque > 0) _writeDataBurst(bloque, nBloque);
+
+    setCanvasWindow(0,0,_width,_height);
+
+    _spiSettings = SPISettings(RA8876_SPI_SPEED, MSBFIRST, SPI_MODE3); //Decremento velocidad SPI para texto => 3MHz
+
+    #if defined(IMG_STATS)
+      bytesImagenes += bytes - lector.pendientes;
+      usImagenes += micros() - inicio;
+    #endif
+
+    return valido;
 }
 
@@ -28,9 +28,11 @@ Version   : v2.0
 #include "COLORS.h"
 
 #include "debug.h" // SM_DEBUG --> SerialPC
+#include "HAL.h" // halPin_t --> CS de la RA8876
 
 
 //#define RA8876_DEBUG // Uncomment to enable debug messaging
+//#define RA8876_IMG_256BITS // Descomentar para que sdCardDraw16bppBINBurst() use sdCardDraw16bppBIN256bits() (comparar tiempos con IMG_STATS)
 
 
 #define RGB332(r, g, b) (((r) & 0xE0) | (((g) & 0xE0) >> 3) | (((b) & 0xE0) >> 6))
@@ -45,6 +47,33 @@ typedef uint8_t FontFlags;
 // Data sheet section 5.2 says maximum SPI clock is 50MHz.
 #define RA8876_SPI_SPEED      3000000  // 3MHz es lo máximo que permite mostrar texto sin problema
 #define RA8876_SPI_SPEED_IMG  50000000 // 50MHz para mostrar imagen
+#define RA8876_SPI_SPEED_LECTURA 10000000 // 10MHz para leer la SDRAM (readPicture_16bpp(), checksum16bpp())
+
+// Lista de escrituras de registro (_writeReg()). Cada escritura son dos tramas (comando y dato) y no se
+// pueden juntar en una: la CS está en un pin normal (no es un NPCS del SPI0) y el chip necesita que suba
+// entre tramas. Lo que sí se ahorra: las escrituras se guardan en la lista y se envían todas juntas al
+// cerrar la transacción más externa (o antes de cualquier otro acceso), con la CS por el PIO y sin
+// repetir la trama de comando si el registro ya estaba seleccionado; y no se envían las de los registros
+// que el chip no modifica solo (_regCacheable()) si ya tienen ese valor, que tampoco hace falta leer.
+#define RA8876_MAX_COMANDOS   32       // Escrituras pendientes como máximo; si se llena, se envía
+
+#define RA8876_BLOQUE_IMAGEN  2048     // Bytes leídos de la SD y enviados en cada ráfaga de sdCardDraw16bppBINBurst(). Múltiplo de 512 (sector)
+
+#define RA8876_GLYPH_SKIP     0xFFFF   // Columna de bteMemoryCopyGlyphs() que no se copia: el destino ya muestra ese glifo
+
+// Imágenes comprimidas Q565 (sdCardDraw16bppQ565()). Cada operación empieza con un byte:
+#define Q565_INDICE   0x00  // 00iiiiii            --> píxel 'i' de la tabla de los 64 últimos colores (Q565_HASH)
+#define Q565_DIF      0x40  // 01rrggbb            --> anterior + (rr-2, gg-2, bb-2)
+#define Q565_LUMA     0x80  // 10gggggg rrrrbbbb   --> anterior + (gggggg-32 + rrrr-8, gggggg-32, gggggg-32 + bbbb-8)
+#define Q565_RACHA    0xC0  // 11nnnnnn            --> anterior repetido nnnnnn+1 veces (1..62)
+#define Q565_RGB      0xFE  // + 2 bytes           --> píxel RGB565 tal cual (little endian, como en los .bin)
+#define Q565_HASH(r, g, b)    (((r) * 3 + (g) * 5 + (b) * 7) & 63)
+#define Q565_BLOQUE_SD        512      // Bytes comprimidos leídos de la SD cada vez
+
+// FNV-1a de 32 bits: checksum16bpp() y firma de las imágenes cargadas en la SDRAM (Screen.h)
+#define FNV_INICIAL   2166136261u
+#define FNV_PRIMO     16777619u
+inline uint32_t fnv1a(const uint8_t *datos, uint32_t n, uint32_t hash = FNV_INICIAL){ while(n--) hash = (hash ^ *datos++) * FNV_PRIMO; return hash; };
 
 // With SPI, the RA8876 expects an initial byte where the top two bits are meaningful. Bit 7
 // is A0, bit 6 is WR#. See data sheet section 7.3.2 and section 19.
@@ -942,6 +971,15 @@ private:
   PllParams           _scanPll;     // SCLK (LCD panel scan) PLL parameters
 
   SPISettings         _spiSettings;
+  uint32_t            _bytesSPI;    // Bytes enviados o leídos por SPI desde el arranque (getBytesSPI())
+  halPin_t            _cs;          // _csPin con acceso directo al PIO (halPinBajo()/halPinAlto())
+
+  uint8_t             _transactionDepth;                    // Transacciones abiertas con _beginTransaction() (anidadas)
+  uint8_t             _nCmds;                               // Escrituras de registro pendientes en _cmds[]
+  uint8_t             _cmds[RA8876_MAX_COMANDOS][2];        // (registro, dato)
+  uint16_t            _selectedReg;                         // Último registro seleccionado con RA8876_CMD_WRITE (0xFFFF --> desconocido)
+  uint8_t             _regCache[256];                       // Último dato escrito en cada registro cacheable...
+  uint32_t            _regCacheValid[8];                    // ... si su bit está a 1
 
   SdramInfo           *_sdramInfo;
 
@@ -976,7 +1014,10 @@ private:
   void      _writeData16bits(uint16_t data);               // lcdDataWrite16bbp() en RA8876_Lite
   void      _writeData64bits(uint64_t data);     
   void      _writeData256bits(uint64_t *data);   
+  void      _writeDataBurst(uint8_t *data, uint16_t len);
   uint8_t   _readData(void);                              // lcdDataRead()  en RA8876_Lite
+  void      _readDataBurst(uint8_t *data, uint16_t len);
+  void      _memoryReadPrepare(uint16_t x,uint16_t y,uint16_t width, uint16_t height);
   uint8_t   _readStatus(void);                            // lcdStatusRead() en RA8876_Lite
   void      _writeReg(uint8_t reg, uint8_t data);         // lcdRegDataWrite() en RA8876_Lite
   void      _writeReg16(uint8_t reg, uint16_t data);
@@ -985,6 +1026,15 @@ private:
   uint16_t  _readReg16(uint8_t reg);
   // ------------------------------------------------------------ */
 
+  // -------- COMMAND LIST -------------------------------------- */
+  void      _beginTransaction(void);                      // SPI.beginTransaction() solo en la más externa
+  void      _endTransaction(void);                        // En la más externa: enviar la lista y SPI.endTransaction()
+  void      _flushCmds(void);                             // Enviar las escrituras pendientes
+  void      _forgetRegs(void);                            // Tras un reset: no se sabe qué hay en los registros
+  static bool _regCacheable(uint16_t reg);                // El chip no lo modifica por su cuenta
+  inline bool _regCached(uint8_t reg) { return _regCacheValid[reg >> 5] & (1UL << (reg & 31)); };
+  // ------------------------------------------------------------ */
+
   // -------- STATUS -------------------------------------------- */
   void      _checkWriteFifoNotFull(void);
   void      _checkWriteFifoEmpty(void);  
@@ -1055,6 +1105,9 @@ public:
   // Dimensions
   int       getWidth() { return _width; };
   int       getHeight() { return _height; };
+
+  // Tráfico SPI
+  uint32_t  getBytesSPI() { return _bytesSPI; };                                          // Bytes por SPI desde el arranque. La diferencia entre dos lecturas es lo que ha costado dibujar lo de en medio
   // ------------------------------------------------------------ 
 
   // -------- RANDOM -------------------------------------------- 
@@ -1152,6 +1205,8 @@ public:
   // MEMORY COPY
   void    bteMemoryCopy(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_x,uint16_t s0_y,uint32_t des_addr,uint16_t des_image_width, 
                     uint16_t des_x,uint16_t des_y,uint16_t copy_width,uint16_t copy_height);
+  void    bteMemoryCopyGlyphs(uint32_t s0_addr,uint16_t s0_y,const uint16_t *s0_x,uint8_t n,uint32_t des_addr,uint16_t des_x,uint16_t des_y,
+                              uint16_t glyph_width,uint16_t glyph_height);  // 'n' celdas de una fila de glifos, seguidas en el destino
   // MEMORY COPY - ROP
   void    bteMemoryCopyWithROP(uint32_t s0_addr,uint16_t s0_image_width,uint16_t s0_x,uint16_t s0_y,uint32_t s1_addr,uint16_t s1_image_width,uint16_t s1_x,uint16_t s1_y,
                             uint32_t des_addr,uint16_t des_image_width, uint16_t des_x,uint16_t des_y,uint16_t copy_width,uint16_t copy_height,uint8_t rop_code);
@@ -1168,10 +1223,24 @@ public:
   // CODIGO CPP
   void    putPicture_16bpp(uint16_t x,uint16_t y,uint16_t width, uint16_t height, const unsigned short *data);
 
+  // LECTURA DE LA SDRAM (canvas actual)
+  void      readPicture_16bpp(uint16_t x,uint16_t y,uint16_t width, uint16_t height, unsigned short *data);
+  uint32_t  checksum16bpp(uint16_t x,uint16_t y,uint16_t width, uint16_t height, uint32_t hash = FNV_INICIAL);  // FNV-1a de los píxeles
+
   // BIN (SD)
   void    sdCardDraw16bppBIN8bits(uint16_t x,uint16_t y,uint16_t width, uint16_t height,char *filename);
   void    sdCardDraw16bppBIN64bits(uint16_t x,uint16_t y,uint16_t width, uint16_t height,char *filename); 
   void    sdCardDraw16bppBIN256bits(uint16_t x,uint16_t y,uint16_t width, uint16_t height,char *filename); 
+  void    sdCardDraw16bppBINBurst(uint16_t x,uint16_t y,uint16_t width, uint16_t height,char *filename);
+  bool    sdCardDraw16bppBINBurst(uint16_t x,uint16_t y,uint16_t width, uint16_t height,File &dataFile);  // Desde la posición actual de un fichero ya abierto
+  bool    sdCardDraw16bppQ565(uint16_t x,uint16_t y,uint16_t width, uint16_t height,File &dataFile,uint32_t bytes);  // Imagen comprimida Q565 de 'bytes' bytes
+
+#if defined(IMG_STATS)
+  uint32_t  bytesImagenes = 0;    // Bytes leídos de la SD desde el último resetStatsImagenes() (comprimidos, en las Q565)
+  uint32_t  usImagenes = 0;       // us dentro de las funciones sdCardDraw16bppBIN256bits() y sdCardDraw16bppBINBurst()
+  uint16_t  aperturasImagenes = 0;  // Ficheros de imagen abiertos (el atlas cuenta como uno)
+  void      resetStatsImagenes() { bytesImagenes = 0; usImagenes = 0; aperturasImagenes = 0; };
+#endif
  /* ------------------------------------------------------------ */
 
 
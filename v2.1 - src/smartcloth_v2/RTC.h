@@ -53,7 +53,7 @@ DS3231  rtc(SDA, SCL); // SDA y SCL ya están definidos como 20 y 21 en la libre
 
 
 // ----- FLAG VERANO/INVIERNO -----
-/*DueFlashStorage dueFlashStorage; // Crear objeto para guardar en la flash
+/*DueFlashStorage dueFlashStorage; // Crear objeto para guardar en la flash (ya se crea en Scale_Calibration.h)
 #define SUMMER_TIME_FLAG_ADDRESS 0 // Dirección en la flash para la bandera del horario de verano
 #define IS_SUMMER 1
 #define IS_WINTER 0*/
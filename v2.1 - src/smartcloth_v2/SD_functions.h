@@ -63,6 +63,7 @@
 #define SD_FUNCTIONS_H
 
 #include <SD.h>
+#include <vector>
 #include "RTC.h"
 #include "Diario.h" // incluye Comida.h
 #include "Files.h"
@@ -383,7 +384,8 @@ void updateAcumuladoHoyFromHistoryFile()
     char *today = rtc.getDateStr(); // Es posible que se cambie de día durante el cocinado?? Si no, hacer en setupRTC(). 
 
     // SUMAS
-    float sumCarb = 0.0, sumLip = 0.0, sumProt = 0.0, sumKcal = 0.0, sumPeso = 0.0;    
+    milesimas_t sumCarb = 0, sumLip = 0, sumProt = 0, sumKcal = 0; // Enteros: la suma no acumula errores de float
+    float sumPeso = 0.0;    
     float sumCarb_R = 0, sumLip_R = 0, sumProt_R = 0;
     byte nComidas = 0;
 
@@ -426,13 +428,13 @@ void updateAcumuladoHoyFromHistoryFile()
                 {
                     switch (fieldIndex) // fieldIndex = 0 => fecha     fieldIndex = 1 => hora    fieldIndex = 2 => carb  ...
                     {
-                        case 2:   value = atof(token);     sumCarb   += value;     break;    // Carbohidratos
+                        case 2:   sumCarb   += leerMilesimas(token);               break;    // Carbohidratos
                         case 3:   value = atof(token);     sumCarb_R += value;     break;    // Raciones de carbohidratos
-                        case 4:   value = atof(token);     sumLip    += value;     break;    // Lípidos (Grasas)
+                        case 4:   sumLip    += leerMilesimas(token);               break;    // Lípidos (Grasas)
                         case 5:   value = atof(token);     sumLip_R  += value;     break;    // Raciones de lípidos
-                        case 6:   value = atof(token);     sumProt   += value;     break;    // Proteínas
+                        case 6:   sumProt   += leerMilesimas(token);               break;    // Proteínas
                         case 7:   value = atof(token);     sumProt_R += value;     break;    // Raciones de proteínas
-                        case 8:   value = atof(token);     sumKcal   += value;     break;    // Kilocalorías
+                        case 8:   sumKcal   += leerMilesimas(token);               break;    // Kilocalorías
                         case 9:   value = atof(token);     sumPeso   += value;     break;    // Peso
                         default:  break;
                     }
@@ -449,7 +451,8 @@ void updateAcumuladoHoyFromHistoryFile()
 
 
         // ----- ACTUALIZAR ACUMULADO HOY -----
-        ValoresNutricionales valAux(sumCarb, sumLip, sumProt, sumKcal);   
+        ValoresNutricionales valAux;
+        valAux.setValoresMilesimas(sumCarb, sumLip, sumProt, sumKcal);   
         diaActual.setValoresDiario(valAux);                               // Inicializar valores nutricionales del Acumulado Hoy
         diaActual.setPesoDiario(sumPeso);                                 // Actualizar peso del Acumulado Hoy
         diaActual.setNumComidas(nComidas);                                // Actualizar nº de comidas del Acumulado Hoy
@@ -718,8 +721,7 @@ void saveMealListInMealsFile()
     if (myFile) 
     {
         // Escribe cada línea en el archivo
-        for (byte i = 0; i < listaComidaESP32.getListSize(); i++) 
-            myFile.println(listaComidaESP32.getItem(i));
+        listaComidaESP32.printLista(myFile);
         
         // Cierra el archivo
         myFile.close();
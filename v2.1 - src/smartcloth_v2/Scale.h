@@ -32,6 +32,7 @@
 #include "HX711.h"
 
 #include "debug.h" // SM_DEBUG --> SerialPC
+#include "Debug_Log.h" // LOG_SM()
 
 HX711 scale;
 
@@ -41,6 +42,10 @@ const byte LOADCELL_DOUT_PIN = 2;
 const byte LOADCELL_SCK_PIN = 3;
 // ---------------------------------------
 
+#include "HX711_Sampler.h" // Muestreo por DRDY
+#include "Scale_Filter.h"  // Mediana, media exponencial y detector de estabilidad. Debajo de 'scale' porque usa su offset y escala
+#include "Scale_Calibration.h" // Calibración y tara guardadas en flash (arranque en caliente)
+
 
 bool      scaleEventOccurred = false;   // Flag para indicar que ha cambiado el peso de la báscula
 bool      tarado = false;               // Flag para indicar que se ha tarado la báscula
@@ -54,12 +59,13 @@ float     pesoLastAlimento  =   0.0;    // Peso del último alimento colocado
 // ------ FIN VARIABLES DE PESO --------------------------------------------------------
 
 
-#define SCALE_CALIBRATION_FACTOR 1032.6858  // Factor de calibración de la báscula (gramos)
+#define SCALE_CALIBRATION_FACTOR 1032.6858  // Factor de calibración por defecto (gramos), si no hay calibración guardada en flash ni en la SD
+
+#include "Scale_Classifier.h" // Umbrales y clasificación de los cambios de peso estable
+#include "Scale_Trace.h"      // Grabación binaria de la báscula en la SD (solo con SCALE_TRACE)
+#include "Flight_Recorder.h"  // Registro de vuelo: transiciones, duración de las actividades y estadísticas de la báscula
 
-#define UMBRAL_MIN_CAMBIO_PESO 5.0      // Cambio mínimo del peso para considerar que se ha colocado/retirado algo de la báscula
-#define UMBRAL_RECIPIENTE_RETIRADO 20.0 // Umbral para considerar que se ha retirado todo (recipiente + alimentos) de la báscula
-                                        // 20 gramos porque asumimos que un plato no pesará 20 gramos y así es más fácil detectar si se ha retirado todo
-#define UMBRAL_BASCULA_VACIA 3.0 // Umbral para considerar que la báscula está vacía, pero no se taró antes, así que no baja a negativo
+#include "Scale_Predictor.h" // Peso provisional mientras se asienta el plato. Debajo del clasificador porque usa sus umbrales
 
 
 #include "State_Machine.h" // Debajo de las variables para que estén disponibles en su ámbito
@@ -71,7 +77,7 @@ float     pesoLastAlimento  =   0.0;    // Peso del último alimento colocado
 /******************************************************************************/
 /******************************************************************************/
 void            setupScale();                                   // Inicializar báscula
-inline float    weighScale(){ return  scale.get_units(3); };    // Pesar báscula
+inline float    weighScale(){ return  (salidaFiltro - scale.get_offset()) / scale.get_scale(); };    // Pesar báscula (salida del filtro en gramos)
 void            tareScale();                                    // Tarar báscula
 void            reiniciarPesos();                               // Reiniciar pesos de recipiente, plato y alimento
 void            checkBascula();                                 // Comprobar si ha habido algún evento en la báscula y determinar el tipo de evento
@@ -98,6 +104,10 @@ void            checkBascula();                                 // Comprobar si
  *      3. Tomar el valor de escala inicial (el marcado en scale.set_scale(1058.22)) y multiplicarlo por el valor obtenido en el paso 2. Ejemplo: 1058.22 * 1000 = 1058220.
  *      4. El resultado obtenido en el paso 3 se divide por el peso conocido en gramos. Ejemplo: 1058220 / 210 = 5039.14. Este es el nuevo valor de escala.
  *      5. Usar el nuevo valor de escala obtenido en el paso 4 para ajustar la báscula correctamente llamando a scale.set_scale() con el nuevo valor. Ejemplo: scale.set_scale(5039.14);
+ * 
+ * Estos pasos los hace ahora calibrate_scale.ino (modo multipunto), que guarda el resultado en la flash
+ * y en la SD. Si hay calibración guardada, se arranca en caliente: se usan su factor y su tara (corregida
+ * con la deriva) sin tarar, y la tara se refina en segundo plano en checkBascula().
  */
 /*-----------------------------------------------------------------------------*/
 void setupScale()
@@ -106,15 +116,43 @@ void setupScale()
         SerialPC.println(F("\nInit Scale..."));
     #endif
 
+    inicioSetupScale = millis();
+
     scale.begin(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN); // Inicializa la celda de carga con los pines especificados
 
-    scale.set_scale(SCALE_CALIBRATION_FACTOR); // Establecer escala inicial. Este valor se ajusta al calibrar la báscula.
-    //scale.tare();  // Tarar tomando la media de 10 medidas
-    scale.tare(5);
+    bool calibracionEnFlash = leerCalibracionFlash();
+    if(calibracionEnFlash or leerCalibracionSD()) // Arranque en caliente: empezar a pesar ya con la tara guardada
+    {
+        if(!calibracionEnFlash) guardarCalibracionFlash(); // Recuperada de la SD tras subir el sketch
+
+        scale.set_scale(calibracion.factor);
+        scale.set_offset(calibracion.offset + calibracion.deriva);
+        arranqueEnCaliente = true;
+        refinandoTara = true;
+    }
+    else // Sin calibración guardada: como antes, factor por defecto y tara completa
+    {
+        scale.set_scale(SCALE_CALIBRATION_FACTOR); // Establecer escala inicial. Este valor se ajusta al calibrar la báscula.
+        //scale.tare();  // Tarar tomando la media de 10 medidas
+        scale.tare(5);
+
+        calibracion.factor = SCALE_CALIBRATION_FACTOR;
+        calibracion.offset = scale.get_offset();
+        calibracion.deriva = 0;
+        calibracion.nArranques = 0;
+        guardarCalibracionFlash();
+        arranqueEnCaliente = false;
+        refinandoTara = false;
+    }
+
+    setupFiltroPeso();
+    setupSampler(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN); // A partir de aquí solo lee del HX711 la ISR de DRDY
 
     #if defined(SM_DEBUG)
         SerialPC.println(F("Scale initialized"));
-        SerialPC.print(F("Using calibration factor: ")); SerialPC.println(SCALE_CALIBRATION_FACTOR, 4);
+        SerialPC.print(F("Using calibration factor: ")); SerialPC.println(scale.get_scale(), 4);
+        SerialPC.print(F("Offset: ")); SerialPC.print(scale.get_offset()); 
+        SerialPC.print(F("  (deriva: ")); SerialPC.print(calibracion.deriva); SerialPC.println(F(")"));
         SerialPC.println("++++++++++++++++++++++++++++++++++++++++++++++++++\n");
     #endif
 }
@@ -124,12 +162,18 @@ void setupScale()
 /*-----------------------------------------------------------------------------*/
 /**
  * @brief Realiza la tara de la báscula y actualiza el peso base.
+ * 
+ * La tara toma como offset la salida actual del filtro en lugar de leer del HX711,
+ * que ya está siendo leído por la ISR de DRDY.
  */
  /*-----------------------------------------------------------------------------*/
 void  tareScale()
 { 
-    scale.tare(1);  // 1 toma de valor
-    pesoBascula = weighScale();;
+    long raw;
+    while(popMuestraSampler(raw)) filtrarMuestra(raw); // Filtrar las muestras pendientes antes de fijar la tara
+
+    scale.set_offset(salidaFiltro);
+    pesoBascula = weighScale();
     if(pesoBascula < 1.0) pesoBascula = 0.0; // Saturar a 0.0 el peso mostrado y utilizado (pesoBascula)
     tarado = true;
 };
@@ -154,106 +198,157 @@ void reiniciarPesos()
 /*-----------------------------------------------------------------------------*/
 /**
  * @brief Función para comprobar si ha habido algún evento en la báscula y determinar el tipo de evento.
+ * 
+ * Las muestras del sampler pasan por el filtro (Scale_Filter.h) y solo se evalúa el peso
+ * cuando el detector de estabilidad lo da por asentado. El peso estable se compara con el
+ * último peso estable, de forma que una colocación o retirada genera un único evento, 
+ * en cuanto el plato se asienta, y no los saltos intermedios mientras oscila.
+ * 
+ * Mientras el peso no está estable, el predictor (Scale_Predictor.h) puede publicar un
+ * peso provisional para adelantar la pantalla. Los pesos de la báscula ('pesoBascula',
+ * 'pesoARetirar'...) solo se actualizan con el peso confirmado.
+ * 
+ * Se procesan todas las muestras pendientes y cada cambio de peso estable añade su evento
+ * a la cola de eventos (colaEventosSM), donde loop() los evalúa todos en orden.
  */
 /*-----------------------------------------------------------------------------*/
 void checkBascula()
 {
-    static float newWeight = 0.0;
-    static float lastWeight = 0.0;
-    static float diffWeight = 0.0; 
-    
-    if (pesado)
+    static float newWeight = 0.0;   // Último peso estable
+    static float lastWeight = 0.0;  // Peso estable anterior
+    bool hayEvento = false;         // Se ha generado algún evento en esta llamada
+
+    if(tarado) // Tras tarar, el peso de referencia pasa a ser el tarado (~0) aunque aún no se haya asentado
+    {
+        LOG_SM(LOG_BASCULA_TARANDO);
+        eventoBascula = TARAR;
+        newWeight = weighScale();
+        tarado = false;
+        #if defined(SCALE_TRACE)
+            trazaTara(scale.get_offset(), scale.get_scale());
+        #endif
+    }
+
+    long raw;
+    while(popMuestraSampler(raw))
     {
+        bool estable = filtrarMuestra(raw);
+        actualWeight = weighScale();
+        reportarPrimerPeso();
+
+        #if defined(SCALE_TRACE)
+            trazaMuestra(raw, actualWeight, estable);
+        #endif
+        vueloMuestraBascula(raw, actualWeight, estable);
+
+        if(!estable) // El plato se está moviendo --> esperar a que se asiente, pero estimar ya el peso final
+        {
+            long prediccionRaw;
+            if(predecirPesoFinal(salidaFiltro, prediccionRaw))
+            {
+                float prediccion = (prediccionRaw - scale.get_offset()) / scale.get_scale();
+                if(prediccion < 1.0) prediccion = 0.0; // Saturar a 0.0 igual que 'pesoBascula'
+
+                bool esCambio = abs(prediccion - newWeight) > UMBRAL_MIN_CAMBIO_PESO;
+                bool esNueva  = !hayPesoProvisional or (abs(prediccion - pesoProvisional) > PREDICCION_CAMBIO_MIN);
+                if(esCambio and esNueva)
+                {
+                    pesoProvisional = prediccion;
+                    hayPesoProvisional = true;
+                    refrescarPesoProvisional = true;
+                }
+            }
+            continue;
+        }
+
+        if(refinandoTara) // Arranque en caliente: refinar la tara la primera vez que la báscula se asienta vacía
+        {
+            if((millis() - inicioSetupScale) > CALIBRACION_REFINADO_MS) refinandoTara = false;
+            else if(abs(actualWeight) < UMBRAL_MIN_CAMBIO_PESO)
+            {
+                if(refinarTara(salidaFiltro))
+                {
+                    #if defined(SCALE_TRACE)
+                        trazaTara(scale.get_offset(), scale.get_scale());
+                    #endif
+                    actualWeight = weighScale();
+                    newWeight = actualWeight; // Nuevo cero de referencia, sin evento
+                }
+                continue;
+            }
+        }
+
+        resetPredictor();
+        if(hayPesoProvisional) // Se confirma o descarta el provisional. Si no hay evento, la pantalla debe volver al peso confirmado
+        {
+            hayPesoProvisional = false;
+            refrescarPesoProvisional = true;
+        }
+
         pesoARetirar = pesoRecipiente + pesoPlato;
 
         lastWeight = newWeight;
         newWeight = actualWeight;
-        diffWeight = abs(lastWeight - newWeight);
+
+        cambio_peso_t cambio = clasificarCambioPeso(lastWeight, newWeight, pesoARetirar);
 
 
         // ----------------------------------------------------
         // ------- COMPROBAR SI HA HABIDO EVENTO --------------
         // ----------------------------------------------------
 
-        if(tarado)
+        if(cambio != CAMBIO_NINGUNO) // Si ha habido una variación de peso estable de más de 5 gramos --> evento
         {
-            #if defined(SM_DEBUG)
-                SerialPC.println(F("TARANDO"));
-            #endif
-            eventoBascula = TARAR;
-        }
-        else
-        {
-            if(diffWeight > UMBRAL_MIN_CAMBIO_PESO) // Si ha habido una variación de peso de más de 2 gramos y no ha sido causada por una tara --> evento
-            {
-                #if defined(SM_DEBUG)       
-                    SerialPC.println(F("\n\n----------------------------------------------------------------------------------------------------"));       
-                #endif
+            scaleEventOccurred = true;
+            refinandoTara = false; // Ya se ha colocado algo: se mantiene la tara guardada
+            
+            // 'pesoBascula' representa el peso evitando pequeños saltos en las medidas.
+            //  Este valor es el que se usará como peso individual de los alimentos. 
+              
+            pesoBascula = newWeight;
+            if(pesoBascula < 1.0) pesoBascula = 0.0; // Saturar a 0.0 el peso mostrado y utilizado (pesoBascula)
 
-                scaleEventOccurred = true;
-                
-                // 'pesoBascula' representa el peso evitando pequeños saltos en las medidas.
-                //  Este valor es el que se usará como peso individual de los alimentos. 
-                  
-                pesoBascula = newWeight;
-                if(pesoBascula < 1.0) pesoBascula = 0.0; // Saturar a 0.0 el peso mostrado y utilizado (pesoBascula)
 
+            // ----------------------------------------------------
+            // --------- RECONOCER EVENTO OCURRIDO ----------------
+            // ----------------------------------------------------
 
-                // ----------------------------------------------------
-                // --------- RECONOCER EVENTO OCURRIDO ----------------
-                // ----------------------------------------------------
-
-                if(lastWeight < newWeight) // Incremento de peso   
-                {
-                    #if defined(SM_DEBUG)       
-                        SerialPC.print(F("\nINCREMENTO"));
-                    #endif
+            switch(cambio)
+            {
+                case CAMBIO_INCREMENTO:
                     eventoBascula = INCREMENTO;
-                }
-                else  // Decremento de peso 
-                {
-                    if(newWeight > UMBRAL_BASCULA_VACIA) // Se están retirando elementos de la báscula, pero aún no se ha liberado
-                    {                                    // O se ha liberado pero no había nada en el plato, así que newWeight es 0.0 y pesoARetirar es 0.0
-                        #if defined(SM_DEBUG)
-                            SerialPC.print(F("\nDECREMENTO"));
-                        #endif
-                        eventoBascula = DECREMENTO;
-                    }
-                    else if(abs(abs(newWeight) - pesoARetirar) < UMBRAL_RECIPIENTE_RETIRADO) // Nuevo peso (negativo o 0.0) es contrario (-X = +X) al peso del plato + recipiente ==> se ha quitado todo
-                    {
-                        #if defined(SM_DEBUG)
-                            SerialPC.print(F("\nLIBERADA"));
-                        #endif
-                        eventoBascula = LIBERAR;
-                        flagRecipienteRetirado = true; // Se ha retirado el plato completo --> pantalla recipienteRetirado()
-                    }
-
-                }
+                    break;
 
+                case CAMBIO_DECREMENTO:
+                    eventoBascula = DECREMENTO;
+                    break;
 
-                #if defined(SM_DEBUG)
-                    SerialPC.println(F("\n--------------------------------------"));
-                    SerialPC.print(F("\nPeso anterior: ")); SerialPC.println(lastWeight); 
-                    SerialPC.print(F("Peso actual: ")); SerialPC.println(newWeight); 
-                    SerialPC.print(F("Peso Bascula: ")); SerialPC.println(pesoBascula);
-                    SerialPC.print(F("Peso a retirar: ")); SerialPC.println(pesoARetirar);
-                    SerialPC.print(F("Peso recipiente: ")); SerialPC.println(pesoRecipiente);
-                    SerialPC.print(F("Peso plato: ")); SerialPC.println(pesoPlato);
-                    SerialPC.println(F("\n--------------------------------------"));
-                #endif
+                case CAMBIO_LIBERAR:
+                    eventoBascula = LIBERAR;
+                    flagRecipienteRetirado = true; // Se ha retirado el plato completo --> pantalla recipienteRetirado()
+                    break;
 
-                addEventToBuffer(eventoBascula);
-                flagEvent = true;
+                default: break; // CAMBIO_SIN_CLASIFICAR: se mantiene el último 'eventoBascula'
             }
-            else scaleEventOccurred = false; // No ha habido evento
-        }
 
-        pesado = false;
+            #if defined(SCALE_TRACE)
+                trazaEvento(salidaFiltro, pesoARetirar, cambio, eventoBascula);
+            #endif
 
-        if(tarado) tarado = false;
-    }
 
+            LOG_SM(LOG_BASCULA_EVENTO, eventoBascula, lastWeight, newWeight, pesoBascula, pesoARetirar, pesoRecipiente, pesoPlato);
+            printSamplerStats();
+            #if defined(SCALE_TRACE)
+                printTrazaStats();
+            #endif
 
+            addEventoExterno(eventoBascula);
+            flagEvent = true;
+            hayEvento = true;
+            refrescarPesoProvisional = false; // El nuevo estado ya muestra el peso confirmado
+        }
+        else if(!hayEvento) scaleEventOccurred = false; // No ha habido evento
+    }
 }
 
 
@@ -0,0 +1,229 @@
+/**
+ * @file Scale_Calibration.h
+ * @brief Calibración y tara de la báscula guardadas en la flash del Due
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Se guarda en la flash (DueFlashStorage) el factor de calibración, la última tara
+ * (offset en cuentas brutas) y un modelo de deriva del cero entre arranques. Así, al
+ * arrancar no hace falta tarar con scale.tare(5): se empieza a pesar en cuanto llega
+ * la primera muestra usando la tara guardada corregida con la deriva, y la tara se
+ * refina en segundo plano cuando la báscula se asienta vacía.
+ *
+ * La flash del Due se borra al subir un sketch nuevo, así que el programa de calibración
+ * (calibrate_scale.ino) guarda también una copia en la SD ('fileCalibracion'). Si la
+ * flash no es válida, se recupera de esa copia y, si tampoco existe, se calibra como
+ * antes (SCALE_CALIBRATION_FACTOR y tara de 5 lecturas).
+ *
+ * @note La estructura 'calibracion_t' y su dirección deben coincidir con las de calibrate_scale.ino
+ *
+ * @see Scale.h
+ */
+
+#ifndef SCALE_CALIBRATION_H
+#define SCALE_CALIBRATION_H
+
+#include <stddef.h> // offsetof
+#include <DueFlashStorage.h>
+#include <SD.h>
+#include "Files.h" // fileCalibracion
+#include "debug.h" // SM_DEBUG --> SerialPC
+
+
+#define CALIBRACION_FLASH_ADDRESS   4           // Dirección en la flash (la 0 está reservada para la bandera de verano/invierno de RTC.h)
+#define CALIBRACION_MAGIC           0x53434C31  // "SCL1". Identifica una calibración válida
+#define CALIBRACION_DERIVA_SHIFT    2           // La deriva se actualiza como media exponencial con alpha = 1/4
+#define CALIBRACION_REFINADO_MS     30000       // Tiempo máximo tras arrancar para refinar la tara con la báscula vacía
+#define CALIBRACION_CAMBIO_MIN_G    0.2         // Cambio mínimo de la tara (gramos) para volver a escribir la flash
+
+
+// ------ CALIBRACIÓN GUARDADA -------------------------------------------------
+typedef struct {
+    uint32_t  magic;        // CALIBRACION_MAGIC
+    float     factor;       // Factor de calibración (cuentas por gramo)
+    long      offset;       // Última tara refinada (cuentas brutas)
+    long      deriva;       // Deriva media del cero entre arranques (cuentas brutas)
+    uint16_t  nArranques;   // Arranques en los que se ha refinado la tara
+    uint16_t  checksum;     // Fletcher-16 de los campos anteriores
+} calibracion_t;
+
+DueFlashStorage     dueFlashStorage;            // Objeto para guardar en la flash
+calibracion_t       calibracion;                // Copia en RAM de la calibración guardada
+// -----------------------------------------------------------------------------
+
+// ------ ARRANQUE EN CALIENTE -------------------------------------------------
+bool            arranqueEnCaliente = false;     // Se ha arrancado con la tara guardada (sin scale.tare(5))
+bool            refinandoTara = false;          // Pendiente de refinar la tara en segundo plano
+unsigned long   inicioSetupScale = 0;           // millis() al empezar setupScale()
+unsigned long   tiempoPrimerPeso = 0;           // millis() de la primera muestra filtrada (primer peso válido)
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+uint16_t    checksumCalibracion(calibracion_t &cal);        // Fletcher-16 de la calibración (sin el propio checksum)
+bool        leerCalibracionFlash();                         // Cargar la calibración de la flash en 'calibracion'
+bool        leerCalibracionSD();                            // Cargar la copia de la calibración de la SD en 'calibracion'
+void        guardarCalibracionFlash();                      // Guardar 'calibracion' en la flash
+bool        refinarTara(long cuentasVacia);                 // Actualizar tara y deriva con la báscula asentada vacía
+void        reportarPrimerPeso();                           // Marcar y mostrar el tiempo hasta el primer peso válido
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Calcula el Fletcher-16 de la calibración, sin incluir el campo 'checksum'.
+ * @param cal Calibración
+ * @return Checksum
+ */
+/*-----------------------------------------------------------------------------*/
+uint16_t checksumCalibracion(calibracion_t &cal)
+{
+    uint16_t sum1 = 0, sum2 = 0;
+    byte *datos = (byte*)&cal;
+    for(uint16_t i = 0; i < offsetof(calibracion_t, checksum); i++)
+    {
+        sum1 = (sum1 + datos[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    return (sum2 << 8) | sum1;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Carga la calibración guardada en la flash.
+ * @return 'true' si la flash contiene una calibración válida
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerCalibracionFlash()
+{
+    memcpy(&calibracion, dueFlashStorage.readAddress(CALIBRACION_FLASH_ADDRESS), sizeof(calibracion_t));
+    return (calibracion.magic == CALIBRACION_MAGIC) and (calibracion.checksum == checksumCalibracion(calibracion)) and (calibracion.factor > 0.0);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Carga la copia de la calibración guardada en la SD por calibrate_scale.ino.
+ *        Se usa cuando la flash se ha borrado al subir el sketch.
+ * @return 'true' si la copia existe y es válida
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerCalibracionSD()
+{
+    File myFile = SD.open(fileCalibracion, FILE_READ);
+    if(!myFile) return false;
+
+    int leidos = myFile.read((byte*)&calibracion, sizeof(calibracion_t));
+    myFile.close();
+
+    return (leidos == sizeof(calibracion_t)) and (calibracion.magic == CALIBRACION_MAGIC)
+            and (calibracion.checksum == checksumCalibracion(calibracion)) and (calibracion.factor > 0.0);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Guarda 'calibracion' en la flash, recalculando su checksum.
+ */
+/*-----------------------------------------------------------------------------*/
+void guardarCalibracionFlash()
+{
+    calibracion.magic = CALIBRACION_MAGIC;
+    calibracion.checksum = checksumCalibracion(calibracion);
+    dueFlashStorage.write(CALIBRACION_FLASH_ADDRESS, (byte*)&calibracion, sizeof(calibracion_t));
+
+    #if defined(SM_DEBUG)
+        SerialPC.println(F("Calibracion guardada en flash"));
+    #endif
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Refina la tara con una lectura estable de la báscula vacía tras un arranque
+ *        en caliente y actualiza el modelo de deriva.
+ *
+ * La deriva es la media exponencial de la diferencia entre el cero real medido en
+ * cada arranque y la tara guardada en el anterior. Se suma a la tara guardada en el
+ * siguiente arranque para empezar lo más cerca posible del cero real.
+ *
+ * @param cuentasVacia Salida del filtro (cuentas brutas) con la báscula asentada y vacía
+ * @return 'true' si se ha cambiado el offset de la báscula
+ */
+/*-----------------------------------------------------------------------------*/
+bool refinarTara(long cuentasVacia)
+{
+    refinandoTara = false;
+
+    long offsetActual = scale.get_offset();
+    long derivaMedida = cuentasVacia - calibracion.offset;   // Desplazamiento del cero desde el último arranque
+    calibracion.deriva += (derivaMedida - calibracion.deriva) >> CALIBRACION_DERIVA_SHIFT;
+    calibracion.nArranques++;
+
+    float cambioGramos = abs(cuentasVacia - offsetActual) / scale.get_scale();
+
+    #if defined(SM_DEBUG)
+        SerialPC.print(F("\nTara refinada en segundo plano: ")); SerialPC.print(cambioGramos, 2); SerialPC.println(F(" g de correccion"));
+    #endif
+
+    if(abs(cuentasVacia - calibracion.offset) / scale.get_scale() >= CALIBRACION_CAMBIO_MIN_G)
+    {
+        calibracion.offset = cuentasVacia;
+        guardarCalibracionFlash(); // Solo se escribe la flash si el cero ha cambiado de verdad, para no desgastarla
+    }
+
+    if(cuentasVacia == offsetActual) return false;
+    scale.set_offset(cuentasVacia);
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Marca el instante del primer peso válido tras arrancar y lo muestra.
+ */
+/*-----------------------------------------------------------------------------*/
+void reportarPrimerPeso()
+{
+    if(tiempoPrimerPeso != 0) return;
+    tiempoPrimerPeso = millis();
+
+    #if defined(SM_DEBUG)
+        SerialPC.println(F("\n--- PRIMER PESO VALIDO ---"));
+        SerialPC.print(arranqueEnCaliente ? F("Arranque en caliente") : F("Arranque en frio (tara completa)")); SerialPC.println();
+        SerialPC.print(F("Desde el encendido: ")); SerialPC.print(tiempoPrimerPeso); SerialPC.println(F(" ms"));
+        SerialPC.print(F("Desde setupScale(): ")); SerialPC.print(tiempoPrimerPeso - inicioSetupScale); SerialPC.println(F(" ms"));
+    #endif
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file Scale_Classifier.h
+ * @brief Clasificación de los cambios de peso estable de la báscula
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Decide si un cambio entre dos pesos estables es un incremento, un decremento o
+ * la retirada del recipiente. No depende de la máquina de estados ni del hardware,
+ * por lo que también se compila en la herramienta de PC que reproduce las trazas
+ * de la báscula (tools/scale_trace).
+ *
+ * @see Scale.h
+ */
+
+#ifndef SCALE_CLASSIFIER_H
+#define SCALE_CLASSIFIER_H
+
+
+#define UMBRAL_MIN_CAMBIO_PESO 5.0      // Cambio mínimo del peso para considerar que se ha colocado/retirado algo de la báscula
+#define UMBRAL_RECIPIENTE_RETIRADO 20.0 // Umbral para considerar que se ha retirado todo (recipiente + alimentos) de la báscula
+                                        // 20 gramos porque asumimos que un plato no pesará 20 gramos y así es más fácil detectar si se ha retirado todo
+#define UMBRAL_BASCULA_VACIA 3.0 // Umbral para considerar que la báscula está vacía, pero no se taró antes, así que no baja a negativo
+
+
+// ------ TIPOS DE CAMBIO DE PESO ----------------------------------------------
+typedef enum {
+    CAMBIO_NINGUNO          = 0,    // Variación menor que UMBRAL_MIN_CAMBIO_PESO
+    CAMBIO_INCREMENTO       = 1,    // Se ha colocado algo
+    CAMBIO_DECREMENTO       = 2,    // Se ha retirado algo, pero no todo
+    CAMBIO_LIBERAR          = 3,    // Se ha retirado todo (recipiente + alimentos)
+    CAMBIO_SIN_CLASIFICAR   = 4     // Decremento hasta vacío que no coincide con el peso a retirar
+} cambio_peso_t;
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+cambio_peso_t   clasificarCambioPeso(float lastWeight, float newWeight, float pesoARetirar);  // Tipo de cambio entre dos pesos estables
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Clasifica el cambio entre dos pesos estables consecutivos.
+ * @param lastWeight Peso estable anterior
+ * @param newWeight Peso estable nuevo
+ * @param pesoARetirar Peso que se debe retirar para liberar la báscula (recipiente + alimentos)
+ * @return Tipo de cambio
+ */
+/*-----------------------------------------------------------------------------*/
+cambio_peso_t clasificarCambioPeso(float lastWeight, float newWeight, float pesoARetirar)
+{
+    float diffWeight = lastWeight - newWeight;
+    if(diffWeight < 0) diffWeight = -diffWeight;
+
+    if(diffWeight <= UMBRAL_MIN_CAMBIO_PESO) return CAMBIO_NINGUNO;
+
+    if(lastWeight < newWeight) return CAMBIO_INCREMENTO; // Incremento de peso
+
+    // Decremento de peso
+    if(newWeight > UMBRAL_BASCULA_VACIA) return CAMBIO_DECREMENTO;  // Se están retirando elementos de la báscula, pero aún no se ha liberado
+                                                                    // O se ha liberado pero no había nada en el plato, así que newWeight es 0.0 y pesoARetirar es 0.0
+
+    float pesoRetirado = (newWeight < 0 ? -newWeight : newWeight) - pesoARetirar;
+    if(pesoRetirado < 0) pesoRetirado = -pesoRetirado;
+    if(pesoRetirado < UMBRAL_RECIPIENTE_RETIRADO) return CAMBIO_LIBERAR; // Nuevo peso (negativo o 0.0) es contrario (-X = +X) al peso del plato + recipiente ==> se ha quitado todo
+
+    return CAMBIO_SIN_CLASIFICAR;
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file Scale_Filter.h
+ * @brief Filtro de peso en coma fija y detector de estabilidad
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Etapa de filtrado entre el sampler del HX711 y la clasificación de eventos de
+ * checkBascula(). Cada muestra bruta pasa por:
+ *
+ *      1. Mediana de N muestras      --> elimina picos aislados (golpes, ruido eléctrico)
+ *      2. Media móvil exponencial    --> suaviza el ruido de la célula (alpha = 1/2^FILTRO_EMA_SHIFT)
+ *      3. Detector de estabilidad    --> varianza de las últimas FILTRO_ESTABLE_VENTANA medianas,
+ *                                        cuya media además debe coincidir con la EMA
+ *
+ * El detector mira la salida de la mediana y no la de la EMA: la cola de la EMA tras un
+ * cambio de peso retrasaba la estabilidad unos 300 ms (tools/scale_trace bench). La
+ * comparación con la EMA evita dar por estable una ventana de medianas sesgada por la
+ * oscilación del plato al asentarse. Con el peso estable, la salida es la media de la
+ * ventana; mientras se mueve, la EMA (peso provisional y pantalla).
+ *
+ * Todo se calcula en cuentas brutas del HX711 (enteros), por lo que el filtro no
+ * depende de la tara: tarar solo cambia el offset con el que se pasa a gramos.
+ *
+ * Cada etapa se puede desactivar desde su #define (mediana de 1 muestra, EMA con
+ * shift 0 o ventana de estabilidad de 1 muestra).
+ *
+ * @see Scale.h
+ */
+
+#ifndef SCALE_FILTER_H
+#define SCALE_FILTER_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC
+
+
+#define FILTRO_MEDIANA_N            3       // Muestras de la mediana (impar). 1 = sin mediana
+#define FILTRO_EMA_SHIFT            1       // alpha = 1/2^shift de la media exponencial. 0 = sin media exponencial
+#define FILTRO_EMA_FRAC_BITS        8       // Bits fraccionarios del acumulador de la media exponencial
+#define FILTRO_ESTABLE_VENTANA      3       // Medianas usadas para decidir si el peso está estable
+#define FILTRO_ESTABLE_DESVIACION   0.5     // Desviación típica máxima (gramos) para considerar el peso estable
+#define FILTRO_ESTABLE_ACUERDO      1.5     // Diferencia máxima (gramos) entre la media de la ventana y la EMA
+
+
+// ------ ESTADO DEL FILTRO ---------------------------------------------------
+long      bufferMediana[FILTRO_MEDIANA_N];          // Últimas muestras brutas para la mediana
+byte      posMediana = 0;
+byte      nMediana = 0;
+
+int64_t   acumuladorEMA = 0;                        // Media exponencial en coma fija (cuentas << FILTRO_EMA_FRAC_BITS)
+bool      iniciadoEMA = false;
+
+long      ventanaEstable[FILTRO_ESTABLE_VENTANA];   // Últimas salidas de la mediana para el detector de estabilidad
+byte      posEstable = 0;
+byte      nEstable = 0;
+uint64_t  umbralVarianza = 0;                       // Varianza máxima (cuentas^2) equivalente a FILTRO_ESTABLE_DESVIACION
+long      mediaEstable = 0;                         // Media de la ventana del detector (cuentas brutas)
+long      umbralAcuerdo = 0;                        // FILTRO_ESTABLE_ACUERDO en cuentas brutas
+
+long      salidaFiltro = 0;                         // Última salida del filtro (cuentas brutas)
+bool      pesoEstable = false;                      // El peso lleva FILTRO_ESTABLE_VENTANA medianas sin variar
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+void    setupFiltroPeso();                  // Reiniciar el filtro y calcular el umbral de estabilidad según la escala actual
+long    filtroMediana(long raw);            // Etapa 1: mediana de las últimas FILTRO_MEDIANA_N muestras
+long    filtroEMA(long raw);                // Etapa 2: media móvil exponencial en coma fija
+bool    detectorEstabilidad(long valor);    // Etapa 3: 'true' si la varianza de la ventana está bajo el umbral. Deja la media en 'mediaEstable'
+bool    filtrarMuestra(long raw);           // Pasar una muestra por las tres etapas. Devuelve si el peso está estable
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Reinicia el estado del filtro y calcula el umbral de varianza en cuentas
+ *        brutas a partir del factor de calibración de la báscula.
+ */
+/*-----------------------------------------------------------------------------*/
+void setupFiltroPeso()
+{
+    posMediana = 0;     nMediana = 0;
+    iniciadoEMA = false;
+    posEstable = 0;     nEstable = 0;
+    salidaFiltro = scale.get_offset(); // Sin muestras todavía --> peso 0
+    pesoEstable = false;
+
+    double desviacionCuentas = FILTRO_ESTABLE_DESVIACION * scale.get_scale();
+    umbralVarianza = (uint64_t)(desviacionCuentas * desviacionCuentas);
+    umbralAcuerdo = (long)(FILTRO_ESTABLE_ACUERDO * scale.get_scale());
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Etapa 1: mediana de las últimas FILTRO_MEDIANA_N muestras.
+ * @param raw Muestra bruta nueva
+ * @return Mediana de las muestras disponibles
+ */
+/*-----------------------------------------------------------------------------*/
+long filtroMediana(long raw)
+{
+    bufferMediana[posMediana] = raw;
+    posMediana = (posMediana + 1) % FILTRO_MEDIANA_N;
+    if(nMediana < FILTRO_MEDIANA_N) nMediana++;
+
+    // Ordenación por inserción de una copia (N muy pequeño)
+    long ordenadas[FILTRO_MEDIANA_N];
+    for(byte i = 0; i < nMediana; i++)
+    {
+        long v = bufferMediana[i];
+        byte j = i;
+        while((j > 0) and (ordenadas[j-1] > v)){ ordenadas[j] = ordenadas[j-1]; j--; }
+        ordenadas[j] = v;
+    }
+    return ordenadas[nMediana / 2];
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Etapa 2: media móvil exponencial en coma fija.
+ *        acc += (x - acc) / 2^FILTRO_EMA_SHIFT, con FILTRO_EMA_FRAC_BITS bits fraccionarios.
+ * @param raw Salida de la mediana
+ * @return Media exponencial redondeada a cuentas enteras
+ */
+/*-----------------------------------------------------------------------------*/
+long filtroEMA(long raw)
+{
+    int64_t x = (int64_t)raw << FILTRO_EMA_FRAC_BITS;
+
+    if(!iniciadoEMA){ acumuladorEMA = x; iniciadoEMA = true; }
+    else acumuladorEMA += (x - acumuladorEMA) >> FILTRO_EMA_SHIFT;
+
+    return (long)((acumuladorEMA + (1 << (FILTRO_EMA_FRAC_BITS - 1))) >> FILTRO_EMA_FRAC_BITS);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Etapa 3: detector de estabilidad. Calcula la varianza de las últimas
+ *        FILTRO_ESTABLE_VENTANA medianas y la compara con el umbral. Deja su media en 'mediaEstable'.
+ * @param valor Salida de la mediana
+ * @return 'true' si la ventana está completa y su varianza no supera el umbral
+ */
+/*-----------------------------------------------------------------------------*/
+bool detectorEstabilidad(long valor)
+{
+    ventanaEstable[posEstable] = valor;
+    posEstable = (posEstable + 1) % FILTRO_ESTABLE_VENTANA;
+    if(nEstable < FILTRO_ESTABLE_VENTANA) nEstable++;
+
+    if(nEstable < FILTRO_ESTABLE_VENTANA) return false;
+
+    // Varianza respecto a la primera muestra de la ventana para no desbordar con cuentas grandes
+    int64_t ref = ventanaEstable[0];
+    int64_t suma = 0, sumaCuadrados = 0;
+    for(byte i = 0; i < FILTRO_ESTABLE_VENTANA; i++)
+    {
+        int64_t d = ventanaEstable[i] - ref;
+        suma += d;
+        sumaCuadrados += d * d;
+    }
+    mediaEstable = (long)(ref + ((suma >= 0) ? (suma + FILTRO_ESTABLE_VENTANA / 2) : (suma - FILTRO_ESTABLE_VENTANA / 2)) / FILTRO_ESTABLE_VENTANA);
+
+    // N * sum(d^2) - (sum d)^2 = N^2 * varianza
+    uint64_t varianzaN2 = (uint64_t)(FILTRO_ESTABLE_VENTANA * sumaCuadrados - suma * suma);
+
+    return varianzaN2 <= umbralVarianza * FILTRO_ESTABLE_VENTANA * FILTRO_ESTABLE_VENTANA;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Pasa una muestra bruta por las tres etapas del filtro.
+ *        El peso está estable si la ventana de medianas lo está y su media no se aleja
+ *        de la EMA más de FILTRO_ESTABLE_ACUERDO. 'salidaFiltro' es entonces la media
+ *        de la ventana y, si no, la EMA.
+ * @param raw Muestra bruta del sampler
+ * @return 'true' si el peso está estable tras esta muestra
+ */
+/*-----------------------------------------------------------------------------*/
+bool filtrarMuestra(long raw)
+{
+    long mediana = raw;
+    if(FILTRO_MEDIANA_N > 1) mediana = filtroMediana(raw);
+
+    long suavizado = mediana;
+    if(FILTRO_EMA_SHIFT > 0) suavizado = filtroEMA(mediana);
+
+    pesoEstable = detectorEstabilidad(mediana);
+    if(pesoEstable) pesoEstable = (abs(mediaEstable - suavizado) <= umbralAcuerdo); // Ventana no sesgada por la oscilación del plato
+    salidaFiltro = pesoEstable ? mediaEstable : suavizado;
+    return pesoEstable;
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file Scale_Predictor.h
+ * @brief Predicción del peso final mientras el plato se asienta
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Mientras el detector de estabilidad (Scale_Filter.h) no da el peso por asentado,
+ * la salida del filtro se acerca al peso final de forma aproximadamente geométrica
+ * (la propia célula de carga y la media exponencial se comportan como un sistema de
+ * primer orden). Con tres salidas consecutivas y0, y1, y2 se extrapola el valor
+ * final con el método delta-cuadrado de Aitken:
+ *
+ *      d1 = y1 - y0,   d2 = y2 - y1,   y_final = y2 - d2^2 / (d2 - d1)
+ *
+ * La confianza de la predicción depende de lo que coinciden entre sí las últimas
+ * PREDICCION_VENTANA predicciones: si varían menos que UMBRAL_MIN_CAMBIO_PESO, la
+ * tendencia está clara y se publica un peso provisional.
+ *
+ * El peso provisional solo se usa para refrescar la pantalla antes de tiempo.
+ * 'pesoBascula', 'pesoPlato' y el resto de pesos solo se actualizan con el peso
+ * confirmado (estable) en checkBascula().
+ *
+ * @see Scale.h
+ */
+
+#ifndef SCALE_PREDICTOR_H
+#define SCALE_PREDICTOR_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC
+
+
+#define PREDICCION_VENTANA          3       // Predicciones consecutivas comparadas para calcular la confianza
+#define PREDICCION_CONFIANZA_MIN    60      // Confianza mínima (%) para publicar el peso provisional
+#define PREDICCION_CAMBIO_MIN       1.0     // Cambio mínimo (gramos) del peso provisional para volver a publicarlo
+
+
+// ------ PESO PROVISIONAL -----------------------------------------------------
+float     pesoProvisional = 0.0;                // Peso final estimado mientras el plato se asienta
+byte      confianzaProvisional = 0;             // Confianza (%) del peso provisional
+bool      hayPesoProvisional = false;           // Hay un peso provisional publicado y aún no se ha confirmado
+bool      refrescarPesoProvisional = false;     // El peso provisional ha cambiado (o se ha descartado) y la pantalla debe actualizarse
+// -----------------------------------------------------------------------------
+
+// ------ ESTADO DEL PREDICTOR -------------------------------------------------
+long      historicoPredictor[3];                // Últimas tres salidas del filtro (y0, y1, y2)
+byte      nHistoricoPredictor = 0;
+long      prediccionesRaw[PREDICCION_VENTANA];  // Últimas predicciones en cuentas brutas
+byte      posPrediccion = 0;
+byte      nPredicciones = 0;
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+void    resetPredictor();                                   // Olvidar la curva actual (al asentarse el peso)
+bool    predecirPesoFinal(long valor, long &prediccion);    // Añadir salida del filtro y estimar el valor final. 'true' si la confianza es suficiente
+inline float pesoAMostrar(){ return hayPesoProvisional ? pesoProvisional : pesoBascula; };  // Peso para la pantalla: provisional si lo hay, si no el confirmado
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Olvida la curva de asentamiento actual.
+ */
+/*-----------------------------------------------------------------------------*/
+void resetPredictor()
+{
+    nHistoricoPredictor = 0;
+    posPrediccion = 0;
+    nPredicciones = 0;
+    confianzaProvisional = 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade una salida del filtro a la curva de asentamiento y estima su valor final.
+ * @param valor Salida del filtro (cuentas brutas) mientras el peso no está estable
+ * @param prediccion Valor final estimado (cuentas brutas)
+ * @return 'true' si hay predicción y su confianza alcanza PREDICCION_CONFIANZA_MIN
+ */
+/*-----------------------------------------------------------------------------*/
+bool predecirPesoFinal(long valor, long &prediccion)
+{
+    if(nHistoricoPredictor < 3) historicoPredictor[nHistoricoPredictor++] = valor;
+    else
+    {
+        historicoPredictor[0] = historicoPredictor[1];
+        historicoPredictor[1] = historicoPredictor[2];
+        historicoPredictor[2] = valor;
+    }
+    if(nHistoricoPredictor < 3) return false;
+
+    int64_t d1 = (int64_t)historicoPredictor[1] - historicoPredictor[0];
+    int64_t d2 = (int64_t)historicoPredictor[2] - historicoPredictor[1];
+
+    // Solo se extrapola una curva que se frena: mismo sentido y pasos decrecientes (razón < 0.9)
+    bool mismoSentido = ((d1 > 0) and (d2 > 0)) or ((d1 < 0) and (d2 < 0));
+    if(!mismoSentido or (10 * abs(d2) > 9 * abs(d1)))
+    {
+        nPredicciones = 0; // La curva ha cambiado (nuevo golpe, se sigue colocando...) --> empezar de nuevo
+        posPrediccion = 0;
+        confianzaProvisional = 0;
+        return false;
+    }
+
+    prediccion = (long)(historicoPredictor[2] - (d2 * d2) / (d2 - d1));
+
+    prediccionesRaw[posPrediccion] = prediccion;
+    posPrediccion = (posPrediccion + 1) % PREDICCION_VENTANA;
+    if(nPredicciones < PREDICCION_VENTANA) nPredicciones++;
+    if(nPredicciones < 2) return false;
+
+    // Confianza: 100% si las predicciones coinciden, 0% si difieren UMBRAL_MIN_CAMBIO_PESO o más
+    long minPred = prediccionesRaw[0], maxPred = prediccionesRaw[0];
+    for(byte i = 1; i < nPredicciones; i++)
+    {
+        if(prediccionesRaw[i] < minPred) minPred = prediccionesRaw[i];
+        if(prediccionesRaw[i] > maxPred) maxPred = prediccionesRaw[i];
+    }
+    float dispersion = (maxPred - minPred) / scale.get_scale(); // gramos
+    if(dispersion >= UMBRAL_MIN_CAMBIO_PESO) confianzaProvisional = 0;
+    else confianzaProvisional = (byte)(100.0 * (1.0 - dispersion / UMBRAL_MIN_CAMBIO_PESO));
+
+    return confianzaProvisional >= PREDICCION_CONFIANZA_MIN;
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
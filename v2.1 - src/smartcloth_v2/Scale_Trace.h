@@ -0,0 +1,270 @@
+/**
+ * @file Scale_Trace.h
+ * @brief Grabación binaria de la báscula en la SD (muestras brutas, peso filtrado y eventos)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Solo se compila si SCALE_TRACE está definido en debug.h. Sirve para reproducir en el PC
+ * los eventos fantasma (INCREMENTO, LIBERAR...) que se den en uso real.
+ *
+ * Formato del fichero 'fileTrazaBascula' (little-endian, ver tools/scale_trace):
+ *
+ *      - Sector 0 (512 bytes): cabecera 'cabeceraTraza_t'
+ *      - Sectores 1..TRAZA_SECTORES: buffer circular de registros 'registroTraza_t' de 16 bytes
+ *        (32 registros por sector)
+ *
+ * El fichero se crea una sola vez con su tamaño final y se mantiene abierto. Cada muestra
+ * solo se copia a un sector en RAM (unos pocos us desde checkBascula()); los sectores llenos
+ * se escriben enteros en flushTrazaBascula(), que se llama desde el loop, y tras cada
+ * sector se actualiza la cabecera con la posición de escritura.
+ *
+ * Si el loop se bloquea y se llenan los dos sectores en RAM, los registros nuevos se
+ * descartan y se cuentan en 'registrosTrazaPerdidos'.
+ */
+
+#ifndef SCALE_TRACE_H
+#define SCALE_TRACE_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC; SCALE_TRACE --> Activar grabación de la báscula
+
+#if defined(SCALE_TRACE)
+
+#include <SD.h>
+#include "Files.h" // fileTrazaBascula
+
+
+#define TRAZA_MAGIC             0x52544353  // "SCTR"
+#define TRAZA_VERSION           1
+#define TRAZA_TAM_SECTOR        512
+#define TRAZA_SECTORES          1024        // 512 KB de registros: 32768 muestras (~55 min a 10 SPS)
+#define TRAZA_REG_POR_SECTOR    (TRAZA_TAM_SECTOR / sizeof(registroTraza_t))
+
+// ------ TIPOS DE REGISTRO ---------------------------------------------------
+#define TRAZA_MUESTRA   1   // raw = cuenta bruta,  valor = peso filtrado (mg),  dato = 1 si estable
+#define TRAZA_EVENTO    2   // raw = salida filtro, valor = pesoARetirar (mg),   dato = cambio_peso_t, evento = event_t
+#define TRAZA_TARA      3   // raw = nuevo offset,  valor = factor * 1000
+// -----------------------------------------------------------------------------
+
+
+typedef struct __attribute__((packed)) {
+    uint32_t  tiempo;       // millis()
+    int32_t   raw;
+    int32_t   valor;
+    uint8_t   tipo;         // TRAZA_MUESTRA, TRAZA_EVENTO o TRAZA_TARA
+    uint8_t   dato;
+    uint16_t  evento;
+} registroTraza_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t  magic;            // TRAZA_MAGIC
+    uint16_t  version;          // TRAZA_VERSION
+    uint16_t  tamRegistro;      // sizeof(registroTraza_t)
+    uint32_t  nSectores;        // Sectores de registros (sin contar la cabecera)
+    uint32_t  sectorSiguiente;  // Próximo sector a escribir (0..nSectores-1)
+    uint32_t  vueltas;          // Veces que se ha dado la vuelta al buffer circular
+    uint32_t  sesiones;         // Arranques que han grabado en el fichero
+} cabeceraTraza_t;
+
+
+// ------ ESTADO DE LA GRABACIÓN -----------------------------------------------
+File                trazaFile;                                      // Fichero abierto durante toda la ejecución
+cabeceraTraza_t     cabeceraTraza;
+bool                trazaActiva = false;
+registroTraza_t     sectoresTraza[2][TRAZA_REG_POR_SECTOR];         // Doble buffer de sectores en RAM
+byte                sectorRellenando = 0;                           // Sector que se está rellenando
+uint16_t            nRegistrosSector = 0;                           // Registros en el sector que se está rellenando
+bool                sectorPendiente[2] = {false, false};            // Sector lleno pendiente de escribir en la SD
+
+unsigned long       registrosTrazaPerdidos = 0;                     // Registros descartados por tener los dos sectores llenos
+unsigned long       maxTiempoRegistroTraza = 0;                     // Tiempo máximo (us) de añadir un registro
+unsigned long       maxTiempoFlushTraza = 0;                        // Tiempo máximo (us) de escribir un sector y la cabecera
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+bool    setupTrazaBascula();                                    // Abrir (o crear) el fichero de la traza y leer su cabecera
+void    addRegistroTraza(byte tipo, long raw, long valor, byte dato, uint16_t evento);  // Añadir registro al sector en RAM
+inline void trazaMuestra(long raw, float peso, bool estable){ addRegistroTraza(TRAZA_MUESTRA, raw, (long)(peso * 1000.0), estable, 0); };
+inline void trazaEvento(long salida, float pesoARetirar, byte cambio, uint16_t evento){ addRegistroTraza(TRAZA_EVENTO, salida, (long)(pesoARetirar * 1000.0), cambio, evento); };
+inline void trazaTara(long offset, float factor){ addRegistroTraza(TRAZA_TARA, offset, (long)(factor * 1000.0), 0, 0); };
+void    flushTrazaBascula();                                    // Escribir en la SD los sectores llenos (desde el loop)
+void    printTrazaStats();                                      // Mostrar el coste de la grabación
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Abre el fichero de la traza. Si no existe o no tiene el formato esperado,
+ *        lo crea con su tamaño final (solo la primera vez, tarda unos segundos).
+ * @return 'true' si la grabación queda activa
+ */
+/*-----------------------------------------------------------------------------*/
+bool setupTrazaBascula()
+{
+    const uint32_t tamFichero = (uint32_t)(TRAZA_SECTORES + 1) * TRAZA_TAM_SECTOR;
+
+    trazaFile = SD.open(fileTrazaBascula, O_READ | O_WRITE | O_CREAT); // Sin O_APPEND para poder escribir en cualquier sector
+    if(!trazaFile) return false;
+
+    bool valida = false;
+    if(trazaFile.size() == tamFichero)
+    {
+        trazaFile.seek(0);
+        valida = (trazaFile.read((byte*)&cabeceraTraza, sizeof(cabeceraTraza_t)) == sizeof(cabeceraTraza_t))
+                 and (cabeceraTraza.magic == TRAZA_MAGIC) and (cabeceraTraza.version == TRAZA_VERSION)
+                 and (cabeceraTraza.nSectores == TRAZA_SECTORES) and (cabeceraTraza.sectorSiguiente < TRAZA_SECTORES);
+    }
+
+    if(!valida) // Crear el fichero completo de una vez
+    {
+        #if defined(SM_DEBUG)
+            SerialPC.println(F("Creando fichero de traza de la bascula..."));
+        #endif
+        memset(sectoresTraza, 0, sizeof(sectoresTraza));
+        trazaFile.seek(0);
+        for(uint32_t i = 0; i <= TRAZA_SECTORES; i++) trazaFile.write((byte*)sectoresTraza[0], TRAZA_TAM_SECTOR);
+
+        cabeceraTraza.magic = TRAZA_MAGIC;
+        cabeceraTraza.version = TRAZA_VERSION;
+        cabeceraTraza.tamRegistro = sizeof(registroTraza_t);
+        cabeceraTraza.nSectores = TRAZA_SECTORES;
+        cabeceraTraza.sectorSiguiente = 0;
+        cabeceraTraza.vueltas = 0;
+        cabeceraTraza.sesiones = 0;
+    }
+
+    cabeceraTraza.sesiones++;
+    trazaFile.seek(0);
+    trazaFile.write((byte*)&cabeceraTraza, sizeof(cabeceraTraza_t));
+    trazaFile.flush();
+
+    trazaActiva = true;
+    trazaTara(scale.get_offset(), scale.get_scale()); // Primer registro de la sesión: calibración con la que se convierte a gramos
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade un registro al sector en RAM. No accede a la SD.
+ */
+/*-----------------------------------------------------------------------------*/
+void addRegistroTraza(byte tipo, long raw, long valor, byte dato, uint16_t evento)
+{
+    if(!trazaActiva) return;
+
+    unsigned long inicio = micros();
+
+    if(nRegistrosSector == TRAZA_REG_POR_SECTOR) // Sector lleno: pasar al otro si ya se ha escrito
+    {
+        byte otro = sectorRellenando ^ 1;
+        if(sectorPendiente[otro]){ registrosTrazaPerdidos++; return; }
+        sectorPendiente[sectorRellenando] = true;
+        sectorRellenando = otro;
+        nRegistrosSector = 0;
+    }
+
+    registroTraza_t &reg = sectoresTraza[sectorRellenando][nRegistrosSector++];
+    reg.tiempo = millis();
+    reg.raw = raw;
+    reg.valor = valor;
+    reg.tipo = tipo;
+    reg.dato = dato;
+    reg.evento = evento;
+
+    if(nRegistrosSector == TRAZA_REG_POR_SECTOR) // Marcar ya como pendiente para que el loop lo escriba cuanto antes
+    {
+        byte otro = sectorRellenando ^ 1;
+        if(!sectorPendiente[otro])
+        {
+            sectorPendiente[sectorRellenando] = true;
+            sectorRellenando = otro;
+            nRegistrosSector = 0;
+        }
+    }
+
+    unsigned long tiempo = micros() - inicio;
+    if(tiempo > maxTiempoRegistroTraza) maxTiempoRegistroTraza = tiempo;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Escribe en la SD los sectores llenos y actualiza la cabecera.
+ *        Se llama desde el loop para que la escritura no ocurra dentro de pantallas bloqueantes.
+ */
+/*-----------------------------------------------------------------------------*/
+void flushTrazaBascula()
+{
+    if(!trazaActiva) return;
+
+    for(byte s = 0; s < 2; s++)
+    {
+        byte sector = sectorRellenando ^ 1 ^ s; // Primero el que no se está rellenando (el más antiguo)
+        if(!sectorPendiente[sector]) continue;
+
+        unsigned long inicio = micros();
+
+        trazaFile.seek((uint32_t)(cabeceraTraza.sectorSiguiente + 1) * TRAZA_TAM_SECTOR);
+        trazaFile.write((byte*)sectoresTraza[sector], TRAZA_TAM_SECTOR);
+
+        cabeceraTraza.sectorSiguiente++;
+        if(cabeceraTraza.sectorSiguiente == TRAZA_SECTORES){ cabeceraTraza.sectorSiguiente = 0; cabeceraTraza.vueltas++; }
+
+        trazaFile.seek(0);
+        trazaFile.write((byte*)&cabeceraTraza, sizeof(cabeceraTraza_t));
+        trazaFile.flush();
+
+        sectorPendiente[sector] = false;
+
+        unsigned long tiempo = micros() - inicio;
+        if(tiempo > maxTiempoFlushTraza) maxTiempoFlushTraza = tiempo;
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra el coste de la grabación: máximo por registro, máximo por sector y registros perdidos.
+ */
+/*-----------------------------------------------------------------------------*/
+void printTrazaStats()
+{
+    #if defined(SM_DEBUG)
+        SerialPC.println(F("\n--- TRAZA BASCULA ---"));
+        SerialPC.print(F("Max registro: ")); SerialPC.print(maxTiempoRegistroTraza); SerialPC.println(F(" us"));
+        SerialPC.print(F("Max sector: ")); SerialPC.print(maxTiempoFlushTraza); SerialPC.println(F(" us"));
+        SerialPC.print(F("Perdidos: ")); SerialPC.println(registrosTrazaPerdidos);
+    #endif
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif // SCALE_TRACE
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file Scheduler.h
+ * @brief Planificador del loop dirigido por eventos: las ISR publican tareas y el loop duerme (WFI) sin ellas
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Antes el loop comprobaba 'millis() - prevMillis > period' (50 ms) sin parar, así que cada
+ * pulsación o cambio de peso esperaba hasta el siguiente ciclo para evaluarse y hasta otro
+ * más para que el nuevo estado dibujara su pantalla, y la CPU estaba siempre ocupada.
+ *
+ * Ahora cada ISR, además de guardar su dato en su cola, publica una tarea en 'tareasPendientes'
+ * con postTarea(). esperarTareas() devuelve las tareas pendientes en cuanto las hay y, si no hay
+ * ninguna, duerme el núcleo con WFI hasta la siguiente interrupción. Cada tarea se ejecuta hasta
+ * terminar (run-to-completion): el loop no se vuelve a dormir hasta haberla atendido.
+ *
+ * Las actividades de los estados que dependen del tiempo (pantallas alternas, cancelación tras
+ * 15 segundos, vuelta desde STATE_ERROR tras 3 segundos...) se siguen llamando periódicamente
+ * con el temporizador TAREA_ACTIVIDADES, que también sirve de respaldo por si se perdiera algún
+ * aviso de una ISR. El SysTick del core (1 ms) también despierta al núcleo, pero solo se
+ * atiende si ha vencido algún temporizador.
+ *
+ * Se mide el porcentaje de tiempo dormido (CPU libre) y la latencia desde que ocurre un evento
+ * (millis() de la ISR o del detector de la báscula) hasta que el nuevo estado ha hecho sus
+ * actividades. Con LOOP_STATS (debug.h) se muestran por SerialPC cada PERIODO_ESTADISTICAS.
+ *
+ * Las pantallas animadas (Screen.h) ya no esperan con delay(): cada TAREA_ANIMACION avanzan un
+ * tramo hasta su siguiente espera y devuelven el control al loop. También se mide el tramo más
+ * largo, que es lo máximo que puede tardar el loop en atender un evento mientras se anima.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "debug.h" // SM_DEBUG --> SerialPC; LOOP_STATS --> Mostrar latencia y CPU libre
+#include "HAL.h"   // halDormir() --> WFI
+#include "Debug_Log.h" // vaciarLog() --> TAREA_LOG
+
+
+// ------ TAREAS ------------------------------------------------------------------
+#define TAREA_BOTONES           0x01    // Pulsación en alguna botonera o en el botón de barcode (ISR de botones)
+#define TAREA_BASCULA           0x02    // Muestra nueva del HX711 (ISR de DRDY)
+#define TAREA_ACTIVIDADES       0x04    // Temporizador de las actividades del estado actual
+#define TAREA_ESTADISTICAS      0x08    // Temporizador para mostrar la latencia y la CPU libre (solo con LOOP_STATS)
+#define TAREA_ANIMACION         0x10    // Temporizador para continuar la pantalla animada en curso (Screen.h)
+#define TAREA_LOG               0x20    // Temporizador para enviar por SerialPC el log binario pendiente (solo con SM_DEBUG)
+// -----------------------------------------------------------------------------
+
+#define PERIODO_ACTIVIDADES     50      // ms. Igual que el antiguo 'period' del loop: basta para las pantallas alternas y los timeouts
+#define PERIODO_ESTADISTICAS    10000   // ms
+#define PERIODO_ANIMACION       5       // ms. La mitad de la espera más corta de las animaciones (10 ms entre pasos de opacidad)
+#define PERIODO_LOG             5       // ms. A 115200 baudios salen ~58 bytes, menos que el buffer de transmisión del UART
+
+
+// ------ TEMPORIZADORES ----------------------------------------------------------
+typedef struct {
+    unsigned long   periodo;    // ms
+    unsigned long   ultimo;     // millis() de la última vez que se publicó su tarea
+    byte            tarea;      // Tarea que publica al vencer
+} temporizador_t;
+
+temporizador_t temporizadores[] = {
+    { PERIODO_ACTIVIDADES,  0, TAREA_ACTIVIDADES  },
+    { PERIODO_ANIMACION,    0, TAREA_ANIMACION    },
+    #if defined(LOOP_STATS)
+    { PERIODO_ESTADISTICAS, 0, TAREA_ESTADISTICAS },
+    #endif
+    #if defined(SM_DEBUG)
+    { PERIODO_LOG,          0, TAREA_LOG          },
+    #endif
+};
+
+#define NUM_TEMPORIZADORES  (sizeof(temporizadores) / sizeof(temporizador_t))
+// -----------------------------------------------------------------------------
+
+
+// ------ ESTADO DEL PLANIFICADOR -------------------------------------------------
+// Las ISR solo hacen '|=' sobre 'tareasPendientes'. Todas las interrupciones de los pines tienen la
+// misma prioridad, así que no se anidan entre sí, y el loop lee y limpia la palabra con las
+// interrupciones deshabilitadas.
+volatile byte   tareasPendientes = 0;
+// -----------------------------------------------------------------------------
+
+// ------ ESTADÍSTICAS ------------------------------------------------------------
+unsigned long   inicioVentanaCPU = 0;       // micros() de inicio de la ventana de medida de CPU libre
+unsigned long   tiempoDormido = 0;          // us dormido (WFI) en la ventana actual
+unsigned long   nDespertares = 0;           // Veces que se ha despertado el núcleo en la ventana actual
+unsigned long   nLatencias = 0;             // Transiciones medidas desde el arranque
+unsigned long   sumaLatencias = 0;          // ms
+unsigned long   maxLatencia = 0;            // ms
+unsigned long   maxRodajaAnimacion = 0;     // us. Tramo más largo de una pantalla animada entre dos esperas (continuarAnimacion())
+unsigned long   nRodajasExcedidas = 0;      // Tramos de animación que han superado PRESUPUESTO_PT_US (Protothread.h)
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+inline void     postTarea(byte tarea){ tareasPendientes |= tarea; };   // Publicar una tarea (desde una ISR)
+byte            revisarTemporizadores();                                // Tareas de los temporizadores que han vencido
+byte            esperarTareas();                                        // Dormir hasta que haya alguna tarea y devolverlas
+void            registrarLatencia(unsigned long tiempoEvento);          // Medir la latencia de un evento hasta la pantalla del nuevo estado
+void            printPlanificadorStats();                               // Mostrar latencia y CPU libre, y empezar una nueva ventana
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           DEFINICIÓN FUNCIONES
+/******************************************************************************/
+/******************************************************************************/
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Comprueba los temporizadores. Los que han vencido se rearman desde ahora, así
+ *        que si el loop ha estado bloqueado varios periodos solo se publica una vez su tarea.
+ * @return Tareas de los temporizadores vencidos
+ */
+/*-----------------------------------------------------------------------------*/
+byte revisarTemporizadores()
+{
+    byte tareas = 0;
+    unsigned long ahora = millis();
+
+    for(byte i = 0; i < NUM_TEMPORIZADORES; i++)
+    {
+        if((ahora - temporizadores[i].ultimo) >= temporizadores[i].periodo)
+        {
+            temporizadores[i].ultimo = ahora;
+            tareas |= temporizadores[i].tarea;
+        }
+    }
+    return tareas;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Devuelve las tareas pendientes (publicadas por las ISR o por los temporizadores)
+ *        y las marca como atendidas. Si no hay ninguna, duerme el núcleo hasta la siguiente
+ *        interrupción.
+ *
+ * La comprobación y el WFI se hacen con las interrupciones deshabilitadas (PRIMASK). Una
+ * interrupción pendiente despierta igualmente al núcleo, pero su ISR no se ejecuta hasta
+ * interrupts(). Así no se puede perder el aviso de una ISR que llegue justo entre la
+ * comprobación y el WFI.
+ *
+ * @return Tareas a atender (nunca 0)
+ */
+/*-----------------------------------------------------------------------------*/
+byte esperarTareas()
+{
+    while(true)
+    {
+        byte tareasTemporizadores = revisarTemporizadores();
+
+        noInterrupts();
+        byte tareas = tareasPendientes | tareasTemporizadores;
+        if(tareas)
+        {
+            tareasPendientes = 0;
+            interrupts();
+            return tareas;
+        }
+
+        unsigned long inicio = micros();
+        halDormir();
+        tiempoDormido += micros() - inicio;
+        nDespertares++;
+        interrupts(); // Se ejecuta la ISR que ha despertado al núcleo
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Registra la latencia de un evento: desde que ocurrió hasta ahora, justo después de
+ *        las actividades del estado al que ha llevado.
+ * @param tiempoEvento millis() en que ocurrió el evento
+ */
+/*-----------------------------------------------------------------------------*/
+void registrarLatencia(unsigned long tiempoEvento)
+{
+    unsigned long latencia = millis() - tiempoEvento;
+    sumaLatencias += latencia;
+    nLatencias++;
+    if(latencia > maxLatencia) maxLatencia = latencia;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra la latencia media y máxima desde el arranque y el porcentaje de CPU libre
+ *        en la última ventana. Después empieza una nueva ventana de CPU libre.
+ */
+/*-----------------------------------------------------------------------------*/
+void printPlanificadorStats()
+{
+    unsigned long ahora = micros();
+
+    #if defined(SM_DEBUG)
+        unsigned long ventana = ahora - inicioVentanaCPU;
+
+        SerialPC.println(F("\n--- PLANIFICADOR ---"));
+        SerialPC.print(F("CPU libre: ")); SerialPC.print(ventana ? (100.0 * tiempoDormido / ventana) : 0.0, 1);
+        SerialPC.print(F(" %  (")); SerialPC.print(nDespertares); SerialPC.println(F(" despertares)"));
+        SerialPC.print(F("Latencia evento-pantalla: media ")); SerialPC.print(nLatencias ? (sumaLatencias / nLatencias) : 0);
+        SerialPC.print(F(" ms, max ")); SerialPC.print(maxLatencia);
+        SerialPC.print(F(" ms  (")); SerialPC.print(nLatencias); SerialPC.println(F(" transiciones)"));
+        SerialPC.print(F("Tramo de animacion: max ")); SerialPC.print(maxRodajaAnimacion);
+        SerialPC.print(F(" us  (")); SerialPC.print(nRodajasExcedidas); SerialPC.println(F(" por encima del presupuesto)"));
+    #endif
+
+    inicioVentanaCPU = ahora;
+    tiempoDormido = 0;
+    nDespertares = 0;
+}
+
+
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+#endif
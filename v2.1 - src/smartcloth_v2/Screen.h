@@ -176,8 +176,10 @@
 bool    eventOccurred(); // Comprobar si ha habido interrupciones de botoneras o eventos de báscula
 
 #include "ISR.h" 
+#include "Protothread.h" // Pantallas animadas reanudables (sin delay())
 #include "RA8876_v2.h" // COLORS.h
 #include "State_Machine.h"  // Incluye SD_functions.h (Serial_functions.h)
+#include "Debug_Log.h" // LOG_SM()
 
 
 /* Screen circuit wiring */
@@ -248,6 +250,218 @@ RA8876 tft = RA8876(RA8876_CS, RA8876_RESET);
 #define SCREEN_HEIGHT 600
 
 
+// Pantalla animada en curso. Es un protohilo (Protothread.h) que avanza un tramo cada vez que se llama
+// a continuarAnimacion() desde loop() (TAREA_ANIMACION), en lugar de bloquear el loop con delay().
+typedef char (*animacion_t)(pt_t *pt, byte option);
+
+animacion_t   animacionActual = NULL;   // NULL --> ninguna animación en curso
+byte          opcionAnimacion = 0;      // 'option' con la que se llama a la animación en cada tramo
+pt_t          ptAnimacion;              // Punto por el que va la animación
+
+
+// Línea de tiempo de fotogramas clave. Los fundidos (aparecer/desaparecer una imagen poco a poco) se
+// describen con una tabla constante de fotogramas clave en lugar de un bucle de opacidades con esperas
+// de 10 ms. avanzarTimeline() calcula en qué paso de su rampa de opacidad tiene que estar cada clave
+// según el tiempo transcurrido desde iniciarTimeline() y solo dibuja las que han cambiado de paso. Si el
+// loop se retrasa, se salta los pasos intermedios en lugar de alargar la animación, y en cada llamada no
+// dibuja más de TIMELINE_PRESUPUESTO_SPI bytes (las claves que no caben se dibujan en la siguiente).
+// Al terminar o cancelarse (cancelarAnimacion()) se envía LOG_TIMELINE con los fotogramas por segundo,
+// la CPU y los bytes SPI de cada fotograma y los pasos saltados.
+#define   CLAVE_APARECER              0   // Al acabar la rampa: copia opaca de la imagen
+#define   CLAVE_DESAPARECER           1   // Al acabar la rampa: borrar el destino (más el margen) con 'color'
+
+#define   TIMELINE_MAX_CLAVES         12  // Claves de la tabla más larga (welcome(): 10 letras y el logo)
+#define   TIMELINE_PRESUPUESTO_SPI    256 // Bytes SPI por llamada a avanzarTimeline(). Un paso son ~10 (solo cambia la opacidad) o ~50 (otra imagen)
+#define   TIMELINE_MARGEN_BORRADO     5   // Píxeles que se borran alrededor del destino en CLAVE_DESAPARECER
+
+#define   DURACION_FUNDIDO            320 // ms de una rampa de 32 pasos de opacidad (32 --> 1, uno cada 10 ms como los bucles de antes)
+#define   DURACION_FUNDIDO_CRUZADO    270 // ms de una rampa de 27 pasos (4 --> 30 y 30 --> 4)
+
+typedef struct {
+    byte          tipo;           // CLAVE_APARECER o CLAVE_DESAPARECER
+    uint16_t      inicio;         // ms desde iniciarTimeline() hasta el primer paso
+    uint16_t      duracion;       // ms desde el primer paso hasta la acción final
+    uint32_t      paginaImagen;   // Página de SDRAM con la imagen (S0)
+    uint16_t      xImagen, yImagen;
+    uint16_t      xFondo, yFondo; // Fondo con el que se mezcla (S1), en paginaDibujo
+    uint16_t      x, y;           // Destino, en paginaDibujo
+    uint16_t      ancho, alto;
+    byte          alfaInicial;    // Opacidad del primer paso (RA8876_ALPHA_OPACITY_x)
+    byte          alfaFinal;      // Opacidad que se alcanzaría en el último paso, que es la acción final
+    uint16_t      color;          // Color de borrado (CLAVE_DESAPARECER)
+} fotogramaClave_t;
+
+#define   PASO_NINGUNO                0xFF  // Clave que aún no ha empezado
+#define   PASO_TERMINADA              0xFE  // Clave que ya ha hecho su acción final
+
+const fotogramaClave_t  *clavesTimeline = NULL;         // NULL --> ninguna línea de tiempo en curso
+byte                    nClavesTimeline = 0;
+byte                    pasoTimeline[TIMELINE_MAX_CLAVES]; // Último paso dibujado de cada clave
+unsigned long           inicioTimeline;                 // millis() al iniciarla
+
+// Estadísticas de la línea de tiempo en curso (LOG_TIMELINE)
+uint16_t                fotogramasTimeline;             // Llamadas a avanzarTimeline() que han dibujado algo
+uint16_t                pasosSaltadosTimeline;          // Pasos de opacidad no dibujados por llegar tarde
+unsigned long           cpuTimeline;                    // us de CPU sumando todos los fotogramas
+unsigned long           maxCpuTimeline;                 // us del fotograma más largo
+uint32_t                bytesTimeline;                  // Bytes SPI sumando todos los fotogramas
+
+
+// Composición fuera de pantalla. El RA8876 muestra 'paginaMostrada' y todas las funciones de Screen.h 
+// dibujan en 'paginaDibujo' (canvas y destino de las BTE). Normalmente son la misma, así que lo que se 
+// dibuja se ve según se dibuja (animaciones, parpadeos, campos del dashboard). Entre empezarComposicion() 
+// y presentarComposicion() se dibuja en la otra página de pantalla, que no se ve, y al presentar se 
+// cambia la página mostrada de una vez: no se ven pantallas a medio dibujar ni el fondo borrado.
+// PAGE2-PAGE4 guardan las imágenes cargadas de la SD, por eso la segunda página es PAGE5.
+#define   PAGINA_PANTALLA_A   PAGE1_START_ADDR
+#define   PAGINA_PANTALLA_B   PAGE5_START_ADDR  // 0x4B0000: con PAGE1 solo cambia el registro MISA2
+
+uint32_t      paginaMostrada = PAGINA_PANTALLA_A; // Página que muestra el RA8876
+uint32_t      paginaDibujo   = PAGINA_PANTALLA_A; // Página en la que se dibuja
+
+
+// Atlas de imágenes (fileAtlas): todas las imágenes de PAGE2-PAGE4 en un solo fichero, creado en el PC
+// con tools/atlas. Formato: cabecera, manifiesto (una entrada por imagen, en orden de carga) y los 
+// datos de cada imagen, empezando en un sector (512 bytes): comprimidos en Q565 (RA8876_v2.h) o, si
+// así no ocupan menos, los píxeles RGB565 tal cual, igual que en los .bin sueltos.
+#define   ATLAS_MAGIC           0x54414353  // "SCAT"
+#define   ATLAS_VERSION         3
+#define   ATLAS_MAX_IMAGENES    64
+
+#define   ATLAS_RGB565          0           // Formato de los datos de una imagen
+#define   ATLAS_Q565            1
+
+// Sin 'packed': todos los campos quedan alineados sin relleno, y así se puede leer y escribir la
+// firma como un array de unsigned short (readPicture_16bpp()/putPicture_16bpp()).
+typedef struct {
+    uint32_t  magic;
+    uint16_t  version;
+    uint16_t  nImagenes;
+    uint32_t  hashImagenes;             // FNV-1a de los píxeles RGB565 de todas las imágenes (tools/atlas)
+} cabeceraAtlas_t;
+
+typedef struct __attribute__((packed)) {
+    char      nombre[12];               // Solo para tools/atlas
+    uint8_t   pagina;                   // 2, 3 o 4 --> PAGE2, PAGE3 o PAGE4
+    uint8_t   formato;                  // ATLAS_RGB565 o ATLAS_Q565
+    uint16_t  x;                        // Posición en la página (la que usan las pantallas)
+    uint16_t  y;
+    uint16_t  ancho;
+    uint16_t  alto;
+    uint32_t  offset;                   // Primer byte de sus datos en el fichero
+    uint32_t  bytes;                    // Bytes de datos
+} imagenAtlas_t;
+
+inline uint32_t direccionPaginaAtlas(byte pagina){ return PAGE2_START_ADDR + (uint32_t)(pagina - 2) * (PAGE3_START_ADDR - PAGE2_START_ADDR); };
+
+
+// Firma de las imágenes cargadas. Si el Due se reinicia sin que se apague la pantalla, la SDRAM 
+// conserva PAGE2-PAGE4 y no hace falta volver a leer las imágenes de la SD. Al terminar de cargar el 
+// atlas se escribe en PAGINA_FIRMA, que no usa ninguna pantalla, el hash del atlas y, por cada imagen,
+// el de FIRMA_FILAS de sus filas leídas de la SDRAM. Al arrancar, si la firma es válida y del mismo 
+// atlas, solo se cargan las imágenes cuyas filas han cambiado. Tras un arranque en frío la SDRAM no 
+// tiene una firma válida y se carga todo, como antes.
+#define   FIRMA_MAGIC           0x4D524946  // "FIRM"
+#define   PAGINA_FIRMA          PAGE6_START_ADDR
+#define   FIRMA_FILAS           3           // Primera, central y última fila de cada imagen
+
+// Sin 'packed': todos los campos quedan alineados sin relleno, y así se puede leer y escribir la
+// firma como un array de unsigned short (readPicture_16bpp()/putPicture_16bpp()).
+typedef struct {
+    uint32_t  magic;
+    uint32_t  hashAtlas;                // FNV-1a de la cabecera y el manifiesto del atlas
+    uint16_t  nImagenes;
+    uint16_t  reservado;
+    uint32_t  hashImagen[ATLAS_MAX_IMAGENES];   // hashImagenSDRAM() de cada imagen al cargarla
+    uint32_t  hash;                     // FNV-1a de los campos anteriores
+} firmaSDRAM_t;
+
+static_assert(sizeof(firmaSDRAM_t) == 4 + 4 + 2 + 2 + 4 * ATLAS_MAX_IMAGENES + 4, "firmaSDRAM_t: no debe tener relleno (se guarda tal cual en la SDRAM)");
+
+byte      imagenesEnSDRAM = 0;          // Imágenes del atlas que no se han cargado en este arranque porque ya estaban
+
+
+// Dashboard retenido (zonas 3 y 4). Cada zona recuerda el texto que muestra cada uno de sus campos
+// numéricos. Mientras el dashboard siga en pantalla, printZona3() y printZona4() solo borran y
+// vuelven a escribir los caracteres que cambian (las fuentes del CGROM son de ancho fijo), en lugar
+// de redibujar la zona completa. Se redibuja entera si se ha mostrado otra pantalla encima
+// ('showingTemporalScreen'), si cambia lo que muestra la zona o tras invalidarDashboard().
+#define   CAMPO_MAX_TEXTO   16          // Caracteres máximos de un campo (con el '\0')
+
+typedef struct {
+    FontSize  fuente;                   // Fuente del CGROM (ancho fijo: 8x16, 12x24 o 16x32)
+    byte      escalaX;                  // RA8876_TEXT_W_SCALE_X..
+    byte      escalaY;                  // RA8876_TEXT_H_SCALE_X..
+    uint16_t  color;
+    uint16_t  fondo;                    // Color del recuadro, con el que se borran los caracteres
+} estiloCampo_t;
+
+typedef struct {
+    uint16_t      x;                        // Cursor del primer carácter
+    uint16_t      y;
+    estiloCampo_t estilo;
+    char          texto[CAMPO_MAX_TEXTO];   // Texto que se muestra ahora
+} campoDashboard_t;
+
+typedef struct {
+    bool              valida;           // 'false' --> la próxima vez se redibuja la zona completa
+    byte              contenido;        // Qué se dibujó (SHOW_..._ZONA3/4 o ZONA3_COMIDA_GUARDADA)
+    campoDashboard_t  peso;
+    campoDashboard_t  carb;
+    campoDashboard_t  prot;
+    campoDashboard_t  grasas;
+    campoDashboard_t  kcal;
+    campoDashboard_t  racCarb;
+    campoDashboard_t  racProt;
+    campoDashboard_t  racGrasas;
+} zonaDashboard_t;
+
+#define   ZONA3_COMIDA_GUARDADA   2     // 'contenido' de la zona 3 con "Comida guardada" (SHOW_COMIDA_ACTUAL_ZONA3 tras guardar)
+
+zonaDashboard_t   zonasDashboard[2];    // SHOW_VALORES_ZONA3 y SHOW_VALORES_ZONA4
+
+const estiloCampo_t ESTILO_PESO         = { RA8876_FONT_SIZE_24, RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2, ROJO_PESO,       GRIS_CUADROS };
+const estiloCampo_t ESTILO_CARB         = { RA8876_FONT_SIZE_32, RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1, AZUL_CARB,       GRIS_CUADROS };
+const estiloCampo_t ESTILO_PROT         = { RA8876_FONT_SIZE_32, RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1, NARANJA_PROT,    GRIS_CUADROS };
+const estiloCampo_t ESTILO_GRASAS       = { RA8876_FONT_SIZE_32, RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1, AMARILLO_GRASAS, GRIS_CUADROS };
+const estiloCampo_t ESTILO_KCAL         = { RA8876_FONT_SIZE_24, RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2, ROJO_KCAL,       GRIS_CUADROS };
+const estiloCampo_t ESTILO_RACION_1     = { RA8876_FONT_SIZE_24, RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2, WHITE,           GRIS_CUADROS_VALORES }; // 1 cifra entera
+const estiloCampo_t ESTILO_RACION_2     = { RA8876_FONT_SIZE_16, RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X3, WHITE,           GRIS_CUADROS_VALORES }; // 2 o más cifras enteras (alargada)
+
+inline uint16_t anchoCaracter(const estiloCampo_t &e){ return (e.fuente + 2) * 4 * (e.escalaX + 1); };
+inline uint16_t altoCaracter(const estiloCampo_t &e){ return (e.fuente + 2) * 8 * (e.escalaY + 1); };
+
+
+// Caché de glifos (PAGINA_GLIFOS). Al arrancar, cargarCacheGlifos() escribe con el motor de texto una fila
+// por estilo de campo con los caracteres de GLIFOS sobre el color de fondo del campo. Después, 
+// actualizarCampo() compone los valores copiando esas celdas con el BTE (bteMemoryCopyGlyphs()) en lugar
+// de configurar el motor de texto (fuente, escala, color y cursor) a 3MHz en cada campo. Los textos con 
+// algún carácter que no está en la caché (p. ej. "nan") se siguen escribiendo con el motor de texto.
+#define   PAGINA_GLIFOS       PAGE7_START_ADDR
+const char GLIFOS[] = "0123456789.- gKcal";
+#define   NUM_GLIFOS          (sizeof(GLIFOS) - 1)
+
+const estiloCampo_t *const estilosGlifos[] = { &ESTILO_PESO, &ESTILO_CARB, &ESTILO_PROT, &ESTILO_GRASAS, &ESTILO_KCAL, &ESTILO_RACION_1, &ESTILO_RACION_2 };
+#define   NUM_ESTILOS_GLIFOS  (sizeof(estilosGlifos) / sizeof(estilosGlifos[0]))
+
+uint16_t  filaGlifos[NUM_ESTILOS_GLIFOS];   // 'y' de la fila de cada estilo en PAGINA_GLIFOS
+bool      cacheGlifosLista = false;         // cargarCacheGlifos() ya ha dibujado la caché
+
+
+// Texto de un campo. Se escribe con print() igual que en la pantalla, para que el formato de los
+// números sea el mismo que con tft.print().
+class TextoCampo : public Print
+{
+public:
+    char    texto[CAMPO_MAX_TEXTO];
+    byte    n;
+
+    TextoCampo() : n(0) { texto[0] = '\0'; };
+    size_t  write(uint8_t c) { if(n < (CAMPO_MAX_TEXTO - 1)){ texto[n++] = c; texto[n] = '\0'; return 1; } return 0; };
+    using   Print::write;
+};
+
+
 
 
 /*******************************************************************************
@@ -265,11 +479,16 @@ void    printGrupoyEjemplos();                                  // Zona 1 => Mos
 void    printProcesamiento();                                   // Zona 2 => Mostrar imagen de 'crudo' o 'cocinado' según el procesamiento activo => STATE_raw y STATE_cooked
 void    printZona3(byte show_objeto);                           // Zona 3 => Mostrar comida actual copiada (SHOW_COMIDA_ACTUAL_ZONA3) o alimento actual (SHOW_ALIMENTO_ACTUAL_ZONA3)
 void    printZona4(byte show_objeto);                           // Zona 4 => Mostrar comida actual real (SHOW_COMIDA_ACTUAL_ZONA4) o acumulado hoy (SHOW_ACUMULADO_HOY_ZONA4)
-void    showValores(ValoresNutricionales &valores, byte zona);  // Mostrar valores en la 'zona' correspondiente (SHOW_VALORES_ZONA3 O SHOW_VALORES_ZONA4).
-void    showRaciones(ValoresNutricionales &valores, byte zona); // Mostrar raciones con decimales mínimos y centradas según la 'zona' (SHOW_RACIONES_ZONA3 o SHOW_RACIONES_ZONA4).
+byte    showValores(ValoresNutricionales &valores, byte zona);  // Mostrar valores en la 'zona' correspondiente (SHOW_VALORES_ZONA3 O SHOW_VALORES_ZONA4). Devuelve los campos redibujados
+byte    showRaciones(ValoresNutricionales &valores, byte zona); // Mostrar raciones con decimales mínimos y centradas según la 'zona' (SHOW_RACIONES_ZONA3 o SHOW_RACIONES_ZONA4). Devuelve los campos redibujados
+void    invalidarDashboard();                                   // Forzar que las zonas 3 y 4 se redibujen completas la próxima vez
+bool    zonaDashboardCompleta(byte zona, byte contenido);       // Comprobar si hay que redibujar la zona completa y, si es así, olvidar sus campos
+byte    actualizarCampo(campoDashboard_t &campo, uint16_t x, uint16_t y, const estiloCampo_t &estilo, const char *texto); // Escribir en pantalla solo los caracteres de 'texto' que han cambiado
+void    cargarCacheGlifos();                                    // Dibujar en PAGINA_GLIFOS los caracteres de los campos con cada estilo
+bool    escribirGlifos(uint16_t x, uint16_t y, const estiloCampo_t &estilo, const char *texto, byte n, const char *anterior); // Componer 'texto' con glifos de la caché (si están todos) donde no coincide con 'anterior'
 void    showDashboardStyle1(byte msg_option);                   // Mostrar dashboard estilo 1 (zonas 1-2 vacías y con mensaje, Comida copiada en zona 3 y Acumulado en zona 4) => STATE_Init y STATE_Plato
 void    showDashboardStyle2();                                  // Mostrar dashboard estilo 2 (zonas 1-2 rellenas, Alimento en zona 3 y Comida en zona 4) => STATE_groupA/B, STATE_raw/cooked y STATE_weighted
-bool    showSemiDashboard_PedirProcesamiento();                 // Mostrar medio dashboard (zonas 1 y 2). Las zonas 3 y 4 se tapan con pantalla de pedir procesamiento => STATE_groupA/B
+void    showSemiDashboard_PedirProcesamiento();                 // Mostrar medio dashboard (zonas 1 y 2). Las zonas 3 y 4 se tapan con pantalla de pedir procesamiento => STATE_groupA/B
 // -- Dahsboard barcode ------
 void    printGrupo_Barcode();                                   // Mostrar grupo de alimentos (50, barcode) en zona 1 que cubre zona 2
 void    showDashboardStyle2_Barcode();                          // Mostrar dashboard estilo 2 con el producto leído y el alimento en zona 3 y la comida en zona 4 => STATE_Barcode
@@ -282,11 +501,11 @@ void    showSavingMeal_connectionState(bool hayConexionInternet); // Mostrar pan
 // -- Info para sincronizar ---
 void    showSyncState(byte option);   // Sincronizar memoria de SmartCloth con Web
 // -- Recipiente ---------
-void    pedirRecipiente();                  // Pedir colocar recipiente          =>  STATE_Init
+char    pedirRecipiente(pt_t *pt, byte option);     // Pedir colocar recipiente (animación)  =>  STATE_Init
 void    recipienteColocado();               // Mostrar "Recipiente colocado"     =>  solo una vez en STATE_Plato
 void    recipienteRetirado();               // Mostrar "Recipiente retirado"     =>  solo si se ha retirado (LIBERAR --> STATE_Init)
 // -- Grupo --------------
-void    pedirGrupoAlimentos();              // Pedir escoger grupo de alimentos  =>  STATE_Plato
+char    pedirGrupoAlimentos(pt_t *pt, byte option); // Pedir escoger grupo de alimentos (animación)  =>  STATE_Plato
 
 // -- Barcode ------------
 void    showScanningBarcode();                  // Mostrar "Escaneando código"        =>  STATE_Barcode
@@ -297,21 +516,21 @@ void    pedirConfirmacionProducto(String &productInfo);   // Mostrar informació
 
 // -- Procesamiento ------
 //void    pedirProcesamiento();             // Pedir escoger crudo o cocinado    =>  STATE_groupA y STATE_groupB
-bool    formGraphicsPedirProcesamiento();   // Compone la pantalla (forma, colores, texto y 1º botón de cocinado) de pedir procesamiento sobre las zonas 3 y 4 del dashboard.
-bool    alternateButtonsProcesamiento();    // Alterna imágenes de botones crudo y cocinado 
-bool    pedirProcesamientoZonas3y4();       // Pedir procesamiento sobre zonas 3 y 4 del dashboard  =>  STATE_groupA y STATE_groupB
+char    formGraphicsPedirProcesamiento(pt_t *pt, byte option);   // (Animación) Compone la pantalla (forma, colores, texto y 1º botón de cocinado) de pedir procesamiento sobre las zonas 3 y 4 del dashboard.
+void    alternateButtonsProcesamiento();    // Alterna imágenes de botones crudo y cocinado 
+void    pedirProcesamientoZonas3y4();       // Pedir procesamiento sobre zonas 3 y 4 del dashboard  =>  STATE_groupA y STATE_groupB
 // -- Colocar alimento ---
-void    pedirAlimento();                    // Pedir colocar alimento
+char    pedirAlimento(pt_t *pt, byte option);       // Pedir colocar alimento (animación)
 // -- Sugerir acción ----
-void    sugerirAccion();                    // Sugerir acción: añadir más alimento, escoger otro grupo, añadir otro plato, borrar plato actual o guardar comida.
+char    sugerirAccion(pt_t *pt, byte option);       // (Animación) Sugerir acción: añadir más alimento, escoger otro grupo, añadir otro plato, borrar plato actual o guardar comida.
 // -- Confirmar acción ---
-void    pedirConfirmacion(byte option);     // Pregunta de confirmación general  =>  STATE_add_check (option: 1), STATE_delete_check (option: 2) y STATE_save_check (option: 3)
+char    pedirConfirmacion(pt_t *pt, byte option);   // (Animación) Pregunta de confirmación general  =>  STATE_add_check (option: 1), STATE_delete_check (option: 2) y STATE_save_check (option: 3)
 // -- Acción realizada ---
 void    showAccionRealizada(byte option);   // Mensaje general de confirmación   =>  STATE_added (option: 1), STATE_deleted (option: 2) y STATE_saved (option: 3)
 // -- Acción cancelada ---
 void    showCancel(byte option);            // Mensaje de "Acción cancelada" para add/delete/save o leer barcode, o "Producto cancelado" para el producto buscado
 // --- Plato retirado sin avisar ---
-void    checkIntencionRemoval();        // Pantalla para preguntar qué intención tenía al retirar el plato: "Guardar y crear otro" o "Eliminar"
+char    checkIntencionRemoval(pt_t *pt, byte option);   // (Animación) Pantalla para preguntar qué intención tenía al retirar el plato: "Guardar y crear otro" o "Eliminar"
 void    showBorradoAutomatico();            // Pantalla de borrado automático del plato porque no se ha recibido respuesta de lo que se quería hacer con él
 // -- Fallo crítico en SD ---
 void    showCriticFailureSD();              // Pantalla de fallo crítico al inicializar la SD ("Fallo en la memoria interna de SM")
@@ -323,11 +542,17 @@ void    showWarning(byte option);           // Warning de acción innecesaria =>
 
 
 // -- Aparición/Desaparición imágenes --
-bool    slowAppearanceImage(byte option);                          // Mostrar imagen de cociGra (option = 1) o scale (option = 2)
-bool    slowAppearanceAndDisappareanceProcesamiento(byte option);  // Mostrar crudoGra desapareciendo y cociGra apareciendo (option = 1) o viceversa (option = 2)
+char    slowAppearanceImage(pt_t *pt, byte option);                          // (Protohilo) Mostrar apareciendo la imagen SLOW_APPEAR_x (clavesAparicion[])
+char    slowAppearanceAndDisappareanceProcesamiento(pt_t *pt, byte option);  // (Animación) Mostrar crudoGra desapareciendo y cociGra apareciendo (option = 1) o viceversa (option = 2)
 
 // --- CARGA DE IMÁGENES ---
 void    loadPicturesShowHourglass();        // Cargar imágenes en la SDRAM de la pantalla mientras se muestra un reloj de arena (hourglass)
+bool    cargarAtlasImagenes();              // Cargar todas las imágenes de una pasada desde el atlas de la SD
+void    cargarImagenesSueltas();            // Cargar las imágenes de sus ficheros sueltos (si no hay atlas)
+uint32_t hashImagenSDRAM(const imagenAtlas_t &img);   // FNV-1a de FIRMA_FILAS filas de una imagen del atlas, leídas de la SDRAM
+bool    leerFirmaSDRAM(firmaSDRAM_t &firma);          // Leer la firma de PAGINA_FIRMA y comprobar que es válida
+void    escribirFirmaSDRAM(firmaSDRAM_t &firma);      // Escribir la firma en PAGINA_FIRMA (calcula su hash)
+void    invalidarFirmaSDRAM();                        // Borrar la firma antes de cambiar las imágenes de PAGE2-PAGE4
 void    putReloj1();
 void    putReloj2();
 void    putReloj3();
@@ -344,12 +569,31 @@ void    putRelojGirado6();
 bool    eventOccurred();                    // Comprobar si ha habido interrupciones de botoneras o eventos de báscula
 
 /*-----------------------------------------------------------------------------*/
-// --- ESPERA E INTERRUPCION ---
-bool    doubleDelayAndCheckInterrupt(unsigned long period);  // El tiempo especificado se divide a la mitad y se comprueba interrupción tras cada espera
+// --- ANIMACIONES (SIN BLOQUEO) ---
+void    iniciarAnimacion(animacion_t animacion, byte option = 0);   // Empezar una pantalla animada (sustituye a la que hubiera) y hacer su primer tramo
+void    continuarAnimacion();                                       // Hacer el siguiente tramo de la animación en curso (TAREA_ANIMACION)
+void    cancelarAnimacion();                                        // Dejar la animación donde esté (evento o transición)
+inline bool isAnimacionEnCurso(){ return animacionActual != NULL; };
+
+/*-----------------------------------------------------------------------------*/
+// --- LÍNEA DE TIEMPO (FOTOGRAMAS CLAVE) ---
+void    iniciarTimeline(const fotogramaClave_t *claves, byte n);    // Empezar a reproducir una tabla de fotogramas clave (sustituye a la que hubiera)
+bool    avanzarTimeline();                                          // Dibujar los pasos que tocan según el tiempo transcurrido. 'false' cuando ya no queda nada
+void    detenerTimeline(bool cancelada = true);                     // Dejarla donde esté y enviar sus estadísticas
+void    dibujarPasoClave(const fotogramaClave_t &clave, byte paso, byte pasos);    // Dibujar un paso de la rampa de una clave (el último es la acción final)
+
+// Desde un protohilo: reproducir una tabla de claves hasta el final, cediendo la CPU entre fotogramas
+#define PT_TIMELINE(pt, claves, n)  do{ iniciarTimeline(claves, n); PT_WAIT_UNTIL(pt, !avanzarTimeline()); }while(0)
+
+/*-----------------------------------------------------------------------------*/
+// --- COMPOSICIÓN FUERA DE PANTALLA ---
+void    empezarComposicion(bool partirDeMostrada = false);          // Dibujar en la página que no se ve (opcionalmente, partiendo de lo que se ve)
+void    presentarComposicion();                                     // Mostrar de una vez lo compuesto y volver a dibujar en la página mostrada
+inline bool isComponiendo(){ return paginaDibujo != paginaMostrada; };
 
 /*-----------------------------------------------------------------------------*/
 // --- MOVIMIENTO PANTALLAS GRUPOS Y CONFIRMACIÓN ---
-bool    desplazar_mano(byte option);   // Desplazar imagen de "mano" por la pantalla hasta el botón correspondiente. Devuelve bool para poder salir de pedirConfirmacion() si hay interrupción.
+char    desplazar_mano(pt_t *pt, byte option);   // (Protohilo) Desplazar imagen de "mano" por la pantalla hasta el botón correspondiente
 void    sin_pulsacion(byte option);    // Mano sobre botón sin pulsación 
 void    con_pulsacion(byte option);    // Pulsación de mano en botón
 
@@ -396,7 +640,7 @@ void setupScreen()
         while(1);
     }
 
-    tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+    tft.canvasImageStartAddress(paginaDibujo); 
     tft.clearScreen(BLACK); 
 
     //SCREEN_WIDTH = tft.getWidth(); // X
@@ -412,33 +656,223 @@ void setupScreen()
 
 
 /***************************************************************************************************/
-/*---------------------------- INTERRUPCIONES   ---------------------------------------------------*/
+/*---------------------------- ANIMACIONES (SIN BLOQUEO) ------------------------------------------*/
 /***************************************************************************************************/
 
 /*---------------------------------------------------------------------------------------------------------
-   doubleDelayAndCheckInterrupt(): Divide a la mitad el tiempo especificado y hace dos (double) delays según
-                                   esos valores. Tras cada espera, comprueba si ha habido interrupciones.
+   iniciarAnimacion(): Empieza una pantalla animada y hace su primer tramo (hasta la primera espera). Los
+                       siguientes tramos se hacen en continuarAnimacion(), así que las esperas entre dibujos
+                       ya no bloquean el loop. Si había otra animación en curso, se deja donde estuviera.
           Parámetros:
-                - period --> período de tiempo que se quiere esperar pero "escuchando" a las interrupciones.
-          Return:
-                - true --> ha habido interrupcion durante algún delay
-                - false --> no ha habido interrupción durante ningún delay
+                - animacion --> pantalla animada (pedirRecipiente, pedirConfirmacion...)
+                - option --> opción con la que se llama a la animación en cada tramo
 ----------------------------------------------------------------------------------------------------------*/
-bool doubleDelayAndCheckInterrupt(unsigned long period){
-    unsigned long timeForDelay = period/2;
-
-    // ----- INT -------------------
-    if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-    // ----- ESPERA ----
-    delay(timeForDelay);
-    // ----- INT -------------------
-    if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula) 
-    // ----- ESPERA ----
-    delay(timeForDelay);
-    // -------- INT -------------------
-    if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
+void iniciarAnimacion(animacion_t animacion, byte option){
+    detenerTimeline();
+    animacionActual = animacion;
+    opcionAnimacion = option;
+    PT_INIT(&ptAnimacion);
+
+    continuarAnimacion();
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   continuarAnimacion(): Hace el siguiente tramo de la animación en curso, si la hay. Se llama desde loop()
+                         con TAREA_ANIMACION. Mide lo que ocupa cada tramo (printPlanificadorStats()).
+----------------------------------------------------------------------------------------------------------*/
+void continuarAnimacion(){
+    if(animacionActual == NULL) return;
+
+    inicioRodajaPT = micros();
+    char estado = animacionActual(&ptAnimacion, opcionAnimacion);
+    unsigned long rodaja = micros() - inicioRodajaPT;
+
+    if(rodaja > maxRodajaAnimacion) maxRodajaAnimacion = rodaja;
+    if(rodaja > PRESUPUESTO_PT_US) nRodajasExcedidas++;
+
+    if(estado == PT_TERMINADA) animacionActual = NULL;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   cancelarAnimacion(): Deja la animación en curso donde esté, incluida la línea de tiempo que estuviera
+                        reproduciendo. Se llama al llegar un evento de botonera o báscula
+                        (addEventoExterno()) y en cada transición.
+----------------------------------------------------------------------------------------------------------*/
+void cancelarAnimacion(){
+    animacionActual = NULL;
+    detenerTimeline();
+}
+
+
+
+/***************************************************************************************************/
+/*---------------------------- LÍNEA DE TIEMPO (FOTOGRAMAS CLAVE) ---------------------------------*/
+/***************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------
+   iniciarTimeline(): Empieza a reproducir una tabla de fotogramas clave. El tiempo de cada clave cuenta
+                      desde ahora. Si había otra línea de tiempo en curso, se deja donde estuviera.
+          Parámetros:
+                - claves --> tabla constante de fotogramas clave (se lee mientras dure, no se copia)
+                - n --> número de claves (hasta TIMELINE_MAX_CLAVES)
+----------------------------------------------------------------------------------------------------------*/
+void iniciarTimeline(const fotogramaClave_t *claves, byte n){
+    detenerTimeline();
+
+    clavesTimeline = claves;
+    nClavesTimeline = min(n, (byte)TIMELINE_MAX_CLAVES);
+    for(byte i = 0; i < nClavesTimeline; i++) pasoTimeline[i] = PASO_NINGUNO;
+    inicioTimeline = millis();
+
+    fotogramasTimeline = 0;
+    pasosSaltadosTimeline = 0;
+    cpuTimeline = 0;
+    maxCpuTimeline = 0;
+    bytesTimeline = 0;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   avanzarTimeline(): Dibuja el paso que le toca a cada clave según el tiempo transcurrido, si no es el que
+                      ya tiene dibujado. Una clave de P pasos (|alfaFinal - alfaInicial|) está en el paso
+                      (t - inicio) * P / duracion; el paso P es la acción final. Los pasos por los que no se
+                      ha pasado a tiempo no se dibujan. En cada llamada se dibuja al menos una clave y, después,
+                      solo mientras no se haya llegado a TIMELINE_PRESUPUESTO_SPI bytes.
+          Return: 'true' mientras quedan claves por terminar, 'false' cuando ya han terminado todas (o no
+                  hay línea de tiempo en curso)
+----------------------------------------------------------------------------------------------------------*/
+bool avanzarTimeline(){
+    if(clavesTimeline == NULL) return false;
+
+    unsigned long inicioCpu = micros();
+    uint32_t bytesInicio = tft.getBytesSPI();
+    unsigned long t = millis() - inicioTimeline;
+    bool dibujado = false;
+    bool pendientes = false;
+
+    for(byte i = 0; i < nClavesTimeline; i++)
+    {
+        if(pasoTimeline[i] == PASO_TERMINADA) continue;
+
+        const fotogramaClave_t &clave = clavesTimeline[i];
+        if((t < clave.inicio) or (dibujado and ((tft.getBytesSPI() - bytesInicio) >= TIMELINE_PRESUPUESTO_SPI)))
+        {
+            pendientes = true;  // Aún no ha empezado o no cabe en este fotograma
+            continue;
+        }
+
+        byte pasos = abs((int)clave.alfaFinal - (int)clave.alfaInicial);
+        byte paso = ((t - clave.inicio) >= clave.duracion) ? pasos : (t - clave.inicio) * pasos / clave.duracion;
+        if(paso == pasoTimeline[i]){ pendientes = true; continue; }
+
+        byte anterior = (pasoTimeline[i] == PASO_NINGUNO) ? 0 : pasoTimeline[i] + 1;
+        pasosSaltadosTimeline += paso - anterior;
+
+        dibujarPasoClave(clave, paso, pasos);
+        dibujado = true;
+
+        if(paso < pasos){ pasoTimeline[i] = paso; pendientes = true; }
+        else pasoTimeline[i] = PASO_TERMINADA;
+    }
+
+    if(dibujado)
+    {
+        unsigned long cpu = micros() - inicioCpu;
+        fotogramasTimeline++;
+        cpuTimeline += cpu;
+        if(cpu > maxCpuTimeline) maxCpuTimeline = cpu;
+        bytesTimeline += tft.getBytesSPI() - bytesInicio;
+    }
+
+    if(!pendientes) detenerTimeline(false);
+    return pendientes;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   detenerTimeline(): Deja la línea de tiempo en curso donde esté y envía sus estadísticas (LOG_TIMELINE).
+          Parámetros:
+                - cancelada --> 'true' si no ha llegado al final (evento, transición u otra animación)
+----------------------------------------------------------------------------------------------------------*/
+void detenerTimeline(bool cancelada){
+    if(clavesTimeline == NULL) return;
+
+    unsigned long ms = millis() - inicioTimeline;
+    uint16_t n = fotogramasTimeline ? fotogramasTimeline : 1;
+    LOG_SM(LOG_TIMELINE, cancelada ? "cancelada" : "terminada", ms, fotogramasTimeline,
+           ms ? (fotogramasTimeline * 1000UL / ms) : 0UL, cpuTimeline / n, maxCpuTimeline, bytesTimeline / n, pasosSaltadosTimeline);
+
+    clavesTimeline = NULL;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   dibujarPasoClave(): Dibuja un paso de la rampa de opacidad de una clave: la imagen mezclada con su fondo
+                       con la opacidad del paso o, en el último paso, la acción final (copia opaca de la
+                       imagen o borrado del destino).
+          Parámetros:
+                - clave --> fotograma clave
+                - paso --> paso a dibujar (0..pasos)
+                - pasos --> pasos de la rampa
+----------------------------------------------------------------------------------------------------------*/
+void dibujarPasoClave(const fotogramaClave_t &clave, byte paso, byte pasos){
+    if(paso < pasos)
+    {
+        int alfa = clave.alfaInicial + ((int)clave.alfaFinal - (int)clave.alfaInicial) * paso / pasos;
+        tft.bteMemoryCopyWithOpacity(clave.paginaImagen,SCREEN_WIDTH,clave.xImagen,clave.yImagen,paginaDibujo,SCREEN_WIDTH,clave.xFondo,clave.yFondo,
+                                     paginaDibujo,SCREEN_WIDTH,clave.x,clave.y,clave.ancho,clave.alto,alfa);
+    }
+    else if(clave.tipo == CLAVE_APARECER)
+    {
+        tft.bteMemoryCopy(clave.paginaImagen,SCREEN_WIDTH,clave.xImagen,clave.yImagen,paginaDibujo,SCREEN_WIDTH,clave.x,clave.y,clave.ancho,clave.alto);
+    }
+    else
+    {
+        tft.clearArea(clave.x - TIMELINE_MARGEN_BORRADO, clave.y - TIMELINE_MARGEN_BORRADO,
+                      clave.x + clave.ancho + TIMELINE_MARGEN_BORRADO, clave.y + clave.alto + TIMELINE_MARGEN_BORRADO, clave.color);
+    }
+}
+
+
+
+/***************************************************************************************************/
+/*---------------------------- COMPOSICIÓN FUERA DE PANTALLA --------------------------------------*/
+/***************************************************************************************************/
+
+/*---------------------------------------------------------------------------------------------------------
+   empezarComposicion(): Lo que se dibuje a partir de ahora va a la página de pantalla que no se muestra,
+                         hasta llamar a presentarComposicion(). Entre una y otra no se puede ceder la CPU
+                         (PT_ESPERAR, PT_CEDER...) ni salir sin presentar, porque lo dibujado no se vería.
+          Parámetros:
+                partirDeMostrada --> 'true' si se va a dibujar sobre lo que ya se ve (p.ej. solo unas zonas
+                                     del dashboard): se copia antes la página mostrada con una BTE. Si la 
+                                     pantalla se dibuja entera desde clearScreen(), no hace falta.
+----------------------------------------------------------------------------------------------------------*/
+void empezarComposicion(bool partirDeMostrada)
+{
+    if(isComponiendo()) return; // Ya se está componiendo: se sigue en la misma página
+
+    paginaDibujo = (paginaMostrada == PAGINA_PANTALLA_A) ? PAGINA_PANTALLA_B : PAGINA_PANTALLA_A;
+    tft.canvasImageStartAddress(paginaDibujo);
+
+    if(partirDeMostrada) tft.bteMemoryCopy(paginaMostrada,SCREEN_WIDTH,0,0,paginaDibujo,SCREEN_WIDTH,0,0,SCREEN_WIDTH,SCREEN_HEIGHT);
+}
 
-    return false;
+
+/*---------------------------------------------------------------------------------------------------------
+   presentarComposicion(): Muestra la página compuesta cambiando la dirección de la imagen principal del 
+                           RA8876. PAGINA_PANTALLA_A y PAGINA_PANTALLA_B solo se diferencian en un byte, así 
+                           que solo cambia el valor de un registro (MISA2) y nunca se lee una dirección a medias.
+                           Después se sigue dibujando en la página mostrada.
+----------------------------------------------------------------------------------------------------------*/
+void presentarComposicion()
+{
+    if(!isComponiendo()) return;
+
+    tft.displayImageStartAddress(paginaDibujo);
+    paginaMostrada = paginaDibujo;
 }
 
 
@@ -447,6 +881,28 @@ bool doubleDelayAndCheckInterrupt(unsigned long period){
 /*---------------------------- BIENVENIDA A SMARTCLOTH   ------------------------------------------*/
 /***************************************************************************************************/
 
+/*---------------------------------------------------------------------------------------------------------
+   Letras y logo de SmartCloth en welcome(): cada uno aparece poco a poco (opacidad 32 --> 1) sobre el fondo
+   blanco de la pantalla (S1 en 0,400), 400 ms después del anterior. El logo, debajo, al final.
+----------------------------------------------------------------------------------------------------------*/
+#define   INTERVALO_LETRAS_WELCOME    400
+
+const fotogramaClave_t clavesWelcome[] = {
+    // tipo          inicio                          duración          imagen            x    y   fondo    destino   ancho alto  alfa   color
+    { CLAVE_APARECER, 0*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR,   0,   0,  0, 400,  40, 150,  95, 159, 32, 0,  0 },   // S
+    { CLAVE_APARECER, 1*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 392,   0,  0, 400, 428, 150, 104, 159, 32, 0,  0 },   // T1
+    { CLAVE_APARECER, 2*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 669,   0,  0, 400, 702, 150,  85, 159, 32, 0,  0 },   // O
+    { CLAVE_APARECER, 3*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 392,   0,  0, 400, 787, 150, 104, 159, 32, 0,  0 },   // T2
+    { CLAVE_APARECER, 4*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR,  96,   0,  0, 400, 135, 150, 104, 159, 32, 0,  0 },   // M
+    { CLAVE_APARECER, 5*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 583,   0,  0, 400, 617, 150,  85, 159, 32, 0,  0 },   // L
+    { CLAVE_APARECER, 6*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 306,   0,  0, 400, 343, 150,  85, 159, 32, 0,  0 },   // R
+    { CLAVE_APARECER, 7*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 201,   0,  0, 400, 239, 150, 104, 159, 32, 0,  0 },   // A
+    { CLAVE_APARECER, 8*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 497,   0,  0, 400, 532, 150,  85, 159, 32, 0,  0 },   // C
+    { CLAVE_APARECER, 9*INTERVALO_LETRAS_WELCOME,    DURACION_FUNDIDO, PAGE2_START_ADDR, 755,   0,  0, 400, 891, 150,  85, 159, 32, 0,  0 },   // H
+    { CLAVE_APARECER, 10*INTERVALO_LETRAS_WELCOME,   DURACION_FUNDIDO, PAGE2_START_ADDR, 841,   0,  0, 400, 417, 350, 162, 169, 32, 0,  0 },   // Logo
+};
+
+
 /*---------------------------------------------------------------------------------------------------------
    Welcome(): Carga las imágenes que se van a usar (loadPicturesShowHourglass) mientras muestra un reloj
               de arena y después muestra el logo de SmartCloth (wireframe de arranque).
@@ -458,11 +914,9 @@ void welcome()
         SerialPC.println(F("\n      WELCOME TO SMARTCLOTH\n"));
         SerialPC.println("**************************************************\n\n");
     #endif
-    uint8_t i; // Variable i de los bucles for para ir modificando la opacidad de las imágenes y que aparezcan poco a poco
-
     showingTemporalScreen = false; // Desactivar flag de estar mostrando pantalla temporal/transitoria
 
-    //tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+    //tft.canvasImageStartAddress(paginaDibujo); 
     //tft.clearScreen(BLACK); 
 
     // 1 -  Cargar imágenes mientras muestra reloj de arena
@@ -470,110 +924,13 @@ void welcome()
 
 
     // 2 - Mostrar Logo SmartCloth
-    //tft.canvasImageStartAddress(PAGE1_START_ADDR);  // YA ESTÁ
+    //tft.canvasImageStartAddress(paginaDibujo);  // YA ESTÁ
     tft.clearScreen(WHITE); // Fondo blanco en PAGE1
     delay(200);
 
     // S M A R T C L O T H ==> S T O T M L R A C H (orden de aparición)
-
-    // ----------- LETRA S ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar S apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,0,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,40,150,95,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,0,0,PAGE1_START_ADDR,SCREEN_WIDTH,40,150,95,159);       // S (95x159) 
-    delay(80);
-
-    // ----------- LETRA T1 ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar T1 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,392,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,428,150,104,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,392,0,PAGE1_START_ADDR,SCREEN_WIDTH,428,150,104,159);   // T1 (104x159)
-    delay(80);
-
-    // ----------- LETRA O ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar  apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,669,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,702,150,85,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,669,0,PAGE1_START_ADDR,SCREEN_WIDTH,702,150,85,159);    // O (85x159)
-    delay(80);
-    
-    // ----------- LETRA T2 ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar T2 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,392,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,787,150,104,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,392,0,PAGE1_START_ADDR,SCREEN_WIDTH,787,150,104,159);   // T2 (104x159) 
-    delay(80);
-
-    // ----------- LETRA M ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar M apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,96,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,135,150,104,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,96,0,PAGE1_START_ADDR,SCREEN_WIDTH,135,150,104,159);    // M (104x154) 
-    delay(80);
-    
-    // ----------- LETRA L ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar L apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,583,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,617,150,85,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,583,0,PAGE1_START_ADDR,SCREEN_WIDTH,617,150,85,159);    // L (85x159) 
-    delay(80);
-
-    // ----------- LETRA R ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar R apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,306,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,343,150,85,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,306,0,PAGE1_START_ADDR,SCREEN_WIDTH,343,150,85,159);    // R (85x159) 
-    delay(80);
-
-    // ----------- LETRA A ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar A apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,201,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,239,150,104,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,201,0,PAGE1_START_ADDR,SCREEN_WIDTH,239,150,104,159);   // A (104x159) 
-    delay(80);
-
-    // ----------- LETRA C ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar C apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,497,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,532,150,85,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,497,0,PAGE1_START_ADDR,SCREEN_WIDTH,532,150,85,159);    // C (85x159) 
-    delay(80);
-
-    // ----------- LETRA H ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar H apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,755,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,891,150,85,159,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,755,0,PAGE1_START_ADDR,SCREEN_WIDTH,891,150,85,159);    // H (85x159) 
-    delay(80);   
-
-    
-    // ----------- LOGO ----------------------
-    for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-        // Mostrar LOGO apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-        tft.bteMemoryCopyWithOpacity(PAGE2_START_ADDR,SCREEN_WIDTH,841,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,400,PAGE1_START_ADDR,SCREEN_WIDTH,417,350,162,169,i);
-        delay(10);
-    }
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,841,0,PAGE1_START_ADDR,SCREEN_WIDTH,417,350,162,169);   // Logo (162x169) ==> debajo
+    iniciarTimeline(clavesWelcome, sizeof(clavesWelcome)/sizeof(clavesWelcome[0]));
+    while(avanzarTimeline()) delay(PERIODO_ANIMACION); // En setup() no hay nada más que hacer mientras tanto
     
     delay(500);
 }
@@ -632,8 +989,8 @@ void blinkGrupoyProcesamiento(byte msg_option){
                 tft.setCursor(50,50);
                 tft.setTextForegroundColor(WHITE);
 
-                if(msg_option == MSG_SIN_RECIPIENTE) tft.print(convertSpecialCharactersToHEX("NO SE HA COLOCADO NINGÚN RECIPIENTE"));  // 16x32 escale x1
-                else if(msg_option == MSG_SIN_GRUPO) tft.print(convertSpecialCharactersToHEX("NO SE HA SELECCIONADO NINGÚN GRUPO DE ALIMENTOS"));  // 16x32 escale x1
+                if(msg_option == MSG_SIN_RECIPIENTE) tft.print(LATIN1("NO SE HA COLOCADO NINGÚN RECIPIENTE"));  // 16x32 escale x1
+                else if(msg_option == MSG_SIN_GRUPO) tft.print(LATIN1("NO SE HA SELECCIONADO NINGÚN GRUPO DE ALIMENTOS"));  // 16x32 escale x1
             }
             // ----- FIN ZONA 1 -------------------------------------
 
@@ -646,7 +1003,7 @@ void blinkGrupoyProcesamiento(byte msg_option){
             // Dibujar cuadro cocinado
             tft.fillRoundRect(937,20,994,74,10,GRIS_CUADROS); 
             // Mostrar cociPeq con opacidad a nivel 24/32. Utiliza un recuadro de color GRIS_CUADROS escrito en page3 como S1.
-            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,PAGE1_START_ADDR,SCREEN_WIDTH,942,26,47,42,RA8876_ALPHA_OPACITY_24);
+            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,paginaDibujo,SCREEN_WIDTH,942,26,47,42,RA8876_ALPHA_OPACITY_24);
             // Resaltado en cuadro cocinado
             tft.drawRoundRect(937,20,994,74,10,RED); // Resaltado x1 en cuadro cocinado
             tft.drawRoundRect(938,21,993,73,10,RED); // Resaltado x2 en cuadro cocinado
@@ -657,7 +1014,7 @@ void blinkGrupoyProcesamiento(byte msg_option){
             // Dibujar cuadro crudo
             tft.fillRoundRect(937,79,994,133,10,GRIS_CUADROS); 
             // Mostrar crudoPeq con opacidad a nivel 24/32. Utiliza un recuadro de color GRIS_CUADROS escrito en page3 como S1.
-            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,PAGE1_START_ADDR,SCREEN_WIDTH,942,85,47,42,RA8876_ALPHA_OPACITY_24);
+            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,paginaDibujo,SCREEN_WIDTH,942,85,47,42,RA8876_ALPHA_OPACITY_24);
             // Resaltado en cuadro crudo
             tft.drawRoundRect(937,79,994,133,10,RED); // Resaltado x1 en cuadro crudo
             tft.drawRoundRect(938,80,993,132,10,RED); // Resaltado x2 en cuadro crudo
@@ -686,8 +1043,8 @@ void blinkGrupoyProcesamiento(byte msg_option){
                 tft.setCursor(50,50);
                 tft.setTextForegroundColor(WHITE);
 
-                if(msg_option == MSG_SIN_RECIPIENTE) tft.print(convertSpecialCharactersToHEX("NO SE HA COLOCADO NINGÚN RECIPIENTE"));  // 16x32 escale x1
-                else if(msg_option == MSG_SIN_GRUPO) tft.print(convertSpecialCharactersToHEX("NO SE HA SELECCIONADO NINGÚN GRUPO DE ALIMENTOS"));  // 16x32 escale x1
+                if(msg_option == MSG_SIN_RECIPIENTE) tft.print(LATIN1("NO SE HA COLOCADO NINGÚN RECIPIENTE"));  // 16x32 escale x1
+                else if(msg_option == MSG_SIN_GRUPO) tft.print(LATIN1("NO SE HA SELECCIONADO NINGÚN GRUPO DE ALIMENTOS"));  // 16x32 escale x1
             
             }
             // ----- FIN ZONA 1 -------------------------------------
@@ -701,14 +1058,14 @@ void blinkGrupoyProcesamiento(byte msg_option){
             // Dibujar cuadro cocinado
             tft.fillRoundRect(937,20,994,74,10,GRIS_CUADROS); 
             // Mostrar cociPeq con opacidad a nivel 24/32. Utiliza un recuadro de color GRIS_CUADROS escrito en page3 como S1.
-            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,PAGE1_START_ADDR,SCREEN_WIDTH,942,26,47,42,RA8876_ALPHA_OPACITY_24);
+            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,paginaDibujo,SCREEN_WIDTH,942,26,47,42,RA8876_ALPHA_OPACITY_24);
             // ----- FIN COCINADO -----
 
             // ----- CRUDO ------------
             // Dibujar cuadro crudo
             tft.fillRoundRect(937,79,994,133,10,GRIS_CUADROS); 
             // Mostrar crudoPeq con opacidad a nivel 24/32. Utiliza un recuadro de color GRIS_CUADROS escrito en page3 como S1.
-            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,PAGE1_START_ADDR,SCREEN_WIDTH,942,85,47,42,RA8876_ALPHA_OPACITY_24);
+            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,paginaDibujo,SCREEN_WIDTH,942,85,47,42,RA8876_ALPHA_OPACITY_24);
             // ----- FIN CRUDO --------
             // ----- FIN ZONA 2 -------------------------------------
 
@@ -740,17 +1097,17 @@ void printGrupoyEjemplos()
     tft.print("Grupo Actual: ");  // 16x32 escale x1
 
     // Color grupo
-    tft.setTextForegroundColor(grupoActual.color_grupo); // 'color_grupo' como atributo de struct 'Grupo'
+    tft.setTextForegroundColor(grupoActual->color_grupo); // 'color_grupo' como atributo de struct 'Grupo'
     
     // Nombre grupo
     tft.setCursor(tft.getCursorX(),tft.getCursorY());
-    tft.print(grupoActual.Nombre_grupo); // Nombre grupo -> 16x32 escale x1
-    //SerialPC.print("Grupo escogido (" + grupoActual.ID_grupo); SerialPC.println("): " + grupoActual.Nombre_grupo); 
+    tft.print(grupoActual->Nombre_grupo); // Nombre grupo -> 16x32 escale x1
+    //SerialPC.print("Grupo escogido (" + grupoActual->ID_grupo); SerialPC.println("): " + grupoActual->Nombre_grupo); 
 
     // Ejemplos grupo
     tft.selectInternalFont(RA8876_FONT_SIZE_24); 
     tft.setCursor(40,68);
-    tft.print(grupoActual.Ejemplos_grupo); // Ejemplos grupo -> 12x24 escale x1
+    tft.print(grupoActual->Ejemplos_grupo); // Ejemplos grupo -> 12x24 escale x1
     // -------- FIN TEXTO --------------------
     
 }
@@ -774,12 +1131,12 @@ void printGrupo_Barcode()
     tft.print("Grupo Actual: ");  // 16x32 escale x1
 
     // Color grupo
-    tft.setTextForegroundColor(grupoActual.color_grupo); // 'color_grupo' como atributo de struct 'Grupo'
+    tft.setTextForegroundColor(grupoActual->color_grupo); // 'color_grupo' como atributo de struct 'Grupo'
     
     // Nombre grupo
     tft.setCursor(tft.getCursorX(),tft.getCursorY());
-    tft.print(grupoActual.Nombre_grupo); // Nombre grupo -> 16x32 escale x1
-    //SerialPC.print("Grupo escogido (" + grupoActual.ID_grupo); SerialPC.println("): " + grupoActual.Nombre_grupo); 
+    tft.print(grupoActual->Nombre_grupo); // Nombre grupo -> 16x32 escale x1
+    //SerialPC.print("Grupo escogido (" + grupoActual->ID_grupo); SerialPC.println("): " + grupoActual->Nombre_grupo); 
     // -------- FIN TEXTO --------------------
     
 }
@@ -798,16 +1155,16 @@ void printProcesamiento(){
     switch(procesamiento){
         case ALIMENTO_CRUDO:  // CRUDO activo
             // Mostrar crudoPeq normal
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE1_START_ADDR,SCREEN_WIDTH,942,85,47,42);  // Mostrar crudoPeq (47x42) en PAGE1
+            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,paginaDibujo,SCREEN_WIDTH,942,85,47,42);  // Mostrar crudoPeq (47x42) en PAGE1
             // Mostrar cociPeq con opacidad a nivel 24/32. Utiliza un recuadro de color GRIS_CUADROS escrito en page3 como S1.
-            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,PAGE1_START_ADDR,SCREEN_WIDTH,942,26,47,42,RA8876_ALPHA_OPACITY_24);
+            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,paginaDibujo,SCREEN_WIDTH,942,26,47,42,RA8876_ALPHA_OPACITY_24);
             break;
 
         case ALIMENTO_COCINADO: // COCINADO activo
             // Mostrar cociPeq normal
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,PAGE1_START_ADDR,SCREEN_WIDTH,942,26,47,42);  // Mostrar cociPeq (47x42) en PAGE1
+            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,529,131,paginaDibujo,SCREEN_WIDTH,942,26,47,42);  // Mostrar cociPeq (47x42) en PAGE1
             // Mostrar crudoPeq con opacidad a nivel 24/32. Utiliza un recuadro de color GRIS_CUADROS escrito en page3 como S1.
-            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,PAGE1_START_ADDR,SCREEN_WIDTH,942,85,47,42,RA8876_ALPHA_OPACITY_24);
+            tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,577,131,PAGE3_START_ADDR,SCREEN_WIDTH,610,174,paginaDibujo,SCREEN_WIDTH,942,85,47,42,RA8876_ALPHA_OPACITY_24);
             break;
 
         default: break;
@@ -816,33 +1173,185 @@ void printProcesamiento(){
 
 
 /*---------------------------------------------------------------------------------------------------------
-   printZona3(): Zona 3 => Muestra los valores nutricionales según el caso.
+   invalidarDashboard(): Olvida lo que muestran las zonas 3 y 4 para que la próxima llamada a printZona3()
+                         y printZona4() las redibuje completas. Se llama al dibujar el dashboard desde cero.
+----------------------------------------------------------------------------------------------------------*/
+void invalidarDashboard()
+{
+    zonasDashboard[SHOW_VALORES_ZONA3].valida = false;
+    zonasDashboard[SHOW_VALORES_ZONA4].valida = false;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   zonaDashboardCompleta(): Comprueba si la zona se puede actualizar campo a campo o hay que redibujarla 
+                            completa: porque se ha invalidado, porque se ha mostrado otra pantalla encima 
+                            o porque cambia lo que muestra. Si hay que redibujarla, olvida sus campos.
           Parámetros:
-                        show_objeto - byte -> 0: Comida actual copiada tras guardar     1: alimento actual
+                        zona - byte -> SHOW_VALORES_ZONA3 o SHOW_VALORES_ZONA4
+                        contenido - byte -> lo que se va a mostrar (SHOW_..._ZONA3/4 o ZONA3_COMIDA_GUARDADA)
+          Return: 'true' si hay que redibujar la zona completa
 ----------------------------------------------------------------------------------------------------------*/
-void printZona3(byte show_objeto)
-{ 
-    // ---------- GRÁFICOS ---------------------------------------------------------------------------------------- 
-    // Recuadro "Comida actual" o "Alimento actual" 
-    tft.fillRoundRect(30,145,504,580,20,GRIS_CUADROS); // 474 x 425
-    tft.drawRoundRect(30,145,504,580,20,AZUL_BORDE_CUADRO); // Borde => 474 x 425
-    tft.drawRoundRect(31,146,503,579,20,AZUL_BORDE_CUADRO); // Borde => 473 x 424
+bool zonaDashboardCompleta(byte zona, byte contenido)
+{
+    zonaDashboard_t &z = zonasDashboard[zona];
+
+    if(z.valida and !showingTemporalScreen and (z.contenido == contenido)) return false;
+
+    memset(&z, 0, sizeof(zonaDashboard_t)); // Campos sin texto: se escriben enteros sobre el recuadro recién dibujado
+    z.contenido = contenido;
+    return true;
+}
+
 
-    // Recuadro Raciones Carbohidratos
-    tft.fillRoundRect(401,288,479,345,10,GRIS_CUADROS_VALORES); // 78 x 57
+/*---------------------------------------------------------------------------------------------------------
+   actualizarCampo(): Escribe 'texto' en el campo, pero solo borra y vuelve a escribir el tramo de caracteres 
+                      que ha cambiado respecto a lo que ya muestra. Si cambia la posición o el estilo (p.ej. 
+                      raciones que pasan de 1 a 2 cifras), se borra el texto anterior y se escribe entero.
+          Parámetros:
+                        campo - campoDashboard_t -> campo retenido de la zona
+                        x, y - uint16_t -> cursor del primer carácter
+                        estilo - estiloCampo_t -> fuente, escala, color y color de fondo
+                        texto - const char* -> texto a mostrar
+          Return: 1 si se ha redibujado algo, 0 si el campo ya mostraba 'texto' (no se envía nada por SPI)
+----------------------------------------------------------------------------------------------------------*/
+byte actualizarCampo(campoDashboard_t &campo, uint16_t x, uint16_t y, const estiloCampo_t &estilo, const char *texto)
+{
+    // ----- CAMBIO DE POSICIÓN O ESTILO -----------
+    if((x != campo.x) or (y != campo.y) or (memcmp(&estilo, &campo.estilo, sizeof(estiloCampo_t)) != 0))
+    {
+        byte nAnterior = strlen(campo.texto);
+        if(nAnterior > 0) tft.fillRect(campo.x, campo.y, campo.x + nAnterior * anchoCaracter(campo.estilo) - 1, 
+                                       campo.y + altoCaracter(campo.estilo) - 1, campo.estilo.fondo);
+        campo.x = x;
+        campo.y = y;
+        campo.estilo = estilo;
+        campo.texto[0] = '\0';
+    }
+    // ---------------------------------------------
 
-    // Recuadro Raciones Proteinas
-    tft.fillRoundRect(401,365,479,422,10,GRIS_CUADROS_VALORES); // 78 x 57
+    // ----- TRAMO QUE CAMBIA ----------------------
+    byte nViejo = strlen(campo.texto);
+    byte nNuevo = min(strlen(texto), (size_t)(CAMPO_MAX_TEXTO - 1));
+    byte n = (nViejo > nNuevo) ? nViejo : nNuevo;
 
-    // Recuadro Raciones Grasas
-    tft.fillRoundRect(401,442,479,499,10,GRIS_CUADROS_VALORES); // 78 x 57
+    byte primero = 0;
+    while((primero < n) and (campo.texto[primero] == texto[primero])) primero++;
+    if(primero == n) return 0; // Sin cambios
 
-    // Dibujo kcal
-    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,529,175,PAGE1_START_ADDR,SCREEN_WIDTH,127,507,60,64);  // Mostrar kcal_20 (60x65) en PAGE1
-    // ---------- FIN GRÁFICOS ------------------------------------------------------------------------------------ 
+    byte ultimo = n; // Primer carácter tras el tramo
+    while(ultimo > (primero + 1))
+    {
+        char viejo = (ultimo - 1 < nViejo) ? campo.texto[ultimo - 1] : '\0';
+        char nuevo = (ultimo - 1 < nNuevo) ? texto[ultimo - 1] : '\0';
+        if(viejo != nuevo) break;
+        ultimo--;
+    }
+    // ---------------------------------------------
 
+    // ----- BORRAR Y ESCRIBIR EL TRAMO ------------
+    uint16_t ancho = anchoCaracter(estilo);
+    byte finNuevo = min(ultimo, nNuevo);
+
+    // Los glifos de la caché llevan su fondo: solo hay que borrar lo que sobra del texto anterior
+    bool conGlifos = (primero < finNuevo) and escribirGlifos(x + primero * ancho, y, estilo, &texto[primero], finNuevo - primero, 
+                                                             (primero < nViejo) ? &campo.texto[primero] : "");
+    byte inicioBorrado = conGlifos ? finNuevo : primero;
+
+    if(inicioBorrado < min(ultimo, nViejo)) tft.fillRect(x + inicioBorrado * ancho, y, x + min(ultimo, nViejo) * ancho - 1, y + altoCaracter(estilo) - 1, estilo.fondo);
+
+    if((primero < finNuevo) and !conGlifos)
+    {
+        tft.setTextScale(estilo.escalaX, estilo.escalaY);
+        tft.selectInternalFont(estilo.fuente);  // Después de la escala, porque deja el fondo del texto transparente
+        tft.setTextForegroundColor(estilo.color);
+        tft.setCursor(x + primero * ancho, y);
+        tft.write((const uint8_t*)&texto[primero], finNuevo - primero);
+    }
+    // ---------------------------------------------
+
+    memcpy(campo.texto, texto, nNuevo);
+    campo.texto[nNuevo] = '\0';
+    return 1;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   cargarCacheGlifos(): Dibuja en PAGINA_GLIFOS, con el motor de texto, una fila por cada estilo de 
+                        estilosGlifos[] con los caracteres de GLIFOS, cada uno en su celda de ancho fijo y 
+                        sobre el fondo del estilo, igual que quedarían escritos en el campo.
+                        Se llama al cargar las imágenes (loadPicturesShowHourglass()).
+----------------------------------------------------------------------------------------------------------*/
+void cargarCacheGlifos()
+{
+    tft.canvasImageStartAddress(PAGINA_GLIFOS);
+
+    uint16_t y = 0;
+    for(byte i = 0; i < NUM_ESTILOS_GLIFOS; i++)
+    {
+        const estiloCampo_t &e = *estilosGlifos[i];
+        filaGlifos[i] = y;
+
+        tft.fillRect(0, y, NUM_GLIFOS * anchoCaracter(e) - 1, y + altoCaracter(e) - 1, e.fondo);
+        tft.setTextScale(e.escalaX, e.escalaY);
+        tft.selectInternalFont(e.fuente);  // Después de la escala, porque deja el fondo del texto transparente
+        tft.setTextForegroundColor(e.color);
+        tft.setCursor(0, y);
+        tft.write((const uint8_t*)GLIFOS, NUM_GLIFOS);
+
+        y += altoCaracter(e);
+    }
+
+    tft.canvasImageStartAddress(paginaDibujo);
+    cacheGlifosLista = true;
+}
 
 
+/*---------------------------------------------------------------------------------------------------------
+   escribirGlifos(): Escribe 'n' caracteres de 'texto' a partir de (x,y) en la página de dibujo copiando sus 
+                     glifos de la caché, con una sola llamada a bteMemoryCopyGlyphs(). Se salta los caracteres 
+                     que coinciden con 'anterior' (lo que ya muestra la pantalla en esas celdas), p. ej. el '.'
+                     de "1.1" --> "5.2": cada glifo es una copia del BTE aparte, así que cuesta lo mismo 
+                     copiar un tramo con huecos que seguido.
+          Parámetros:
+                        anterior - const char* -> texto que hay ahora desde (x,y) ("" --> celdas vacías)
+          Return: 'false' sin dibujar nada si la caché no está lista, el estilo no está en estilosGlifos[] o
+                  algún carácter no está en GLIFOS (hay que usar el motor de texto)
+----------------------------------------------------------------------------------------------------------*/
+bool escribirGlifos(uint16_t x, uint16_t y, const estiloCampo_t &estilo, const char *texto, byte n, const char *anterior)
+{
+    if(!cacheGlifosLista) return false;
+
+    byte fila = 0;
+    while((fila < NUM_ESTILOS_GLIFOS) and (memcmp(&estilo, estilosGlifos[fila], sizeof(estiloCampo_t)) != 0)) fila++;
+    if(fila == NUM_ESTILOS_GLIFOS) return false;
+
+    uint16_t ancho = anchoCaracter(estilo);
+    uint16_t columnas[CAMPO_MAX_TEXTO];
+    bool enAnterior = true; // Aún no se ha llegado al final de 'anterior'
+    for(byte i = 0; i < n; i++)
+    {
+        const char *glifo = (texto[i] != '\0') ? strchr(GLIFOS, texto[i]) : NULL;
+        if(!glifo) return false;
+
+        if(enAnterior and (anterior[i] == '\0')) enAnterior = false;
+        columnas[i] = (enAnterior and (anterior[i] == texto[i])) ? RA8876_GLYPH_SKIP : (glifo - GLIFOS) * ancho;
+    }
+
+    tft.bteMemoryCopyGlyphs(PAGINA_GLIFOS, filaGlifos[fila], columnas, n, paginaDibujo, x, y, ancho, altoCaracter(estilo));
+    return true;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   printZona3(): Zona 3 => Muestra los valores nutricionales según el caso.
+                 Si la zona ya está en pantalla con el mismo contenido, solo se redibujan los caracteres
+                 que cambian (dashboard retenido).
+          Parámetros:
+                        show_objeto - byte -> 0: Comida actual copiada tras guardar     1: alimento actual
+----------------------------------------------------------------------------------------------------------*/
+void printZona3(byte show_objeto)
+{ 
     // ------ VALORES Y PESO A MOSTRAR ----------------------------------------------------------------------------
     ValoresNutricionales valores; // Valores a mostrar
     float pesoMostrado = 0.0;
@@ -866,7 +1375,9 @@ void printZona3(byte show_objeto)
     }
     else if(show_objeto == SHOW_ALIMENTO_ACTUAL_ZONA3) // Valores temporales calculados a partir del peso del alimento, que puede variar
     {   
-        if(pesoBascula == 0.0) // Es posible que se muestre este dashboard con el 'pesoBascula' a 0.0 (p.ej. en STATE_raw)
+        float pesoAlimento = pesoAMostrar(); // Peso provisional mientras se asienta el plato o 'pesoBascula' si ya es estable
+
+        if(pesoAlimento == 0.0) // Es posible que se muestre este dashboard con el 'pesoBascula' a 0.0 (p.ej. en STATE_raw)
         {
             // Para evitar la creación innecesaria de un objeto Alimento cuando el peso es 0,
             // se asignan directamente los valores a 0.
@@ -875,56 +1386,87 @@ void printZona3(byte show_objeto)
         }
         else // Si se ha pesado un alimento, se muestran los valores temporales con los valores no definitivos del alimento pesado (STATE_weighted)
         {
-            Alimento AlimentoAux(grupoActual, pesoBascula);         // Alimento auxiliar usado para mostrar información variable de lo pesado
-            float carb = AlimentoAux.getValoresAlimento().getCarbValores();
-            float lip = AlimentoAux.getValoresAlimento().getLipValores();
-            float prot = AlimentoAux.getValoresAlimento().getProtValores();
-            float kcal = AlimentoAux.getValoresAlimento().getKcalValores();
-            valores.setValores(carb, lip, prot, kcal); // Calcula raciones automáticamente a partir de los valores
+            Alimento AlimentoAux(grupoActual, pesoAlimento);        // Alimento auxiliar usado para mostrar información variable de lo pesado
+            valores.setValores(AlimentoAux.getValoresAlimento());
             pesoMostrado = AlimentoAux.getPesoAlimento();
         }
     }
     // ------- FIN VALORES Y PESO A MOSTRAR -----------------------------------------------------------------------
 
 
+    byte contenido = ((show_objeto == SHOW_COMIDA_ACTUAL_ZONA3) and flagComidaSaved) ? ZONA3_COMIDA_GUARDADA : show_objeto;
+    uint32_t bytesSPI = tft.getBytesSPI();
+    unsigned long inicio = micros();
+    bool completa = zonaDashboardCompleta(SHOW_VALORES_ZONA3, contenido);
 
-    // -------- TEXTO --------------------------------------------------------------------------------------------- 
-    tft.selectInternalFont(RA8876_FONT_SIZE_24);
-    tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);  // 12x24 escale x2
-    tft.setTextForegroundColor(WHITE); 
-
-    // Título
-    tft.setCursor(120,155);
-    if(show_objeto == SHOW_COMIDA_ACTUAL_ZONA3)
+    if(completa)
     {
-        if(flagComidaSaved)
+        // ---------- GRÁFICOS ---------------------------------------------------------------------------------------- 
+        // Recuadro "Comida actual" o "Alimento actual" 
+        tft.fillRoundRect(30,145,504,580,20,GRIS_CUADROS); // 474 x 425
+        tft.drawRoundRect(30,145,504,580,20,AZUL_BORDE_CUADRO); // Borde => 474 x 425
+        tft.drawRoundRect(31,146,503,579,20,AZUL_BORDE_CUADRO); // Borde => 473 x 424
+
+        // Recuadro Raciones Carbohidratos
+        tft.fillRoundRect(401,288,479,345,10,GRIS_CUADROS_VALORES); // 78 x 57
+
+        // Recuadro Raciones Proteinas
+        tft.fillRoundRect(401,365,479,422,10,GRIS_CUADROS_VALORES); // 78 x 57
+
+        // Recuadro Raciones Grasas
+        tft.fillRoundRect(401,442,479,499,10,GRIS_CUADROS_VALORES); // 78 x 57
+
+        // Dibujo kcal
+        tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,529,175,paginaDibujo,SCREEN_WIDTH,127,507,60,64);  // Mostrar kcal_20 (60x65) en PAGE1
+        // ---------- FIN GRÁFICOS ------------------------------------------------------------------------------------ 
+
+
+        // -------- TEXTO FIJO ---------------------------------------------------------------------------------------- 
+        tft.selectInternalFont(RA8876_FONT_SIZE_24);
+        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);  // 12x24 escale x2
+        tft.setTextForegroundColor(WHITE); 
+
+        // Título
+        tft.setCursor(120,155);
+        if(contenido == ZONA3_COMIDA_GUARDADA)
         { 
             tft.setTextForegroundColor(YELLOW); 
             tft.setCursor(90,155);
             tft.print("Comida guardada");  // 12x24 escale x2
         }
-        else tft.print("Comida actual");  // 12x24 escale x2
-    } 
-    else if(show_objeto == SHOW_ALIMENTO_ACTUAL_ZONA3) tft.print("Alimento actual"); // 12x24 escale x2 
+        else if(contenido == SHOW_COMIDA_ACTUAL_ZONA3) tft.print("Comida actual");  // 12x24 escale x2
+        else if(contenido == SHOW_ALIMENTO_ACTUAL_ZONA3) tft.print("Alimento actual"); // 12x24 escale x2 
+
+        // Peso
+        tft.setCursor(50,220); 
+        tft.setTextForegroundColor(ROJO_PESO); 
+        tft.print("PESO: "); // 12x24 escale x2 
+        // -------- FIN TEXTO FIJO ------------------------------------------------------------------------------------
+    }
 
-    // Peso
-    tft.setCursor(50,220); 
-    tft.setTextForegroundColor(ROJO_PESO); 
-    tft.print("PESO: "); tft.print(pesoMostrado,1); tft.print("g"); // 12x24 escale x2 
+
+    // -------- CAMPOS ---------------------------------------------------------------------------------------------- 
+    TextoCampo peso;
+    peso.print(pesoMostrado,1); peso.print("g");
+    byte campos = actualizarCampo(zonasDashboard[SHOW_VALORES_ZONA3].peso, 50 + 6 * anchoCaracter(ESTILO_PESO), 220, ESTILO_PESO, peso.texto); // Tras "PESO: "
 
     // --- VALORES EN ZONA 3 ---
-    showValores(valores, SHOW_VALORES_ZONA3);
+    campos += showValores(valores, SHOW_VALORES_ZONA3);
 
     // --- RACIONES EN ZONA 3 ---
-    showRaciones(valores, SHOW_RACIONES_ZONA3);
+    campos += showRaciones(valores, SHOW_RACIONES_ZONA3);
+    // -------- FIN CAMPOS ------------------------------------------------------------------------------------------
 
-    // -------- FIN TEXTO ------------------------------------------------------------------------
+    zonasDashboard[SHOW_VALORES_ZONA3].valida = true;
 
+    LOG_SM(LOG_DASHBOARD_ZONA_US, 3, completa ? "completa" : "cambios", campos, tft.getBytesSPI() - bytesSPI, micros() - inicio);
 }
 
 
 /*---------------------------------------------------------------------------------------------------------
    printZona4(): Zona 4 => Muestra los valores nutricionales según el caso.
+                 Si la zona ya está en pantalla con el mismo contenido, solo se redibujan los caracteres
+                 que cambian (dashboard retenido).
           Parámetros:
                         show_objeto - byte -> 0: Comida actual real     1: acumulado hoy
 ----------------------------------------------------------------------------------------------------------*/
@@ -932,32 +1474,15 @@ void printZona4(byte show_objeto)
 { 
     float pesoMostrado = 0.0;
 
-    // ---------- GRÁFICOS --------------------------------------------------------------------------------------
-    // Recuadro "Comida actual" o "Acumulado hoy"
-    tft.fillRoundRect(520,145,994,580,20,GRIS_CUADROS); // 474 x 425
-
-    // Recuadro Carbohidratos
-    tft.fillRoundRect(891,288,969,345,10,GRIS_CUADROS_VALORES); // 78 x 57
-
-    // Recuadro Proteinas
-    tft.fillRoundRect(891,365,969,422,10,GRIS_CUADROS_VALORES); // 78 x 57
-
-    // Recuadro Grasas
-    tft.fillRoundRect(891,442,969,499,10,GRIS_CUADROS_VALORES); // 78 x 57
-
-    // kcal
-    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,529,175,PAGE1_START_ADDR,SCREEN_WIDTH,617,507,60,64);  // Mostrar kcal_20 (60x65) en PAGE1
-    // ---------- FIN GRÁFICOS ----------------------------------------------------------------------------------
-
-
-
     // ------ VALORES A MOSTRAR -----------------------------------------------------------------
     ValoresNutricionales valores; // Valores a mostrar
                                   // En el caso de SHOW_COMIDA_ACTUAL_ZONA4, se mostrarán los valores temporales con los valores no definitivos del alimento pesado
 
     if(show_objeto == SHOW_COMIDA_ACTUAL_ZONA4) // Valores temporales de la comida actual
     {
-        if(pesoBascula == 0.0) // Es posible que se muestre este dashboard con el 'pesoBascula' a 0.0 (p.ej. en STATE_raw)
+        float pesoAlimento = pesoAMostrar(); // Peso provisional mientras se asienta el plato o 'pesoBascula' si ya es estable
+
+        if(pesoAlimento == 0.0) // Es posible que se muestre este dashboard con el 'pesoBascula' a 0.0 (p.ej. en STATE_raw)
         {
             // Para evitar la creación innecesaria de un objeto Alimento cuando el peso es 0,
             // se asignan directamente los valores a 0.
@@ -966,12 +1491,9 @@ void printZona4(byte show_objeto)
         }
         else // El resto de estados, para que se muestren los valores del peso del alimento pesado
         {
-            Alimento AlimentoAux(grupoActual, pesoBascula);         // Alimento auxiliar usado para mostrar información variable de lo pesado
-            float carb = AlimentoAux.getValoresAlimento().getCarbValores() + comidaActual.getValoresComida().getCarbValores();
-            float lip = AlimentoAux.getValoresAlimento().getLipValores() + comidaActual.getValoresComida().getLipValores();
-            float prot = AlimentoAux.getValoresAlimento().getProtValores() + comidaActual.getValoresComida().getProtValores();
-            float kcal = AlimentoAux.getValoresAlimento().getKcalValores() + comidaActual.getValoresComida().getKcalValores();
-            valores.setValores(carb, lip, prot, kcal); // Calcula raciones automáticamente a partir de los valores
+            Alimento AlimentoAux(grupoActual, pesoAlimento);        // Alimento auxiliar usado para mostrar información variable de lo pesado
+            valores.setValores(comidaActual.getValoresComida());
+            valores.sumar(AlimentoAux.getValoresAlimento());
 
             pesoMostrado = AlimentoAux.getPesoAlimento() + comidaActual.getPesoComida();
         }
@@ -984,74 +1506,125 @@ void printZona4(byte show_objeto)
     // -------------------------------------------------------------------------------------------
 
 
+    uint32_t bytesSPI = tft.getBytesSPI();
+    unsigned long inicio = micros();
+    bool completa = zonaDashboardCompleta(SHOW_VALORES_ZONA4, show_objeto);
 
-    // -------- TEXTO --------------------------------------------------------------------------------------------- 
-    tft.selectInternalFont(RA8876_FONT_SIZE_24);
-    tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);  // 12x24 escale x2
-    tft.setTextForegroundColor(WHITE); 
+    if(completa)
+    {
+        // ---------- GRÁFICOS --------------------------------------------------------------------------------------
+        // Recuadro "Comida actual" o "Acumulado hoy"
+        tft.fillRoundRect(520,145,994,580,20,GRIS_CUADROS); // 474 x 425
 
-    // Título
-    tft.setCursor(590, 155);
-    if(show_objeto == SHOW_COMIDA_ACTUAL_ZONA4) tft.print("Comida actual");  // 12x24 escale x2
-    else if(show_objeto == SHOW_ACUMULADO_HOY_ZONA4) tft.print("Acumulado hoy"); // 12x24 escale x2 
+        // Recuadro Carbohidratos
+        tft.fillRoundRect(891,288,969,345,10,GRIS_CUADROS_VALORES); // 78 x 57
+
+        // Recuadro Proteinas
+        tft.fillRoundRect(891,365,969,422,10,GRIS_CUADROS_VALORES); // 78 x 57
+
+        // Recuadro Grasas
+        tft.fillRoundRect(891,442,969,499,10,GRIS_CUADROS_VALORES); // 78 x 57
+
+        // kcal
+        tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,529,175,paginaDibujo,SCREEN_WIDTH,617,507,60,64);  // Mostrar kcal_20 (60x65) en PAGE1
+        // ---------- FIN GRÁFICOS ----------------------------------------------------------------------------------
 
-    // Peso
-    tft.setCursor(540,220);
-    tft.setTextForegroundColor(ROJO_PESO); 
-    tft.print("PESO: "); tft.print(pesoMostrado,1); tft.print("g"); // 12x24 escale x2 
+
+        // -------- TEXTO FIJO ---------------------------------------------------------------------------------------- 
+        tft.selectInternalFont(RA8876_FONT_SIZE_24);
+        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);  // 12x24 escale x2
+        tft.setTextForegroundColor(WHITE); 
+
+        // Título
+        tft.setCursor(590, 155);
+        if(show_objeto == SHOW_COMIDA_ACTUAL_ZONA4) tft.print("Comida actual");  // 12x24 escale x2
+        else if(show_objeto == SHOW_ACUMULADO_HOY_ZONA4) tft.print("Acumulado hoy"); // 12x24 escale x2 
+
+        // Peso
+        tft.setCursor(540,220);
+        tft.setTextForegroundColor(ROJO_PESO); 
+        tft.print("PESO: "); // 12x24 escale x2 
+        // -------- FIN TEXTO FIJO ------------------------------------------------------------------------------------
+    }
+
+
+    // -------- CAMPOS ---------------------------------------------------------------------------------------------- 
+    TextoCampo peso;
+    peso.print(pesoMostrado,1); peso.print("g");
+    byte campos = actualizarCampo(zonasDashboard[SHOW_VALORES_ZONA4].peso, 540 + 6 * anchoCaracter(ESTILO_PESO), 220, ESTILO_PESO, peso.texto); // Tras "PESO: "
 
     // --- VALORES EN ZONA 4 ---
-    showValores(valores, SHOW_VALORES_ZONA4);
+    campos += showValores(valores, SHOW_VALORES_ZONA4);
 
     // --- RACIONES EN ZONA 4 ---
-    showRaciones(valores, SHOW_RACIONES_ZONA4);
+    campos += showRaciones(valores, SHOW_RACIONES_ZONA4);
+    // -------- FIN CAMPOS ------------------------------------------------------------------------------------------
 
-    // -------- FIN TEXTO ------------------------------------------------------------------------
+    zonasDashboard[SHOW_VALORES_ZONA4].valida = true;
 
+    LOG_SM(LOG_DASHBOARD_ZONA_US, 4, completa ? "completa" : "cambios", campos, tft.getBytesSPI() - bytesSPI, micros() - inicio);
 }
 
 
 
 /*---------------------------------------------------------------------------------------------------------
    showValores(): Mostrar los valores pasados en la ubicación correspondiente de la pantalla según la zona.
+                  Las etiquetas solo se escriben al redibujar la zona completa y los valores solo si cambian.
       Parámetros:
                   valores - ValoresNutricionales  --> objeto con los valores a mostrar
                   zona - byte    --> zona en la que se están mostrando, necesaria para saber la ubicación en pantalla.
+      Return: número de campos redibujados
 ----------------------------------------------------------------------------------------------------------*/
-void showValores(ValoresNutricionales &valores, byte zona){
+byte showValores(ValoresNutricionales &valores, byte zona){
 
-    tft.selectInternalFont(RA8876_FONT_SIZE_32); 
-    tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
+    zonaDashboard_t &z = zonasDashboard[zona];
+    uint16_t x = (zona == SHOW_VALORES_ZONA3) ? 50 : 540; // Margen izquierdo de las etiquetas
+    byte campos = 0;
+
+    // ------------ Etiquetas ------------
+    if(!z.valida)
+    {
+        tft.selectInternalFont(RA8876_FONT_SIZE_32); 
+        tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
+
+        tft.setCursor(x,303);
+        tft.setTextForegroundColor(AZUL_CARB); 
+        tft.print("CARBOHIDRATOS: "); // 16x32 escale x1
+
+        tft.setCursor(x,380);
+        tft.setTextForegroundColor(NARANJA_PROT); 
+        tft.print(LATIN1("PROTEÍNAS: ")); // 16x32 escale x1
+
+        tft.setCursor(x,457);
+        tft.setTextForegroundColor(AMARILLO_GRASAS); 
+        tft.print("GRASAS: "); // 16x32 escale x1
+    }
 
     // ------------ Carbohidratos ------------
-    if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(50,303);
-    else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(540,303);
-    tft.setTextForegroundColor(AZUL_CARB); 
-    tft.print("CARBOHIDRATOS: "); tft.print(valores.getCarbValores(),1); tft.print("g");  // 16x32 escale x1
+    char texto[LONGITUD_TEXTO_MILESIMAS];
+
+    TextoCampo carb;
+    carb.print(textoMilesimas(texto, valores.getCarbMilesimas(), DECIMALES_DASHBOARD)); carb.print("g");
+    campos += actualizarCampo(z.carb, x + 15 * anchoCaracter(ESTILO_CARB), 303, ESTILO_CARB, carb.texto);   // Tras "CARBOHIDRATOS: "
     
     // ------------ Proteinas ------------
-    if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(50,380);
-    else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(540,380);
-    tft.setTextForegroundColor(NARANJA_PROT); 
-    tft.print(convertSpecialCharactersToHEX("PROTEÍNAS: ")); tft.print(valores.getProtValores(),1); tft.print("g"); // 16x32 escale x1
+    TextoCampo prot;
+    prot.print(textoMilesimas(texto, valores.getProtMilesimas(), DECIMALES_DASHBOARD)); prot.print("g");
+    campos += actualizarCampo(z.prot, x + 11 * anchoCaracter(ESTILO_PROT), 380, ESTILO_PROT, prot.texto);   // Tras "PROTEÍNAS: "
 
     // ------------ Grasas ------------
-    if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(50,457);
-    else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(540,457);
-    tft.setTextForegroundColor(AMARILLO_GRASAS); 
-    tft.print("GRASAS: "); tft.print(valores.getLipValores(),1); tft.print("g"); // 16x32 escale x1
+    TextoCampo grasas;
+    grasas.print(textoMilesimas(texto, valores.getLipMilesimas(), DECIMALES_DASHBOARD)); grasas.print("g");
+    campos += actualizarCampo(z.grasas, x + 8 * anchoCaracter(ESTILO_GRASAS), 457, ESTILO_GRASAS, grasas.texto); // Tras "GRASAS: "
     
     // ------------ Kcal ------------
-    if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(197,516);
-    else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(697,516);
-    tft.setTextForegroundColor(ROJO_KCAL); 
-    tft.selectInternalFont(RA8876_FONT_SIZE_24);
-    tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2); 
-    tft.print(valores.getKcalValores(),0); tft.print(" Kcal"); // 12x24 escale X2
+    TextoCampo kcal;
+    kcal.print(textoMilesimas(texto, valores.getKcalMilesimas(), 0)); kcal.print(" Kcal");
+    campos += actualizarCampo(z.kcal, (zona == SHOW_VALORES_ZONA3) ? 197 : 697, 516, ESTILO_KCAL, kcal.texto); // 12x24 escale X2
 
+    return campos;
 }
 
-
 /*---------------------------------------------------------------------------------------------------------
    showRaciones(): Mostrar raciones de los valores pasados como atributo, mostrando los decimales solo en 
                    determinados casos y centrando el valor en el recuadro correspondiente.
@@ -1171,77 +1744,39 @@ void showValores(ValoresNutricionales &valores, byte zona){
 
 // Esta versión de la función muestra los valores para la nueva forma de calcular las raciones, que
 // redondeaba al decimal más cercano y siempre mantiene 1 decimal, aunque sea .0
-void showRaciones(ValoresNutricionales &valores, byte zona)
+byte showRaciones(ValoresNutricionales &valores, byte zona)
 {
-    float raciones;
+    zonaDashboard_t &z = zonasDashboard[zona];
+    uint16_t x = (zona == SHOW_RACIONES_ZONA3) ? 0 : 490; // Desplazamiento de la zona 4 respecto a la zona 3
+    byte campos = 0;
 
     // Texto "Raciones"
-    tft.selectInternalFont(RA8876_FONT_SIZE_32); 
-    tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
-    tft.setTextForegroundColor(WHITE);
-    if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(370,243);
-    else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(860,243);
-    tft.print("Raciones"); // 16x32 escale x1
-
-
-    // ------------ Raciones de Carbohidratos ------------
-    raciones = valores.getCarbRaciones();
-    // Cursor y tamaño según la cantidad de cifras enteras para centrar en el cuadro
-    if(abs((int)raciones) < 10){   // 1 cifra entera
-        tft.selectInternalFont(RA8876_FONT_SIZE_24);
-        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2); 
-        if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(406,293);
-        else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(896,293);
-    } 
-    else{ // 2 o más cifras enteras
-        tft.selectInternalFont(RA8876_FONT_SIZE_16);
-        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X3); // Alargar
-        if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(408,291); 
-        else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(898,291); 
-    }          
-    tft.print(raciones,1); // Si no termina en .0 , termina en .5 , entonces sí lo mostramos. 12x24 escale x2 solo altura
-    // --------------------------------------------------- 
-
-
-
-    // ------------ Raciones de Proteinas ---------------- 
-    raciones = valores.getProtRaciones();
-    // Cursor y tamaño según la cantidad de cifras enteras para centrar en el cuadro
-    if(abs((int)raciones) < 10){   // 1 cifra entera
-        tft.selectInternalFont(RA8876_FONT_SIZE_24);
-        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);
-        if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(406,370);
-        else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(896,370);
-    } 
-    else{ // 2 o más cifras enteras
-        tft.selectInternalFont(RA8876_FONT_SIZE_16);
-        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X3); // Alargar
-        if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(408,368);    
-        else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(898,368);
-    } 
-    tft.print(raciones,1); // Si no termina en .0 , termina en .5 , entonces sí lo mostramos. 12x24 escale x2 solo altura
-    // ---------------------------------------------------  
+    if(!z.valida)
+    {
+        tft.selectInternalFont(RA8876_FONT_SIZE_32); 
+        tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
+        tft.setTextForegroundColor(WHITE);
+        tft.setCursor(x + 370,243);
+        tft.print("Raciones"); // 16x32 escale x1
+    }
 
+    // Cursor y tamaño según la cantidad de cifras enteras para centrar en el cuadro:
+    //      1 cifra entera:         12x24 escale x2 en (406, y)
+    //      2 o más cifras enteras: 8x16 escale x2 de ancho y x3 de alto (alargada) en (408, y - 2)
+    campoDashboard_t *camposRacion[3] = { &z.racCarb, &z.racProt, &z.racGrasas };
+    float raciones[3] = { valores.getCarbRaciones(), valores.getProtRaciones(), valores.getLipRaciones() };
+    const uint16_t y[3] = { 293, 370, 447 };
 
+    for(byte i = 0; i < 3; i++)
+    {
+        TextoCampo racion;
+        racion.print(raciones[i],1); // Siempre con 1 decimal, aunque sea .0
 
-    // ---------- Raciones de Grasas ---------------------
-    raciones = valores.getLipRaciones();
-    // Cursor y tamaño según la cantidad de cifras enteras para centrar en el cuadro
-    if(abs((int)raciones) < 10){   // 1 cifra entera
-        tft.selectInternalFont(RA8876_FONT_SIZE_24);
-        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);
-        if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(406,447);
-        else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(896,447);
-    } 
-    else{ // 2 o más cifras enteras
-        tft.selectInternalFont(RA8876_FONT_SIZE_16);
-        tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X3); // Alargar
-        if(zona == SHOW_RACIONES_ZONA3) tft.setCursor(408,445); 
-        else if(zona == SHOW_RACIONES_ZONA4) tft.setCursor(898,445);
-    }   
-    tft.print(raciones,1); // Si no termina en .0 , termina en .5 , entonces sí lo mostramos. 12x24 escale x2 solo altura
-    // --------------------------------------------------- 
+        if(abs((int)raciones[i]) < 10) campos += actualizarCampo(*camposRacion[i], x + 406, y[i], ESTILO_RACION_1, racion.texto);
+        else campos += actualizarCampo(*camposRacion[i], x + 408, y[i] - 2, ESTILO_RACION_2, racion.texto);
+    }
 
+    return campos;
 }
 
 
@@ -1260,12 +1795,17 @@ void showRaciones(ValoresNutricionales &valores, byte zona)
 ----------------------------------------------------------------------------------------------------------*/
 void showDashboardStyle1(byte msg_option){
     showingTemporalScreen = false; // Desactivar flag de estar mostrando pantalla temporal/transitoria
+    invalidarDashboard();          // Las zonas 3 y 4 se dibujan completas sobre el fondo nuevo
+
+    empezarComposicion();        // Se dibuja sin verse y se muestra completo al final
 
-    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro en PAGE1
+    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro
 
     blinkGrupoyProcesamiento(msg_option);     // Zonas 1 y 2 - Parpadeando y mensaje de falta recipiente o grupo
     printZona3(SHOW_COMIDA_ACTUAL_ZONA3);     // Zona 3 - Valores comida copiada tras guardar. Al inicio están a 0.
     printZona4(SHOW_ACUMULADO_HOY_ZONA4);     // Zona 4 - Valores Acumulado hoy
+
+    presentarComposicion();
 }
 
 
@@ -1278,13 +1818,18 @@ void showDashboardStyle1(byte msg_option){
 void showDashboardStyle2()
 {
     showingTemporalScreen = false; // Desactivar flag de estar mostrando pantalla temporal/transitoria
+    invalidarDashboard();          // Las zonas 3 y 4 se dibujan completas sobre el fondo nuevo
 
-    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro en PAGE1
+    empezarComposicion();        // Se dibuja sin verse y se muestra completo al final
+
+    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro
 
     printGrupoyEjemplos();                  // Zona 1 - Grupo y ejemplos 
     printProcesamiento();                   // Zona 2 - Procesamiento crudo o cocinado (según modo: ALIMENTO_CRUDO o ALIMENTO_COCINADO)
     printZona3(SHOW_ALIMENTO_ACTUAL_ZONA3); // Zona 3 - Valores alimento actual pesado
     printZona4(SHOW_COMIDA_ACTUAL_ZONA4);   // Zona 4 - Valores Comida actual actualizada en tiempo real según el peso del alimento
+
+    presentarComposicion();
 }
 
 
@@ -1299,12 +1844,17 @@ void showDashboardStyle2()
 void showDashboardStyle2_Barcode()
 {
     showingTemporalScreen = false; // Desactivar flag de estar mostrando pantalla temporal/transitoria
+    invalidarDashboard();          // Las zonas 3 y 4 se dibujan completas sobre el fondo nuevo
 
-    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro en PAGE1
+    empezarComposicion();        // Se dibuja sin verse y se muestra completo al final
+
+    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro
 
     printGrupo_Barcode();                   // Zona 1 y 2 - Grupo (nombre producto)
     printZona3(SHOW_ALIMENTO_ACTUAL_ZONA3); // Zona 3 - Valores alimento actual pesado
     printZona4(SHOW_COMIDA_ACTUAL_ZONA4);   // Zona 4 - Valores Comida actual actualizada en tiempo real según el peso del alimento
+
+    presentarComposicion();
 }
 
 
@@ -1317,18 +1867,21 @@ void showDashboardStyle2_Barcode()
                         Este dashboard se muestra en STATE_groupA y STATE_groupB, donde aún no se ha escogido
                         crudo o cocinado.
 ----------------------------------------------------------------------------------------------------------*/
-bool showSemiDashboard_PedirProcesamiento(){
+void showSemiDashboard_PedirProcesamiento(){
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria.
                                   // En STATE_raw y STATE_cooked se muestra todo el dashboard 2 si esta flag
                                   // está activa. Si no lo está, solo se modifica la zona 2.
 
-    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro en PAGE1
+    empezarComposicion();        // Zonas 1 y 2 sin verse. Las zonas 3 y 4 se animan ya sobre la página mostrada
+
+    tft.clearScreen(AZUL_FONDO); // Fondo azul oscuro
 
     printGrupoyEjemplos();                          // Zona 1 - Grupo y ejemplos 
     blinkGrupoyProcesamiento(NO_MSG);               // Zona 2 - Procesamiento sin escoger (parpadeo)
-    if(pedirProcesamientoZonas3y4()) return true;   // Zonas 3 y 4 - Pedir procesamiento
-                                                        // Si ha ocurrido una interrupción mientras se formaba la pantalla de pedir recipiente, se sale de la función
-    return false;
+
+    presentarComposicion();
+
+    pedirProcesamientoZonas3y4();                   // Zonas 3 y 4 - Pedir procesamiento (se termina de formar en continuarAnimacion())
 }
 
 
@@ -1365,7 +1918,7 @@ void showSavingMeal_baseScreen()
     // ----------------------------------------------------------------------------------------------------
 
     // ------ ICONO (GUARDANDO) ---------------------------------------------------------------------------
-    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,554,0,PAGE1_START_ADDR,SCREEN_WIDTH,450,150,91,98); // Mostrar disquete (91x98) en PAGE1
+    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,554,0,paginaDibujo,SCREEN_WIDTH,450,150,91,98); // Mostrar disquete (91x98) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ LINEA ---------------------------------------------------------------------------------
@@ -1396,7 +1949,7 @@ void showSavingMeal_connectionState(bool hayConexionInternet)
      tft.setTextForegroundColor(WHITE);
     if(!hayConexionInternet)
     {
-        tft.setCursor(220, tft.getCursorY() + tft.getTextSizeY()); tft.print(convertSpecialCharactersToHEX("Se guardará en SMARTCLOTH"));
+        tft.setCursor(220, tft.getCursorY() + tft.getTextSizeY()); tft.print(LATIN1("Se guardará en SMARTCLOTH"));
         tft.setCursor(280, tft.getCursorY() + tft.getTextSizeY() + 10); tft.println("pero no en la web");
     }
     // ----------------------------------------------------------------------------------------------------
@@ -1406,13 +1959,13 @@ void showSavingMeal_connectionState(bool hayConexionInternet)
     if(hayConexionInternet) // Mostrar icono de conexión a internet y texto
     {
         // Toma desde y=1 para quitar linea de basura y, para evitar la linea de debajo, hacemos como que es de 66 píxeles de alto
-        tft.bteMemoryCopy(PAGE4_START_ADDR, SCREEN_WIDTH, 646, 1, PAGE1_START_ADDR, SCREEN_WIDTH, 30, 500, 43, 66); // Mostrar conexión (43x67) en PAGE1. 
-        tft.setCursor(85,520);    tft.println(convertSpecialCharactersToHEX("CON CONEXIÓN A INTERNET"));
+        tft.bteMemoryCopy(PAGE4_START_ADDR, SCREEN_WIDTH, 646, 1, paginaDibujo, SCREEN_WIDTH, 30, 500, 43, 66); // Mostrar conexión (43x67) en PAGE1. 
+        tft.setCursor(85,520);    tft.println(LATIN1("CON CONEXIÓN A INTERNET"));
     }
     else // Mostrar icono de sin conexión a internet y texto
     {   
-        tft.bteMemoryCopy(PAGE4_START_ADDR, SCREEN_WIDTH, 689, 0, PAGE1_START_ADDR, SCREEN_WIDTH, 30, 480, 54, 85); // Mostrar no conexión (54x85) en PAGE1
-        tft.setCursor(90,520);    tft.println(convertSpecialCharactersToHEX("SIN CONEXIÓN A INTERNET"));
+        tft.bteMemoryCopy(PAGE4_START_ADDR, SCREEN_WIDTH, 689, 0, paginaDibujo, SCREEN_WIDTH, 30, 480, 54, 85); // Mostrar no conexión (54x85) en PAGE1
+        tft.setCursor(90,520);    tft.println(LATIN1("SIN CONEXIÓN A INTERNET"));
     
     }
     // ----------------------------------------------------------------------------------------------------
@@ -1461,13 +2014,13 @@ void showSyncState(byte option)
     {
         case UPLOADING_DATA:            tft.setCursor(270, 30);        tft.println("SINCRONIZANDO...");                        break; 
 
-        case ALL_MEALS_UPLOADED:        tft.setCursor(70, 30);         tft.println(convertSpecialCharactersToHEX("¡SMARTCLOTH SINCRONIZADO!"));     break;
+        case ALL_MEALS_UPLOADED:        tft.setCursor(70, 30);         tft.println(LATIN1("¡SMARTCLOTH SINCRONIZADO!"));     break;
 
         case ERROR_READING_MEALS_FILE:         
         case NO_INTERNET_CONNECTION:     
         case HTTP_ERROR:                
         case TIMEOUT:   
-        case UNKNOWN_ERROR:             tft.setCursor(180,100);        tft.println(convertSpecialCharactersToHEX("¡ERROR DEL SISTEMA!"));            break;
+        case UNKNOWN_ERROR:             tft.setCursor(180,100);        tft.println(LATIN1("¡ERROR DEL SISTEMA!"));            break;
         
         default:    break;
     }
@@ -1479,12 +2032,12 @@ void showSyncState(byte option)
     {
         case UPLOADING_DATA: // Icono SM sincronizando
             // Toma desde y=1 para quitar linea de basura y, para evitar la linea de debajo, hacemos como que es de 122 píxeles de alto
-            tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,0,1,PAGE1_START_ADDR,SCREEN_WIDTH,420,130,188,122); // Mostrar sincronizando (188x123) en PAGE1
+            tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,0,1,paginaDibujo,SCREEN_WIDTH,420,130,188,122); // Mostrar sincronizando (188x123) en PAGE1
             tft.fillRoundRect(210,280,814,288,3,lineColor); // Línea bajo el icono
             break;
 
         case ALL_MEALS_UPLOADED: // Icono SM sincronizado
-            tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,189,0,PAGE1_START_ADDR,SCREEN_WIDTH,402,147,220,136); // Mostrar SM sincronizado (220x136) en PAGE1
+            tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,189,0,paginaDibujo,SCREEN_WIDTH,402,147,220,136); // Mostrar SM sincronizado (220x136) en PAGE1
             tft.fillRoundRect(210,300,814,308,3,lineColor); // Línea bajo el icono
             break;
 
@@ -1493,7 +2046,7 @@ void showSyncState(byte option)
         case HTTP_ERROR:
         case TIMEOUT:
         case UNKNOWN_ERROR:
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,292,PAGE1_START_ADDR,SCREEN_WIDTH,451,231,114,127); // Mostrar cruz (114x127) en PAGE1
+            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,292,paginaDibujo,SCREEN_WIDTH,451,231,114,127); // Mostrar cruz (114x127) en PAGE1
             tft.fillRoundRect(252,290,764,298,3,lineColor); // Dibujar líea por encima de la imagen de cruz para no tener que cuadrarla
             break;
 
@@ -1514,19 +2067,19 @@ void showSyncState(byte option)
     {
         case UPLOADING_DATA:            
             tft.setCursor(70, 338);                                             tft.println("ESPERE MIENTRAS SE FINALIZA LA SUBIDA");
-            tft.setCursor(300,tft.getCursorY() + tft.getTextSizeY()-10);        tft.println(convertSpecialCharactersToHEX("DE INFORMACIÓN"));
-            tft.setCursor(200, tft.getCursorY() + tft.getTextSizeY() + 20);     tft.println(convertSpecialCharactersToHEX("No retire el teléfono móvil"));                                      break; 
+            tft.setCursor(300,tft.getCursorY() + tft.getTextSizeY()-10);        tft.println(LATIN1("DE INFORMACIÓN"));
+            tft.setCursor(200, tft.getCursorY() + tft.getTextSizeY() + 20);     tft.println(LATIN1("No retire el teléfono móvil"));                                      break; 
 
         case ALL_MEALS_UPLOADED:        tft.setCursor(215, 388);                                        tft.println("LA WEB SE HA ACTUALIZADO");                                                break;
 
-        case ERROR_READING_MEALS_FILE:         tft.setCursor(40, 420);                                         tft.println(convertSpecialCharactersToHEX("FALLÓ LA LECTURA DEL FICHERO DE COMIDAS"));  break;
+        case ERROR_READING_MEALS_FILE:         tft.setCursor(40, 420);                                         tft.println(LATIN1("FALLÓ LA LECTURA DEL FICHERO DE COMIDAS"));  break;
 
-        case NO_INTERNET_CONNECTION:    tft.setCursor(125, 420);                                        tft.println(convertSpecialCharactersToHEX("SE PERDIÓ LA CONEXIÓN A INTERNET"));
-                                        tft.setCursor(50, tft.getCursorY() + tft.getTextSizeY()+20);    tft.println(convertSpecialCharactersToHEX("NO SE PUEDE SINCRONIZAR LA INFORMACIÓN"));   break;
+        case NO_INTERNET_CONNECTION:    tft.setCursor(125, 420);                                        tft.println(LATIN1("SE PERDIÓ LA CONEXIÓN A INTERNET"));
+                                        tft.setCursor(50, tft.getCursorY() + tft.getTextSizeY()+20);    tft.println(LATIN1("NO SE PUEDE SINCRONIZAR LA INFORMACIÓN"));   break;
               
-        case HTTP_ERROR:                tft.setCursor(100, 420);                                         tft.println(convertSpecialCharactersToHEX("FALLÓ LA SINCRONIZACIÓN CON LA WEB"));       break;
+        case HTTP_ERROR:                tft.setCursor(100, 420);                                         tft.println(LATIN1("FALLÓ LA SINCRONIZACIÓN CON LA WEB"));       break;
 
-        case TIMEOUT:                   tft.setCursor(120, 420);                                        tft.println(convertSpecialCharactersToHEX("FALLÓ LA AUTENTICACIÓN EN LA WEB"));         break;
+        case TIMEOUT:                   tft.setCursor(120, 420);                                        tft.println(LATIN1("FALLÓ LA AUTENTICACIÓN EN LA WEB"));         break;
 
         case UNKNOWN_ERROR:             tft.setCursor(300, 420);                                        tft.println("ERROR DESCONOCIDO");                                                       break;
 
@@ -1558,8 +2111,10 @@ void showSyncState(byte option)
 /*---------------------------------------------------------------------------------------------------------
    pedirRecipiente(): Pide colocar un recipiente (STATE_Init)
 ----------------------------------------------------------------------------------------------------------*/
-void pedirRecipiente()
+char pedirRecipiente(pt_t *pt, byte /*option*/)
 {
+    PT_BEGIN(pt);
+
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria
 
     // ************ TEXTO ********************************************************************************
@@ -1585,18 +2140,15 @@ void pedirRecipiente()
     tft.fillCircle(512,380,65,WHITE); // 65 pixeles de diametro
     // ****************************************************************************************************
 
-    // -------- INT -------------------
-    if(eventOccurred()) return; // Evento de interrupción (botonera o báscula)
-
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(600)) return;
+    PT_ESPERAR(pt, 600);
 
     // ************ CUADRADO REDONDEADO *******************************************************************
     tft.fillRoundRect(447,315,577,445,10,WHITE); // x = 512 +/- 65 = 447   ->   y = 380 +/- 65 = 315
     // ****************************************************************************************************
     
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(600)) return;
+    PT_ESPERAR(pt, 600);
 
     // ************ PALITOS *******************************************************************************
     //PAG 5 ==> palitos alrededor cuadrado. 4 pixeles entre barra y barra
@@ -1619,30 +2171,28 @@ void pedirRecipiente()
     // ****************************************************************************************************
     
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
     // ------------------------------------------------------------------------------------------------------
 
     // *********** BRAINS (120X108) *************************************************************************
     // **** BRAIN 1 ********************************************
     // BRAIN1 (120x108) --> centrar en el cuadrado blanco
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,0,170,PAGE1_START_ADDR,SCREEN_WIDTH,450,325,120,108); // Mostrar brain1 en PAGE1
+    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,0,170,paginaDibujo,SCREEN_WIDTH,450,325,120,108); // Mostrar brain1 en PAGE1
     // *********************************************************
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
 
     // **** BRAIN 2 ********************************************
     // BRAIN2G (99x83) (verde)
-    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,121,170,PAGE1_START_ADDR,SCREEN_WIDTH,450,325,120,108); // Mostrar brain2G en PAGE1
+    tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,121,170,paginaDibujo,SCREEN_WIDTH,450,325,120,108); // Mostrar brain2G en PAGE1
     // *********************************************************
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
     // ****************************************************************************************************
-    
+
+    PT_END(pt);
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -1703,10 +2253,16 @@ void recipienteRetirado()
    TODO: DIBUJAR BORDE DE RECTANGULO REDONDEADO (VARIAS VECES POR GROSOR) DEL COLOR DEL FONDO Y PONERLO 
           ENCIMA DE LAS IMÁGENES DE GRUPOS PARA TAPAR LAS SOMBRAS EN LAS ESQUINAS.
 ----------------------------------------------------------------------------------------------------------*/
-void pedirGrupoAlimentos()
+char pedirGrupoAlimentos(pt_t *pt, byte /*option*/)
 {
+    static pt_t ptHijo;
+    static bool pulsacion;
+    static byte i;
+
+    PT_BEGIN(pt);
+
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria
-    bool pulsacion = true;
+    pulsacion = true;
 
     // ***** FONDO VERDE ***********
     tft.clearScreen(VERDE_PEDIR_Y_EXITO); // Fondo verde en PAGE1
@@ -1720,9 +2276,7 @@ void pedirGrupoAlimentos()
     tft.setCursor(255, tft.getCursorY() + tft.getTextSizeY()-10);     tft.print("DE ALIMENTOS"); 
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // ****************************************************************************************************
 
 
@@ -1731,9 +2285,7 @@ void pedirGrupoAlimentos()
     tft.fillRoundRect(0,450,512,458,3,WHITE);
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // ****************************************************************************************************
 
 
@@ -1742,45 +2294,41 @@ void pedirGrupoAlimentos()
     // Mostrar en PAGE1 (copiar de PAGE3 a PAGE1)
 
     // ------ Grupo 1 (130x125) ---------
-    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,0,PAGE1_START_ADDR,SCREEN_WIDTH,236,288,130,125); // x = 236  ->  y = 288
-    slowAppearanceImage(SLOW_APPEAR_GRUPO1);
+    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,0,paginaDibujo,SCREEN_WIDTH,236,288,130,125); // x = 236  ->  y = 288
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GRUPO1));
 
     // DIBUJAR BORDE DE RECTANGULO REDONDEADO (VARIAS VECES POR GROSOR) DEL COLOR DEL FONDO Y PONERLO ENCIMA 
     // DE LAS IMÁGENES DE GRUPOS PARA TAPAR LAS SOMBRAS EN LAS ESQUINAS.
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
 
     // ------ Grupo 2 (130x125) ---------
-    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,131,0,PAGE1_START_ADDR,SCREEN_WIDTH,396,288,130,125); // x = <grupo1(236) + grupo1(130) + 30 = 396  ->  y = 288
-    slowAppearanceImage(SLOW_APPEAR_GRUPO2);
+    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,131,0,paginaDibujo,SCREEN_WIDTH,396,288,130,125); // x = <grupo1(236) + grupo1(130) + 30 = 396  ->  y = 288
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GRUPO2));
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
 
     // ------ Grupo 3 (130x125) ---------
-    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,PAGE1_START_ADDR,SCREEN_WIDTH,556,288,130,125); // x = <grupo2(396) + grupo2(130) + 30 = 556  ->  y = 288
-    slowAppearanceImage(SLOW_APPEAR_GRUPO3);
+    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,paginaDibujo,SCREEN_WIDTH,556,288,130,125); // x = <grupo2(396) + grupo2(130) + 30 = 556  ->  y = 288
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GRUPO3));
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
 
     // ------ Grupo 4 (130x125) ---------
-    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,393,0,PAGE1_START_ADDR,SCREEN_WIDTH,716,288,130,125); // x = <grupo3(556) + grupo3(130) + 30 = 716  ->  y = 288
-    slowAppearanceImage(SLOW_APPEAR_GRUPO4);
+    //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,393,0,paginaDibujo,SCREEN_WIDTH,716,288,130,125); // x = <grupo3(556) + grupo3(130) + 30 = 716  ->  y = 288
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GRUPO4));
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
+    PT_ESPERAR(pt, 800);
     // ****************************************************************************************************
 
 
     // ************ DESPLAZAR MANO PARA SIMULAR MOVIMIENTO ************************************************
     // MANO por el camino
-    if(desplazar_mano(MANO_Y_PULSACION_GRUPOS)) return; // Si ha ocurrido interrupción mientras se desplazaba la mano, se sale de la función.
+    PT_SPAWN(pt, &ptHijo, desplazar_mano(&ptHijo, MANO_Y_PULSACION_GRUPOS));
     // ****************************************************************************************************
 
 
@@ -1788,30 +2336,29 @@ void pedirGrupoAlimentos()
     // Tras trasladar la mano, no hay pulsación. Se van a hacer dos alternancias de pulsación,
     // es decir: pulsacion - no pulsacion - pulsacion - no pulsacion
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
 
-    for(byte i = 0; i < 4; i++){
+    for(i = 0; i < 4; i++){
         if(pulsacion) con_pulsacion(MANO_Y_PULSACION_GRUPOS);
         else sin_pulsacion(MANO_Y_PULSACION_GRUPOS);
-        if(doubleDelayAndCheckInterrupt(400)) return;
-        if(doubleDelayAndCheckInterrupt(400)) return;
-        if(doubleDelayAndCheckInterrupt(200)) return;
+        PT_ESPERAR(pt, 1000);
         pulsacion = !pulsacion;
     }
     // ****************************************************************************************************
 
+    PT_END(pt);
 }
 
 /*---------------------------------------------------------------------------------------------------------
    desplazar_mano(): Desplazar imagen de "mano" por la pantalla simulando movimiento hasta botón correspondiente.
-        Return:   true: ha habido interrupción    false: no ha habido interrupción
-            Devuelve bool para salir de la función que llamó de desplazar_mano() si hubo interrupción.  
+        Return:   PT_ESPERANDO mientras se desplaza la mano    PT_TERMINADA al llegar al botón
+            Es un protohilo (Protothread.h) que se ejecuta con PT_SPAWN() desde la pantalla que lo usa.
 ----------------------------------------------------------------------------------------------------------*/
-bool desplazar_mano(byte option)
+char desplazar_mano(pt_t *pt, byte option)
 {
-    int alto, posY;
+    static int alto, posY;
+
+    PT_BEGIN(pt);
 
     switch(option){
         case MANO_Y_PULSACION_ANADIR: // Añadir
@@ -1820,24 +2367,20 @@ bool desplazar_mano(byte option)
               alto = 128; posY = 580;
               while(posY >= 510){
                   // manoWppt
-                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,430,posY,120,128,WHITE); // Mostrar manoWppt (120x128)
-                  delay(50);
+                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,430,posY,120,128,WHITE); // Mostrar manoWppt (120x128)
+                  PT_ESPERAR(pt, 50);
                   tft.clearArea(430,posY,567,posY + alto,AMARILLO_CONFIRM_Y_AVISO); // Desaparece de esa zona para aparecer en otra --> se mueve
                   posY -= 10; // Subimos verticalmente la imagen 10 píxeles
-                  // -------- INT -------------------
-                  if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula) 
               }
               
               // 2 - Botón correspondiente --> para superponerse a la última mano y que desaparezca para simular el movimiento
-              if(option == MANO_Y_PULSACION_ANADIR) tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); // Mostrar añadir (172x130) 
-              else tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); // Mostrar borrar (172x130)
+              if(option == MANO_Y_PULSACION_ANADIR) tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); // Mostrar añadir (172x130) 
+              else tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); // Mostrar borrar (172x130)
               
               // 3 - Movimiento final de la mano (manoWppt)
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,430,472,120,128,WHITE); // Mostrar manoWppt (120x128)
-              delay(50);
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,430,472,120,128,WHITE); // Mostrar manoWppt (120x128)
+              PT_ESPERAR(pt, 50);
 
-              // -------- INT -------------------
-              if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula) 
               
               break;
 
@@ -1847,23 +2390,19 @@ bool desplazar_mano(byte option)
               alto = 128; posY = 590;
               while(posY >= 530){
                   // manoWppt
-                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,420,posY,120,128,WHITE); // Mostrar manoWppt (120x128)
-                  delay(50);
+                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,420,posY,120,128,WHITE); // Mostrar manoWppt (120x128)
+                  PT_ESPERAR(pt, 50);
                   tft.clearArea(420,posY,557,posY + alto,AMARILLO_CONFIRM_Y_AVISO); // Desaparece de esa zona para aparecer en otra --> se mueve
                   posY -= 10; // Subimos verticalmente la imagen 10 píxeles
-                  // -------- INT -------------------
-                  if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
               }
               
               // 2 - Botón guardar --> para superponerse a la última mano y que desaparezca para simular el movimiento
-              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,PAGE1_START_ADDR,SCREEN_WIDTH,420,400,172,130); // Mostrar guardar (172x130)
+              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,paginaDibujo,SCREEN_WIDTH,420,400,172,130); // Mostrar guardar (172x130)
               
               // 3 - Movimiento final de la mano (manoWppt)
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,420,492,120,128,WHITE); // Mostrar manoWppt (120x128)    
-              delay(50);
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,420,492,120,128,WHITE); // Mostrar manoWppt (120x128)    
+              PT_ESPERAR(pt, 50);
 
-              // -------- INT -------------------
-              if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula) 
               
               break;
 
@@ -1873,25 +2412,21 @@ bool desplazar_mano(byte option)
               alto = 127; posY = 480;
               while(posY >= 410){
                   // manoGppt
-                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,PAGE1_START_ADDR,SCREEN_WIDTH,566,posY,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
-                  delay(50);
+                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,paginaDibujo,SCREEN_WIDTH,566,posY,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
+                  PT_ESPERAR(pt, 50);
                   if(posY < 413) posY = 413; // Solo afecta al penúltimo movimiento de la mano, para evitar que se borre parte del grupo3 que está debajo
                   tft.clearArea(556,posY,690,posY + alto+5,VERDE_PEDIR_Y_EXITO); // Desaparece de esa zona para aparecer en otra --> se mueve
                   posY -= 10; // Subimos verticalmente la imagen 10 píxeles
-                  // -------- INT -------------------
-                  if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula) 
               }
               posY = 400;
               while(posY >= 380){
                   // Mostrar grupo3 (130x125). Para superponerse a la mano, que aún se está "moviendo"
-                  tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,PAGE1_START_ADDR,SCREEN_WIDTH,556,288,130,125); 
+                  tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,paginaDibujo,SCREEN_WIDTH,556,288,130,125); 
                   
                   // Mostrar mano (manoGppt)
-                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,PAGE1_START_ADDR,SCREEN_WIDTH,566,posY,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
+                  tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,paginaDibujo,SCREEN_WIDTH,566,posY,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
                   
-                  delay(50);
-                  // -------- INT -------------------
-                  if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula) 
+                  PT_ESPERAR(pt, 50);
 
                   if(posY == 400) tft.clearArea(556,413,690,528,VERDE_PEDIR_Y_EXITO); // Se borra desde y = 413 para no borrar parte del botón. Solo se borra en la primera iteración del bucle
                   posY -= 20;
@@ -1902,8 +2437,7 @@ bool desplazar_mano(byte option)
         default: break;
     }
 
-    return false; // Si no ha ocurrido ninguna interrupción mientras se desplazaba la mano,
-                  // se continúa con la función que llamó a esta.
+    PT_END(pt);
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -1918,12 +2452,12 @@ void sin_pulsacion(byte option)
               tft.clearArea(400,370,612,620,AMARILLO_CONFIRM_Y_AVISO); // Empieza en la esquina superior izquierda de la pulsación y termina al final de la mano
               
               // 2 - Botón correspondiente --> para superponerse a la última mano y que desaparezca para simular el movimiento
-              if(option == MANO_Y_PULSACION_ANADIR) tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); // Mostrar añadir (172x130) 
-              else tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); // Mostrar borrar (172x130)
+              if(option == MANO_Y_PULSACION_ANADIR) tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); // Mostrar añadir (172x130) 
+              else tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); // Mostrar borrar (172x130)
               
               // 3 - Movimiento final de la mano (manoWppt)
               // manoWppt
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,430,472,120,128,WHITE); // Transparencia manoWppt (120x128)
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,430,472,120,128,WHITE); // Transparencia manoWppt (120x128)
               
               break;
 
@@ -1933,10 +2467,10 @@ void sin_pulsacion(byte option)
               tft.clearArea(400,390,612,660,AMARILLO_CONFIRM_Y_AVISO); // Empieza en la esquina superior izquierda de la pulsación y termina al final de la mano
               
               // 2 - Botón guardar --> para superponerse a la última mano y que desaparezca para simular el movimiento
-              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,PAGE1_START_ADDR,SCREEN_WIDTH,420,400,172,130); // Mostrar guardar (172x130)
+              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,paginaDibujo,SCREEN_WIDTH,420,400,172,130); // Mostrar guardar (172x130)
 
               // 3 - Movimiento final de la mano (manoWppt)
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,420,492,120,128,WHITE); // Transparencia manoWppt (120x128)
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,420,492,120,128,WHITE); // Transparencia manoWppt (120x128)
               
               break;
 
@@ -1946,10 +2480,10 @@ void sin_pulsacion(byte option)
               tft.clearArea(546,278,690,528,VERDE_PEDIR_Y_EXITO); // Empieza en la esquina superior izquierda de la pulsación y termina al final de la mano
 
               // 2 - Mostrar grupo3 (130x125)
-              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,PAGE1_START_ADDR,SCREEN_WIDTH,556,288,130,125); 
+              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,paginaDibujo,SCREEN_WIDTH,556,288,130,125); 
 
               // 3 - Mostrar mano (manoGppt)
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,PAGE1_START_ADDR,SCREEN_WIDTH,566,380,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,paginaDibujo,SCREEN_WIDTH,566,380,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
 
               break;
 
@@ -1972,8 +2506,8 @@ void con_pulsacion(byte option)
               tft.clearArea(400,370,612,620,AMARILLO_CONFIRM_Y_AVISO); // Empieza en la esquina superior izquierda de la pulsación y termina al final de la mano
               
               // 2 - Botón correspondiente --> para superponerse a la última mano y que desaparezca para simular el movimiento
-              if(option == MANO_Y_PULSACION_ANADIR) tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); // Mostrar añadir (172x130) 
-              else tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); // Mostrar borrar (172x130)
+              if(option == MANO_Y_PULSACION_ANADIR) tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); // Mostrar añadir (172x130) 
+              else tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); // Mostrar borrar (172x130)
               
               // 3 - Pulsación
               // ------------ CUADRADO ESQUINADO (PULSACION) --------------------------------------------------------   
@@ -1989,7 +2523,7 @@ void con_pulsacion(byte option)
               // 4 - Mano
               // ------------ MANO (120x129) ------------------------------------------------------------------------
               // Mano (manoWppt) final pulsando
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,430,472,120,128,WHITE); // Transparencia manoWppt (120x128)
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,430,472,120,128,WHITE); // Transparencia manoWppt (120x128)
               // ----------------------------------------------------------------------------------------------------
 
               // 5 - Rayitas pulsación
@@ -2024,7 +2558,7 @@ void con_pulsacion(byte option)
               tft.clearArea(400,410,612,660,AMARILLO_CONFIRM_Y_AVISO); // Empieza en la esquina superior izquierda de la pulsación y termina al final de la mano
               
               // 2 - Botón guardar --> para superponerse a la última mano y que desaparezca para simular el movimiento
-              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,PAGE1_START_ADDR,SCREEN_WIDTH,420,400,172,130); // Mostrar guardar (172x130)
+              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,paginaDibujo,SCREEN_WIDTH,420,400,172,130); // Mostrar guardar (172x130)
 
               // 3 - Pulsación
               // ------------ CUADRADO ESQUINADO (PULSACION) --------------------------------------------------------   
@@ -2040,7 +2574,7 @@ void con_pulsacion(byte option)
               // 4 - Mano
               // ------------ MANO (120x129) ------------------------------------------------------------------------
               // Mano (manoWppt) final pulsando
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,PAGE1_START_ADDR,SCREEN_WIDTH,420,492,120,128,WHITE); // Transparencia manoWppt (120x128)
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,251,292,paginaDibujo,SCREEN_WIDTH,420,492,120,128,WHITE); // Transparencia manoWppt (120x128)
               // ----------------------------------------------------------------------------------------------------
 
               // 5 - Rayitas pulsación
@@ -2074,7 +2608,7 @@ void con_pulsacion(byte option)
               tft.clearArea(546,278,690,528,VERDE_PEDIR_Y_EXITO); // Empieza en la esquina superior izquierda de la pulsación y termina al final de la mano
               
               // 2 - Volver a mostrar grupo3 (130x125)
-              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,PAGE1_START_ADDR,SCREEN_WIDTH,556,288,130,125); 
+              tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,paginaDibujo,SCREEN_WIDTH,556,288,130,125); 
               
               // 3 - Pulsación
               // ------------ CUADRADO ESQUINADO (PULSACION) --------------------------------------------------------   
@@ -2090,7 +2624,7 @@ void con_pulsacion(byte option)
               // 4 - Mano
               // ------------ MANO (120x129) ------------------------------------------------------------------------
               // Mano final pulsando (manoGppt)
-              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,PAGE1_START_ADDR,SCREEN_WIDTH,566,380,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
+              tft.bteMemoryCopyWithChromaKey(PAGE3_START_ADDR,SCREEN_WIDTH,525,1,paginaDibujo,SCREEN_WIDTH,566,380,119,127,VERDE_PEDIR_Y_EXITO); // Transparencia manoGppt (120x128)
               // ----------------------------------------------------------------------------------------------------
 
               // 5 - Rayitas pulsación
@@ -2146,7 +2680,7 @@ void showScanningBarcode()
     // -----------------------------------------------------------------------------------------------
 
     // ------ ICONO (CODIGO DE BARRAS) --------------------------------------------------------------------
-    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,0,137,PAGE1_START_ADDR,SCREEN_WIDTH,427,100,171,128); // Mostrar scan (171x128) en PAGE1
+    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,0,137,paginaDibujo,SCREEN_WIDTH,427,100,171,128); // Mostrar scan (171x128) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ LINEA ---------------------------------------------------------------------------------
@@ -2156,10 +2690,10 @@ void showScanningBarcode()
     // ------ TEXTO (COMENTARIO) --------------------------------------------------------------------------
     tft.selectInternalFont(RA8876_FONT_SIZE_24);
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);
-    tft.setCursor(140, 338);                                            tft.println(convertSpecialCharactersToHEX("COLOQUE EL CÓDIGO DE BARRAS DEL"));
+    tft.setCursor(140, 338);                                            tft.println(LATIN1("COLOQUE EL CÓDIGO DE BARRAS DEL"));
     tft.setCursor(130,tft.getCursorY() + tft.getTextSizeY() - 10);      tft.println("PRODUCTO A UNOS 10cms DEL LECTOR");
-    tft.setCursor(180,tft.getCursorY() + tft.getTextSizeY() + 10);      tft.println(convertSpecialCharactersToHEX("El lector cambiará de color"));
-    tft.setCursor(300,tft.getCursorY() + tft.getTextSizeY() - 20);      tft.println(convertSpecialCharactersToHEX("al leer el código"));
+    tft.setCursor(180,tft.getCursorY() + tft.getTextSizeY() + 10);      tft.println(LATIN1("El lector cambiará de color"));
+    tft.setCursor(300,tft.getCursorY() + tft.getTextSizeY() - 20);      tft.println(LATIN1("al leer el código"));
     // ----------------------------------------------------------------------------------------------------
 
 }
@@ -2188,7 +2722,7 @@ void showSearchingProductInfo()
 
     // ------ ICONO (LUPA) --------------------------------------------------------------------------------
     // Toma desde y=138 (137+1) para quitar linea de basura y, para evitar la linea de debajo, hacemos como que es de 129 píxeles de alto
-    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,172,138,PAGE1_START_ADDR,SCREEN_WIDTH,471,120,82,129); // Mostrar lupa (82x130) en PAGE1
+    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,172,138,paginaDibujo,SCREEN_WIDTH,471,120,82,129); // Mostrar lupa (82x130) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ LINEA ---------------------------------------------------------------------------------
@@ -2198,7 +2732,7 @@ void showSearchingProductInfo()
     // ------ TEXTO (COMENTARIO) --------------------------------------------------------------------------
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);
     tft.setCursor(140, 338);                                         tft.println("ESPERE MIENTRAS LOCALIZAMOS LA");
-    tft.setCursor(160,tft.getCursorY() + tft.getTextSizeY() - 10);   tft.println(convertSpecialCharactersToHEX("INFORMACIÓN NUTRICIONAL DEL"));
+    tft.setCursor(160,tft.getCursorY() + tft.getTextSizeY() - 10);   tft.println(LATIN1("INFORMACIÓN NUTRICIONAL DEL"));
     tft.setCursor(420,tft.getCursorY() + tft.getTextSizeY() - 10);   tft.println("PRODUCTO");
     // ----------------------------------------------------------------------------------------------------
 
@@ -2227,7 +2761,8 @@ void pedirConfirmacionProducto(String &productInfo)
     int idx_nombre = cad.indexOf(';');
     int idx_carb = cad.indexOf(';', idx_nombre + 1);
     String barcode = cad.substring(0, idx_nombre);                      // Extraer <barcode>
-    String nombreProducto = convertSpecialCharactersToHEX(cad.substring(idx_nombre + 1, idx_carb));   // Extraer <nombre_producto> y convertir caracteres especiales
+    String nombreProducto = cad.substring(idx_nombre + 1, idx_carb);   // Extraer <nombre_producto>
+    utf8ALatin1(nombreProducto);                                        // y convertir caracteres especiales
     // ----------------------------------------------------------------------------------------------------
 
     // ---- COLOR FONDO -----------------------------------------------------------------------------------
@@ -2240,19 +2775,19 @@ void pedirConfirmacionProducto(String &productInfo)
     tft.setTextScale(RA8876_TEXT_W_SCALE_X3, RA8876_TEXT_H_SCALE_X3);
     tft.setTextForegroundColor(WHITE);
 
-    tft.setCursor(125, 30);    tft.println(convertSpecialCharactersToHEX("¡PRODUCTO ENCONTRADO!"));
+    tft.setCursor(125, 30);    tft.println(LATIN1("¡PRODUCTO ENCONTRADO!"));
     // ----------------------------------------------------------------------------------------------------
 
     // ----- TEXTO (COMENTARIO) ---------------------------------------------------------------------------
     //tft.selectInternalFont(RA8876_FONT_SIZE_16);
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);
 
-    tft.setCursor(150, 125);                                        tft.print(convertSpecialCharactersToHEX("Pulse el botón de lectura si es"));
+    tft.setCursor(150, 125);                                        tft.print(LATIN1("Pulse el botón de lectura si es"));
     tft.setCursor(265, tft.getCursorY() + tft.getTextSizeY() + 15); tft.println("el producto correcto");
     // ----------------------------------------------------------------------------------------------------
 
     // ------ ICONO (PRODUCTO + BOTÓN BARCODE) ------------------------------------------------------------
-    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,369,137,PAGE1_START_ADDR,SCREEN_WIDTH,350,240,297,104); // Mostrar producto encontrado (297x104) en PAGE1
+    tft.bteMemoryCopy(PAGE4_START_ADDR,SCREEN_WIDTH,369,137,paginaDibujo,SCREEN_WIDTH,350,240,297,104); // Mostrar producto encontrado (297x104) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ LINEA ---------------------------------------------------------------------------------
@@ -2271,7 +2806,7 @@ void pedirConfirmacionProducto(String &productInfo)
     tft.selectInternalFont(RA8876_FONT_SIZE_24); 
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2);
 
-    tft.setCursor(110, 440);                                         tft.print(convertSpecialCharactersToHEX("Código: "));  tft.println(barcode);
+    tft.setCursor(110, 440);                                         tft.print(LATIN1("Código: "));  tft.println(barcode);
     tft.setCursor(110,tft.getCursorY() + tft.getTextSizeY() - 10);   tft.print("Nombre:");                                  tft.println(nombreProducto);
     
     #if defined(SM_DEBUG)
@@ -2298,8 +2833,12 @@ void pedirConfirmacionProducto(String &productInfo)
    formGraphicsPedirProcesamiento(): Compone la pantalla (forma, colores, texto y 1º botón de cocinado) de
                                      pedir procesamiento sobre las zonas 3 y 4 del dashboard.
 ----------------------------------------------------------------------------------------------------------*/
-bool formGraphicsPedirProcesamiento()
+char formGraphicsPedirProcesamiento(pt_t *pt, byte /*option*/)
 {
+    static pt_t ptHijo;
+
+    PT_BEGIN(pt);
+
     // ******* ZONAS 3 Y 4 **************************************************************************
     // ------- GRÁFICOS -------------------------------------
         // Recuadro tapando zonas 3 y 4 del dashboard
@@ -2314,33 +2853,35 @@ bool formGraphicsPedirProcesamiento()
         tft.selectInternalFont(RA8876_FONT_SIZE_32);
         tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2); 
         tft.setTextForegroundColor(WHITE); 
-        tft.setCursor(230, 185);                                        tft.println(convertSpecialCharactersToHEX("¿EL ALIMENTO ESTÁ"));
-        tft.setCursor(250, tft.getCursorY() + tft.getTextSizeY()-20);   tft.print(convertSpecialCharactersToHEX("COCINADO O CRUDO?"));
+        tft.setCursor(230, 185);                                        tft.println(LATIN1("¿EL ALIMENTO ESTÁ"));
+        tft.setCursor(250, tft.getCursorY() + tft.getTextSizeY()-20);   tft.print(LATIN1("COCINADO O CRUDO?"));
     // ---------------------------------------------------------------------------
 
     // ------- 1º BOTÓN -------------------------------------
-    if(slowAppearanceImage(SLOW_APPEAR_COCINADO)) return true; // Si ha ocurrido interrupción mientras aparecía la imagen de cocinado
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_COCINADO));
 
     // ***********************************************************************************************
 
-    return false;
+    PT_END(pt);
 }
 
 /*---------------------------------------------------------------------------------------------------------
    alternateButtonsProcesamiento(): Alternar botones de crudo cocinado en la pantalla de pedir procesamiento.
                                     Zonas 3 y 4 tapadas con mensaje de petición en formGraphicsPedirProcesamiento().
 ----------------------------------------------------------------------------------------------------------*/
-bool alternateButtonsProcesamiento()
+void alternateButtonsProcesamiento()
 { 
     // Tiempos utilizados para alternar entre mostrar botón COCINADO o CRUDO:
     static unsigned long previousTime = 0;      // Variable estática para almacenar el tiempo anterior
     const unsigned long interval = 1000;        // Intervalo de tiempo para alternar entre botones (1 seg)
 
-    unsigned long currentTime = millis();
-
     static bool showingCocinado = true;
     static bool showingCrudo = false;
 
+    if(isAnimacionEnCurso()) return;            // Aún se está formando la pantalla o haciendo la última alternancia (continuarAnimacion())
+
+    unsigned long currentTime = millis();
+
     // ------- ALTERNANCIAS CRUDO/COCINADO ----------------------------------------
     if(currentTime - previousTime >= interval) 
     {
@@ -2348,24 +2889,18 @@ bool alternateButtonsProcesamiento()
         if(showingCocinado)
         {
             // Mostrar CRUDO
-            if(slowAppearanceAndDisappareanceProcesamiento(SLOW_DISAPPEAR_COCINADO_APPEAR_CRUDO)) return true; 
-                // Si ha ocurrido interrupción mientras aparecía la imagen de crudo y desaparecía la de cocinado, 
-                // se sale de la función.
+            iniciarAnimacion(slowAppearanceAndDisappareanceProcesamiento, SLOW_DISAPPEAR_COCINADO_APPEAR_CRUDO); 
             showingCrudo = true;
             showingCocinado = false;
         }
         else if(showingCrudo)
         {
             // Mostrar COCINADO
-            if(slowAppearanceAndDisappareanceProcesamiento(SLOW_DISAPPEAR_CRUDO_APPEAR_COCINADO)) return true; 
-                // Si ha ocurrido interrupción mientras aparecía la imagen de cocinado y desaparecía la de crudo, 
-                // se sale de la función.
+            iniciarAnimacion(slowAppearanceAndDisappareanceProcesamiento, SLOW_DISAPPEAR_CRUDO_APPEAR_COCINADO); 
             showingCocinado = true;
             showingCrudo = false;
         }
     }
-
-    return false;
     // ----------------------------------------------------------------------------
 
 }
@@ -2377,12 +2912,10 @@ bool alternateButtonsProcesamiento()
                                   Esto se hace en STATE_groupA y STATE_groupB, donde aún no se ha escogido
                                   crudo o cocinado.
 ----------------------------------------------------------------------------------------------------------*/
-bool pedirProcesamientoZonas3y4()
+void pedirProcesamientoZonas3y4()
 {
-    if(formGraphicsPedirProcesamiento()) return true;    // Zonas 3 y 4 - Base (formas, colores, texto y 1º botón cocinado) de la pantalla de pedir procesamiento
-    if(alternateButtonsProcesamiento()) return true;     // Zonas 3 y 4 - Alternar botones de crudo o cocinado en pantalla de pedir procesamiento
-
-    return false;
+    iniciarAnimacion(formGraphicsPedirProcesamiento);   // Zonas 3 y 4 - Base (formas, colores, texto y 1º botón cocinado) de la pantalla de pedir procesamiento
+                                                        // Al terminar, actGruposAlimentos() alterna los botones de crudo o cocinado (alternateButtonsProcesamiento())
 }
 
 
@@ -2400,8 +2933,12 @@ bool pedirProcesamientoZonas3y4()
 /*---------------------------------------------------------------------------------------------------------
    pedirAlimento(): Pide colocar alimento sobre la báscula, tras haber seleccionado crudo o cocinado.
 ----------------------------------------------------------------------------------------------------------*/
-void pedirAlimento()
-{ 
+char pedirAlimento(pt_t *pt, byte /*option*/)
+{
+    static pt_t ptHijo;
+
+    PT_BEGIN(pt);
+
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria
 
     // ************ TEXTO ********************************************************************************
@@ -2417,30 +2954,25 @@ void pedirAlimento()
     // ****************************************************************************************************
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
 
     // ************ LÍNEAS ********************************************************************************
     tft.fillRoundRect(0,270,276,278,3,WHITE);
     tft.fillRoundRect(748,517,1024,525,3,WHITE);
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // **************************************************************************************************** 
     
       
     // ************ SCALE *********************************************************************************
     // Imagen scale 
-    if(slowAppearanceImage(SLOW_APPEAR_SCALE)) return; // Imagen de scale apareciendo
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_SCALE));
     // **************************************************************************************************** 
     
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
 
+    PT_END(pt);
 }
 
 /*------------------------- FIN COLOCAR ALIMENTO --------------------------------------------------------*/
@@ -2455,8 +2987,12 @@ void pedirAlimento()
 /*-------------------------------------------------------------------------------------------------------*/
 // TODO: DIBUJAR BORDE DE RECTANGULO REDONDEADO (VARIAS VECES POR GROSOR) DEL COLOR DEL FONDO Y PONERLO ENCIMA 
 //        DE LAS IMÁGENES PARA TAPAR LAS SOMBRAS EN LAS ESQUINAS.
-void sugerirAccion()
+char sugerirAccion(pt_t *pt, byte /*option*/)
 {
+    static pt_t ptHijo;
+
+    PT_BEGIN(pt);
+
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria
 
     // ***** TEXTO (PREGUNTA) ****************************************************************************
@@ -2467,12 +3003,10 @@ void sugerirAccion()
     tft.setTextForegroundColor(WHITE); 
     //tft.ignoreTextBackground();       // Activa la transparencia igual que ==> tft.setTextBackgroundTrans(RA8876_TEXT_TRANS_ON);
     tft.setCursor(80, 50);
-    tft.println(convertSpecialCharactersToHEX("¿QUÉ QUIERE HACER AHORA?"));
+    tft.println(LATIN1("¿QUÉ QUIERE HACER AHORA?"));
     
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // **************************************************************************************************** 
 
 
@@ -2485,15 +3019,13 @@ void sugerirAccion()
 
     // ----- MÁS ALIMENTO -------------------------------------------------
     // Añadir más cantidad de alimento --> scaleG (150x150) 
-    tft.setCursor(90, 377);                                       tft.println(convertSpecialCharactersToHEX("AÑADIR"));
-    tft.setCursor(115, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println(convertSpecialCharactersToHEX("MÁS"));
+    tft.setCursor(90, 377);                                       tft.println(LATIN1("AÑADIR"));
+    tft.setCursor(115, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println(LATIN1("MÁS"));
     tft.setCursor(75, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("ALIMENTO");
     // Apareciendo y recortando bordes de add/delete/save
-    if(slowAppearanceImage(SLOW_APPEAR_SCALE_SUGERENCIA)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_SCALE_SUGERENCIA));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // --------------------------------------------------------------------
 
 
@@ -2503,25 +3035,21 @@ void sugerirAccion()
     tft.setCursor(275, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("OTRO");
     tft.setCursor(270, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("GRUPO");
     // Apareciendo y recortando bordes de add/delete/save
-    if(slowAppearanceImage(SLOW_APPEAR_GRUPO1_SUGERENCIA)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GRUPO1_SUGERENCIA));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // --------------------------------------------------------------------
 
 
     // ----- AÑADIR PLATO -------------------------------------------------
     // Añadir plato --> anadir (172x130) 
-    tft.setCursor(430, 377);                                       tft.println(convertSpecialCharactersToHEX("AÑADIR"));
+    tft.setCursor(430, 377);                                       tft.println(LATIN1("AÑADIR"));
     tft.setCursor(445, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("OTRO");
     tft.setCursor(440, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("PLATO");
     // Apareciendo y recortando bordes de add/delete/save
-    if(slowAppearanceImage(SLOW_APPEAR_ANADIR_SUGERENCIA)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_ANADIR_SUGERENCIA));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // --------------------------------------------------------------------
 
 
@@ -2531,11 +3059,9 @@ void sugerirAccion()
     tft.setCursor(627, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("PLATO");
     tft.setCursor(617, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("ACTUAL");
     // Apareciendo y recortando bordes de add/delete/save
-    if(slowAppearanceImage(SLOW_APPEAR_BORRAR_SUGERENCIA)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_BORRAR_SUGERENCIA));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 1000);
     // --------------------------------------------------------------------
 
 
@@ -2544,11 +3070,12 @@ void sugerirAccion()
     tft.setCursor(795, 377);                                       tft.println("GUARDAR");
     tft.setCursor(800, tft.getCursorY() + tft.getTextSizeY()-5);  tft.println("COMIDA");
     // Apareciendo y recortando bordes de add/delete/save
-    if(slowAppearanceImage(SLOW_APPEAR_GUARDAR_SUGERENCIA)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GUARDAR_SUGERENCIA));
     // --------------------------------------------------------------------
 
     // **************************************************************************************************** 
 
+    PT_END(pt);
 }
 
 /*------------------------- FIN SUGERIR ACCIONES --------------------------------------------------------*/
@@ -2616,27 +3143,27 @@ void sugerirAccion()
 
     if(option == ASK_CONFIRMATION_SAVE_CON_INTERNET || option == ASK_CONFIRMATION_SAVE_SIN_INTERNET) tft.setCursor(30, 20); // Guardar
     else tft.setCursor(30, 30); // Añadir y eliminar
-    tft.println(convertSpecialCharactersToHEX("¿ESTÁ SEGURO DE QUE QUIERE"));
+    tft.println(LATIN1("¿ESTÁ SEGURO DE QUE QUIERE"));
 
     // -------- INT -------------------
     if(eventOccurred()) return; // Evento de interrupción (botonera o báscula)  
 
     switch (option)
     {
-        case ASK_CONFIRMATION_ADD:    tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(convertSpecialCharactersToHEX("AÑADIR UN NUEVO PLATO?")); break; // BOTÓN AÑADIR
+        case ASK_CONFIRMATION_ADD:    tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(LATIN1("AÑADIR UN NUEVO PLATO?")); break; // BOTÓN AÑADIR
 
-        case ASK_CONFIRMATION_DELETE: tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(convertSpecialCharactersToHEX("BORRAR EL PLATO ACTUAL?"));     break; // BOTÓN ELIMINAR
+        case ASK_CONFIRMATION_DELETE: tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(LATIN1("BORRAR EL PLATO ACTUAL?"));     break; // BOTÓN ELIMINAR
 
       
         case ASK_CONFIRMATION_SAVE_CON_INTERNET: // BOTÓN GUARDAR
         case ASK_CONFIRMATION_SAVE_SIN_INTERNET:
-              tft.setCursor(80, tft.getCursorY() + tft.getTextSizeY()-40);  tft.print(convertSpecialCharactersToHEX("GUARDAR LA COMIDA ACTUAL?"));
+              tft.setCursor(80, tft.getCursorY() + tft.getTextSizeY()-40);  tft.print(LATIN1("GUARDAR LA COMIDA ACTUAL?"));
               // ----- ESPERA E INTERRUPCION ----------------
               if(doubleDelayAndCheckInterrupt(200)) return; 
               // ----- TEXTO (COMENTARIO) ---------
               tft.selectInternalFont(RA8876_FONT_SIZE_32);
               tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
-              tft.setCursor(100, 180);  tft.println(convertSpecialCharactersToHEX("LOS VALORES NUTRICIONALES PASARÁN AL ACUMULADO DE HOY"));
+              tft.setCursor(100, 180);  tft.println(LATIN1("LOS VALORES NUTRICIONALES PASARÁN AL ACUMULADO DE HOY"));
               // -----------------------------------
               break;
     }
@@ -2661,7 +3188,7 @@ void sugerirAccion()
     if(option == ASK_CONFIRMATION_SAVE_CON_INTERNET || option == ASK_CONFIRMATION_SAVE_SIN_INTERNET) tft.setCursor(150, 275); // Guardar
     else tft.setCursor(150, 245); // Añadir y eliminar
     tft.println("PARA CONFIRMAR, PULSE DE NUEVO");
-    tft.setCursor(400, tft.getCursorY() + tft.getTextSizeY()-10);   tft.print(convertSpecialCharactersToHEX("EL BOTÓN")); 
+    tft.setCursor(400, tft.getCursorY() + tft.getTextSizeY()-10);   tft.print(LATIN1("EL BOTÓN")); 
     // ----------------------------------------------------------------------------------------------------
 
     // -------- INT -------------------
@@ -2672,10 +3199,10 @@ void sugerirAccion()
     // Copiar de PAGE3 a PAGE1
     switch (option)
     {
-        case ASK_CONFIRMATION_ADD:    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); break; // Mostrar BOTÓN AÑADIR (172x130) en PAGE1      
-        case ASK_CONFIRMATION_DELETE: tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130); break; // Mostrar BOTÓN ELIMINAR (172x130) en PAGE1   
+        case ASK_CONFIRMATION_ADD:    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); break; // Mostrar BOTÓN AÑADIR (172x130) en PAGE1      
+        case ASK_CONFIRMATION_DELETE: tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130); break; // Mostrar BOTÓN ELIMINAR (172x130) en PAGE1   
         case ASK_CONFIRMATION_SAVE_CON_INTERNET: 
-        case ASK_CONFIRMATION_SAVE_SIN_INTERNET:   tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,PAGE1_START_ADDR,SCREEN_WIDTH,420,400,172,130); break; // Mostrar BOTÓN GUARDAR (172x130) en PAGE1  
+        case ASK_CONFIRMATION_SAVE_SIN_INTERNET:   tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,paginaDibujo,SCREEN_WIDTH,420,400,172,130); break; // Mostrar BOTÓN GUARDAR (172x130) en PAGE1  
         default: break;       
     }
     // ----------------------------------------------------------------------------------------------------
@@ -2727,13 +3254,21 @@ void sugerirAccion()
 }*/
 
 // En esta versión no se indica por pantalla si hay conexión a Internet al pedir confirmar acción, sino que se informa al guardar.
-void pedirConfirmacion(byte option)
+char pedirConfirmacion(pt_t *pt, byte option)
 {
+    static pt_t ptHijo;
+    static bool pulsacion;
+    static byte i;
+
+    PT_BEGIN(pt);
+
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria
 
 
     // ----- TEXTO (PREGUNTA) ----------------------------------------------------------------------------
-    tft.clearScreen(AMARILLO_CONFIRM_Y_AVISO); // Fondo amarillo en PAGE1
+    empezarComposicion(); // Fondo y primera línea sin verse, para no ver el dashboard borrándose
+
+    tft.clearScreen(AMARILLO_CONFIRM_Y_AVISO); // Fondo amarillo
 
     tft.selectInternalFont(RA8876_FONT_SIZE_24);
     tft.setTextScale(RA8876_TEXT_W_SCALE_X3, RA8876_TEXT_H_SCALE_X3); 
@@ -2741,33 +3276,34 @@ void pedirConfirmacion(byte option)
 
     if(option == ASK_CONFIRMATION_SAVE) tft.setCursor(30, 20); // Guardar
     else tft.setCursor(30, 30); // Añadir y eliminar
-    tft.println(convertSpecialCharactersToHEX("¿ESTÁ SEGURO DE QUE QUIERE"));
+    tft.println(LATIN1("¿ESTÁ SEGURO DE QUE QUIERE"));
 
-    // -------- INT -------------------
-    if(eventOccurred()) return; // Evento de interrupción (botonera o báscula)  
+    presentarComposicion(); // Antes de ceder la CPU
+
+    // -------- CEDER CPU -------------
+    PT_CEDER_SI_AGOTADO(pt);
 
     switch (option)
     {
-        case ASK_CONFIRMATION_ADD:    tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(convertSpecialCharactersToHEX("AÑADIR UN NUEVO PLATO?")); break; // BOTÓN AÑADIR
+        case ASK_CONFIRMATION_ADD:    tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(LATIN1("AÑADIR UN NUEVO PLATO?")); break; // BOTÓN AÑADIR
 
-        case ASK_CONFIRMATION_DELETE: tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(convertSpecialCharactersToHEX("BORRAR EL PLATO ACTUAL?"));     break; // BOTÓN ELIMINAR
+        case ASK_CONFIRMATION_DELETE: tft.setCursor(110, tft.getCursorY() + tft.getTextSizeY()-40); tft.print(LATIN1("BORRAR EL PLATO ACTUAL?"));     break; // BOTÓN ELIMINAR
 
       
         case ASK_CONFIRMATION_SAVE: // BOTÓN GUARDAR
-              tft.setCursor(80, tft.getCursorY() + tft.getTextSizeY()-40);  tft.print(convertSpecialCharactersToHEX("GUARDAR LA COMIDA ACTUAL?"));
+              tft.setCursor(80, tft.getCursorY() + tft.getTextSizeY()-40);  tft.print(LATIN1("GUARDAR LA COMIDA ACTUAL?"));
               // ----- ESPERA E INTERRUPCION ----------------
-              if(doubleDelayAndCheckInterrupt(200)) return; 
+              PT_ESPERAR(pt, 200);
               // ----- TEXTO (COMENTARIO) ---------
               tft.selectInternalFont(RA8876_FONT_SIZE_32);
               tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
-              tft.setCursor(100, 180);  tft.println(convertSpecialCharactersToHEX("LOS VALORES NUTRICIONALES PASARÁN AL ACUMULADO DE HOY"));
+              tft.setCursor(100, 180);  tft.println(LATIN1("LOS VALORES NUTRICIONALES PASARÁN AL ACUMULADO DE HOY"));
               // -----------------------------------
               break;
     }
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(200)) return; 
-    if(doubleDelayAndCheckInterrupt(200)) return;  
+    PT_ESPERAR(pt, 400);
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ LINEA --------------------------------------------------------------------------------
@@ -2776,7 +3312,7 @@ void pedirConfirmacion(byte option)
     // ----------------------------------------------------------------------------------------------------
     
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(200)) return; 
+    PT_ESPERAR(pt, 200);
 
     // ----- TEXTO (CONFIRMACIÓN) -------------------------------------------------------------------------
     tft.selectInternalFont(RA8876_FONT_SIZE_24);
@@ -2785,20 +3321,20 @@ void pedirConfirmacion(byte option)
      if(option == ASK_CONFIRMATION_SAVE) tft.setCursor(150, 275); // Guardar
     else tft.setCursor(150, 245); // Añadir y eliminar
     tft.println("PARA CONFIRMAR, PULSE DE NUEVO");
-    tft.setCursor(400, tft.getCursorY() + tft.getTextSizeY()-10);   tft.print(convertSpecialCharactersToHEX("EL BOTÓN")); 
+    tft.setCursor(400, tft.getCursorY() + tft.getTextSizeY()-10);   tft.print(LATIN1("EL BOTÓN")); 
     // ----------------------------------------------------------------------------------------------------
 
-    // -------- INT -------------------
-    if(doubleDelayAndCheckInterrupt(200)) return; // Evento de interrupción (botonera o báscula)  
+    // ----- ESPERA E INTERRUPCION ----------------
+    PT_ESPERAR(pt, 200);
 
 
     // ------------ BOTÓN A PULSAR ------------------------------------------------------------------------
     // Copiar de PAGE3 a PAGE1
     switch (option)
     {
-        case ASK_CONFIRMATION_ADD:      tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130);     break;  // Mostrar BOTÓN AÑADIR (172x130) en PAGE1      
-        case ASK_CONFIRMATION_DELETE:   tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,PAGE1_START_ADDR,SCREEN_WIDTH,420,380,172,130);     break;  // Mostrar BOTÓN ELIMINAR (172x130) en PAGE1   
-        case ASK_CONFIRMATION_SAVE:     tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,PAGE1_START_ADDR,SCREEN_WIDTH,420,400,172,130);     break;  // Mostrar BOTÓN GUARDAR (172x130) en PAGE1  
+        case ASK_CONFIRMATION_ADD:      tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,645,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130);     break;  // Mostrar BOTÓN AÑADIR (172x130) en PAGE1      
+        case ASK_CONFIRMATION_DELETE:   tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,818,0,paginaDibujo,SCREEN_WIDTH,420,380,172,130);     break;  // Mostrar BOTÓN ELIMINAR (172x130) en PAGE1   
+        case ASK_CONFIRMATION_SAVE:     tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,131,paginaDibujo,SCREEN_WIDTH,420,400,172,130);     break;  // Mostrar BOTÓN GUARDAR (172x130) en PAGE1  
         default: break;       
     }
     // ----------------------------------------------------------------------------------------------------
@@ -2806,8 +3342,8 @@ void pedirConfirmacion(byte option)
 
     // ------------ DESPLAZAR MANO PARA SIMULAR MOVIMIENTO ------------------------------------------------
     // MANO por el camino hasta alcanzar botón
-    // Si ha ocurrido interrupción mientras se desplazaba la mano, se sale de la función.
-    if(desplazar_mano(option)) return; 
+    // Si ocurre un evento mientras se desplaza la mano, addEventoExterno() cancela toda la animación.
+    PT_SPAWN(pt, &ptHijo, desplazar_mano(&ptHijo, option));
     // ----------------------------------------------------------------------------------------------------
     
 
@@ -2815,13 +3351,11 @@ void pedirConfirmacion(byte option)
     // Tras trasladar la mano, no hay pulsación. Se van a hacer dos alternancias de pulsación,
     // es decir: pulsacion - no pulsacion - pulsacion - no pulsacion
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(400)) return;
-    if(doubleDelayAndCheckInterrupt(200)) return; 
+    PT_ESPERAR(pt, 1000);
 
-    bool pulsacion = true;
+    pulsacion = true;
 
-    for(byte i = 0; i < 10; i++) // Da para 5 pulsar/despulsar mientras no se cancele o confirme la acción
+    for(i = 0; i < 10; i++) // Da para 5 pulsar/despulsar mientras no se cancele o confirme la acción
     {
         if(pulsacion)   
             con_pulsacion(option); // Simular pulsación 
@@ -2829,15 +3363,13 @@ void pedirConfirmacion(byte option)
             sin_pulsacion(option); // Eliminar pulsación           
 
         // ----- ESPERA E INTERRUPCION ----------------
-        if(doubleDelayAndCheckInterrupt(400)) return;
-        if(doubleDelayAndCheckInterrupt(400)) return;
-        if(doubleDelayAndCheckInterrupt(200)) return; 
+        PT_ESPERAR(pt, 1000);
 
         pulsacion = !pulsacion; // Alternar entre pulsación y no pulsación
     }
     // ****************************************************************************************************
 
-
+    PT_END(pt);
 }
 
 
@@ -2887,7 +3419,7 @@ void showAccionRealizada(byte option)
 
     switch (option)
     {
-        case ADD_EXECUTED:                  tft.setCursor(170, 208);   tft.println(convertSpecialCharactersToHEX("NUEVO PLATO AÑADIDO"));             break;  // PLATO AÑADIDO
+        case ADD_EXECUTED:                  tft.setCursor(170, 208);   tft.println(LATIN1("NUEVO PLATO AÑADIDO"));             break;  // PLATO AÑADIDO
 
         case DELETE_EXECUTED:               tft.setCursor(100, 208);   tft.println("PLATO ACTUAL ELIMINADO");               break;  // PLATO ELIMINADO
 
@@ -2899,7 +3431,7 @@ void showAccionRealizada(byte option)
                                             tft.setCursor(120, 208);   tft.println("COMIDA ACTUAL GUARDADA");               break;  // Comida guardada al menos en local
 
         case SAVE_EXECUTED_ONLY_DATABASE:   tft.setCursor(120, 208);   tft.println("COMIDA ACTUAL GUARDADA");                                    break;  // Comida guardada solo en database. Error en acumulado local
-        case ERROR_SAVING_DATA:             tft.setCursor(120, 208);   tft.println(convertSpecialCharactersToHEX("¡ERROR AL GUARDAR DATOS!"));   break;  // Error al guardar datos
+        case ERROR_SAVING_DATA:             tft.setCursor(120, 208);   tft.println(LATIN1("¡ERROR AL GUARDAR DATOS!"));   break;  // Error al guardar datos
 
         default: break;
     }
@@ -2939,12 +3471,12 @@ void showAccionRealizada(byte option)
                 // No se pone if(pesoARetirar ...) porque aún no ha dado tiempo a actualizar 'pesoARetirar' y puede ser incorrecto
                 if(lastValidState == STATE_Init) // Si se inició el guardado desde Init, no habrá plato en báscula
                 {
-                    tft.setCursor(190, 388); tft.println(convertSpecialCharactersToHEX("LOS VALORES NUTRICIONALES SE HAN AÑADIDO"));
+                    tft.setCursor(190, 388); tft.println(LATIN1("LOS VALORES NUTRICIONALES SE HAN AÑADIDO"));
                     tft.setCursor(350, tft.getCursorY() + tft.getTextSizeY()+40); tft.print("AL ACUMULADO DE HOY"); 
                 }
                 else // Si se guarda tras conformar el plato, estando aún en la báscula, indicando que se retire
                 { 
-                    tft.setCursor(30, 388); tft.println(convertSpecialCharactersToHEX("LOS VALORES NUTRICIONALES SE HAN AÑADIDO AL ACUMULADO DE HOY"));  
+                    tft.setCursor(30, 388); tft.println(LATIN1("LOS VALORES NUTRICIONALES SE HAN AÑADIDO AL ACUMULADO DE HOY"));  
                     if(state_prev != STATE_REMOVAL_CHECK){ tft.setCursor(200,450); tft.println("RETIRE EL PLATO PARA COMENZAR DE NUEVO"); }
                 }
 
@@ -2962,11 +3494,11 @@ void showAccionRealizada(byte option)
                 {
                     case SAVE_EXECUTED_FULL:                        tft.setCursor(20,550);    tft.println(" SUBIDO A WEB ");                                                break; // Esquina izquierda
                     
-                    case SAVE_EXECUTED_ONLY_LOCAL_ERROR_HTTP:       tft.setCursor(750,550);   tft.println(convertSpecialCharactersToHEX(" ERROR EN EL ENVÍO "));            break; // Esquina derecha
+                    case SAVE_EXECUTED_ONLY_LOCAL_ERROR_HTTP:       tft.setCursor(750,550);   tft.println(LATIN1(" ERROR EN EL ENVÍO "));            break; // Esquina derecha
                     
                     case SAVE_EXECUTED_ONLY_LOCAL_NO_WIFI:          tft.setCursor(850,550);   tft.println(" SIN INTERNET ");                                                break; // Esquina derecha
                     
-                    case SAVE_EXECUTED_ONLY_LOCAL_TIMEOUT:          tft.setCursor(705,550);   tft.println(convertSpecialCharactersToHEX(" ERROR EN ENVÍO (TIMEOUT) "));     break; // Esquina derecha
+                    case SAVE_EXECUTED_ONLY_LOCAL_TIMEOUT:          tft.setCursor(705,550);   tft.println(LATIN1(" ERROR EN ENVÍO (TIMEOUT) "));     break; // Esquina derecha
                     
                     case SAVE_EXECUTED_ONLY_LOCAL_UNKNOWN_ERROR:    tft.setCursor(790,550);   tft.println(" ERROR DESCONOCIDO ");                                           break; // Esquina derecha
                     
@@ -3032,7 +3564,7 @@ void showCancel(byte option)
     tft.setTextScale(RA8876_TEXT_W_SCALE_X3, RA8876_TEXT_H_SCALE_X3); 
     tft.setTextForegroundColor(WHITE); 
     
-    if(option == ACTION_CANCELLED){ tft.setCursor(220, 258);  tft.println(convertSpecialCharactersToHEX("ACCIÓN CANCELADA")); }
+    if(option == ACTION_CANCELLED){ tft.setCursor(220, 258);  tft.println(LATIN1("ACCIÓN CANCELADA")); }
     else if(option == PRODUCT_CANCELLED){ tft.setCursor(190, 258);  tft.println("PRODUCTO CANCELADO"); }
     
     // ------ LINEA ---------
@@ -3051,8 +3583,12 @@ void showCancel(byte option)
    checkIntencionRemoval(): Indica que se ha retirado el plato sin avisar y pregunta qué se quiere hacer
                                 con él: añadir otro, eliminarlo o guardarlo.
 ----------------------------------------------------------------------------------------------------------*/
-void checkIntencionRemoval()
+char checkIntencionRemoval(pt_t *pt, byte /*option*/)
 {
+    static pt_t ptHijo;
+
+    PT_BEGIN(pt);
+
     showingTemporalScreen = true; // Activar flag de estar mostrando pantalla temporal/transitoria
     // Es una pantalla temporal porque se dan 30 segundos para responder a la pregunta de qué hacer con el plato retirado sin avisar.
 
@@ -3064,14 +3600,14 @@ void checkIntencionRemoval()
     tft.setTextForegroundColor(ROJO_TEXTO_CONFIRM_Y_AVISO); 
 
     tft.setCursor(30, 40);                                  
-    tft.println(convertSpecialCharactersToHEX("¡PLATO RETIRADO SIN AVISAR!"));
+    tft.println(LATIN1("¡PLATO RETIRADO SIN AVISAR!"));
 
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2); 
     tft.setCursor(150, tft.getCursorY() + tft.getTextSizeY() - 70); 
-    tft.println(convertSpecialCharactersToHEX("INDIQUE LO QUE QUERÍA HACER"));
+    tft.println(LATIN1("INDIQUE LO QUE QUERÍA HACER"));
 
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(200)) return; 
+    PT_ESPERAR(pt, 200);
     // ----------------------------------------------------------------------------------------------------
 
 
@@ -3080,21 +3616,21 @@ void checkIntencionRemoval()
 
     // ----- AÑADIR PLATO -------------------------------------------------
     // Añadir plato --> anadir (172x130) 
-    tft.setCursor(170, 367);                                        tft.println(convertSpecialCharactersToHEX("AÑADIR"));
+    tft.setCursor(170, 367);                                        tft.println(LATIN1("AÑADIR"));
     tft.setCursor(190, tft.getCursorY() + tft.getTextSizeY()-13);   tft.println("OTRO");
     tft.setCursor(180, tft.getCursorY() + tft.getTextSizeY()-13);   tft.println("PLATO");
     // Apareciendo y recortando bordes de add
-    if(slowAppearanceImage(SLOW_APPEAR_ANADIR_SUDDEN_REMOVAL)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_ANADIR_SUDDEN_REMOVAL));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(200)) return;
+    PT_ESPERAR(pt, 200);
     // --------------------------------------------------------------------
 
 
     // ----- TEXTO (COMENTARIO ÚLTIMO ALIMENTO) ---------------------------
     tft.setCursor(150, 520);                                  
-    tft.println(convertSpecialCharactersToHEX("(NO SE GUARDARÁ EL ÚLTIMO ALIMENTO COLOCADO)"));
+    tft.println(LATIN1("(NO SE GUARDARÁ EL ÚLTIMO ALIMENTO COLOCADO)"));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(500)) return;
+    PT_ESPERAR(pt, 500);
     // --------------------------------------------------------------------
 
 
@@ -3104,9 +3640,9 @@ void checkIntencionRemoval()
     tft.setCursor(445, tft.getCursorY() + tft.getTextSizeY()-13);  tft.println("PLATO");
     tft.setCursor(420, tft.getCursorY() + tft.getTextSizeY()-13);  tft.println("RETIRADO");
     // Apareciendo y recortando bordes de add/delete/save
-    if(slowAppearanceImage(SLOW_APPEAR_BORRAR_SUDDEN_REMOVAL)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_BORRAR_SUDDEN_REMOVAL));
     // ----- ESPERA E INTERRUPCION ----------------
-    if(doubleDelayAndCheckInterrupt(500)) return;
+    PT_ESPERAR(pt, 500);
     // --------------------------------------------------------------------
 
 
@@ -3115,10 +3651,11 @@ void checkIntencionRemoval()
     tft.setCursor(703, 367);                                        tft.println("GUARDAR");
     tft.setCursor(710, tft.getCursorY() + tft.getTextSizeY()-13);   tft.println("COMIDA");
     // Apareciendo y recortando bordes de save
-    if(slowAppearanceImage(SLOW_APPEAR_GUARDAR_SUDDEN_REMOVAL)) return;
+    PT_SPAWN(pt, &ptHijo, slowAppearanceImage(&ptHijo, SLOW_APPEAR_GUARDAR_SUDDEN_REMOVAL));
     // --------------------------------------------------------------------
     // ----------------------------------------------------------------------------------------------------
 
+    PT_END(pt);
 }
 
 
@@ -3139,7 +3676,7 @@ void showBorradoAutomatico()
     tft.setTextForegroundColor(ROJO_TEXTO_CONFIRM_Y_AVISO); 
 
     // Título principal de la pantalla
-    tft.setCursor(384, 100);    tft.println(convertSpecialCharactersToHEX("¡AVISO!"));                           
+    tft.setCursor(384, 100);    tft.println(LATIN1("¡AVISO!"));                           
     // ---------------------------------------------------------------------------------------------------
 
     // ------------ LINEA --------------------------------------------------------------------------------
@@ -3148,7 +3685,7 @@ void showBorradoAutomatico()
 
     // ------------ ADVERTENCIA ---------------------------------------------------------------------------
     // Mostrar icono de aviso
-    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,115,293,PAGE1_START_ADDR,SCREEN_WIDTH,445,230,135,112); // Mostrar aviso2 (135x113) en PAGE1
+    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,115,293,paginaDibujo,SCREEN_WIDTH,445,230,135,112); // Mostrar aviso2 (135x113) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
     // ----- TEXTO (PLATO BORRADO POR RETIRAR SIN AVISAR) -------------------------------------------------
@@ -3156,7 +3693,7 @@ void showBorradoAutomatico()
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2); 
 
     tft.setCursor(130, 410);   tft.println("SE HA ELIMINADO EL PLATO PORQUE"); 
-    tft.setCursor(135, tft.getCursorY() + tft.getTextSizeY());      tft.println(convertSpecialCharactersToHEX("NO HA INDICADO QUÉ HACER CON ÉL"));
+    tft.setCursor(135, tft.getCursorY() + tft.getTextSizeY());      tft.println(LATIN1("NO HA INDICADO QUÉ HACER CON ÉL"));
     // ----------------------------------------------------------------------------------------------------   
     
 }
@@ -3190,13 +3727,14 @@ void showWarning(byte option)
     // Título principal de la pantalla
     switch(option)
     {
-        case WARNING_BARCODE_NOT_READ:          tft.setCursor(100, 100);    tft.println(convertSpecialCharactersToHEX("¡PRODUCTO NO DETECTADO!"));      break;
-        case WARNING_PRODUCT_NOT_FOUND:         tft.setCursor(100, 100);    tft.println(convertSpecialCharactersToHEX("¡PRODUCTO NO ENCONTRADO!"));     break;
-        case WARNING_MEALS_LEFT:                tft.setCursor(100, 100);    tft.println(convertSpecialCharactersToHEX("¡SINCRONIZACIÓN PARCIAL!"));     break;
-        case WARNING_NO_INTERNET_NO_BARCODE:    tft.setCursor(70, 100);     tft.println(convertSpecialCharactersToHEX("¡SIN CONEXIÓN A INTERNET!"));    break;
+        case WARNING_BARCODE_NOT_READ:          tft.setCursor(100, 100);    tft.println(LATIN1("¡PRODUCTO NO DETECTADO!"));      break;
+        case WARNING_PRODUCT_NOT_FOUND:         tft.setCursor(100, 100);    tft.println(LATIN1("¡PRODUCTO NO ENCONTRADO!"));     break;
+        case WARNING_MEALS_LEFT:                tft.setCursor(100, 100);    tft.println(LATIN1("¡SINCRONIZACIÓN PARCIAL!"));     break;
+        case WARNING_NO_INTERNET_NO_BARCODE:    tft.setCursor(70, 100);     tft.println(LATIN1("¡SIN CONEXIÓN A INTERNET!"));    break;
+        case WARNING_LISTA_LLENA:               tft.setCursor(80, 100);     tft.println(LATIN1("¡COMIDA DEMASIADO LARGA!"));     break;
         
         // ADD, DELETE, SAVE, RAW_COOKED_NOT_NEEDED
-        default:                            tft.setCursor(384, 100);    tft.println(convertSpecialCharactersToHEX("¡AVISO!"));                           break;
+        default:                            tft.setCursor(384, 100);    tft.println(LATIN1("¡AVISO!"));                           break;
     }
     
     // ---------------------------------------------------------------------------------------------------
@@ -3219,7 +3757,7 @@ void showWarning(byte option)
     // al modificar el punto de inicio de la imagen en PAGE3. 
 
     // aviso2 
-    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,115,293,PAGE1_START_ADDR,SCREEN_WIDTH,445,230,135,112); // Mostrar aviso2 (135x113) en PAGE1
+    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,115,293,paginaDibujo,SCREEN_WIDTH,445,230,135,112); // Mostrar aviso2 (135x113) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
 
@@ -3231,17 +3769,17 @@ void showWarning(byte option)
     {
         case WARNING_NOT_ADDED: // AÑADIR
             tft.setCursor(150, 410);                                      tft.println("NO SE HA CREADO UN NUEVO PLATO"); 
-            tft.setCursor(180, tft.getCursorY() + tft.getTextSizeY());    tft.print(convertSpecialCharactersToHEX("PORQUE EL ACTUAL ESTÁ VACÍO"));  
+            tft.setCursor(180, tft.getCursorY() + tft.getTextSizeY());    tft.print(LATIN1("PORQUE EL ACTUAL ESTÁ VACÍO"));  
             break;
 
         case WARNING_NOT_DELETED: // ELIMINAR
             tft.setCursor(180, 410);                                      tft.println("NO SE HA ELIMINADO EL PLATO"); 
-            tft.setCursor(300, tft.getCursorY() + tft.getTextSizeY());    tft.print(convertSpecialCharactersToHEX("PORQUE ESTÁ VACÍO")); 
+            tft.setCursor(300, tft.getCursorY() + tft.getTextSizeY());    tft.print(LATIN1("PORQUE ESTÁ VACÍO")); 
             break;
 
         case WARNING_NOT_SAVED: // GUARDAR
             tft.setCursor(190, 410);                                      tft.println("NO SE HA GUARDADO LA COMIDA"); 
-            tft.setCursor(300, tft.getCursorY() + tft.getTextSizeY());    tft.print(convertSpecialCharactersToHEX("PORQUE ESTÁ VACÍA")); 
+            tft.setCursor(300, tft.getCursorY() + tft.getTextSizeY());    tft.print(LATIN1("PORQUE ESTÁ VACÍA")); 
             break;
 
         case WARNING_RAW_COOKED_NOT_NEEDED: // NO HACE FALTA CRUDO/COCINADO PARA PRODUCTO BARCODE
@@ -3250,22 +3788,27 @@ void showWarning(byte option)
             break;
 
         case WARNING_BARCODE_NOT_READ: // CÓDIGO DE BARRAS NO LEÍDO
-            tft.setCursor(100, 410);                                        tft.println(convertSpecialCharactersToHEX("NO SE HA LEÍDO EL CÓDIGO DE BARRAS"));
+            tft.setCursor(100, 410);                                        tft.println(LATIN1("NO SE HA LEÍDO EL CÓDIGO DE BARRAS"));
             break;
 
         case WARNING_PRODUCT_NOT_FOUND: // PRODUCTO NO ENCONTRADO
             tft.setCursor(150, 410);                                        tft.println("NO SE HA ENCONTRADO EL PRODUCTO");
-            tft.setCursor(180, tft.getCursorY() + tft.getTextSizeY()+10);   tft.print(convertSpecialCharactersToHEX("CON EL CÓDIGO: ")); tft.println(barcode); 
+            tft.setCursor(180, tft.getCursorY() + tft.getTextSizeY()+10);   tft.print(LATIN1("CON EL CÓDIGO: ")); tft.println(barcode); 
             break;
 
         case WARNING_MEALS_LEFT: // SINCRONIZACIÓN PARCIAL
             tft.setCursor(50, 410);                                         tft.println("ALGUNAS COMIDAS NO SE HAN SINCRONIZADO"); 
-            tft.setCursor(100, tft.getCursorY() + tft.getTextSizeY()+20);   tft.println(convertSpecialCharactersToHEX("SE INTENTARÁ DE NUEVO MÁS ADELANTE"));
+            tft.setCursor(100, tft.getCursorY() + tft.getTextSizeY()+20);   tft.println(LATIN1("SE INTENTARÁ DE NUEVO MÁS ADELANTE"));
             break;
 
         case WARNING_NO_INTERNET_NO_BARCODE: // SIN CONEXIÓN A INTERNET
             tft.setCursor(140, 410);                                        tft.println("NO SE PUEDE BUSCAR EL PRODUCTO");
             break;
+
+        case WARNING_LISTA_LLENA: // NO CABEN MÁS ALIMENTOS EN LA LISTA DE LA COMIDA
+            tft.setCursor(100, 410);                                        tft.println(LATIN1("NO SE HA AÑADIDO EL ÚLTIMO ALIMENTO"));
+            tft.setCursor(320, tft.getCursorY() + tft.getTextSizeY()+20);   tft.println("GUARDE LA COMIDA");
+            break;
     }
     // ----------------------------------------------------------------------------------------------------  
 
@@ -3294,7 +3837,7 @@ void showCriticFailureSD()
     tft.setTextForegroundColor(WHITE); 
     //tft.setCursor(60, 258);  
     tft.setCursor(200, 158);  
-    tft.println(convertSpecialCharactersToHEX("¡FALLO EN MEMORIA!")); // 12x24 escalado x3
+    tft.println(LATIN1("¡FALLO EN MEMORIA!")); // 12x24 escalado x3
     // ------ LINEA ---------
     tft.fillRoundRect(252,270,764,278,3,WHITE);
     // -------------------------------------------------------------------
@@ -3332,9 +3875,9 @@ void showError(byte option)
 
     // cruz
     tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-    tft.sdCardDraw16bppBIN256bits(0,292,114,127,fileCruz); // Cargar cruz (114x127) en PAGE3 =>  x  =  0  ->   y = <crudoGra(131) + crudoGra(160) + 1 = 292
+    tft.sdCardDraw16bppBINBurst(0,292,114,127,fileCruz); // Cargar cruz (114x127) en PAGE3 =>  x  =  0  ->   y = <crudoGra(131) + crudoGra(160) + 1 = 292
 
-    tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+    tft.canvasImageStartAddress(paginaDibujo); 
 
     // ----- TEXTO (ERROR) --------------------------------------------------------------------------------
     tft.clearScreen(RED_ERROR_Y_CANCEL); // Fondo rojo en PAGE1
@@ -3343,12 +3886,12 @@ void showError(byte option)
     tft.setTextScale(RA8876_TEXT_W_SCALE_X3, RA8876_TEXT_H_SCALE_X3); 
     tft.setTextForegroundColor(WHITE); 
     tft.setCursor(170, 100);
-    tft.println(convertSpecialCharactersToHEX("¡ACCIÓN INCORRECTA!"));
+    tft.println(LATIN1("¡ACCIÓN INCORRECTA!"));
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ CRUZ --------------------------------------------------------------------------------
     // Copiar de PAGE3 a PAGE1
-    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,292,PAGE1_START_ADDR,SCREEN_WIDTH,451,231,114,127); // Mostrar cruz (114x127) en PAGE1
+    tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,292,paginaDibujo,SCREEN_WIDTH,451,231,114,127); // Mostrar cruz (114x127) en PAGE1
     // ----------------------------------------------------------------------------------------------------
 
     // ------------ LINEA --------------------------------------------------------------------------------
@@ -3383,17 +3926,17 @@ void showError(byte option)
             break;
 
       case ERROR_STATE_PROCESAMIENTO: // Crudo o Cocinado
-            tft.setCursor(100, 450);                                      tft.println(convertSpecialCharactersToHEX("COLOQUE UN ALIMENTO SOBRE LA BÁSCULA"));  
+            tft.setCursor(100, 450);                                      tft.println(LATIN1("COLOQUE UN ALIMENTO SOBRE LA BÁSCULA"));  
             break;
 
       case ERROR_STATE_WEIGHTED: // Pesado
             tft.setCursor(140, 420);                                      tft.println("ESCOJA GRUPO PARA OTRO ALIMENTO,"); 
-            tft.setCursor(100, tft.getCursorY() + tft.getTextSizeY());    tft.print(convertSpecialCharactersToHEX("AÑADA OTRO PLATO O GUARDE LA COMIDA")); 
+            tft.setCursor(100, tft.getCursorY() + tft.getTextSizeY());    tft.print(LATIN1("AÑADA OTRO PLATO O GUARDE LA COMIDA")); 
             break;
 
       case ERROR_STATE_ADD_CHECK: // add_check
-            tft.setCursor(70, 420);                                       tft.println(convertSpecialCharactersToHEX("PULSE \"AÑADIR\" DE NUEVO PARA CONFIRMAR")); 
-            tft.setCursor(100, tft.getCursorY() + tft.getTextSizeY());    tft.print(convertSpecialCharactersToHEX("O CUALQUIER OTRO BOTÓN PARA CANCELAR")); 
+            tft.setCursor(70, 420);                                       tft.println(LATIN1("PULSE \"AÑADIR\" DE NUEVO PARA CONFIRMAR")); 
+            tft.setCursor(100, tft.getCursorY() + tft.getTextSizeY());    tft.print(LATIN1("O CUALQUIER OTRO BOTÓN PARA CANCELAR")); 
             break;
       
       case ERROR_STATE_ADDED: // Added
@@ -3405,7 +3948,7 @@ void showError(byte option)
 
       case ERROR_STATE_DELETE_CHECK: // delete_check
             tft.setCursor(60, 420);                                       tft.println("PULSE \"BORRAR\" DE NUEVO PARA CONFIRMAR"); 
-            tft.setCursor(90, tft.getCursorY() + tft.getTextSizeY());     tft.print(convertSpecialCharactersToHEX("O CUALQUIER OTRO BOTÓN PARA CANCELAR")); 
+            tft.setCursor(90, tft.getCursorY() + tft.getTextSizeY());     tft.print(LATIN1("O CUALQUIER OTRO BOTÓN PARA CANCELAR")); 
             break;
 
       case ERROR_STATE_DELETED: // Deleted
@@ -3417,7 +3960,7 @@ void showError(byte option)
 
       case ERROR_STATE_SAVE_CHECK: // save_check
             tft.setCursor(50, 420);                                       tft.println("PULSE \"GUARDAR\" DE NUEVO PARA CONFIRMAR"); 
-            tft.setCursor(90, tft.getCursorY() + tft.getTextSizeY());     tft.print(convertSpecialCharactersToHEX("O CUALQUIER OTRO BOTÓN PARA CANCELAR")); 
+            tft.setCursor(90, tft.getCursorY() + tft.getTextSizeY());     tft.print(LATIN1("O CUALQUIER OTRO BOTÓN PARA CANCELAR")); 
             break;
 
       case ERROR_STATE_SAVED: // Saved
@@ -3428,7 +3971,7 @@ void showError(byte option)
             break;
       
       case ERROR_STATE_CANCEL: // Cancelado
-            tft.setCursor(90, 450);                                       tft.println(convertSpecialCharactersToHEX("ESPERE A QUE TERMINE LA CANCELACIÓN"));  
+            tft.setCursor(90, 450);                                       tft.println(LATIN1("ESPERE A QUE TERMINE LA CANCELACIÓN"));  
             break;
 
       case ERROR_STATE_AVISO: // Aviso
@@ -3452,256 +3995,63 @@ void showError(byte option)
 /*-------------------------------------------------------------------------------------------------------*/
 
 /*---------------------------------------------------------------------------------------------------------
-   slowAppearanceImage(): Mostrar imagen de cocinado (escoger procesamiento) o de scale (colocar alimento)
-                          apareciendo poco a poco en pantalla cuando corresponda.
-        Parámetros: 
-            - option -> 1: cocinado  2: scale
-
-        Return:   true: ha habido interrupción    false: no ha habido interrupción
-            Devuelve bool para salir de la función que llamó de slowAppearanceImage() si hubo interrupción.  
+   Imágenes que aparecen poco a poco (opacidad 32 --> 1) sobre el fondo verde de la pantalla, en el orden
+   de las opciones SLOW_APPEAR_x (la clave de la opción N es la N-1).
 ----------------------------------------------------------------------------------------------------------*/
-bool slowAppearanceImage(byte option)
-{
-    uint8_t i;
-    switch(option)
-    {
-        case SLOW_APPEAR_COCINADO: // Cocinado
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar cociGra apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                // Pantalla completa:
-                //tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,1,320,PAGE1_START_ADDR,SCREEN_WIDTH,300,300,177,160,i);
-                // Sobre Dashboard:
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,800,350,PAGE1_START_ADDR,SCREEN_WIDTH,280,350,177,160,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            // Pantalla completa:
-            //tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,300,300,177,160); // Mostrar sin transparencia
-            // Sobre Dashboard
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,280,350,177,160); // Mostrar sin transparencia
-
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-
-            break;
-
-
-        case SLOW_APPEAR_SCALE: // ScaleG
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar scaleG apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,372,293,PAGE1_START_ADDR,SCREEN_WIDTH,1,320,PAGE1_START_ADDR,SCREEN_WIDTH,437,320,146,147,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,373,293,PAGE1_START_ADDR,SCREEN_WIDTH,437,320,146,147); // Mostrar sin transparencia
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
+const fotogramaClave_t clavesAparicion[] = {
+    // tipo          inicio duración          imagen            x    y    fondo     destino   ancho alto  alfa   color
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 173, 131, 800, 350, 280, 350, 177, 160, 32, 0,  0 },   // SLOW_APPEAR_COCINADO (sobre el dashboard)
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 373, 293,   1, 320, 437, 320, 146, 147, 32, 0,  0 },   // SLOW_APPEAR_SCALE
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR,   0,   0,   0, 288, 236, 288, 130, 125, 32, 0,  0 },   // SLOW_APPEAR_GRUPO1
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 131,   0,   0, 288, 396, 288, 130, 125, 32, 0,  0 },   // SLOW_APPEAR_GRUPO2 (x = grupo1(236) + 130 + 30)
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 262,   0,   0, 288, 556, 288, 130, 125, 32, 0,  0 },   // SLOW_APPEAR_GRUPO3 (x = grupo2(396) + 130 + 30)
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 393,   0,   0, 288, 716, 288, 130, 125, 32, 0,  0 },   // SLOW_APPEAR_GRUPO4 (x = grupo3(556) + 130 + 30)
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 373, 293, 873, 450,  69, 200, 146, 147, 32, 0,  0 },   // SLOW_APPEAR_SCALE_SUGERENCIA
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR,   1,   1, 873, 450, 245, 213, 129, 124, 32, 0,  0 },   // SLOW_APPEAR_GRUPO1_SUGERENCIA
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 652,   0, 873, 450, 404, 206, 158, 130, 32, 0,  0 },   // SLOW_APPEAR_ANADIR_SUGERENCIA
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 825,   0, 873, 450, 592, 206, 158, 130, 32, 0,  0 },   // SLOW_APPEAR_BORRAR_SUGERENCIA
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR,   7, 131, 873, 450, 780, 206, 158, 130, 32, 0,  0 },   // SLOW_APPEAR_GUARDAR_SUGERENCIA
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 652,   0, 873, 450, 144, 216, 158, 130, 32, 0,  0 },   // SLOW_APPEAR_ANADIR_SUDDEN_REMOVAL
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR, 825,   0, 873, 450, 404, 216, 158, 130, 32, 0,  0 },   // SLOW_APPEAR_BORRAR_SUDDEN_REMOVAL
+    { CLAVE_APARECER, 0,    DURACION_FUNDIDO, PAGE3_START_ADDR,   7, 131, 873, 450, 678, 216, 158, 130, 32, 0,  0 },   // SLOW_APPEAR_GUARDAR_SUDDEN_REMOVAL
+};
+
+#define   NUM_SLOW_APPEAR   (sizeof(clavesAparicion)/sizeof(clavesAparicion[0]))
 
 
-        case SLOW_APPEAR_GRUPO1: // grupo1
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar grupo1 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,0,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,288,PAGE1_START_ADDR,SCREEN_WIDTH,236,288,130,125,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,0,0,PAGE1_START_ADDR,SCREEN_WIDTH,236,288,130,125); // x = 236  ->  y = 288
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_GRUPO2: // grupo2
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar grupo2 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,131,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,288,PAGE1_START_ADDR,SCREEN_WIDTH,396,288,130,125,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,131,0,PAGE1_START_ADDR,SCREEN_WIDTH,396,288,130,125); // x = <grupo1(236) + grupo1(130) + 30 = 396  ->  y = 288
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_GRUPO3: // grupo3
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar grupo3 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,288,PAGE1_START_ADDR,SCREEN_WIDTH,556,288,130,125,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,262,0,PAGE1_START_ADDR,SCREEN_WIDTH,556,288,130,125); // x = <grupo2(396) + grupo2(130) + 30 = 556  ->  y = 288
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_GRUPO4: // grupo4
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar grupo4 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,393,0,PAGE1_START_ADDR,SCREEN_WIDTH,0,288,PAGE1_START_ADDR,SCREEN_WIDTH,716,288,130,125,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,393,0,PAGE1_START_ADDR,SCREEN_WIDTH,716,288,130,125); // x = <grupo3(556) + grupo3(130) + 30 = 716  ->  y = 288
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_SCALE_SUGERENCIA: // ScaleG sugerencias
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar scale apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,372,293,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,69,200,146,147,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,373,293,PAGE1_START_ADDR,SCREEN_WIDTH,69,200,146,147); // Mostrar scaleG (150x150)
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_GRUPO1_SUGERENCIA: // grupo1 sugerencias
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar grupo1 apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,1,1,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,245,213,129,124,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,1,1,PAGE1_START_ADDR,SCREEN_WIDTH,245,213,129,124); // Mostrar grupo1 (130x125)
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_ANADIR_SUGERENCIA: // añadir sugerencias
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar añadir apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,652,0,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,404,206,158,130,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,652,0,PAGE1_START_ADDR,SCREEN_WIDTH,404,206,158,130); // Mostrar añadir (172x130)
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_ANADIR_SUDDEN_REMOVAL: // añadir tras retirar sin avisar
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar añadir apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,652,0,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,144,216,158,130,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,652,0,PAGE1_START_ADDR,SCREEN_WIDTH,144,216,158,130); // Mostrar añadir (172x130)
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-
-        case SLOW_APPEAR_BORRAR_SUGERENCIA: // borrar sugerencias
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar borrar apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,825,0,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,592,206,158,130,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,825,0,PAGE1_START_ADDR,SCREEN_WIDTH,592,206,158,130); // Mostrar borrar (172x130) 
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
-        
-        case SLOW_APPEAR_BORRAR_SUDDEN_REMOVAL: // borrar tras retirar sin avisar
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar borrar apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,825,0,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,404,216,158,130,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,825,0,PAGE1_START_ADDR,SCREEN_WIDTH,404,216,158,130); // Mostrar borrar (172x130) 
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
-
+/*---------------------------------------------------------------------------------------------------------
+   slowAppearanceImage(): Mostrar imagen de cocinado (escoger procesamiento), de scale (colocar alimento),
+                          de los grupos o de los botones de las sugerencias apareciendo poco a poco en
+                          pantalla cuando corresponda.
+        Parámetros: 
+            - option -> SLOW_APPEAR_x (clave de clavesAparicion[])
 
-        case SLOW_APPEAR_GUARDAR_SUGERENCIA: // guardar sugerencias
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar guardar apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,7,131,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,780,206,158,130,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,7,131,PAGE1_START_ADDR,SCREEN_WIDTH,780,206,158,130); // Mostrar guardar (172x130)
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
+        Return:   PT_ESPERANDO mientras aparece la imagen    PT_TERMINADA al acabar
+            Es un protohilo (Protothread.h) que se ejecuta con PT_SPAWN() desde la pantalla que lo usa.
+----------------------------------------------------------------------------------------------------------*/
+char slowAppearanceImage(pt_t *pt, byte option)
+{
+    PT_BEGIN(pt);
 
-        
-        case SLOW_APPEAR_GUARDAR_SUDDEN_REMOVAL: // guardar tras retirar sin avisar
-            for(i = 32; i >= 1; i--){ // i = 16 --> RA8876_ALPHA_OPACITY_16
-                // Mostrar guardar apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,7,131,PAGE1_START_ADDR,SCREEN_WIDTH,873,450,PAGE1_START_ADDR,SCREEN_WIDTH,678,216,158,130,i);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,7,131,PAGE1_START_ADDR,SCREEN_WIDTH,678,216,158,130); // Mostrar guardar (172x130)
-  
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-  
-            break;
+    if((option >= 1) and (option <= NUM_SLOW_APPEAR)) PT_TIMELINE(pt, &clavesAparicion[option - 1], 1);
 
+    PT_END(pt);
+}
 
-        default: break;
-    }
 
-    return false; // Si no ha ocurrido ninguna interrupción mientras aparecía la imagen,
-                  // se continúa con la función que llamó a esta.
-}
 
+/*---------------------------------------------------------------------------------------------------------
+   Cambio entre crudo y cocinado: la imagen seleccionada antes desaparece (opacidad 4 --> 30, y al final se
+   borra) mientras la otra aparece (30 --> 4, y al final se copia opaca). Dos claves por opción, en el
+   orden de SLOW_DISAPPEAR_x.
+----------------------------------------------------------------------------------------------------------*/
+const fotogramaClave_t clavesProcesamiento[] = {
+    // tipo             inicio duración                  imagen            x    y    fondo     destino   ancho alto  alfa    color
+    { CLAVE_DESAPARECER, 0,    DURACION_FUNDIDO_CRUZADO, PAGE3_START_ADDR, 351, 131, 800, 350, 567, 350, 177, 160,  4, 31, VERDE_PEDIR_Y_EXITO },  // SLOW_DISAPPEAR_CRUDO_APPEAR_COCINADO: crudoGra
+    { CLAVE_APARECER,    0,    DURACION_FUNDIDO_CRUZADO, PAGE3_START_ADDR, 173, 131, 800, 350, 280, 350, 177, 160, 30,  3, 0 },                    //                                      cociGra
+    { CLAVE_DESAPARECER, 0,    DURACION_FUNDIDO_CRUZADO, PAGE3_START_ADDR, 173, 131, 800, 350, 280, 350, 177, 160,  4, 31, VERDE_PEDIR_Y_EXITO },  // SLOW_DISAPPEAR_COCINADO_APPEAR_CRUDO: cociGra
+    { CLAVE_APARECER,    0,    DURACION_FUNDIDO_CRUZADO, PAGE3_START_ADDR, 351, 131, 800, 350, 567, 350, 177, 160, 30,  3, 0 },                    //                                      crudoGra
+};
 
 
 /*---------------------------------------------------------------------------------------------------------
@@ -3710,52 +4060,17 @@ bool slowAppearanceImage(byte option)
         Parámetros: 
             - option -> 1: desaparecer crudo y aparecer cocinado    2: desaparecer cocinado y aparecer crudo
 
-        Return:   true: ha habido interrupción    false: no ha habido interrupción
-            Devuelve bool para salir de la función que llamó de slowAppearanceAndDisappareanceProcesamiento() si hubo interrupción.  
+        Return:   PT_ESPERANDO mientras cambian las imágenes    PT_TERMINADA al acabar
+            Se inicia como animación (iniciarAnimacion()) desde alternateButtonsProcesamiento().
 ----------------------------------------------------------------------------------------------------------*/
-bool slowAppearanceAndDisappareanceProcesamiento(byte option)
+char slowAppearanceAndDisappareanceProcesamiento(pt_t *pt, byte option)
 {
-    uint8_t i,j;
-
-     switch(option)
-     {
-        case SLOW_DISAPPEAR_CRUDO_APPEAR_COCINADO: // Desaparecer CRUDO y aparecer COCINADO 
-            for (i = 4, j = 30; i <= 30 && j >= 4; i++, j--) {  // i|j = 16  --> RA8876_ALPHA_OPACITY_16
-                // Mostrar crudoGra desapareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,351,131,PAGE1_START_ADDR,SCREEN_WIDTH,800,350,PAGE1_START_ADDR,SCREEN_WIDTH,567,350,177,160,i);
-                // Mostrar cociGra apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,800,350,PAGE1_START_ADDR,SCREEN_WIDTH,280,350,177,160,j);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.clearArea(562,345,749,515,VERDE_PEDIR_Y_EXITO); // Borrar crudoGra
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,280,350,177,160); // Mostrar cociGra (177x160) en PAGE1
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            break;
+    PT_BEGIN(pt);
 
-        case SLOW_DISAPPEAR_COCINADO_APPEAR_CRUDO: // Desaparecer COCINADO y aparecer CRUDO
-            for (i = 4, j = 30; i <= 30 && j >= 4; i++, j--) {  // i|j = 16  --> RA8876_ALPHA_OPACITY_16
-                // Mostrar cociGra desapareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,173,131,PAGE1_START_ADDR,SCREEN_WIDTH,800,350,PAGE1_START_ADDR,SCREEN_WIDTH,280,350,177,160,i);
-                // Mostrar crudoGra apareciendo con opacidad a nivel i/32. Utiliza el propio fondo verde de la page1 como S1.
-                tft.bteMemoryCopyWithOpacity(PAGE3_START_ADDR,SCREEN_WIDTH,351,131,PAGE1_START_ADDR,SCREEN_WIDTH,800,350,PAGE1_START_ADDR,SCREEN_WIDTH,567,350,177,160,j);
-                delay(10);
-                // ----- INT -------------------
-                if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            }
-            tft.clearArea(275,345,462,515,VERDE_PEDIR_Y_EXITO); // Borrar cociGra
-            tft.bteMemoryCopy(PAGE3_START_ADDR,SCREEN_WIDTH,351,131,PAGE1_START_ADDR,SCREEN_WIDTH,567,350,177,160); // Mostrar crudoGra (177x160) en PAGE1
-            // ----- INT -------------------
-            if(eventOccurred()) return true; // Evento de interrupción (botonera o báscula)
-            break;
-
-        default: break;
-    }
+    if((option == SLOW_DISAPPEAR_CRUDO_APPEAR_COCINADO) or (option == SLOW_DISAPPEAR_COCINADO_APPEAR_CRUDO))
+        PT_TIMELINE(pt, &clavesProcesamiento[2*(option - 1)], 2);
 
-    return false; // Si no ha ocurrido ninguna interrupción mientras aparecían/desaparecían las imágenes,
-                  // se continúa con la función que llamó a esta.
+    PT_END(pt);
 }
 
 
@@ -3781,7 +4096,7 @@ void pedirConfirmacion_DELETE_FILES()
     tft.setTextScale(RA8876_TEXT_W_SCALE_X2, RA8876_TEXT_H_SCALE_X2); 
     tft.setTextForegroundColor(WHITE); 
     tft.setCursor(220, 200);  
-    tft.println(convertSpecialCharactersToHEX("¿BORRAR FICHEROS USUARIO?")); // 12x24 escalado x3
+    tft.println(LATIN1("¿BORRAR FICHEROS USUARIO?")); // 12x24 escalado x3
 
     tft.selectInternalFont(RA8876_FONT_SIZE_32);
     tft.setTextScale(RA8876_TEXT_W_SCALE_X1, RA8876_TEXT_H_SCALE_X1); 
@@ -3830,13 +4145,238 @@ void showAcumuladoBorrado(const bool &exito)
 /*********************************************************************************************************/
 
 
+// Fotogramas del reloj de arena, en el orden en que se muestran durante la carga
+#define   NUM_FOTOGRAMAS_RELOJ  10
+void (*const fotogramasReloj[NUM_FOTOGRAMAS_RELOJ])() = { putReloj1, putReloj2, putReloj3, putReloj4, putRelojGirado1, 
+                                                          putRelojGirado2, putRelojGirado3, putRelojGirado4, putRelojGirado5, putRelojGirado6 };
+
+
 /*---------------------------------------------------------------------------------------------------------
    loadPicturesShowHourglass(): Carga en SDRAM las imágenes necesarias para todas las pantallas de SmartCloth 
    mientras muestra un reloj de arena en la pantalla. Las imágenes del reloj se muestran en una secuencia 
    específica para lograr el efecto de giro del reloj.
-   La carga de las imágenes se hace por orden de peso para dar la sensación de una carga cada vez más rápida.
+   Si la SD tiene el atlas de imágenes (tools/atlas), se cargan todas de una pasada con cargarAtlasImagenes(),
+   que se salta las que ya estén en la SDRAM (firmaSDRAM_t). Si no, o si no es válido, se cargan de los 
+   ficheros sueltos con cargarImagenesSueltas().
 ----------------------------------------------------------------------------------------------------------*/
 void loadPicturesShowHourglass()
+{
+  #if defined(IMG_STATS)
+    unsigned long inicioCarga = millis();
+    tft.resetStatsImagenes();
+  #endif
+
+    imagenesEnSDRAM = 0;
+    bool atlas = cargarAtlasImagenes();
+    if(!atlas) cargarImagenesSueltas();
+
+    // Recuadro azul utilizado para la transparencia de crudo/cocinado en dashboard. Tiene el mismo tamaño que esas imágenes.
+    tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
+    tft.fillRect(610,174,657,216,GRIS_CUADROS); // Cargar cuadro (47x42) en PAGE3 => x = <kcal(529) + kcal(80) + 1 = 610    ->  y = <kcal = 174
+
+    // Caracteres de los campos del dashboard en PAGINA_GLIFOS
+    cargarCacheGlifos();
+
+
+    //---------------------------------------------------------------------------------------------------
+    // ----- REGRESAR A LA PÁGINA 1 ---------------------------------------------------------------------
+    // Regresamos la dirección de inicio del canvas a la PAGE1 para que lo que se escriba a partir de ahora se muestre en pantalla
+    tft.canvasImageStartAddress(paginaDibujo); 
+    // ---------------------------------------------------------------------------------------------------
+    // ---------------------------------------------------------------------------------------------------
+
+  #if defined(IMG_STATS) && defined(SM_DEBUG)
+    SerialPC.print(F("\nCarga de imagenes ")); SerialPC.print(atlas ? F("(atlas): ") : F("(ficheros sueltos): "));
+    SerialPC.print(millis() - inicioCarga); SerialPC.print(F(" ms en total, ")); SerialPC.print(imagenesEnSDRAM); SerialPC.print(F(" imagenes ya en la SDRAM, "));
+    SerialPC.print(tft.aperturasImagenes); SerialPC.print(F(" ficheros abiertos, "));
+    SerialPC.print(tft.usImagenes / 1000); SerialPC.print(F(" ms leyendo ")); SerialPC.print(tft.bytesImagenes); SerialPC.print(F(" bytes de la SD ("));
+    SerialPC.print(tft.usImagenes ? (uint32_t)((uint64_t)tft.bytesImagenes * 1000000 / tft.usImagenes) : 0); SerialPC.println(F(" bytes/s)"));
+  #endif
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   cargarAtlasImagenes(): Carga todas las imágenes del atlas (fileAtlas) abriéndolo una sola vez y leyéndolo
+                          de principio a fin: cabecera, manifiesto y los datos de cada imagen, en el orden
+                          del manifiesto. Las comprimidas se descomprimen mientras se envían a la pantalla. Tras cada imagen se muestra el siguiente fotograma del reloj de arena
+                          (las 10 primeras imágenes son sus fotogramas).
+                          Si la firma de la SDRAM es de este atlas (reinicio sin apagar la pantalla), se saltan 
+                          las imágenes que siguen intactas. Al terminar se escribe la firma nueva.
+                          El atlas se crea en el PC con tools/atlas a partir de tools/atlas/disposicion.txt, que
+                          tiene las mismas posiciones que cargarImagenesSueltas().
+          Return: 'false' si no hay atlas o no es válido (no se ha cargado nada) o si se acaba antes de tiempo
+----------------------------------------------------------------------------------------------------------*/
+bool cargarAtlasImagenes()
+{
+    #if defined(IMG_STATS)
+      unsigned long inicio = micros();
+    #endif
+
+    File fichero = SD.open(fileAtlas);
+    if(!fichero) return false;
+
+    #if defined(IMG_STATS)
+      tft.aperturasImagenes++;
+    #endif
+
+    // ----- CABECERA Y MANIFIESTO -----------------
+    cabeceraAtlas_t cabecera;
+    imagenAtlas_t manifiesto[ATLAS_MAX_IMAGENES];
+
+    bool valido = (fichero.read((uint8_t*)&cabecera, sizeof(cabecera)) == sizeof(cabecera)) and (cabecera.magic == ATLAS_MAGIC) 
+                  and (cabecera.version == ATLAS_VERSION) and (cabecera.nImagenes >= NUM_FOTOGRAMAS_RELOJ) and (cabecera.nImagenes <= ATLAS_MAX_IMAGENES);
+    if(valido) valido = (fichero.read((uint8_t*)manifiesto, cabecera.nImagenes * sizeof(imagenAtlas_t)) == (int)(cabecera.nImagenes * sizeof(imagenAtlas_t)));
+
+    for(byte i = 0; valido and (i < cabecera.nImagenes); i++)
+    {
+        const imagenAtlas_t &img = manifiesto[i];
+        valido = (img.pagina >= 2) and (img.pagina <= 4) and ((img.x + img.ancho) <= SCREEN_WIDTH) and ((img.y + img.alto) <= SCREEN_HEIGHT)
+                 and ((img.formato == ATLAS_Q565) or ((img.formato == ATLAS_RGB565) and (img.bytes == (uint32_t)img.ancho * img.alto * 2)))
+                 and ((img.offset + img.bytes) <= fichero.size());
+    }
+
+    #if defined(IMG_STATS)
+      tft.usImagenes += micros() - inicio;
+    #endif
+
+    if(!valido)
+    {
+        #if defined(SM_DEBUG)
+            SerialPC.println(F("Atlas de imagenes no valido. Se cargan los ficheros sueltos"));
+        #endif
+        fichero.close();
+        return false;
+    }
+    // ---------------------------------------------
+
+    // ----- IMÁGENES QUE YA ESTÁN EN LA SDRAM -----
+    uint32_t hashAtlas = fnv1a((uint8_t*)manifiesto, cabecera.nImagenes * sizeof(imagenAtlas_t), fnv1a((uint8_t*)&cabecera, sizeof(cabecera)));
+
+    firmaSDRAM_t firma;
+    bool firmaValida = leerFirmaSDRAM(firma) and (firma.hashAtlas == hashAtlas) and (firma.nImagenes == cabecera.nImagenes);
+
+    bool enSDRAM[ATLAS_MAX_IMAGENES];
+    for(byte i = 0; i < cabecera.nImagenes; i++)
+    {
+        enSDRAM[i] = firmaValida and (hashImagenSDRAM(manifiesto[i]) == firma.hashImagen[i]);
+        if(enSDRAM[i]) imagenesEnSDRAM++;
+    }
+
+    #if defined(SM_DEBUG)
+        if(firmaValida){ SerialPC.print(F("Imagenes ya cargadas en la SDRAM: ")); SerialPC.print(imagenesEnSDRAM); SerialPC.print(F(" de ")); SerialPC.println(cabecera.nImagenes); }
+    #endif
+
+    if(imagenesEnSDRAM == cabecera.nImagenes)
+    {
+        fichero.close();
+        return true;
+    }
+
+    // Si se reinicia a mitad de la carga, la firma anterior no puede dar por buenas las imágenes a medias
+    invalidarFirmaSDRAM();
+    // ---------------------------------------------
+
+    // ----- IMÁGENES ------------------------------
+    bool paginaBorrada[3] = { firmaValida, firmaValida, firmaValida }; // PAGE2, PAGE3 y PAGE4. No se borran si conservan imágenes
+    byte cargadas = 0;
+
+    for(byte i = 0; i < cabecera.nImagenes; i++)
+    {
+        const imagenAtlas_t &img = manifiesto[i];
+        if(enSDRAM[i]){ cargadas++; continue; }
+
+        tft.canvasImageStartAddress(direccionPaginaAtlas(img.pagina)); // putReloj..() deja el canvas en la página de pantalla
+        if(!paginaBorrada[img.pagina - 2])
+        {
+            tft.clearScreen(BLACK);
+            paginaBorrada[img.pagina - 2] = true;
+        }
+
+        if((fichero.position() != img.offset) and !fichero.seek(img.offset)) break; // Relleno hasta el siguiente sector
+        bool dibujada = (img.formato == ATLAS_Q565) ? tft.sdCardDraw16bppQ565(img.x, img.y, img.ancho, img.alto, fichero, img.bytes)
+                                                    : tft.sdCardDraw16bppBINBurst(img.x, img.y, img.ancho, img.alto, fichero);
+        if(!dibujada) break;
+
+        fotogramasReloj[i % NUM_FOTOGRAMAS_RELOJ](); // Siguiente fotograma del reloj de arena en la página de pantalla
+        cargadas++;
+    }
+    // ---------------------------------------------
+
+    fichero.close();
+    if(cargadas != cabecera.nImagenes) return false;
+
+    // ----- FIRMA NUEVA ---------------------------
+    firma.magic = FIRMA_MAGIC;
+    firma.hashAtlas = hashAtlas;
+    firma.nImagenes = cabecera.nImagenes;
+    firma.reservado = 0;
+    for(byte i = 0; i < cabecera.nImagenes; i++) if(!enSDRAM[i]) firma.hashImagen[i] = hashImagenSDRAM(manifiesto[i]);
+    escribirFirmaSDRAM(firma);
+    // ---------------------------------------------
+
+    return true;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   hashImagenSDRAM(): FNV-1a de FIRMA_FILAS filas (primera, central y última) de una imagen del atlas, leídas
+                      de su página en la SDRAM. Leer la imagen entera costaría casi lo mismo que cargarla.
+----------------------------------------------------------------------------------------------------------*/
+uint32_t hashImagenSDRAM(const imagenAtlas_t &img)
+{
+    tft.canvasImageStartAddress(direccionPaginaAtlas(img.pagina));
+
+    uint32_t hash = FNV_INICIAL;
+    for(byte f = 0; f < FIRMA_FILAS; f++) hash = tft.checksum16bpp(img.x, img.y + (uint32_t)(img.alto - 1) * f / (FIRMA_FILAS - 1), img.ancho, 1, hash);
+    return hash;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   leerFirmaSDRAM(): Lee la firma de la primera fila de PAGINA_FIRMA.
+          Return: 'false' si no es una firma válida (p. ej. tras encender la pantalla, con la SDRAM sin iniciar)
+----------------------------------------------------------------------------------------------------------*/
+bool leerFirmaSDRAM(firmaSDRAM_t &firma)
+{
+    tft.canvasImageStartAddress(PAGINA_FIRMA);
+    tft.readPicture_16bpp(0, 0, sizeof(firmaSDRAM_t) / 2, 1, (unsigned short*)&firma);
+
+    return (firma.magic == FIRMA_MAGIC) and (firma.nImagenes <= ATLAS_MAX_IMAGENES)
+           and (firma.hash == fnv1a((uint8_t*)&firma, offsetof(firmaSDRAM_t, hash)));
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   escribirFirmaSDRAM(): Calcula el hash de la firma y la escribe en la primera fila de PAGINA_FIRMA.
+----------------------------------------------------------------------------------------------------------*/
+void escribirFirmaSDRAM(firmaSDRAM_t &firma)
+{
+    firma.hash = fnv1a((uint8_t*)&firma, offsetof(firmaSDRAM_t, hash));
+
+    tft.canvasImageStartAddress(PAGINA_FIRMA);
+    tft.putPicture_16bpp(0, 0, sizeof(firmaSDRAM_t) / 2, 1, (const unsigned short*)&firma);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   invalidarFirmaSDRAM(): Borra el 'magic' de la firma. Se llama antes de escribir imágenes en PAGE2-PAGE4
+                          para que un reinicio a mitad de la carga no dé por buenas las imágenes anteriores.
+----------------------------------------------------------------------------------------------------------*/
+void invalidarFirmaSDRAM()
+{
+    const unsigned short cero[2] = { 0, 0 };
+
+    tft.canvasImageStartAddress(PAGINA_FIRMA);
+    tft.putPicture_16bpp(0, 0, 2, 1, cero);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   cargarImagenesSueltas(): Carga las imágenes de sus ficheros (Files.h), una a una, mostrando el reloj de arena.
+                            La carga de las imágenes se hace por orden de peso para dar la sensación de una carga 
+                            cada vez más rápida.
+----------------------------------------------------------------------------------------------------------*/
+void cargarImagenesSueltas()
 {
   /*
     ------------------ POSICIONES DE IMAGENES EN LAS PAGINAS ----------------------------------------------------------------------------------------------------
@@ -3857,6 +4397,9 @@ void loadPicturesShowHourglass()
     --------------------------------------------------------------------------------------------------------------------------------------------------------------
   */
 
+  // Estas imágenes no tienen firma: si la SDRAM tenía la de un atlas, deja de valer
+  invalidarFirmaSDRAM();
+
   // EN PRIMER LUGAR SE CARGAN LAS IMÁGENES DEL RELOJ, SEGUIDAS DE LAS LETRAS DEL LOGO DE ARRANQUE. A PARTIR DE AHÍ, LA CARGA DE HA ORDENADO SEGÚN
   // EL PESO, DE MÁS PESADAS A MENOS, PARA QUE DÉ LA SENSACIÓN DE QUE CADA VEZ GIRA MÁS RÁPIDO EL RELOJ.
 
@@ -3866,54 +4409,54 @@ void loadPicturesShowHourglass()
       tft.clearScreen(BLACK);
 
       // reloj1
-      tft.sdCardDraw16bppBIN256bits(0,279,65,103,fileReloj1); // Cargar reloj1 (65x103) en PAGE2 => x = 0   ->   y = <brain1(170) + brain1(108) + 1 = 279  
+      tft.sdCardDraw16bppBINBurst(0,279,65,103,fileReloj1); // Cargar reloj1 (65x103) en PAGE2 => x = 0   ->   y = <brain1(170) + brain1(108) + 1 = 279  
       putReloj1(); // Mostrar reloj1 en PAGE1 => borrar PAGE1
 
       // reloj2
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2 porque al mostrar reloj1 se activa PAGE1 para borrarla
-      tft.sdCardDraw16bppBIN256bits(66,279,65,103,fileReloj2);   // Cargar reloj2 (65x103) en PAGE2 => <reloj1(0) + reloj1(65) + 1 = 66  -> y = 279
+      tft.sdCardDraw16bppBINBurst(66,279,65,103,fileReloj2);   // Cargar reloj2 (65x103) en PAGE2 => <reloj1(0) + reloj1(65) + 1 = 66  -> y = 279
       putReloj2(); // Mostrar reloj2 en PAGE1
 
       // reloj3
       // No hace falta volver a PAGE2 porque no ha hecho falta activar PAGE1 para borrar reloj1 al escribir reloj2 en PAGE1
-      tft.sdCardDraw16bppBIN256bits(132,279,65,103,fileReloj3); // Cargar reloj3 (65x103) en PAGE2 => x = <reloj2(66) + reloj2(65) + 1 = 132   ->   y = 279
+      tft.sdCardDraw16bppBINBurst(132,279,65,103,fileReloj3); // Cargar reloj3 (65x103) en PAGE2 => x = <reloj2(66) + reloj2(65) + 1 = 132   ->   y = 279
       putReloj3(); // Mostrar reloj3 en PAGE1
 
       // reloj4
       // No hace falta volver a PAGE2 porque no ha hecho falta activar PAGE1 para borrar reloj2 al escribir reloj3 en PAGE1
-      tft.sdCardDraw16bppBIN256bits(198,279,65,103,fileReloj4); // Cargar reloj4 (65x103) en PAGE2 => x = <reloj3(132) + reloj3(65) + 1 = 198   ->   y = 279   
+      tft.sdCardDraw16bppBINBurst(198,279,65,103,fileReloj4); // Cargar reloj4 (65x103) en PAGE2 => x = <reloj3(132) + reloj3(65) + 1 = 198   ->   y = 279   
       putReloj4(); // Mostrar reloj4 en PAGE1
       // -------------------------------------------------
 
       // --------- RELOJES GIRADOS 1, 2, 3, 4, 5 y 6 -----------------
       // relGir1
       // No hace falta volver a PAGE2 porque no ha hecho falta activar PAGE1 para borrar reloj3 al escribir reloj4 en PAGE1
-      tft.sdCardDraw16bppBIN256bits(264,279,95,115,fileRelGir1);   // Cargar relGir1 (95x115) en PAGE2 => x = <reloj4(198) + reloj4(65) + 1 = 264   ->   y = 279   
+      tft.sdCardDraw16bppBINBurst(264,279,95,115,fileRelGir1);   // Cargar relGir1 (95x115) en PAGE2 => x = <reloj4(198) + reloj4(65) + 1 = 264   ->   y = 279   
       putRelojGirado1(); // Mostrar relGir1 en PAGE1 => No hace falta borrar reloj4 para mostrar relGir1 porque relGir1 ocupa más espacio -> se coloca encima
 
       // relGir2
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2 porque al mostrar relGir1 se activa PAGE1 para borrarla
-      tft.sdCardDraw16bppBIN256bits(360,279,112,112,fileRelGir2); // Cargar relGir2 (112x112) en PAGE2 => x = <relGir1(264) + relGir1(95) + 1 = 360  ->   y = 279   
+      tft.sdCardDraw16bppBINBurst(360,279,112,112,fileRelGir2); // Cargar relGir2 (112x112) en PAGE2 => x = <relGir1(264) + relGir1(95) + 1 = 360  ->   y = 279   
       putRelojGirado2();  // Mostrar relGir2 en PAGE1 => Se borra la PAGE1 entera (más fácil que solo un área) antes de escribir relGir2
 
       // relGir3
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2 porque al mostrar relGir2 se activa PAGE1 para borrarla
-      tft.sdCardDraw16bppBIN256bits(473,279,113,94,fileRelGir3);   // Cargar relGir3 (113x94) en PAGE2 => x = <relGir2(360) + relGir2(112) + 1 = 473  ->   y = 279 
+      tft.sdCardDraw16bppBINBurst(473,279,113,94,fileRelGir3);   // Cargar relGir3 (113x94) en PAGE2 => x = <relGir2(360) + relGir2(112) + 1 = 473  ->   y = 279 
       putRelojGirado3(); // Mostrar relGir3 en PAGE1 => Se borra la PAGE1 entera (más fácil que solo un área) antes de escribir relGir3
 
       // relGir4
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2 porque al mostrar relGir3 se activa PAGE1 para borrarla
-      tft.sdCardDraw16bppBIN256bits(587,279,100,65,fileRelGir4); // Cargar relGir4 (100x65) en PAGE2 => x = <relGir3(473) + relGir3(113) + 1 = 587     ->   y = 279   
+      tft.sdCardDraw16bppBINBurst(587,279,100,65,fileRelGir4); // Cargar relGir4 (100x65) en PAGE2 => x = <relGir3(473) + relGir3(113) + 1 = 587     ->   y = 279   
       putRelojGirado4(); // Mostrar relGir4 en PAGE1 => Se borra la PAGE1 entera (más fácil que solo un área) antes de escribir relGir4
 
       // relGir5
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2 porque al mostrar relGir4 se activa PAGE1 para borrarla
-      tft.sdCardDraw16bppBIN256bits(688,279,113,94,fileRelGir5);   // Cargar relGir5 (113x94) en PAGE2 => x = <relGir4(587) + relGir4(100) + 1 = 688    ->   y = 279 
+      tft.sdCardDraw16bppBINBurst(688,279,113,94,fileRelGir5);   // Cargar relGir5 (113x94) en PAGE2 => x = <relGir4(587) + relGir4(100) + 1 = 688    ->   y = 279 
       putRelojGirado5(); // Mostrar relGir5 en PAGE1 => Se borra la PAGE1 entera (más fácil que solo un área) antes de escribir relGir5
 
       // relGir6
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2 porque al mostrar relGir5 se activa PAGE1 para borrarla
-      tft.sdCardDraw16bppBIN256bits(802,279,99,113,fileRelGir6); // Cargar relGir6 (99x113) en PAGE2 => x = <relGir5(688) + relGir5(113) + 1 = 802     ->   y = 279  
+      tft.sdCardDraw16bppBINBurst(802,279,99,113,fileRelGir6); // Cargar relGir6 (99x113) en PAGE2 => x = <relGir5(688) + relGir5(113) + 1 = 802     ->   y = 279  
       putRelojGirado6(); // Mostrar relGir6 en PAGE1 => Se borra la PAGE1 entera (más fácil que solo un área) antes de escribir relGir6
       // -------------------------------------------------------------
     // ------------- FIN CARGA INICIAL --------------------------------------------------------------------
@@ -3923,61 +4466,61 @@ void loadPicturesShowHourglass()
       // -------- LETRAS S-M-A-R-T-C-L-O-H -------
       // Letra S
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(0,0,95,159,fileS);      // Cargar S  (95x159) en PAGE2  =>  x  =  <S  =  0   ->    y = 0  
+      tft.sdCardDraw16bppBINBurst(0,0,95,159,fileS);      // Cargar S  (95x159) en PAGE2  =>  x  =  <S  =  0   ->    y = 0  
       
       putReloj1(); // Mostrar reloj1 en PAGE1 => borrar PAGE1
 
       // Letra M
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(96,0,104,159,fileM);    // Cargar M  (104x154) en PAGE2 =>  x  =  <M  =  <S(0)    + S(95)   + 1  =  96    ->    y = 0   
+      tft.sdCardDraw16bppBINBurst(96,0,104,159,fileM);    // Cargar M  (104x154) en PAGE2 =>  x  =  <M  =  <S(0)    + S(95)   + 1  =  96    ->    y = 0   
       
       putReloj2(); // Mostrar reloj2 en PAGE1 
 
       // Letra A
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(201,0,104,159,fileA);   // Cargar A  (104x159) en PAGE2 =>  x  =  <A  =  <M(96)   + M(104)  + 1  =  201   ->    y = 0   
+      tft.sdCardDraw16bppBINBurst(201,0,104,159,fileA);   // Cargar A  (104x159) en PAGE2 =>  x  =  <A  =  <M(96)   + M(104)  + 1  =  201   ->    y = 0   
       
       putReloj3(); // Mostrar reloj3 en PAGE1 
       
       // Letra R
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(306,0,85,159,fileR);    // Cargar R  (85x159)  en PAGE2 =>  x  =  <R  =  <A(201)  + A(104)  + 1  =  306   ->    y = 0  
+      tft.sdCardDraw16bppBINBurst(306,0,85,159,fileR);    // Cargar R  (85x159)  en PAGE2 =>  x  =  <R  =  <A(201)  + A(104)  + 1  =  306   ->    y = 0  
      
       putReloj4(); // Mostrar reloj4 en PAGE1 
      
       // Letra T
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(392,0,104,159,fileT);   // Cargar T1 (104x159) en PAGE2 =>  x  =  <T1 =  <R(306)  + R(85)   + 1  =  392   ->    y = 0   
+      tft.sdCardDraw16bppBINBurst(392,0,104,159,fileT);   // Cargar T1 (104x159) en PAGE2 =>  x  =  <T1 =  <R(306)  + R(85)   + 1  =  392   ->    y = 0   
       
       putRelojGirado1(); // Mostrar relGir1 en PAGE1 
 
       // Letra C
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(497,0,85,159,fileC);    // Cargar C (85x159) en PAGE2 =>  x  =  <C  =  <T1(392) + T1(104) + 1  =  497   ->    y = 0  
+      tft.sdCardDraw16bppBINBurst(497,0,85,159,fileC);    // Cargar C (85x159) en PAGE2 =>  x  =  <C  =  <T1(392) + T1(104) + 1  =  497   ->    y = 0  
       
       putRelojGirado2(); // Mostrar relGir2 en PAGE1 
       
       // Letra L
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(583,0,85,159,fileL);    // Cargar L (85x159) en PAGE2 =>  x  =  <L  =  <C(497)  + C(85)   + 1  =  583   ->    y = 0   
+      tft.sdCardDraw16bppBINBurst(583,0,85,159,fileL);    // Cargar L (85x159) en PAGE2 =>  x  =  <L  =  <C(497)  + C(85)   + 1  =  583   ->    y = 0   
       
       putRelojGirado3(); // Mostrar relGir3 en PAGE1 
       
       // Letra O
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(669,0,85,159,fileO);    // Cargar O (85x159) en PAGE2 =>  x  =  <O  =  <L(583)  + L(85)   + 1  =  669   ->    y = 0  
+      tft.sdCardDraw16bppBINBurst(669,0,85,159,fileO);    // Cargar O (85x159) en PAGE2 =>  x  =  <O  =  <L(583)  + L(85)   + 1  =  669   ->    y = 0  
       
       putRelojGirado4(); // Mostrar relGir4 en PAGE1 
       
       // Letra H
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(755,0,85,159,fileH);    // Cargar H (85x159) en PAGE2 =>  x  =  <H  =  <O(669)  + O(85)   + 1  =  755   ->    y = 0  
+      tft.sdCardDraw16bppBINBurst(755,0,85,159,fileH);    // Cargar H (85x159) en PAGE2 =>  x  =  <H  =  <O(669)  + O(85)   + 1  =  755   ->    y = 0  
       
       putRelojGirado5(); // Mostrar relGir5 en PAGE1 
 
       // --------- LOGO ---------
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(841,0,162,169,fileLogo); // Cargar log (162x169) en PAGE2 => x  = <log =  <H(755)  + H(85)   + 1  =  841   ->    y = 0  
+      tft.sdCardDraw16bppBINBurst(841,0,162,169,fileLogo); // Cargar log (162x169) en PAGE2 => x  = <log =  <H(755)  + H(85)   + 1  =  841   ->    y = 0  
      
       putRelojGirado6(); // Mostrar relGir6 en PAGE1 
     // -------------- FIN ARRANQUE -----------------------------------------------------------------------
@@ -3989,19 +4532,19 @@ void loadPicturesShowHourglass()
         // Sincronizando SM
         tft.canvasImageStartAddress(PAGE4_START_ADDR); // Ir a PAGE4
         tft.clearScreen(BLACK);
-        tft.sdCardDraw16bppBIN256bits(0,0,188,123,fileSincronizando);  // Cargar sincronizando (188x123) en PAGE4 =>  x  =  0      ->   y = 0 
+        tft.sdCardDraw16bppBINBurst(0,0,188,123,fileSincronizando);  // Cargar sincronizando (188x123) en PAGE4 =>  x  =  0      ->   y = 0 
 
         putReloj1(); // Mostrar reloj1 en PAGE1 => borrar PAGE1
 
         // SM sincronizado
         tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-        tft.sdCardDraw16bppBIN256bits(189,0,220,136,fileSMSincronizado);  // Cargar SM sincronizado (220x136) en PAGE4 =>  x  =  <sincronizando(0) + sincronizando(188) + 1 = 189      ->   y = 0
+        tft.sdCardDraw16bppBINBurst(189,0,220,136,fileSMSincronizado);  // Cargar SM sincronizado (220x136) en PAGE4 =>  x  =  <sincronizando(0) + sincronizando(188) + 1 = 189      ->   y = 0
 
         putReloj2(); // Mostrar reloj2 en PAGE1 
 
         // Aviso nuevo para sincronización y barcode
         tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-        tft.sdCardDraw16bppBIN256bits(410,0,143,126,fileAvisoNew);  // Cargar aviso nuevo (143x126) en PAGE4 =>  x  =  <sync_ok(189) + sync_ok(220) + 1 = 410      ->   y = 0
+        tft.sdCardDraw16bppBINBurst(410,0,143,126,fileAvisoNew);  // Cargar aviso nuevo (143x126) en PAGE4 =>  x  =  <sync_ok(189) + sync_ok(220) + 1 = 410      ->   y = 0
 
         putReloj3(); // Mostrar reloj3 en PAGE1 
 
@@ -4011,19 +4554,19 @@ void loadPicturesShowHourglass()
     // -------------- LEER BARCODE, BUSCAR PRODUCTO Y CONFIRMAR ------------------------------------------
         // Escanear
         tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-        tft.sdCardDraw16bppBIN256bits(0,137,171,128,fileScanBarcode); // Cargar scan (171x128) en PAGE4 =>  x  =  0  ->   y = <sync_ok(0) + sync_ok(136) + 1 = 137  
+        tft.sdCardDraw16bppBINBurst(0,137,171,128,fileScanBarcode); // Cargar scan (171x128) en PAGE4 =>  x  =  0  ->   y = <sync_ok(0) + sync_ok(136) + 1 = 137  
 
         putReloj4(); // Mostrar reloj4 en PAGE1 => borrar PAGE1
 
         // Lupa
         tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-        tft.sdCardDraw16bppBIN256bits(172,137,82,130,fileSearchProduct); // Cargar lupa (82x130) en PAGE4 =>  x  =  <scan(0) + scan(171) + 1 = 172  ->   y = 137
+        tft.sdCardDraw16bppBINBurst(172,137,82,130,fileSearchProduct); // Cargar lupa (82x130) en PAGE4 =>  x  =  <scan(0) + scan(171) + 1 = 172  ->   y = 137
 
         putRelojGirado1(); // Mostrar relGir1 en PAGE1
 
         // Producto encontrado
         tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-        tft.sdCardDraw16bppBIN256bits(369,137,297,104,fileProductFound); // Cargar producto encontrado (297x104) en PAGE4 =>  x  =  <lupa(172) + lupa(82) + 1 = 369  ->   y = 137
+        tft.sdCardDraw16bppBINBurst(369,137,297,104,fileProductFound); // Cargar producto encontrado (297x104) en PAGE4 =>  x  =  <lupa(172) + lupa(82) + 1 = 369  ->   y = 137
 
         putRelojGirado2(); // Mostrar relGir2 en PAGE1
         
@@ -4034,31 +4577,31 @@ void loadPicturesShowHourglass()
       // añadir
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
       tft.clearScreen(BLACK);
-      tft.sdCardDraw16bppBIN256bits(645,0,172,130,fileBotonAnadir);  // Cargar anadir (172x130) en PAGE3 =>  x  =  <manoR(524) + manoR(120) + 1 = 645      ->   y = 0  
+      tft.sdCardDraw16bppBINBurst(645,0,172,130,fileBotonAnadir);  // Cargar anadir (172x130) en PAGE3 =>  x  =  <manoR(524) + manoR(120) + 1 = 645      ->   y = 0  
       
        putRelojGirado3(); // Mostrar relGir3 en PAGE1 
       
       // borrar
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(818,0,172,130,fileBotonEliminar);  // Cargar borrar (172x130) en PAGE3 =>  x  = <anadir(645) + anadir(172) + 1 = 818    ->   y = 0  
+      tft.sdCardDraw16bppBINBurst(818,0,172,130,fileBotonEliminar);  // Cargar borrar (172x130) en PAGE3 =>  x  = <anadir(645) + anadir(172) + 1 = 818    ->   y = 0  
       
         putRelojGirado4(); // Mostrar relGir4 en PAGE1
 
       // guardar
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(0,131,172,130,fileBotonGuardar); // Cargar guardar (172x130) en PAGE3 =>  x  =   0  ->   y = <borrar(0) + borrar(130) + 1 = 131 
+      tft.sdCardDraw16bppBINBurst(0,131,172,130,fileBotonGuardar); // Cargar guardar (172x130) en PAGE3 =>  x  =   0  ->   y = <borrar(0) + borrar(130) + 1 = 131 
      
         putRelojGirado5(); // Mostrar relGir5 en PAGE1
      
       // cociGra
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(173,131,177,160,fileCocinadoGrande); // Cargar cociGra (177x160) en PAGE3 =>  x  =  <guardar(0) + guardar(172) + 1 = 173    ->   y = 131  
+      tft.sdCardDraw16bppBINBurst(173,131,177,160,fileCocinadoGrande); // Cargar cociGra (177x160) en PAGE3 =>  x  =  <guardar(0) + guardar(172) + 1 = 173    ->   y = 131  
      
         putRelojGirado6(); // Mostrar relGir6 en PAGE1
      
       // crudoGra
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(351,131,177,160,fileCrudoGrande); // Cargar crudoGra (177x160) en PAGE3 =>  x  =  <cociGra(131) + cociGra(177) + 1 = 351  ->   y = 131  
+      tft.sdCardDraw16bppBINBurst(351,131,177,160,fileCrudoGrande); // Cargar crudoGra (177x160) en PAGE3 =>  x  =  <cociGra(131) + cociGra(177) + 1 = 351  ->   y = 131  
      
         putReloj1(); // Mostrar reloj1 en PAGE1 => borrar PAGE1
 
@@ -4069,7 +4612,7 @@ void loadPicturesShowHourglass()
     // -------------- COLOCAR ALIMENTO -------------------------------------------------------------------
       // scale
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(372,292,150,150,fileScale); // Cargar scaleG (150x150) en PAGE3 => x =  <manoY(251) + manoY(120) + 1 = 372   ->  y = 292
+      tft.sdCardDraw16bppBINBurst(372,292,150,150,fileScale); // Cargar scaleG (150x150) en PAGE3 => x =  <manoY(251) + manoY(120) + 1 = 372   ->  y = 292
 
         putReloj2(); // Mostrar reloj2 en PAGE1 
     // ----------- FIN COLOCAR ALIMENTO ------------------------------------------------------------------
@@ -4079,32 +4622,32 @@ void loadPicturesShowHourglass()
       // -------- GRUPOS  -------
       // grupo1
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Canvas inicia en PAGE3
-      tft.sdCardDraw16bppBIN256bits(0,0,130,125,fileGrupo1);     // Cargar grupo1 (130x125) en PAGE3  =>  x = 0   ->   y = 0 
+      tft.sdCardDraw16bppBINBurst(0,0,130,125,fileGrupo1);     // Cargar grupo1 (130x125) en PAGE3  =>  x = 0   ->   y = 0 
       
         putReloj3(); // Mostrar reloj3 en PAGE1 => borrar PAGE1
       
       // grupo2
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(131,0,130,125,fileGrupo2);   // Cargar grupo2 (130x125) en PAGE3  =>  x = <grupo1(0)   + grupo1(130) + 1 = 131   ->   y = 0 
+      tft.sdCardDraw16bppBINBurst(131,0,130,125,fileGrupo2);   // Cargar grupo2 (130x125) en PAGE3  =>  x = <grupo1(0)   + grupo1(130) + 1 = 131   ->   y = 0 
       
         putReloj4(); // Mostrar reloj4 en PAGE1
       
       // grupo3
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(262,0,130,125,fileGrupo3);   // Cargar grupo3 (130x125) en PAGE3  =>  x = <grupo2(131) + grupo2(130) + 1 = 262   ->   y = 0 
+      tft.sdCardDraw16bppBINBurst(262,0,130,125,fileGrupo3);   // Cargar grupo3 (130x125) en PAGE3  =>  x = <grupo2(131) + grupo2(130) + 1 = 262   ->   y = 0 
       
       putRelojGirado1(); // Mostrar relGir1 en PAGE1 
       
       // grupo4
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(393,0,130,125,fileGrupo4);   // Cargar grupo4 (130x125) en PAGE3  =>  x = <grupo3(262) + grupo3(130) + 1 = 393   ->   y = 0 
+      tft.sdCardDraw16bppBINBurst(393,0,130,125,fileGrupo4);   // Cargar grupo4 (130x125) en PAGE3  =>  x = <grupo3(262) + grupo3(130) + 1 = 393   ->   y = 0 
       
         putRelojGirado2(); // Mostrar relGir2 en PAGE1
 
       // mano con fondo verde ==> usada en grupos
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(524,0,120,128,fileManoGreenIcon);    // Cargar manoGppt (120x128) en PAGE3  =>  x  =  <manoG  =  <grupo4(393) + grupo4(130) + 1 = 524   ->   y = 0  
-      //tft.sdCardDraw16bppBIN256bits(524,0,120,129,fileManoGreen);    // Cargar manoG (120x129) en PAGE3  =>  x  =  <manoG  =  <grupo4(393) + grupo4(130) + 1 = 524   ->   y = 0  
+      tft.sdCardDraw16bppBINBurst(524,0,120,128,fileManoGreenIcon);    // Cargar manoGppt (120x128) en PAGE3  =>  x  =  <manoG  =  <grupo4(393) + grupo4(130) + 1 = 524   ->   y = 0  
+      //tft.sdCardDraw16bppBINBurst(524,0,120,129,fileManoGreen);    // Cargar manoG (120x129) en PAGE3  =>  x  =  <manoG  =  <grupo4(393) + grupo4(130) + 1 = 524   ->   y = 0  
 
         putRelojGirado3(); // Mostrar relGir3 en PAGE1
     // --------------- FIN ESCOGER GRUPO -----------------------------------------------------------------
@@ -4113,16 +4656,16 @@ void loadPicturesShowHourglass()
     // --------- ERROR / AVISO ---------------------------------------------------------------------------
       // error
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(0,292,114,127,fileCruz); // Cargar cruz (114x127) en PAGE3 =>  x  =  0  ->   y = <cociGra(131) + cociGra(160) + 1 = 292
+      tft.sdCardDraw16bppBINBurst(0,292,114,127,fileCruz); // Cargar cruz (114x127) en PAGE3 =>  x  =  0  ->   y = <cociGra(131) + cociGra(160) + 1 = 292
 
         putRelojGirado4(); // Mostrar relGir4 en PAGE1
 
       // aviso
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
       // Imagen aviso con fondo naranja oscuro
-      //tft.sdCardDraw16bppBIN256bits(115,292,135,113,fileAvisoDarkOrange); // Cargar avisoO (135x113) en PAGE3 =>  x  =  <cruz(0) + cruz(114) + 1 = 115  ->   y = 292
+      //tft.sdCardDraw16bppBINBurst(115,292,135,113,fileAvisoDarkOrange); // Cargar avisoO (135x113) en PAGE3 =>  x  =  <cruz(0) + cruz(114) + 1 = 115  ->   y = 292
       // Imagen aviso con fondo amarillo
-      tft.sdCardDraw16bppBIN256bits(115,292,135,113,fileAvisoYellow); // Cargar avisoY (135x113) en PAGE3 =>  x  =  <cruz(0) + cruz(114) + 1 = 115  ->   y = 292
+      tft.sdCardDraw16bppBINBurst(115,292,135,113,fileAvisoYellow); // Cargar avisoY (135x113) en PAGE3 =>  x  =  <cruz(0) + cruz(114) + 1 = 115  ->   y = 292
       
         putRelojGirado5(); // Mostrar relGir5 en PAGE1
 
@@ -4130,8 +4673,8 @@ void loadPicturesShowHourglass()
       //      La imagen de la mano no es blanco puro, por eso se puede filtrar el fondo blanco y que se siga viendo
       //      la mano. Así no aparecen los píxeles de color, como sí ocurre con los píxeles amarillos de manoY.
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(251,292,120,128,fileManoWhiteIcon);    // Cargar manoWppt (120x128) en PAGE3  =>  x  =  <avisoY(115) + avisoY(135) + 1 = 251   ->   y = 292
-      //tft.sdCardDraw16bppBIN256bits(251,292,120,129,fileManoYellow);    // Cargar manoY (120x129) en PAGE3  =>  x  =  <avisoY(115) + avisoY(135) + 1 = 251   ->   y = 292
+      tft.sdCardDraw16bppBINBurst(251,292,120,128,fileManoWhiteIcon);    // Cargar manoWppt (120x128) en PAGE3  =>  x  =  <avisoY(115) + avisoY(135) + 1 = 251   ->   y = 292
+      //tft.sdCardDraw16bppBINBurst(251,292,120,129,fileManoYellow);    // Cargar manoY (120x129) en PAGE3  =>  x  =  <avisoY(115) + avisoY(135) + 1 = 251   ->   y = 292
 
         putRelojGirado6(); // Mostrar relGir6 en PAGE1
 
@@ -4141,13 +4684,13 @@ void loadPicturesShowHourglass()
     // ----------------- PANTALLA INICIAL ----------------------------------------------------------------
       // brain1
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(0,170,120,108,fileBrain1);    // Cargar brain1 (120x108) en PAGE2 => x = 0 ->   y = <Log(0) + Log(169) + 1 = 170  
+      tft.sdCardDraw16bppBINBurst(0,170,120,108,fileBrain1);    // Cargar brain1 (120x108) en PAGE2 => x = 0 ->   y = <Log(0) + Log(169) + 1 = 170  
       
         putReloj1(); // Mostrar reloj1 en PAGE1 => borrar PAGE1
       
       // brain2G
       tft.canvasImageStartAddress(PAGE2_START_ADDR); // Regresar a PAGE2
-      tft.sdCardDraw16bppBIN256bits(121,170,120,108,fileBrain2Green);  // Cargar brain2G (120x108) en PAGE2 => x = <brain1(0)  + brain1(120) + 1 = 121  ->  y = 170  
+      tft.sdCardDraw16bppBINBurst(121,170,120,108,fileBrain2Green);  // Cargar brain2G (120x108) en PAGE2 => x = <brain1(0)  + brain1(120) + 1 = 121  ->  y = 170  
 
         putReloj2(); // Mostrar reloj2 en PAGE1 
     // ------------- FIN PANTALLA INICIAL ----------------------------------------------------------------
@@ -4156,19 +4699,19 @@ void loadPicturesShowHourglass()
     // ----------- GUARDAR COMIDA ------------------------------------------------------------------------
     // guardar (disquete)
     tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-    tft.sdCardDraw16bppBIN256bits(554,0,91,98,fileGuardando); // Cargar disquete (91x98) en PAGE4 =>  x  = <aviso_new(410)  + aviso_new(143) + 1 = 554  ->   y = 0
+    tft.sdCardDraw16bppBINBurst(554,0,91,98,fileGuardando); // Cargar disquete (91x98) en PAGE4 =>  x  = <aviso_new(410)  + aviso_new(143) + 1 = 554  ->   y = 0
 
     putReloj3(); // Mostrar reloj3 en PAGE1 
 
     // Hay conexión WiFi
     tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-    tft.sdCardDraw16bppBIN256bits(646,0,43,67,fileGuardandoWifi); // Cargar conexión (43x67) en PAGE4 =>  x  = <disquete(554) + disquete(91) + 1 = 646  ->   y = 0
+    tft.sdCardDraw16bppBINBurst(646,0,43,67,fileGuardandoWifi); // Cargar conexión (43x67) en PAGE4 =>  x  = <disquete(554) + disquete(91) + 1 = 646  ->   y = 0
 
     putReloj4(); // Mostrar reloj4 en PAGE1 
 
     // no conexión
     tft.canvasImageStartAddress(PAGE4_START_ADDR); // Regresar a PAGE4
-    tft.sdCardDraw16bppBIN256bits(689,0,54,85,fileGuardandoNoWifi); // Cargar no_conex (54x85) en PAGE4 =>  x  = <conexion(646) + conexion(42) + 1 = 689  ->   y = 0
+    tft.sdCardDraw16bppBINBurst(689,0,54,85,fileGuardandoNoWifi); // Cargar no_conex (54x85) en PAGE4 =>  x  = <conexion(646) + conexion(42) + 1 = 689  ->   y = 0
 
     putRelojGirado1(); // Mostrar relGir1 en PAGE1
 
@@ -4178,37 +4721,22 @@ void loadPicturesShowHourglass()
     // --------- DASHBOARD -------------------------------------------------------------------------------
       // cociPeq
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(529,131,47,42,fileCocinadoPeq); // Cargar cociPeq (47x42) en PAGE3 =>  x  =  <crudoGra(351) + crudoGra(177) + 1 = 529  ->   y = 131  
+      tft.sdCardDraw16bppBINBurst(529,131,47,42,fileCocinadoPeq); // Cargar cociPeq (47x42) en PAGE3 =>  x  =  <crudoGra(351) + crudoGra(177) + 1 = 529  ->   y = 131  
 
         putRelojGirado2(); // Mostrar relGir2 en PAGE1
 
       // crudoPeq
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(577,131,47,42,fileCrudoPeq); // Cargar crudoPeq (47x42) en PAGE3 =>  x  =  <cociPeq(529) + crudoGra(47) + 1 = 577  ->   y = 131  
+      tft.sdCardDraw16bppBINBurst(577,131,47,42,fileCrudoPeq); // Cargar crudoPeq (47x42) en PAGE3 =>  x  =  <cociPeq(529) + crudoGra(47) + 1 = 577  ->   y = 131  
 
         putRelojGirado3(); // Mostrar relGir3 en PAGE1
 
       // kcal
       tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.sdCardDraw16bppBIN256bits(529,174,60,65,fileKcal); // Cargar kcal (60x65) en PAGE3 =>  x = <crudoGra(351) + crudoGra(177) + 1 = 529   ->   y = <cociPeq(131) + cociPeq(42) + 1 = 174
+      tft.sdCardDraw16bppBINBurst(529,174,60,65,fileKcal); // Cargar kcal (60x65) en PAGE3 =>  x = <crudoGra(351) + crudoGra(177) + 1 = 529   ->   y = <cociPeq(131) + cociPeq(42) + 1 = 174
 
         putRelojGirado4(); // Mostrar relGir4 en PAGE1
-
-      // Recuadro azul utilizado para la transparencia de crudo/cocinado en dashboard. Tiene el mismo tamaño que esas imágenes.
-      tft.canvasImageStartAddress(PAGE3_START_ADDR); // Regresar a PAGE3
-      tft.fillRect(610,174,657,216,GRIS_CUADROS); // Cargar cuadro (47x42) en PAGE3 => x = <kcal(529) + kcal(80) + 1 = 610    ->  y = <kcal = 174
     // --------- FIN DASHBOARD ---------------------------------------------------------------------------
-
-
-
-
-    //---------------------------------------------------------------------------------------------------
-    // ----- REGRESAR A LA PÁGINA 1 ---------------------------------------------------------------------
-    // Regresamos la dirección de inicio del canvas a la PAGE1 para que lo que se escriba a partir de ahora se muestre en pantalla
-    tft.canvasImageStartAddress(PAGE1_START_ADDR); 
-    // ---------------------------------------------------------------------------------------------------
-    // ---------------------------------------------------------------------------------------------------
-
 }
 
 
@@ -4220,9 +4748,9 @@ void loadPicturesShowHourglass()
 ----------------------------------------------------------------------------------------------------------*/
 void putReloj1()
 { 
-  tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+  tft.canvasImageStartAddress(paginaDibujo); 
   tft.clearScreen(WHITE); 
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,0,279,PAGE1_START_ADDR,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj1 (260x410) en PAGE1 -> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,0,279,paginaDibujo,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj1 (260x410) en PAGE1 -> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4231,7 +4759,7 @@ void putReloj1()
 void putReloj2()
 { 
   // No necesita limpiar porque ocupa el mismo espacio que reloj1
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,66,279,PAGE1_START_ADDR,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj2 en PAGE1 --> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,66,279,paginaDibujo,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj2 en PAGE1 --> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4240,7 +4768,7 @@ void putReloj2()
 void putReloj3()
 {
   // No necesita limpiar porque ocupa el mismo espacio que reloj2
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,132,279,PAGE1_START_ADDR,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj3 en PAGE1 --> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,132,279,paginaDibujo,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj3 en PAGE1 --> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4249,7 +4777,7 @@ void putReloj3()
 void putReloj4()
 {
   // No necesita limpiar porque ocupa el mismo espacio que reloj3
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,198,279,PAGE1_START_ADDR,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj4 en PAGE1 --> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,198,279,paginaDibujo,SCREEN_WIDTH,480,249,65,103); // Mostrar reloj4 en PAGE1 --> x = 512 +/- 32 = 480     y = 300 +/- 51 = 249
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4258,7 +4786,7 @@ void putReloj4()
 void putRelojGirado1()
 {
   // No necesita limpiar porque ocupa más espacio que reloj4
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,264,279,PAGE1_START_ADDR,SCREEN_WIDTH,465,243,95,115); // Mostrar relGir1 en PAGE1 --> x = 512 +/- 47 = 465     y = 300 +/- 57 = 243
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,264,279,paginaDibujo,SCREEN_WIDTH,465,243,95,115); // Mostrar relGir1 en PAGE1 --> x = 512 +/- 47 = 465     y = 300 +/- 57 = 243
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4266,9 +4794,9 @@ void putRelojGirado1()
 ----------------------------------------------------------------------------------------------------------*/
 void putRelojGirado2()
 {
-  tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+  tft.canvasImageStartAddress(paginaDibujo); 
   tft.clearScreen(WHITE);
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,360,279,PAGE1_START_ADDR,SCREEN_WIDTH,456,244,112,112); // Mostrar relGir2 --> x = 512 +/- 56 = 456     y = 300 +/- 56 = 244
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,360,279,paginaDibujo,SCREEN_WIDTH,456,244,112,112); // Mostrar relGir2 --> x = 512 +/- 56 = 456     y = 300 +/- 56 = 244
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4276,9 +4804,9 @@ void putRelojGirado2()
 ----------------------------------------------------------------------------------------------------------*/
 void putRelojGirado3()
 {
-  tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+  tft.canvasImageStartAddress(paginaDibujo); 
   tft.clearScreen(WHITE);
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,473,279,PAGE1_START_ADDR,SCREEN_WIDTH,456,253,113,94); // Mostrar relGir3 en PAGE1 --> x = 512 +/- 56 = 456     y = 300 +/- 47 = 253
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,473,279,paginaDibujo,SCREEN_WIDTH,456,253,113,94); // Mostrar relGir3 en PAGE1 --> x = 512 +/- 56 = 456     y = 300 +/- 47 = 253
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4286,9 +4814,9 @@ void putRelojGirado3()
 ----------------------------------------------------------------------------------------------------------*/
 void putRelojGirado4()
 {
-  tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+  tft.canvasImageStartAddress(paginaDibujo); 
   tft.clearScreen(WHITE);
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,587,279,PAGE1_START_ADDR,SCREEN_WIDTH,462,268,100,65); // Mostrar relGir4 en PAGE1 --> x = 512 +/- 50 = 462     y = 300 +/- 32 = 268
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,587,279,paginaDibujo,SCREEN_WIDTH,462,268,100,65); // Mostrar relGir4 en PAGE1 --> x = 512 +/- 50 = 462     y = 300 +/- 32 = 268
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4296,9 +4824,9 @@ void putRelojGirado4()
 ----------------------------------------------------------------------------------------------------------*/
 void putRelojGirado5()
 {
-  tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+  tft.canvasImageStartAddress(paginaDibujo); 
   tft.clearScreen(WHITE);
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,688,279,PAGE1_START_ADDR,SCREEN_WIDTH,456,253,113,94); // Mostrar relGir5 en PAGE1 --> x = 512 +/- 56 = 456   ->  y = 300 +/- 47 = 253
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,688,279,paginaDibujo,SCREEN_WIDTH,456,253,113,94); // Mostrar relGir5 en PAGE1 --> x = 512 +/- 56 = 456   ->  y = 300 +/- 47 = 253
 }
 
 /*---------------------------------------------------------------------------------------------------------
@@ -4306,9 +4834,9 @@ void putRelojGirado5()
 ----------------------------------------------------------------------------------------------------------*/
 void putRelojGirado6()
 {
-  tft.canvasImageStartAddress(PAGE1_START_ADDR); 
+  tft.canvasImageStartAddress(paginaDibujo); 
   tft.clearScreen(WHITE);
-  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,802,279,PAGE1_START_ADDR,SCREEN_WIDTH,463,244,99,113); // Mostrar relGir6 en PAGE1 --> x = 512 +/- 49 = 463  ->  y = 300 +/- 56 = 244
+  tft.bteMemoryCopy(PAGE2_START_ADDR,SCREEN_WIDTH,802,279,paginaDibujo,SCREEN_WIDTH,463,244,99,113); // Mostrar relGir6 en PAGE1 --> x = 512 +/- 49 = 463  ->  y = 300 +/- 56 = 244
 }
 
 
@@ -127,6 +127,7 @@
 #include "Comida.h" // comidaActual
 #include "SD_functions.h"
 #include "debug.h" // SM_DEBUG --> Comunicación Serial con PC
+#include "Debug_Log.h" // LOG_SM()
 
 bool eventOccurred(); // Evento de interrupción en botoneras o báscula
 
@@ -405,17 +406,11 @@ bool processCharacter(String &tempBuffer, String &msgFromESP32)
         if (tempBuffer.length() > 0 && isValidESP32Message(tempBuffer))   // Verificar que el mensaje es uno de los posibles antes de asignarlo
         {
             msgFromESP32 = tempBuffer; // Asigna el contenido del buffer temporal al mensaje del ESP32
-            #if defined(SM_DEBUG)
-                SerialPC.print("\n---> Mensaje completo del ESP32: "); 
-                SerialPC.print("\"" + msgFromESP32); 
-                SerialPC.println("\"");
-            #endif
+            LOG_SM(LOG_ESP32_MENSAJE, msgFromESP32);
             tempBuffer = "";  // Resetea el buffer temporal
             return true;  // Mensaje completo procesado
         }
-        #if defined(SM_DEBUG)
-            SerialPC.println("Mensaje incompleto o no reconocido: " + tempBuffer);
-        #endif
+        LOG_SM(LOG_ESP32_NO_RECONOCIDO, tempBuffer);
         tempBuffer = "";  // Si estaba vacío o no era válido, se resetea el buffer
     } 
     else 
@@ -491,9 +486,7 @@ void waitResponseFromESP32(String &msgFromESP32, unsigned long &timeout)
     }
 
     // Si se alcanza el tiempo de espera sin recibir un mensaje
-    #if defined(SM_DEBUG)
-        SerialPC.println(F("\nTIMEOUT. No se ha recibido respuesta del ESP32"));
-    #endif
+    LOG_SM(LOG_ESP32_TIMEOUT);
 
     msgFromESP32 = "TIMEOUT";  // Marca el mensaje como TIMEOUT si no se recibió nada útil
 }
@@ -535,9 +528,7 @@ void waitResponseFromESP32WithEvents(String &msgFromESP32, unsigned long &timeou
 
         if(eventOccurred()) 
         {
-            #if defined(SM_DEBUG)
-                SerialPC.println(F("Interrupcion mientras se leia barcode"));
-            #endif
+            LOG_SM(LOG_ESP32_INTERRUPCION);
             msgFromESP32 = "INTERRUPTION"; // Señalar que se ha interrumpido
             return; // Salir de la función si se detecta interrupción (cancelación manual de la lectura)
         }
@@ -547,9 +538,7 @@ void waitResponseFromESP32WithEvents(String &msgFromESP32, unsigned long &timeou
 
 
     // Si se alcanza el tiempo de espera sin recibir un mensaje
-    #if defined(SM_DEBUG)
-        SerialPC.println(F("\nTIMEOUT. No se ha recibido respuesta del ESP32"));
-    #endif
+    LOG_SM(LOG_ESP32_TIMEOUT);
 
     msgFromESP32 = "TIMEOUT";  // Marca el mensaje como TIMEOUT si no se recibió nada útil
 
@@ -569,9 +558,7 @@ void waitResponseFromESP32WithEvents(String &msgFromESP32, unsigned long &timeou
 bool checkWifiConnection() 
 {
     // ---- PREGUNTAR POR WIFI ---------------------------------
-    #if defined(SM_DEBUG)
-        SerialPC.println(F("Comprobando la conexion WiFi del ESP32..."));
-    #endif
+    LOG_SM(LOG_WIFI_COMPROBANDO);
     
     sendMsgToESP32("CHECK-WIFI"); // Envía la cadena al ESP32
     // ---------------------------------------------------------
@@ -590,32 +577,24 @@ bool checkWifiConnection()
     // --- EXITO ------
     if (msgFromESP32 == "WIFI-OK") // Respuesta OK, hay conexión WiFi
     {
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("Dice que hay wifi"));
-        #endif
+        LOG_SM(LOG_WIFI_OK);
         return true;
     } 
     // -----------------
     // --- "ERRORES" ---
     else if (msgFromESP32 == "NO-WIFI") // Respuesta NO-WIFI, no hay conexión WiFi
     {
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("Dice que NO hay wifi"));
-        #endif
+        LOG_SM(LOG_WIFI_NO);
         return false;
     }
     else if (msgFromESP32 == "TIMEOUT") // No se ha recibido respuesta del ESP32
     {
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("TIMEOUT. Sin respuesta del ESP32 al comprobar la conexion WiFi"));
-        #endif
+        LOG_SM(LOG_WIFI_TIMEOUT);
         return false; // Se considera que no hay conexión WiFi
     }
     else // Mensaje desconocido
     {
-        #if defined(SM_DEBUG)
-            SerialPC.println(F("Error desconocido al comprobar la conexion WiFi..."));
-        #endif
+        LOG_SM(LOG_WIFI_DESCONOCIDO);
         return false; // Se considera que no hay conexión WiFi
     }
     // -----------------
@@ -641,9 +620,7 @@ bool checkWifiConnection()
 byte prepareSaving()
 {
     // ---- INDICAR ENVÍO DE DATOS -----------------------------
-    #if defined(SM_DEBUG)
-        SerialPC.println(F("\nIndicando que se quiere guardar..."));
-    #endif
+    LOG_SM(LOG_GUARDAR_INDICANDO);
     //SerialESP32.println(F("SAVE")); // Indicar al ESP32 que se le va a enviar información
     sendMsgToESP32("SAVE"); // Indicar al ESP32 que se le va a enviar información
     // ---------------------------------------------------------
@@ -664,39 +641,29 @@ byte prepareSaving()
     // --- EXITO ------
     if(msgFromESP32 == "WAITING-FOR-DATA") // El ESP32 queda a la espera de la info
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("El ESP32 esta esperando la info...\n"));
-        #endif
+        LOG_SM(LOG_GUARDAR_ESPERANDO);
         return WAITING_FOR_DATA; // ESP32 listo para recibir la info
     }
     // -----------------
     // --- ERRORES -----
     else if(msgFromESP32 == "NO-WIFI") // Se ha perdido la conexion WiFi
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("Se ha perdido la conexión WiFi...\n"));
-        #endif
+        LOG_SM(LOG_GUARDAR_NO_WIFI);
         return NO_INTERNET_CONNECTION; // No se puede enviar info al ESP32
     }
     else if(msgFromESP32.startsWith("HTTP-ERROR")) // Error HTTP al subir la info al ESP32
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("Error HTTP al autenticarse en la database...\n"));
-        #endif
+        LOG_SM(LOG_GUARDAR_HTTP_ERROR);
         return HTTP_ERROR; // No se puede enviar info al ESP32
     }
     else if(msgFromESP32 == "TIMEOUT") // No se recibió nada en 'timeout' segundos en waitResponseFromESP32()
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("TIMEOUT. Sin respuesta del ESP32 al indicar guardado\n"));
-        #endif
+        LOG_SM(LOG_GUARDAR_TIMEOUT);
         return TIMEOUT; // No se puede enviar info al ESP32
     }   
     else
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("Error desconocido al indicar que se quiere guardar...\n"));
-        #endif
+        LOG_SM(LOG_GUARDAR_DESCONOCIDO);
         return UNKNOWN_ERROR; // No se puede enviar info al ESP32
     }
     // -----------------
@@ -722,9 +689,7 @@ byte prepareSaving()
 byte askForBarcode(String &barcode)
 {
     // ---- PEDIR LEER BARCODE ---------------------------------
-    #ifdef SM_DEBUG
-        SerialPC.println(F("\nPidiendo escanear barcode..."));
-    #endif
+    LOG_SM(LOG_BARCODE_PIDIENDO);
     sendMsgToESP32("GET-BARCODE"); // Envía la cadena al ESP32
     // ---------------------------------------------------------
 
@@ -745,9 +710,7 @@ byte askForBarcode(String &barcode)
     // --- CANCELAR LECTURA ---
     if(msgFromESP32 == "INTERRUPTION") // Interrupción del usuario (pulsar botón para cancelar lectura)
     {
-        #ifdef SM_DEBUG
-            SerialPC.println(F("\nIndicando al ESP32 que cancele la lectura..."));
-        #endif
+        LOG_SM(LOG_BARCODE_CANCELANDO);
         
         // --- CANCELAR LECTURA ---
         sendMsgToESP32("CANCEL-BARCODE"); // Cancelar la lectura del barcode
@@ -759,32 +722,24 @@ byte askForBarcode(String &barcode)
     else if(msgFromESP32.startsWith("BARCODE:")) // "BARCODE:<barcode>"
     {
         barcode = msgFromESP32.substring(8);
-        #ifdef SM_DEBUG
-            SerialPC.println("\nCodigo de barras leido: " + barcode);
-        #endif
+        LOG_SM(LOG_BARCODE_LEIDO, barcode);
         return BARCODE_READ; // Se ha leído el código de barras
     }
     // -----------------
     // --- "ERRORES" ---
     else if(msgFromESP32 == "NO-BARCODE") 
     {
-        #ifdef SM_DEBUG
-            SerialPC.println(F("\nNo se ha podido leer el codigo de barras"));
-        #endif
+        LOG_SM(LOG_BARCODE_NO_LEIDO);
         return BARCODE_NOT_READ; // No se ha detectado el código de barras
     }
     else if(msgFromESP32 == "TIMEOUT") // No se recibió nada en 'timeout' segundos en waitResponseFromESP32WithEvents()
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("TIMEOUT. Sin respuesta del ESP32 al pedir leer barcode\n"));
-        #endif
+        LOG_SM(LOG_BARCODE_TIMEOUT);
         return TIMEOUT; // Se considera que no se ha detectado el código de barras
     }
     else // Mensaje desconocido
     {
-        #ifdef SM_DEBUG
-            SerialPC.println(F("\nMensaje o error desconocido al pedir leer barcode..."));
-        #endif
+        LOG_SM(LOG_BARCODE_DESCONOCIDO);
         return UNKNOWN_ERROR; // Se considera que no se ha detectado el código de barras
     }
     // -----------------
@@ -808,9 +763,7 @@ byte askForBarcode(String &barcode)
 byte getProductInfo(String &barcode, String &productInfo)
 {
     // ---- PEDIR BUSCAR PRODUCTO ------------------------------
-    #ifdef SM_DEBUG
-        SerialPC.println(F("\nPidiendo buscar producto..."));
-    #endif
+    LOG_SM(LOG_PRODUCTO_PIDIENDO);
     String msgToESP32 = "GET-PRODUCT:" + barcode; 
     sendMsgToESP32(msgToESP32); // Envía la cadena al ESP32
     // ---------------------------------------------------------
@@ -831,9 +784,7 @@ byte getProductInfo(String &barcode, String &productInfo)
     // --- EXITO ------
     if(msgFromESP32.startsWith("PRODUCT:")) // "PRODUCT:<barcode>;<nombreProducto>;<carb_1g>;<lip_1g>;<prot_1g>;<kcal_1g>"
     {
-        #ifdef SM_DEBUG
-            SerialPC.println("\nInformacion del producto: " + msgFromESP32);
-        #endif
+        LOG_SM(LOG_PRODUCTO_INFO, msgFromESP32);
         productInfo = msgFromESP32;
         return PRODUCT_FOUND;
     }
@@ -841,38 +792,27 @@ byte getProductInfo(String &barcode, String &productInfo)
     // --- ERRORES -----
     else if(msgFromESP32 == "NO-PRODUCT") 
     {
-        #ifdef SM_DEBUG
-            SerialPC.print("\nNo se ha encontrado el producto " + barcode); SerialPC.println(" en OpenFoodFacts");
-        #endif
+        LOG_SM(LOG_PRODUCTO_NO_ENCONTRADO, barcode);
         return PRODUCT_NOT_FOUND;
     }
     else if(msgFromESP32 == "PRODUCT-TIMEOUT") 
     {
-        #ifdef SM_DEBUG
-            SerialPC.println("\nEl servidor de OpenFoodFacts no responde");
-        #endif
+        LOG_SM(LOG_PRODUCTO_SIN_SERVIDOR);
         return PRODUCT_TIMEOUT;
     }
     else if(msgFromESP32.startsWith("HTTP-ERROR:")) 
     {
-        #ifdef SM_DEBUG
-            String error = msgFromESP32.substring(11);
-            SerialPC.println("Error al buscar info del producto (peticion HTTP GET): " + error);
-        #endif
+        LOG_SM(LOG_PRODUCTO_HTTP_ERROR, msgFromESP32.substring(11));
         return HTTP_ERROR;
     }
     else if(msgFromESP32 == "TIMEOUT") // No se recibió nada en 'timeout' segundos en waitResponseFromESP32WithEvents()
     {
-        #if defined SM_DEBUG
-            SerialPC.println(F("TIMEOUT. Sin respuesta del ESP32 al pedir buscar info de producto\n"));
-        #endif
+        LOG_SM(LOG_PRODUCTO_TIMEOUT);
         return TIMEOUT; // Se considera que no se ha encontrado el producto
     }
     else // Mensaje desconocido
     {
-        #ifdef SM_DEBUG
-            SerialPC.println("Mensaje no reconocido: " + msgFromESP32);
-        #endif
+        LOG_SM(LOG_PRODUCTO_DESCONOCIDO, msgFromESP32);
         return UNKNOWN_ERROR;
     }
     // -----------------
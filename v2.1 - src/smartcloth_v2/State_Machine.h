@@ -17,6 +17,7 @@
 
 
 #include "debug.h" // SM_DEBUG --> SerialPC
+#include "Debug_Log.h" // LOG_SM()
 
 /**
  * @def MAX_EVENTS
@@ -24,19 +25,6 @@
  */
 #define MAX_EVENTS 5
 
-/**
- * @def RULES
- * @brief Máximo número de reglas de transición.
- * 
- * @note Si este valor pasa de 255, hay que cambiar el tipo de dato de 'byte' a 'int' en la función checkStateConditions().
- */
-#ifdef BORRADO_INFO_USUARIO
-#define RULES 215
-#else
-#define RULES 201 
-#endif
-
-
 #include "SD_functions.h" // Incluye lista_Comida.h y Serial_functions.h
 #include "Buttons.h"
 
@@ -74,6 +62,7 @@
 #define  WARNING_PRODUCT_NOT_FOUND          6   // Aviso: producto no encontrado
 #define  WARNING_MEALS_LEFT                 7   // Aviso: algunas comidas no sincronizadas
 #define  WARNING_NO_INTERNET_NO_BARCODE     8   // Aviso: no se puede leer barcode porque no hay conexión a internet
+#define  WARNING_LISTA_LLENA                9   // Aviso: alimento no incluido porque la lista de la comida está llena
 
 
 // --- MENSAJE DE CANCELACIÓN ---
@@ -132,107 +121,7 @@ bool doneState;       // Flag para que solo se realicen una vez las actividades
                       // pero no en cada iteración del loop de Arduino.
 
 
-/*----------------------------------------------------------------------------------------------*/
-/*-------------------------------------- ESTADOS -----------------------------------------------*/
-/*----------------------------------------------------------------------------------------------*/
-/**
- * @enum state_t
- * @brief Enumeración de los diferentes estados de la Máquina de Estados.
- */
-typedef enum 
-{
-                STATE_Init              =   (1),    // Estado inicial para colocar plato                                        -->     Estado válido 
-                STATE_Plato             =   (2),    // Estado para escoger grupo                                                -->     Estado válido 
-                STATE_Grupo             =   (3),    // Grupo alimentos                                                          -->     Estado válido 
-                STATE_Barcode_read      =   (4),    // Estado para leer barcode                                                 -->     Estado transitorio
-                STATE_Barcode_search    =   (5),    // Estado para buscar información del producto                              -->     Estado transitorio
-                STATE_Barcode_check     =   (6),    // Estado para confirmar el producto encontrado                             -->     Estado transitorio
-                STATE_Barcode           =   (7),    // Estado para utilizar el producto encontrado como grupo de alimentos      -->     Estado válido 
-                STATE_raw               =   (8),    // Estado que indica alimento crudo                                         -->     Estado válido 
-                STATE_cooked            =   (9),    // Estado que indica alimento cocinado                                      -->     Estado válido 
-                STATE_weighted          =   (10),   // Estado para pesar alimento                                               -->     Estado válido 
-                STATE_add_check         =   (11),   // Estado para comprobar que se quiere añadir plato                         -->     Estado transitorio
-                STATE_added             =   (12),   // Estado para añadir plato                                                 -->     Estado transitorio
-                STATE_delete_check      =   (13),   // Estado para comprobar que se quiere eliminar plato                       -->     Estado transitorio
-                STATE_deleted           =   (14),   // Estado para eliminar plato                                               -->     Estado transitorio
-                STATE_save_check        =   (15),   // Estado para comprobar que se quiere guardar la comida                    -->     Estado transitorio
-                STATE_saved             =   (16),   // Estado para guardar la comida                                            -->     Estado transitorio
-                STATE_ERROR             =   (17),   // Estado ficticio de error (acción incorrecta)                             -->     Estado transitorio
-                STATE_CANCEL            =   (18),   // Estado ficticio de Cancelación                                           -->     Estado transitorio
-                STATE_AVISO             =   (19),   // Estado ficticio de Aviso                                                 -->     Estado transitorio
-
-                #ifdef BORRADO_INFO_USUARIO
-                STATE_DELETE_FILES_CHECK    =   (20),   // COMPROBAR QUE SE QUIERE BORRAR LOS FICHEROS. EL USUARIO NO DEBERÍA ACCEDER. SOLO PARA LAS PRUEBAS. -->     Estado transitorio
-                STATE_DELETED_FILES         =   (21),   // FICHEROS BORRADOS. EL USUARIO NO DEBERÍA ACCEDER. SOLO PARA LAS PRUEBAS.                          -->     Estado transitorio
-                                                      //  --> PARA LIMPIAR EL ACUMULADO DEL DÍA, DEJÁNDOLO LISTO PARA EL SIGUIENTE USUARIO
-                #endif
-
-                STATE_CRITIC_FAILURE_SD   =   (22),     // La SD ha fallado en el setup o no se encuentra --> no se permite usar SM                         -->     Estado transitorio
-                                                        // Este estado no tiene transiciones de entrada ni de salida. Solo sirve para mostrar
-                                                        // la pantalla de fallo crítico. Se entra manualmente por código, no por acciones del usuario.
-
-                STATE_UPLOAD_DATA = (23),       // Hay datos en el fichero data-esp.txt y hay que subirlos a la base de datos.                              -->     Estado transitorio
-                                                // Solo se pasaría a este estado al iniciar el dispositivo para guardar la info acumulada en el fichero.
-                                                // Se entra manualmente por código, no por acciones del usuario, por eso no tiene transiciones de entrada.
-                                                // Sí tiene una transición de salida a Init cuando se suben o no los datos.
-
-                STATE_REMOVAL_CHECK = (24)      // Estado para preguntar qué hacer con el plato retirado sin avisar: guardarlo en la comida para añadir otro o eliminarlo
-} state_t;
-
-
-
-/*----------------------------------------------------------------------------------------------*/
-/*-------------------------------------- EVENTOS -----------------------------------------------*/
-/*----------------------------------------------------------------------------------------------*/
-/**
- * @enum event_t
- * @brief Enumeración de los diferentes eventos que pueden ocurrir en la Máquina de Estados.
- */
-typedef enum 
-{
-              NONE                              =   (0),    
-              TIPO_A                            =   (1),    // Botonera Grande (7,8,9,16,17,18,19)
-              TIPO_B                            =   (2),    // Botonera Grande (1,2,3,4,5,6,10,11,12,13,14,15,20)
-              BARCODE                           =   (3),    // Botón Barcode
-              BARCODE_R                         =   (4),    // Barcode leído
-              BARCODE_F                         =   (5),    // Producto encontrado
-              CRUDO                             =   (6),    // AMARILLO
-              COCINADO                          =   (7),    // BLANCO
-              ADD_PLATO                         =   (8),    // VERDE
-              DELETE_PLATO                      =   (9),    // ROJO
-              GUARDAR                           =   (10),   // NEGRO 
-              INCREMENTO                        =   (11),   // Báscula
-              DECREMENTO                        =   (12),   // Báscula
-              TARAR                             =   (13),   // Báscula tarada
-              LIBERAR                           =   (14),   // Báscula vacía real
-              ERROR                             =   (15),   // Error (acción incorrecta)
-              CANCELAR                          =   (16),   // Cancelar acción de añadir, eliminar o guardar
-              AVISO_PLATO_EMPTY_NOT_ADDED       =   (17),   // Aviso de plato vacío, no añadido uno nuevo
-              AVISO_PLATO_EMPTY_NOT_DELETED     =   (18),   // Aviso de plato vacío, no borrado
-              AVISO_COMIDA_EMPTY_NOT_SAVED      =   (19),   // Aviso de comida vacía, no guardada
-              AVISO_NO_WIFI_BARCODE             =   (20),   // Aviso de que no hay conexión a Internet, así que no se podrá buscar el producto
-              AVISO_NO_BARCODE                  =   (21),   // Aviso de que no se ha detectado barcode
-              AVISO_PRODUCT_NOT_FOUND           =   (22),   // Aviso de que no se ha encontrado el producto en OpenFoodFacts
-              GO_TO_INIT                        =   (23),   // Evento ficticio para volver a STATE_Init porque saltó un error, aviso o se canceló una acción (añadir, eliminar o guardar)
-              GO_TO_PLATO                       =   (24),   // Evento ficticio para volver a STATE_Plato porque saltó un error 
-              GO_TO_GRUPO                       =   (25),   // Evento ficticio para volver a STATE_Grupo porque saltó un error o aviso
-              GO_TO_BARCODE_READ                =   (26),   // Evento ficticio para volver a STATE_Barcode_read porque saltó un error o aviso
-              GO_TO_BARCODE                     =   (27),   // Evento ficticio para volver a STATE_Barcode porque saltó un error o aviso
-              GO_TO_RAW                         =   (28),   // Evento ficticio para volver a STATE_raw porque saltó un error o se canceló una acción (añadir, eliminar o guardar)
-              GO_TO_COOKED                      =   (29),   // Evento ficticio para volver a STATE_cooked porque saltó un error o se canceló una acción (añadir, eliminar o guardar)
-              GO_TO_WEIGHTED                    =   (30),   // Evento ficticio para volver a STATE_weighted porque saltó un error o se canceló una acción (añadir, eliminar o guardar)
-              GO_TO_ADD_CHECK                   =   (31),   // Evento ficticio para volver a STATE_add_check porque saltó un error 
-              GO_TO_ADDED                       =   (32),   // Evento ficticio para volver a STATE_added porque saltó un error 
-              GO_TO_DELETE_CHECK                =   (33),   // Evento ficticio para volver a STATE_delete_check porque saltó un error 
-              GO_TO_DELETED                     =   (34),   // Evento ficticio para volver a STATE_deleted porque saltó un error
-              GO_TO_SAVE_CHECK                  =   (35),   // Evento ficticio para volver a STATE_save_check porque saltó un error 
-              GO_TO_SAVED                       =   (36),   // Evento ficticio para volver a STATE_saved porque saltó un error 
-              GO_TO_CANCEL                      =   (37),   // Evento ficticio para ir a STATE_CANCEL si se cancela una acción iniciada durante un error
-
-              #ifdef BORRADO_INFO_USUARIO
-              DELETE_FILES                        =   (38)   // EVENTO PARA BORRAR EL FICHERO CSV. EL USUARIO NO DEBERÍA LLEGAR A ACTIVARLO. SOLO PARA LAS PRUEBAS.
-              #endif
-} event_t;
+#include "State_Transitions.h" // Estados, eventos, reglas de transición y tabla de transiciones
 
 
 /**
@@ -241,344 +130,13 @@ typedef enum
 static event_t event_buffer[MAX_EVENTS];       // Buffer de eventos al que se irán añadiendo conforme ocurran
 /* Este buffer solo se utiliza para debuggear, para ver qué eventos han ido ocurriendo.
    Para comprobar si se cumple alguna regla de transición se utiliza 'lastEvent', que 
-   sería el último evento añadido al buffer.
+   es el evento sacado de 'colaEventosSM' que se está evaluando.
    
    Se podría eliminar el buffer para evitar ocupar memoria innecesariamente.
 */
 
 
 
-/*----------------------------------------------------------------------------------------------*/
-/*------------------------------ REGLAS TRANSICION ---------------------------------------------*/
-/*----------------------------------------------------------------------------------------------*/
-/**
- * @struct transition_rule
- * @brief Estructura que define una regla de transición en la Máquina de Estados.
- */
-typedef struct
-{
-    state_t state_i;     /**< Estado actual */
-    state_t state_j;     /**< Estado siguiente */
-    event_t condition;    /**< Condición para transición de estado */
-}transition_rule;
-
-
-/**
- * @brief Array de reglas de transición para la Máquina de Estados.
- */
-static transition_rule rules[RULES] =  
-{                                       // --- Esperando Recipiente ---
-                                        {STATE_Init,STATE_Init,TARAR},                  // Tara inicial
-                                        {STATE_Init,STATE_Init,DECREMENTO},             // Por si se inicia SM con un recipiente ya puesto y luego se retira
-                                        {STATE_Init,STATE_Init,LIBERAR},                // Por si se inicia SM con recipiente puesto, se retira y resulta que pesaba menos de 20 gramos (el umbral)
-                                        {STATE_Init,STATE_Plato,INCREMENTO},            // Colocar recipiente
-                                        {STATE_Init,STATE_save_check,GUARDAR},          // Guardar comida directamente (comidaActual no está vacía)
-                                        {STATE_Init,STATE_ERROR,ERROR},                 // Acción incorrecta
-                                        // ----------------------------
-
-                                        // --- Recipiente colocado ---
-                                        {STATE_Plato,STATE_Plato,INCREMENTO},           // Cambios por recolocar recipiente
-                                        {STATE_Plato,STATE_Plato,DECREMENTO},           // Cambios por recolocar recipiente
-                                        {STATE_Plato,STATE_Init,LIBERAR},               // Se ha retirado el recipiente
-                                        {STATE_Plato,STATE_Grupo,TIPO_A},               // Escogido grupo de alimentos de tipo A
-                                        {STATE_Plato,STATE_Grupo,TIPO_B},               // Escogido grupo de alimentos de tipo B
-                                        {STATE_Plato,STATE_Barcode_read,BARCODE},       // Pulsado botón de barcode para iniciar lectura
-                                        {STATE_Plato,STATE_Plato,TARAR},
-                                        {STATE_Plato,STATE_ERROR,ERROR},                // Acción incorrecta             
-                                        // ---------------------------
-                                        
-                                        // --- Grupo de alimentos ---
-                                        //{STATE_Grupo,STATE_Init,LIBERAR},              // Se ha retirado el plato completo (+ recipiente) ==> Automáticamente se borra el plato, sin preguntar
-                                        {STATE_Grupo,STATE_REMOVAL_CHECK,LIBERAR},     // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
-                                        {STATE_Grupo,STATE_Grupo,DECREMENTO},          // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
-                                        {STATE_Grupo,STATE_Grupo,TARAR},               // Tarar tras colocar recipiente o alimento   
-                                        {STATE_Grupo,STATE_Grupo,TIPO_A},              // Otro grupo de tipo A
-                                        {STATE_Grupo,STATE_Grupo,TIPO_B},              // Otro grupo de tipo B
-                                        {STATE_Grupo,STATE_Barcode_read,BARCODE},      // Pulsado botón de barcode para iniciar lectura
-                                        {STATE_Grupo,STATE_raw,CRUDO},                         
-                                        {STATE_Grupo,STATE_cooked,COCINADO},              
-                                        {STATE_Grupo,STATE_add_check,ADD_PLATO},       // Nuevo plato, aunque no se haya colocado alimento
-                                        {STATE_Grupo,STATE_delete_check,DELETE_PLATO}, // Borrar plato actual
-                                        {STATE_Grupo,STATE_save_check,GUARDAR},        // Guardar comida, aunque no se haya colocado alimento
-                                        {STATE_Grupo,STATE_ERROR,ERROR},               // Acción incorrecta
-                                        // --------------------------
-
-                                        // --- Leer Barcode ---------
-                                        //{STATE_Barcode_read,STATE_Init,LIBERAR},                // Se ha retirado el plato completo (+ recipiente) ==> Automáticamente se borra el plato, sin preguntar
-                                        {STATE_Barcode_read,STATE_REMOVAL_CHECK,LIBERAR},       // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
-                                        {STATE_Barcode_read,STATE_Barcode_read,DECREMENTO},     // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
-                                        {STATE_Barcode_read,STATE_Barcode_read,TARAR},          // Tarar tras colocar recipiente o alimento   
-                                        {STATE_Barcode_read,STATE_Barcode_search,BARCODE_R},    // Producto detectado y código leído
-                                        //{STATE_Barcode_read,STATE_AVISO,AVISO_NO_WIFI_BARCODE}, // Aviso de "No se puede leer barcode porque no hay conexión a Internet"
-                                        {STATE_Barcode_read,STATE_AVISO,AVISO_NO_BARCODE},      // Aviso de "Código no detectado" porque no se detecta o porque no responde el ESP32
-                                        {STATE_Barcode_read,STATE_CANCEL,TIPO_A},               // Cancelar lectura de barcode pulsando botón de grupo tipoA.
-                                        {STATE_Barcode_read,STATE_CANCEL,TIPO_B},               // Cancelar lectura de barcode pulsando botón de grupo tipoB.
-                                        {STATE_Barcode_read,STATE_CANCEL,BARCODE},              // Cancelar lectura de barcode pulsando botón de BARCODE
-                                        {STATE_Barcode_read,STATE_CANCEL,CRUDO},                // Cancelar lectura de barcode pulsando botón de CRUDO.
-                                        {STATE_Barcode_read,STATE_CANCEL,COCINADO},             // Cancelar lectura de barcode pulsando botón de COCINADO.
-                                        {STATE_Barcode_read,STATE_CANCEL,ADD_PLATO},            // Cancelar lectura de barcode pulsando botón de AÑADIR PLATO.
-                                        {STATE_Barcode_read,STATE_CANCEL,DELETE_PLATO},         // Cancelar lectura de barcode pulsando botón de BORRAR PLATO.
-                                        {STATE_Barcode_read,STATE_CANCEL,GUARDAR},              // Cancelar lectura de barcode pulsando botón de GUARDAR.
-                                                                                                // No se hace cancelación automática tras 30 segundos porque se asume simplemente que no se ha leído el barcode
-                                        {STATE_Barcode_read,STATE_Plato,GO_TO_PLATO},           // Regresar a STATE_Plato si fue lastValidState y no había conexión a Internet, por lo que no se pudo leer barcode.
-                                        {STATE_Barcode_read,STATE_Grupo,GO_TO_GRUPO},           // Regresar a STATE_Grupo si fue lastValidState y no había conexión a Internet, por lo que no se pudo leer barcode.
-                                        {STATE_Barcode_read,STATE_Barcode,GO_TO_BARCODE},       // Regresar a STATE_Barcode si fue lastValidState y no había conexión a Internet, por lo que no se pudo leer barcode.
-                                        {STATE_Barcode_read,STATE_ERROR,ERROR},                 // Acción incorrecta ????? El único error sería poner peso en báscula (Incremento), pero el usuario no debería hacerlo
-                                        // --------------------------
-
-                                        // --- Buscar Barcode --------
-                                        {STATE_Barcode_search,STATE_Barcode_check,BARCODE_F},       // Producto encontrado
-                                        {STATE_Barcode_search,STATE_AVISO,AVISO_PRODUCT_NOT_FOUND}, // Aviso de "Producto no encontrado"
-                                        {STATE_Barcode_search,STATE_AVISO,AVISO_NO_WIFI_BARCODE},   // Aviso de "No se puede buscar producto porque no hay conexión a Internet"
-                                        //{STATE_Barcode_search,STATE_CANCEL,CANCELAR},             // Cancelar búsqueda de producto por timeout del ESP32
-                                        {STATE_Barcode_search,STATE_Plato,GO_TO_PLATO},             // Regresar a STATE_Plato si fue lastValidState y no había conexión a Internet, por lo que no se pudo buscar el producto.
-                                        {STATE_Barcode_search,STATE_Grupo,GO_TO_GRUPO},             // Regresar a STATE_Grupo si fue lastValidState y no había conexión a Internet, por lo que no se pudo buscar el producto.
-                                        {STATE_Barcode_search,STATE_Barcode,GO_TO_BARCODE},         // Regresar a STATE_Barcode si fue lastValidState y no había conexión a Internet, por lo que no se pudo buscar el producto.
-                                        {STATE_Barcode_search,STATE_ERROR,ERROR},                   // Acción incorrecta ????? EL USUARIO NO DEBERÍA HACER NADA MIENTRAS SE BUSCA EL PRODUCTO
-                                        // --------------------------
-
-                                        // --- Confirmar producto ---
-                                        {STATE_Barcode_check,STATE_Barcode,BARCODE},            // Producto confirmado pulsado botón barcode
-                                        {STATE_Barcode_check,STATE_CANCEL,TIPO_A},              // Cancelar producto (no es el desado) pulsando botón de grupo tipoA.
-                                        {STATE_Barcode_check,STATE_CANCEL,TIPO_B},              // Cancelar producto (no es el desado) pulsando botón de grupo tipoB.
-                                        {STATE_Barcode_check,STATE_CANCEL,CRUDO},               // Cancelar producto (no es el desado) pulsando botón de CRUDO.
-                                        {STATE_Barcode_check,STATE_CANCEL,COCINADO},            // Cancelar producto (no es el desado) pulsando botón de COCINADO.
-                                        {STATE_Barcode_check,STATE_CANCEL,ADD_PLATO},           // Cancelar producto (no es el desado) pulsando botón de COCINADO.
-                                        {STATE_Barcode_check,STATE_CANCEL,DELETE_PLATO},        // Cancelar producto (no es el desado) pulsando botón de BORRAR PLATO.
-                                        {STATE_Barcode_check,STATE_CANCEL,GUARDAR},             // Cancelar producto (no es el desado) pulsando botón de GUARDAR.
-                                        {STATE_Barcode_check,STATE_CANCEL,CANCELAR},            // Cancelar producto tras 20 segundos de inactividad.
-                                        {STATE_Barcode_check,STATE_ERROR,ERROR},                // Acción incorrecta ????? Tocar la báscula (incremento, decremento o liberar) sería error, pero no debería ocurrir
-                                        // --------------------------
-
-                                        // --- Grupo Barcode --------
-                                        //{STATE_Barcode,STATE_Init,LIBERAR},                 // Se ha retirado el plato completo (+ recipiente) ==> Automáticamente se borra el plato, sin preguntar
-                                        {STATE_Barcode,STATE_REMOVAL_CHECK,LIBERAR},        // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
-                                        {STATE_Barcode,STATE_Barcode,DECREMENTO},           // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
-                                        {STATE_Barcode,STATE_Grupo,TIPO_A},                 // Cambiar grupo alimentos con TIPO_A
-                                        {STATE_Barcode,STATE_Grupo,TIPO_B},                 // Cambiar grupo alimentos con TIPO_B
-                                        {STATE_Barcode,STATE_Barcode_read,BARCODE},         // Leer otro barcode (vuelve a comenzar)
-                                        {STATE_Barcode,STATE_AVISO,CRUDO},                  // Aviso de "No hace falta crudo" porque el producto no necesita crudo
-                                        {STATE_Barcode,STATE_AVISO,COCINADO},               // Aviso de "No hace falta cocinado" porque el producto no necesita cocinado
-                                        {STATE_Barcode,STATE_weighted,INCREMENTO},          // Se ha colocado alimento del producto leído
-                                        {STATE_Barcode,STATE_add_check,ADD_PLATO},          // Nuevo plato, aunque no se haya colocado alimento
-                                        {STATE_Barcode,STATE_delete_check,DELETE_PLATO},    // Borrar plato actual
-                                        {STATE_Barcode,STATE_save_check,GUARDAR},           // Guardar comida, aunque no se haya colocado alimento
-                                        {STATE_Barcode,STATE_ERROR,ERROR},                  // Acción incorrecta ????? Parece que todas las posibles acciones del usuario están contempladas en las reglas de transición
-                                        // --------------------------
-
-                                        // --- Alimento crudo ---
-                                        //{STATE_raw,STATE_Init,LIBERAR},                 // Se ha retirado el plato completo (+ recipiente) ==> ¿Habría que borrar y empezar de nuevo?
-                                        {STATE_raw,STATE_REMOVAL_CHECK,LIBERAR},        // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
-                                        {STATE_raw,STATE_raw,DECREMENTO},               // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
-                                        {STATE_raw,STATE_raw,TARAR},                    // Tarar tras pesar alimento y querer cambiar procesamiento, por lo que se ha debido de guardar el alimento pesado antes de cambiar procesamiento
-                                        {STATE_raw,STATE_Grupo,TIPO_A},                 // Cambiar grupo alimentos
-                                        {STATE_raw,STATE_Grupo,TIPO_B},                 // Cambiar grupo alimentos
-                                        {STATE_raw,STATE_Barcode_read,BARCODE},         // Pulsado botón de barcode para iniciar lectura
-                                        {STATE_raw,STATE_raw,CRUDO},                    // Para que no dé error si se vuelve a pulsar 'crudo'.
-                                        {STATE_raw,STATE_cooked,COCINADO},              // Cambiar procesamiento (crudo => cocinado).
-                                        {STATE_raw,STATE_weighted,INCREMENTO},          // Se ha colocado alimento.
-                                        {STATE_raw,STATE_add_check,ADD_PLATO},          // Nuevo plato, aunque no se haya colocado alimento.
-                                        {STATE_raw,STATE_delete_check,DELETE_PLATO},    // Borrar plato actual. 
-                                        {STATE_raw,STATE_save_check,GUARDAR},           // Guardar comida, aunque no se haya colocado alimento.  
-                                        {STATE_raw,STATE_ERROR,ERROR},                  // Acción incorrecta
-                                        // -----------------------
-
-                                        // --- Alimento cocinado ---
-                                        //{STATE_cooked,STATE_Init,LIBERAR},              // Se ha retirado el plato completo (+ recipiente) ==> ¿Habría que borrar y empezar de nuevo?
-                                        {STATE_cooked,STATE_REMOVAL_CHECK,LIBERAR},     // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer  
-                                        {STATE_cooked,STATE_cooked,DECREMENTO},         // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
-                                        {STATE_cooked,STATE_cooked,TARAR},              // Tarar tras pesar alimento y querer cambiar procesamiento, por lo que se ha debido de guardar el alimento pesado antes de cambiar procesamiento
-                                        {STATE_cooked,STATE_Grupo,TIPO_A},              // Cambiar grupo alimentos
-                                        {STATE_cooked,STATE_Grupo,TIPO_B},              // Cambiar grupo alimentos
-                                        {STATE_cooked,STATE_Barcode_read,BARCODE},      // Pulsado botón de barcode para iniciar lectura
-                                        {STATE_cooked,STATE_cooked,COCINADO},           // Para que no dé error si se vuelve a pulsar 'cocinado'.
-                                        {STATE_cooked,STATE_raw,CRUDO},                 // Cambiar procesamiento (cocinado => crudo).
-                                        {STATE_cooked,STATE_weighted,INCREMENTO},       // Se ha colocado alimento.      
-                                        {STATE_cooked,STATE_add_check,ADD_PLATO},       // Nuevo plato, aunque no se haya colocado alimento.
-                                        {STATE_cooked,STATE_delete_check,DELETE_PLATO}, // Borrar plato actual. 
-                                        {STATE_cooked,STATE_save_check,GUARDAR},        // Guardar comida, aunque no se haya colocado alimento.   
-                                        {STATE_cooked,STATE_ERROR,ERROR},               // Acción incorrecta 
-                                        // --------------------------
-
-                                        // --- Alimento pesado ---
-                                        //{STATE_weighted,STATE_Init,LIBERAR},                // Se ha retirado el plato completo (+ recipiente) ==> ¿Habría que borrar y empezar de nuevo?
-                                        {STATE_weighted,STATE_REMOVAL_CHECK,LIBERAR},       // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
-                                        {STATE_weighted,STATE_weighted,INCREMENTO},         // Se coloca más alimento.  
-                                        {STATE_weighted,STATE_weighted,DECREMENTO},         // Se retira alimento.
-                                        {STATE_weighted,STATE_Grupo,TIPO_A},                // Escoger nuevo grupo. Se guardará en STATE_Grupo el peso del alimento en báscula.
-                                        {STATE_weighted,STATE_Grupo,TIPO_B},                // Escoger nuevo grupo. Se guardará en STATE_Grupo el peso del alimento en báscula.
-                                        {STATE_weighted,STATE_raw,CRUDO},                   // Cambiar procesamiento (pesado => crudo).
-                                        {STATE_weighted,STATE_cooked,COCINADO},             // Cambiar procesamiento (pesado => cocinado).
-                                        {STATE_weighted,STATE_Barcode_read,BARCODE},        // Pulsado botón de barcode para iniciar lectura. Se guardará en STATE_Barcode el peso del alimento en báscula.
-                                        {STATE_weighted,STATE_add_check,ADD_PLATO},         // Nuevo plato, aunque no se haya colocado alimento.
-                                        {STATE_weighted,STATE_delete_check,DELETE_PLATO},   // Borrar plato actual. 
-                                        {STATE_weighted,STATE_save_check,GUARDAR},          // Guardar comida, aunque no se haya colocado alimento. 
-                                        {STATE_weighted,STATE_ERROR,ERROR},                 // Acción incorrecta ????? Parece que todas las posibles acciones del usuario están contempladas en las reglas de transición
-                                        // -----------------------
-
-                                        // --- Check añadir plato ---
-                                        {STATE_add_check,STATE_added,ADD_PLATO},         // Confirmar añadir plato.
-                                        {STATE_add_check,STATE_CANCEL,TIPO_A},           // Cancelar añadir plato pulsando botón de grupo tipoA.
-                                        {STATE_add_check,STATE_CANCEL,TIPO_B},           // Cancelar añadir plato pulsando botón de grupo tipoB.
-                                        {STATE_add_check,STATE_CANCEL,BARCODE},          // Cancelar añadir plato pulsando botón de BARCODE.
-                                        {STATE_add_check,STATE_CANCEL,CRUDO},            // Cancelar añadir plato pulsando botón de CRUDO.
-                                        {STATE_add_check,STATE_CANCEL,COCINADO},         // Cancelar añadir plato pulsando botón de COCINADO.
-                                        {STATE_add_check,STATE_CANCEL,DELETE_PLATO},     // Cancelar añadir plato pulsando botón de BORRAR PLATO.
-                                        {STATE_add_check,STATE_CANCEL,GUARDAR},          // Cancelar añadir plato pulsando botón de GUARDAR.
-                                        {STATE_add_check,STATE_CANCEL,CANCELAR},         // Cancelar añadir plato tras 10 segundos de inactividad.
-                                        {STATE_add_check,STATE_ERROR,ERROR},             // Acción incorrecta (solo salta si se manipula la báscula).
-                                        // --------------------------
-
-                                        // --- Plato añadido ---
-                                        {STATE_added,STATE_added,TARAR},                        // Taramos para saber (en negativo) cuánto se va quitando al retirar el plato para LIBERAR.
-                                        {STATE_added,STATE_added,DECREMENTO},                   // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR).
-                                        {STATE_added,STATE_added,INCREMENTO},                   // Para evitar error de evento cuando, al retirar el plato, pueda detectar un ligero incremento.
-                                        {STATE_added,STATE_Init,LIBERAR},                       // Se ha retirado el plato completo (+ recipiente) tras añadir uno nuevo.
-                                        {STATE_added,STATE_ERROR,ERROR},                        // Acción incorrecta
-                                        {STATE_added,STATE_AVISO,AVISO_PLATO_EMPTY_NOT_ADDED},  // No se ha añadido un plato porque el actual está vacío
-                                        {STATE_added,STATE_Init,GO_TO_INIT},                    // Se regresa automáticamente a STATE_Init tras añadir el plato post STATE_REMOVAL_CHECK
-                                        // ---------------------
-
-                                        // --- Check eliminar plato ---
-                                        {STATE_delete_check,STATE_deleted,DELETE_PLATO},    // Confirmar eliminar plato.
-                                        {STATE_delete_check,STATE_CANCEL,TIPO_A},           // Cancelar eliminar plato pulsando botón de grupo tipoA.
-                                        {STATE_delete_check,STATE_CANCEL,TIPO_B},           // Cancelar eliminar plato pulsando botón de grupo tipoB.
-                                        {STATE_delete_check,STATE_CANCEL,BARCODE},          // Cancelar eliminar plato pulsando botón de BARCODE.
-                                        {STATE_delete_check,STATE_CANCEL,CRUDO},            // Cancelar eliminar plato pulsando botón de CRUDO.
-                                        {STATE_delete_check,STATE_CANCEL,COCINADO},         // Cancelar eliminar plato pulsando botón de COCINADO.
-                                        {STATE_delete_check,STATE_CANCEL,ADD_PLATO},        // Cancelar eliminar plato pulsando botón de AÑADIR PLATO.
-                                        {STATE_delete_check,STATE_CANCEL,GUARDAR},          // Cancelar eliminar plato pulsando botón de GUARDAR.
-                                        {STATE_delete_check,STATE_CANCEL,CANCELAR},         // Cancelar eliminar plato tras 10 segundos de inactividad.
-                                        {STATE_delete_check,STATE_ERROR,ERROR},             // Acción incorrecta (solo salta si se manipula la báscula).
-                                        // --------------------------
-
-                                        // --- Plato eliminado ---
-                                        {STATE_deleted,STATE_deleted,TARAR},                        // Taramos para saber (en negativo) cuánto se va quitando al retirar el plato para LIBERAR.
-                                        {STATE_deleted,STATE_deleted,DECREMENTO},                   // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR).
-                                        {STATE_deleted,STATE_deleted,INCREMENTO},                   // Para evitar error de evento cuando, al retirar el plato, pueda detectar un ligero incremento.
-                                        {STATE_deleted,STATE_Init,LIBERAR},                         // Se ha retirado el plato completo (+ recipiente) tras borrar. 
-                                        {STATE_deleted,STATE_ERROR,ERROR},                          // Acción incorrecta
-                                        {STATE_deleted,STATE_AVISO,AVISO_PLATO_EMPTY_NOT_DELETED},  // No se ha eliminado el plato porque está vacío
-                                        {STATE_deleted,STATE_Init,GO_TO_INIT},                      // Se regresa automáticamente a STATE_Init tras borrar el plato post STATE_REMOVAL_CHECK
-                                        // -----------------------
-
-                                        // --- Check guardar comida ---
-                                        {STATE_save_check,STATE_saved,GUARDAR},          // Confirmar guardar comida.
-                                        {STATE_save_check,STATE_CANCEL,TIPO_A},          // Cancelar guardar comida pulsando botón de grupo tipoA.
-                                        {STATE_save_check,STATE_CANCEL,TIPO_B},          // Cancelar guardar comida pulsando botón de grupo tipoB.
-                                        {STATE_save_check,STATE_CANCEL,BARCODE},         // Cancelar guardar comida pulsando botón de BARCODE.
-                                        {STATE_save_check,STATE_CANCEL,CRUDO},           // Cancelar guardar comida pulsando botón de CRUDO.
-                                        {STATE_save_check,STATE_CANCEL,COCINADO},        // Cancelar guardar comida pulsando botón de COCINADO.
-                                        {STATE_save_check,STATE_CANCEL,ADD_PLATO},       // Cancelar guardar comida pulsando botón de AÑADIR PLATO.
-                                        {STATE_save_check,STATE_CANCEL,DELETE_PLATO},    // Cancelar guardar comida pulsando botón de BORRAR PLATO.
-                                        {STATE_save_check,STATE_CANCEL,CANCELAR},        // Cancelar guardar comida tras 10 segundos de inactividad.
-                                        {STATE_save_check,STATE_ERROR,ERROR},            // Acción incorrecta (solo salta si se manipula la báscula).
-                                        // --------------------------
-
-                                        // --- Comida guardada ---
-                                        {STATE_saved,STATE_saved,TARAR},                        // Taramos para saber (en negativo) cuánto se va quitando al retirar el plato para LIBERAR.
-                                        {STATE_saved,STATE_saved,DECREMENTO},                   // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR).
-                                        {STATE_saved,STATE_saved,INCREMENTO},                   // Para evitar error de evento cuando, al retirar el plato, pueda detectar un ligero incremento.
-                                        {STATE_saved,STATE_Init,LIBERAR},                       // Se ha retirado el plato completo (+ recipiente) tras guardar correctamente.  
-                                        {STATE_saved,STATE_Init,GO_TO_INIT},                    // Se regresa automáticamente a STATE_Init tras guardar la comida
-                                        {STATE_saved,STATE_ERROR,ERROR},                        // Acción incorrecta
-                                        {STATE_saved,STATE_AVISO,AVISO_COMIDA_EMPTY_NOT_SAVED}, // No se ha guardado la comida porque está vacía
-                                        {STATE_saved, STATE_Init,GO_TO_INIT},                   // Se regresa automáticamente a STATE_Init tras guardar la comida post STATE_REMOVAL_CHECK
-                                        // -----------------------
-
-
-                                        // --- ERROR DE EVENTO ---
-                                        {STATE_ERROR,STATE_Init,GO_TO_INIT},                    // Regresar a STATE_Init tras mostrar error cometido allí o tras cometer error una vez retirado el plato sin avisar
-                                        {STATE_ERROR,STATE_Plato,GO_TO_PLATO},                  // Regresar a STATE_Plato tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_Grupo,GO_TO_GRUPO},                  // Regresar a STATE_Grupo tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_Barcode_read,GO_TO_BARCODE_READ},    // Regresar a STATE_Barcode_read tras mostrar error cometido allí o en STATE_Grupo pero se pulsa botón de barcode durante error
-                                        {STATE_ERROR,STATE_Barcode,GO_TO_BARCODE},              // Regresar a STATE_Barcode tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_raw,GO_TO_RAW},                      // Regresar a STATE_raw tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_cooked,GO_TO_COOKED},                // Regresar a STATE_cooked tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_weighted,GO_TO_WEIGHTED},            // Regresar a STATE_weighted tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_add_check,GO_TO_ADD_CHECK},          // Regresar a STATE_add_check tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_added,GO_TO_ADDED},                  // Regresar a STATE_added tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_delete_check,GO_TO_DELETE_CHECK},    // Regresar a STATE_delete_check tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_deleted,GO_TO_DELETED},              // Regresar a STATE_deleted tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_save_check,GO_TO_SAVE_CHECK},        // Regresar a STATE_save_check tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_saved,GO_TO_SAVED},                  // Regresar a STATE_saved tras mostrar error cometido allí
-                                        {STATE_ERROR,STATE_CANCEL,GO_TO_CANCEL},                // Ir a STATE_CANCEL si se ha cancelado un acción iniciada durante error
-                                        // -----------------------
-
-
-                                        // --- CANCELAR ----------
-                                        {STATE_CANCEL,STATE_Init,GO_TO_INIT},           // Regresar a STATE_Init tras cancelar acción de guardar iniciada desde STATE_Init
-                                        {STATE_CANCEL,STATE_Plato,GO_TO_PLATO},         // Regresar a STATE_Plato tras cancelar acción de leer barcode iniciada desde STATE_Plato
-                                        {STATE_CANCEL,STATE_Grupo,GO_TO_GRUPO},         // Regresar a STATE_Grupo tras cancelar add/delete/save o leer barcode iniciada desde STATE_Grupo
-                                        {STATE_CANCEL,STATE_Barcode,GO_TO_BARCODE},     // Regresar a STATE_Barcode tras cancelar add/delete/save o leer otro barcode iniciada desde STATE_Barcode
-                                        {STATE_CANCEL,STATE_raw,GO_TO_RAW},             // Regresar a STATE_raw tras cancelar add/delete/save o leer barcode iniciada desde STATE_raw   
-                                        {STATE_CANCEL,STATE_cooked,GO_TO_COOKED},       // Regresar a STATE_cooked tras cancelar add/delete/save o leer barcode iniciada desde STATE_cooked
-                                        {STATE_CANCEL,STATE_weighted,GO_TO_WEIGHTED},   // Regresar a STATE_weighted tras cancelar add/delete/save o leer barcode iniciada desde STATE_weighted
-                                        {STATE_CANCEL,STATE_ERROR,ERROR},               // Acción incorrecta. No suele ocurrir, pero si ocurre y no se gestiona, se quedaría 
-                                                                                        // en bucle marcando error.    
-                                        #ifdef BORRADO_INFO_USUARIO
-                                        {STATE_CANCEL,STATE_DELETE_FILES_CHECK,DELETE_FILES},  // INICIAR BORRADO DE FICHEROS USUARIO (se marca DELETE_FILES pulsando botón grupo 1 durante cancelación)
-                                        #endif
-                                        // -----------------------
-
-
-                                        // --- AVISO -------------
-                                        {STATE_AVISO,STATE_Init,GO_TO_INIT},            // Regresar a Init tras 3 segundos de warning
-                                        {STATE_AVISO,STATE_Plato,GO_TO_PLATO},          // Regresar a STATE_Plato tras 3 segundos de warning
-                                        {STATE_AVISO,STATE_Grupo,GO_TO_GRUPO},          // Regresar a STATE_Grupo tras 3 segundos de warning
-                                        {STATE_AVISO,STATE_Barcode,GO_TO_BARCODE},      // Regresar a GO_TO_BARCODE tras 3 segundos de warning por intentar marcar crudo/cocinado
-                                        {STATE_AVISO,STATE_ERROR,ERROR},                // Acción incorrecta durante aviso. Cualquier cosa es acción incorrecta. Igual que en Cancelar.
-                                        // -----------------------
-
-
-                                         // --- CHECK DELETE FILES ---
-                                         #ifdef BORRADO_INFO_USUARIO
-                                        {STATE_DELETE_FILES_CHECK,STATE_DELETED_FILES,DELETE_FILES},    // CONFIRMAR BORRAR FICHEROS DEL USUARIO (se marca DELETE_FILES pulsando botón grupo 20)
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,TIPO_A},               // Cancelar borrar ficheros del usuario pulsando botón de grupo tipoA.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,TIPO_B},               // Cancelar borrar ficheros del usuario pulsando botón de grupo tipoB (excepto grupo 20).
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,BARCODE},              // Cancelar borrar ficheros del usuario pulsando botón de BARCODE.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,CRUDO},                // Cancelar borrar ficheros del usuario pulsando botón de CRUDO.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,COCINADO},             // Cancelar borrar ficheros del usuario pulsando botón de COCINADO.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,ADD_PLATO},            // Cancelar borrar ficheros del usuario pulsando botón de AÑADIR PLATO.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,DELETE_PLATO},         // Cancelar borrar ficheros del usuario pulsando botón de BORRAR PLATO.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,GUARDAR},              // Cancelar borrar ficheros del usuario pulsando botón de GUARDAR.
-                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,CANCELAR},             // Cancelar automáticamente el borrar ficheros del usuario tras 5 segundos de inactividad.
-                                        // --------------------------
-
-                                        // --- FICHEROS BORRADOS ---
-                                        {STATE_DELETED_FILES,STATE_Init,GO_TO_INIT},         // Regresar a STATE_Init tras BORRAR FICHEROS USUARIO (siempre iniciado desde STATE_Init)
-                                        #endif // BORRADO_INFO_USUARIO
-                                        // ---------------------
-
-                                        // --- UPLOAD DATA TO DATABASE ---
-                                        {STATE_UPLOAD_DATA,STATE_Init,GO_TO_INIT},         // Regresar a STATE_Init tras subir o no la info acumulada
-                                        // ---------------------
-                                      
-                                      
-                                        // --- RETIRADA DE PLATO IMPREVISTA ---
-                                        // Indicar intención: En estos casos, nos saltamos el estado de confirmación (add_check, delete_check o save_check) porque se confirma al pulsar su botón
-                                        {STATE_REMOVAL_CHECK,STATE_added,ADD_PLATO},       // Al retirar plato sin avisar se quería "guardar" y añadir otro plato
-                                        {STATE_REMOVAL_CHECK,STATE_deleted,DELETE_PLATO},  // Al retirar plato sin avisar se quería borrar el plato retirado
-                                        {STATE_REMOVAL_CHECK,STATE_saved,GUARDAR},          // Al retirar plato sin avisar se quería guardar la comida (no suelen hacer esto)
-                                        // Borrado automático:
-                                        {STATE_REMOVAL_CHECK,STATE_Init,GO_TO_INIT},       // Regresar directamente a STATE_Init tras comprobar no había nada en la comida para "guardar" o eliminar 
-                                                                                           // Si pasan 30 segundos sin que indique nada, vamos a STATE_Init asumiendo que se quiere borrar, como antes
-                                        // Evitar error de evento si se toca la báscula una vez ya retirado el plato:
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,DECREMENTO},  // Por si se toca la báscula (que se supone que está vacía) en lugar de indicar la intención al retirar el plato
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,INCREMENTO},   // Por si se toca la báscula (que se supone que está vacía) en lugar de indicar la intención al retirar el plato
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,LIBERAR},     // Por si se toca la báscula (que se supone que está vacía) en lugar de indicar la intención al retirar el plato
-                                        // Evitar error de evento si algún iluminado pulsa otros botones en lugar de responder:
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,TIPO_A},      // Por si se pulsa un grupo de TIPO_A en lugar de indicar la intención al retirar el plato
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,TIPO_B},      // Por si se pulsa un grupo de TIPO_B en lugar de indicar la intención al retirar el plato
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,BARCODE},     // Por si se pulsa el botón de barcode en lugar de indicar la intención al retirar el plato
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,CRUDO},       // Por si se pulsa el botón de crudo en lugar de indicar la intención al retirar el plato
-                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,COCINADO}    // Por si se pulsa el botón de cocinado en lugar de indicar la intención al retirar el plato
-                                        // ------------------------------------
-                                      };
-
-
-
-
 
 /*----------------------------------------------------------------------------------------------*/
 /*------------------------------ VARIABLES ESTADOS/EVENTOS -------------------------------------*/
@@ -599,6 +157,11 @@ event_t eventoMain;         // Evento ocurrido en botonera Main
 event_t eventoGrande;       // Evento ocurrido en botonera grande
 event_t eventoBascula;      // Evento ocurrido en báscula
 
+colaEventos_t colaEventosSM;            // Eventos pendientes de evaluar, en el orden en que ocurrieron (Event_Queue.h).
+                                        // Los añaden las botoneras, la báscula y las actividades de los estados (GO_TO_...)
+                                        // y el loop los saca y evalúa todos en cada ciclo.
+unsigned long tiempoLastEvent = 0;      // millis() en que ocurrió 'lastEvent'
+
 bool    flagEvent               = false;    // Para evitar que marque evento para cada interrupción, ya que lo marcaría cada medio segundo
                                             // por la interrupción de la báscula.
                                             // Con esta flag solo se da aviso de un evento real (pulsación, incremento o decremento)
@@ -698,6 +261,9 @@ void    actState_REMOVAL_CHECK();                       // Actividades STATE_REM
 // --- Actividades estado actual ---
 void    doStateActions();                               // Actividades según estado actual
 
+// --- Lista de la comida llena ---
+void    rechazarAlimento();                             // El alimento pesado no cabe en la lista: no se incluye en la comida y su peso pasa al recipiente
+
 // --- Error de evento ---
 void    actEventError();                                // Mensaje de error de evento según el estado actual
 
@@ -706,7 +272,9 @@ bool    isBufferEmpty();                                 // Comprobar buffer de
 bool    isBufferFull();                                 // Comprobar buffer de eventos lleno
 byte    getFirstGapBuffer();                            // Obtener primer hueco en el buffer
 void    shiftLeftEventBuffer();                         // Desplazar buffer a izquierda para incluir nuevo evento
-void    addEventToBuffer(event_t evento);               // Añadir evento al buffer
+void    addEventToBuffer(event_t evento, unsigned long tiempo = millis());  // Añadir evento al buffer y a la cola de eventos
+void    addEventoExterno(event_t evento, unsigned long tiempo = millis());  // Añadir evento de botonera o báscula, cancelando la animación en curso
+bool    sacarEvento();                                  // Sacar el siguiente evento de la cola a 'lastEvent'
 /******************************************************************************/
 /******************************************************************************/
 
@@ -773,6 +341,7 @@ void printEventName(event_t event)
         case GO_TO_SAVE_CHECK:                  SerialPC.print(F("GO_TO_SAVE_CHECK"));                  break;
         case GO_TO_SAVED:                       SerialPC.print(F("GO_TO_SAVED"));                       break;
         case GO_TO_CANCEL:                      SerialPC.print(F("GO_TO_CANCEL"));                      break;
+        case AVISO_LISTA_LLENA:                 SerialPC.print(F("AVISO_LISTA_LLENA"));                 break;
 
         #ifdef BORRADO_INFO_USUARIO
         case DELETE_FILES:                        SerialPC.print(F("DELETE_FILES"));                        break;
@@ -840,31 +409,45 @@ void printStateName(state_t state)
 /** ---------------------------------------------------------------------------------------------------------
  * @brief checkStateConditions(): Verifica las condiciones de transición de estado en la máquina de estados
  * 
- * Esta función recorre un conjunto de reglas de transición para determinar si 
- * se cumple alguna regla que permita cambiar del estado actual a un nuevo estado.
+ * Esta función consulta en la tabla de transiciones (State_Transitions.h), generada al
+ * compilar a partir de las reglas, si hay alguna regla que permita cambiar del estado
+ * actual a un nuevo estado con el último evento.
  * 
  * @return true Si se cumple alguna regla de transición y se actualiza el estado.
  * @return false Si no se cumple ninguna regla de transición, indicando un error de evento.
- * 
- * @note Si el número de reglas (RULES) supera 255, se debe cambiar el tipo de dato 
- *       de la variable de iteración 'i' de byte a int.
  *
 ---------------------------------------------------------------------------------------------------------*/
 bool checkStateConditions()
 {
-    for (byte i = 0; i < RULES; i++) // Si hay más de 255 reglas, cambiar byte --> int        
-    {
-        if(rules[i].state_i == state_actual)
-        {
-            if(rules[i].condition == lastEvent)
-            {    
-                state_new = rules[i].state_j;     // Nuevo estado
-                doneState = false;                // Desactivar flag de haber hecho las actividades del estado
-                return true;                        
-            }
-        }
-    }
-    return false;   // Si no se ha cumplido ninguna regla de transición ==> ERROR DE EVENTO
+    byte siguiente = buscarTransicion(state_actual, lastEvent);
+    if(siguiente == SIN_TRANSICION) return false;   // Si no se ha cumplido ninguna regla de transición ==> ERROR DE EVENTO
+
+    state_new = (state_t)siguiente;     // Nuevo estado
+    doneState = false;                  // Desactivar flag de haber hecho las actividades del estado
+    cancelarAnimacion();                // La pantalla animada que quedara del estado anterior ya no corresponde
+    return true;
+}
+
+
+
+
+/*-------------------------------------------------------------------------------------------------------*/
+/*-------------------------------- LISTA DE LA COMIDA LLENA ---------------------------------------------*/
+/*-------------------------------------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------
+   rechazarAlimento(): Se llama cuando el alimento pesado no ha cabido en la lista de la comida (addAlimento() o
+                       addAlimentoBarcode() devuelven 'false'). No se incluye en el plato ni en la comida, para que
+                       lo mostrado y guardado coincida con lo que se envía al ESP32. El alimento sigue en la báscula,
+                       así que su peso se suma al del recipiente para que 'pesoARetirar' siga siendo correcto.
+----------------------------------------------------------------------------------------------------------*/
+void rechazarAlimento()
+{
+    #if defined(SM_DEBUG)
+        SerialPC.println(F("Lista de la comida llena. El alimento no se incluye en el plato..."));
+    #endif
+
+    pesoRecipiente += pesoBascula;   // Se retira junto con el recipiente, pero no cuenta en la comida
 }
 
 
@@ -1037,7 +620,7 @@ void actStateInit()
                 if (currentTime - previousTime >= dashboardInterval)  // Si el dashboard ha estado 10 segundos, se cambia a colocar recipiente
                 {
                     previousTime = currentTime;
-                    pedirRecipiente();
+                    iniciarAnimacion(pedirRecipiente);
                     showing_dash = false;  
                     showing_pedir_recipiente = true; 
                 }
@@ -1099,7 +682,7 @@ void actStatePlato()
                 // ----- INICIAR PLATO --------------------------------------
                 // Si lo último escrito no es INICIO-PLATO (la comida está vacía o se está empezando otro plato), 
                 // se añade a la lista "INICIO-PLATO"
-                listaComidaESP32.iniciarPlato();
+                listaComidaESP32.iniciarPlato();    // Si no cabe, tampoco cabrá el primer alimento: se rechazará y avisará al añadirlo
                 #if defined(SM_DEBUG)
                     listaComidaESP32.leerLista();
                 #endif 
@@ -1183,7 +766,7 @@ void actStatePlato()
             if (currentTime - previousTime >= dashboardInterval)  // Si el dashboard ha estado 10 segundos, se cambia a escoger grupo
             {
                 previousTime = currentTime;
-                pedirGrupoAlimentos();
+                iniciarAnimacion(pedirGrupoAlimentos);
                 showing_dash = false;  
                 showing_escoger_grupo = true; // Mostrando escoger grupo
             }
@@ -1241,13 +824,14 @@ void actGruposAlimentos()
             else if (pesoBascula != 0.0)
             {
                     // ----- AÑADIR ALIMENTO A LISTA -----------------------------
-                    if(grupoAnterior.ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
+                    bool alimentoEnLista;   // Falso si no cabe en la lista de la comida
+                    if(grupoAnterior->ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
                     {                                 // siendo <grupo> el ID de 'grupoAnterior' y <peso> el valor de 'pesoBascula'.
-                        listaComidaESP32.addAlimento(grupoAnterior.ID_grupo, pesoBascula);
+                        alimentoEnLista = listaComidaESP32.addAlimento(grupoAnterior->ID_grupo, pesoBascula);
                     }
                     else  // Si el grupo anterior es un barcode (grupo 50), se escribe ALIMENTO,<grupo>,<peso>,<ean>
                     {
-                        listaComidaESP32.addAlimentoBarcode(grupoAnterior.ID_grupo, pesoBascula, barcode);
+                        alimentoEnLista = listaComidaESP32.addAlimentoBarcode(grupoAnterior->ID_grupo, pesoBascula, barcode);
                     }
 
                     #if defined(SM_DEBUG)
@@ -1260,15 +844,24 @@ void actGruposAlimentos()
                         SerialPC.println(F("Añadiendo alimento al plato..."));
                     #endif
 
-                    Alimento alimento(grupoAnterior, pesoBascula);              // Cálculo automático de valores nutricionales.
-                                                                                // Al escoger un nuevo grupo se guarda el alimento del grupo anterior
-                                                                                // colocado en la báscula en la iteración anterior. Por eso se utiliza 'grupoAnterior' para
-                                                                                // crear el alimento, porque 'grupoActual' ya ha tomado el valor del nuevo grupo al pulsar el nuevo botón.
-                                                                                // Si el 'grupoAnterior' hubiera sido un barcode, se habrían modificado los valores nutricionales 
-                                                                                // del grupo en State_Barcode, por lo que se habrían guardado en 'grupoAnterior' y se usarían aquí.
+                    if(alimentoEnLista)
+                    {
+                        Alimento alimento(grupoAnterior, pesoBascula);              // Cálculo automático de valores nutricionales.
+                                                                                    // Al escoger un nuevo grupo se guarda el alimento del grupo anterior
+                                                                                    // colocado en la báscula en la iteración anterior. Por eso se utiliza 'grupoAnterior' para
+                                                                                    // crear el alimento, porque 'grupoActual' ya ha tomado el valor del nuevo grupo al pulsar el nuevo botón.
+                                                                                    // Si el 'grupoAnterior' hubiera sido un barcode, se habrían modificado los valores nutricionales 
+                                                                                    // del grupo en State_Barcode, por lo que se habrían guardado en 'grupoAnterior' y se usarían aquí.
                                                                 
-                    platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
-                    comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+                        platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
+                        comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+                    }
+                    else    // No cabe en la lista: tampoco en el plato ni en la comida. Se avisa de que hay que guardar la comida
+                    {
+                        rechazarAlimento();
+                        addEventToBuffer(AVISO_LISTA_LLENA);                   // Se transiciona al STATE_AVISO, que regresa a STATE_Plato
+                        flagEvent = true;
+                    }
 
                     pesoPlato = platoActual.getPesoPlato();                     // Se actualiza el 'pesoPlato' para sumarlo a 'pesoRecipiente' y saber el 'pesoARetirar'.
 
@@ -1281,8 +874,8 @@ void actGruposAlimentos()
 
             // ----- INFO PANTALLA -------------------------
             // Si es la primera vez que se escoge grupo (no se viene de STATE_Grupo), se forma medio Dashboard (ejemplos, parpadeo zona 2 y pedir cr/co)  
-            if(showSemiDashboard_PedirProcesamiento()) return;  // Mostrar semi dashboard completo al inicio
-                                                                // Si ocurre alguna interrupción mientras se forma el semi dashboard, se sale de la función.
+            showSemiDashboard_PedirProcesamiento();             // Mostrar semi dashboard completo al inicio
+                                                                // Las zonas 3 y 4 se terminan de formar en continuarAnimacion() (TAREA_ANIMACION)
             // ----- FIN INFO DE PANTALLA ------------------
 
 
@@ -1322,8 +915,8 @@ void actGruposAlimentos()
     //
     // ----- PANTALLAS CON MOVIMIENTO -------------------------
     blinkGrupoyProcesamiento(NO_MSG);               // Zona 2 - Parpadea (procesamiento sin escoger)
-    if(alternateButtonsProcesamiento()) return;     // Zonas 3 y 4 - Alternar botones de crudo y cocinado. Las formas, colores y texto ya están (formGraphicsPedirProcesamiento())
-                                                    // Si hay interrupción mientras se alternan botones, se sale de la función --> en loop() se chequea la interrupción.
+    alternateButtonsProcesamiento();                // Zonas 3 y 4 - Alternar botones de crudo y cocinado. Las formas, colores y texto ya están (formGraphicsPedirProcesamiento())
+                                                    // Cada alternancia es una animación que continúa en continuarAnimacion() (TAREA_ANIMACION).
     // --------------------------------------------------------
 
 
@@ -1339,6 +932,8 @@ void actStateBarcodeRead()
 {
     if(!doneState)
     {
+        bool avisoListaLlena = false;   // El alimento pesado antes no ha cabido en la lista de la comida
+
         //if(state_prev != STATE_Barcode_read)    // ==> Si no se viene del propio STATE_Barcode_read, para evitar que se vuelva a iniciar el proceso de lectura.
         //{                                       // Se vendría de STATE_Barcode_read si al retirar el plato se detectara DECREMENTO antes de LIBERAR,
                                                 // que ya llevaría a STATE_Init
@@ -1372,13 +967,14 @@ void actStateBarcodeRead()
                     // el producto no se actualiza el 'grupoActual', por lo que el alimento pesado antes se puede guardar con 'grupoActual', pues sigue siendo válido.
                     
                     // Usamos 'grupoActual' porque aún no se ha actualizado
-                    if(grupoActual.ID_grupo != BARCODE_PRODUCT_INDEX) // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
+                    bool alimentoEnLista;   // Falso si no cabe en la lista de la comida
+                    if(grupoActual->ID_grupo != BARCODE_PRODUCT_INDEX) // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
                     {                                                 // siendo <grupo> el ID de 'grupoActual' y <peso> el valor de 'pesoBascula'.
-                        listaComidaESP32.addAlimento(grupoActual.ID_grupo, pesoBascula);
+                        alimentoEnLista = listaComidaESP32.addAlimento(grupoActual->ID_grupo, pesoBascula);
                     }
                     else  // Si el grupo anterior es un barcode (grupo 50), se escribe ALIMENTO,<grupo>,<peso>,<ean>
                     {
-                        listaComidaESP32.addAlimentoBarcode(grupoActual.ID_grupo, pesoBascula, barcode);
+                        alimentoEnLista = listaComidaESP32.addAlimentoBarcode(grupoActual->ID_grupo, pesoBascula, barcode);
                     }
 
                     #if defined(SM_DEBUG)
@@ -1391,11 +987,21 @@ void actStateBarcodeRead()
                         SerialPC.println(F("Añadiendo alimento al plato..."));
                     #endif
 
-                    Alimento alimento(grupoActual, pesoBascula);              // Cálculo automático de valores nutricionales.
-                                                                            // Usamos 'grupoActual' porque aún no se ha actualizado
+                    if(alimentoEnLista)
+                    {
+                        Alimento alimento(grupoActual, pesoBascula);              // Cálculo automático de valores nutricionales.
+                                                                                // Usamos 'grupoActual' porque aún no se ha actualizado
                                                                 
-                    platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
-                    comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+                        platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
+                        comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+                    }
+                    else    // No cabe en la lista: tampoco en el plato ni en la comida. Se avisa de que hay que guardar la comida
+                    {
+                        rechazarAlimento();
+                        addEventToBuffer(AVISO_LISTA_LLENA);                   // Se transiciona al STATE_AVISO, que regresa a STATE_Plato
+                        flagEvent = true;
+                        avisoListaLlena = true;                                 // No se lee otro barcode
+                    }
 
                     pesoPlato = platoActual.getPesoPlato();                     // Se actualiza el 'pesoPlato' para sumarlo a 'pesoRecipiente' y saber el 'pesoARetirar'.
 
@@ -1408,55 +1014,58 @@ void actStateBarcodeRead()
 
 
 
-            // ----- ACCIONES PRINCIPALES Y PANTALLAS -----------------
-            // ----- INFO DE PANTALLA -------------------------
-            showScanningBarcode();                                   // Mostrar "Escaneando código de barras..."
-            // ----- FIN INFO DE PANTALLA ---------------------
+            if(!avisoListaLlena)   // Si el alimento anterior no ha cabido en la lista, se pasa al aviso sin leer otro barcode
+            {
+                // ----- ACCIONES PRINCIPALES Y PANTALLAS -----------------
+                // ----- INFO DE PANTALLA -------------------------
+                showScanningBarcode();                                   // Mostrar "Escaneando código de barras..."
+                // ----- FIN INFO DE PANTALLA ---------------------
 
-            // ----- LEER BARCODE -----------------------------
-            byte resultFromReadingBarcode = askForBarcode(barcode);  // Pedir código de barras. Se va a quedar aquí hasta 10.5 segundos esperando respuesta del ESP32.
+                // ----- LEER BARCODE -----------------------------
+                byte resultFromReadingBarcode = askForBarcode(barcode);  // Pedir código de barras. Se va a quedar aquí hasta 10.5 segundos esperando respuesta del ESP32.
 
-            switch(resultFromReadingBarcode)
-            {
-                // --- BARCODE LEÍDO -----------
-                case BARCODE_READ: // Si se ha leído el barcode, pasar a STATE_Barcode_search (evento BARCODE_R) para buscar su información
-                                    #if defined(SM_DEBUG)
-                                        SerialPC.println(F("\nBarcode leido. Pasando a STATE_Barcode_search..."));
-                                    #endif
-                                    addEventToBuffer(BARCODE_R);    break; 
-                // -----------------------------
+                switch(resultFromReadingBarcode)
+                {
+                    // --- BARCODE LEÍDO -----------
+                    case BARCODE_READ: // Si se ha leído el barcode, pasar a STATE_Barcode_search (evento BARCODE_R) para buscar su información
+                                        #if defined(SM_DEBUG)
+                                            SerialPC.println(F("\nBarcode leido. Pasando a STATE_Barcode_search..."));
+                                        #endif
+                                        addEventToBuffer(BARCODE_R);    break; 
+                    // -----------------------------
 
-                // -- AVISO: BARCODE NO LEÍDO --
-                case BARCODE_NOT_READ: // Si no se ha leído el barcode, STATE_AVISO para mostrar el mensaje "Código de barras no detectado"
-                                    #if defined(SM_DEBUG)
-                                        SerialPC.println(F("\nNo se ha detectado un barcode. Pasando a STATE_AVISO..."));
-                                    #endif
-                                    addEventToBuffer(AVISO_NO_BARCODE);        break;
-                // -----------------------------
+                    // -- AVISO: BARCODE NO LEÍDO --
+                    case BARCODE_NOT_READ: // Si no se ha leído el barcode, STATE_AVISO para mostrar el mensaje "Código de barras no detectado"
+                                        #if defined(SM_DEBUG)
+                                            SerialPC.println(F("\nNo se ha detectado un barcode. Pasando a STATE_AVISO..."));
+                                        #endif
+                                        addEventToBuffer(AVISO_NO_BARCODE);        break;
+                    // -----------------------------
 
-                // -- INTERRUPCIÓN (CANCELAR) --
-                case INTERRUPTION: // Cancelación de la lectura del barcode por parte del usuario
-                                    #if defined(SM_DEBUG)
-                                        SerialPC.println(F("\nInterrupción. Cancelando lectura de barcode..."));
-                                    #endif
-                                    // En las reglas de transición ya se pasa a STATE_CANCEL al detectar algún evento de usuario (botoneras) en este estado
-                                    // No hace falta marcar aquí el evento manualmente.
-                                                                    break;
-                // ----------------------------
+                    // -- INTERRUPCIÓN (CANCELAR) --
+                    case INTERRUPTION: // Cancelación de la lectura del barcode por parte del usuario
+                                        #if defined(SM_DEBUG)
+                                            SerialPC.println(F("\nInterrupción. Cancelando lectura de barcode..."));
+                                        #endif
+                                        // En las reglas de transición ya se pasa a STATE_CANCEL al detectar algún evento de usuario (botoneras) en este estado
+                                        // No hace falta marcar aquí el evento manualmente.
+                                                                        break;
+                    // ----------------------------
 
-                // -- TIMEOUT O DESCONOCIDO ---
-                default: // TIMEOUT o UNKNOWN_ERROR
-                                    #if defined(SM_DEBUG)
-                                        SerialPC.println(F("\nTimeout o Desconocido, asumimos barcode no leido. Pasando a STATE_AVISO..."));
-                                    #endif
-                                    addEventToBuffer(AVISO_NO_BARCODE);        break;
-                // ----------------------------
-            }
+                    // -- TIMEOUT O DESCONOCIDO ---
+                    default: // TIMEOUT o UNKNOWN_ERROR
+                                        #if defined(SM_DEBUG)
+                                            SerialPC.println(F("\nTimeout o Desconocido, asumimos barcode no leido. Pasando a STATE_AVISO..."));
+                                        #endif
+                                        addEventToBuffer(AVISO_NO_BARCODE);        break;
+                    // ----------------------------
+                }
 
-            flagEvent = true; // Marcar flag de evento para que se compruebe en loop() y se realice la transición
+                flagEvent = true; // Marcar flag de evento para que se compruebe en loop() y se realice la transición
             
-            // ----- FIN LEER BARCODE -------------------------
-            // --------------------------------------------------------
+                // ----- FIN LEER BARCODE -------------------------
+                // --------------------------------------------------------
+            }
 
 
         //} // FIN if(state_prev != STATE_Barcode_read)
@@ -1682,7 +1291,7 @@ void actStateBarcode()
         if (currentTime - previousTime >= dashboardInterval)  // Si el dashboard ha estado 10 segundos, se cambia a pedir alimento
         {
             previousTime = currentTime;
-            pedirAlimento();
+            iniciarAnimacion(pedirAlimento);
             showing_dash = false;  
             showing_colocar_alimento = true;   // Mostrando pedir alimento
         }
@@ -1730,13 +1339,14 @@ void actStateRaw()
             // Al pulsar el botón de CRUDO se han actualiza 'grupoActual' y 'grupoAnterior', pero aún no se ha guardado el alimento pesado, por lo que se guarda 
             // con 'grupoAnterior' porque representa al grupo del alimento pesado, que aunque fuera del mismo grupo oficial, se ha pesado antes de cambiar el procesamiento.
             // ----- AÑADIR ALIMENTO A LISTA -----------------------------
-            if(grupoAnterior.ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
+            bool alimentoEnLista;   // Falso si no cabe en la lista de la comida
+            if(grupoAnterior->ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
             {                                                  //   siendo <grupo> el ID de 'grupoActual' y <peso> el valor de 'pesoBascula'.
-                listaComidaESP32.addAlimento(grupoAnterior.ID_grupo, pesoBascula);
+                alimentoEnLista = listaComidaESP32.addAlimento(grupoAnterior->ID_grupo, pesoBascula);
             }
             else  // Si el grupo anterior es un barcode (grupo 50), se escribe ALIMENTO,<grupo>,<peso>,<ean>
             {
-                listaComidaESP32.addAlimentoBarcode(grupoAnterior.ID_grupo, pesoBascula, barcode);
+                alimentoEnLista = listaComidaESP32.addAlimentoBarcode(grupoAnterior->ID_grupo, pesoBascula, barcode);
             }
 
             #if defined(SM_DEBUG)
@@ -1749,10 +1359,19 @@ void actStateRaw()
                 SerialPC.println(F("Añadiendo alimento al plato..."));
             #endif
 
-            Alimento alimento(grupoAnterior, pesoBascula);              // Cálculo automático de valores nutricionales.
+            if(alimentoEnLista)
+            {
+                Alimento alimento(grupoAnterior, pesoBascula);              // Cálculo automático de valores nutricionales.
                                                             
-            platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
-            comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+                platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
+                comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+            }
+            else    // No cabe en la lista: tampoco en el plato ni en la comida. Se avisa de que hay que guardar la comida
+            {
+                rechazarAlimento();
+                addEventToBuffer(AVISO_LISTA_LLENA);                   // Se transiciona al STATE_AVISO, que regresa a STATE_Plato
+                flagEvent = true;
+            }
 
             pesoPlato = platoActual.getPesoPlato();                     // Se actualiza el 'pesoPlato' para sumarlo a 'pesoRecipiente' y saber el 'pesoARetirar'.
 
@@ -1809,10 +1428,17 @@ void actStateRaw()
     currentTime = millis();
     if(showing_dash) // Se está mostrando dashboard estilo 2 (Alimento | Comida)
     {
+        if(refrescarPesoProvisional) // Se está colocando el alimento: mostrar el peso provisional antes del INCREMENTO
+        {                            // (o volver a 0 si el provisional se ha descartado)
+            printZona3(SHOW_ALIMENTO_ACTUAL_ZONA3); // Zona 3 - Valores alimento actual con el peso provisional
+            printZona4(SHOW_COMIDA_ACTUAL_ZONA4);   // Zona 4 - Valores Comida actual con el peso provisional
+            refrescarPesoProvisional = false;
+        }
+
         if (currentTime - previousTime >= dashboardInterval)  // Si el dashboard ha estado 10 segundos, se cambia a pedir alimento
         {
             previousTime = currentTime;
-            pedirAlimento();
+            iniciarAnimacion(pedirAlimento);
             showing_dash = false;  
             showing_colocar_alimento = true;   // Mostrando pedir alimento
         }
@@ -1859,13 +1485,14 @@ void actStateCooked()
             // Al pulsar el botón de COCINADO se han actualiza 'grupoActual' y 'grupoAnterior', pero aún no se ha guardado el alimento pesado, por lo que se guarda 
             // con 'grupoAnterior' porque representa al grupo del alimento pesado, que aunque fuera del mismo grupo oficial, se ha pesado antes de cambiar el procesamiento.
             // ----- AÑADIR ALIMENTO A LISTA -----------------------------
-            if(grupoAnterior.ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
+            bool alimentoEnLista;   // Falso si no cabe en la lista de la comida
+            if(grupoAnterior->ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
             {                                                  //   siendo <grupo> el ID de 'grupoActual' y <peso> el valor de 'pesoBascula'.
-                listaComidaESP32.addAlimento(grupoAnterior.ID_grupo, pesoBascula);
+                alimentoEnLista = listaComidaESP32.addAlimento(grupoAnterior->ID_grupo, pesoBascula);
             }
             else  // Si el grupo anterior es un barcode (grupo 50), se escribe ALIMENTO,<grupo>,<peso>,<ean>
             {
-                listaComidaESP32.addAlimentoBarcode(grupoAnterior.ID_grupo, pesoBascula, barcode);
+                alimentoEnLista = listaComidaESP32.addAlimentoBarcode(grupoAnterior->ID_grupo, pesoBascula, barcode);
             }
 
             #if defined(SM_DEBUG)
@@ -1878,10 +1505,19 @@ void actStateCooked()
                 SerialPC.println(F("Añadiendo alimento al plato..."));
             #endif
 
-            Alimento alimento(grupoAnterior, pesoBascula);              // Cálculo automático de valores nutricionales.
+            if(alimentoEnLista)
+            {
+                Alimento alimento(grupoAnterior, pesoBascula);              // Cálculo automático de valores nutricionales.
                                                             
-            platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
-            comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+                platoActual.addAlimentoPlato(alimento);                     // Alimento ==> Plato
+                comidaActual.addAlimentoComida(alimento);                   // Alimento ==> Comida
+            }
+            else    // No cabe en la lista: tampoco en el plato ni en la comida. Se avisa de que hay que guardar la comida
+            {
+                rechazarAlimento();
+                addEventToBuffer(AVISO_LISTA_LLENA);                   // Se transiciona al STATE_AVISO, que regresa a STATE_Plato
+                flagEvent = true;
+            }
 
             pesoPlato = platoActual.getPesoPlato();                     // Se actualiza el 'pesoPlato' para sumarlo a 'pesoRecipiente' y saber el 'pesoARetirar'.
 
@@ -1938,10 +1574,17 @@ void actStateCooked()
     currentTime = millis();
     if(showing_dash) // Se está mostrando dashboard estilo 2 (Alimento | Comida)
     {
+        if(refrescarPesoProvisional) // Se está colocando el alimento: mostrar el peso provisional antes del INCREMENTO
+        {                            // (o volver a 0 si el provisional se ha descartado)
+            printZona3(SHOW_ALIMENTO_ACTUAL_ZONA3); // Zona 3 - Valores alimento actual con el peso provisional
+            printZona4(SHOW_COMIDA_ACTUAL_ZONA4);   // Zona 4 - Valores Comida actual con el peso provisional
+            refrescarPesoProvisional = false;
+        }
+
         if (currentTime - previousTime >= dashboardInterval)  // Si el dashboard ha estado 10 segundos, se cambia a pedir alimento
         {
             previousTime = currentTime;
-            pedirAlimento();
+            iniciarAnimacion(pedirAlimento);
             showing_dash = false;  
             showing_colocar_alimento = true;   // Mostrando pedir alimento
         }
@@ -1989,7 +1632,7 @@ void actStateWeighted()
         // Si el grupo actual es de barcode (ID = 50), el dashboard es algo distinto porque no se muestra la Zona 2 de procesamiento
         if(showingTemporalScreen)
         {
-            if(grupoActual.ID_grupo == BARCODE_PRODUCT_INDEX)
+            if(grupoActual->ID_grupo == BARCODE_PRODUCT_INDEX)
                 showDashboardStyle2_Barcode(); // Mostrar dashboard estilo 2 (Alimento | Comida) con Zona 1 (nombre producto) cubriendo la Zona 2 (no necesita procesamiento) para el grupo barcode
             else 
                 showDashboardStyle2(); // Mostrar dashboard estilo 2 (Alimento | Comida) con Zona 1 (grupo y ejemplos) y Zona 2 (procesamiento) para los grupos normales
@@ -2014,10 +1657,17 @@ void actStateWeighted()
     currentTime = millis();
     if(showing_dash) // Se está mostrando dashboard estilo 2 (Alimento | Comida)
     {
+        if(refrescarPesoProvisional) // Se está colocando más alimento: mostrar el peso provisional sin esperar a que se asiente
+        {                            // (o volver al peso confirmado si el provisional se ha descartado)
+            printZona3(SHOW_ALIMENTO_ACTUAL_ZONA3); // Zona 3 - Valores alimento actual con el peso provisional
+            printZona4(SHOW_COMIDA_ACTUAL_ZONA4);   // Zona 4 - Valores Comida actual con el peso provisional
+            refrescarPesoProvisional = false;
+        }
+
         if (currentTime - previousTime >= dashboardInterval)  // Si el dashboard ha estado 30 segundos, se cambia a sugerir acciones
         {
             previousTime = currentTime;
-            sugerirAccion();
+            iniciarAnimacion(sugerirAccion);
             showing_dash = false;  
             showing_sugerir_acciones = true;   // Mostrando sugerir acciones
         }
@@ -2027,7 +1677,7 @@ void actStateWeighted()
         if (currentTime - previousTime >= sugerenciasInterval)  // Si el sugerir acciones ha estado 10 segundos, se cambia a dashboard estilo 2
         {
             previousTime = currentTime;
-            if(grupoActual.ID_grupo == BARCODE_PRODUCT_INDEX) showDashboardStyle2_Barcode(); // Mostrar dashboard estilo 2 para el grupo barcode
+            if(grupoActual->ID_grupo == BARCODE_PRODUCT_INDEX) showDashboardStyle2_Barcode(); // Mostrar dashboard estilo 2 para el grupo barcode
             else showDashboardStyle2(); // Mostrar dashboard estilo 2 para los grupos normales
             showing_dash = true;  // Mostrando dashboard estilo 2 (Alimento | Comida)
             showing_sugerir_acciones = false;   
@@ -2053,7 +1703,7 @@ void actStateAddCheck()
             SerialPC.println(F("\n¿Seguro que quiere añadir un plato?")); 
         #endif
         
-        pedirConfirmacion(ASK_CONFIRMATION_ADD);                            // Mostrar pregunta de confirmación para añadir plato
+        iniciarAnimacion(pedirConfirmacion, ASK_CONFIRMATION_ADD);  // Mostrar pregunta de confirmación para añadir plato
         
         doneState = true;                                                   // Solo realizar una vez las actividades del estado por cada vez que se active y no
                                                                             // cada vez que se entre a esta función debido al loop de Arduino.
@@ -2123,13 +1773,14 @@ void actStateAdded()
 
                 // ----- AÑADIR ALIMENTO A LISTA -----------------------------
                 // Usamos 'grupoActual' porque no se ha modificado (no se ha pulsado otro grupo).
-                if(grupoActual.ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
+                bool alimentoEnLista;   // Falso si no cabe en la lista de la comida
+                if(grupoActual->ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
                 {                                 // siendo <grupo> el ID de 'grupoActual' y <peso> el valor de 'pesoBascula'.
-                    listaComidaESP32.addAlimento(grupoActual.ID_grupo, pesoBascula);
+                    alimentoEnLista = listaComidaESP32.addAlimento(grupoActual->ID_grupo, pesoBascula);
                 }
                 else  // Si el grupo anterior es un barcode (grupo 50), se escribe ALIMENTO,<grupo>,<peso>,<ean>
                 {
-                    listaComidaESP32.addAlimentoBarcode(grupoActual.ID_grupo, pesoBascula, barcode);
+                    alimentoEnLista = listaComidaESP32.addAlimentoBarcode(grupoActual->ID_grupo, pesoBascula, barcode);
                 }
 
                 #if defined(SM_DEBUG)
@@ -2139,11 +1790,15 @@ void actStateAdded()
                 
 
                 // ----- AÑADIR ALIMENTO A PLATO -----------------------------
-                Alimento alimento(grupoActual, pesoBascula);      // Cálculo automático de valores nutricionales. 
-                                                                    // Usamos 'grupoActual' porque no se ha modificado (no se ha pulsado otro grupo).
+                if(alimentoEnLista)
+                {
+                    Alimento alimento(grupoActual, pesoBascula);      // Cálculo automático de valores nutricionales. 
+                                                                        // Usamos 'grupoActual' porque no se ha modificado (no se ha pulsado otro grupo).
                 
-                platoActual.addAlimentoPlato(alimento);             // Alimento ==> Plato
-                comidaActual.addAlimentoComida(alimento);           // Alimento ==> Comida
+                    platoActual.addAlimentoPlato(alimento);             // Alimento ==> Plato
+                    comidaActual.addAlimentoComida(alimento);           // Alimento ==> Comida
+                }
+                else rechazarAlimento();                                    // No cabe en la lista: tampoco en el plato ni en la comida
 
                 /* ----- TARAR  ----- */
                 tareScale();                                        // Se debe tarar para que conforme vaya disminuyendo el peso veamos si 
@@ -2242,7 +1897,7 @@ void actStateDeleteCheck()
             SerialPC.println(F("\n¿Seguro que quiere eliminar el plato?")); 
         #endif
         
-        pedirConfirmacion(ASK_CONFIRMATION_DELETE);     // Mostrar pregunta de confirmación para eliminar plato
+        iniciarAnimacion(pedirConfirmacion, ASK_CONFIRMATION_DELETE);  // Mostrar pregunta de confirmación para eliminar plato
         
         doneState = true;                               // Solo realizar una vez las actividades del estado por cada vez que se active y no
                                                         // cada vez que se entre a esta función debido al loop de Arduino.
@@ -2463,7 +2118,7 @@ void actStateSaveCheck()
             SerialPC.println(F("\n¿Seguro que quiere guardar la comida?")); 
         #endif
         
-        pedirConfirmacion(ASK_CONFIRMATION_SAVE);       // Mostrar pregunta de confirmación para guardar comida.
+        iniciarAnimacion(pedirConfirmacion, ASK_CONFIRMATION_SAVE);  // Mostrar pregunta de confirmación para guardar comida.
                                                         // No se indica si tiene conexión a internet o no para que no se pare a preguntar, por si el ESP32 no responde.   
         
         doneState = true;                               // Solo realizar una vez las actividades del estado por cada vez que se active y no
@@ -2552,13 +2207,14 @@ void actStateSaved()
 
                 // ----- AÑADIR ALIMENTO A LISTA -----------------------------
                 // Usamos 'grupoActual' porque no se ha modificado (no se ha pulsado otro grupo).
-                if(grupoActual.ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
+                bool alimentoEnLista;   // Falso si no cabe en la lista de la comida
+                if(grupoActual->ID_grupo != BARCODE_PRODUCT_INDEX)  // Si el grupo anterior del alimento pesado es de los nuestros, se escribe ALIMENTO,<grupo>,<peso> en la lista, 
                 {                                 // siendo <grupo> el ID de 'grupoActual' y <peso> el valor de 'pesoBascula'.
-                    listaComidaESP32.addAlimento(grupoActual.ID_grupo, pesoBascula);
+                    alimentoEnLista = listaComidaESP32.addAlimento(grupoActual->ID_grupo, pesoBascula);
                 }
                 else  // Si el grupo anterior es un barcode (grupo 50), se escribe ALIMENTO,<grupo>,<peso>,<ean>
                 {
-                    listaComidaESP32.addAlimentoBarcode(grupoActual.ID_grupo, pesoBascula, barcode);
+                    alimentoEnLista = listaComidaESP32.addAlimentoBarcode(grupoActual->ID_grupo, pesoBascula, barcode);
                 }
 
                 #if defined(SM_DEBUG)
@@ -2568,11 +2224,15 @@ void actStateSaved()
                 
 
                 // ----- AÑADIR ALIMENTO A PLATO -----------------------------
-                Alimento alimento(grupoActual, pesoBascula);      // Cálculo automático de valores nutricionales.
-                                                                    // Usamos 'grupoActual' porque no se ha modificado (no se ha pulsado otro grupo).
+                if(alimentoEnLista)
+                {
+                    Alimento alimento(grupoActual, pesoBascula);      // Cálculo automático de valores nutricionales.
+                                                                        // Usamos 'grupoActual' porque no se ha modificado (no se ha pulsado otro grupo).
                 
-                platoActual.addAlimentoPlato(alimento);             // Alimento ==> Plato
-                comidaActual.addAlimentoComida(alimento);           // Alimento ==> Comida
+                    platoActual.addAlimentoPlato(alimento);             // Alimento ==> Plato
+                    comidaActual.addAlimentoComida(alimento);           // Alimento ==> Comida
+                }
+                else rechazarAlimento();                                    // No cabe en la lista: tampoco en el plato ni en la comida
 
                 /* ----- TARAR  ----- */
                 tareScale();                                        // Se debe tarar para que conforme vaya disminuyendo el peso veamos si 
@@ -3134,8 +2794,8 @@ void actStateERROR()
                                                 // Solo se debe "forzar" la transición a estados a los que se pueda transicionar desde el estado desde donde
                                                 // se cometió el error, por eso se debe chequear qué botón se ha pulsado, para ver si hacer caso o ignorar.
                                                 //
-                                                // Entonces, aunque checkAllButtons() añada un evento al buffer, el 'lastEvent' con el que se compararán las
-                                                // reglas de transición será el último marcado aquí.
+                                                // Entonces, aunque checkMainButton() añada a la cola el evento del botón pulsado, ese evento no tiene regla
+                                                // en STATE_ERROR y se ignora al evaluarlo. La transición la hace el GO_TO_... marcado aquí, que va detrás en la cola.
 
                             if(eventoMain == GUARDAR) // Se ha pulsado "Guardar comida" mientras se estaba en error. Se pasa a STATE_save_check para confirmar acción.
                             {
@@ -3805,6 +3465,7 @@ void actStateCANCEL()
 // STATE_Barcode_read       -->     AVISO_NO_WIFI_BARCODE           
 // STATE_Barcode_read       -->     AVISO_NO_BARCODE               
 // STATE_Barcode_search     -->     AVISO_PRODUCT_NOT_FOUND         
+// STATE_Grupo, STATE_Barcode_read, STATE_raw, STATE_cooked --> AVISO_LISTA_LLENA
 
 // Si el aviso ha sido escoger crudo o cocinado para un producto barcode, no se marca un evento especial de aviso, sino que se
 // utiliza el propio evento CRUDO o COCINADO aprovechando la pulsación para pasar de STATE_Barcode a STATE_AVISO. 
@@ -3818,7 +3479,7 @@ void actStateAVISO()
     { 
         previousTimeWarning = millis();   // Reiniciar "temporizador" de 3 segundos para, tras mostrar pantalla de aviso, regresar al estado anterior.
 
-        // Mostrar información según el evento que ha llevado al aviso (AVISO_PLATO_EMPTY_NOT_ADDED, AVISO_PLATO_EMPTY_NOT_DELETED, AVISO_COMIDA_EMPTY, AVISO_NO_WIFI_BARCODE, AVISO_NO_BARCODE, AVISO_PRODUCT_NOT_FOUND)
+        // Mostrar información según el evento que ha llevado al aviso (AVISO_PLATO_EMPTY_NOT_ADDED, AVISO_PLATO_EMPTY_NOT_DELETED, AVISO_COMIDA_EMPTY, AVISO_NO_WIFI_BARCODE, AVISO_NO_BARCODE, AVISO_PRODUCT_NOT_FOUND, AVISO_LISTA_LLENA)
         switch(lastEvent) 
         { 
             case AVISO_PLATO_EMPTY_NOT_ADDED:       showWarning(WARNING_NOT_ADDED);                 break;  // No se ha añadido plato en STATE_added porque el actual está vacío     
@@ -3828,6 +3489,7 @@ void actStateAVISO()
             case AVISO_NO_WIFI_BARCODE:             showWarning(WARNING_NO_INTERNET_NO_BARCODE);    break;  // No había conexión a Internet, así que no se puede buscar el producto en STATE_Barcode_search
             case AVISO_NO_BARCODE:                  showWarning(WARNING_BARCODE_NOT_READ);          break;  // No se ha detectado un barcode en 10 segundos en STATE_Barcode_read
             case AVISO_PRODUCT_NOT_FOUND:           showWarning(WARNING_PRODUCT_NOT_FOUND);         break;  // No se ha encontrado el producto en OpenFoodFacts en STATE_Barcode_search
+            case AVISO_LISTA_LLENA:                 showWarning(WARNING_LISTA_LLENA);               break;  // El último alimento no cabe en la lista de la comida
 
             // Se ha pulsado crudo/cocinado en STATE_Barcode, pero un producto barcode no necesita diferenciar entre crudo o cocinado
             case CRUDO: 
@@ -4179,7 +3841,7 @@ void actState_REMOVAL_CHECK()
                 SerialPC.println(F("\nHa retirado el plato sin avisar. ¿Qué quiere hacer con él: BORRAR PLATO o AÑADIR OTRO (no se guardara el ultimo alimento)?")); 
             #endif
 
-            checkIntencionRemoval();  // Preguntar qué intención tenía al retirar el plato: "Guardar y crear otro", "Eliminar" o "Guardar comida"
+            iniciarAnimacion(checkIntencionRemoval);  // Preguntar qué intención tenía al retirar el plato: "Guardar y crear otro", "Eliminar" o "Guardar comida"
         }
         // -----------------------------------------
         // ---- NO HAY NADA QUE PROCESAR -----------
@@ -4268,6 +3930,14 @@ void actState_REMOVAL_CHECK()
 ----------------------------------------------------------------------------------------------------------*/
 void doStateActions()
 {
+    // Mientras se forma la pantalla animada del estado (continuarAnimacion()), sus actividades siguen "en curso",
+    // igual que cuando la pantalla bloqueaba el loop con delay(). Un evento o una transición la cancelan.
+    if(isAnimacionEnCurso()) return;
+
+    static state_t estadoAnterior = (state_t)0;    // Para registrar siempre la primera actividad de cada estado
+    state_t estado = state_actual;
+    unsigned long inicio = micros();
+
     switch (state_actual)
     {
         case STATE_Init:                actStateInit();             break;  // Init
@@ -4303,6 +3973,9 @@ void doStateActions()
 
       default: break;
     }
+
+    vueloActividad(estado, micros() - inicio, estado != estadoAnterior);
+    estadoAnterior = estado;
 }
 
 
@@ -4316,9 +3989,8 @@ void actEventError()
     // Tras 3 segundos con la pantalla de error, se marca el evento GO_TO_<estado> correspondiente para 
     // regresar al estado previo.
 
-    #if defined(SM_DEBUG)
-        SerialPC.println(F("\nERROR..."));
-    #endif
+    LOG_SM(LOG_ERROR_EVENTO, lastEvent, state_actual);
+    vueloError(lastEvent, state_actual);
     addEventToBuffer(ERROR);    
     flagError = true;
 }
@@ -4389,18 +4061,11 @@ void shiftLeftEventBuffer()
 
 
 /*---------------------------------------------------------------------------------------------------------
-   addEventToBuffer(): Añade el último evento ocurrido al buffer de eventos
+   addEventToBuffer(): Añade el último evento ocurrido al buffer de eventos y a la cola de eventos pendientes
+                       de evaluar (colaEventosSM), con el millis() en que ocurrió
 ----------------------------------------------------------------------------------------------------------*/
-void addEventToBuffer(event_t evento)
+void addEventToBuffer(event_t evento, unsigned long tiempo)
 {
-    #if defined SM_DEBUG
-        SerialPC.println("\n\n--------------------------------------------------");
-        SerialPC.println("--------------------------------------------------");
-        SerialPC.println("      +++++++++++++++++++++++++++++++++++++++     ");
-        SerialPC.println("      EVENTO --> ACTIVANDO MÁQUINA DE ESTADOS      ");
-        SerialPC.println("      +++++++++++++++++++++++++++++++++++++++     ");
-    #endif
-
     byte pos;
     if(isBufferEmpty()){ 
         pos = 0;
@@ -4415,18 +4080,48 @@ void addEventToBuffer(event_t evento)
         }
     }
     event_buffer[pos] = evento;                  // Añadir a buffer
-    lastEvent = evento;
 
-    #if defined(SM_DEBUG)
-        SerialPC.print("\nBuffer: "); 
-        for (byte i = 0; i < MAX_EVENTS; i++){
-            //SerialPC.print(event_buffer[i]); SerialPC.print(" ");
-            printEventName(event_buffer[i]); SerialPC.print(" | ");
-        }
-        SerialPC.println();
-        SerialPC.print("Last event: "); printEventName(lastEvent);
-        SerialPC.println();
-    #endif
+    if(!pushCola(colaEventosSM, evento, tiempo)) // Se evalúa en loop() al sacarlo de la cola
+    {
+        LOG_SM(LOG_COLA_LLENA, evento);
+        return;
+    }
+
+    LOG_SM(LOG_EVENTO_ANADIDO, evento, (byte)((colaEventosSM.head - colaEventosSM.tail) & COLA_EVENTOS_MASK));
+}
+
+
+
+/*---------------------------------------------------------------------------------------------------------
+   addEventoExterno(): Añade un evento de las botoneras o de la báscula. Interrumpe la pantalla animada en
+                       curso, como hacía antes eventOccurred() entre esperas.
+                       Los eventos internos (GO_TO_*, AVISO_*, BARCODE_R...) los marca la propia Máquina de
+                       Estados y no cancelan nada al añadirse: si llevan a otro estado, checkStateConditions()
+                       cancela la animación en la transición.
+----------------------------------------------------------------------------------------------------------*/
+void addEventoExterno(event_t evento, unsigned long tiempo)
+{
+    cancelarAnimacion();
+    addEventToBuffer(evento, tiempo);
+}
+
+
+
+/*---------------------------------------------------------------------------------------------------------
+   sacarEvento(): Saca de 'colaEventosSM' el evento más antiguo y lo deja en 'lastEvent' para evaluarlo
+                  con checkStateConditions(). Devuelve 'false' si no hay eventos pendientes.
+----------------------------------------------------------------------------------------------------------*/
+bool sacarEvento()
+{
+    eventoCola_t elemento;
+    if(!popCola(colaEventosSM, elemento)) return false;
+
+    lastEvent = (event_t)elemento.codigo;
+    tiempoLastEvent = elemento.tiempo;
+
+    LOG_SM(LOG_EVALUANDO_EVENTO, lastEvent, millis() - tiempoLastEvent);
+
+    return true;
 }
 
 
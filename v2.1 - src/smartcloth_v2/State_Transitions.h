@@ -0,0 +1,600 @@
+/** 
+ * @file State_Transitions.h
+ * @brief Estados, eventos y reglas de transición de la Máquina de Estados
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ *  Las reglas de transición se escriben como lista ('rules'), pero checkStateConditions()
+ *  no la recorre: al compilar se genera con ellas una tabla densa [estado][evento] con el
+ *  estado siguiente ('tablaTransiciones'), que se guarda en flash y se consulta en O(1).
+ *
+ *  Al compilar también se comprueba que:
+ *      - RULES coincide con el número de reglas escritas
+ *      - No hay reglas con estados o eventos fuera de rango
+ *      - No hay dos reglas para el mismo estado y evento (repetidas o en conflicto)
+ *
+ *  No depende del resto de la Máquina de Estados, así que también se compila en la
+ *  herramienta de PC que compara la tabla con la búsqueda lineal (tools/state_table_bench).
+ *
+ * @see State_Machine.h
+ */
+
+#ifndef STATE_TRANSITIONS_H
+#define STATE_TRANSITIONS_H
+
+#include "debug.h" // BORRADO_INFO_USUARIO
+
+
+/**
+ * @def RULES
+ * @brief Máximo número de reglas de transición.
+ * 
+ * @note Debe coincidir con el número de reglas de 'rules'. Se comprueba al compilar.
+ */
+#ifdef BORRADO_INFO_USUARIO
+#define RULES 218
+#else
+#define RULES 206
+#endif
+
+
+/*----------------------------------------------------------------------------------------------*/
+/*-------------------------------------- ESTADOS -----------------------------------------------*/
+/*----------------------------------------------------------------------------------------------*/
+/**
+ * @enum state_t
+ * @brief Enumeración de los diferentes estados de la Máquina de Estados.
+ */
+typedef enum 
+{
+                STATE_Init              =   (1),    // Estado inicial para colocar plato                                        -->     Estado válido 
+                STATE_Plato             =   (2),    // Estado para escoger grupo                                                -->     Estado válido 
+                STATE_Grupo             =   (3),    // Grupo alimentos                                                          -->     Estado válido 
+                STATE_Barcode_read      =   (4),    // Estado para leer barcode                                                 -->     Estado transitorio
+                STATE_Barcode_search    =   (5),    // Estado para buscar información del producto                              -->     Estado transitorio
+                STATE_Barcode_check     =   (6),    // Estado para confirmar el producto encontrado                             -->     Estado transitorio
+                STATE_Barcode           =   (7),    // Estado para utilizar el producto encontrado como grupo de alimentos      -->     Estado válido 
+                STATE_raw               =   (8),    // Estado que indica alimento crudo                                         -->     Estado válido 
+                STATE_cooked            =   (9),    // Estado que indica alimento cocinado                                      -->     Estado válido 
+                STATE_weighted          =   (10),   // Estado para pesar alimento                                               -->     Estado válido 
+                STATE_add_check         =   (11),   // Estado para comprobar que se quiere añadir plato                         -->     Estado transitorio
+                STATE_added             =   (12),   // Estado para añadir plato                                                 -->     Estado transitorio
+                STATE_delete_check      =   (13),   // Estado para comprobar que se quiere eliminar plato                       -->     Estado transitorio
+                STATE_deleted           =   (14),   // Estado para eliminar plato                                               -->     Estado transitorio
+                STATE_save_check        =   (15),   // Estado para comprobar que se quiere guardar la comida                    -->     Estado transitorio
+                STATE_saved             =   (16),   // Estado para guardar la comida                                            -->     Estado transitorio
+                STATE_ERROR             =   (17),   // Estado ficticio de error (acción incorrecta)                             -->     Estado transitorio
+                STATE_CANCEL            =   (18),   // Estado ficticio de Cancelación                                           -->     Estado transitorio
+                STATE_AVISO             =   (19),   // Estado ficticio de Aviso                                                 -->     Estado transitorio
+
+                #ifdef BORRADO_INFO_USUARIO
+                STATE_DELETE_FILES_CHECK    =   (20),   // COMPROBAR QUE SE QUIERE BORRAR LOS FICHEROS. EL USUARIO NO DEBERÍA ACCEDER. SOLO PARA LAS PRUEBAS. -->     Estado transitorio
+                STATE_DELETED_FILES         =   (21),   // FICHEROS BORRADOS. EL USUARIO NO DEBERÍA ACCEDER. SOLO PARA LAS PRUEBAS.                          -->     Estado transitorio
+                                                      //  --> PARA LIMPIAR EL ACUMULADO DEL DÍA, DEJÁNDOLO LISTO PARA EL SIGUIENTE USUARIO
+                #endif
+
+                STATE_CRITIC_FAILURE_SD   =   (22),     // La SD ha fallado en el setup o no se encuentra --> no se permite usar SM                         -->     Estado transitorio
+                                                        // Este estado no tiene transiciones de entrada ni de salida. Solo sirve para mostrar
+                                                        // la pantalla de fallo crítico. Se entra manualmente por código, no por acciones del usuario.
+
+                STATE_UPLOAD_DATA = (23),       // Hay datos en el fichero data-esp.txt y hay que subirlos a la base de datos.                              -->     Estado transitorio
+                                                // Solo se pasaría a este estado al iniciar el dispositivo para guardar la info acumulada en el fichero.
+                                                // Se entra manualmente por código, no por acciones del usuario, por eso no tiene transiciones de entrada.
+                                                // Sí tiene una transición de salida a Init cuando se suben o no los datos.
+
+                STATE_REMOVAL_CHECK = (24)      // Estado para preguntar qué hacer con el plato retirado sin avisar: guardarlo en la comida para añadir otro o eliminarlo
+} state_t;
+
+
+
+/*----------------------------------------------------------------------------------------------*/
+/*-------------------------------------- EVENTOS -----------------------------------------------*/
+/*----------------------------------------------------------------------------------------------*/
+/**
+ * @enum event_t
+ * @brief Enumeración de los diferentes eventos que pueden ocurrir en la Máquina de Estados.
+ */
+typedef enum 
+{
+              NONE                              =   (0),    
+              TIPO_A                            =   (1),    // Botonera Grande (7,8,9,16,17,18,19)
+              TIPO_B                            =   (2),    // Botonera Grande (1,2,3,4,5,6,10,11,12,13,14,15,20)
+              BARCODE                           =   (3),    // Botón Barcode
+              BARCODE_R                         =   (4),    // Barcode leído
+              BARCODE_F                         =   (5),    // Producto encontrado
+              CRUDO                             =   (6),    // AMARILLO
+              COCINADO                          =   (7),    // BLANCO
+              ADD_PLATO                         =   (8),    // VERDE
+              DELETE_PLATO                      =   (9),    // ROJO
+              GUARDAR                           =   (10),   // NEGRO 
+              INCREMENTO                        =   (11),   // Báscula
+              DECREMENTO                        =   (12),   // Báscula
+              TARAR                             =   (13),   // Báscula tarada
+              LIBERAR                           =   (14),   // Báscula vacía real
+              ERROR                             =   (15),   // Error (acción incorrecta)
+              CANCELAR                          =   (16),   // Cancelar acción de añadir, eliminar o guardar
+              AVISO_PLATO_EMPTY_NOT_ADDED       =   (17),   // Aviso de plato vacío, no añadido uno nuevo
+              AVISO_PLATO_EMPTY_NOT_DELETED     =   (18),   // Aviso de plato vacío, no borrado
+              AVISO_COMIDA_EMPTY_NOT_SAVED      =   (19),   // Aviso de comida vacía, no guardada
+              AVISO_NO_WIFI_BARCODE             =   (20),   // Aviso de que no hay conexión a Internet, así que no se podrá buscar el producto
+              AVISO_NO_BARCODE                  =   (21),   // Aviso de que no se ha detectado barcode
+              AVISO_PRODUCT_NOT_FOUND           =   (22),   // Aviso de que no se ha encontrado el producto en OpenFoodFacts
+              GO_TO_INIT                        =   (23),   // Evento ficticio para volver a STATE_Init porque saltó un error, aviso o se canceló una acción (añadir, eliminar o guardar)
+              GO_TO_PLATO                       =   (24),   // Evento ficticio para volver a STATE_Plato porque saltó un error 
+              GO_TO_GRUPO                       =   (25),   // Evento ficticio para volver a STATE_Grupo porque saltó un error o aviso
+              GO_TO_BARCODE_READ                =   (26),   // Evento ficticio para volver a STATE_Barcode_read porque saltó un error o aviso
+              GO_TO_BARCODE                     =   (27),   // Evento ficticio para volver a STATE_Barcode porque saltó un error o aviso
+              GO_TO_RAW                         =   (28),   // Evento ficticio para volver a STATE_raw porque saltó un error o se canceló una acción (añadir, eliminar o guardar)
+              GO_TO_COOKED                      =   (29),   // Evento ficticio para volver a STATE_cooked porque saltó un error o se canceló una acción (añadir, eliminar o guardar)
+              GO_TO_WEIGHTED                    =   (30),   // Evento ficticio para volver a STATE_weighted porque saltó un error o se canceló una acción (añadir, eliminar o guardar)
+              GO_TO_ADD_CHECK                   =   (31),   // Evento ficticio para volver a STATE_add_check porque saltó un error 
+              GO_TO_ADDED                       =   (32),   // Evento ficticio para volver a STATE_added porque saltó un error 
+              GO_TO_DELETE_CHECK                =   (33),   // Evento ficticio para volver a STATE_delete_check porque saltó un error 
+              GO_TO_DELETED                     =   (34),   // Evento ficticio para volver a STATE_deleted porque saltó un error
+              GO_TO_SAVE_CHECK                  =   (35),   // Evento ficticio para volver a STATE_save_check porque saltó un error 
+              GO_TO_SAVED                       =   (36),   // Evento ficticio para volver a STATE_saved porque saltó un error 
+              GO_TO_CANCEL                      =   (37),   // Evento ficticio para ir a STATE_CANCEL si se cancela una acción iniciada durante un error
+              AVISO_LISTA_LLENA                 =   (38),   // Aviso de que el alimento pesado no cabe en la lista de la comida (lista_Comida.h) y no se ha incluido
+
+              #ifdef BORRADO_INFO_USUARIO
+              DELETE_FILES                        =   (39)   // EVENTO PARA BORRAR EL FICHERO CSV. EL USUARIO NO DEBERÍA LLEGAR A ACTIVARLO. SOLO PARA LAS PRUEBAS.
+              #endif
+} event_t;
+
+
+/**
+ * @def NUM_ESTADOS
+ * @brief Filas de la tabla de transiciones (el estado 0 no existe y su fila queda vacía).
+ *
+ * @def NUM_EVENTOS
+ * @brief Columnas de la tabla de transiciones.
+ */
+#define NUM_ESTADOS     (STATE_REMOVAL_CHECK + 1)
+#ifdef BORRADO_INFO_USUARIO
+#define NUM_EVENTOS     (DELETE_FILES + 1)
+#else
+#define NUM_EVENTOS     (AVISO_LISTA_LLENA + 1)
+#endif
+
+/**
+ * @def SIN_TRANSICION
+ * @brief Valor de la tabla cuando no hay regla para ese estado y evento (ERROR DE EVENTO).
+ */
+#define SIN_TRANSICION  0
+
+
+
+/*----------------------------------------------------------------------------------------------*/
+/*------------------------------ REGLAS TRANSICION ---------------------------------------------*/
+/*----------------------------------------------------------------------------------------------*/
+/**
+ * @struct transition_rule
+ * @brief Estructura que define una regla de transición en la Máquina de Estados.
+ */
+typedef struct
+{
+    state_t state_i;     /**< Estado actual */
+    state_t state_j;     /**< Estado siguiente */
+    event_t condition;    /**< Condición para transición de estado */
+}transition_rule;
+
+
+/**
+ * @brief Array de reglas de transición para la Máquina de Estados.
+ * 
+ * Solo se recorre al compilar, para generar 'tablaTransiciones'.
+ */
+constexpr transition_rule rules[RULES] =  
+{                                       // --- Esperando Recipiente ---
+                                        {STATE_Init,STATE_Init,TARAR},                  // Tara inicial
+                                        {STATE_Init,STATE_Init,DECREMENTO},             // Por si se inicia SM con un recipiente ya puesto y luego se retira
+                                        {STATE_Init,STATE_Init,LIBERAR},                // Por si se inicia SM con recipiente puesto, se retira y resulta que pesaba menos de 20 gramos (el umbral)
+                                        {STATE_Init,STATE_Plato,INCREMENTO},            // Colocar recipiente
+                                        {STATE_Init,STATE_save_check,GUARDAR},          // Guardar comida directamente (comidaActual no está vacía)
+                                        {STATE_Init,STATE_ERROR,ERROR},                 // Acción incorrecta
+                                        // ----------------------------
+
+                                        // --- Recipiente colocado ---
+                                        {STATE_Plato,STATE_Plato,INCREMENTO},           // Cambios por recolocar recipiente
+                                        {STATE_Plato,STATE_Plato,DECREMENTO},           // Cambios por recolocar recipiente
+                                        {STATE_Plato,STATE_Init,LIBERAR},               // Se ha retirado el recipiente
+                                        {STATE_Plato,STATE_Grupo,TIPO_A},               // Escogido grupo de alimentos de tipo A
+                                        {STATE_Plato,STATE_Grupo,TIPO_B},               // Escogido grupo de alimentos de tipo B
+                                        {STATE_Plato,STATE_Barcode_read,BARCODE},       // Pulsado botón de barcode para iniciar lectura
+                                        {STATE_Plato,STATE_Plato,TARAR},
+                                        {STATE_Plato,STATE_ERROR,ERROR},                // Acción incorrecta             
+                                        // ---------------------------
+                                        
+                                        // --- Grupo de alimentos ---
+                                        //{STATE_Grupo,STATE_Init,LIBERAR},              // Se ha retirado el plato completo (+ recipiente) ==> Automáticamente se borra el plato, sin preguntar
+                                        {STATE_Grupo,STATE_REMOVAL_CHECK,LIBERAR},     // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
+                                        {STATE_Grupo,STATE_Grupo,DECREMENTO},          // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
+                                        {STATE_Grupo,STATE_Grupo,TARAR},               // Tarar tras colocar recipiente o alimento   
+                                        {STATE_Grupo,STATE_Grupo,TIPO_A},              // Otro grupo de tipo A
+                                        {STATE_Grupo,STATE_Grupo,TIPO_B},              // Otro grupo de tipo B
+                                        {STATE_Grupo,STATE_Barcode_read,BARCODE},      // Pulsado botón de barcode para iniciar lectura
+                                        {STATE_Grupo,STATE_raw,CRUDO},                         
+                                        {STATE_Grupo,STATE_cooked,COCINADO},              
+                                        {STATE_Grupo,STATE_add_check,ADD_PLATO},       // Nuevo plato, aunque no se haya colocado alimento
+                                        {STATE_Grupo,STATE_delete_check,DELETE_PLATO}, // Borrar plato actual
+                                        {STATE_Grupo,STATE_save_check,GUARDAR},        // Guardar comida, aunque no se haya colocado alimento
+                                        {STATE_Grupo,STATE_AVISO,AVISO_LISTA_LLENA},   // El alimento pesado antes de escoger grupo no cabe en la lista
+                                        {STATE_Grupo,STATE_ERROR,ERROR},               // Acción incorrecta
+                                        // --------------------------
+
+                                        // --- Leer Barcode ---------
+                                        //{STATE_Barcode_read,STATE_Init,LIBERAR},                // Se ha retirado el plato completo (+ recipiente) ==> Automáticamente se borra el plato, sin preguntar
+                                        {STATE_Barcode_read,STATE_REMOVAL_CHECK,LIBERAR},       // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
+                                        {STATE_Barcode_read,STATE_Barcode_read,DECREMENTO},     // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
+                                        {STATE_Barcode_read,STATE_Barcode_read,TARAR},          // Tarar tras colocar recipiente o alimento   
+                                        {STATE_Barcode_read,STATE_Barcode_search,BARCODE_R},    // Producto detectado y código leído
+                                        //{STATE_Barcode_read,STATE_AVISO,AVISO_NO_WIFI_BARCODE}, // Aviso de "No se puede leer barcode porque no hay conexión a Internet"
+                                        {STATE_Barcode_read,STATE_AVISO,AVISO_NO_BARCODE},      // Aviso de "Código no detectado" porque no se detecta o porque no responde el ESP32
+                                        {STATE_Barcode_read,STATE_CANCEL,TIPO_A},               // Cancelar lectura de barcode pulsando botón de grupo tipoA.
+                                        {STATE_Barcode_read,STATE_CANCEL,TIPO_B},               // Cancelar lectura de barcode pulsando botón de grupo tipoB.
+                                        {STATE_Barcode_read,STATE_CANCEL,BARCODE},              // Cancelar lectura de barcode pulsando botón de BARCODE
+                                        {STATE_Barcode_read,STATE_CANCEL,CRUDO},                // Cancelar lectura de barcode pulsando botón de CRUDO.
+                                        {STATE_Barcode_read,STATE_CANCEL,COCINADO},             // Cancelar lectura de barcode pulsando botón de COCINADO.
+                                        {STATE_Barcode_read,STATE_CANCEL,ADD_PLATO},            // Cancelar lectura de barcode pulsando botón de AÑADIR PLATO.
+                                        {STATE_Barcode_read,STATE_CANCEL,DELETE_PLATO},         // Cancelar lectura de barcode pulsando botón de BORRAR PLATO.
+                                        {STATE_Barcode_read,STATE_CANCEL,GUARDAR},              // Cancelar lectura de barcode pulsando botón de GUARDAR.
+                                                                                                // No se hace cancelación automática tras 30 segundos porque se asume simplemente que no se ha leído el barcode
+                                        {STATE_Barcode_read,STATE_Plato,GO_TO_PLATO},           // Regresar a STATE_Plato si fue lastValidState y no había conexión a Internet, por lo que no se pudo leer barcode.
+                                        {STATE_Barcode_read,STATE_Grupo,GO_TO_GRUPO},           // Regresar a STATE_Grupo si fue lastValidState y no había conexión a Internet, por lo que no se pudo leer barcode.
+                                        {STATE_Barcode_read,STATE_Barcode,GO_TO_BARCODE},       // Regresar a STATE_Barcode si fue lastValidState y no había conexión a Internet, por lo que no se pudo leer barcode.
+                                        {STATE_Barcode_read,STATE_AVISO,AVISO_LISTA_LLENA},     // El alimento pesado antes de leer barcode no cabe en la lista
+                                        {STATE_Barcode_read,STATE_ERROR,ERROR},                 // Acción incorrecta ????? El único error sería poner peso en báscula (Incremento), pero el usuario no debería hacerlo
+                                        // --------------------------
+
+                                        // --- Buscar Barcode --------
+                                        {STATE_Barcode_search,STATE_Barcode_check,BARCODE_F},       // Producto encontrado
+                                        {STATE_Barcode_search,STATE_AVISO,AVISO_PRODUCT_NOT_FOUND}, // Aviso de "Producto no encontrado"
+                                        {STATE_Barcode_search,STATE_AVISO,AVISO_NO_WIFI_BARCODE},   // Aviso de "No se puede buscar producto porque no hay conexión a Internet"
+                                        //{STATE_Barcode_search,STATE_CANCEL,CANCELAR},             // Cancelar búsqueda de producto por timeout del ESP32
+                                        {STATE_Barcode_search,STATE_Plato,GO_TO_PLATO},             // Regresar a STATE_Plato si fue lastValidState y no había conexión a Internet, por lo que no se pudo buscar el producto.
+                                        {STATE_Barcode_search,STATE_Grupo,GO_TO_GRUPO},             // Regresar a STATE_Grupo si fue lastValidState y no había conexión a Internet, por lo que no se pudo buscar el producto.
+                                        {STATE_Barcode_search,STATE_Barcode,GO_TO_BARCODE},         // Regresar a STATE_Barcode si fue lastValidState y no había conexión a Internet, por lo que no se pudo buscar el producto.
+                                        {STATE_Barcode_search,STATE_ERROR,ERROR},                   // Acción incorrecta ????? EL USUARIO NO DEBERÍA HACER NADA MIENTRAS SE BUSCA EL PRODUCTO
+                                        // --------------------------
+
+                                        // --- Confirmar producto ---
+                                        {STATE_Barcode_check,STATE_Barcode,BARCODE},            // Producto confirmado pulsado botón barcode
+                                        {STATE_Barcode_check,STATE_CANCEL,TIPO_A},              // Cancelar producto (no es el desado) pulsando botón de grupo tipoA.
+                                        {STATE_Barcode_check,STATE_CANCEL,TIPO_B},              // Cancelar producto (no es el desado) pulsando botón de grupo tipoB.
+                                        {STATE_Barcode_check,STATE_CANCEL,CRUDO},               // Cancelar producto (no es el desado) pulsando botón de CRUDO.
+                                        {STATE_Barcode_check,STATE_CANCEL,COCINADO},            // Cancelar producto (no es el desado) pulsando botón de COCINADO.
+                                        {STATE_Barcode_check,STATE_CANCEL,ADD_PLATO},           // Cancelar producto (no es el desado) pulsando botón de COCINADO.
+                                        {STATE_Barcode_check,STATE_CANCEL,DELETE_PLATO},        // Cancelar producto (no es el desado) pulsando botón de BORRAR PLATO.
+                                        {STATE_Barcode_check,STATE_CANCEL,GUARDAR},             // Cancelar producto (no es el desado) pulsando botón de GUARDAR.
+                                        {STATE_Barcode_check,STATE_CANCEL,CANCELAR},            // Cancelar producto tras 20 segundos de inactividad.
+                                        {STATE_Barcode_check,STATE_ERROR,ERROR},                // Acción incorrecta ????? Tocar la báscula (incremento, decremento o liberar) sería error, pero no debería ocurrir
+                                        // --------------------------
+
+                                        // --- Grupo Barcode --------
+                                        //{STATE_Barcode,STATE_Init,LIBERAR},                 // Se ha retirado el plato completo (+ recipiente) ==> Automáticamente se borra el plato, sin preguntar
+                                        {STATE_Barcode,STATE_REMOVAL_CHECK,LIBERAR},        // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
+                                        {STATE_Barcode,STATE_Barcode,DECREMENTO},           // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
+                                        {STATE_Barcode,STATE_Grupo,TIPO_A},                 // Cambiar grupo alimentos con TIPO_A
+                                        {STATE_Barcode,STATE_Grupo,TIPO_B},                 // Cambiar grupo alimentos con TIPO_B
+                                        {STATE_Barcode,STATE_Barcode_read,BARCODE},         // Leer otro barcode (vuelve a comenzar)
+                                        {STATE_Barcode,STATE_AVISO,CRUDO},                  // Aviso de "No hace falta crudo" porque el producto no necesita crudo
+                                        {STATE_Barcode,STATE_AVISO,COCINADO},               // Aviso de "No hace falta cocinado" porque el producto no necesita cocinado
+                                        {STATE_Barcode,STATE_weighted,INCREMENTO},          // Se ha colocado alimento del producto leído
+                                        {STATE_Barcode,STATE_add_check,ADD_PLATO},          // Nuevo plato, aunque no se haya colocado alimento
+                                        {STATE_Barcode,STATE_delete_check,DELETE_PLATO},    // Borrar plato actual
+                                        {STATE_Barcode,STATE_save_check,GUARDAR},           // Guardar comida, aunque no se haya colocado alimento
+                                        {STATE_Barcode,STATE_ERROR,ERROR},                  // Acción incorrecta ????? Parece que todas las posibles acciones del usuario están contempladas en las reglas de transición
+                                        // --------------------------
+
+                                        // --- Alimento crudo ---
+                                        //{STATE_raw,STATE_Init,LIBERAR},                 // Se ha retirado el plato completo (+ recipiente) ==> ¿Habría que borrar y empezar de nuevo?
+                                        {STATE_raw,STATE_REMOVAL_CHECK,LIBERAR},        // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
+                                        {STATE_raw,STATE_raw,DECREMENTO},               // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
+                                        {STATE_raw,STATE_raw,TARAR},                    // Tarar tras pesar alimento y querer cambiar procesamiento, por lo que se ha debido de guardar el alimento pesado antes de cambiar procesamiento
+                                        {STATE_raw,STATE_Grupo,TIPO_A},                 // Cambiar grupo alimentos
+                                        {STATE_raw,STATE_Grupo,TIPO_B},                 // Cambiar grupo alimentos
+                                        {STATE_raw,STATE_Barcode_read,BARCODE},         // Pulsado botón de barcode para iniciar lectura
+                                        {STATE_raw,STATE_raw,CRUDO},                    // Para que no dé error si se vuelve a pulsar 'crudo'.
+                                        {STATE_raw,STATE_cooked,COCINADO},              // Cambiar procesamiento (crudo => cocinado).
+                                        {STATE_raw,STATE_weighted,INCREMENTO},          // Se ha colocado alimento.
+                                        {STATE_raw,STATE_add_check,ADD_PLATO},          // Nuevo plato, aunque no se haya colocado alimento.
+                                        {STATE_raw,STATE_delete_check,DELETE_PLATO},    // Borrar plato actual. 
+                                        {STATE_raw,STATE_save_check,GUARDAR},           // Guardar comida, aunque no se haya colocado alimento.  
+                                        {STATE_raw,STATE_AVISO,AVISO_LISTA_LLENA},      // El alimento pesado antes de cambiar el procesamiento no cabe en la lista
+                                        {STATE_raw,STATE_ERROR,ERROR},                  // Acción incorrecta
+                                        // -----------------------
+
+                                        // --- Alimento cocinado ---
+                                        //{STATE_cooked,STATE_Init,LIBERAR},              // Se ha retirado el plato completo (+ recipiente) ==> ¿Habría que borrar y empezar de nuevo?
+                                        {STATE_cooked,STATE_REMOVAL_CHECK,LIBERAR},     // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer  
+                                        {STATE_cooked,STATE_cooked,DECREMENTO},         // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR)
+                                        {STATE_cooked,STATE_cooked,TARAR},              // Tarar tras pesar alimento y querer cambiar procesamiento, por lo que se ha debido de guardar el alimento pesado antes de cambiar procesamiento
+                                        {STATE_cooked,STATE_Grupo,TIPO_A},              // Cambiar grupo alimentos
+                                        {STATE_cooked,STATE_Grupo,TIPO_B},              // Cambiar grupo alimentos
+                                        {STATE_cooked,STATE_Barcode_read,BARCODE},      // Pulsado botón de barcode para iniciar lectura
+                                        {STATE_cooked,STATE_cooked,COCINADO},           // Para que no dé error si se vuelve a pulsar 'cocinado'.
+                                        {STATE_cooked,STATE_raw,CRUDO},                 // Cambiar procesamiento (cocinado => crudo).
+                                        {STATE_cooked,STATE_weighted,INCREMENTO},       // Se ha colocado alimento.      
+                                        {STATE_cooked,STATE_add_check,ADD_PLATO},       // Nuevo plato, aunque no se haya colocado alimento.
+                                        {STATE_cooked,STATE_delete_check,DELETE_PLATO}, // Borrar plato actual. 
+                                        {STATE_cooked,STATE_save_check,GUARDAR},        // Guardar comida, aunque no se haya colocado alimento.   
+                                        {STATE_cooked,STATE_AVISO,AVISO_LISTA_LLENA},   // El alimento pesado antes de cambiar el procesamiento no cabe en la lista
+                                        {STATE_cooked,STATE_ERROR,ERROR},               // Acción incorrecta 
+                                        // --------------------------
+
+                                        // --- Alimento pesado ---
+                                        //{STATE_weighted,STATE_Init,LIBERAR},                // Se ha retirado el plato completo (+ recipiente) ==> ¿Habría que borrar y empezar de nuevo?
+                                        {STATE_weighted,STATE_REMOVAL_CHECK,LIBERAR},       // Se ha retirado el plato completo (+ recipiente) ==> Preguntar qué hacer
+                                        {STATE_weighted,STATE_weighted,INCREMENTO},         // Se coloca más alimento.  
+                                        {STATE_weighted,STATE_weighted,DECREMENTO},         // Se retira alimento.
+                                        {STATE_weighted,STATE_Grupo,TIPO_A},                // Escoger nuevo grupo. Se guardará en STATE_Grupo el peso del alimento en báscula.
+                                        {STATE_weighted,STATE_Grupo,TIPO_B},                // Escoger nuevo grupo. Se guardará en STATE_Grupo el peso del alimento en báscula.
+                                        {STATE_weighted,STATE_raw,CRUDO},                   // Cambiar procesamiento (pesado => crudo).
+                                        {STATE_weighted,STATE_cooked,COCINADO},             // Cambiar procesamiento (pesado => cocinado).
+                                        {STATE_weighted,STATE_Barcode_read,BARCODE},        // Pulsado botón de barcode para iniciar lectura. Se guardará en STATE_Barcode el peso del alimento en báscula.
+                                        {STATE_weighted,STATE_add_check,ADD_PLATO},         // Nuevo plato, aunque no se haya colocado alimento.
+                                        {STATE_weighted,STATE_delete_check,DELETE_PLATO},   // Borrar plato actual. 
+                                        {STATE_weighted,STATE_save_check,GUARDAR},          // Guardar comida, aunque no se haya colocado alimento. 
+                                        {STATE_weighted,STATE_ERROR,ERROR},                 // Acción incorrecta ????? Parece que todas las posibles acciones del usuario están contempladas en las reglas de transición
+                                        // -----------------------
+
+                                        // --- Check añadir plato ---
+                                        {STATE_add_check,STATE_added,ADD_PLATO},         // Confirmar añadir plato.
+                                        {STATE_add_check,STATE_CANCEL,TIPO_A},           // Cancelar añadir plato pulsando botón de grupo tipoA.
+                                        {STATE_add_check,STATE_CANCEL,TIPO_B},           // Cancelar añadir plato pulsando botón de grupo tipoB.
+                                        {STATE_add_check,STATE_CANCEL,BARCODE},          // Cancelar añadir plato pulsando botón de BARCODE.
+                                        {STATE_add_check,STATE_CANCEL,CRUDO},            // Cancelar añadir plato pulsando botón de CRUDO.
+                                        {STATE_add_check,STATE_CANCEL,COCINADO},         // Cancelar añadir plato pulsando botón de COCINADO.
+                                        {STATE_add_check,STATE_CANCEL,DELETE_PLATO},     // Cancelar añadir plato pulsando botón de BORRAR PLATO.
+                                        {STATE_add_check,STATE_CANCEL,GUARDAR},          // Cancelar añadir plato pulsando botón de GUARDAR.
+                                        {STATE_add_check,STATE_CANCEL,CANCELAR},         // Cancelar añadir plato tras 10 segundos de inactividad.
+                                        {STATE_add_check,STATE_ERROR,ERROR},             // Acción incorrecta (solo salta si se manipula la báscula).
+                                        // --------------------------
+
+                                        // --- Plato añadido ---
+                                        {STATE_added,STATE_added,TARAR},                        // Taramos para saber (en negativo) cuánto se va quitando al retirar el plato para LIBERAR.
+                                        {STATE_added,STATE_added,DECREMENTO},                   // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR).
+                                        {STATE_added,STATE_added,INCREMENTO},                   // Para evitar error de evento cuando, al retirar el plato, pueda detectar un ligero incremento.
+                                        {STATE_added,STATE_Init,LIBERAR},                       // Se ha retirado el plato completo (+ recipiente) tras añadir uno nuevo.
+                                        {STATE_added,STATE_ERROR,ERROR},                        // Acción incorrecta
+                                        {STATE_added,STATE_AVISO,AVISO_PLATO_EMPTY_NOT_ADDED},  // No se ha añadido un plato porque el actual está vacío
+                                        {STATE_added,STATE_Init,GO_TO_INIT},                    // Se regresa automáticamente a STATE_Init tras añadir el plato post STATE_REMOVAL_CHECK
+                                        // ---------------------
+
+                                        // --- Check eliminar plato ---
+                                        {STATE_delete_check,STATE_deleted,DELETE_PLATO},    // Confirmar eliminar plato.
+                                        {STATE_delete_check,STATE_CANCEL,TIPO_A},           // Cancelar eliminar plato pulsando botón de grupo tipoA.
+                                        {STATE_delete_check,STATE_CANCEL,TIPO_B},           // Cancelar eliminar plato pulsando botón de grupo tipoB.
+                                        {STATE_delete_check,STATE_CANCEL,BARCODE},          // Cancelar eliminar plato pulsando botón de BARCODE.
+                                        {STATE_delete_check,STATE_CANCEL,CRUDO},            // Cancelar eliminar plato pulsando botón de CRUDO.
+                                        {STATE_delete_check,STATE_CANCEL,COCINADO},         // Cancelar eliminar plato pulsando botón de COCINADO.
+                                        {STATE_delete_check,STATE_CANCEL,ADD_PLATO},        // Cancelar eliminar plato pulsando botón de AÑADIR PLATO.
+                                        {STATE_delete_check,STATE_CANCEL,GUARDAR},          // Cancelar eliminar plato pulsando botón de GUARDAR.
+                                        {STATE_delete_check,STATE_CANCEL,CANCELAR},         // Cancelar eliminar plato tras 10 segundos de inactividad.
+                                        {STATE_delete_check,STATE_ERROR,ERROR},             // Acción incorrecta (solo salta si se manipula la báscula).
+                                        // --------------------------
+
+                                        // --- Plato eliminado ---
+                                        {STATE_deleted,STATE_deleted,TARAR},                        // Taramos para saber (en negativo) cuánto se va quitando al retirar el plato para LIBERAR.
+                                        {STATE_deleted,STATE_deleted,DECREMENTO},                   // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR).
+                                        {STATE_deleted,STATE_deleted,INCREMENTO},                   // Para evitar error de evento cuando, al retirar el plato, pueda detectar un ligero incremento.
+                                        {STATE_deleted,STATE_Init,LIBERAR},                         // Se ha retirado el plato completo (+ recipiente) tras borrar. 
+                                        {STATE_deleted,STATE_ERROR,ERROR},                          // Acción incorrecta
+                                        {STATE_deleted,STATE_AVISO,AVISO_PLATO_EMPTY_NOT_DELETED},  // No se ha eliminado el plato porque está vacío
+                                        {STATE_deleted,STATE_Init,GO_TO_INIT},                      // Se regresa automáticamente a STATE_Init tras borrar el plato post STATE_REMOVAL_CHECK
+                                        // -----------------------
+
+                                        // --- Check guardar comida ---
+                                        {STATE_save_check,STATE_saved,GUARDAR},          // Confirmar guardar comida.
+                                        {STATE_save_check,STATE_CANCEL,TIPO_A},          // Cancelar guardar comida pulsando botón de grupo tipoA.
+                                        {STATE_save_check,STATE_CANCEL,TIPO_B},          // Cancelar guardar comida pulsando botón de grupo tipoB.
+                                        {STATE_save_check,STATE_CANCEL,BARCODE},         // Cancelar guardar comida pulsando botón de BARCODE.
+                                        {STATE_save_check,STATE_CANCEL,CRUDO},           // Cancelar guardar comida pulsando botón de CRUDO.
+                                        {STATE_save_check,STATE_CANCEL,COCINADO},        // Cancelar guardar comida pulsando botón de COCINADO.
+                                        {STATE_save_check,STATE_CANCEL,ADD_PLATO},       // Cancelar guardar comida pulsando botón de AÑADIR PLATO.
+                                        {STATE_save_check,STATE_CANCEL,DELETE_PLATO},    // Cancelar guardar comida pulsando botón de BORRAR PLATO.
+                                        {STATE_save_check,STATE_CANCEL,CANCELAR},        // Cancelar guardar comida tras 10 segundos de inactividad.
+                                        {STATE_save_check,STATE_ERROR,ERROR},            // Acción incorrecta (solo salta si se manipula la báscula).
+                                        // --------------------------
+
+                                        // --- Comida guardada ---
+                                        {STATE_saved,STATE_saved,TARAR},                        // Taramos para saber (en negativo) cuánto se va quitando al retirar el plato para LIBERAR.
+                                        {STATE_saved,STATE_saved,DECREMENTO},                   // Para evitar error de evento cuando pase por condiciones que habilitan DECREMENTO (previo a LIBERAR).
+                                        {STATE_saved,STATE_saved,INCREMENTO},                   // Para evitar error de evento cuando, al retirar el plato, pueda detectar un ligero incremento.
+                                        {STATE_saved,STATE_Init,LIBERAR},                       // Se ha retirado el plato completo (+ recipiente) tras guardar correctamente.  
+                                        {STATE_saved,STATE_Init,GO_TO_INIT},                    // Se regresa automáticamente a STATE_Init tras guardar la comida (también post STATE_REMOVAL_CHECK)
+                                        {STATE_saved,STATE_ERROR,ERROR},                        // Acción incorrecta
+                                        {STATE_saved,STATE_AVISO,AVISO_COMIDA_EMPTY_NOT_SAVED}, // No se ha guardado la comida porque está vacía
+                                        // -----------------------
+
+
+                                        // --- ERROR DE EVENTO ---
+                                        {STATE_ERROR,STATE_Init,GO_TO_INIT},                    // Regresar a STATE_Init tras mostrar error cometido allí o tras cometer error una vez retirado el plato sin avisar
+                                        {STATE_ERROR,STATE_Plato,GO_TO_PLATO},                  // Regresar a STATE_Plato tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_Grupo,GO_TO_GRUPO},                  // Regresar a STATE_Grupo tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_Barcode_read,GO_TO_BARCODE_READ},    // Regresar a STATE_Barcode_read tras mostrar error cometido allí o en STATE_Grupo pero se pulsa botón de barcode durante error
+                                        {STATE_ERROR,STATE_Barcode,GO_TO_BARCODE},              // Regresar a STATE_Barcode tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_raw,GO_TO_RAW},                      // Regresar a STATE_raw tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_cooked,GO_TO_COOKED},                // Regresar a STATE_cooked tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_weighted,GO_TO_WEIGHTED},            // Regresar a STATE_weighted tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_add_check,GO_TO_ADD_CHECK},          // Regresar a STATE_add_check tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_added,GO_TO_ADDED},                  // Regresar a STATE_added tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_delete_check,GO_TO_DELETE_CHECK},    // Regresar a STATE_delete_check tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_deleted,GO_TO_DELETED},              // Regresar a STATE_deleted tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_save_check,GO_TO_SAVE_CHECK},        // Regresar a STATE_save_check tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_saved,GO_TO_SAVED},                  // Regresar a STATE_saved tras mostrar error cometido allí
+                                        {STATE_ERROR,STATE_CANCEL,GO_TO_CANCEL},                // Ir a STATE_CANCEL si se ha cancelado un acción iniciada durante error
+                                        // -----------------------
+
+
+                                        // --- CANCELAR ----------
+                                        {STATE_CANCEL,STATE_Init,GO_TO_INIT},           // Regresar a STATE_Init tras cancelar acción de guardar iniciada desde STATE_Init
+                                        {STATE_CANCEL,STATE_Plato,GO_TO_PLATO},         // Regresar a STATE_Plato tras cancelar acción de leer barcode iniciada desde STATE_Plato
+                                        {STATE_CANCEL,STATE_Grupo,GO_TO_GRUPO},         // Regresar a STATE_Grupo tras cancelar add/delete/save o leer barcode iniciada desde STATE_Grupo
+                                        {STATE_CANCEL,STATE_Barcode,GO_TO_BARCODE},     // Regresar a STATE_Barcode tras cancelar add/delete/save o leer otro barcode iniciada desde STATE_Barcode
+                                        {STATE_CANCEL,STATE_raw,GO_TO_RAW},             // Regresar a STATE_raw tras cancelar add/delete/save o leer barcode iniciada desde STATE_raw   
+                                        {STATE_CANCEL,STATE_cooked,GO_TO_COOKED},       // Regresar a STATE_cooked tras cancelar add/delete/save o leer barcode iniciada desde STATE_cooked
+                                        {STATE_CANCEL,STATE_weighted,GO_TO_WEIGHTED},   // Regresar a STATE_weighted tras cancelar add/delete/save o leer barcode iniciada desde STATE_weighted
+                                        {STATE_CANCEL,STATE_ERROR,ERROR},               // Acción incorrecta. No suele ocurrir, pero si ocurre y no se gestiona, se quedaría 
+                                                                                        // en bucle marcando error.    
+                                        #ifdef BORRADO_INFO_USUARIO
+                                        {STATE_CANCEL,STATE_DELETE_FILES_CHECK,DELETE_FILES},  // INICIAR BORRADO DE FICHEROS USUARIO (se marca DELETE_FILES pulsando botón grupo 1 durante cancelación)
+                                        #endif
+                                        // -----------------------
+
+
+                                        // --- AVISO -------------
+                                        {STATE_AVISO,STATE_Init,GO_TO_INIT},            // Regresar a Init tras 3 segundos de warning
+                                        {STATE_AVISO,STATE_Plato,GO_TO_PLATO},          // Regresar a STATE_Plato tras 3 segundos de warning
+                                        {STATE_AVISO,STATE_Grupo,GO_TO_GRUPO},          // Regresar a STATE_Grupo tras 3 segundos de warning
+                                        {STATE_AVISO,STATE_Barcode,GO_TO_BARCODE},      // Regresar a GO_TO_BARCODE tras 3 segundos de warning por intentar marcar crudo/cocinado
+                                        {STATE_AVISO,STATE_ERROR,ERROR},                // Acción incorrecta durante aviso. Cualquier cosa es acción incorrecta. Igual que en Cancelar.
+                                        // -----------------------
+
+
+                                         // --- CHECK DELETE FILES ---
+                                         #ifdef BORRADO_INFO_USUARIO
+                                        {STATE_DELETE_FILES_CHECK,STATE_DELETED_FILES,DELETE_FILES},    // CONFIRMAR BORRAR FICHEROS DEL USUARIO (se marca DELETE_FILES pulsando botón grupo 20)
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,TIPO_A},               // Cancelar borrar ficheros del usuario pulsando botón de grupo tipoA.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,TIPO_B},               // Cancelar borrar ficheros del usuario pulsando botón de grupo tipoB (excepto grupo 20).
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,BARCODE},              // Cancelar borrar ficheros del usuario pulsando botón de BARCODE.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,CRUDO},                // Cancelar borrar ficheros del usuario pulsando botón de CRUDO.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,COCINADO},             // Cancelar borrar ficheros del usuario pulsando botón de COCINADO.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,ADD_PLATO},            // Cancelar borrar ficheros del usuario pulsando botón de AÑADIR PLATO.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,DELETE_PLATO},         // Cancelar borrar ficheros del usuario pulsando botón de BORRAR PLATO.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,GUARDAR},              // Cancelar borrar ficheros del usuario pulsando botón de GUARDAR.
+                                        {STATE_DELETE_FILES_CHECK,STATE_CANCEL,CANCELAR},             // Cancelar automáticamente el borrar ficheros del usuario tras 5 segundos de inactividad.
+                                        // --------------------------
+
+                                        // --- FICHEROS BORRADOS ---
+                                        {STATE_DELETED_FILES,STATE_Init,GO_TO_INIT},         // Regresar a STATE_Init tras BORRAR FICHEROS USUARIO (siempre iniciado desde STATE_Init)
+                                        #endif // BORRADO_INFO_USUARIO
+                                        // ---------------------
+
+                                        // --- UPLOAD DATA TO DATABASE ---
+                                        {STATE_UPLOAD_DATA,STATE_Init,GO_TO_INIT},         // Regresar a STATE_Init tras subir o no la info acumulada
+                                        // ---------------------
+                                      
+                                      
+                                        // --- RETIRADA DE PLATO IMPREVISTA ---
+                                        // Indicar intención: En estos casos, nos saltamos el estado de confirmación (add_check, delete_check o save_check) porque se confirma al pulsar su botón
+                                        {STATE_REMOVAL_CHECK,STATE_added,ADD_PLATO},       // Al retirar plato sin avisar se quería "guardar" y añadir otro plato
+                                        {STATE_REMOVAL_CHECK,STATE_deleted,DELETE_PLATO},  // Al retirar plato sin avisar se quería borrar el plato retirado
+                                        {STATE_REMOVAL_CHECK,STATE_saved,GUARDAR},          // Al retirar plato sin avisar se quería guardar la comida (no suelen hacer esto)
+                                        // Borrado automático:
+                                        {STATE_REMOVAL_CHECK,STATE_Init,GO_TO_INIT},       // Regresar directamente a STATE_Init tras comprobar no había nada en la comida para "guardar" o eliminar 
+                                                                                           // Si pasan 30 segundos sin que indique nada, vamos a STATE_Init asumiendo que se quiere borrar, como antes
+                                        // Evitar error de evento si se toca la báscula una vez ya retirado el plato:
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,DECREMENTO},  // Por si se toca la báscula (que se supone que está vacía) en lugar de indicar la intención al retirar el plato
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,INCREMENTO},   // Por si se toca la báscula (que se supone que está vacía) en lugar de indicar la intención al retirar el plato
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,LIBERAR},     // Por si se toca la báscula (que se supone que está vacía) en lugar de indicar la intención al retirar el plato
+                                        // Evitar error de evento si algún iluminado pulsa otros botones en lugar de responder:
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,TIPO_A},      // Por si se pulsa un grupo de TIPO_A en lugar de indicar la intención al retirar el plato
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,TIPO_B},      // Por si se pulsa un grupo de TIPO_B en lugar de indicar la intención al retirar el plato
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,BARCODE},     // Por si se pulsa el botón de barcode en lugar de indicar la intención al retirar el plato
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,CRUDO},       // Por si se pulsa el botón de crudo en lugar de indicar la intención al retirar el plato
+                                        {STATE_REMOVAL_CHECK,STATE_REMOVAL_CHECK,COCINADO}    // Por si se pulsa el botón de cocinado en lugar de indicar la intención al retirar el plato
+                                        // ------------------------------------
+                                      };
+
+
+
+/*----------------------------------------------------------------------------------------------*/
+/*------------------------------ TABLA TRANSICIONES --------------------------------------------*/
+/*----------------------------------------------------------------------------------------------*/
+/*  Las funciones son constexpr de C++11 (un solo return), así que los recorridos de 'rules' se
+    hacen dividiendo el rango por la mitad. Así la profundidad de la recursión es log2(RULES)
+    en lugar de RULES y no se pasa del límite del compilador.
+*/
+
+/**
+ * @brief Primera regla (índice) del rango [desde, hasta) para el estado y evento dados, o RULES si no hay.
+ */
+constexpr unsigned primeraRegla(unsigned estado, unsigned evento, unsigned desde, unsigned hasta);
+
+constexpr unsigned elegirRegla(unsigned izquierda, unsigned derecha){ return (izquierda != RULES) ? izquierda : derecha; }
+
+constexpr unsigned primeraRegla(unsigned estado, unsigned evento, unsigned desde, unsigned hasta)
+{
+    return (hasta - desde == 1) ? (((rules[desde].state_i == estado) and (rules[desde].condition == evento)) ? desde : RULES)
+                                : elegirRegla(primeraRegla(estado, evento, desde, (desde + hasta) / 2),
+                                              primeraRegla(estado, evento, (desde + hasta) / 2, hasta));
+}
+
+
+/**
+ * @brief Estado siguiente de una celda de la tabla (celda = estado * NUM_EVENTOS + evento).
+ */
+constexpr byte estadoDeRegla(unsigned regla){ return (regla == RULES) ? SIN_TRANSICION : (byte)rules[regla].state_j; }
+constexpr byte estadoSiguiente(unsigned celda){ return estadoDeRegla(primeraRegla(celda / NUM_EVENTOS, celda % NUM_EVENTOS, 0, RULES)); }
+
+
+/**
+ * @brief Comprobaciones de cada regla.
+ */
+constexpr bool reglaFueraDeRango(unsigned i)
+{
+    return (rules[i].state_i == 0) or (rules[i].state_i >= NUM_ESTADOS)     // state_i == 0: faltan reglas para llegar a RULES (relleno con ceros)
+            or (rules[i].state_j == 0) or (rules[i].state_j >= NUM_ESTADOS)
+            or (rules[i].condition >= NUM_EVENTOS);
+}
+constexpr bool reglaRepetida(unsigned i){ return primeraRegla(rules[i].state_i, rules[i].condition, 0, RULES) != i; }
+constexpr bool reglaEnConflicto(unsigned i){ return reglaRepetida(i) and (rules[primeraRegla(rules[i].state_i, rules[i].condition, 0, RULES)].state_j != rules[i].state_j); }
+
+#define CONTAR_REGLAS(nombre, comprobacion) \
+    constexpr unsigned nombre(unsigned desde, unsigned hasta) \
+    { \
+        return (hasta - desde == 1) ? (comprobacion(desde) ? 1 : 0) : nombre(desde, (desde + hasta) / 2) + nombre((desde + hasta) / 2, hasta); \
+    }
+
+CONTAR_REGLAS(contarReglasFueraDeRango, reglaFueraDeRango)
+CONTAR_REGLAS(contarReglasRepetidas, reglaRepetida)
+CONTAR_REGLAS(contarReglasEnConflicto, reglaEnConflicto)
+
+static_assert(contarReglasFueraDeRango(0, RULES) == 0, "Reglas de transicion: RULES no coincide con el numero de reglas o hay estados/eventos fuera de rango");
+static_assert(contarReglasEnConflicto(0, RULES) == 0, "Reglas de transicion: hay reglas con el mismo estado y evento y distinto estado siguiente");
+static_assert(contarReglasRepetidas(0, RULES) == 0, "Reglas de transicion: hay reglas repetidas");
+
+
+/**
+ * @brief Secuencia 0..N-1 de índices de celda para inicializar la tabla (en C++11 no existe std::make_index_sequence).
+ *        Se genera uniendo dos mitades para que la profundidad de plantillas sea log2(N).
+ */
+template<unsigned... I> struct indicesTabla { typedef indicesTabla type; };
+
+template<class A, class B> struct unirIndicesTabla;
+template<unsigned... I, unsigned... J> struct unirIndicesTabla<indicesTabla<I...>, indicesTabla<J...> > : indicesTabla<I..., (sizeof...(I) + J)...> {};
+
+template<unsigned N> struct generarIndicesTabla : unirIndicesTabla<typename generarIndicesTabla<N / 2>::type, typename generarIndicesTabla<N - N / 2>::type> {};
+template<> struct generarIndicesTabla<0> : indicesTabla<> {};
+template<> struct generarIndicesTabla<1> : indicesTabla<0> {};
+
+
+/**
+ * @struct tabla_transiciones_t
+ * @brief Tabla densa [estado][evento] con el estado siguiente o SIN_TRANSICION.
+ */
+typedef struct
+{
+    byte siguiente[NUM_ESTADOS][NUM_EVENTOS];
+} tabla_transiciones_t;
+
+template<unsigned... I>
+constexpr tabla_transiciones_t generarTablaTransiciones(indicesTabla<I...>){ return {{ estadoSiguiente(I)... }}; }
+
+
+/**
+ * @brief Tabla de transiciones generada al compilar a partir de 'rules'. Es constante, así que queda en flash.
+ */
+constexpr tabla_transiciones_t tablaTransiciones = generarTablaTransiciones(generarIndicesTabla<NUM_ESTADOS * NUM_EVENTOS>::type());
+
+
+/**
+ * @brief Estado siguiente para el estado y evento dados, o SIN_TRANSICION si no hay regla.
+ */
+inline byte buscarTransicion(state_t estado, event_t evento){ return tablaTransiciones.siguiente[estado][evento]; }
+
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file Texto_Latin1.h
+ * @brief Conversión de texto UTF-8 a Latin-1 (ISO 8859-1) para la fuente interna de la RA8876: al
+ *        compilar para los textos fijos y en una sola pasada, sin reservar memoria, para los que
+ *        llegan en ejecución
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Los fuentes están en UTF-8 (2 bytes por vocal acentuada) y la fuente interna de la RA8876 es
+ * Latin-1 (1 byte por carácter, Table 14-1 del datasheet). Antes cada texto se convertía al dibujarlo
+ * con convertSpecialCharactersToHEX(): una copia del String y 17 String::replace(), cada uno con sus
+ * reservas en el heap, también para los textos fijos como "PROTEÍNAS: " en cada refresco del dashboard.
+ *
+ *      LATIN1("PROTEÍNAS: ")       --> const char* al texto convertido al compilar (constante en flash).
+ *                                      Solo con literales y dentro de una función.
+ *      TEXTO_LATIN1("Legumbres")   --> El texto convertido como valor constexpr (textoLatin1_t), para
+ *                                      inicializar tablas.
+ *      utf8ALatin1(texto)          --> Convierte en el sitio un texto recibido en ejecución (nombre de
+ *                                      un producto de OpenFoodFacts). Nunca se alarga, así que no reserva.
+ *
+ * Las tres usan las mismas reglas (bytesCaracter() y caracterLatin1()): U+0000..U+00FF pasan a su byte
+ * Latin-1, "..." y '…' a 0x85 (puntos suspensivos en la fuente de la RA8876) y el resto de caracteres,
+ * que la fuente no tiene, o los bytes que no son UTF-8 válido, a '?'.
+ *
+ * @see https://cs.stanford.edu/people/miles/iso8859.html Colección de caracteres ASCII/ISO 8859-1 (Latin-1) en HEX
+ * @see https://www.raio.com.tw/data_raio/Datasheet/RA887677/RA8876_Brief_DS_V11_Eng.pdf Table 14-1 (pag 99) del datasheet de RA8876 para caracteres Latin-1
+ */
+
+#ifndef TEXTO_LATIN1_H
+#define TEXTO_LATIN1_H
+
+#include <stddef.h>
+
+
+#define LATIN1_PUNTOS_SUSPENSIVOS   '\x85'
+#define LATIN1_DESCONOCIDO          '?'
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                     REGLAS DE CONVERSIÓN (COMPILACIÓN Y EJECUCIÓN)
+/******************************************************************************/
+/******************************************************************************/
+// constexpr de C++11: una sola expresión por función. Las lecturas van encadenadas con 'and' para
+// no pasar nunca del '\0' final (al compilar sería un error y en ejecución, leer fuera del texto).
+
+constexpr unsigned char byteTexto(const char *s, size_t i){ return (unsigned char)s[i]; }
+constexpr bool esContinuacion(const char *s, size_t i){ return (byteTexto(s, i) & 0xC0) == 0x80; }      // 10xxxxxx
+
+constexpr bool esTresPuntos(const char *s, size_t i){ return (s[i] == '.') and (s[i + 1] == '.') and (s[i + 2] == '.'); }
+constexpr bool esElipsis(const char *s, size_t i){ return (byteTexto(s, i) == 0xE2) and (byteTexto(s, i + 1) == 0x80) and (byteTexto(s, i + 2) == 0xA6); } // U+2026
+
+// Bytes que ocupa en el texto UTF-8 el carácter que empieza en s[i] (1 si no es UTF-8 válido)
+constexpr size_t bytesCaracter(const char *s, size_t i){
+    return esTresPuntos(s, i)                                                                               ? 3 :
+           (((byteTexto(s, i) & 0xE0) == 0xC0) and esContinuacion(s, i + 1))                                ? 2 :
+           (((byteTexto(s, i) & 0xF0) == 0xE0) and esContinuacion(s, i + 1) and esContinuacion(s, i + 2))   ? 3 :
+           (((byteTexto(s, i) & 0xF8) == 0xF0) and esContinuacion(s, i + 1) and esContinuacion(s, i + 2)
+                                               and esContinuacion(s, i + 3))                                ? 4 : 1;
+}
+
+// Byte Latin-1 del carácter que empieza en s[i]
+constexpr char caracterLatin1(const char *s, size_t i){
+    return (esTresPuntos(s, i) or esElipsis(s, i))                      ? LATIN1_PUNTOS_SUSPENSIVOS :
+           (byteTexto(s, i) < 0x80)                                     ? s[i] :
+           ((bytesCaracter(s, i) == 2) and (byteTexto(s, i) >= 0xC2)
+                                       and (byteTexto(s, i) <= 0xC3))   ? (char)(((byteTexto(s, i) & 0x03) << 6) | (byteTexto(s, i + 1) & 0x3F)) :
+                                                                          LATIN1_DESCONOCIDO;
+}
+
+// Posición en el texto UTF-8 del carácter n (la del '\0' si el texto tiene menos)
+constexpr size_t siguienteCaracter(const char *s, size_t i){ return (s[i] == '\0') ? i : i + bytesCaracter(s, i); }
+constexpr size_t posicionCaracter(const char *s, size_t n){ return (n == 0) ? 0 : siguienteCaracter(s, posicionCaracter(s, n - 1)); }
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                           TEXTOS FIJOS (AL COMPILAR)
+/******************************************************************************/
+/******************************************************************************/
+
+// Texto convertido en un array del mismo tamaño que el literal UTF-8: lo que sobra son '\0'
+template<size_t N> struct textoLatin1_t {
+    char c[N];
+};
+
+// Índices 0..N-1 para generar arrays al compilar: carácter a carácter un literal o, en Grupos.h, la tabla de IDs
+template<size_t... I> struct secuenciaIndices {};
+template<size_t N, size_t... I> struct crearSecuenciaIndices : crearSecuenciaIndices<N - 1, N - 1, I...> {};
+template<size_t... I> struct crearSecuenciaIndices<0, I...> { typedef secuenciaIndices<I...> tipo; };
+
+template<size_t N, size_t... I> constexpr textoLatin1_t<N> transcodificarLatin1(const char (&s)[N], secuenciaIndices<I...>){
+    return {{ caracterLatin1(s, posicionCaracter(s, I))... }};
+}
+
+#define TEXTO_LATIN1(literal)   transcodificarLatin1(literal, crearSecuenciaIndices<sizeof(literal)>::tipo())
+
+// La variable 'static constexpr' obliga a convertirlo al compilar y deja el resultado en flash
+#define LATIN1(literal)         ({ static constexpr textoLatin1_t<sizeof(literal)> textoLatin1 = TEXTO_LATIN1(literal); (const char*)textoLatin1.c; })
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                         TEXTOS VARIABLES (EN EJECUCIÓN)
+/******************************************************************************/
+/******************************************************************************/
+size_t  utf8ALatin1(char *texto);       // Convertir en el sitio un texto terminado en '\0'. Devuelve su nueva longitud
+void    utf8ALatin1(String &texto);     // Convertir en el sitio un String (solo acorta, no reserva)
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Convierte en el sitio un texto UTF-8 a Latin-1, en una pasada. Cada carácter ocupa lo mismo o
+ *        menos que antes, así que se escribe detrás de lo que se va leyendo.
+ * @param texto Texto terminado en '\0'
+ * @return Longitud del texto convertido
+ */
+/*-----------------------------------------------------------------------------*/
+size_t utf8ALatin1(char *texto)
+{
+    size_t j = 0;
+    for(size_t i = 0; texto[i] != '\0'; )
+    {
+        size_t n = bytesCaracter(texto, i);     // Antes de escribir: si j == i se pisa texto[i]
+        texto[j++] = caracterLatin1(texto, i);
+        i += n;
+    }
+    texto[j] = '\0';
+    return j;
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Convierte en el sitio un String UTF-8 a Latin-1. Solo usa setCharAt() y remove(), que no
+ *        cambian el buffer del String.
+ * @param texto Texto a convertir
+ */
+/*-----------------------------------------------------------------------------*/
+void utf8ALatin1(String &texto)
+{
+    const char *s = texto.c_str();
+    unsigned int j = 0;
+    for(unsigned int i = 0; s[i] != '\0'; )
+    {
+        size_t n = bytesCaracter(s, i);
+        texto.setCharAt(j++, caracterLatin1(s, i));
+        i += n;
+    }
+    texto.remove(j);
+}
+/******************************************************************************/
+/******************************************************************************/
+
+
+#endif
@@ -5,22 +5,127 @@
  * @author Irene Casares Rodríguez
  * @date 06/06/23
  * @version 1.0
- * 
+ *
  * Este archivo contiene la definición de la clase ValoresNutricionales, que representa al conjunto
  * de carbohidratos, lípidos, proteínas y sus respectivas raciones, así como kilocalorías.
- * 
+ *
  * La clase ValoresNutricionales permite establecer y obtener la cantidad de carbohidratos,
- * lípidos, proteínas y kcal, además de las raciones. 
+ * lípidos, proteínas y kcal, además de las raciones.
  * El objeto ValoresNutricionales se incluye en las clases Alimento, Plato, Comida y Diario.
- * 
+ *
+ * Los valores se guardan como enteros en milésimas (mg y cal, tipo 'milesimas_t'): el valor de cada
+ * alimento se redondea una sola vez al crearlo y a partir de ahí las sumas y restas del plato, la comida
+ * y el diario son exactas (borrar un plato deja la comida como estaba). Las raciones no se guardan, se
+ * calculan al pedirlas. Para escribirlos (CSV, petición HTTP y dashboard) se usa textoMilesimas(), que
+ * redondea al decimal pedido siempre igual, sin depender de la representación en float.
+ *
  * @see Alimento, Plato, Comida y Diario
- * 
+ *
  */
 
 #ifndef VALORES_NUTRICIONALES_H
 #define VALORES_NUTRICIONALES_H
 
 
+typedef int32_t milesimas_t; // Milésimas de gramo (mg) o de kcal (cal). Hasta 2147 kg o 2147000 kcal
+
+#define MILESIMAS_POR_UNIDAD    1000    // mg en 1 g o cal en 1 kcal
+#define MILESIMAS_POR_DECIMA    1000    // mg en 0.1 raciones (1 ración = 10 g)
+
+#define DECIMALES_CSV           2       // Decimales de los valores en el CSV y la petición HTTP (los de String(float))
+#define DECIMALES_DASHBOARD     1       // Decimales de los gramos en el dashboard (las kcal, sin decimales)
+
+#define LONGITUD_TEXTO_MILESIMAS  14    // "-2147483.648" + '\0' y margen
+
+const int32_t divisorDecimales[4] = { 1000, 100, 10, 1 }; // Milésimas en una unidad del último decimal, según los decimales
+
+
+
+
+// **************************************************************************************************************************
+// *****************      CONVERSIÓN Y TEXTO DE MILÉSIMAS       *************************************************************
+// **************************************************************************************************************************
+
+/*---------------------------------------------------------------------------------------------------------
+   aMilesimas(): Pasa un valor en gramos o kcal a milésimas, redondeando al más cercano (los empates,
+                 alejándose del 0).
+----------------------------------------------------------------------------------------------------------*/
+inline milesimas_t aMilesimas(float valor){
+  valor *= MILESIMAS_POR_UNIDAD;
+  return (milesimas_t)((valor >= 0.0f) ? (valor + 0.5f) : (valor - 0.5f));
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   dividirRedondeando(): Divide redondeando al entero más cercano (los empates, alejándose del 0), como
+                         round() pero sin pasar por float.
+----------------------------------------------------------------------------------------------------------*/
+inline int32_t dividirRedondeando(int32_t valor, int32_t divisor){
+  return (valor >= 0) ? ((valor + divisor/2) / divisor) : -((-valor + divisor/2) / divisor);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   leerMilesimas(): Lee un valor escrito con textoMilesimas() (p. ej. un campo del CSV) sin pasar por
+                    float, que con valores grandes ya no distingue las milésimas. Las cifras a partir
+                    de la cuarta decimal se ignoran.
+
+          Parámetros:
+                  texto - Texto con el valor ("-12.34"). Termina en el primer carácter que no es cifra
+          Return: Valor en milésimas
+----------------------------------------------------------------------------------------------------------*/
+milesimas_t leerMilesimas(const char *texto){
+  bool negativo = (*texto == '-');
+  if(negativo) texto++;
+
+  milesimas_t valor = 0;
+  while((*texto >= '0') and (*texto <= '9')) valor = valor*10 + (*texto++ - '0');
+  valor *= MILESIMAS_POR_UNIDAD;
+
+  if(*texto == '.')
+  {
+    texto++;
+    for(int32_t peso = MILESIMAS_POR_UNIDAD/10; (peso > 0) and (*texto >= '0') and (*texto <= '9'); peso /= 10) valor += (*texto++ - '0') * peso;
+  }
+
+  return negativo ? -valor : valor;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------
+   textoMilesimas(): Escribe un valor en milésimas con 'decimales' decimales (0 a 3), redondeado como
+                     dividirRedondeando(). Es el texto que se guarda en el CSV y se muestra en el dashboard.
+
+          Parámetros:
+                  texto - Buffer de al menos LONGITUD_TEXTO_MILESIMAS caracteres
+                  valor - Valor en milésimas
+                  decimales - Decimales a escribir
+          Return: 'texto'
+----------------------------------------------------------------------------------------------------------*/
+char* textoMilesimas(char *texto, milesimas_t valor, byte decimales){
+  if(decimales > 3) decimales = 3;
+
+  int32_t redondeado = dividirRedondeando(valor, divisorDecimales[decimales]); // En unidades del último decimal
+  uint32_t absoluto = (redondeado < 0) ? -redondeado : redondeado;
+
+  // Cifras de atrás hacia delante, con al menos una cifra entera
+  char cifras[LONGITUD_TEXTO_MILESIMAS];
+  byte n = 0;
+  do{
+    if((n == decimales) and (decimales > 0)) cifras[n++] = '.';
+    cifras[n++] = '0' + (absoluto % 10);
+    absoluto /= 10;
+  } while((absoluto > 0) or (n <= decimales));
+
+  byte i = 0;
+  if(redondeado < 0) texto[i++] = '-';
+  while(n > 0) texto[i++] = cifras[--n];
+  texto[i] = '\0';
+
+  return texto;
+}
+
+
 
 
 // **************************************************************************************************************************
@@ -31,16 +136,22 @@
  * @brief Clase que representa los valores nutricionales.
  */
 class ValoresNutricionales{
-  
+
   private:
-  
-    float   _carb;    /**< Valor de carbohidratos */
-    float   _lip;     /**< Valor de lípidos */
-    float   _prot;    /**< Valor de proteínas */
-    float   _kcal;    /**< Valor calórico */
-    float   _carb_R;  /**< Raciones de carbohidratos */
-    float   _lip_R;   /**< Raciones de lípidos */
-    float   _prot_R;  /**< Raciones de proteínas */
+
+    milesimas_t   _carb;    /**< Carbohidratos (mg) */
+    milesimas_t   _lip;     /**< Lípidos (mg) */
+    milesimas_t   _prot;    /**< Proteínas (mg) */
+    milesimas_t   _kcal;    /**< Valor calórico (cal) */
+
+
+    /**
+     * @brief Calcula las raciones de unos gramos en milésimas: gramos/10 redondeado al decimal más cercano.
+     *
+     * @param valor Valor en mg
+     * @return Raciones (siempre con 1 decimal)
+     */
+    static inline float _raciones(milesimas_t valor){ return dividirRedondeando(valor, MILESIMAS_POR_DECIMA) / 10.0f; };
 
 
 
@@ -52,14 +163,14 @@ class ValoresNutricionales{
 
     /**
      * @brief Constructor por defecto de la clase ValoresNutricionales.
-     *        Inicializa los valores nutricionales a 0.0 y calcula automáticamente las raciones correspondientes.
+     *        Inicializa los valores nutricionales a 0.
      */
     ValoresNutricionales();
 
     /**
      * @brief Constructor de la clase ValoresNutricionales.
-     *        Inicializa los valores nutricionales según los parámetros pasados como argumentos y calcula automáticamente las raciones correspondientes.
-     * 
+     *        Inicializa los valores nutricionales según los parámetros pasados como argumentos, en gramos y kcal.
+     *
      * @param carb Valor de carbohidratos
      * @param lip Valor de lípidos
      * @param prot Valor de proteínas
@@ -75,30 +186,32 @@ class ValoresNutricionales{
     // ----------------------------------------------------------------------
 
     /**
-     * @brief Establece el valor de carbohidratos y calcula las raciones correspondientes.
-     * 
-     * @param carb Valor de carbohidratos a establecer
+     * @brief Establece el valor de carbohidratos.
+     *
+     * @param carb Valor de carbohidratos a establecer (g)
      */
-    inline void setCarbValores(float carb){ _carb = carb; this->computeCarbRaciones();  };
+    inline void setCarbValores(float carb){ _carb = aMilesimas(carb); };
 
     /**
-     * @brief Calcula las raciones de carbohidratos a partir del valor establecido.
+     * @brief Obtiene el valor de carbohidratos.
+     *
+     * @return El valor de carbohidratos (g)
      */
-    void computeCarbRaciones();
+    inline float getCarbValores() const { return (float)_carb / MILESIMAS_POR_UNIDAD; };
 
     /**
-     * @brief Obtiene el valor de carbohidratos.
-     * 
-     * @return El valor de carbohidratos
+     * @brief Obtiene el valor de carbohidratos en milésimas.
+     *
+     * @return El valor de carbohidratos (mg)
      */
-    inline float getCarbValores(){ return _carb; };
+    inline milesimas_t getCarbMilesimas() const { return _carb; };
 
     /**
-     * @brief Obtiene las raciones de carbohidratos.
-     * 
+     * @brief Obtiene las raciones de carbohidratos, calculadas a partir del valor.
+     *
      * @return Las raciones de carbohidratos
      */
-    inline float getCarbRaciones(){ return _carb_R; };
+    inline float getCarbRaciones() const { return _raciones(_carb); };
 
 
 
@@ -108,30 +221,32 @@ class ValoresNutricionales{
     // ----------------------------------------------------------------------
 
     /**
-     * @brief Establece el valor de lípidos y calcula las raciones correspondientes.
-     * 
-     * @param lip Valor de lípidos a establecer
+     * @brief Establece el valor de lípidos.
+     *
+     * @param lip Valor de lípidos a establecer (g)
      */
-    inline void setLipValores(float lip){ _lip = lip; this->computeLipRaciones(); };
+    inline void setLipValores(float lip){ _lip = aMilesimas(lip); };
 
     /**
-     * @brief Calcula las raciones de lípidos a partir del valor establecido.
+     * @brief Obtiene el valor de lípidos.
+     *
+     * @return El valor de lípidos (g)
      */
-    void computeLipRaciones();
+    inline float getLipValores() const { return (float)_lip / MILESIMAS_POR_UNIDAD; };
 
     /**
-     * @brief Obtiene el valor de lípidos.
-     * 
-     * @return El valor de lípidos
+     * @brief Obtiene el valor de lípidos en milésimas.
+     *
+     * @return El valor de lípidos (mg)
      */
-    inline float getLipValores(){ return _lip; };
+    inline milesimas_t getLipMilesimas() const { return _lip; };
 
     /**
-     * @brief Obtiene las raciones de lípidos.
-     * 
+     * @brief Obtiene las raciones de lípidos, calculadas a partir del valor.
+     *
      * @return Las raciones de lípidos
      */
-    inline float getLipRaciones(){ return _lip_R; };
+    inline float getLipRaciones() const { return _raciones(_lip); };
 
 
 
@@ -141,30 +256,32 @@ class ValoresNutricionales{
     // ----------------------------------------------------------------------
 
     /**
-     * @brief Establece el valor de proteínas y calcula las raciones correspondientes.
-     * 
-     * @param prot Valor de proteínas a establecer
+     * @brief Establece el valor de proteínas.
+     *
+     * @param prot Valor de proteínas a establecer (g)
      */
-    inline void setProtValores(float prot){ _prot = prot; this->computeProtRaciones(); };
+    inline void setProtValores(float prot){ _prot = aMilesimas(prot); };
 
     /**
-     * @brief Calcula las raciones de proteínas a partir del valor establecido.
+     * @brief Obtiene el valor de proteínas.
+     *
+     * @return El valor de proteínas (g)
      */
-    void computeProtRaciones();
+    inline float getProtValores() const { return (float)_prot / MILESIMAS_POR_UNIDAD; };
 
     /**
-     * @brief Obtiene el valor de proteínas.
-     * 
-     * @return El valor de proteínas
+     * @brief Obtiene el valor de proteínas en milésimas.
+     *
+     * @return El valor de proteínas (mg)
      */
-    inline float getProtValores(){ return _prot; };
+    inline milesimas_t getProtMilesimas() const { return _prot; };
 
     /**
-     * @brief Obtiene las raciones de proteínas.
-     * 
+     * @brief Obtiene las raciones de proteínas, calculadas a partir del valor.
+     *
      * @return Las raciones de proteínas
      */
-    inline float getProtRaciones(){ return _prot_R; };
+    inline float getProtRaciones() const { return _raciones(_prot); };
 
 
 
@@ -175,17 +292,24 @@ class ValoresNutricionales{
 
     /**
      * @brief Establece el valor calórico.
-     * 
-     * @param Kcal Valor calórico a establecer
+     *
+     * @param Kcal Valor calórico a establecer (kcal)
      */
-    inline void setKcalValores(float Kcal){ _kcal = Kcal; };
+    inline void setKcalValores(float Kcal){ _kcal = aMilesimas(Kcal); };
 
     /**
      * @brief Obtiene el valor calórico.
-     * 
-     * @return El valor calórico
+     *
+     * @return El valor calórico (kcal)
+     */
+    inline float getKcalValores() const { return (float)_kcal / MILESIMAS_POR_UNIDAD; };
+
+    /**
+     * @brief Obtiene el valor calórico en milésimas.
+     *
+     * @return El valor calórico (cal)
      */
-    inline float getKcalValores(){ return _kcal; };
+    inline milesimas_t getKcalMilesimas() const { return _kcal; };
 
 
 
@@ -196,21 +320,52 @@ class ValoresNutricionales{
 
     /**
      * @brief Establece los valores de carbohidratos, lípidos, proteínas y valor calórico a partir de un objeto ValoresNutricionales.
-     * 
+     *
      * @param val Objeto ValoresNutricionales a partir del cual se establecen los valores
      */
-    void setValores(ValoresNutricionales val);
+    inline void setValores(const ValoresNutricionales &val){ *this = val; };
 
     /**
      * @brief Establece los valores de carbohidratos, lípidos, proteínas y valor calórico a partir de los parámetros pasados como argumentos.
-     * 
-     * @param carb Valor de carbohidratos
-     * @param lip Valor de lípidos
-     * @param prot Valor de proteínas
-     * @param kcal Valor calórico
+     *
+     * @param carb Valor de carbohidratos (g)
+     * @param lip Valor de lípidos (g)
+     * @param prot Valor de proteínas (g)
+     * @param kcal Valor calórico (kcal)
      */
     void setValores(float carb, float lip, float prot, float kcal);
 
+    /**
+     * @brief Establece los valores de carbohidratos, lípidos, proteínas y valor calórico en milésimas, sin redondear.
+     *
+     * @param carb Valor de carbohidratos (mg)
+     * @param lip Valor de lípidos (mg)
+     * @param prot Valor de proteínas (mg)
+     * @param kcal Valor calórico (cal)
+     */
+    void setValoresMilesimas(milesimas_t carb, milesimas_t lip, milesimas_t prot, milesimas_t kcal);
+
+    /**
+     * @brief Suma a los valores actuales los de otro objeto (en el sitio, sin redondeos).
+     *
+     * @param val Valores a sumar
+     */
+    void sumar(const ValoresNutricionales &val);
+
+    /**
+     * @brief Resta a los valores actuales los de otro objeto (en el sitio, sin redondeos).
+     *
+     * @param val Valores a restar
+     */
+    void restar(const ValoresNutricionales &val);
+
+    /**
+     * @brief Redondea los valores a 'decimales' decimales, como se escriben con textoMilesimas().
+     *
+     * @param decimales Decimales a conservar (0 a 3)
+     */
+    void redondear(byte decimales);
+
 };
 
 
@@ -229,142 +384,108 @@ class ValoresNutricionales{
 // --------------------------------------------------------------------------------------------------------------------------
 
 /*---------------------------------------------------------------------------------------------------------
-   ValoresNutricionales(): Constructor de la clase ValoresNutricionales que inicializa sus valores 
-                           a 0.0, calculando automáticamente las raciones correspondientes a partir
-                           de esos valores. Es decir, 0.0 también.
+   ValoresNutricionales(): Constructor de la clase ValoresNutricionales que inicializa sus valores a 0.
 ----------------------------------------------------------------------------------------------------------*/
 ValoresNutricionales::ValoresNutricionales(){
-  this->setCarbValores(0.0);
-  this->setLipValores(0.0);
-  this->setProtValores(0.0);
-  this->setKcalValores(0.0);
+  this->setValoresMilesimas(0, 0, 0, 0);
 }
 
 
 /*---------------------------------------------------------------------------------------------------------
-   ValoresNutricionales(): Constructor de la clase ValoresNutricionales que inicializa sus valores 
-                           según los parámetros pasados como argumentos, calculando automáticamente 
-                           las raciones correspondientes.
+   ValoresNutricionales(): Constructor de la clase ValoresNutricionales que inicializa sus valores
+                           según los parámetros pasados como argumentos, en gramos y kcal.
 ----------------------------------------------------------------------------------------------------------*/
 ValoresNutricionales::ValoresNutricionales(float carb, float lip, float prot, float kcal){
-  this->setCarbValores(carb);
-  this->setLipValores(lip);
-  this->setProtValores(prot);
-  this->setKcalValores(kcal);
+  this->setValores(carb, lip, prot, kcal);
 }
 
 
 
 // --------------------------------------------------------------------------------------------------------------------------
-// *****************          CARBOHIDRATOS           ***********************************************************************
+// *****************       VALORES NUTRICIONALES (TODOS)        *************************************************************
 // --------------------------------------------------------------------------------------------------------------------------
 
 /*---------------------------------------------------------------------------------------------------------
-   computeCarbRaciones(): Calcula las raciones de carbohidratos según el valor establecido. Divide entre 10
-                          y redondea al entero más cercano si el valor es menor que .3 o mayor que .7 
-                          Si el valor está entre .3 y .7, se redondea a .5 
-----------------------------------------------------------------------------------------------------------*/
-/*void ValoresNutricionales::computeCarbRaciones(){
-  _carb_R = round(2.0*(this->getCarbValores()/10));   // 0.3 <= raciones <= 0.7   ------->  raciones = 0.5
-  _carb_R = _carb_R/2;
-}*/
-/*---------------------------------------------------------------------------------------------------------
-   computeCarbRaciones(): Calcula las raciones de carbohidratos según el valor establecido. Divide entre 10
-                          para redondear al decimal más cercano y luego multiplica por 10 para volver a la
-                          escala original, pero manteniendo siempre 1 decimal. 
+   setValores(): Establece los valores nutricionales del objeto actual a partir de los valores pasados como
+                 argumentos, redondeándolos a milésimas.
+
+          Parámetros:
+                  carb - Valor de carbohidratos a establecer (g)
+                  lip - Valor de lípidos a establecer (g)
+                  prot - Valor de proteínas a establecer (g)
+                  kcal - Valor de kilocalorías a establecer (kcal)
 ----------------------------------------------------------------------------------------------------------*/
-void ValoresNutricionales::computeCarbRaciones(){
-  _carb_R = round(10.0*(this->getCarbValores()/10));   // Redondea al decimal más cercano
-  _carb_R = _carb_R/10;
+void ValoresNutricionales::setValores(float carb, float lip, float prot, float kcal){
+  this->setCarbValores(carb);
+  this->setLipValores(lip);
+  this->setProtValores(prot);
+  this->setKcalValores(kcal);
 }
 
 
-
-// --------------------------------------------------------------------------------------------------------------------------
-// *****************          LÍPIDOS           *****************************************************************************
-// --------------------------------------------------------------------------------------------------------------------------
-
-/*---------------------------------------------------------------------------------------------------------
-   computeLipRaciones(): Calcula las raciones de lípidos según el valor establecido. Divide entre 10
-                         y redondea al entero más cercano si el valor es menor que .3 o mayor que .7 
-                         Si el valor está entre .3 y .7, se redondea a .5 
-----------------------------------------------------------------------------------------------------------*/
-/*void ValoresNutricionales::computeLipRaciones(){
-  _lip_R = round(2.0*(this->getLipValores()/10));   // 0.3 <= raciones <= 0.7   ------->  raciones = 0.5
-  _lip_R = _lip_R/2;
-}*/
 /*---------------------------------------------------------------------------------------------------------
-   computeLipRaciones(): Calcula las raciones de lípidos según el valor establecido. Divide entre 10
-                          para redondear al decimal más cercano y luego multiplica por 10 para volver a la
-                          escala original, pero manteniendo siempre 1 decimal. 
+   setValoresMilesimas(): Establece los valores nutricionales del objeto actual directamente en milésimas,
+                          p. ej. los sumados al leer el CSV.
+
+          Parámetros:
+                  carb - Valor de carbohidratos a establecer (mg)
+                  lip - Valor de lípidos a establecer (mg)
+                  prot - Valor de proteínas a establecer (mg)
+                  kcal - Valor de kilocalorías a establecer (cal)
 ----------------------------------------------------------------------------------------------------------*/
-void ValoresNutricionales::computeLipRaciones(){
-  _lip_R = round(10.0*(this->getLipValores()/10));   // Redondea al decimal más cercano
-  _lip_R = _lip_R/10;
+void ValoresNutricionales::setValoresMilesimas(milesimas_t carb, milesimas_t lip, milesimas_t prot, milesimas_t kcal){
+  _carb = carb;
+  _lip = lip;
+  _prot = prot;
+  _kcal = kcal;
 }
 
 
-
-// --------------------------------------------------------------------------------------------------------------------------
-// *****************          PROTEÍNAS           ***************************************************************************
-// --------------------------------------------------------------------------------------------------------------------------
-
-/*---------------------------------------------------------------------------------------------------------
-   computeProtRaciones(): Calcula las raciones de proteínas según el valor establecido. Divide entre 10
-                          y redondea al entero más cercano si el valor es menor que .3 o mayor que .7 
-                          Si el valor está entre .3 y .7, se redondea a .5 
-----------------------------------------------------------------------------------------------------------*/
-/*void ValoresNutricionales::computeProtRaciones(){
-  _prot_R = round(2.0*(this->getProtValores()/10));   // 0.3 <= raciones <= 0.7   ------->  raciones = 0.5
-  _prot_R = _prot_R/2;
-}*/
 /*---------------------------------------------------------------------------------------------------------
-   computeProtRaciones(): Calcula las raciones de proteínas según el valor establecido. Divide entre 10
-                          para redondear al decimal más cercano y luego multiplica por 10 para volver a la
-                          escala original, pero manteniendo siempre 1 decimal. 
+   sumar(): Suma a los valores nutricionales del objeto actual los de otro, p. ej. los de un alimento
+            al añadirlo al plato.
+
+          Parámetros:
+                  val - Valores a sumar
 ----------------------------------------------------------------------------------------------------------*/
-void ValoresNutricionales::computeProtRaciones(){
-  _prot_R = round(10.0*(this->getProtValores()/10));   // Redondea al decimal más cercano
-  _prot_R = _prot_R/10;
+void ValoresNutricionales::sumar(const ValoresNutricionales &val){
+  _carb += val._carb;
+  _lip += val._lip;
+  _prot += val._prot;
+  _kcal += val._kcal;
 }
 
 
-
-// --------------------------------------------------------------------------------------------------------------------------
-// *****************       VALORES NUTRICIONALES (TODOS)        *************************************************************
-// --------------------------------------------------------------------------------------------------------------------------
-
 /*---------------------------------------------------------------------------------------------------------
-   setValores(): Establece los valores nutricionales del objeto actual a partir de otro. Es decir, "copia"
-                 los valores de carbohidratos, lípidos, proteínas y kilocalorías.
+   restar(): Resta a los valores nutricionales del objeto actual los de otro, p. ej. los de un plato
+             al borrarlo de la comida. Al ser enteros, se vuelve exactamente a lo que había antes.
 
-          Parámetros: 
-                  val - Valores a establecer
+          Parámetros:
+                  val - Valores a restar
 ----------------------------------------------------------------------------------------------------------*/
-void ValoresNutricionales::setValores(ValoresNutricionales val){
-  this->setCarbValores(val.getCarbValores());
-  this->setLipValores(val.getLipValores());
-  this->setProtValores(val.getProtValores());
-  this->setKcalValores(val.getKcalValores());
+void ValoresNutricionales::restar(const ValoresNutricionales &val){
+  _carb -= val._carb;
+  _lip -= val._lip;
+  _prot -= val._prot;
+  _kcal -= val._kcal;
 }
 
 
-
 /*---------------------------------------------------------------------------------------------------------
-   setValores(): Establece los valores nutricionales del objeto actual a partir de los valores pasados como
-                 argumentos. 
+   redondear(): Redondea los valores a los decimales con que se escriben. Se usa al sumar una comida al
+                acumulado de hoy, para que sea el mismo que se obtiene al leer el CSV tras reiniciar.
 
-          Parámetros: 
-                  carb - Valor de carbohidratos a establecer
-                  lip - Valor de lípidos a establecer
-                  prot - Valor de proteínas a establecer
-                  kcal - Valor de kilocalorías a establecer
+          Parámetros:
+                  decimales - Decimales a conservar (0 a 3)
 ----------------------------------------------------------------------------------------------------------*/
-void ValoresNutricionales::setValores(float carb, float lip, float prot, float kcal){
-  this->setCarbValores(carb);
-  this->setLipValores(lip);
-  this->setProtValores(prot);
-  this->setKcalValores(kcal);
+void ValoresNutricionales::redondear(byte decimales){
+  if(decimales > 3) decimales = 3;
+  int32_t d = divisorDecimales[decimales];
+
+  _carb = dividirRedondeando(_carb, d) * d;
+  _lip = dividirRedondeando(_lip, d) * d;
+  _prot = dividirRedondeando(_prot, d) * d;
+  _kcal = dividirRedondeando(_kcal, d) * d;
 }
 
 
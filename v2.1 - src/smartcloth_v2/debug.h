@@ -10,6 +10,21 @@
 // -----------------------
 
 
+// ---- TRAZA BÁSCULA ----
+//#define SCALE_TRACE // Descomentar para grabar en la SD las muestras brutas y los eventos de la báscula (ver Scale_Trace.h)
+// -----------------------
+
+
+// ---- LATENCIA Y CPU ---
+//#define LOOP_STATS // Descomentar para mostrar cada 10 seg la latencia evento-pantalla y el % de CPU libre del loop (ver Scheduler.h)
+// -----------------------
+
+
+// ---- CARGA IMÁGENES ---
+//#define IMG_STATS // Descomentar para mostrar el tiempo de loadPicturesShowHourglass() y la velocidad (bytes/s) de lectura de imágenes de la SD (ver RA8876_v2.cpp)
+// -----------------------
+
+
 // ----- BORRADO CSV -----
 #define BORRADO_INFO_USUARIO // Descomentar para habilitar el borrado de la info del usuario en ficheros CSV (acumulado), TXT (comidas a subir) y CSV (productos barcode leídos)
 // -----------------------
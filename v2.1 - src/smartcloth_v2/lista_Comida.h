@@ -9,10 +9,15 @@
  *
  *  Este archivo contiene las funciones para manejar una lista de cadenas que representan las
  *  líneas a escribir en el fichero para el ESP32.
- *  Para cada comida, se van a ir guardando en una lista (vector de String) las cadenas a escribir 
- *  en el fichero cuya información se enviará al esp32 cuando haya wifi para que conforme un JSON y suba
- *  la información a la base de datos.
+ *  Para cada comida, se van a ir guardando en una lista las líneas a escribir en el fichero cuya 
+ *  información se enviará al esp32 cuando haya wifi para que conforme un JSON y suba la información 
+ *  a la base de datos.
  *  Estas cadenas (líneas) solo se escribirán en el fichero txt al guardar la comida. 
+ *
+ *  La lista no guarda el texto, sino un registro binario por línea en un array de tamaño fijo 
+ *  (CAPACIDAD_LISTA bytes), sin usar el heap. El texto de cada línea se escribe al enviarla al 
+ *  ESP32 o al fichero. Antes era un vector de String: varias reservas por línea y el heap 
+ *  fragmentado entre comidas.
  *  
  */
 
@@ -43,7 +48,8 @@
 
     STATE_deleted:
         - Borra todas las lineas finales de la lista hasta la última aparición de "INICIO-PLATO", inclusive, para borrar el último plato 
-          (grupoActual porque aún se tiene activo el último grupo seleccionado)
+          (grupoActual porque aún se tiene activo el último grupo seleccionado). No se recorre la lista: se sabe dónde empieza el 
+          último plato y cada plato guarda dónde empieza el anterior.
 
     STATE_saved:
         - Al actualizar plato actual previo a guardar comida, escribir "ALIMENTO,<grupoActual>,<pesoBascula>" o "ALIMENTO,<grupoActual>,<pesoBascula>,<ean>" 
@@ -55,18 +61,59 @@
 #ifndef LISTA_H
 #define LISTA_H
 
-#include <vector>
-#include <string>
 #include "RTC.h"
+#include "Valores_Nutricionales.h" // textoMilesimas()
 
 
 #include "debug.h" // SM_DEBUG --> SerialPC
 #include "Serial_functions.h" // SerialESP32 y resultados de subir a database (WAITING_FOR_DATA, UPLOADING_DATA, MEAL_UPLOADED, MEALS_LEFT, ERROR_READING_TXT, NO_INTERNET_CONECTION, HTTP_ERROR, TIMEOUT, UNKNOWN_ERROR)
+#include "Debug_Log.h" // LOG_SM()
 
 
 void waitResponseFromESP32(String &msgFromESP32, unsigned long &timeout);
 
 
+#define CAPACIDAD_LISTA     1024    // Bytes para los registros de una comida (~50 alimentos con EAN de 13 cifras o ~140 sin EAN)
+#define SIN_PLATO           0xFFFF  // Posición del plato anterior al primero de la comida (o del último, si no cupo su INICIO-PLATO)
+
+// ------ TIPOS DE REGISTRO ---------------------------------------------------
+#define REGISTRO_INICIO_COMIDA  1   // "INICIO-COMIDA"                                  Solo el tipo (1 byte)
+#define REGISTRO_INICIO_PLATO   2   // "INICIO-PLATO"                                   registroPlato_t
+#define REGISTRO_ALIMENTO       3   // "ALIMENTO,<grupo>,<peso>" o "...,<ean>"          registroAlimento_t + EAN
+#define REGISTRO_FIN_COMIDA     4   // "FIN-COMIDA,<fecha>,<hora>"                      registroFinComida_t
+// -----------------------------------------------------------------------------
+
+
+typedef struct __attribute__((packed)) {
+    uint8_t       tipo;             // REGISTRO_INICIO_PLATO
+    uint8_t       numero;           // Número del plato en la comida (1, 2...)
+    uint16_t      anterior;         // Posición del INICIO-PLATO anterior (SIN_PLATO si es el primero)
+    uint8_t       tipoPrevio;       // Tipo del registro anterior a este, para saber cuál queda el último al borrar el plato
+} registroPlato_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t       tipo;             // REGISTRO_ALIMENTO
+    uint8_t       grupo;            // ID del grupo
+    int32_t       peso;             // Peso en centésimas de gramo (las dos decimales que se envían)
+    uint8_t       longitudEAN;      // Caracteres del EAN que siguen al registro (0 si no es un producto de barcode)
+} registroAlimento_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t       tipo;             // REGISTRO_FIN_COMIDA
+    uint8_t       dia;
+    uint8_t       mes;
+    uint16_t      anio;
+    uint8_t       hora;
+    uint8_t       minuto;
+    uint8_t       segundo;
+} registroFinComida_t;
+
+// Si no cabe un INICIO-PLATO, tampoco cabe ningún alimento detrás: un plato que no se ha podido 
+// iniciar se queda sin registros y borrarlo no toca los del plato anterior.
+static_assert(sizeof(registroAlimento_t) >= sizeof(registroPlato_t), "lista_Comida: un alimento no puede ocupar menos que un INICIO-PLATO");
+
+
+
 
 // **************************************************************************************************************************
 // *****************      DECLARACIÓN CLASE 'LISTA'       *******************************************************************
@@ -83,61 +130,51 @@ class Lista
 {
     private:
         
-        std::vector<String> _lines; // Vector para almacenar las líneas de la lista.
-
-        /**
-         * @brief Obtiene el último elemento de la lista.
-         * @return El último elemento de la lista.
-         */
-        inline String getLastItem() { return _lines.back(); };
+        byte        _registros[CAPACIDAD_LISTA];    // Registros de la comida, uno detrás de otro y sin huecos
+        uint16_t    _fin = 0;                       // Bytes ocupados (posición del siguiente registro)
+        uint16_t    _ultimoPlato = SIN_PLATO;       // Posición del último INICIO-PLATO
+        byte        _tipoUltimo = 0;                // Tipo del último registro (0 si la lista está vacía)
 
         /**
          * @brief Comprueba si la lista está vacía.
          * @return Verdadero si la lista está vacía, falso en caso contrario.
          */
-        inline bool isListEmpty() { return _lines.empty(); };
+        inline bool isListEmpty() const { return _fin == 0; };
 
-        /**
-         * @brief Añade una línea a la lista.
-         * @param line La línea a añadir.
-         */
-        inline void addLineToList(const String& line) { _lines.push_back(line); };
+        bool        addRegistro(const void *registro, uint16_t tam, const char *ean = nullptr, byte longitudEAN = 0); // Añade un registro al final de la lista
+        uint16_t    printRegistro(Print &salida, uint16_t pos) const;                                                   // Escribe la línea de texto de un registro
 
         /**
-         * @brief Borra elementos de la lista desde el índice 'fromIndex' hasta el final de la lista
-         * @param fromIndex Índice de la lista desde donde borrar elementos
-        */
-        inline void deleteItemsFrom(byte& fromIndex) { _lines.erase(_lines.begin() + fromIndex, _lines.end()); };
+         * @brief Pasa el peso de la báscula a centésimas de gramo. En double para que redondee a las dos 
+         *        decimales igual que String(float) (en float, 30.385 g ya no se distingue de 30.38499 g).
+         * @param peso Peso en gramos
+         * @return Peso en centésimas de gramo
+         */
+        static inline int32_t centesimas(float peso) { return (peso >= 0.0f) ? (int32_t)(peso * 100.0 + 0.5) : -(int32_t)(-peso * 100.0 + 0.5); };
 
 
     public:
         
         /**
-         * @brief Obtiene el tamaño de la lista
-         * @return El tamaño de la lista
+         * @brief Obtiene los bytes ocupados por los registros de la comida
+         * @return Bytes ocupados (como mucho CAPACIDAD_LISTA)
         */
-        inline byte getListSize() { return _lines.size(); };
-
-        /**
-         * @brief Obtiene el elemento de la lista en el índice 'index'
-         * @param index El índice del elemento en la lista
-         * @return El elemento en la lista según el índice
-        */
-        inline String getItem(byte& index) { return _lines[index]; };
+        inline uint16_t getBytesLista() const { return _fin; };
 
         /**
          * @brief Limpiar lista
         */
-        inline void clearList() { _lines.clear(); };
+        inline void clearList() { _fin = 0; _ultimoPlato = SIN_PLATO; _tipoUltimo = 0; };
 
 
-        void iniciarComida();                                               // Inicia una comida.
-        void iniciarPlato();                                                // Inicia un plato.
-        void addAlimento(byte grupo, float peso);                           // Añade un alimento a la lista.
-        void addAlimentoBarcode(byte grupo, float peso, String barcode);    // Añade un alimento de tipo barcode a la lista.
-        void borrarLastPlato();                                             // Borra el último plato de la lista.
-        void finishComida();                                                // Finaliza la comida añadiendo la fecha y hora
-        void sendListToESP32();                                             // Envía la lista elemento a elemento al ESP32 por Serial
+        bool iniciarComida();                                                       // Inicia una comida. Falso si no cabe.
+        bool iniciarPlato();                                                        // Inicia un plato. Falso si no cabe.
+        bool addAlimento(byte grupo, float peso);                                   // Añade un alimento a la lista. Falso si no cabe.
+        bool addAlimentoBarcode(byte grupo, float peso, const String &barcode);     // Añade un alimento de tipo barcode a la lista. Falso si no cabe.
+        void borrarLastPlato();                                                     // Borra el último plato de la lista.
+        void finishComida();                                                        // Finaliza la comida añadiendo la fecha y hora
+        void sendListToESP32();                                                     // Envía la lista elemento a elemento al ESP32 por Serial
+        void printLista(Print &salida) const;                                       // Escribe la lista, una línea por registro (p. ej. en el fichero TXT)
 
 
         #if defined(SM_DEBUG)
@@ -149,12 +186,106 @@ class Lista
 
 
 
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Añade un registro al final de la lista.
+ *
+ * Salvo el FIN-COMIDA, ningún registro puede ocupar el sitio reservado para él,
+ * así que la comida siempre se puede terminar aunque la lista se llene. Si el 
+ * registro no cabe, se descarta y se avisa en el log.
+ *
+ * @param registro Registro a copiar (su primer byte es el tipo)
+ * @param tam Tamaño del registro
+ * @param ean Caracteres que se copian detrás del registro (el EAN de un alimento)
+ * @param longitudEAN Número de caracteres de 'ean'
+ * @return Verdadero si se ha añadido, falso si no cabía
+ */
+/*-----------------------------------------------------------------------------*/
+bool Lista::addRegistro(const void *registro, uint16_t tam, const char *ean, byte longitudEAN)
+{
+    byte tipo = *(const byte*)registro;
+    uint16_t reservado = (tipo == REGISTRO_FIN_COMIDA) ? 0 : sizeof(registroFinComida_t);
+    uint16_t total = tam + longitudEAN;
+
+    if (_fin + total + reservado > CAPACIDAD_LISTA) {
+        LOG_SM(LOG_LISTA_LLENA, _fin, CAPACIDAD_LISTA, total);
+        return false;
+    }
+
+    memcpy(&_registros[_fin], registro, tam);
+    if (longitudEAN > 0) memcpy(&_registros[_fin + tam], ean, longitudEAN);
+    _fin += total;
+    _tipoUltimo = tipo;
+    return true;
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Escribe la línea de texto de un registro, con el mismo formato que se 
+ *        guardaba antes en la lista.
+ *
+ * @param salida Donde escribir la línea (SerialESP32, el fichero TXT o SerialPC)
+ * @param pos Posición del registro
+ * @return Posición del registro siguiente
+ */
+/*-----------------------------------------------------------------------------*/
+uint16_t Lista::printRegistro(Print &salida, uint16_t pos) const
+{
+    switch (_registros[pos]) 
+    {
+        case REGISTRO_INICIO_COMIDA:
+            salida.println(F("INICIO-COMIDA"));
+            return pos + 1;
+
+        case REGISTRO_INICIO_PLATO:
+            salida.println(F("INICIO-PLATO"));
+            return pos + sizeof(registroPlato_t);
+
+        case REGISTRO_ALIMENTO:
+        {
+            registroAlimento_t alimento;
+            memcpy(&alimento, &_registros[pos], sizeof(alimento));
+
+            char peso[LONGITUD_TEXTO_MILESIMAS];
+            salida.print(F("ALIMENTO,"));
+            salida.print(alimento.grupo);
+            salida.print(',');
+            salida.print(textoMilesimas(peso, alimento.peso * 10, 2)); // Dos decimales, como String(float)
+            if (alimento.longitudEAN > 0) {
+                salida.print(',');
+                salida.write(&_registros[pos + sizeof(alimento)], alimento.longitudEAN);
+            }
+            salida.println();
+            return pos + sizeof(alimento) + alimento.longitudEAN;
+        }
+
+        case REGISTRO_FIN_COMIDA:
+        {
+            registroFinComida_t fin;
+            memcpy(&fin, &_registros[pos], sizeof(fin));
+
+            // "FIN-COMIDA,dd.mm.aaaa,hh:mm:ss", como rtc.getDateStr() y rtc.getTimeStr()
+            char linea[sizeof("FIN-COMIDA,255.255.65535,255:255:255")];    // Cabe con cualquier valor de los campos
+            snprintf(linea, sizeof(linea), "FIN-COMIDA,%02u.%02u.%04u,%02u:%02u:%02u", 
+                     fin.dia, fin.mes, fin.anio, fin.hora, fin.minuto, fin.segundo);
+            salida.println(linea);
+            return pos + sizeof(fin);
+        }
+
+        default: // No debería ocurrir: se da la lista por terminada
+            return _fin;
+    }
+}
+
+
 /*-----------------------------------------------------------------------------*/
 /**
  * @brief Inicia una comida nueva.
+ * @return Falso si no cabe el "INICIO-COMIDA" (solo con la lista llena de una comida sin terminar)
  */
 /*-----------------------------------------------------------------------------*/
-void Lista::iniciarComida() 
+bool Lista::iniciarComida() 
 {
     // Comprobar si la lista está vacía para iniciar la comida. Si no lo está,
     // significa que la comida ya ha comenzado, por lo que no hace falta escribirlo
@@ -165,13 +296,15 @@ void Lista::iniciarComida()
             SerialPC.println(F("\nIniciando comida..."));
         #endif 
         
-        // Añadir cadena a la lista
-        addLineToList("INICIO-COMIDA");
+        // Añadir registro a la lista
+        byte registro = REGISTRO_INICIO_COMIDA;
+        return addRegistro(&registro, sizeof(registro));
     }
     else{
         #if defined(SM_DEBUG)
             SerialPC.println(F("\nLa COMIDA ya ha comenzado"));
         #endif 
+        return true;
     }
 }
 
@@ -180,23 +313,43 @@ void Lista::iniciarComida()
 /*-----------------------------------------------------------------------------*/
 /**
  * @brief Inicia un plato nuevo.
+ *
+ * Si no cabe su INICIO-PLATO, el último plato pasa a ser SIN_PLATO: el plato 
+ * nuevo no tiene registros y, al borrarlo, no se debe borrar el anterior.
+ *
+ * @return Falso si no cabe el "INICIO-PLATO"
  */
 /*-----------------------------------------------------------------------------*/
-void Lista::iniciarPlato() 
+bool Lista::iniciarPlato() 
 {
     // Comprobar si el último elemento no es "INICIO-PLATO"   
-    if (getLastItem() != "INICIO-PLATO") {
+    if (_tipoUltimo != REGISTRO_INICIO_PLATO) {
         #if defined(SM_DEBUG)
             SerialPC.println(F("\nIniciando plato..."));
         #endif
         
-        // Añadir cadena a la lista
-        addLineToList("INICIO-PLATO"); 
+        // Añadir registro a la lista, enlazado con el plato anterior
+        registroPlato_t plato;
+        plato.tipo = REGISTRO_INICIO_PLATO;
+        plato.numero = 1;
+        if (_ultimoPlato != SIN_PLATO) {
+            registroPlato_t anterior;
+            memcpy(&anterior, &_registros[_ultimoPlato], sizeof(anterior));
+            plato.numero = anterior.numero + 1;
+        }
+        plato.anterior = _ultimoPlato;
+        plato.tipoPrevio = _tipoUltimo;
+
+        uint16_t pos = _fin;
+        bool added = addRegistro(&plato, sizeof(plato));
+        _ultimoPlato = added ? pos : SIN_PLATO;
+        return added;
     }
     else {
         #if defined(SM_DEBUG)
             SerialPC.println(F("\nEl PLATO ya ha comenzado"));
         #endif
+        return true;
     }
 }
 
@@ -218,20 +371,25 @@ void Lista::iniciarPlato()
  * 
  * @param grupo El grupo del alimento (grupoAnterior).
  * @param peso El peso del alimento (pesoBascula).
+ * @return Falso si no cabe. La Máquina de Estados no lo debe incluir entonces en el plato ni en la comida.
  * 
  */
 /*-----------------------------------------------------------------------------*/
-void Lista::addAlimento(byte grupo, float peso) 
+bool Lista::addAlimento(byte grupo, float peso) 
 {
     #if defined(SM_DEBUG)
         SerialPC.println(F("Guardando alimento y peso en lista...\n"));
     #endif
     
-    // Obtener cadena "ALIMENTO,<grupo>,<peso>"
-    String cad = "ALIMENTO," + String(grupo) + "," + String(peso);
+    // Registro de "ALIMENTO,<grupo>,<peso>"
+    registroAlimento_t alimento;
+    alimento.tipo = REGISTRO_ALIMENTO;
+    alimento.grupo = grupo;
+    alimento.peso = centesimas(peso);
+    alimento.longitudEAN = 0;
     
-    // Añadir cadena a la lista
-    addLineToList(cad);
+    // Añadir registro a la lista
+    return addRegistro(&alimento, sizeof(alimento));
 }
 
 
@@ -255,21 +413,26 @@ void Lista::addAlimento(byte grupo, float peso)
  * 
  * @param grupo El grupo al que pertenece el alimento (grupoAnterior).
  * @param peso El peso del alimento (pesoBascula).
- * @param barcode El código de barras del alimento (barcode).
+ * @param barcode El código de barras del alimento (barcode). Se copian como mucho 255 caracteres.
+ * @return Falso si no cabe. La Máquina de Estados no lo debe incluir entonces en el plato ni en la comida.
  * 
  */
 /*-----------------------------------------------------------------------------*/
-void Lista::addAlimentoBarcode(byte grupo, float peso, String barcode) 
+bool Lista::addAlimentoBarcode(byte grupo, float peso, const String &barcode) 
 {
     #if defined(SM_DEBUG)
         SerialPC.println(F("Guardando alimento tipo barcode con peso e EAN en lista...\n"));
     #endif
     
-    // Obtener cadena "ALIMENTO,<grupo>,<peso>,<ean>"
-    String cad = "ALIMENTO," + String(grupo) + "," + String(peso) + "," + barcode;
+    // Registro de "ALIMENTO,<grupo>,<peso>,<ean>", con el EAN detrás
+    registroAlimento_t alimento;
+    alimento.tipo = REGISTRO_ALIMENTO;
+    alimento.grupo = grupo;
+    alimento.peso = centesimas(peso);
+    alimento.longitudEAN = (barcode.length() > 255) ? 255 : barcode.length();
     
-    // Añadir cadena a la lista
-    addLineToList(cad);
+    // Añadir registro a la lista
+    return addRegistro(&alimento, sizeof(alimento), barcode.c_str(), alimento.longitudEAN);
 }
 
 
@@ -277,25 +440,25 @@ void Lista::addAlimentoBarcode(byte grupo, float peso, String barcode)
 /**
  * @brief Borra el último plato de la lista.
  *
- * Busca el índice del último "INICIO-PLATO" en la lista y borra todos los 
- * elementos desde ese índice hasta el final de la lista.
+ * Borra todos los registros desde el último "INICIO-PLATO" hasta el final de la 
+ * lista. El plato anterior pasa a ser el último, así que se puede volver a llamar.
  */
 /*-----------------------------------------------------------------------------*/
 void Lista::borrarLastPlato() 
 {
-    // Buscar el último INICIO-PLATO en la lista
-    byte lastPlatoIndex = -1;
-    for (byte i = 0; i < getListSize(); i++) 
-    {
-        if (getItem(i) == "INICIO-PLATO"){
-            lastPlatoIndex = i;
-        }
-    }
+    if (_ultimoPlato == SIN_PLATO) return; // No hay plato que borrar
 
-    // Borrar todas las líneas desde el último INICIO-PLATO
-    if (lastPlatoIndex != -1){
-        deleteItemsFrom(lastPlatoIndex);
-    }
+    registroPlato_t plato;
+    memcpy(&plato, &_registros[_ultimoPlato], sizeof(plato));
+
+    #if defined(SM_DEBUG)
+        SerialPC.print(F("\nBorrando plato ")); SerialPC.print(plato.numero); SerialPC.println(F(" de la lista..."));
+    #endif
+
+    // Borrar todos los registros desde el último INICIO-PLATO
+    _fin = _ultimoPlato;
+    _ultimoPlato = plato.anterior;
+    _tipoUltimo = plato.tipoPrevio;
 }
 
 
@@ -306,7 +469,7 @@ void Lista::borrarLastPlato()
  * @brief Finaliza la comida actual.
  *
  * Añade una línea "FIN-COMIDA,<fecha>,<hora>" al final de la lista para indicar 
- * el final de la comida.
+ * el final de la comida. La fecha y la hora salen de una sola lectura del RTC.
  */
 /*-----------------------------------------------------------------------------*/
 void Lista::finishComida() 
@@ -318,14 +481,20 @@ void Lista::finishComida()
         SerialPC.println(F("\nFinalizando comida en lista...\n"));
     #endif 
 
-    char *today = rtc.getDateStr();
-    char *time = rtc.getTimeStr();
-
-    // Obtener cadena "FIN-COMIDA,<fecha>,<hora>"
-    String cadFin = "FIN-COMIDA," + String(today) + "," + String(time);
+    Time t = rtc.getTime();
+
+    // Registro de "FIN-COMIDA,<fecha>,<hora>"
+    registroFinComida_t fin;
+    fin.tipo = REGISTRO_FIN_COMIDA;
+    fin.dia = t.date;
+    fin.mes = t.mon;
+    fin.anio = t.year;
+    fin.hora = t.hour;
+    fin.minuto = t.min;
+    fin.segundo = t.sec;
     
-    // Añadir cadena a la lista
-    addLineToList(cadFin);
+    // Añadir registro a la lista (siempre cabe)
+    addRegistro(&fin, sizeof(fin));
 }
 
 
@@ -333,7 +502,8 @@ void Lista::finishComida()
 /**
  * @brief Envia el contenido de la lista al ESP32.
  *
- * Recorre la lista y envía cada línea a través de SerialESP32.
+ * Recorre la lista y envía cada línea a través de SerialESP32, como 
+ * sendMsgToESP32() pero escribiendo el texto directamente en el puerto.
  */
 /*-----------------------------------------------------------------------------*/
 void Lista::sendListToESP32() 
@@ -342,9 +512,24 @@ void Lista::sendListToESP32()
         SerialPC.println(F("Enviando lista al esp32 para subir la info"));
     #endif
 
-    for (byte i = 0; i < getListSize(); i++) {
-        //SerialESP32.println(getItem(i));
-        sendMsgToESP32(getItem(i));
+    for (uint16_t pos = 0; pos < _fin; ) {
+        clearReceptionBuffer();                     // Limpiar solo buffer RX antes de enviar nueva línea
+        pos = printRegistro(SerialESP32, pos);
+        delay(50);                                  // Pequeño retraso para asegurar que el ESP32 tenga tiempo de leer la línea
+    }
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Escribe el contenido de la lista, una línea por registro.
+ * @param salida Donde escribir (el fichero TXT, SerialPC...)
+ */
+/*-----------------------------------------------------------------------------*/
+void Lista::printLista(Print &salida) const
+{
+    for (uint16_t pos = 0; pos < _fin; ) {
+        pos = printRegistro(salida, pos);
     }
 }
 
@@ -362,10 +547,9 @@ void Lista::leerLista()
 {
     SerialPC.println(F("\nContenido de la Lista:\n"));
 
-    for (byte i = 0; i < getListSize(); i++) {
-        SerialPC.println(getItem(i));
-    }
+    printLista(SerialPC);
 
+    SerialPC.print(F("\n(")); SerialPC.print(_fin); SerialPC.print(F(" de ")); SerialPC.print(CAPACIDAD_LISTA); SerialPC.println(F(" bytes)"));
     SerialPC.println("\n");
 }
 #endif
@@ -22,8 +22,22 @@
 
     - Buttons.h 
         - ISR.h 
+            - Event_Queue.h
+            - Scheduler.h
+                - HAL.h
+                - Debug_Log.h
+                    - Log_Diccionario.h
             - Scale.h
+                - HX711_Sampler.h
+                    - HAL.h
+                - Scale_Filter.h
+                - Scale_Predictor.h
+                - Scale_Calibration.h
+                - Scale_Classifier.h
+                - Scale_Trace.h
+                - Flight_Recorder.h
                 - State_Machine.h (eventos)
+                    - State_Transitions.h
                     - Serial_esp32cam.h
                     - SD_functions.h
                         - lista_Comida.h
@@ -36,17 +50,13 @@
                                         - Valores_Nutricionales.h
                                         - Grupos.h
                     - Screen.h 
+                        - Protothread.h
                         - RA8876_v2.h
                             - COLORS.h
 */
 // ------------------------------------------
 
 
-/* Time */
-const unsigned long   period = 50;
-unsigned long         prevMillis = 0;
-unsigned long         tiempoPrevio = 0;
-
 // Error al inicializar la SD
 bool falloCriticoSD = false;
 
@@ -90,6 +100,10 @@ void setup()
         SerialPC.println(F("Inicializando scale..."));
     #endif
     setupScale();   
+    #if defined(SCALE_TRACE)
+        if(!falloCriticoSD) setupTrazaBascula(); // Sin SD no se graba la traza
+    #endif
+    if(!falloCriticoSD) setupRegistroVuelo(); // Sin SD el registro de vuelo se queda en RAM
     delay(100); 
     // -----------------------------------------
     
@@ -167,8 +181,8 @@ void setup()
     attachInterrupt(digitalPinToInterrupt(intPinBarcode), ISR_barcode, FALLING); // Interrupción en flanco de bajada
 
     //  -----   Scale   ------
-    attachDueInterrupt(HW_TIMER_INTERVAL_MS * 1000, TimerHandler, "ITimer");
-    ISR_Timer.setInterval(TIMER_INTERVAL_5MS,  ISR_pesarBascula); //timer llama a 'ISR_pesarBascula' cada 100 ms
+    // La báscula ya no usa timer: el sampler tiene su propia interrupción de DRDY (setupScale())
+    // y checkBascula() evalúa el peso en cuanto el filtro lo da por estable
     // -----------------------------------------
 
 
@@ -188,6 +202,8 @@ void setup()
 
     // ------ TIEMPO DE ESTABILIZACIÓN ---------
     startupTime = millis();
+    inicioVentanaCPU = micros(); // Primera ventana de medida de CPU libre (Scheduler.h)
+    vueloArranque(state_actual, startupTime);
     // -----------------------------------------
 
 }
@@ -196,52 +212,92 @@ void setup()
 
 
 /*---------------------------------------------------------------------------------------------------------
-   loop(): Función principal ejecutada continuamente
+   loop(): Función principal ejecutada continuamente. Duerme hasta que una ISR (botoneras, báscula) o un
+           temporizador publica alguna tarea y la atiende en el momento (Scheduler.h).
 ----------------------------------------------------------------------------------------------------------*/
 void loop() 
 {    
-    if (millis() - prevMillis > period)
-    {
-        prevMillis = millis();
-                
-        doStateActions();   // Actividades del estado actual. Comienza en STATE_Init (o en STATE_CRITIC_FAILURE_SD si ha fallado la SD)
+    byte tareas = esperarTareas();  // Duerme (WFI) hasta que haya alguna tarea pendiente
 
-        // Si no ha ocurrido un fallo al inicializar la SD, se chequean cambios en la Máquina de Estados
-        if (!falloCriticoSD)
-        {
+    // Actividades del estado actual. Comienza en STATE_Init (o en STATE_CRITIC_FAILURE_SD si ha fallado la SD).
+    // Solo hace falta llamarlas periódicamente por las que dependen del tiempo (pantallas alternas, cancelación
+    // automática, vuelta desde STATE_ERROR...). Tras una transición se llaman directamente más abajo.
+    if (tareas & TAREA_ACTIVIDADES) doStateActions();
 
-            /*--------------------------------------------------------------*/
-            /* ---------------    CHECK INTERRUPCIONES   ------------------ */
-            /*--------------------------------------------------------------*/
-            checkAllButtons();  // Comprueba interrupción de botoneras y marca evento
-            checkBascula();     // Comprueba interrupción de báscula y marca evento
-            
+    // Siguiente tramo de la pantalla animada en curso (pedir recipiente, confirmar acción...), si la hay.
+    // Antes se dibujaba entera con delay() entre pasos, bloqueando el loop varios segundos.
+    if (tareas & TAREA_ANIMACION) continuarAnimacion();
 
+    #if defined(LOOP_STATS)
+        if (tareas & TAREA_ESTADISTICAS) printPlanificadorStats();
+    #endif
 
-            /*------------------------------------------------------------*/
-            /* ---------------    MOTOR DE INFERENCIA   ----------------- */
-            /*------------------------------------------------------------*/
+    // Log de depuración binario (Debug_Log.h): enviar lo que quepa en el UART sin bloquear
+    if (tareas & TAREA_LOG) vaciarLog();
 
-            if(flagEvent or flagError){     // Para evitar que marque evento para cada interrupción, ya que lo marcaría cada
-                                            // medio segundo por la interrupción de la báscula, se utiliza la flag 'flagEvent'.
-                                            // Con esta flag solo se da aviso de un evento real (pulsación, incremento o decremento).
+    #if defined(SM_DEBUG)
+        // Volcar el registro de vuelo a la SD a petición del PC. No hay tarea para el Serial: se revisa
+        // como mucho cada PERIODO_ACTIVIDADES, cuando despierta el temporizador de las actividades.
+        if ((SerialPC.available() > 0) and (SerialPC.read() == 'V')) volcarRegistroVuelo(VOLCADO_PEDIDO, state_actual);
+    #endif
+
+    // Si no ha ocurrido un fallo al inicializar la SD, se chequean cambios en la Máquina de Estados
+    if (!falloCriticoSD)
+    {
 
-                                            // Se incluye 'flagError' en la condición para que también compruebe las reglas
-                                            // de transición en el caso de error y pase al STATE_ERROR.
-                                            // Esta flag se activa en actEventError() y se desactiva tras los 3 segundos para
-                                            // mostrar la pantalla de error en actStateERROR().
+        /*--------------------------------------------------------------*/
+        /* ---------------    CHECK INTERRUPCIONES   ------------------ */
+        /*--------------------------------------------------------------*/
+        // Se comprueban siempre, no solo con TAREA_BOTONES o TAREA_BASCULA: con las colas vacías no
+        // cuestan nada y así el temporizador recoge también lo que se haya quedado sin avisar
+        // (p. ej. una muestra leída desde popMuestraSampler() tras perder el flanco de DRDY).
+        checkAllButtons();  // Comprueba interrupción de botoneras y marca evento
+        checkBascula();     // Comprueba interrupción de báscula y marca evento
+        #if defined(SCALE_TRACE)
+            flushTrazaBascula(); // Escribir en la SD los sectores llenos de la traza
+        #endif
+        
 
-                                            // El error es una acción de diferente naturaleza. Es decir, no ocurre un error,
-                                            // sino que si ha ocurrido algo que no es evento, se considera error. 
 
+        /*------------------------------------------------------------*/
+        /* ---------------    MOTOR DE INFERENCIA   ----------------- */
+        /*------------------------------------------------------------*/
+
+        if(flagEvent or flagError or !isColaVacia(colaEventosSM)){
+                                        // Para evitar que marque evento para cada interrupción, ya que lo marcaría cada
+                                        // medio segundo por la interrupción de la báscula, se utiliza la flag 'flagEvent'.
+                                        // Con esta flag solo se da aviso de un evento real (pulsación, incremento o decremento).
+
+                                        // Se incluye 'flagError' en la condición para que también compruebe las reglas
+                                        // de transición en el caso de error y pase al STATE_ERROR.
+                                        // Esta flag se activa en actEventError() y se desactiva tras los 3 segundos para
+                                        // mostrar la pantalla de error en actStateERROR().
+
+                                        // El error es una acción de diferente naturaleza. Es decir, no ocurre un error,
+                                        // sino que si ha ocurrido algo que no es evento, se considera error. 
+
+            // Se evalúan todos los eventos pendientes, en el orden en que ocurrieron. Cada vez que un evento
+            // provoca una transición, el nuevo estado hace ya sus actividades (su pantalla), sin esperar al
+            // siguiente TAREA_ACTIVIDADES, y se registra la latencia de ese evento. Así, si quedan más eventos,
+            // cada uno se evalúa en el estado que le corresponde. Tras un evento sin transición no se hace nada
+            // más: las actividades del estado siguen en TAREA_ACTIVIDADES.
+            // Si solo está activa 'flagError' (no hay eventos nuevos), se vuelve a evaluar 'lastEvent', como antes.
+            bool volcarVuelo = false;   // Se ha entrado en STATE_ERROR --> volcar el registro de vuelo tras mostrar su pantalla
+            sacarEvento();
+            for(byte nEventos = 0; nEventos < COLA_EVENTOS_SIZE; nEventos++) // Límite por si un error de evento se repitiera sin fin
+            {
+                bool hayTransicion = false;
                 if(checkStateConditions()){     // Si se ha cumplido alguna regla de transición cuyo estado 
                                                 // inicial fuera el actual, se modifica el estado actual por
                                                 // el próximo indicado en la regla.
-                    
+                
 
                     state_prev = state_actual;
                     state_actual = state_new;
-                    
+                    hayTransicion = true;
+                    vueloTransicion(lastEvent, state_prev, state_actual, millis() - tiempoLastEvent);
+                    if(state_actual == STATE_ERROR) volcarVuelo = true;
+                
                     if(state_prev != lastValidState){
                         switch(state_prev){ // Último estado válido --> Como puntos de retorno (checkpoint) tras error o aviso.
                             case STATE_Init: case STATE_Plato: case STATE_Grupo: case STATE_Barcode: case STATE_raw: case STATE_cooked: case STATE_weighted:
@@ -250,13 +306,7 @@ void loop()
                             default: break;
                         }
                     }
-                    #if defined SM_DEBUG
-                        SerialPC.print(F("\nUltimo estado valido: "));  printStateName(lastValidState);  SerialPC.println();
-                        SerialPC.print(F("Estado anterior: "));         printStateName(state_prev);      SerialPC.println();
-                        SerialPC.print(F("Nuevo estado: "));            printStateName(state_new);       SerialPC.println();
-                        SerialPC.println("--------------------------------------------------");
-                        SerialPC.println("--------------------------------------------------\n\n");
-                    #endif
+                    LOG_SM(LOG_TRANSICION, state_prev, state_new, lastValidState);
                 }
                 else if((state_actual != STATE_ERROR) and (state_actual != STATE_CANCEL) and (state_actual != STATE_AVISO))
                 //else if(state_actual != STATE_ERROR) // PROBAR ESTO SOLO
@@ -272,12 +322,22 @@ void loop()
                         // La 'flagError' se desactiva en actStateERROR() tras los 3 segundos,
                     actEventError();       // Mensaje de error por evento erróneo según el estado actual
                 }
-                flagEvent = false;
 
-          }
-          
+                if(hayTransicion)
+                {
+                    doStateActions();                       // Pantalla del nuevo estado...
+                    registrarLatencia(tiempoLastEvent);     // ... desde el evento que la ha provocado
+                }
+
+                if(!sacarEvento()) break;
+            }
+
+            flagEvent = false;
+
+            if(volcarVuelo) volcarRegistroVuelo(VOLCADO_ERROR, state_actual);
+
         }
-        
+      
     }
     
 }
@@ -0,0 +1,489 @@
+/**
+ * @file atlas.cpp
+ * @brief Herramienta de PC para empaquetar las imágenes de la SD en un único fichero (atlas) que
+ *        loadPicturesShowHourglass() (Screen.h) carga de una pasada, comprimidas en Q565
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta:
+ *
+ *      g++ -std=c++11 -O2 -o atlas atlas.cpp
+ *
+ * Uso:
+ *
+ *      atlas crear disposicion.txt carpeta_SD   --> Comprueba la disposición (páginas, límites, solapes
+ *                                                   y tamaño de cada .bin), comprime cada imagen y escribe
+ *                                                   carpeta_SD/bin/atlas.bin con la compresión de cada una
+ *      atlas crear -s disposicion.txt carpeta_SD --> Igual, pero sin comprimir
+ *      atlas listar atlas.bin                    --> Muestra el manifiesto de un atlas
+ *
+ * Cada imagen comprimida se descomprime antes de guardarla para comprobar que sale igual que el .bin.
+ *
+ * Hay que volver a crear el atlas cada vez que se cambie alguna imagen o disposicion.txt. Si el
+ * atlas no está en la SD o no es válido, el sketch carga las imágenes sueltas como antes.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+// ------ FORMATO DEL FICHERO (igual que Screen.h) -----------------------------
+#define ATLAS_MAGIC             0x54414353  // "SCAT"
+#define ATLAS_VERSION           3
+#define ATLAS_MAX_IMAGENES      64
+#define ATLAS_ALINEACION        512         // Cada imagen empieza en un sector
+
+#define ATLAS_RGB565            0
+#define ATLAS_Q565              1
+
+typedef struct __attribute__((packed)) {
+    uint32_t  magic;
+    uint16_t  version;
+    uint16_t  nImagenes;
+    uint32_t  hashImagenes;
+} cabeceraAtlas_t;
+
+typedef struct __attribute__((packed)) {
+    char      nombre[12];
+    uint8_t   pagina;
+    uint8_t   formato;
+    uint16_t  x;
+    uint16_t  y;
+    uint16_t  ancho;
+    uint16_t  alto;
+    uint32_t  offset;
+    uint32_t  bytes;
+} imagenAtlas_t;
+// -----------------------------------------------------------------------------
+
+// ------ Q565 (igual que RA8876_v2.h) -----------------------------------------
+#define Q565_INDICE             0x00
+#define Q565_DIF                0x40
+#define Q565_LUMA               0x80
+#define Q565_RACHA              0xC0
+#define Q565_RGB                0xFE
+#define Q565_HASH(r, g, b)      (((r) * 3 + (g) * 5 + (b) * 7) & 63)
+#define Q565_MAX_RACHA          62
+// -----------------------------------------------------------------------------
+
+#define ANCHO_PAGINA    1024
+#define ALTO_PAGINA     600
+
+#define FNV_INICIAL     2166136261u     // FNV-1a de 32 bits (igual que Screen.h)
+#define FNV_PRIMO       16777619u
+
+typedef struct {
+    imagenAtlas_t   imagen;
+    std::string     fichero;    // Vacío si es una zona reservada
+    int             linea;
+} entrada_t;
+
+// Fotogramas del reloj de arena, que tienen que ser las primeras imágenes y en este orden
+const char *fotogramasReloj[] = { "reloj1", "reloj2", "reloj3", "reloj4", "relgir1", "relgir2", "relgir3", "relgir4", "relgir5", "relgir6" };
+const int NUM_FOTOGRAMAS = sizeof(fotogramasReloj) / sizeof(fotogramasReloj[0]);
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief FNV-1a de 32 bits de 'n' bytes, continuando desde 'hash'.
+ */
+/*-----------------------------------------------------------------------------*/
+uint32_t fnv1a(const uint8_t *datos, size_t n, uint32_t hash)
+{
+    for(size_t i = 0; i < n; i++) hash = (hash ^ datos[i]) * FNV_PRIMO;
+    return hash;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee disposicion.txt. Se salta las líneas vacías y los comentarios (#).
+ * @return 'false' si alguna línea está mal escrita
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerDisposicion(const char *ruta, std::vector<entrada_t> &entradas)
+{
+    FILE *f = fopen(ruta, "r");
+    if(!f){ fprintf(stderr, "No se puede abrir %s\n", ruta); return false; }
+
+    char linea[256];
+    int n = 0;
+    bool ok = true;
+    while(fgets(linea, sizeof(linea), f))
+    {
+        n++;
+        char *p = linea;
+        while(*p == ' ' or *p == '\t') p++;
+        if(*p == '#' or *p == '\n' or *p == '\r' or *p == '\0') continue;
+
+        char nombre[64], fichero[200];
+        unsigned pagina, x, y, ancho, alto;
+        if(sscanf(p, "%63s %u %u %u %u %u %199s", nombre, &pagina, &x, &y, &ancho, &alto, fichero) != 7)
+        {
+            fprintf(stderr, "%s:%d: se esperaba 'nombre pagina x y ancho alto fichero'\n", ruta, n);
+            ok = false;
+            continue;
+        }
+        if(strlen(nombre) >= sizeof(((imagenAtlas_t*)0)->nombre))
+        {
+            fprintf(stderr, "%s:%d: nombre '%s' demasiado largo (max %u caracteres)\n", ruta, n, nombre,
+                    (unsigned)sizeof(((imagenAtlas_t*)0)->nombre) - 1);
+            ok = false;
+            continue;
+        }
+
+        entrada_t e;
+        memset(&e.imagen, 0, sizeof(imagenAtlas_t));
+        strcpy(e.imagen.nombre, nombre);
+        e.imagen.pagina = pagina;
+        e.imagen.x = x;
+        e.imagen.y = y;
+        e.imagen.ancho = ancho;
+        e.imagen.alto = alto;
+        e.fichero = (strcmp(fichero, "-") == 0) ? "" : fichero;
+        e.linea = n;
+        entradas.push_back(e);
+    }
+
+    fclose(f);
+    return ok;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Comprueba que cada imagen cabe en su página (PAGE2-PAGE4), que no se solapa con otra
+ *        y que los fotogramas del reloj van primero.
+ * @return Número de errores
+ */
+/*-----------------------------------------------------------------------------*/
+int comprobarDisposicion(const char *ruta, const std::vector<entrada_t> &entradas)
+{
+    int errores = 0;
+
+    for(size_t i = 0; i < entradas.size(); i++)
+    {
+        const imagenAtlas_t &a = entradas[i].imagen;
+
+        if((a.pagina < 2) or (a.pagina > 4))
+        {
+            fprintf(stderr, "%s:%d: %s en PAGE%u (solo PAGE2-PAGE4)\n", ruta, entradas[i].linea, a.nombre, a.pagina);
+            errores++;
+        }
+        if((a.ancho == 0) or (a.alto == 0) or (a.x + a.ancho > ANCHO_PAGINA) or (a.y + a.alto > ALTO_PAGINA))
+        {
+            fprintf(stderr, "%s:%d: %s (%u,%u) %ux%u se sale de la pagina\n", ruta, entradas[i].linea, a.nombre, a.x, a.y, a.ancho, a.alto);
+            errores++;
+        }
+
+        for(size_t j = 0; j < i; j++)
+        {
+            const imagenAtlas_t &b = entradas[j].imagen;
+            if(a.pagina != b.pagina) continue;
+            if((a.x < b.x + b.ancho) and (b.x < a.x + a.ancho) and (a.y < b.y + b.alto) and (b.y < a.y + a.alto))
+            {
+                fprintf(stderr, "%s:%d: %s se solapa con %s (linea %d) en PAGE%u\n", ruta, entradas[i].linea, a.nombre, b.nombre,
+                        entradas[j].linea, a.pagina);
+                errores++;
+            }
+        }
+    }
+
+    for(int i = 0; i < NUM_FOTOGRAMAS; i++)
+    {
+        if((i >= (int)entradas.size()) or (strcmp(entradas[i].imagen.nombre, fotogramasReloj[i]) != 0))
+        {
+            fprintf(stderr, "%s: la imagen %d tiene que ser '%s' (fotogramas del reloj de arena, en orden)\n", ruta, i + 1, fotogramasReloj[i]);
+            errores++;
+            break;
+        }
+    }
+
+    return errores;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Comprime una imagen RGB565 (bytes de un .bin, little endian) en Q565.
+ */
+/*-----------------------------------------------------------------------------*/
+std::vector<uint8_t> comprimirQ565(const std::vector<uint8_t> &rgb565)
+{
+    std::vector<uint8_t> q;
+    uint16_t tabla[64] = {0};
+    uint16_t anterior = 0;
+    int racha = 0;
+
+    for(size_t i = 0; i + 1 < rgb565.size(); i += 2)
+    {
+        uint16_t p = rgb565[i] | (rgb565[i + 1] << 8);
+
+        if(p == anterior)
+        {
+            if(++racha == Q565_MAX_RACHA){ q.push_back(Q565_RACHA | (racha - 1)); racha = 0; }
+            continue;
+        }
+        if(racha){ q.push_back(Q565_RACHA | (racha - 1)); racha = 0; }
+
+        int r = p >> 11, g = (p >> 5) & 0x3F, b = p & 0x1F;
+        int h = Q565_HASH(r, g, b);
+
+        if(tabla[h] == p) q.push_back(Q565_INDICE | h);
+        else
+        {
+            tabla[h] = p;
+
+            // Diferencias con el anterior, en módulo (5, 6 y 5 bits)
+            int dr = ((r - (anterior >> 11) + 16) & 0x1F) - 16;
+            int dg = ((g - ((anterior >> 5) & 0x3F) + 32) & 0x3F) - 32;
+            int db = ((b - (anterior & 0x1F) + 16) & 0x1F) - 16;
+
+            if((dr >= -2) and (dr <= 1) and (dg >= -2) and (dg <= 1) and (db >= -2) and (db <= 1))
+            {
+                q.push_back(Q565_DIF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+            }
+            else if((dr - dg >= -8) and (dr - dg <= 7) and (db - dg >= -8) and (db - dg <= 7))
+            {
+                q.push_back(Q565_LUMA | (dg + 32));
+                q.push_back(((dr - dg + 8) << 4) | (db - dg + 8));
+            }
+            else
+            {
+                q.push_back(Q565_RGB);
+                q.push_back(p & 0xFF);
+                q.push_back(p >> 8);
+            }
+        }
+        anterior = p;
+    }
+    if(racha) q.push_back(Q565_RACHA | (racha - 1));
+
+    return q;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Descomprime Q565 igual que sdCardDraw16bppQ565() (RA8876_v2.cpp), para comprobar el compresor.
+ * @return 'false' si los datos no son válidos o no dan exactamente 'nPixeles'
+ */
+/*-----------------------------------------------------------------------------*/
+bool descomprimirQ565(const std::vector<uint8_t> &q, size_t nPixeles, std::vector<uint8_t> &rgb565)
+{
+    uint16_t tabla[64] = {0};
+    uint16_t p = 0;
+    size_t i = 0;
+    rgb565.clear();
+
+    while(rgb565.size() < nPixeles * 2)
+    {
+        if(i >= q.size()) return false;
+        uint8_t op = q[i++];
+        int repeticiones = 1;
+
+        if(op == Q565_RGB)
+        {
+            if(i + 2 > q.size()) return false;
+            p = q[i] | (q[i + 1] << 8);
+            i += 2;
+        }
+        else if(op == 0xFF) return false;
+        else if((op & 0xC0) == Q565_RACHA) repeticiones = (op & 0x3F) + 1;
+        else if((op & 0xC0) == Q565_INDICE) p = tabla[op];
+        else
+        {
+            int r = p >> 11, g = (p >> 5) & 0x3F, b = p & 0x1F;
+            if((op & 0xC0) == Q565_DIF)
+            {
+                r += ((op >> 4) & 3) - 2;
+                g += ((op >> 2) & 3) - 2;
+                b += (op & 3) - 2;
+            }
+            else
+            {
+                if(i >= q.size()) return false;
+                int dg = (op & 0x3F) - 32;
+                r += dg + (q[i] >> 4) - 8;
+                g += dg;
+                b += dg + (q[i] & 0x0F) - 8;
+                i++;
+            }
+            p = ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+        }
+
+        if(((op & 0xC0) != Q565_RACHA) or (op == Q565_RGB)) tabla[Q565_HASH(p >> 11, (p >> 5) & 0x3F, p & 0x1F)] = p;
+
+        while(repeticiones--){ rgb565.push_back(p & 0xFF); rgb565.push_back(p >> 8); }
+    }
+
+    return (i == q.size()) and (rgb565.size() == nPixeles * 2);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Escribe el atlas: cabecera, manifiesto y los datos de cada imagen a partir de un múltiplo
+ *        de ATLAS_ALINEACION. Cada imagen va comprimida en Q565 si así ocupa menos (y 'comprimir').
+ */
+/*-----------------------------------------------------------------------------*/
+int crear(const char *rutaDisposicion, const char *carpetaSD, bool comprimir)
+{
+    std::vector<entrada_t> todas;
+    if(!leerDisposicion(rutaDisposicion, todas)) return 1;
+    if(comprobarDisposicion(rutaDisposicion, todas)) return 1;
+
+    // Las zonas reservadas solo sirven para comprobar solapes
+    std::vector<entrada_t> imagenes;
+    for(const entrada_t &e : todas) if(!e.fichero.empty()) imagenes.push_back(e);
+
+    if(imagenes.size() > ATLAS_MAX_IMAGENES)
+    {
+        fprintf(stderr, "%u imagenes, el sketch admite %d (ATLAS_MAX_IMAGENES)\n", (unsigned)imagenes.size(), ATLAS_MAX_IMAGENES);
+        return 1;
+    }
+
+    // Leer los .bin y comprobar que su tamaño corresponde a ancho x alto
+    std::vector<std::vector<uint8_t>> pixeles(imagenes.size());
+    int errores = 0;
+    for(size_t i = 0; i < imagenes.size(); i++)
+    {
+        const imagenAtlas_t &a = imagenes[i].imagen;
+        std::string ruta = std::string(carpetaSD) + "/" + imagenes[i].fichero;
+        FILE *f = fopen(ruta.c_str(), "rb");
+        if(!f){ fprintf(stderr, "No se puede abrir %s\n", ruta.c_str()); errores++; continue; }
+
+        fseek(f, 0, SEEK_END);
+        long tam = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if(tam != (long)a.ancho * a.alto * 2)
+        {
+            fprintf(stderr, "%s: %ld bytes, pero %s es de %ux%u (%u bytes)\n", ruta.c_str(), tam, a.nombre, a.ancho, a.alto, a.ancho * a.alto * 2);
+            errores++;
+        }
+        else
+        {
+            pixeles[i].resize(tam);
+            if(fread(pixeles[i].data(), 1, tam, f) != (size_t)tam){ fprintf(stderr, "Error leyendo %s\n", ruta.c_str()); errores++; }
+        }
+        fclose(f);
+    }
+    if(errores) return 1;
+
+    // Hash de los píxeles de todas las imágenes: el sketch lo guarda en la firma de la SDRAM para saber
+    // si las imágenes que ya tiene la pantalla son las de este atlas
+    uint32_t hash = FNV_INICIAL;
+    for(size_t i = 0; i < imagenes.size(); i++) hash = fnv1a(pixeles[i].data(), pixeles[i].size(), hash);
+
+    // Comprimir
+    uint32_t totalRGB565 = 0, totalDatos = 0;
+    if(comprimir) printf("  %-12s %9s %9s %7s\n", "nombre", "RGB565", "Q565", "ratio");
+    for(size_t i = 0; i < imagenes.size(); i++)
+    {
+        imagenAtlas_t &a = imagenes[i].imagen;
+        a.formato = ATLAS_RGB565;
+        totalRGB565 += pixeles[i].size();
+
+        if(comprimir)
+        {
+            std::vector<uint8_t> q = comprimirQ565(pixeles[i]), comprobacion;
+            if(!descomprimirQ565(q, a.ancho * a.alto, comprobacion) or (comprobacion != pixeles[i]))
+            {
+                fprintf(stderr, "%s: la imagen descomprimida no coincide con el .bin\n", a.nombre);
+                return 1;
+            }
+            printf("  %-12s %9u %9u %6.2fx\n", a.nombre, (unsigned)pixeles[i].size(), (unsigned)q.size(), (double)pixeles[i].size() / q.size());
+            if(q.size() < pixeles[i].size()){ pixeles[i] = q; a.formato = ATLAS_Q565; }
+        }
+
+        a.bytes = pixeles[i].size();
+        totalDatos += a.bytes;
+    }
+
+    // Offsets
+    uint32_t offset = sizeof(cabeceraAtlas_t) + imagenes.size() * sizeof(imagenAtlas_t);
+    for(size_t i = 0; i < imagenes.size(); i++)
+    {
+        offset = (offset + ATLAS_ALINEACION - 1) / ATLAS_ALINEACION * ATLAS_ALINEACION;
+        imagenes[i].imagen.offset = offset;
+        offset += pixeles[i].size();
+    }
+
+    std::string rutaAtlas = std::string(carpetaSD) + "/bin/atlas.bin";
+    FILE *f = fopen(rutaAtlas.c_str(), "wb");
+    if(!f){ fprintf(stderr, "No se puede crear %s\n", rutaAtlas.c_str()); return 1; }
+
+    cabeceraAtlas_t cabecera = { ATLAS_MAGIC, ATLAS_VERSION, (uint16_t)imagenes.size(), hash };
+    fwrite(&cabecera, sizeof(cabecera), 1, f);
+    for(const entrada_t &e : imagenes) fwrite(&e.imagen, sizeof(imagenAtlas_t), 1, f);
+
+    uint32_t relleno = 0;
+    for(size_t i = 0; i < imagenes.size(); i++)
+    {
+        while((uint32_t)ftell(f) < imagenes[i].imagen.offset){ fputc(0, f); relleno++; }
+        fwrite(pixeles[i].data(), 1, pixeles[i].size(), f);
+    }
+    fclose(f);
+
+    printf("%s: %u imagenes, %u bytes (%u de relleno para alinear a %d)\n", rutaAtlas.c_str(), (unsigned)imagenes.size(),
+            offset, relleno, ATLAS_ALINEACION);
+    printf("Imagenes: %u bytes en RGB565, %u en el atlas (%.2fx)\n", totalRGB565, totalDatos, (double)totalRGB565 / totalDatos);
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra la cabecera y el manifiesto de un atlas.
+ */
+/*-----------------------------------------------------------------------------*/
+int listar(const char *ruta)
+{
+    FILE *f = fopen(ruta, "rb");
+    if(!f){ fprintf(stderr, "No se puede abrir %s\n", ruta); return 1; }
+
+    cabeceraAtlas_t c;
+    if((fread(&c, sizeof(c), 1, f) != 1) or (c.magic != ATLAS_MAGIC) or (c.version != ATLAS_VERSION))
+    {
+        fprintf(stderr, "%s: no es un atlas valido (version %d)\n", ruta, ATLAS_VERSION);
+        fclose(f);
+        return 1;
+    }
+
+    printf("%u imagenes, hash %08x\n\n  %-12s %4s %5s %5s %6s %5s %9s %8s %7s\n", c.nImagenes, c.hashImagenes, "nombre", "pag", "x", "y", "ancho", "alto", "offset", "bytes", "formato");
+    for(unsigned i = 0; i < c.nImagenes; i++)
+    {
+        imagenAtlas_t a;
+        if(fread(&a, sizeof(a), 1, f) != 1){ fprintf(stderr, "Manifiesto incompleto\n"); fclose(f); return 1; }
+        printf("  %-12.12s %4u %5u %5u %6u %5u %9u %8u %7s\n", a.nombre, a.pagina, a.x, a.y, a.ancho, a.alto, a.offset, a.bytes,
+                (a.formato == ATLAS_Q565) ? "Q565" : "RGB565");
+    }
+
+    fclose(f);
+    return 0;
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    if((argc == 4) and (strcmp(argv[1], "crear") == 0)) return crear(argv[2], argv[3], true);
+    if((argc == 5) and (strcmp(argv[1], "crear") == 0) and (strcmp(argv[2], "-s") == 0)) return crear(argv[3], argv[4], false);
+    if((argc == 3) and (strcmp(argv[1], "listar") == 0)) return listar(argv[2]);
+
+    fprintf(stderr, "Uso: %s crear [-s] <disposicion.txt> <carpeta_SD>\n"
+                    "     %s listar <atlas.bin>\n", argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file nombres_sm.h
+ * @brief Nombres de los estados y eventos de la Máquina de Estados para las herramientas de PC
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Siguen el orden de 'state_t' y 'event_t' (State_Transitions.h) y hay que actualizarlos aquí si
+ * cambian. Los usan tools/flight_recorder y tools/debug_log.
+ */
+
+#ifndef NOMBRES_SM_H
+#define NOMBRES_SM_H
+
+
+// Mismo orden que 'state_t' (State_Transitions.h)
+inline const char *nombreEstado(int estado)
+{
+    static const char *nombres[] = { "?", "Init", "Plato", "Grupo", "Barcode_read", "Barcode_search", "Barcode_check",
+                                     "Barcode", "raw", "cooked", "weighted", "add_check", "added", "delete_check",
+                                     "deleted", "save_check", "saved", "ERROR", "CANCEL", "AVISO", "DELETE_FILES_CHECK",
+                                     "DELETED_FILES", "CRITIC_FAILURE_SD", "UPLOAD_DATA", "REMOVAL_CHECK" };
+    return ((estado > 0) and (estado < (int)(sizeof(nombres) / sizeof(nombres[0])))) ? nombres[estado] : "?";
+}
+
+// Mismo orden que 'event_t' (State_Transitions.h)
+inline const char *nombreEvento(int evento)
+{
+    static const char *nombres[] = { "NONE", "TIPO_A", "TIPO_B", "BARCODE", "BARCODE_R", "BARCODE_F", "CRUDO", "COCINADO",
+                                     "ADD_PLATO", "DELETE_PLATO", "GUARDAR", "INCREMENTO", "DECREMENTO", "TARAR", "LIBERAR",
+                                     "ERROR", "CANCELAR", "AVISO_PLATO_EMPTY_NOT_ADDED", "AVISO_PLATO_EMPTY_NOT_DELETED",
+                                     "AVISO_COMIDA_EMPTY_NOT_SAVED", "AVISO_NO_WIFI_BARCODE", "AVISO_NO_BARCODE",
+                                     "AVISO_PRODUCT_NOT_FOUND", "GO_TO_INIT", "GO_TO_PLATO", "GO_TO_GRUPO", "GO_TO_BARCODE_READ",
+                                     "GO_TO_BARCODE", "GO_TO_RAW", "GO_TO_COOKED", "GO_TO_WEIGHTED", "GO_TO_ADD_CHECK",
+                                     "GO_TO_ADDED", "GO_TO_DELETE_CHECK", "GO_TO_DELETED", "GO_TO_SAVE_CHECK", "GO_TO_SAVED",
+                                     "GO_TO_CANCEL", "AVISO_LISTA_LLENA", "DELETE_FILES" };
+    return ((evento >= 0) and (evento < (int)(sizeof(nombres) / sizeof(nombres[0])))) ? nombres[evento] : "?";
+}
+
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file debug_log.cpp
+ * @brief Herramienta de PC para decodificar la salida de SerialPC con el log binario (Debug_Log.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta:
+ *
+ *      g++ -std=c++11 -O2 -I../common -I"../../smartcloth_v2" -o debug_log debug_log.cpp
+ *
+ * Uso (con la salida de SerialPC capturada en bruto, p. ej. con 'cat /dev/ttyACM0 > captura.bin'):
+ *
+ *      debug_log captura.bin       --> Texto tal cual y cada registro binario como
+ *      debug_log < captura.bin         "[    123456 ms] mensaje" en una línea
+ *
+ * Los formatos se leen de Log_Diccionario.h, así que hay que compilar la herramienta con la misma
+ * versión del sketch que ha generado el log.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "nombres_sm.h" // nombreEstado(), nombreEvento()
+
+#define LOG_CON_TEXTOS
+#include "Log_Diccionario.h" // idLog_t, formatosLog[]
+
+
+#define LOG_SINCRONIA       0xFE        // Igual que Debug_Log.h
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee un entero de 4 bytes (little endian).
+ * @return 'false' si se acaba el fichero
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerU32(FILE *f, uint32_t &v)
+{
+    uint8_t b[4];
+    if(fread(b, 1, 4, f) != 4) return false;
+    v = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee los argumentos de un registro siguiendo su formato y devuelve el mensaje completo.
+ * @return 'false' si se acaba el fichero antes de completar el registro
+ */
+/*-----------------------------------------------------------------------------*/
+bool decodificarRegistro(FILE *f, const char *formato, std::string &mensaje)
+{
+    char buf[64];
+
+    for(const char *p = formato; *p; p++)
+    {
+        if(*p != '%'){ mensaje += *p; continue; }
+
+        // Especificador: %[.N]c
+        std::string espec = "%";
+        p++;
+        while(*p and strchr(".0123456789", *p)) espec += *p++;
+        if(!*p) break;
+
+        uint32_t v;
+        switch(*p)
+        {
+            case 'd':   if(!leerU32(f, v)) return false; snprintf(buf, sizeof(buf), (espec + "d").c_str(), (int32_t)v); mensaje += buf; break;
+            case 'u':   if(!leerU32(f, v)) return false; snprintf(buf, sizeof(buf), (espec + "u").c_str(), v); mensaje += buf; break;
+            case 'x':   if(!leerU32(f, v)) return false; snprintf(buf, sizeof(buf), (espec + "x").c_str(), v); mensaje += buf; break;
+            case 'E':   if(!leerU32(f, v)) return false; mensaje += nombreEvento(v); break;
+            case 'S':   if(!leerU32(f, v)) return false; mensaje += nombreEstado(v); break;
+            case 'f':
+            {
+                if(!leerU32(f, v)) return false;
+                float x;
+                memcpy(&x, &v, 4);
+                snprintf(buf, sizeof(buf), (espec + "f").c_str(), x);
+                mensaje += buf;
+                break;
+            }
+            case 's':
+            {
+                int n = fgetc(f);
+                if(n == EOF) return false;
+                std::string texto(n, '\0');
+                if(n and (fread(&texto[0], 1, n, f) != (size_t)n)) return false;
+                mensaje += texto;
+                break;
+            }
+            case '%':   mensaje += '%'; break;
+            default:    mensaje += espec + *p;
+        }
+    }
+
+    return true;
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    if(argc > 2)
+    {
+        fprintf(stderr, "Uso: %s [captura.bin]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = stdin;
+    if(argc == 2)
+    {
+        f = fopen(argv[1], "rb");
+        if(!f){ fprintf(stderr, "No se puede abrir %s\n", argv[1]); return 2; }
+    }
+
+    bool inicioLinea = true;
+    int c;
+    while((c = fgetc(f)) != EOF)
+    {
+        if(c != LOG_SINCRONIA)
+        {
+            putchar(c);
+            inicioLinea = (c == '\n');
+            continue;
+        }
+
+        // Registro binario: [ID 2 bytes][millis() 4 bytes][argumentos]
+        int lo = fgetc(f), hi = fgetc(f);
+        uint32_t ms;
+        if((hi == EOF) or !leerU32(f, ms)){ fprintf(stderr, "\nRegistro incompleto al final\n"); break; }
+
+        uint16_t id = lo | (hi << 8);
+        if(id >= NUM_MENSAJES_LOG)
+        {
+            // Sin el formato no se sabe cuánto ocupa: el resto del log no se puede decodificar
+            fprintf(stderr, "\nID de mensaje desconocido: %u (¿Log_Diccionario.h de otra versión?)\n", id);
+            break;
+        }
+
+        std::string mensaje;
+        if(!decodificarRegistro(f, formatosLog[id], mensaje)){ fprintf(stderr, "\nRegistro incompleto al final\n"); break; }
+
+        if(!inicioLinea) putchar('\n');
+        printf("[%10u ms] %s\n", ms, mensaje.c_str());
+        inicioLinea = true;
+    }
+
+    if(f != stdin) fclose(f);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file event_queue_stress.cpp
+ * @brief Prueba de carga en PC de las colas de eventos (Event_Queue.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta:
+ *
+ *      g++ -std=c++11 -O2 -pthread -I"../../smartcloth_v2" -o event_queue_stress event_queue_stress.cpp
+ *
+ * Uso:
+ *
+ *      event_queue_stress [rafagas]
+ *
+ * Cada fuente de interrupción (main, grande y barcode) es un hilo productor con su propia cola,
+ * como las ISR, y el hilo principal hace de loop: en cada "ciclo" saca todas las pulsaciones de
+ * las tres colas, las pasa a la cola de la Máquina de Estados y la vacía entera. Los hilos se
+ * ejecutan a la vez de verdad, lo que es más exigente que una ISR interrumpiendo al loop.
+ *
+ * Cada productor mete ráfagas de hasta COLA_EVENTOS_SIZE - 1 elementos numerados. Se comprueba
+ * que el loop recibe todos, sin huecos ni desorden, y que ningún contador 'perdidos' sube. Al
+ * final se repite con ráfagas mayores que la cola para comprobar que lo que no cabe se cuenta
+ * como perdido en lugar de pisar otros elementos.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+
+typedef uint8_t byte;
+
+#include "Event_Queue.h"
+
+
+#define FUENTES 3
+
+colaEventos_t       colasISR[FUENTES];      // Una cola por fuente, como colaMain, colaGrande y colaBarcode
+colaEventos_t       colaSM;                 // Cola de la Máquina de Estados (productor y consumidor: el loop)
+std::atomic<bool>   fin(false);
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Productor (ISR simulada). Mete ráfagas de elementos numerados y espera a que el loop
+ *        vacíe su cola antes de la siguiente, como pulsaciones separadas por el tiempo de un ciclo.
+ * @param fuente Índice de la cola
+ * @param rafagas Número de ráfagas
+ * @param tamMax Tamaño máximo de ráfaga
+ */
+/*-----------------------------------------------------------------------------*/
+void productor(int fuente, unsigned rafagas, unsigned tamMax)
+{
+    unsigned long secuencia = 0;
+    unsigned semilla = 1000 + fuente;
+
+    for(unsigned r = 0; r < rafagas; r++)
+    {
+        unsigned tam = 1 + rand_r(&semilla) % tamMax;
+        for(unsigned i = 0; i < tam; i++)
+        {
+            if(pushCola(colasISR[fuente], (byte)fuente, secuencia)) secuencia++;
+        }
+        while(!isColaVacia(colasISR[fuente]) and !fin) std::this_thread::yield();
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Ejecuta una prueba completa.
+ * @return Elementos perdidos (contadores 'perdidos' de todas las colas)
+ */
+/*-----------------------------------------------------------------------------*/
+unsigned long prueba(unsigned rafagas, unsigned tamMax, bool &ordenCorrecto, unsigned long &recibidos)
+{
+    for(int f = 0; f < FUENTES; f++){ colasISR[f].head = colasISR[f].tail = 0; colasISR[f].perdidos = 0; }
+    colaSM.head = colaSM.tail = 0; colaSM.perdidos = 0;
+    fin = false;
+
+    unsigned long siguiente[FUENTES] = {0};
+    ordenCorrecto = true;
+    recibidos = 0;
+
+    std::thread hilos[FUENTES];
+    for(int f = 0; f < FUENTES; f++) hilos[f] = std::thread(productor, f, rafagas, tamMax);
+
+    std::atomic<int> terminados(0);
+    std::thread vigilante([&](){ for(int f = 0; f < FUENTES; f++) hilos[f].join(); terminados = 1; });
+
+    // ---- Loop: checkAllButtons() + vaciar la cola de eventos ----
+    while(true)
+    {
+        bool acabado = (terminados == 1); // Leer antes de vaciar para no dejar elementos sin sacar
+        eventoCola_t e;
+        for(int f = 0; f < FUENTES; f++)
+        {
+            while(popCola(colasISR[f], e))
+            {
+                if(!pushCola(colaSM, e.codigo, e.tiempo)) break;
+                while(popCola(colaSM, e)) // El loop evalúa todos los eventos pendientes
+                {
+                    if(e.tiempo != siguiente[e.codigo]) ordenCorrecto = false;
+                    siguiente[e.codigo] = e.tiempo + 1;
+                    recibidos++;
+                }
+            }
+        }
+        if(acabado) break;
+    }
+    fin = true;
+    vigilante.join();
+
+    unsigned long perdidos = colaSM.perdidos;
+    for(int f = 0; f < FUENTES; f++) perdidos += colasISR[f].perdidos;
+    return perdidos;
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    unsigned rafagas = (argc > 1) ? atoi(argv[1]) : 5000;
+    bool orden;
+    unsigned long recibidos;
+
+    // ---- Ráfagas que caben en la cola: no se puede perder nada ----
+    unsigned long perdidos = prueba(rafagas, COLA_EVENTOS_SIZE - 1, orden, recibidos);
+    printf("Rafagas de hasta %d por fuente (%d fuentes, %u rafagas):\n", COLA_EVENTOS_SIZE - 1, FUENTES, rafagas);
+    printf("    Recibidos: %lu   Perdidos: %lu   Orden: %s\n", recibidos, perdidos, orden ? "correcto" : "INCORRECTO");
+    bool ok = (perdidos == 0) and orden;
+
+    // ---- Ráfagas mayores que la cola: lo que no cabe se cuenta, lo demás llega en orden ----
+    perdidos = prueba(rafagas / 10, 2 * COLA_EVENTOS_SIZE, orden, recibidos);
+    printf("Rafagas de hasta %d (mayores que la cola):\n", 2 * COLA_EVENTOS_SIZE);
+    printf("    Recibidos: %lu   Perdidos (contados): %lu   Orden: %s\n", recibidos, perdidos, orden ? "correcto" : "INCORRECTO");
+    ok = ok and orden;
+
+    printf("\n%s\n", ok ? "OK" : "FALLO");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file flight_recorder.cpp
+ * @brief Herramienta de PC para decodificar los volcados del registro de vuelo (Flight_Recorder.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta:
+ *
+ *      g++ -std=c++11 -O2 -I../common -o flight_recorder flight_recorder.cpp
+ *
+ * Uso (con el fichero data/vuelo.rec copiado de la SD):
+ *
+ *      flight_recorder timeline vuelo.rec  --> Todos los registros de cada volcado en orden, con el
+ *                                              tiempo en ms desde el arranque del Due
+ *      flight_recorder hist vuelo.rec      --> Por estado: histograma de la duración de sus actividades
+ *                                              y latencia de las transiciones que llegan a él
+ *
+ * Los nombres de los estados y eventos están en tools/common/nombres_sm.h.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include "nombres_sm.h" // nombreEstado(), nombreEvento()
+
+
+// ------ FORMATO DEL FICHERO (igual que Flight_Recorder.h) -------------------
+#define VUELO_MAGIC         0x52464353
+#define VUELO_VERSION       1
+
+#define VUELO_ARRANQUE      1
+#define VUELO_TRANSICION    2
+#define VUELO_ACTIVIDAD     3
+#define VUELO_ERROR         4
+#define VUELO_BASCULA       5
+
+#define VOLCADO_ERROR       1
+#define VOLCADO_PEDIDO      2
+
+typedef struct __attribute__((packed)) {
+    uint32_t  tiempo;
+    int32_t   valor;
+    int32_t   extra;
+    uint8_t   tipo;
+    uint8_t   a;
+    uint8_t   b;
+    uint8_t   c;
+} registroVuelo_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t  magic;
+    uint16_t  version;
+    uint16_t  tamRegistro;
+    uint16_t  nRegistros;
+    uint8_t   motivo;
+    uint8_t   estado;
+    uint32_t  millisVolcado;
+    uint32_t  microsVolcado;
+    uint32_t  primerRegistro;
+    uint32_t  perdidos;
+} cabeceraVuelo_t;
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    cabeceraVuelo_t                 cabecera;
+    bool                            nuevaSesion;    // El Due ha arrancado antes de este volcado
+    std::vector<registroVuelo_t>    registros;
+    std::vector<double>             ms;             // Tiempo de cada registro (ms desde el arranque)
+} volcado_t;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee todos los volcados del fichero y calcula el tiempo de cada registro a partir de
+ *        su antigüedad respecto al micros() del volcado (micros() da la vuelta cada ~71 min).
+ * @return 'false' si el fichero no existe o no es un registro de vuelo válido
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerVolcados(const char *ruta, std::vector<volcado_t> &volcados)
+{
+    FILE *f = fopen(ruta, "rb");
+    if(!f){ fprintf(stderr, "No se puede abrir %s\n", ruta); return false; }
+
+    volcado_t v;
+    while(fread(&v.cabecera, sizeof(cabeceraVuelo_t), 1, f) == 1)
+    {
+        const cabeceraVuelo_t &c = v.cabecera;
+        if((c.magic != VUELO_MAGIC) or (c.version != VUELO_VERSION) or (c.tamRegistro != sizeof(registroVuelo_t)))
+        {
+            fprintf(stderr, "%s: volcado %u no valido (version %d)\n", ruta, (unsigned)volcados.size() + 1, VUELO_VERSION);
+            break;
+        }
+
+        v.registros.resize(c.nRegistros);
+        if(fread(v.registros.data(), sizeof(registroVuelo_t), c.nRegistros, f) != c.nRegistros)
+        {
+            fprintf(stderr, "%s: volcado %u incompleto\n", ruta, (unsigned)volcados.size() + 1);
+            break;
+        }
+
+        v.ms.clear();
+        for(const registroVuelo_t &r : v.registros) v.ms.push_back(c.millisVolcado - (uint32_t)(c.microsVolcado - r.tiempo) / 1000.0);
+
+        // El contador de registros vuelve a empezar en cada arranque
+        v.nuevaSesion = volcados.empty() or (c.primerRegistro < volcados.back().cabecera.primerRegistro + volcados.back().cabecera.nRegistros);
+        volcados.push_back(v);
+    }
+
+    fclose(f);
+    return !volcados.empty();
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra todos los registros de cada volcado.
+ */
+/*-----------------------------------------------------------------------------*/
+void timeline(const std::vector<volcado_t> &volcados)
+{
+    for(const volcado_t &v : volcados)
+    {
+        const cabeceraVuelo_t &c = v.cabecera;
+        if(v.nuevaSesion) printf("\n------------------------- nueva sesion -------------------------\n");
+        printf("\n=== Volcado (%s) en %s a los %u ms: %u registros", (c.motivo == VOLCADO_ERROR) ? "ERROR" : "pedido",
+                nombreEstado(c.estado), c.millisVolcado, c.nRegistros);
+        if(c.perdidos) printf(", %u perdidos antes", c.perdidos);
+        printf(" ===\n");
+
+        for(size_t i = 0; i < v.registros.size(); i++)
+        {
+            const registroVuelo_t &r = v.registros[i];
+            printf("%12.3f  ", v.ms[i]);
+            switch(r.tipo)
+            {
+                case VUELO_ARRANQUE:
+                    printf("ARRANQUE    en %s tras %d ms de setup()\n", nombreEstado(r.a), r.valor);
+                    break;
+                case VUELO_TRANSICION:
+                    printf("TRANSICION  %s --%s--> %s  (%d ms desde el evento)\n", nombreEstado(r.b), nombreEvento(r.a),
+                            nombreEstado(r.c), r.valor);
+                    break;
+                case VUELO_ACTIVIDAD:
+                    printf("ACTIVIDAD   %-16s %9.3f ms%s\n", nombreEstado(r.a), r.valor / 1000.0, r.b ? "  (entrada)" : "");
+                    break;
+                case VUELO_ERROR:
+                    printf("ERROR       %s en %s\n", nombreEvento(r.a), nombreEstado(r.b));
+                    break;
+                case VUELO_BASCULA:
+                    printf("BASCULA     %u muestras, %u estables, ruido %d cuentas, peso %.3f g\n", r.a, r.b, r.valor, r.extra / 1000.0);
+                    break;
+                default:
+                    printf("? tipo %u\n", r.tipo);
+            }
+        }
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Percentil de una lista de valores ya ordenada.
+ */
+/*-----------------------------------------------------------------------------*/
+double percentil(const std::vector<double> &ordenados, double p)
+{
+    return ordenados[(size_t)(p * (ordenados.size() - 1) + 0.5)];
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Histogramas por estado. Las actividades se agrupan en potencias de 2 de us; las de menos
+ *        de VUELO_UMBRAL_ACTIVIDAD_US solo están si fueron la entrada al estado.
+ */
+/*-----------------------------------------------------------------------------*/
+void hist(const std::vector<volcado_t> &volcados)
+{
+    const int NUM_CUBOS = 16;   // 128 us .. 4 s
+    std::vector<double> actividades[256], latencias[256];
+
+    for(const volcado_t &v : volcados)
+    {
+        for(const registroVuelo_t &r : v.registros)
+        {
+            if(r.tipo == VUELO_ACTIVIDAD) actividades[r.a].push_back(r.valor);
+            else if(r.tipo == VUELO_TRANSICION) latencias[r.c].push_back(r.valor);
+        }
+    }
+
+    for(int e = 0; e < 256; e++)
+    {
+        if(actividades[e].empty() and latencias[e].empty()) continue;
+        printf("\n%s\n", nombreEstado(e));
+
+        if(!latencias[e].empty())
+        {
+            std::vector<double> &l = latencias[e];
+            std::sort(l.begin(), l.end());
+            printf("  Transiciones: %zu   latencia desde el evento p50 %.0f ms, p95 %.0f ms, max %.0f ms\n",
+                    l.size(), percentil(l, 0.5), percentil(l, 0.95), l.back());
+        }
+
+        if(actividades[e].empty()) continue;
+        std::vector<double> &a = actividades[e];
+        std::sort(a.begin(), a.end());
+        printf("  Actividades: %zu   p50 %.3f ms, p95 %.3f ms, max %.3f ms\n",
+                a.size(), percentil(a, 0.5) / 1000.0, percentil(a, 0.95) / 1000.0, a.back() / 1000.0);
+
+        int cubos[NUM_CUBOS] = {0};
+        int maxCubo = 0;
+        for(double us : a)
+        {
+            int c = 0;
+            while((c < NUM_CUBOS - 1) and (us >= (128 << c))) c++;
+            cubos[c]++;
+            maxCubo = std::max(maxCubo, cubos[c]);
+        }
+        for(int c = 0; c < NUM_CUBOS; c++)
+        {
+            if(!cubos[c]) continue;
+            if(c == 0) printf("  %10s", "< 128 us");
+            else if((128 << c) >= 1000) printf("  < %5.0f ms", (128 << c) / 1000.0);
+            else printf("  < %5d us", 128 << c);
+            printf(" %6d |%s\n", cubos[c], std::string(1 + cubos[c] * 50 / maxCubo, '#').c_str());
+        }
+    }
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    if(argc != 3)
+    {
+        fprintf(stderr, "Uso: %s timeline|hist <vuelo.rec>\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<volcado_t> volcados;
+    if(!leerVolcados(argv[2], volcados)) return 2;
+
+    if(strcmp(argv[1], "timeline") == 0) timeline(volcados);
+    else if(strcmp(argv[1], "hist") == 0) hist(volcados);
+    else
+    {
+        fprintf(stderr, "Comando desconocido: %s\n", argv[1]);
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * @file Arduino.h
+ * @brief Núcleo de Arduino para el simulador en PC: tipos, String, Print/Stream, puertos serie,
+ *        pines, interrupciones y tiempo
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Sustituye al núcleo del Due al compilar el sketch en el PC (tools/host_sim). Solo tiene lo que
+ * usan el sketch, RA8876_v2.cpp y la librería HX711. El tiempo es el reloj virtual del simulador
+ * (Host.h): millis() y micros() no miden el PC, sino el tiempo que habría pasado en el Due.
+ *
+ * @note En el PC 'long' es de 64 bits y en el Due de 32. El sketch no depende de ello salvo en la
+ *       extensión de signo de las cuentas del HX711, así que la báscula simulada da cuentas positivas.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+typedef uint8_t     byte;
+typedef bool        boolean;
+typedef uint16_t    word;
+
+// ------ CONSTANTES (mismos valores que el núcleo del Due) -------------------------
+#define HIGH            1
+#define LOW             0
+
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+
+#define CHANGE          2
+#define FALLING         3
+#define RISING          4
+
+#define DEC             10
+#define HEX             16
+#define OCT             8
+#define BIN             2
+
+#define LSBFIRST        0
+#define MSBFIRST        1
+
+#define SDA             20
+#define SCL             21
+
+#define NUM_PINES       80
+// -----------------------------------------------------------------------------
+
+// ------ FLASH (en el PC todo está en RAM) -------------------------------------------
+#define F(x)            (x)
+#define PSTR(x)         (x)
+#define PROGMEM
+struct __FlashStringHelper;
+// -----------------------------------------------------------------------------
+
+// ------ MATEMÁTICAS -----------------------------------------------------------------
+using std::abs;
+using ::round;
+
+template<class A, class B> inline A     min(A a, B b){ return (a < b) ? a : (A)b; }
+template<class A, class B> inline A     max(A a, B b){ return (a > b) ? a : (A)b; }
+template<class T, class A, class B> inline T constrain(T x, A a, B b){ return (x < a) ? (T)a : ((x > b) ? (T)b : x); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax){ return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin; }
+
+long    random(long hasta);
+long    random(long desde, long hasta);
+void    randomSeed(unsigned long semilla);
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+                                   STRING
+*******************************************************************************/
+void hostReservaString();    // Cuenta una reserva de heap del String (Host.cpp, hostStats.reservasString)
+
+// Además de hacer lo mismo, cuenta las reservas de heap (malloc/realloc) que haría el String del núcleo
+// del Due, que reserva justo lo que necesita: una al construir (también vacío o con un número), copiar
+// o sacar un substring(), y otra cada vez que concat(), +=, = o replace() no caben en lo reservado.
+// El std::string del PC guarda los textos cortos sin reservar, así que no sirve para contarlas.
+class String : public std::string
+{
+public:
+    String(){ reservar(0); }                                        // En el Due: String(const char *cstr = "")
+    String(const char *s) : std::string(s ? s : ""){ reservar(size()); }
+    String(const std::string &s) : std::string(s){ reservar(size()); }
+    String(const String &s) : std::string(s){ reservar(size()); }
+    String(String &&s) : std::string(std::move(s)), capacidad(s.capacidad){}
+    String(char c) : std::string(1, c){ reservar(size()); }
+    String(unsigned char v, int base = DEC) : std::string(numero(v, base)){ reservar(size()); }
+    String(int v, int base = DEC) : std::string(numero(v, base)){ reservar(size()); }
+    String(unsigned int v, int base = DEC) : std::string(numero(v, base)){ reservar(size()); }
+    String(long v, int base = DEC) : std::string(numero(v, base)){ reservar(size()); }
+    String(unsigned long v, int base = DEC) : std::string(numero(v, base)){ reservar(size()); }
+    String(float v, int decimales = 2) : std::string(decimal(v, decimales)){ reservar(size()); }
+    String(double v, int decimales = 2) : std::string(decimal(v, decimales)){ reservar(size()); }
+
+    String&     operator=(const String &s){ if(this != &s){ reservar(s.size()); assign(s); } return *this; }
+    String&     operator=(String &&s){ std::string::operator=(std::move(s)); capacidad = s.capacidad; return *this; }
+    String&     operator=(const char *s){ s = s ? s : ""; reservar(strlen(s)); assign(s); return *this; }
+
+    static std::string numero(long long v, int base);
+    static std::string decimal(double v, int decimales);
+
+    unsigned    length() const { return (unsigned)size(); }
+    char        charAt(unsigned i) const { return (i < size()) ? (*this)[i] : 0; }
+    void        setCharAt(unsigned i, char c){ if(i < size()) (*this)[i] = c; }
+    bool        reserve(unsigned n){ reservar(n); std::string::reserve(n); return true; }
+
+    int         indexOf(char c, unsigned desde = 0) const { size_t p = find(c, desde); return (p == npos) ? -1 : (int)p; }
+    int         indexOf(const String &s, unsigned desde = 0) const { size_t p = find(s, desde); return (p == npos) ? -1 : (int)p; }
+    int         lastIndexOf(char c) const { size_t p = rfind(c); return (p == npos) ? -1 : (int)p; }
+    int         lastIndexOf(const String &s) const { size_t p = rfind(s); return (p == npos) ? -1 : (int)p; }
+    String      substring(unsigned a) const { return (a > size()) ? String() : String(substr(a)); }
+    String      substring(unsigned a, unsigned b) const { if(a > b) std::swap(a, b); return (a > size()) ? String() : String(substr(a, b - a)); }
+
+    bool        startsWith(const String &s) const { return compare(0, s.size(), s) == 0; }
+    bool        endsWith(const String &s) const { return (size() >= s.size()) and (compare(size() - s.size(), s.size(), s) == 0); }
+    bool        equals(const String &s) const { return *this == s; }
+    bool        equalsIgnoreCase(const String &s) const;
+
+    void        replace(const String &a, const String &b);
+    void        replace(char a, char b){ for(size_t i = 0; i < size(); i++) if((*this)[i] == a) (*this)[i] = b; }
+    void        remove(unsigned i){ if(i < size()) erase(i); }
+    void        remove(unsigned i, unsigned n){ if(i < size()) erase(i, n); }
+    void        trim();
+    void        toUpperCase(){ for(size_t i = 0; i < size(); i++) (*this)[i] = toupper((unsigned char)(*this)[i]); }
+    void        toLowerCase(){ for(size_t i = 0; i < size(); i++) (*this)[i] = tolower((unsigned char)(*this)[i]); }
+
+    long        toInt() const { return atol(c_str()); }
+    float       toFloat() const { return (float)atof(c_str()); }
+    double      toDouble() const { return atof(c_str()); }
+
+    void        toCharArray(char *buf, unsigned n) const { if(!n) return; strncpy(buf, c_str(), n); buf[n - 1] = '\0'; }
+    void        getBytes(unsigned char *buf, unsigned n) const { toCharArray((char*)buf, n); }
+
+    // Lo que se añade se convierte sin crear otro String (el Due usa un buffer en la pila)
+    template<class T> bool      concat(const T &v){ anadir(texto(v)); return true; }
+    template<class T> String&   operator+=(const T &v){ anadir(texto(v)); return *this; }
+
+private:
+    unsigned    capacidad = 0;      // Lo reservado por el String del Due (sin contar el '\0')
+    bool        conBuffer = false;
+
+    void        reservar(unsigned n){ if(!conBuffer or (capacidad < n)){ hostReservaString(); capacidad = n; conBuffer = true; } }
+    void        anadir(const std::string &t){ if(t.empty()) return; reservar(size() + t.size()); append(t); }
+
+    static std::string  texto(const std::string &s){ return s; }
+    static std::string  texto(const char *s){ return s ? s : ""; }
+    static std::string  texto(char c){ return std::string(1, c); }
+    static std::string  texto(unsigned char v){ return numero(v, DEC); }
+    static std::string  texto(int v){ return numero(v, DEC); }
+    static std::string  texto(unsigned int v){ return numero(v, DEC); }
+    static std::string  texto(long v){ return numero(v, DEC); }
+    static std::string  texto(unsigned long v){ return numero(v, DEC); }
+    static std::string  texto(float v){ return decimal(v, 2); }
+    static std::string  texto(double v){ return decimal(v, 2); }
+};
+
+template<class T> inline String operator+(const String &a, const T &b){ String r(a); r += b; return r; }
+inline String operator+(const String &a, const String &b){ String r(a); r += b; return r; }
+inline String operator+(const String &a, const char *b){ String r(a); r += b; return r; }
+inline String operator+(const char *a, const String &b){ String r(a); r += b; return r; }
+inline String operator+(char a, const String &b){ String r(a); r += b; return r; }
+
+
+
+
+/*******************************************************************************
+                                PRINT Y STREAM
+*******************************************************************************/
+class Print
+{
+public:
+    virtual ~Print(){}
+    virtual size_t  write(uint8_t b) = 0;
+    virtual size_t  write(const uint8_t *buf, size_t n){ for(size_t i = 0; i < n; i++) write(buf[i]); return n; }
+    size_t          write(const char *s){ return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+    size_t          write(const char *buf, size_t n){ return write((const uint8_t*)buf, n); }
+    virtual void    flush(){}
+
+    size_t  print(const char *s){ return write(s); }
+    size_t  print(const String &s){ return write((const uint8_t*)s.data(), s.size()); }
+    size_t  print(char c){ return write((uint8_t)c); }
+    size_t  print(unsigned char v, int base = DEC){ return print(String::numero(v, base).c_str()); }
+    size_t  print(int v, int base = DEC){ return print(String::numero(v, base).c_str()); }
+    size_t  print(unsigned int v, int base = DEC){ return print(String::numero(v, base).c_str()); }
+    size_t  print(long v, int base = DEC){ return print(String::numero(v, base).c_str()); }
+    size_t  print(unsigned long v, int base = DEC){ return print(String::numero(v, base).c_str()); }
+    size_t  print(long long v, int base = DEC){ return print(String::numero(v, base).c_str()); }
+    size_t  print(unsigned long long v, int base = DEC){ return print(String::numero((long long)v, base).c_str()); }
+    size_t  print(double v, int decimales = 2){ return print(String::decimal(v, decimales).c_str()); }
+
+    size_t  println(){ return write("\r\n"); }
+    template<class T> size_t println(const T &v){ size_t n = print(v); return n + println(); }
+    template<class T> size_t println(const T &v, int formato){ size_t n = print(v, formato); return n + println(); }
+};
+
+
+class Stream : public Print
+{
+public:
+    virtual int     available() = 0;
+    virtual int     read() = 0;
+    virtual int     peek() = 0;
+    using Print::write;
+
+    void            setTimeout(unsigned long ms){ timeout = ms; }
+    String          readStringUntil(char fin);
+    String          readString(){ return readStringUntil('\0'); }
+    size_t          readBytesUntil(char fin, char *buf, size_t n);
+    size_t          readBytes(char *buf, size_t n);
+    size_t          readBytes(uint8_t *buf, size_t n){ return readBytes((char*)buf, n); }
+
+protected:
+    unsigned long   timeout = 1000;
+    int             timedRead();    // Como en el núcleo: espera hasta 'timeout' ms (virtuales) a que llegue un byte
+};
+
+
+
+
+/*******************************************************************************
+                                PUERTOS SERIE
+*******************************************************************************/
+// Serial (PC) va a la salida estándar del simulador y Serial1 al ESP32 simulado (Host.h)
+class HardwareSerial : public Stream
+{
+public:
+    explicit HardwareSerial(int puerto) : puerto(puerto){}
+    void        begin(unsigned long){}
+    void        end(){}
+    operator    bool(){ return true; }
+
+    size_t      write(uint8_t b);
+    using Print::write;
+    int         available();
+    int         read();
+    int         peek();
+    int         availableForWrite(){ return 128; }  // El envío no cuesta tiempo virtual: siempre cabe el buffer del UART
+
+private:
+    int         puerto;
+};
+
+extern HardwareSerial Serial, Serial1, Serial2, Serial3;
+
+
+
+
+/*******************************************************************************
+                           PINES, INTERRUPCIONES Y TIEMPO
+*******************************************************************************/
+void            pinMode(uint32_t pin, uint32_t modo);
+void            digitalWrite(uint32_t pin, uint32_t nivel);
+int             digitalRead(uint32_t pin);
+int             analogRead(uint32_t pin);
+void            analogWrite(uint32_t pin, uint32_t valor);
+uint8_t         shiftIn(uint32_t pinDatos, uint32_t pinReloj, uint32_t orden);
+void            shiftOut(uint32_t pinDatos, uint32_t pinReloj, uint32_t orden, uint8_t valor);
+
+#define digitalPinToInterrupt(p)    (p)
+void            attachInterrupt(uint32_t pin, void (*isr)(void), uint32_t modo);
+void            detachInterrupt(uint32_t pin);
+void            noInterrupts();
+void            interrupts();
+
+unsigned long   millis();
+unsigned long   micros();
+void            delay(unsigned long ms);
+void            delayMicroseconds(unsigned int us);
+inline void     yield(){}
+
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file DS3231.h
+ * @brief RTC DS3231 para el simulador en PC: la hora de inicio de la sesión (hostFechaInicio(),
+ *        Host.h) más el tiempo virtual transcurrido
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Misma interfaz que la librería DS3231 de Rinky-Dink Electronics que usa RTC.h.
+ */
+
+#ifndef HOST_DS3231_H
+#define HOST_DS3231_H
+
+#include "Arduino.h"
+
+#define FORMAT_SHORT        1
+#define FORMAT_LONG         2
+
+#define FORMAT_LITTLEENDIAN 1
+#define FORMAT_BIGENDIAN    2
+#define FORMAT_MIDDLEENDIAN 3
+
+
+class Time
+{
+public:
+    uint8_t     hour;
+    uint8_t     min;
+    uint8_t     sec;
+    uint8_t     date;
+    uint8_t     mon;
+    uint16_t    year;
+    uint8_t     dow;
+};
+
+
+class DS3231
+{
+public:
+    DS3231(uint8_t, uint8_t){}
+    void        begin(){}
+    Time        getTime();
+    char*       getDateStr(uint8_t formato = FORMAT_LONG, uint8_t orden = FORMAT_LITTLEENDIAN, char separador = '.');
+    char*       getTimeStr(uint8_t formato = FORMAT_LONG);
+    void        setTime(uint8_t hora, uint8_t min, uint8_t seg);
+    void        setDate(uint8_t dia, uint8_t mes, uint16_t anio);
+    void        setDOW(uint8_t){}
+    float       getTemp(){ return 21.0; }
+
+private:
+    char        bufFecha[16];       // Cada texto en su buffer, como en la librería: getDateStr() y getTimeStr() se usan a la vez
+    char        bufHora[16];
+};
+
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file DueFlashStorage.h
+ * @brief Flash del Due para el simulador en PC: un array en RAM que empieza borrado (0xFF),
+ *        como tras subir un sketch nuevo
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ */
+
+#ifndef HOST_DUEFLASHSTORAGE_H
+#define HOST_DUEFLASHSTORAGE_H
+
+#include "Arduino.h"
+
+#define HOST_FLASH_SIZE     4096
+
+extern byte hostFlash[HOST_FLASH_SIZE];
+
+
+class DueFlashStorage
+{
+public:
+    byte    read(uint32_t dir){ return (dir < HOST_FLASH_SIZE) ? hostFlash[dir] : 0xFF; }
+    byte*   readAddress(uint32_t dir){ return &hostFlash[(dir < HOST_FLASH_SIZE) ? dir : 0]; }
+    bool    write(uint32_t dir, byte dato){ if(dir >= HOST_FLASH_SIZE) return false; hostFlash[dir] = dato; return true; }
+    bool    write(uint32_t dir, byte *datos, uint32_t n){ if(dir + n > HOST_FLASH_SIZE) return false; memcpy(&hostFlash[dir], datos, n); return true; }
+};
+
+
+#endif
@@ -0,0 +1,978 @@
+/**
+ * @file Host.cpp
+ * @brief Implementación en PC del núcleo de Arduino, de las librerías que usa el sketch y de los
+ *        modelos de los periféricos (ver Host.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ */
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "SD.h"
+#include "DS3231.h"
+#include "DueFlashStorage.h"
+#include "SAMDUETimerInterrupt.h"
+#include "Host.h"
+
+#include <queue>
+#include <deque>
+#include <set>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <time.h>
+
+
+// ------ OBJETOS GLOBALES DEL NÚCLEO Y LIBRERÍAS -------------------------------------
+hostStats_t     hostStats;
+
+HardwareSerial  Serial(0), Serial1(1), Serial2(2), Serial3(3);
+SPIClass        SPI;
+SDClass         SD;
+DueTimerClass   DueTimer;
+
+byte            hostFlash[HOST_FLASH_SIZE];
+static struct iniFlash_t { iniFlash_t(){ memset(hostFlash, 0xFF, sizeof(hostFlash)); } } iniFlash; // Flash borrada
+
+static std::mt19937 generador(1234);
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+                          RELOJ VIRTUAL Y EVENTOS
+*******************************************************************************/
+typedef struct {
+    unsigned long long      ns;
+    unsigned long long      orden;      // Desempate: en el orden en que se programaron
+    std::function<void()>   accion;
+} evento_t;
+
+struct eventoPosterior {
+    bool operator()(const evento_t &a, const evento_t &b) const { return (a.ns != b.ns) ? (a.ns > b.ns) : (a.orden > b.orden); }
+};
+
+static unsigned long long   relojNs = 0;
+static unsigned long long   nProgramados = 0;
+static std::priority_queue<evento_t, std::vector<evento_t>, eventoPosterior> eventos;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Ejecuta en orden los eventos que vencen hasta 'destino' y deja el reloj en 'destino'.
+ *        Un evento puede volver a avanzar el reloj (p. ej. una ISR que llama a micros()).
+ */
+/*-----------------------------------------------------------------------------*/
+static void ejecutarHasta(unsigned long long destino)
+{
+    while(!eventos.empty() and (eventos.top().ns <= destino))
+    {
+        evento_t e = eventos.top();
+        eventos.pop();
+        if(e.ns > relojNs) relojNs = e.ns;
+        e.accion();
+    }
+    if(destino > relojNs) relojNs = destino;
+}
+
+unsigned long long hostAhoraNs(){ return relojNs; }
+void hostAvanzarNs(unsigned long long ns){ ejecutarHasta(relojNs + ns); }
+bool hostHayEventos(){ return !eventos.empty(); }
+
+void hostProgramar(unsigned long long ns, std::function<void()> accion)
+{
+    evento_t e = { ns, nProgramados++, accion };
+    eventos.push(e);
+}
+
+
+
+
+/*******************************************************************************
+                          PINES E INTERRUPCIONES
+*******************************************************************************/
+typedef struct {
+    uint8_t     modo;
+    uint8_t     nivel;
+    bool        externo;        // Lo controla el guion (hostFijarEntrada()) o un periférico simulado
+    void        (*isr)(void);
+    uint32_t    modoISR;
+    bool        pendiente;
+} pinSim_t;
+
+static pinSim_t     pines[NUM_PINES];
+static bool         irqHabilitadas = true;
+static int          nivelISR = 0;
+
+// Botonera grande (matriz)
+static std::vector<byte>    filasTeclado, columnasTeclado;
+static int                  teclaFila = -1, teclaColumna = -1;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Ejecuta las ISR pendientes si las interrupciones están habilitadas y no hay otra en curso.
+ */
+/*-----------------------------------------------------------------------------*/
+static void atenderPendientes()
+{
+    if(!irqHabilitadas or nivelISR) return;
+
+    for(bool hay = true; hay; )
+    {
+        hay = false;
+        for(int p = 0; p < NUM_PINES; p++)
+        {
+            if(pines[p].pendiente and pines[p].isr)
+            {
+                pines[p].pendiente = false;
+                nivelISR++;
+                pines[p].isr();
+                nivelISR--;
+                hostStats.nISR++;
+                hay = true;
+            }
+        }
+    }
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Cambia el nivel de un pin y, si es el flanco de su interrupción, la deja pendiente.
+ */
+/*-----------------------------------------------------------------------------*/
+static void cambiarNivel(byte pin, bool nivel)
+{
+    pinSim_t &p = pines[pin];
+    bool antes = p.nivel;
+    p.nivel = nivel;
+    if((antes == nivel) or !p.isr) return;
+
+    if((p.modoISR == CHANGE) or ((p.modoISR == RISING) and nivel) or ((p.modoISR == FALLING) and !nivel))
+    {
+        p.pendiente = true;
+        atenderPendientes();
+    }
+}
+
+
+void attachInterrupt(uint32_t pin, void (*isr)(void), uint32_t modo)
+{
+    if(pin >= NUM_PINES) return;
+    pines[pin].isr = isr;
+    pines[pin].modoISR = modo;
+    pines[pin].pendiente = false;
+}
+
+void detachInterrupt(uint32_t pin){ if(pin < NUM_PINES) pines[pin].isr = NULL; }
+void noInterrupts(){ irqHabilitadas = false; }
+void interrupts(){ irqHabilitadas = true; atenderPendientes(); }
+
+void hostFijarEntrada(byte pin, bool nivel){ pines[pin].externo = true; cambiarNivel(pin, nivel); }
+
+void hostTeclado(const byte *filas, byte nFilas, const byte *columnas, byte nColumnas)
+{
+    filasTeclado.assign(filas, filas + nFilas);
+    columnasTeclado.assign(columnas, columnas + nColumnas);
+    for(byte r = 0; r < nFilas; r++) pines[filas[r]].externo = true;
+}
+
+void hostPulsarTecla(int fila, int columna){ teclaFila = fila; teclaColumna = columna; }
+
+
+
+
+/*******************************************************************************
+                               BÁSCULA (HX711)
+*******************************************************************************/
+#define HX711_PERIODO_NS    100000000ULL    // 10 SPS
+#define HX711_MAX_CUENTA    0x7FFFFF
+#define HX711_MIN_CUENTA    (-0x800000L)
+
+static struct {
+    bool            activa;
+    byte            dout, sck;
+    long            offset;
+    float           factor;
+    float           ruido;          // Desviación típica (cuentas)
+    float           gramos;
+    unsigned long   valor;          // Conversión que se está sacando por DOUT
+    bool            lista;          // DOUT en bajo hasta el pulso 25
+    int             pulsos;
+} hx;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Nueva conversión del HX711: baja DOUT (DRDY). Si la anterior se está leyendo, se descarta.
+ */
+/*-----------------------------------------------------------------------------*/
+static void conversionHX711()
+{
+    hostProgramar(relojNs + HX711_PERIODO_NS, conversionHX711);
+    if(hx.pulsos > 0) return;
+
+    std::normal_distribution<float> ruido(0.0, hx.ruido);
+    long cuenta = lround(hx.offset + hx.gramos * hx.factor + ruido(generador));
+    hx.valor = (unsigned long)constrain(cuenta, HX711_MIN_CUENTA, (long)HX711_MAX_CUENTA) & 0xFFFFFFUL; // Complemento a 2 de 24 bits
+    hx.lista = true;
+    cambiarNivel(hx.dout, LOW);
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Flanco de subida de SCK: saca el siguiente bit (MSB primero); el pulso 25 sube DOUT
+ *        (canal A, ganancia 128).
+ */
+/*-----------------------------------------------------------------------------*/
+static void pulsoHX711()
+{
+    hostStats.pulsosSCK++;
+    if(!hx.lista) return;
+
+    hx.pulsos++;
+    if(hx.pulsos <= 24) cambiarNivel(hx.dout, (hx.valor >> (24 - hx.pulsos)) & 1);
+    else
+    {
+        cambiarNivel(hx.dout, HIGH);
+        hx.lista = false;
+        hx.pulsos = 0;
+    }
+}
+
+
+void hostBascula(byte dout, byte sck, long offset, float factor, float ruido)
+{
+    hx.activa = true;
+    hx.dout = dout;
+    hx.sck = sck;
+    hx.offset = offset;
+    hx.factor = factor;
+    hx.ruido = ruido;
+    pines[dout].externo = true;
+    pines[dout].nivel = HIGH;
+    hostProgramar(relojNs + HX711_PERIODO_NS, conversionHX711);
+}
+
+void hostFijarPeso(float gramos){ hx.gramos = gramos; }
+float hostPeso(){ return hx.gramos; }
+
+
+
+
+/*******************************************************************************
+                              PANTALLA (RA8876)
+*******************************************************************************/
+#define RA8876_CMD_WRITE    0x00
+#define RA8876_STATUS_READ  0x40
+#define RA8876_DATA_WRITE   0x80
+#define RA8876_DATA_READ    0xC0
+#define RA8876_REG_MRWDP    0x04
+#define RA8876_REG_CVSSA0   0x50    // Dirección del canvas (4 bytes)
+#define RA8876_REG_CVS_IMWTH0 0x54  // Ancho del canvas (2 bytes)
+#define RA8876_REG_AWUL_X0  0x56    // Ventana activa: x, y, ancho, alto (2 bytes cada uno)
+#define RA8876_REG_CURH0    0x5F    // Cursor de lectura/escritura: x, y (2 bytes cada uno)
+#define RA8876_REG_CURV1    0x62
+#define RA8876_ESTADO_LISTO 0x40    // SDRAM lista, FIFO de escritura vacía, núcleo libre, funcionamiento normal
+#define RA8876_SDRAM_BYTES  (16UL << 20)
+
+static struct {
+    bool        activa;
+    byte        cs;
+    bool        primerByte;     // El primer byte tras bajar CS es el tipo de acceso
+    uint8_t     acceso;
+    uint8_t     reg;
+    uint8_t     regs[256];
+
+    std::vector<uint8_t> sdram;
+    uint16_t    cx, cy;         // Cursor de memoria
+    byte        fase;           // Byte del píxel actual (0: bajo, 1: alto)
+    bool        lecturaFalsa;   // La siguiente lectura de memoria es la falsa (dummy read)
+} lcd;
+
+static uint32_t regLcd(uint8_t reg, byte n){ uint32_t v = 0; for(byte i = 0; i < n; i++) v |= (uint32_t)lcd.regs[reg + i] << (8 * i); return v; }
+
+
+void hostPantalla(byte cs)
+{
+    lcd.activa = true;
+    lcd.cs = cs;
+    std::mt19937 basura(5678); // Propio, para no cambiar la secuencia de 'generador'
+    lcd.sdram.resize(RA8876_SDRAM_BYTES);
+    for(uint8_t &b : lcd.sdram) b = basura(); // Recién encendida
+}
+
+
+bool hostCargarSDRAM(const char *fichero)
+{
+    FILE *f = fopen(fichero, "rb");
+    if(!f) return false;
+    bool ok = fread(lcd.sdram.data(), 1, lcd.sdram.size(), f) == lcd.sdram.size();
+    fclose(f);
+    return ok;
+}
+
+
+bool hostGuardarSDRAM(const char *fichero)
+{
+    FILE *f = fopen(fichero, "wb");
+    if(!f) return false;
+    bool ok = fwrite(lcd.sdram.data(), 1, lcd.sdram.size(), f) == lcd.sdram.size();
+    fclose(f);
+    return ok;
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Byte de la SDRAM en el cursor (NULL si se sale de la memoria). Tras el byte alto, el
+ *        cursor pasa al siguiente píxel de la ventana activa y, al final de la fila, a la siguiente.
+ */
+/*-----------------------------------------------------------------------------*/
+static uint8_t *byteMemoriaLcd()
+{
+    uint32_t dir = regLcd(RA8876_REG_CVSSA0, 4) + ((uint32_t)lcd.cy * regLcd(RA8876_REG_CVS_IMWTH0, 2) + lcd.cx) * 2 + lcd.fase;
+    uint8_t *b = (dir < lcd.sdram.size()) ? &lcd.sdram[dir] : NULL;
+
+    if(++lcd.fase == 2)
+    {
+        lcd.fase = 0;
+        if(++lcd.cx >= regLcd(RA8876_REG_AWUL_X0, 2) + regLcd(RA8876_REG_AWUL_X0 + 4, 2))
+        {
+            lcd.cx = regLcd(RA8876_REG_AWUL_X0, 2);
+            lcd.cy++;
+        }
+    }
+    return b;
+}
+
+
+void SPIClass::beginTransaction(SPISettings ajustes)
+{
+    reloj = ajustes.reloj;
+    hostStats.transaccionesSPI++;
+}
+
+
+uint8_t SPIClass::transfer(uint8_t dato)
+{
+    unsigned long long ns = 8000000000ULL / reloj;
+    hostStats.nsSPI += ns;
+    hostStats.bytesSPI++;
+    hostAvanzarNs(ns);
+
+    if(!lcd.activa or pines[lcd.cs].nivel != LOW) return 0;
+
+    if(lcd.primerByte)
+    {
+        lcd.primerByte = false;
+        lcd.acceso = dato;
+        return 0;
+    }
+
+    switch(lcd.acceso)
+    {
+        case RA8876_CMD_WRITE:      lcd.reg = dato;                                                         return 0;
+        case RA8876_DATA_WRITE:     if(lcd.reg == RA8876_REG_MRWDP)
+                                    {
+                                        hostStats.bytesSPIMemoria++;
+                                        hostStats.hashPixeles = (hostStats.hashPixeles ^ dato) * 16777619u;
+                                        uint8_t *b = byteMemoriaLcd();
+                                        if(b) *b = dato;
+                                        return 0;
+                                    }
+                                    lcd.regs[lcd.reg] = dato;
+                                    if((lcd.reg >= RA8876_REG_CURH0) and (lcd.reg <= RA8876_REG_CURV1))
+                                    {
+                                        lcd.cx = regLcd(RA8876_REG_CURH0, 2);
+                                        lcd.cy = regLcd(RA8876_REG_CURH0 + 2, 2);
+                                        lcd.fase = 0;
+                                        lcd.lecturaFalsa = true;
+                                    }
+                                    return 0;
+        case RA8876_DATA_READ:      if(lcd.reg == RA8876_REG_MRWDP)
+                                    {
+                                        if(lcd.lecturaFalsa){ lcd.lecturaFalsa = false; return 0; }
+                                        hostStats.bytesLeidosSDRAM++;
+                                        uint8_t *b = byteMemoriaLcd();
+                                        return b ? *b : 0;
+                                    }
+                                    return lcd.regs[lcd.reg];
+        case RA8876_STATUS_READ:    return RA8876_ESTADO_LISTO;
+        default:                    return 0;
+    }
+}
+
+
+
+
+/*******************************************************************************
+                           PINES: LECTURA Y ESCRITURA
+*******************************************************************************/
+void pinMode(uint32_t pin, uint32_t modo)
+{
+    if(pin >= NUM_PINES) return;
+    pines[pin].modo = modo;
+    if((modo == INPUT_PULLUP) and !pines[pin].externo) pines[pin].nivel = HIGH;
+}
+
+
+void digitalWrite(uint32_t pin, uint32_t nivel)
+{
+    if(pin >= NUM_PINES) return;
+    bool antes = pines[pin].nivel;
+    pines[pin].nivel = nivel ? HIGH : LOW;
+
+    if(hx.activa and (pin == hx.sck) and !antes and nivel) pulsoHX711();
+    if(lcd.activa and (pin == lcd.cs) and antes and !nivel){ lcd.primerByte = true; hostStats.tramasSPI++; }
+}
+
+
+int digitalRead(uint32_t pin)
+{
+    if(pin >= NUM_PINES) return LOW;
+
+    for(size_t r = 0; r < filasTeclado.size(); r++)
+    {
+        if(filasTeclado[r] != pin) continue;
+        if((teclaFila != (int)r) or (teclaColumna < 0)) return LOW;
+        const pinSim_t &columna = pines[columnasTeclado[teclaColumna]];
+        return ((columna.modo == OUTPUT) and columna.nivel) ? HIGH : LOW;
+    }
+    return pines[pin].nivel;
+}
+
+
+int analogRead(uint32_t){ return 0; }
+void analogWrite(uint32_t, uint32_t){}
+
+
+uint8_t shiftIn(uint32_t pinDatos, uint32_t pinReloj, uint32_t orden)
+{
+    uint8_t valor = 0;
+    for(uint8_t i = 0; i < 8; i++)
+    {
+        digitalWrite(pinReloj, HIGH);
+        if(orden == LSBFIRST) valor |= digitalRead(pinDatos) << i;
+        else                  valor |= digitalRead(pinDatos) << (7 - i);
+        digitalWrite(pinReloj, LOW);
+    }
+    return valor;
+}
+
+
+void shiftOut(uint32_t pinDatos, uint32_t pinReloj, uint32_t orden, uint8_t valor)
+{
+    for(uint8_t i = 0; i < 8; i++)
+    {
+        digitalWrite(pinDatos, (orden == LSBFIRST) ? ((valor >> i) & 1) : ((valor >> (7 - i)) & 1));
+        digitalWrite(pinReloj, HIGH);
+        digitalWrite(pinReloj, LOW);
+    }
+}
+
+
+
+
+/*******************************************************************************
+                                    TIEMPO
+*******************************************************************************/
+unsigned long millis(){ hostAvanzarNs(HOST_NS_LLAMADA_RELOJ); return (unsigned long)(relojNs / 1000000ULL); }
+unsigned long micros(){ hostAvanzarNs(HOST_NS_LLAMADA_RELOJ); return (unsigned long)(relojNs / 1000ULL); }
+void delay(unsigned long ms){ hostAvanzarNs(ms ? ms * 1000000ULL : HOST_NS_LLAMADA_RELOJ); }
+void delayMicroseconds(unsigned int us){ hostAvanzarNs(us * 1000ULL); }
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief WFI: se llama con las interrupciones deshabilitadas. Si no hay ninguna pendiente, salta
+ *        al siguiente evento programado o al siguiente tick del SysTick, lo que llegue antes.
+ */
+/*-----------------------------------------------------------------------------*/
+void hostDormir()
+{
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+    bool hayPendiente = false;
+    for(int p = 0; p < NUM_PINES; p++) if(pines[p].pendiente) hayPendiente = true;
+
+    if(!hayPendiente)
+    {
+        unsigned long long destino = (relojNs / HOST_NS_SYSTICK + 1) * HOST_NS_SYSTICK;
+        if(!eventos.empty() and (eventos.top().ns < destino)) destino = std::max(eventos.top().ns, relojNs);
+        hostStats.nsDormido += destino - relojNs;
+        ejecutarHasta(destino);
+    }
+    hostStats.nDespertares++;
+
+    hostStats.nsHostDormido += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+
+long random(long hasta){ return (hasta > 0) ? (long)(generador() % hasta) : 0; }
+long random(long desde, long hasta){ return (hasta > desde) ? desde + random(hasta - desde) : desde; }
+void randomSeed(unsigned long semilla){ generador.seed(semilla); }
+
+
+
+
+/*******************************************************************************
+                                   STRING
+*******************************************************************************/
+void hostReservaString(){ hostStats.reservasString++; }
+
+std::string String::numero(long long v, int base)
+{
+    char t[72];
+    if(base == DEC){ snprintf(t, sizeof(t), "%lld", v); return t; }
+
+    unsigned long long u = (v < 0) ? ((unsigned long long)v & 0xFFFFFFFFULL) : (unsigned long long)v; // Como en el Due (32 bits)
+    if(base == HEX) snprintf(t, sizeof(t), "%llX", u);
+    else if(base == OCT) snprintf(t, sizeof(t), "%llo", u);
+    else
+    {
+        int n = 0;
+        char inv[72];
+        do { inv[n++] = '0' + (u % base); u /= base; } while(u and (n < 64));
+        for(int i = 0; i < n; i++) t[i] = inv[n - 1 - i];
+        t[n] = '\0';
+    }
+    return t;
+}
+
+std::string String::decimal(double v, int decimales)
+{
+    if(isnan(v)) return "nan";
+    if(isinf(v)) return "inf";
+    char t[72];
+    snprintf(t, sizeof(t), "%.*f", decimales, v);
+    return t;
+}
+
+bool String::equalsIgnoreCase(const String &s) const
+{
+    if(size() != s.size()) return false;
+    for(size_t i = 0; i < size(); i++) if(tolower((unsigned char)(*this)[i]) != tolower((unsigned char)s[i])) return false;
+    return true;
+}
+
+void String::replace(const String &a, const String &b)
+{
+    if(a.empty()) return;
+    size_t p = 0;
+    if(b.size() > a.size())
+    {
+        // El Due cuenta las apariciones y reserva una vez lo que va a ocupar
+        size_t n = 0;
+        for(size_t q = find(a); q != npos; q = find(a, q + a.size())) n++;
+        if(n) reservar(size() + n * (b.size() - a.size()));
+    }
+    while((p = find(a, p)) != npos){ std::string::replace(p, a.size(), b); p += b.size(); }
+}
+
+void String::trim()
+{
+    size_t fin = size();
+    while(fin and isspace((unsigned char)(*this)[fin - 1])) fin--;
+    size_t ini = 0;
+    while((ini < fin) and isspace((unsigned char)(*this)[ini])) ini++;
+    assign(substr(ini, fin - ini));
+}
+
+
+
+
+/*******************************************************************************
+                                   STREAM
+*******************************************************************************/
+int Stream::timedRead()
+{
+    unsigned long inicio = millis();
+    do {
+        int c = read();
+        if(c >= 0) return c;
+        delay(1);
+    } while(millis() - inicio < timeout);
+    return -1;
+}
+
+String Stream::readStringUntil(char fin)
+{
+    String s;
+    int c = timedRead();
+    while((c >= 0) and (c != fin)){ s += (char)c; c = timedRead(); }
+    return s;
+}
+
+size_t Stream::readBytesUntil(char fin, char *buf, size_t n)
+{
+    size_t i = 0;
+    while(i < n)
+    {
+        int c = timedRead();
+        if((c < 0) or (c == fin)) break;
+        buf[i++] = (char)c;
+    }
+    return i;
+}
+
+size_t Stream::readBytes(char *buf, size_t n)
+{
+    size_t i = 0;
+    while(i < n)
+    {
+        int c = timedRead();
+        if(c < 0) break;
+        buf[i++] = (char)c;
+    }
+    return i;
+}
+
+
+
+
+/*******************************************************************************
+                        SERIAL CON EL PC Y ESP32 (Serial1)
+*******************************************************************************/
+#define ESP32_NS_BYTE   87000ULL    // 115200 baudios
+
+static bool             mostrarSerialPC = false;
+static std::string      entradaSerialPC;            // Lo que ha escrito el PC y aún no ha leído el sketch
+static std::string      *capturaSerial = NULL;
+
+static struct {
+    bool                                                    wifi = true;
+    unsigned long                                           latenciaMs = 20;
+    unsigned long                                           subidaMs = 800;
+    std::string                                             linea;
+    std::deque<std::pair<unsigned long long, char> >        rx;         // Bytes hacia el Due y cuándo llegan
+    std::string                                             barcode;
+    unsigned long                                           lecturaMs = 3000;
+    std::map<std::string, std::string>                      productos;
+} esp;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Encola una respuesta del ESP32 que empieza a llegar pasados 'ms' milisegundos.
+ */
+/*-----------------------------------------------------------------------------*/
+static void responderESP32(const std::string &msg, unsigned long ms)
+{
+    unsigned long long t = relojNs + ms * 1000000ULL;
+    if(!esp.rx.empty() and (esp.rx.back().first > t)) t = esp.rx.back().first;
+
+    std::string trama = msg + "\r\n";
+    for(size_t i = 0; i < trama.size(); i++)
+    {
+        t += ESP32_NS_BYTE;
+        esp.rx.push_back(std::make_pair(t, trama[i]));
+    }
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Atiende una línea recibida del Due (protocolo de Serial_functions.h).
+ */
+/*-----------------------------------------------------------------------------*/
+static void lineaESP32(std::string l)
+{
+    while(!l.empty() and isspace((unsigned char)l[l.size() - 1])) l.erase(l.size() - 1);
+    if(l.empty()) return;
+    hostStats.lineasESP32++;
+
+    if(l == "CHECK-WIFI") responderESP32(esp.wifi ? "WIFI-OK" : "NO-WIFI", esp.latenciaMs);
+    else if(l == "SAVE") responderESP32(esp.wifi ? "WAITING-FOR-DATA" : "NO-WIFI", esp.latenciaMs + (esp.wifi ? esp.subidaMs : 0));
+    else if(l.compare(0, 10, "FIN-COMIDA") == 0)
+    {
+        if(esp.wifi) hostStats.comidasSubidas++;
+        responderESP32(esp.wifi ? "SAVED-OK" : "NO-WIFI", esp.latenciaMs + esp.subidaMs);
+    }
+    else if(l == "GET-BARCODE")
+    {
+        responderESP32(esp.barcode.empty() ? "NO-BARCODE" : ("BARCODE:" + esp.barcode), esp.lecturaMs);
+        esp.barcode.clear();
+    }
+    else if(l == "CANCEL-BARCODE")
+    {
+        while(!esp.rx.empty() and (esp.rx.back().first > relojNs)) esp.rx.pop_back(); // La lectura en curso no llega a enviarse
+    }
+    else if(l.compare(0, 12, "GET-PRODUCT:") == 0)
+    {
+        std::string bc = l.substr(12);
+        std::map<std::string, std::string>::iterator it = esp.productos.find(bc);
+        if(!esp.wifi) responderESP32("NO-WIFI", esp.latenciaMs);
+        else if(it == esp.productos.end()) responderESP32("NO-PRODUCT", esp.latenciaMs + esp.subidaMs);
+        else responderESP32("PRODUCT:" + bc + ";" + it->second, esp.latenciaMs + esp.subidaMs);
+    }
+    // El resto son líneas de la comida (INICIO-COMIDA, INICIO-PLATO, ALIMENTO...), que solo se acumulan
+}
+
+
+size_t HardwareSerial::write(uint8_t b)
+{
+    if(puerto == 0)
+    {
+        if(capturaSerial) capturaSerial->push_back((char)b);
+        else if(mostrarSerialPC) fputc(b, stdout);
+    }
+    else if(puerto == 1)
+    {
+        if(b == '\n'){ lineaESP32(esp.linea); esp.linea.clear(); }
+        else if(b != '\r') esp.linea.push_back((char)b);
+    }
+    return 1;
+}
+
+int HardwareSerial::available()
+{
+    if(puerto == 0) return (int)entradaSerialPC.size();
+    if(puerto != 1) return 0;
+    int n = 0;
+    for(size_t i = 0; (i < esp.rx.size()) and (esp.rx[i].first <= relojNs); i++) n++;
+    return n;
+}
+
+int HardwareSerial::read()
+{
+    if((puerto == 0) and !entradaSerialPC.empty()){ char c = entradaSerialPC[0]; entradaSerialPC.erase(0, 1); return (unsigned char)c; }
+    if((puerto != 1) or esp.rx.empty() or (esp.rx.front().first > relojNs)) return -1;
+    char c = esp.rx.front().second;
+    esp.rx.pop_front();
+    return (unsigned char)c;
+}
+
+int HardwareSerial::peek()
+{
+    if((puerto == 0) and !entradaSerialPC.empty()) return (unsigned char)entradaSerialPC[0];
+    if((puerto != 1) or esp.rx.empty() or (esp.rx.front().first > relojNs)) return -1;
+    return (unsigned char)esp.rx.front().second;
+}
+
+
+void hostSerialPC(bool mostrar){ mostrarSerialPC = mostrar; }
+void hostEnviarSerialPC(const std::string &texto){ entradaSerialPC += texto; }
+void hostCapturarSerial(std::string *destino){ capturaSerial = destino; }
+
+void hostESP32(bool wifi, unsigned long latenciaMs, unsigned long subidaMs)
+{
+    esp.wifi = wifi;
+    esp.latenciaMs = latenciaMs;
+    esp.subidaMs = subidaMs;
+}
+
+void hostESP32Barcode(const std::string &barcode, unsigned long lecturaMs){ esp.barcode = barcode; esp.lecturaMs = lecturaMs; }
+void hostESP32Producto(const std::string &barcode, const std::string &info){ esp.productos[barcode] = info; }
+
+
+
+
+/*******************************************************************************
+                                 TARJETA SD
+*******************************************************************************/
+struct ficheroSD_t {
+    std::vector<uint8_t>    datos;
+};
+
+static std::map<std::string, std::shared_ptr<ficheroSD_t> >    ficherosSD;
+static std::set<std::string>                                    borradosSD;     // No volver a cargarlos de la carpeta montada
+static std::string                                              carpetaSD;
+static bool                                                     falloSD = false;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Ruta normalizada (FAT no distingue mayúsculas): sin '/' inicial y en minúsculas.
+ */
+/*-----------------------------------------------------------------------------*/
+static std::string normalizarRuta(const char *ruta)
+{
+    std::string r(ruta ? ruta : "");
+    while(!r.empty() and (r[0] == '/')) r.erase(0, 1);
+    for(size_t i = 0; i < r.size(); i++) r[i] = tolower((unsigned char)r[i]);
+    return r;
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Busca un fichero en memoria o, si no está, lo carga de la carpeta montada.
+ */
+/*-----------------------------------------------------------------------------*/
+static std::shared_ptr<ficheroSD_t> buscarFichero(const char *ruta)
+{
+    std::string clave = normalizarRuta(ruta);
+    std::map<std::string, std::shared_ptr<ficheroSD_t> >::iterator it = ficherosSD.find(clave);
+    if(it != ficherosSD.end()) return it->second;
+    if(carpetaSD.empty() or borradosSD.count(clave)) return std::shared_ptr<ficheroSD_t>();
+
+    std::string rutaPC = carpetaSD + "/" + std::string(ruta + (ruta[0] == '/'));
+    FILE *f = fopen(rutaPC.c_str(), "rb");
+    if(!f) return std::shared_ptr<ficheroSD_t>();
+
+    std::shared_ptr<ficheroSD_t> fichero(new ficheroSD_t);
+    uint8_t buf[4096];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0) fichero->datos.insert(fichero->datos.end(), buf, buf + n);
+    fclose(f);
+
+    ficherosSD[clave] = fichero;
+    return fichero;
+}
+
+
+bool SDClass::begin(uint8_t){ return !falloSD; }
+
+File SDClass::open(const char *ruta, uint8_t modo)
+{
+    hostStats.aperturasSD++;
+    hostAvanzarNs(HOST_NS_APERTURA_SD);
+    if(falloSD) return File();
+
+    std::shared_ptr<ficheroSD_t> f = buscarFichero(ruta);
+    if(!f)
+    {
+        if(!(modo & O_CREAT)) return File();
+        f.reset(new ficheroSD_t);
+        ficherosSD[normalizarRuta(ruta)] = f;
+        borradosSD.erase(normalizarRuta(ruta));
+    }
+    if((modo & O_TRUNC) and (modo & O_WRITE)) f->datos.clear();
+
+    return File(f, ruta, modo, (modo & O_APPEND) ? (uint32_t)f->datos.size() : 0);
+}
+
+bool SDClass::exists(const char *ruta){ return !falloSD and (bool)buscarFichero(ruta); }
+
+bool SDClass::remove(const char *ruta)
+{
+    std::string clave = normalizarRuta(ruta);
+    bool existia = (bool)buscarFichero(ruta);
+    ficherosSD.erase(clave);
+    borradosSD.insert(clave);
+    return existia;
+}
+
+
+uint32_t File::size() const { return f ? (uint32_t)f->datos.size() : 0; }
+bool File::seek(uint32_t p){ if(!f or (p > f->datos.size())) return false; pos = p; return true; }
+int File::available(){ return (f and (pos < f->datos.size())) ? (int)(f->datos.size() - pos) : 0; }
+
+int File::peek(){ return (f and (pos < f->datos.size())) ? f->datos[pos] : -1; }
+
+int File::read()
+{
+    if(!f or (pos >= f->datos.size())) return -1;
+    hostStats.bytesSD++;
+    hostAvanzarNs(HOST_NS_BYTE_SD);
+    return f->datos[pos++];
+}
+
+int File::read(void *buf, size_t n)
+{
+    if(!f) return -1;
+    size_t quedan = f->datos.size() - pos;
+    if(n > quedan) n = quedan;
+    memcpy(buf, &f->datos[pos], n);
+    pos += n;
+    hostStats.bytesSD += n;
+    hostAvanzarNs(n * HOST_NS_BYTE_SD);
+    return (int)n;
+}
+
+size_t File::write(const uint8_t *buf, size_t n)
+{
+    if(!f or !(modo & O_WRITE)) return 0;
+    if(modo & O_APPEND) pos = f->datos.size();
+    if(pos + n > f->datos.size()) f->datos.resize(pos + n);
+    memcpy(&f->datos[pos], buf, n);
+    pos += n;
+    hostStats.bytesSD += n;
+    hostAvanzarNs(n * HOST_NS_BYTE_SD);
+    return n;
+}
+
+
+void hostMontarSD(const char *carpeta){ carpetaSD = carpeta ? carpeta : ""; }
+void hostFalloSD(bool fallo){ falloSD = fallo; }
+
+bool hostLeerFicheroSD(const char *ruta, std::string &contenido)
+{
+    std::shared_ptr<ficheroSD_t> f = buscarFichero(ruta);
+    if(!f) return false;
+    contenido.assign(f->datos.begin(), f->datos.end());
+    return true;
+}
+
+
+
+
+/*******************************************************************************
+                                  RTC (DS3231)
+*******************************************************************************/
+static time_t   inicioRTC = 1792310400;    // 18/10/2026 08:00:00
+static long     ajusteRTC = 0;              // Segundos añadidos con setTime()/setDate()
+
+static time_t ahoraRTC(){ return inicioRTC + (time_t)(relojNs / 1000000000ULL) + ajusteRTC; }
+
+void hostFechaInicio(int anio, int mes, int dia, int hora, int min, int seg)
+{
+    struct tm t = {};
+    t.tm_year = anio - 1900; t.tm_mon = mes - 1; t.tm_mday = dia;
+    t.tm_hour = hora; t.tm_min = min; t.tm_sec = seg;
+    inicioRTC = timegm(&t);
+    ajusteRTC = 0;
+}
+
+Time DS3231::getTime()
+{
+    time_t ahora = ahoraRTC();
+    struct tm t;
+    gmtime_r(&ahora, &t);
+
+    Time r;
+    r.hour = t.tm_hour; r.min = t.tm_min; r.sec = t.tm_sec;
+    r.date = t.tm_mday; r.mon = t.tm_mon + 1; r.year = t.tm_year + 1900;
+    r.dow = (t.tm_wday == 0) ? 7 : t.tm_wday; // 1 = lunes ... 7 = domingo
+    return r;
+}
+
+char* DS3231::getDateStr(uint8_t formato, uint8_t orden, char separador)
+{
+    Time t = getTime();
+    int anio = (formato == FORMAT_SHORT) ? (t.year % 100) : t.year;
+    int ancho = (formato == FORMAT_SHORT) ? 2 : 4;
+    if(orden == FORMAT_BIGENDIAN)           snprintf(bufFecha, sizeof(bufFecha), "%0*d%c%02d%c%02d", ancho, anio, separador, t.mon, separador, t.date);
+    else if(orden == FORMAT_MIDDLEENDIAN)   snprintf(bufFecha, sizeof(bufFecha), "%02d%c%02d%c%0*d", t.mon, separador, t.date, separador, ancho, anio);
+    else                                    snprintf(bufFecha, sizeof(bufFecha), "%02d%c%02d%c%0*d", t.date, separador, t.mon, separador, ancho, anio);
+    return bufFecha;
+}
+
+char* DS3231::getTimeStr(uint8_t formato)
+{
+    Time t = getTime();
+    if(formato == FORMAT_SHORT) snprintf(bufHora, sizeof(bufHora), "%02d:%02d", t.hour, t.min);
+    else                        snprintf(bufHora, sizeof(bufHora), "%02d:%02d:%02d", t.hour, t.min, t.sec);
+    return bufHora;
+}
+
+void DS3231::setTime(uint8_t hora, uint8_t min, uint8_t seg)
+{
+    Time t = getTime();
+    ajusteRTC += ((long)hora - t.hour) * 3600 + ((long)min - t.min) * 60 + ((long)seg - t.sec);
+}
+
+void DS3231::setDate(uint8_t dia, uint8_t mes, uint16_t anio)
+{
+    time_t ahora = ahoraRTC();
+    struct tm t;
+    gmtime_r(&ahora, &t);
+    t.tm_mday = dia; t.tm_mon = mes - 1; t.tm_year = anio - 1900;
+    ajusteRTC += (long)(timegm(&t) - ahora);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file Host.h
+ * @brief Control del simulador en PC: reloj virtual, eventos programados y modelos de los periféricos
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * RELOJ VIRTUAL
+ *      El tiempo del Due se cuenta en ns y solo avanza cuando el sketch "gasta" tiempo: delay(),
+ *      delayMicroseconds(), cada byte por SPI o de la SD, y un pequeño coste fijo por cada llamada
+ *      a millis()/micros() (para que terminen las esperas activas). El tiempo de CPU del propio
+ *      sketch no se cuenta: se mide aparte, con el reloj del PC, en host_sim.cpp.
+ *
+ *      hostDormir() (el WFI de HAL.h) salta directamente al siguiente evento programado o al
+ *      siguiente tick de 1 ms del SysTick, que también despierta al núcleo en el Due.
+ *
+ * INTERRUPCIONES
+ *      Un cambio de nivel en un pin con attachInterrupt() deja la interrupción pendiente y su ISR
+ *      se ejecuta en cuanto las interrupciones están habilitadas y no hay otra ISR en curso, como
+ *      en el NVIC (varios flancos mientras tanto cuentan como uno).
+ *
+ * PERIFÉRICOS
+ *      - Botoneras: pines de entrada que el guion sube y baja; la botonera grande es una matriz
+ *        que se lee con readButtonsGrande() mientras la tecla sigue pulsada.
+ *      - HX711: una conversión cada 100 ms (10 SPS) con el peso del guion; baja DOUT y saca los
+ *        bits con los flancos de SCK, tanto para la librería HX711 como para la ISR de DRDY.
+ *      - RA8876: protocolo SPI (comando, dato, lectura y estado), banco de registros y estado
+ *        siempre listo (SDRAM inicializada, FIFO vacía). Se cuentan los bytes de cada tipo, las
+ *        tramas (cada vez que baja el CS) y las transacciones SPI.
+ *        La SDRAM guarda lo que se escribe y se lee por MRWDP (canvas, ventana activa y cursor;
+ *        la primera lectura tras colocar el cursor es falsa, como en el chip), pero no lo que
+ *        dibujan el motor gráfico ni el BTE. Empieza con datos aleatorios (pantalla recién
+ *        encendida) o con los de un reinicio anterior (hostCargarSDRAM()).
+ *      - SD: ficheros en memoria (SD.h).
+ *      - ESP32 en Serial1: responde al protocolo de Serial_functions.h con una latencia configurable.
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+#include "Arduino.h"
+#include <functional>
+#include <map>
+
+
+// ------ COSTES DEL RELOJ VIRTUAL ---------------------------------------------------
+#define HOST_NS_LLAMADA_RELOJ   1000ULL     // Coste de cada millis()/micros()
+#define HOST_NS_BYTE_SD         500ULL      // ~2 MB/s, lectura/escritura secuencial de la SD por SPI
+#define HOST_NS_APERTURA_SD     1000000ULL  // Buscar un fichero en la FAT
+#define HOST_NS_SYSTICK         1000000ULL  // El SysTick del core despierta al núcleo cada 1 ms
+// -----------------------------------------------------------------------------
+
+
+// ------ ESTADÍSTICAS ----------------------------------------------------------------
+typedef struct {
+    unsigned long long  nsDormido;          // Tiempo virtual en WFI
+    unsigned long long  nsHostDormido;      // Tiempo real del PC simulando los WFI (no es tiempo del sketch)
+    unsigned long long  nDespertares;
+    unsigned long long  nISR;               // ISR de pines ejecutadas
+    unsigned long long  pulsosSCK;          // Flancos de subida de SCK del HX711 (25 por muestra con ganancia 128)
+    unsigned long long  bytesSPI;           // Bytes enviados a la RA8876
+    unsigned long long  tramasSPI;          // Tramas a la RA8876 (flancos de bajada de su CS)
+    unsigned long long  transaccionesSPI;   // SPI.beginTransaction()
+    unsigned long long  bytesSPIMemoria;    // ... de ellos, píxeles escritos en la SDRAM (MRWDP)
+    uint32_t            hashPixeles;        // FNV-1a de esos píxeles: igual si dos versiones dibujan lo mismo
+    unsigned long long  bytesLeidosSDRAM;   // Bytes leídos de la SDRAM (MRWDP)
+    unsigned long long  nsSPI;              // Tiempo virtual del bus SPI
+    unsigned long long  bytesSD;            // Bytes leídos o escritos en la SD
+    unsigned long long  aperturasSD;
+    unsigned long long  lineasESP32;        // Líneas enviadas al ESP32
+    unsigned long long  comidasSubidas;     // "SAVED-OK" respondidos por el ESP32
+    unsigned long long  reservasString;     // Reservas de heap que habría hecho el String del Due
+} hostStats_t;
+
+extern hostStats_t hostStats;
+// -----------------------------------------------------------------------------
+
+
+
+
+/*******************************************************************************
+                          DECLARACIÓN FUNCIONES
+*******************************************************************************/
+// RELOJ VIRTUAL Y EVENTOS
+unsigned long long  hostAhoraNs();                                                  // Tiempo virtual (ns)
+void                hostAvanzarNs(unsigned long long ns);                           // Avanzar el reloj ejecutando los eventos que venzan
+void                hostProgramar(unsigned long long ns, std::function<void()> accion); // Ejecutar 'accion' en el instante virtual 'ns'
+bool                hostHayEventos();                                               // Quedan eventos programados
+void                hostDormir();                                                   // WFI (HAL.h)
+
+// PINES DE ENTRADA Y BOTONERAS
+void                hostFijarEntrada(byte pin, bool nivel);                         // Nivel de un pin de entrada (dispara su ISR)
+void                hostTeclado(const byte *filas, byte nFilas, const byte *columnas, byte nColumnas);
+void                hostPulsarTecla(int fila, int columna);                         // Tecla de la matriz pulsada (-1 --> ninguna)
+
+// BÁSCULA (HX711)
+void                hostBascula(byte dout, byte sck, long offset, float factor, float ruido);
+void                hostFijarPeso(float gramos);
+float               hostPeso();
+
+// PANTALLA (RA8876)
+void                hostPantalla(byte cs);
+bool                hostCargarSDRAM(const char *fichero);                           // SDRAM de la pantalla que sigue encendida tras reiniciar la Due
+bool                hostGuardarSDRAM(const char *fichero);
+
+// SD
+void                hostMontarSD(const char *carpeta);                              // Carpeta del PC de la que cargar los ficheros que falten
+void                hostFalloSD(bool fallo);                                        // SD.begin() falla (STATE_CRITIC_FAILURE_SD)
+bool                hostLeerFicheroSD(const char *ruta, std::string &contenido);
+
+// ESP32
+void                hostESP32(bool wifi, unsigned long latenciaMs, unsigned long subidaMs);
+void                hostESP32Barcode(const std::string &barcode, unsigned long lecturaMs);  // Código que leerá la cámara en el próximo GET-BARCODE
+void                hostESP32Producto(const std::string &barcode, const std::string &info);  // "<nombre>;<carb>;<lip>;<prot>;<kcal>" (por gramo)
+
+// SERIAL CON EL PC Y RTC
+void                hostSerialPC(bool mostrar);                                     // Mostrar la salida de Serial por stdout
+void                hostEnviarSerialPC(const std::string &texto);                   // Escribir desde el PC en Serial
+void                hostCapturarSerial(std::string *destino);                       // Redirigir Serial a 'destino' (NULL --> dejar de capturar)
+void                hostFechaInicio(int anio, int mes, int dia, int hora, int min, int seg);
+
+
+#endif
@@ -0,0 +1,37 @@
+/**
+ * @file SAMDUETimerInterrupt.h
+ * @brief Temporizadores del Due para el simulador en PC. El sketch ya no los usa (la báscula va
+ *        por DRDY y el loop por Scheduler.h), así que no disparan nunca.
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ */
+
+#ifndef HOST_SAMDUETIMERINTERRUPT_H
+#define HOST_SAMDUETIMERINTERRUPT_H
+
+#include "Arduino.h"
+
+typedef void (*timerCallback)(void);
+
+
+class DueTimerInterrupt
+{
+public:
+    bool        attachInterruptInterval(double, timerCallback){ return true; }
+    uint16_t    getTimerNumber(){ return 0; }
+    void        stopTimer(){}
+};
+
+
+class DueTimerClass
+{
+public:
+    DueTimerInterrupt getAvailable(){ return DueTimerInterrupt(); }
+};
+
+extern DueTimerClass DueTimer;
+
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * @file SAMDUE_ISR_Timer.h
+ * @brief Temporizadores por software del Due para el simulador en PC (sin uso en el sketch)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ */
+
+#ifndef HOST_SAMDUE_ISR_TIMER_H
+#define HOST_SAMDUE_ISR_TIMER_H
+
+#include "Arduino.h"
+
+
+class SAMDUE_ISR_Timer
+{
+public:
+    void    init(){}
+    void    run(){}
+    int     setInterval(unsigned long, void (*)()){ return 0; }
+    int     setTimeout(unsigned long, void (*)()){ return 0; }
+    void    restartTimer(int){}
+    void    enable(int){}
+    void    disable(int){}
+};
+
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file SD.h
+ * @brief Tarjeta SD para el simulador en PC: ficheros en memoria
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Los ficheros viven en memoria y se pierden al salir. Si se monta una carpeta del PC con
+ * hostMontarSD() (Host.h), los ficheros que no estén en memoria se cargan de ella la primera
+ * vez que se abren (las imágenes de 'images/'); la carpeta nunca se modifica.
+ *
+ * Los modos son los de SdFat: FILE_WRITE añade al final (O_APPEND) y sin O_APPEND se puede
+ * escribir en cualquier posición tras seek(), como hace Scale_Trace.h.
+ */
+
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include "Arduino.h"
+#include <memory>
+
+#define O_READ      0x01
+#define O_WRITE     0x02
+#define O_RDWR      (O_READ | O_WRITE)
+#define O_APPEND    0x04
+#define O_SYNC      0x08
+#define O_CREAT     0x10
+#define O_EXCL      0x20
+#define O_TRUNC     0x40
+
+#define FILE_READ   O_READ
+#define FILE_WRITE  (O_READ | O_WRITE | O_CREAT | O_APPEND)
+
+
+struct ficheroSD_t; // Contenido de un fichero (Host.cpp)
+
+
+class File : public Stream
+{
+public:
+    File(){}
+    File(std::shared_ptr<ficheroSD_t> f, const std::string &ruta, uint8_t modo, uint32_t pos) : f(f), ruta(ruta), modo(modo), pos(pos){}
+
+    operator    bool() const { return (bool)f; }
+    const char* name() const { return ruta.c_str(); }
+    void        close(){ f.reset(); }
+    void        flush(){}
+
+    uint32_t    size() const;
+    uint32_t    position() const { return pos; }
+    bool        seek(uint32_t p);
+
+    int         available();
+    int         read();
+    int         read(void *buf, size_t n);
+    int         peek();
+    size_t      write(uint8_t b){ return write(&b, 1); }
+    size_t      write(const uint8_t *buf, size_t n);
+    using Print::write;
+
+private:
+    std::shared_ptr<ficheroSD_t>    f;
+    std::string                     ruta;
+    uint8_t                         modo = 0;
+    uint32_t                        pos = 0;
+};
+
+
+class SDClass
+{
+public:
+    bool    begin(uint8_t pinCS);
+    File    open(const char *ruta, uint8_t modo = FILE_READ);
+    File    open(const String &ruta, uint8_t modo = FILE_READ){ return open(ruta.c_str(), modo); }
+    bool    exists(const char *ruta);
+    bool    exists(const String &ruta){ return exists(ruta.c_str()); }
+    bool    remove(const char *ruta);
+    bool    remove(const String &ruta){ return remove(ruta.c_str()); }
+    bool    mkdir(const char *){ return true; }
+};
+
+extern SDClass SD;
+
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file SPI.h
+ * @brief Bus SPI para el simulador en PC: los bytes van a la pantalla RA8876 simulada (Host.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Cada byte avanza el reloj virtual lo que tardaría en el bus con el reloj de la última
+ * beginTransaction() (3 MHz para texto y 50 MHz para imágenes en RA8876_v2.cpp).
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0   0x02
+#define SPI_MODE1   0x00
+#define SPI_MODE2   0x03
+#define SPI_MODE3   0x01
+
+
+class SPISettings
+{
+public:
+    SPISettings() : reloj(4000000){}
+    SPISettings(uint32_t reloj, uint8_t, uint8_t) : reloj(reloj){}
+    uint32_t    reloj;  // Hz
+};
+
+
+class SPIClass
+{
+public:
+    void        begin(){}
+    void        end(){}
+    void        beginTransaction(SPISettings ajustes);
+    void        endTransaction(){}
+    uint8_t     transfer(uint8_t dato);
+    uint16_t    transfer16(uint16_t dato){ uint8_t a = transfer(dato >> 8); return (a << 8) | transfer(dato & 0xFF); }
+    void        transfer(void *buf, size_t n){ uint8_t *b = (uint8_t*)buf; for(size_t i = 0; i < n; i++) b[i] = transfer(b[i]); }
+
+private:
+    uint32_t    reloj = 4000000;
+};
+
+extern SPIClass SPI;
+
+
+#endif
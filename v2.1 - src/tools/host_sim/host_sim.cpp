@@ -0,0 +1,435 @@
+/**
+ * @file host_sim.cpp
+ * @brief Simulador en PC del firmware completo de SmartCloth: ejecuta sesiones de comida con guion
+ *        más rápido que en tiempo real y mide lo que tarda en atenderse cada evento
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta:
+ *
+ *      g++ -std=gnu++11 -O2 -DHOST_SIM -DARDUINO=10819 -Ihal -I"../../smartcloth_v2" -I"../../../libs/HX711/src" \
+ *          -o host_sim host_sim.cpp hal/Host.cpp "../../smartcloth_v2/RA8876_v2.cpp" "../../../libs/HX711/src/HX711.cpp"
+ *
+ * o todas las herramientas a la vez, con -Wall -Wextra y sus pruebas, desde tools/:
+ *
+ *      cmake -S . -B build && cmake --build build -j && ctest --test-dir build --output-on-failure
+ *
+ * Uso:
+ *
+ *      host_sim [-v] [-g guion.txt] [-s carpeta_SD] [-w] [-x fichero_SD fichero_PC] [-r sdram.bin]
+ *
+ *      -v  Mostrar la salida de SerialPC del sketch
+ *      -g  Guion de la sesión (por defecto, una comida de ejemplo con dos platos y un barcode)
+ *      -s  Carpeta del PC con el contenido de la SD (por defecto la carpeta 'images' del repositorio)
+ *      -w  Empezar sin WiFi en el ESP32
+ *      -x  Copiar al PC un fichero de la SD al terminar (p. ej. data/vuelo.rec para tools/flight_recorder)
+ *      -r  SDRAM de la pantalla: se carga de 'sdram.bin' si existe (la Due se reinicia con la pantalla
+ *          encendida) y se guarda ahí al terminar. Sin -r, o la primera vez, la pantalla arranca en frío
+ *
+ * Se compila el sketch tal cual (setup() y loop() de smartcloth_v2.ino) contra la implementación
+ * para PC de Arduino y de las librerías que hay en 'hal/' (ver hal/Host.h): reloj virtual, SD en
+ * memoria, báscula HX711, pantalla RA8876 y ESP32 simulados. HOST_SIM selecciona la versión para
+ * PC de HAL.h.
+ *
+ * GUION: una orden por línea ('#' para comentarios). Las acciones ocurren en el instante del guion,
+ * que empieza al terminar setup() y solo avanza con 'espera':
+ *
+ *      espera <ms>                     Avanzar el instante del guion
+ *      peso <gramos> [rampa_ms]        Peso total sobre la báscula (con una rampa lineal opcional)
+ *      grupo <1..20>                   Pulsar un grupo de la botonera grande
+ *      crudo | cocinado | anadir | borrar | guardar    Pulsar un botón de la botonera main
+ *      barcode                         Pulsar el botón de barcode
+ *      wifi si|no                      Conexión del ESP32
+ *      leer <barcode>                  Código que leerá la cámara en el próximo GET-BARCODE
+ *      producto <barcode> <nombre;carb;lip;prot;kcal>  Producto en la base de datos (valores por gramo)
+ *      pc <texto>                      Escribir desde el PC en SerialPC (p. ej. 'pc V' para volcar el registro de vuelo)
+ *
+ * Para cada pulsación o cambio de peso se muestra, hasta la siguiente acción del guion:
+ *      - Los estados por los que pasa la Máquina de Estados.
+ *      - La latencia virtual hasta la primera transición (lo que vería el usuario en el Due).
+ *      - El tiempo virtual ocupado (sin dormir): SPI, SD, delay() y esperas al ESP32.
+ *      - El tiempo de CPU del PC ejecutando loop(), sin contar la simulación de los WFI.
+ *      - Los bytes enviados a la pantalla y leídos o escritos en la SD.
+ *      - Las reservas de heap que habrían hecho los String del sketch en el Due ('heap').
+ */
+
+#include "Arduino.h"
+#include "Host.h"
+#include "smartcloth_v2.ino"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+
+#define PULSACION_MS        150     // Tiempo que se mantiene pulsado cada botón
+#define COLA_SESION_MS      5000    // Tiempo simulado tras la última acción del guion
+#define HX711_OFFSET        400000  // Cuentas con la báscula vacía (positivas, ver hal/Arduino.h)
+#define HX711_RUIDO         15.0    // Desviación típica del ruido (cuentas)
+#define RAMPA_PASO_MS       50
+
+
+// Sesión por defecto: un plato con dos alimentos que se añade, otro con un producto leído por barcode y guardar la comida
+const char *GUION_EJEMPLO =
+    "espera 1500\n"
+    "peso 300 400\n"        // Recipiente --> STATE_Plato
+    "espera 2500\n"
+    "grupo 7\n"             // TIPO_A --> STATE_Grupo
+    "espera 1500\n"
+    "crudo\n"               // --> STATE_raw
+    "espera 1500\n"
+    "peso 420 600\n"        // 120 g --> STATE_weighted
+    "espera 3000\n"
+    "grupo 16\n"
+    "espera 1500\n"
+    "cocinado\n"            // --> STATE_cooked
+    "espera 1500\n"
+    "peso 500 600\n"        // 80 g --> STATE_weighted
+    "espera 3000\n"
+    "anadir\n"              // --> STATE_add_check
+    "espera 1500\n"
+    "anadir\n"              // --> STATE_added
+    "espera 3000\n"
+    "peso 0 300\n"          // Retirar --> STATE_Init
+    "espera 3000\n"
+    "peso 250 400\n"        // Otro recipiente --> STATE_Plato
+    "espera 2500\n"
+    "leer 8410000000001\n"
+    "producto 8410000000001 Yogur natural;0.047;0.031;0.038;0.61\n"
+    "barcode\n"             // --> STATE_Barcode_read --> STATE_Barcode_search --> STATE_Barcode_check
+    "espera 6000\n"
+    "barcode\n"             // Confirmar producto --> STATE_Barcode
+    "espera 1500\n"
+    "peso 375 600\n"        // 125 g --> STATE_weighted
+    "espera 3000\n"
+    "guardar\n"             // --> STATE_save_check
+    "espera 1500\n"
+    "guardar\n"             // --> STATE_saved (sube la comida por el ESP32)
+    "espera 4000\n"
+    "peso 0 300\n"          // Retirar --> STATE_Init
+    "espera 3000\n";
+
+
+// ------ MEDIDAS POR EVENTO ----------------------------------------------------------
+typedef struct {
+    std::string         accion;
+    unsigned long long  nsEvento;
+    std::string         estados;            // Estado inicial y transiciones
+    unsigned long long  nsPrimeraTransicion;
+    double              usCPU;
+    unsigned long       nLoops;
+    hostStats_t         statsInicio;
+    unsigned long long  nsFin;
+    hostStats_t         statsFin;
+} medida_t;
+
+std::vector<medida_t>   medidas;
+int                     medidaActual = -1;
+state_t                 estadoMedido;               // Último estado anotado en la medida en curso
+// -----------------------------------------------------------------------------
+
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Nombre de un estado (el que imprime printStateName() por SerialPC).
+ */
+/*-----------------------------------------------------------------------------*/
+std::string nombreEstado(state_t estado)
+{
+    std::string nombre;
+    #if defined(SM_DEBUG)
+        hostCapturarSerial(&nombre);
+        printStateName(estado);
+        hostCapturarSerial(NULL);
+        if(nombre.compare(0, 6, "STATE_") == 0) nombre.erase(0, 6);
+    #else
+        nombre = std::to_string((int)estado);
+    #endif
+    return nombre;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Cierra la medida en curso y abre otra para la acción que acaba de ocurrir.
+ */
+/*-----------------------------------------------------------------------------*/
+void abrirMedida(const std::string &accion)
+{
+    if(medidaActual >= 0){ medidas[medidaActual].nsFin = hostAhoraNs(); medidas[medidaActual].statsFin = hostStats; }
+
+    medida_t m;
+    m.accion = accion;
+    m.nsEvento = hostAhoraNs();
+    m.estados = nombreEstado(state_actual);
+    estadoMedido = state_actual;                    // La acción puede llegar en mitad de un loop() que ya ha cambiado de estado
+    m.nsPrimeraTransicion = 0;
+    m.usCPU = 0;
+    m.nLoops = 0;
+    m.statsInicio = hostStats;
+    medidas.push_back(m);
+    medidaActual = medidas.size() - 1;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Programa una pulsación: sube el pin (o lo baja, si la entrada es pull-up) y lo suelta
+ *        pasados PULSACION_MS.
+ */
+/*-----------------------------------------------------------------------------*/
+void programarPulsacion(unsigned long long ns, const std::string &accion, byte pin, bool activoAlto)
+{
+    hostProgramar(ns, [=](){ abrirMedida(accion); hostFijarEntrada(pin, activoAlto); });
+    hostProgramar(ns + PULSACION_MS * 1000000ULL, [=](){ hostFijarEntrada(pin, !activoAlto); });
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee el guion y programa sus acciones a partir del instante 'inicioNs'.
+ * @return Instante en que termina el guion
+ */
+/*-----------------------------------------------------------------------------*/
+unsigned long long programarGuion(const std::string &guion, unsigned long long inicioNs)
+{
+    std::istringstream lineas(guion);
+    std::string linea;
+    unsigned long long t = inicioNs;
+    float pesoGuion = 0;
+    int nLinea = 0;
+
+    while(std::getline(lineas, linea))
+    {
+        nLinea++;
+        size_t comentario = linea.find('#');
+        if(comentario != std::string::npos) linea.erase(comentario);
+
+        std::istringstream campos(linea);
+        std::string orden;
+        if(!(campos >> orden)) continue;
+
+        if(orden == "espera")
+        {
+            unsigned long ms = 0;
+            campos >> ms;
+            t += ms * 1000000ULL;
+        }
+        else if(orden == "peso")
+        {
+            float gramos = 0;
+            unsigned long rampa = 0;
+            campos >> gramos >> rampa;
+            std::string accion = "peso " + String(gramos, 0);
+            float desde = pesoGuion;
+            unsigned long pasos = rampa / RAMPA_PASO_MS;
+            hostProgramar(t, [=](){ abrirMedida(accion); if(!pasos) hostFijarPeso(gramos); });
+            for(unsigned long i = 1; i <= pasos; i++)
+            {
+                float g = desde + (gramos - desde) * i / pasos;
+                hostProgramar(t + i * RAMPA_PASO_MS * 1000000ULL, [=](){ hostFijarPeso(g); });
+            }
+            pesoGuion = gramos;
+        }
+        else if(orden == "grupo")
+        {
+            int grupo = 0;
+            campos >> grupo;
+            int fila = -1, columna = -1;
+            for(byte r = 0; r < countRows; r++)
+                for(byte c = 0; c < countColumns; c++)
+                    if(buttons[r][c] == grupo){ fila = r; columna = c; }
+            if(fila < 0){ fprintf(stderr, "Linea %d: grupo %d no existe\n", nLinea, grupo); continue; }
+
+            std::string accion = "grupo " + std::to_string(grupo);
+            hostProgramar(t, [=](){ hostPulsarTecla(fila, columna); abrirMedida(accion); hostFijarEntrada(intPinGrande, HIGH); });
+            hostProgramar(t + PULSACION_MS * 1000000ULL, [=](){ hostFijarEntrada(intPinGrande, LOW); hostPulsarTecla(-1, -1); });
+        }
+        else if(orden == "cocinado")    programarPulsacion(t, orden, intPinCocinado, true);
+        else if(orden == "crudo")       programarPulsacion(t, orden, intPinCrudo, true);
+        else if(orden == "anadir")      programarPulsacion(t, orden, intPinAddPlato, true);
+        else if(orden == "borrar")      programarPulsacion(t, orden, intPinDeletePlato, true);
+        else if(orden == "guardar")     programarPulsacion(t, orden, intPinGuardar, true);
+        else if(orden == "barcode")     programarPulsacion(t, orden, intPinBarcode, false);
+        else if(orden == "wifi")
+        {
+            std::string valor;
+            campos >> valor;
+            bool wifi = (valor == "si");
+            hostProgramar(t, [=](){ hostESP32(wifi, 20, 800); });
+        }
+        else if(orden == "leer")
+        {
+            std::string bc;
+            campos >> bc;
+            hostProgramar(t, [=](){ hostESP32Barcode(bc, 2000); });
+        }
+        else if(orden == "pc")
+        {
+            std::string texto;
+            campos >> texto;
+            hostProgramar(t, [=](){ hostEnviarSerialPC(texto); });
+        }
+        else if(orden == "producto")
+        {
+            std::string bc, info;
+            campos >> bc;
+            std::getline(campos, info);
+            info.erase(0, info.find_first_not_of(' '));
+            hostESP32Producto(bc, info);
+        }
+        else fprintf(stderr, "Linea %d: orden desconocida '%s'\n", nLinea, orden.c_str());
+    }
+    return t;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra la tabla de medidas por evento.
+ */
+/*-----------------------------------------------------------------------------*/
+void mostrarMedidas(unsigned long long inicioNs)
+{
+    printf("\n %-3s %8s  %-10s %9s %9s %9s %8s %7s %8s %7s  %s\n", "#", "t(ms)", "accion", "lat(ms)", "ocup(ms)", "CPU(us)", "SPI(KB)", "tramas", "SD(KB)", "heap", "estados");
+
+    for(size_t i = 0; i < medidas.size(); i++)
+    {
+        const medida_t &m = medidas[i];
+        unsigned long long ventana = m.nsFin - m.nsEvento;
+        unsigned long long dormido = m.statsFin.nsDormido - m.statsInicio.nsDormido;
+
+        char lat[16];
+        if(m.nsPrimeraTransicion) snprintf(lat, sizeof(lat), "%.1f", (m.nsPrimeraTransicion - m.nsEvento) / 1e6);
+        else snprintf(lat, sizeof(lat), "-");
+
+        printf(" %-3zu %8.0f  %-10s %9s %9.1f %9.0f %8.1f %7llu %8.1f %7llu  %s\n",
+               i + 1, (m.nsEvento - inicioNs) / 1e6, m.accion.c_str(), lat,
+               (ventana - dormido) / 1e6, m.usCPU,
+               (m.statsFin.bytesSPI - m.statsInicio.bytesSPI) / 1024.0,
+               m.statsFin.tramasSPI - m.statsInicio.tramasSPI,
+               (m.statsFin.bytesSD - m.statsInicio.bytesSD) / 1024.0,
+               m.statsFin.reservasString - m.statsInicio.reservasString,
+               m.estados.c_str());
+    }
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    bool verbose = false, wifi = true;
+    std::string guion = GUION_EJEMPLO;
+    const char *carpetaSD = "../../../images";
+    const char *ficheroSDRAM = NULL;
+    std::vector<std::pair<std::string, std::string> > extraer;     // Ficheros de la SD a copiar al PC
+
+    for(int i = 1; i < argc; i++)
+    {
+        std::string op = argv[i];
+        if(op == "-v") verbose = true;
+        else if(op == "-w") wifi = false;
+        else if((op == "-s") and (i + 1 < argc)) carpetaSD = argv[++i];
+        else if((op == "-r") and (i + 1 < argc)) ficheroSDRAM = argv[++i];
+        else if((op == "-x") and (i + 2 < argc)){ extraer.push_back(std::make_pair(argv[i + 1], argv[i + 2])); i += 2; }
+        else if((op == "-g") and (i + 1 < argc))
+        {
+            std::ifstream f(argv[++i]);
+            if(!f){ fprintf(stderr, "No se puede abrir el guion %s\n", argv[i]); return 1; }
+            std::stringstream contenido;
+            contenido << f.rdbuf();
+            guion = contenido.str();
+        }
+        else { fprintf(stderr, "Uso: %s [-v] [-g guion.txt] [-s carpeta_SD] [-w] [-x fichero_SD fichero_PC] [-r sdram.bin]\n", argv[0]); return 1; }
+    }
+
+    // ---- PERIFÉRICOS SIMULADOS ----
+    hostSerialPC(verbose);
+    hostMontarSD(carpetaSD);
+    hostESP32(wifi, 20, 800);
+    hostPantalla(RA8876_CS);
+    bool reinicioEnCaliente = ficheroSDRAM and hostCargarSDRAM(ficheroSDRAM);
+    hostBascula(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN, HX711_OFFSET, SCALE_CALIBRATION_FACTOR, HX711_RUIDO);
+    hostTeclado(rowsPins, countRows, columnsPins, countColumns);
+    hostFijarEntrada(intPinBarcode, HIGH); // Pull-up: se pulsa a nivel bajo
+
+    // ---- ARRANQUE ----
+    std::chrono::steady_clock::time_point inicioPC = std::chrono::steady_clock::now();
+    setup();
+    double usSetup = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - inicioPC).count();
+    unsigned long long nsSetup = hostAhoraNs();
+
+    // ---- SESIÓN ----
+    unsigned long long finNs = programarGuion(guion, nsSetup) + COLA_SESION_MS * 1000000ULL;
+    hostStats_t statsSesion = hostStats;
+    unsigned long long nLoops = 0;
+
+    while(hostAhoraNs() < finNs)
+    {
+        unsigned long long dormidoAntes = hostStats.nsHostDormido;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        loop();
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        us -= (hostStats.nsHostDormido - dormidoAntes) / 1000.0;
+        nLoops++;
+
+        if(medidaActual < 0) continue;
+        medida_t &m = medidas[medidaActual];
+        m.usCPU += us;
+        m.nLoops++;
+        if(state_actual != estadoMedido)
+        {
+            if(!m.nsPrimeraTransicion) m.nsPrimeraTransicion = hostAhoraNs();
+            m.estados += " > " + nombreEstado(state_actual);
+            estadoMedido = state_actual;
+        }
+    }
+    if(medidaActual >= 0){ medidas[medidaActual].nsFin = hostAhoraNs(); medidas[medidaActual].statsFin = hostStats; }
+
+    double usTotal = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - inicioPC).count();
+
+    // ---- INFORME ----
+    hostSerialPC(false);
+    printf("\n========================= SIMULACION SMARTCLOTH =========================\n");
+    printf("Arranque (setup%s): %.0f ms virtuales, %.1f ms de CPU del PC, %llu tramas a la pantalla\n", reinicioEnCaliente ? ", pantalla encendida" : "",
+           nsSetup / 1e6, usSetup / 1000.0, statsSesion.tramasSPI);
+    mostrarMedidas(nsSetup);
+
+    unsigned long long nsSesion = hostAhoraNs() - nsSetup;
+    unsigned long long nsDormido = hostStats.nsDormido - statsSesion.nsDormido;
+    printf("\nSesion: %.1f s virtuales en %.3f s del PC (x%.0f), %llu iteraciones de loop()\n",
+           nsSesion / 1e9, usTotal / 1e6, (nsSetup + nsSesion) / (usTotal * 1000.0), nLoops);
+    printf("CPU libre (virtual): %.1f %%   ISR: %llu   Despertares: %llu\n",
+           100.0 * nsDormido / nsSesion, hostStats.nISR - statsSesion.nISR, hostStats.nDespertares - statsSesion.nDespertares);
+    printf("Pantalla: %.1f KB por SPI (%.1f KB de pixeles, hash %08x; %.1f KB leidos de la SDRAM), %.0f ms de bus\n",
+           hostStats.bytesSPI / 1024.0, hostStats.bytesSPIMemoria / 1024.0, hostStats.hashPixeles, hostStats.bytesLeidosSDRAM / 1024.0, hostStats.nsSPI / 1e6);
+    printf("          %llu tramas (CS) en %llu transacciones SPI\n", hostStats.tramasSPI, hostStats.transaccionesSPI);
+    printf("SD: %.1f KB en %llu aperturas   ESP32: %llu lineas, %llu comidas subidas\n",
+           hostStats.bytesSD / 1024.0, hostStats.aperturasSD, hostStats.lineasESP32, hostStats.comidasSubidas);
+    printf("Heap: %llu reservas de String en el arranque y %llu en la sesion\n",
+           statsSesion.reservasString, hostStats.reservasString - statsSesion.reservasString);
+
+    if(ficheroSDRAM and !hostGuardarSDRAM(ficheroSDRAM)) fprintf(stderr, "No se puede guardar la SDRAM en %s\n", ficheroSDRAM);
+
+    std::string csv;
+    if(hostLeerFicheroSD(historyFileCSV, csv)) printf("\n%s:\n%s", historyFileCSV, csv.c_str());
+
+    for(size_t i = 0; i < extraer.size(); i++)
+    {
+        std::string contenido;
+        if(!hostLeerFicheroSD(extraer[i].first.c_str(), contenido)){ fprintf(stderr, "No existe %s en la SD\n", extraer[i].first.c_str()); continue; }
+        std::ofstream f(extraer[i].second.c_str(), std::ios::binary);
+        f.write(contenido.data(), contenido.size());
+    }
+
+    return 0;
+}
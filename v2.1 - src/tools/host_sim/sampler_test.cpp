@@ -0,0 +1,152 @@
+/**
+ * @file sampler_test.cpp
+ * @brief Prueba en PC del muestreo del HX711 por DRDY (HX711_Sampler.h) con el HX711 simulado
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar con el CMakeLists.txt de tools/ (objetivo sampler_test) o desde esta carpeta, igual que host_sim:
+ *
+ *      g++ -std=gnu++11 -O2 -DHOST_SIM -DARDUINO=10819 -Ihal -I"../../smartcloth_v2" -I"../../../libs/HX711/src" \
+ *          -o sampler_test sampler_test.cpp hal/Host.cpp "../../smartcloth_v2/RA8876_v2.cpp" "../../../libs/HX711/src/HX711.cpp"
+ *
+ * El HX711 de hal/Host.cpp baja DOUT en cada conversión (10 SPS), saca un bit por cada flanco de subida
+ * de SCK y vuelve a subir DOUT en el pulso 25. Sin setup() del sketch: solo setupSampler(), la ISR de
+ * DOUT (ISR_muestraHX711()) y popMuestraSampler(), que es lo que vacía el buffer en checkBascula().
+ * Cada conversión k lleva la cuenta OFFSET + k (factor 1, sin ruido apreciable), así que se sabe qué
+ * muestra es cada una. Se comprueba:
+ *
+ *      1. Tramas de 25 pulsos: cada muestra deja DOUT en alto y SCK en bajo y llega entera y en orden.
+ *      2. Desbordamiento del buffer: sin vaciarlo, se guardan las SAMPLER_BUFFER_SIZE - 1 más antiguas,
+ *         el resto se cuenta en 'nMuestrasPerdidas' y el muestreo sigue después sin desfasarse.
+ *      3. Flanco de DRDY perdido: popMuestraSampler() lee la conversión pendiente con DOUT en bajo.
+ *      4. Cuentas negativas: extensión del signo del complemento a 2 de 24 bits.
+ *
+ * Devuelve 1 si falla alguna comprobación.
+ */
+
+#include "Arduino.h"
+#include "Host.h"
+#include "smartcloth_v2.ino"
+
+#define PRUEBA_OFFSET       100000L         // Cuentas con 0 g
+#define PRUEBA_PERIODO_NS   100000000ULL    // Periodo de conversión del HX711 simulado (10 SPS)
+#define PRUEBA_CONVERSIONES 200             // Conversiones con su peso programado
+#define PULSOS_CANAL_A_128  25              // Datasheet del HX711: 24 bits + 1 pulso (26: canal B, 27: canal A con ganancia 64)
+
+static int  fallos = 0;
+static unsigned long long inicioNs = 0;     // Instante de hostBascula(): la conversión k llega en inicioNs + k * periodo
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Cuenta y muestra una comprobación fallida.
+ */
+/*-----------------------------------------------------------------------------*/
+static void comprobar(bool condicion, const char *descripcion)
+{
+    if(condicion) return;
+    fallos++;
+    printf("   FALLO: %s\n", descripcion);
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Avanza el reloj virtual hasta justo después de la conversión 'k'.
+ */
+/*-----------------------------------------------------------------------------*/
+static void hastaConversion(unsigned k)
+{
+    unsigned long long destino = inicioNs + k * PRUEBA_PERIODO_NS + PRUEBA_PERIODO_NS / 4;
+    if(destino > hostAhoraNs()) hostAvanzarNs(destino - hostAhoraNs());
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Vacía el buffer y comprueba que salen las conversiones 'desde'..'hasta' en orden.
+ */
+/*-----------------------------------------------------------------------------*/
+static void comprobarMuestras(unsigned desde, unsigned hasta, const char *descripcion)
+{
+    unsigned n = 0;
+    bool enOrden = true;
+    long raw;
+    while(popMuestraSampler(raw))
+    {
+        if(raw != PRUEBA_OFFSET + (long)(desde + n)) enOrden = false;
+        n++;
+    }
+    printf("   %s: %u muestras (esperadas %u)\n", descripcion, n, hasta - desde + 1);
+    comprobar(n == hasta - desde + 1, "numero de muestras");
+    comprobar(enOrden, "valores o el orden de las muestras");
+}
+
+
+
+
+int main()
+{
+    inicioNs = hostAhoraNs();
+    hostBascula(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN, PRUEBA_OFFSET, 1.0, 0.001);
+    for(unsigned k = 1; k <= PRUEBA_CONVERSIONES; k++) // La conversión k pesa k gramos (k cuentas)
+        hostProgramar(inicioNs + k * PRUEBA_PERIODO_NS - PRUEBA_PERIODO_NS / 2, [k](){ hostFijarPeso(k); });
+
+    pinMode(LOADCELL_SCK_PIN, OUTPUT);
+    digitalWrite(LOADCELL_SCK_PIN, LOW);
+    pinMode(LOADCELL_DOUT_PIN, INPUT);
+    setupSampler(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN);
+
+
+    // ----- 1. TRAMAS DE 25 PULSOS ------------------------------------------
+    printf("1. Tramas de %d pulsos\n", PULSOS_CANAL_A_128);
+    hastaConversion(10);
+    comprobar(hostStats.pulsosSCK == 10ULL * PULSOS_CANAL_A_128, "pulsos de SCK por muestra");
+    comprobar(digitalRead(LOADCELL_DOUT_PIN) == HIGH, "DOUT en alto tras el pulso 25");
+    comprobar(digitalRead(LOADCELL_SCK_PIN) == LOW, "SCK en bajo entre muestras (en alto > 60 us apaga el HX711)");
+    comprobarMuestras(1, 10, "conversiones 1-10");
+    comprobar(nMuestrasPerdidas == 0, "sin muestras perdidas");
+
+
+    // ----- 2. DESBORDAMIENTO DEL BUFFER ------------------------------------
+    printf("2. Desbordamiento del buffer (%d posiciones)\n", SAMPLER_BUFFER_SIZE);
+    hastaConversion(90); // 80 conversiones sin vaciar
+    unsigned caben = SAMPLER_BUFFER_SIZE - 1;
+    printf("   perdidas: %lu (esperadas %u)\n", (unsigned long)nMuestrasPerdidas, 80 - caben);
+    comprobar(nMuestrasPerdidas == 80 - caben, "muestras perdidas con el buffer lleno");
+    comprobar(nMuestrasTotales == 90, "muestras leidas por la ISR (tambien las perdidas)");
+    comprobarMuestras(11, 10 + caben, "las mas antiguas");
+    hastaConversion(95);
+    comprobarMuestras(91, 95, "despues de desbordar");
+    comprobar(hostStats.pulsosSCK == 95ULL * PULSOS_CANAL_A_128, "pulsos de SCK tras desbordar");
+
+
+    // ----- 3. FLANCO DE DRDY PERDIDO ---------------------------------------
+    printf("3. Flanco de DRDY perdido\n");
+    detachInterrupt(digitalPinToInterrupt(LOADCELL_DOUT_PIN));
+    hastaConversion(96); // DOUT baja sin ISR
+    attachInterrupt(digitalPinToInterrupt(LOADCELL_DOUT_PIN), ISR_muestraHX711, FALLING);
+    comprobar(digitalRead(LOADCELL_DOUT_PIN) == LOW, "DOUT en bajo con la conversion pendiente");
+    comprobar(isSamplerBufferEmpty(), "buffer vacio sin la ISR");
+    comprobarMuestras(96, 96, "leida desde popMuestraSampler()");
+    comprobar(digitalRead(LOADCELL_DOUT_PIN) == HIGH, "DOUT en alto tras leerla");
+    hastaConversion(100);
+    comprobarMuestras(97, 100, "siguientes por la ISR");
+
+
+    // ----- 4. CUENTAS NEGATIVAS --------------------------------------------
+    printf("4. Cuentas negativas\n");
+    hostProgramar(inicioNs + 101 * PRUEBA_PERIODO_NS - PRUEBA_PERIODO_NS / 4, [](){ hostFijarPeso(-(PRUEBA_OFFSET + 5)); });
+    hastaConversion(101);
+    long raw = 0;
+    bool hay = popMuestraSampler(raw);
+    printf("   cuenta: %ld (esperada -5)\n", raw);
+    comprobar(hay and (raw == -5), "extension del signo de 24 bits");
+
+
+    printf("\nISR: %lu muestras, %lu perdidas, %lu us como maximo. %s\n", (unsigned long)nMuestrasTotales,
+            (unsigned long)nMuestrasPerdidas, (unsigned long)maxTiempoISRMuestra, fallos ? "FALLA" : "OK");
+    return fallos ? 1 : 0;
+}
@@ -0,0 +1,531 @@
+/**
+ * @file lista_bench.cpp
+ * @brief Herramienta de PC que compara la lista de la comida (lista_Comida.h) con la versión anterior
+ *        (vector de String): mismo texto, uso del heap y fragmentación a lo largo de muchas comidas
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar con el CMakeLists.txt de tools/ (objetivo lista_bench) o desde esta carpeta (con el núcleo
+ * y el sketch del simulador, como tools/host_sim):
+ *
+ *      g++ -std=gnu++11 -O2 -Wall -Wextra -Wno-comment -DHOST_SIM -DARDUINO=10819 -I../host_sim/hal -I"../../smartcloth_v2" \
+ *          -I"../../../libs/HX711/src" -o lista_bench lista_bench.cpp ../host_sim/hal/Host.cpp \
+ *          "../../smartcloth_v2/RA8876_v2.cpp" "../../../libs/HX711/src/HX711.cpp"
+ *
+ * Uso:
+ *
+ *      lista_bench [dias] [comidas_por_dia]
+ *
+ * Se generan al azar (semilla fija) comidas como las que escribe la Máquina de Estados: INICIO-COMIDA,
+ * platos con alimentos (algunos de barcode), platos borrados y FIN-COMIDA, y después se envían o se
+ * guardan y se limpia la lista. Todo sin reiniciar, como un SmartCloth encendido varios días. Se
+ * comprueba:
+ *
+ *      1. Que el texto de cada comida (lo que llega al ESP32 o al TXT) es el mismo en las dos versiones.
+ *      2. Que la lista actual no descarta ningún registro y cuánto llega a ocupar de CAPACIDAD_LISTA.
+ *
+ * Devuelve 1 si falla alguna de las dos.
+ *
+ * HEAP: el PC no tiene el heap del Due, así que los String de la versión anterior reservan en un modelo
+ * del malloc de newlib: bloques con 4 bytes de cabecera, alineados a 8 y de 16 como mínimo; se usa el
+ * primer hueco en el que quepa, los huecos contiguos se unen, realloc() crece en el sitio si detrás hay
+ * hueco o está la cima, y el heap solo crece (sbrk) cuando no hay hueco. Los String siguen las reglas
+ * del núcleo del Due: reserva exacta (longitud + 1), realloc() en cada concatenación, copia al devolver
+ * por valor y al meter en el vector, y el vector (12 bytes por String) copia todos al crecer porque el
+ * constructor de movimiento de String no es noexcept. También se intercalan las reservas del resto del
+ * programa que ocurren mientras se llena la lista (el barcode leído, la respuesta del ESP32 con el
+ * producto y las líneas del CSV y de la petición HTTP al guardar), que son las que dejan huecos.
+ *
+ * Al final de cada día se muestra, para las dos versiones: bytes en uso, cima del heap (lo que el heap
+ * ha quitado a la pila para siempre), huecos libres por debajo de la cima, el mayor de ellos y la
+ * fragmentación (1 - mayor hueco / huecos libres).
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "Host.h"
+#include "smartcloth_v2.ino" // Lista y listaComidaESP32 actuales
+
+
+/*******************************************************************************
+/*******************************************************************************
+                            MODELO DEL HEAP DEL DUE
+/******************************************************************************/
+/******************************************************************************/
+#define CABECERA_HEAP       4       // Tamaño del bloque (size_t de 32 bits)
+#define ALINEACION_HEAP     8
+#define BLOQUE_MINIMO_HEAP  16
+#define INICIO_HEAP         8       // Primera dirección (0 es NULL)
+
+class ModeloHeap
+{
+public:
+    std::map<uint32_t, uint32_t>    huecos;     // Dirección -> tamaño de los bloques libres por debajo de la cima
+    std::map<uint32_t, uint32_t>    bloques;    // Dirección -> tamaño de los bloques en uso
+    uint32_t                        cima = INICIO_HEAP;
+    uint32_t                        maxCima = INICIO_HEAP;
+    uint32_t                        enUso = 0;
+    uint32_t                        maxEnUso = 0;
+    unsigned long long              operaciones = 0;    // malloc(), realloc() y free()
+
+    static uint32_t tamBloque(uint32_t n)
+    {
+        uint32_t t = (n + CABECERA_HEAP + ALINEACION_HEAP - 1) & ~(uint32_t)(ALINEACION_HEAP - 1);
+        return (t < BLOQUE_MINIMO_HEAP) ? BLOQUE_MINIMO_HEAP : t;
+    }
+
+    uint32_t reservar(uint32_t n)
+    {
+        operaciones++;
+        return tomar(tamBloque(n));
+    }
+
+    void liberar(uint32_t dir)
+    {
+        if(dir == 0) return;
+        operaciones++;
+        soltar(dir);
+    }
+
+    uint32_t redimensionar(uint32_t dir, uint32_t n)
+    {
+        if(dir == 0) return reservar(n);
+        operaciones++;
+
+        uint32_t t = tamBloque(n);
+        uint32_t actual = bloques[dir];
+        if(t <= actual) return dir;
+
+        // Crecer en el sitio: detrás está la cima o un hueco suficiente
+        uint32_t falta = t - actual;
+        if(dir + actual == cima)
+        {
+            cima += falta;
+            usar(dir, t, actual);
+            return dir;
+        }
+        auto h = huecos.find(dir + actual);
+        if((h != huecos.end()) and (h->second >= falta))
+        {
+            uint32_t resto = h->second - falta;
+            huecos.erase(h);
+            if(resto >= BLOQUE_MINIMO_HEAP) huecos[dir + t] = resto;
+            else t += resto;
+            usar(dir, t, actual);
+            return dir;
+        }
+
+        // Si no, bloque nuevo, copia y liberar el anterior
+        uint32_t nuevo = tomar(t);
+        soltar(dir);
+        return nuevo;
+    }
+
+    uint32_t totalHuecos() const { uint32_t s = 0; for(auto &h : huecos) s += h.second; return s; }
+    uint32_t mayorHueco() const { uint32_t m = 0; for(auto &h : huecos) if(h.second > m) m = h.second; return m; }
+    double   fragmentacion() const { uint32_t s = totalHuecos(); return s ? 1.0 - (double)mayorHueco() / s : 0.0; }
+
+private:
+    void usar(uint32_t dir, uint32_t t, uint32_t antes)
+    {
+        bloques[dir] = t;
+        enUso += t - antes;
+        if(enUso > maxEnUso) maxEnUso = enUso;
+        if(cima > maxCima) maxCima = cima;
+    }
+
+    uint32_t tomar(uint32_t t)
+    {
+        for(auto h = huecos.begin(); h != huecos.end(); ++h)
+        {
+            if(h->second < t) continue;
+            uint32_t dir = h->first, resto = h->second - t;
+            huecos.erase(h);
+            if(resto >= BLOQUE_MINIMO_HEAP) huecos[dir + t] = resto;
+            else t += resto;
+            usar(dir, t, 0);
+            return dir;
+        }
+        uint32_t dir = cima;
+        cima += t;
+        usar(dir, t, 0);
+        return dir;
+    }
+
+    void soltar(uint32_t dir)
+    {
+        auto b = bloques.find(dir);
+        uint32_t t = b->second;
+        bloques.erase(b);
+        enUso -= t;
+
+        // Unir con los huecos de delante y de detrás
+        auto sig = huecos.find(dir + t);
+        if(sig != huecos.end()){ t += sig->second; huecos.erase(sig); }
+        auto ant = huecos.lower_bound(dir);
+        if(ant != huecos.begin())
+        {
+            --ant;
+            if(ant->first + ant->second == dir){ dir = ant->first; t += ant->second; huecos.erase(ant); }
+        }
+
+        // Lo que toca la cima vuelve a ella
+        if(dir + t == cima) cima = dir;
+        else huecos[dir] = t;
+    }
+};
+
+ModeloHeap *heapModelo = NULL;  // Heap en el que reservan los String de la versión anterior
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                     VERSIÓN ANTERIOR (VECTOR DE STRING)
+/******************************************************************************/
+/******************************************************************************/
+// String del núcleo del Due (WString.cpp) con sus reservas en el modelo, y Lista tal cual estaba
+// (sin los mensajes de SM_DEBUG).
+namespace anterior
+{
+    #define TAM_STRING_DUE  12  // char *buffer, unsigned int capacity, unsigned int len
+
+    class String
+    {
+        std::string _texto;
+        uint32_t    _dir = 0;           // Buffer en el modelo (0 = NULL)
+        unsigned    _capacidad = 0;
+
+        void reserve(unsigned n){ if(_dir and (_capacidad >= n)) return; _dir = heapModelo->redimensionar(_dir, n + 1); _capacidad = n; }
+        void copy(const char *s, unsigned n){ reserve(n); _texto.assign(s, n); }
+
+      public:
+        String(const char *s = ""){ copy(s, strlen(s)); }
+        String(const String &s){ *this = s; }
+        String(String &&s) : _texto(std::move(s._texto)), _dir(s._dir), _capacidad(s._capacidad) { s._dir = 0; s._capacidad = 0; }   // No es noexcept, como en el núcleo
+        explicit String(unsigned char v){ char t[8]; snprintf(t, sizeof(t), "%u", v); copy(t, strlen(t)); }
+        explicit String(float v){ char t[33]; snprintf(t, sizeof(t), "%4.2f", v); copy(t, strlen(t)); }     // dtostrf(v, 4, 2, t)
+        ~String(){ heapModelo->liberar(_dir); }
+
+        String& operator=(const String &s){ if(this != &s) copy(s._texto.data(), s._texto.size()); return *this; }
+        bool operator==(const char *s) const { return _texto == s; }
+        bool operator!=(const char *s) const { return _texto != s; }
+        void concat(const char *s, unsigned n){ if(n == 0) return; reserve(_texto.size() + n); _texto.append(s, n); }
+        const std::string& texto() const { return _texto; }
+    };
+
+    class StringSumHelper : public String
+    {
+      public:
+        StringSumHelper(const char *s) : String(s) {}
+    };
+
+    StringSumHelper& operator+(const StringSumHelper &a, const String &b){ StringSumHelper &r = const_cast<StringSumHelper&>(a); r.concat(b.texto().data(), b.texto().size()); return r; }
+    StringSumHelper& operator+(const StringSumHelper &a, const char *b){ StringSumHelper &r = const_cast<StringSumHelper&>(a); r.concat(b, strlen(b)); return r; }
+
+
+    // Las reservas del vector, también en el modelo
+    template<class T> struct reservaModelo
+    {
+        typedef T value_type;
+        static std::map<T*, uint32_t> &direcciones(){ static std::map<T*, uint32_t> d; return d; }
+
+        reservaModelo(){}
+        template<class U> reservaModelo(const reservaModelo<U>&){}
+        T* allocate(size_t n){ T *p = (T*)::operator new(n * sizeof(T)); direcciones()[p] = heapModelo->reservar(n * TAM_STRING_DUE); return p; }
+        void deallocate(T *p, size_t){ heapModelo->liberar(direcciones()[p]); direcciones().erase(p); ::operator delete(p); }
+        template<class U> bool operator==(const reservaModelo<U>&) const { return true; }
+        template<class U> bool operator!=(const reservaModelo<U>&) const { return false; }
+    };
+
+
+    class Lista
+    {
+        std::vector<String, reservaModelo<String> > _lines;
+
+        String getLastItem(){ return _lines.back(); }
+        bool isListEmpty(){ return _lines.empty(); }
+        void addLineToList(const String& line){ _lines.push_back(line); }
+        void deleteItemsFrom(byte& fromIndex){ _lines.erase(_lines.begin() + fromIndex, _lines.end()); }
+
+      public:
+        byte getListSize(){ return _lines.size(); }
+        String getItem(byte& index){ return _lines[index]; }
+        void clearList(){ _lines.clear(); }
+
+        void iniciarComida(){ if(isListEmpty()) addLineToList("INICIO-COMIDA"); }
+        void iniciarPlato(){ if(getLastItem() != "INICIO-PLATO") addLineToList("INICIO-PLATO"); }
+        void addAlimento(byte grupo, float peso)
+        {
+            String cad = "ALIMENTO," + String(grupo) + "," + String(peso);
+            addLineToList(cad);
+        }
+        void addAlimentoBarcode(byte grupo, float peso, String barcode)
+        {
+            String cad = "ALIMENTO," + String(grupo) + "," + String(peso) + "," + barcode;
+            addLineToList(cad);
+        }
+        void borrarLastPlato()
+        {
+            byte lastPlatoIndex = -1;
+            for(byte i = 0; i < getListSize(); i++)
+                if(getItem(i) == "INICIO-PLATO") lastPlatoIndex = i;
+            if(lastPlatoIndex != (byte)-1) deleteItemsFrom(lastPlatoIndex); // En el original '!= -1', siempre cierto con un byte
+        }
+        void finishComida()
+        {
+            char *today = rtc.getDateStr();
+            char *time = rtc.getTimeStr();
+            String cadFin = "FIN-COMIDA," + String(today) + "," + String(time);
+            addLineToList(cadFin);
+        }
+    };
+}
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                                COMIDAS DE PRUEBA
+/******************************************************************************/
+/******************************************************************************/
+#define PORCENTAJE_BARCODE      25      // Alimentos de barcode
+#define PORCENTAJE_BORRADO      15      // Platos que se borran (STATE_deleted)
+#define MAX_PLATOS              4
+#define MAX_ALIMENTOS_PLATO     8
+
+typedef struct {
+    byte        grupo;
+    float       peso;
+    std::string ean;        // Vacío si no es de barcode
+} alimentoPrueba_t;
+
+typedef struct {
+    std::vector<alimentoPrueba_t>   alimentos;
+    bool                            borrar;     // Se borra al terminarlo
+} platoPrueba_t;
+
+typedef std::vector<platoPrueba_t> comidaPrueba_t;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Genera una comida al azar: grupos de Grupos.h, pesos de la báscula (float sin redondear)
+ *        y EAN-13 o EAN-8 en los de barcode.
+ */
+/*-----------------------------------------------------------------------------*/
+comidaPrueba_t generarComida()
+{
+    comidaPrueba_t comida(1 + rand() % MAX_PLATOS);
+    for(auto &plato : comida)
+    {
+        plato.borrar = (rand() % 100) < PORCENTAJE_BORRADO;
+        plato.alimentos.resize(1 + rand() % MAX_ALIMENTOS_PLATO);
+        for(auto &a : plato.alimentos)
+        {
+            a.peso = 1.0f + 499.0f * ((float)rand() / RAND_MAX);
+            if((rand() % 100) < PORCENTAJE_BARCODE)
+            {
+                a.grupo = BARCODE_PRODUCT_INDEX;
+                a.ean = (rand() % 5) ? "84" : "";
+                while(a.ean.size() < ((a.ean.empty() or (a.ean[0] != '8')) ? 8 : 13)) a.ean += (char)('0' + rand() % 10);
+            }
+            else a.grupo = gruposAlimentos[rand() % NUM_GRUPOS].ID_grupo;
+        }
+    }
+    return comida;
+}
+
+
+// Salida que guarda el texto escrito (en lugar de SerialESP32 o el fichero TXT)
+class SalidaTexto : public Print
+{
+public:
+    std::string texto;
+    size_t write(uint8_t b){ texto += (char)b; return 1; }
+};
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                                 SIMULACIÓN
+/******************************************************************************/
+/******************************************************************************/
+
+// Resto del programa: reservas que se intercalan con las de la lista
+struct RestoPrograma
+{
+    anterior::String barcode;   // Global 'barcode' de State_Machine.h
+
+    // askForBarcode() y getProductInfo(): el código leído y la respuesta del ESP32 con el producto
+    void leerBarcode(const std::string &ean)
+    {
+        barcode = anterior::String(ean.c_str());
+        anterior::String productInfo = anterior::StringSumHelper("PRODUCT:") + barcode + ";Producto de prueba;0.047;0.031;0.038;0.61";
+    }
+
+    // getComidaAllValues() y getComidaAllValuesHttpRequest() mientras se guarda la comida
+    template<class F> void guardar(F escribirLista)
+    {
+        anterior::String csv = anterior::StringSumHelper("18.10.2026;08:01:03;") + "38.36;3.80;10.93;1.10;24.16;2.40;346.85;341.69";
+        anterior::String http = anterior::StringSumHelper("carb=38.36&carb_R=3.80&lip=10.93&lip_R=1.10&prot=24.16") + "&prot_R2.40&kcal346.85&peso=341.69";
+        escribirLista();
+    }
+};
+
+
+typedef struct {
+    uint32_t    enUso;
+    uint32_t    cima;
+    uint32_t    huecos;
+    uint32_t    mayorHueco;
+    double      fragmentacion;
+} fotoHeap_t;
+
+fotoHeap_t foto(const ModeloHeap &h){ return { h.enUso, h.cima, h.totalHuecos(), h.mayorHueco(), h.fragmentacion() }; }
+
+
+int main(int argc, char *argv[])
+{
+    unsigned dias = (argc > 1) ? atoi(argv[1]) : 7;
+    unsigned comidasDia = (argc > 2) ? atoi(argv[2]) : 12;
+
+    srand(2024);
+    std::vector< std::vector<comidaPrueba_t> > comidas(dias);
+    unsigned nComidas = 0, nPlatos = 0, nBorrados = 0, nAlimentos = 0, nBarcode = 0;
+    for(auto &dia : comidas)
+    {
+        for(unsigned c = 0; c < comidasDia; c++) dia.push_back(generarComida());
+        for(auto &comida : dia)
+        {
+            nComidas++;
+            for(auto &plato : comida)
+            {
+                nPlatos++; nBorrados += plato.borrar;
+                for(auto &a : plato.alimentos){ nAlimentos++; nBarcode += !a.ean.empty(); }
+            }
+        }
+    }
+    printf("%u dias, %u comidas, %u platos (%u borrados), %u alimentos (%u de barcode)\n\n", dias, nComidas, nPlatos, nBorrados, nAlimentos, nBarcode);
+
+    ModeloHeap heapAntes, heapAhora;
+    std::vector<fotoHeap_t> fotosAntes, fotosAhora;
+    unsigned comidasIguales = 0, comidasDistintas = 0, maxBytesLista = 0;
+    std::string primeraDistinta;
+
+    // Cada versión con su heap desde que se construye (no se destruyen: el programa termina antes)
+    heapModelo = &heapAntes;
+    anterior::Lista &listaAntes = *new anterior::Lista;
+    RestoPrograma &restoAntes = *new RestoPrograma;
+    heapModelo = &heapAhora;
+    RestoPrograma &restoAhora = *new RestoPrograma;
+
+    for(auto &dia : comidas)
+    {
+        for(auto &comida : dia)
+        {
+            // ----- VERSIÓN ANTERIOR -----
+            heapModelo = &heapAntes;
+            std::string textoAntes;
+            listaAntes.iniciarComida();
+            for(auto &plato : comida)
+            {
+                listaAntes.iniciarPlato();
+                for(auto &a : plato.alimentos)
+                {
+                    if(a.ean.empty()) listaAntes.addAlimento(a.grupo, a.peso);
+                    else
+                    {
+                        restoAntes.leerBarcode(a.ean);
+                        listaAntes.addAlimentoBarcode(a.grupo, a.peso, restoAntes.barcode);
+                    }
+                }
+                if(plato.borrar) listaAntes.borrarLastPlato();
+            }
+            listaAntes.finishComida();
+            restoAntes.guardar([&](){
+                for(byte i = 0; i < listaAntes.getListSize(); i++) textoAntes += listaAntes.getItem(i).texto() + "\r\n";  // println(getItem(i))
+            });
+            listaAntes.clearList();
+
+            // ----- VERSIÓN ACTUAL -----
+            heapModelo = &heapAhora;
+            SalidaTexto salida;
+            listaComidaESP32.iniciarComida();
+            for(auto &plato : comida)
+            {
+                listaComidaESP32.iniciarPlato();
+                for(auto &a : plato.alimentos)
+                {
+                    if(a.ean.empty()) listaComidaESP32.addAlimento(a.grupo, a.peso);
+                    else
+                    {
+                        restoAhora.leerBarcode(a.ean);
+                        listaComidaESP32.addAlimentoBarcode(a.grupo, a.peso, String(a.ean.c_str()));
+                    }
+                }
+                if(listaComidaESP32.getBytesLista() > maxBytesLista) maxBytesLista = listaComidaESP32.getBytesLista();
+                if(plato.borrar) listaComidaESP32.borrarLastPlato();
+            }
+            listaComidaESP32.finishComida();
+            if(listaComidaESP32.getBytesLista() > maxBytesLista) maxBytesLista = listaComidaESP32.getBytesLista();
+            restoAhora.guardar([&](){ listaComidaESP32.printLista(salida); });
+            listaComidaESP32.clearList();
+
+            if(salida.texto == textoAntes) comidasIguales++;
+            else if(comidasDistintas++ == 0) primeraDistinta = "Antes:\n" + textoAntes + "Ahora:\n" + salida.texto;
+        }
+        fotosAntes.push_back(foto(heapAntes));
+        fotosAhora.push_back(foto(heapAhora));
+    }
+
+    bool ok = (comidasDistintas == 0) and (maxBytesLista <= CAPACIDAD_LISTA);
+
+    // ----- 1. TEXTO -----
+    printf("Texto de cada comida: %u/%u iguales\n", comidasIguales, nComidas);
+    if(comidasDistintas) printf("Primera distinta:\n%s\n", primeraDistinta.c_str());
+
+    // ----- 2. CAPACIDAD -----
+    // Sin descartes, la lista ocupa lo mismo que su texto menos lo que se ahorra por registro; un
+    // descarte se vería como texto distinto.
+    printf("Lista actual: como mucho %u de %u bytes\n\n", maxBytesLista, CAPACIDAD_LISTA);
+
+    // ----- HEAP -----
+    printf("Heap al terminar cada dia (bytes; fragm = 1 - mayor hueco / huecos):\n");
+    printf(" %4s | %-44s | %-44s\n", "", "vector de String", "registros binarios");
+    printf(" %4s | %7s %7s %7s %7s %6s   | %7s %7s %7s %7s %6s\n", "dia", "en uso", "cima", "huecos", "mayor", "fragm", "en uso", "cima", "huecos", "mayor", "fragm");
+    unsigned paso = (dias > 10) ? dias / 10 : 1;
+    for(unsigned d = 0; d < dias; d++)
+    {
+        if((d % paso) and (d != dias - 1)) continue;
+        const fotoHeap_t &a = fotosAntes[d], &b = fotosAhora[d];
+        printf(" %4u | %7u %7u %7u %7u %5.0f%%   | %7u %7u %7u %7u %5.0f%%\n", d + 1,
+               a.enUso, a.cima, a.huecos, a.mayorHueco, 100 * a.fragmentacion,
+               b.enUso, b.cima, b.huecos, b.mayorHueco, 100 * b.fragmentacion);
+    }
+    printf("\nMaximo en uso:      %6u bytes (vector de String)   %6u bytes (registros)\n", heapAntes.maxEnUso, heapAhora.maxEnUso);
+    printf("Cima maxima:        %6u bytes                      %6u bytes\n", heapAntes.maxCima, heapAhora.maxCima);
+    printf("Operaciones heap:   %6.1f por comida                %6.1f por comida\n", (double)heapAntes.operaciones / nComidas, (double)heapAhora.operaciones / nComidas);
+    printf("                    %6.1f por alimento\n", (double)heapAntes.operaciones / nAlimentos);
+    printf("(Registros: %u bytes fijos en .bss, fuera del heap)\n", (unsigned)sizeof(Lista));
+
+    printf("\n%s\n", ok ? "OK" : "FALLOS");
+    return ok ? 0 : 1;
+}
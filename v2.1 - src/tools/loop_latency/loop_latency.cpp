@@ -0,0 +1,319 @@
+/**
+ * @file loop_latency.cpp
+ * @brief Simulación en PC del loop: latencia evento-pantalla y CPU libre con el antiguo sondeo de 50 ms
+ *        y con el planificador dirigido por eventos (Scheduler.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar con el CMakeLists.txt de tools/ (objetivo loop_latency) o desde esta carpeta:
+ *
+ *      g++ -std=gnu++11 -O2 -Wall -Wextra -Wno-comment -DHOST_SIM -I"../host_sim/hal" -I"../../smartcloth_v2" -o loop_latency loop_latency.cpp
+ *
+ * Con HOST_SIM, HAL.h usa las cabeceras de Arduino del simulador (../host_sim/hal) en lugar de
+ * los registros del SAM3X8E, y halDormir() llama a hostDormir(), que aquí se define sobre el reloj
+ * virtual de esta simulación (no hace falta enlazar Host.cpp).
+ *
+ * Uso:
+ *
+ *      loop_latency [segundos] [ms_pantalla]
+ *
+ * Se simula un reloj virtual en us. Las pulsaciones llegan al azar (media de una cada 2 seg) y la
+ * báscula da una muestra cada 100 ms (10 SPS), de las que alguna acaba en un cambio de peso
+ * estable (media de uno cada 5 seg). Cada pulsación o cambio de peso provoca una transición y el
+ * nuevo estado dibuja su pantalla, que cuesta 'ms_pantalla' (por defecto 40 ms).
+ *
+ * El loop nuevo usa el propio Scheduler.h del sketch: millis(), micros(), hostDormir() e interrupts()
+ * se implementan aquí sobre el reloj virtual, y las "ISR" (pulsación, DRDY y SysTick de 1 ms)
+ * se ejecutan cuando el reloj llega a su tiempo y las interrupciones están habilitadas.
+ *
+ * La latencia se mide desde la interrupción (pulsación o muestra de la báscula) hasta que termina
+ * de dibujarse la pantalla del nuevo estado. La CPU libre es el tiempo dormido en WFI; el loop
+ * antiguo nunca duerme (espera activa comprobando millis()), así que para él se muestra también
+ * el tiempo que pasa dando vueltas sin hacer nada.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+
+// ------ ENTORNO MÍNIMO DEL SKETCH ---------------------------------------------
+#define DEBUG_H // Sin SerialPC: las estadísticas se muestran aquí
+
+typedef uint8_t byte;
+
+unsigned long long  reloj = 0;                  // us virtuales
+bool                interrupcionesOn = true;
+
+unsigned long millis(){ return (unsigned long)(reloj / 1000); }
+unsigned long micros(){ return (unsigned long)reloj; }
+void noInterrupts(){ interrupcionesOn = false; }
+void interrupts();
+void hostDormir(); // WFI (halDormir() de HAL.h con HOST_SIM)
+
+#include "Event_Queue.h"
+#include "Scheduler.h"
+// -----------------------------------------------------------------------------
+
+
+// ------ MODELO ------------------------------------------------------------------
+#define PERIODO_MUESTRA_US      100000  // 10 SPS
+#define COSTE_CHECKS_US         5       // checkAllButtons() + checkBascula() sin nada pendiente
+#define COSTE_MUESTRA_US        30      // Filtrar una muestra
+#define COSTE_ACTIVIDADES_US    10      // doStateActions() sin nada que dibujar
+#define COSTE_SYSTICK_US        1       // ISR del SysTick
+#define COSTE_ISR_US            2       // ISR de botón o de DRDY (sin contar la lectura de los 24 bits)
+
+struct entrada_t {
+    unsigned long long  tiempo;     // us
+    bool                esBoton;    // Pulsación o muestra de la báscula
+    bool                esCambio;   // Muestra que termina en un cambio de peso estable
+};
+
+std::vector<entrada_t>  entradas;
+size_t                  siguienteEntrada = 0;
+unsigned long long      costePantallaUs = 40000;
+
+colaEventos_t           colaEntradas;           // Pulsaciones y muestras, como colaMain y el buffer del sampler
+
+std::vector<double>     latencias;              // ms
+// -----------------------------------------------------------------------------
+
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Genera las entradas de toda la simulación (misma secuencia para los dos loops).
+ */
+/*-----------------------------------------------------------------------------*/
+void generarEntradas(double segundos)
+{
+    srand(42);
+    unsigned long long fin = (unsigned long long)(segundos * 1e6);
+
+    // Pulsaciones: proceso de Poisson de media 2 seg
+    double t = 0;
+    while(true)
+    {
+        t += -log(1.0 - (rand() + 0.5) / ((double)RAND_MAX + 1.0)) * 2e6;
+        if(t >= fin) break;
+        entradas.push_back({ (unsigned long long)t, true, false });
+    }
+
+    // Muestras de la báscula cada 100 ms, desfasadas del SysTick. 1 de cada 50 es un cambio de peso
+    for(unsigned long long m = 37; m < fin; m += PERIODO_MUESTRA_US)
+        entradas.push_back({ m, false, (rand() % 50) == 0 });
+
+    std::sort(entradas.begin(), entradas.end(), [](const entrada_t &a, const entrada_t &b){ return a.tiempo < b.tiempo; });
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Ejecuta las "ISR" de las entradas que ya han llegado. La del SysTick solo cuesta tiempo.
+ */
+/*-----------------------------------------------------------------------------*/
+void atenderISR()
+{
+    while((siguienteEntrada < entradas.size()) and (entradas[siguienteEntrada].tiempo <= reloj))
+    {
+        const entrada_t &e = entradas[siguienteEntrada++];
+        // El 'tiempo' de la cola se guarda en ms en el sketch; aquí en us para medir la latencia con precisión
+        byte codigo = e.esBoton ? 0 : (e.esCambio ? 2 : 1);
+        pushCola(colaEntradas, codigo, (unsigned long)e.tiempo);
+        postTarea(e.esBoton ? TAREA_BOTONES : TAREA_BASCULA);
+        reloj += COSTE_ISR_US;
+    }
+}
+
+void interrupts(){ interrupcionesOn = true; atenderISR(); }
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Avanza el reloj virtual ejecutando trabajo del loop. Las ISR que lleguen mientras
+ *        tanto se atienden en su momento.
+ */
+/*-----------------------------------------------------------------------------*/
+void trabajar(unsigned long long us)
+{
+    unsigned long long fin = reloj + us;
+    while(reloj < fin)
+    {
+        unsigned long long paso = fin - reloj;
+        if(siguienteEntrada < entradas.size() and entradas[siguienteEntrada].tiempo < fin)
+            paso = (entradas[siguienteEntrada].tiempo > reloj) ? entradas[siguienteEntrada].tiempo - reloj : 0;
+        reloj += paso;
+        if(interrupcionesOn) atenderISR();
+    }
+}
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief WFI: el núcleo duerme hasta la siguiente interrupción (entrada o SysTick de 1 ms).
+ */
+/*-----------------------------------------------------------------------------*/
+void hostDormir()
+{
+    unsigned long long systick = (reloj / 1000 + 1) * 1000;
+    unsigned long long despertar = systick;
+    if((siguienteEntrada < entradas.size()) and (entradas[siguienteEntrada].tiempo < despertar))
+        despertar = std::max(entradas[siguienteEntrada].tiempo, reloj);
+    reloj = despertar;
+    if(despertar == systick) reloj += COSTE_SYSTICK_US;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Saca las entradas pendientes (checkAllButtons() + checkBascula()).
+ * @return Número de eventos (pulsaciones o cambios de peso) encontrados. 'tiempoEventos' recibe sus tiempos.
+ */
+/*-----------------------------------------------------------------------------*/
+int sacarEntradas(std::vector<unsigned long long> &tiempoEventos)
+{
+    int eventos = 0;
+    eventoCola_t e;
+    trabajar(COSTE_CHECKS_US);
+    while(popCola(colaEntradas, e))
+    {
+        if(e.codigo != 0) trabajar(COSTE_MUESTRA_US);
+        if(e.codigo != 1){ tiempoEventos.push_back(e.tiempo); eventos++; }
+    }
+    return eventos;
+}
+
+void registrar(const std::vector<unsigned long long> &tiempoEventos)
+{
+    for(unsigned long long t : tiempoEventos) latencias.push_back((reloj - t) / 1000.0);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Loop antiguo: espera activa hasta que pasan 'period' ms y en cada ciclo hace las
+ *        actividades del estado (dibuja si hubo transición en el ciclo anterior), comprueba
+ *        las entradas y evalúa los eventos.
+ * @return Porcentaje del tiempo dando vueltas sin hacer nada
+ */
+/*-----------------------------------------------------------------------------*/
+double loopAntiguo(unsigned long long fin)
+{
+    const unsigned long period = 50;
+    unsigned long prevMillis = 0;
+    std::vector<unsigned long long> pendientesDibujar;
+    unsigned long long tiempoVueltas = 0;
+
+    while(reloj < fin)
+    {
+        if(millis() - prevMillis > period)
+        {
+            prevMillis = millis();
+
+            // doStateActions(): el estado al que se pasó en el ciclo anterior dibuja ahora su pantalla
+            if(!pendientesDibujar.empty()){ trabajar(costePantallaUs); registrar(pendientesDibujar); pendientesDibujar.clear(); }
+            else trabajar(COSTE_ACTIVIDADES_US);
+
+            std::vector<unsigned long long> tiempos;
+            if(sacarEntradas(tiempos) > 0)
+            {
+                // Varios eventos en el mismo ciclo: los intermedios dibujan ya entre medias (Event_Queue.h)
+                for(size_t i = 0; i + 1 < tiempos.size(); i++){ trabajar(costePantallaUs); latencias.push_back((reloj - tiempos[i]) / 1000.0); }
+                pendientesDibujar.push_back(tiempos.back());
+            }
+        }
+        else // Dar vueltas hasta que millis() supere el periodo (las ISR se siguen atendiendo)
+        {
+            unsigned long long hasta = (unsigned long long)(prevMillis + period + 1) * 1000;
+            tiempoVueltas += hasta - reloj;
+            trabajar(hasta - reloj);
+        }
+    }
+    return 100.0 * tiempoVueltas / fin;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Loop nuevo (mismo orden que smartcloth_v2.ino): esperarTareas(), actividades periódicas
+ *        con TAREA_ACTIVIDADES, comprobar entradas, evaluar eventos y, si hay transición,
+ *        dibujar la pantalla del nuevo estado en el momento.
+ * @return Porcentaje del tiempo dormido (CPU libre)
+ */
+/*-----------------------------------------------------------------------------*/
+double loopNuevo(unsigned long long fin)
+{
+    inicioVentanaCPU = micros();
+    tiempoDormido = 0;
+
+    while(reloj < fin)
+    {
+        byte tareas = esperarTareas();
+        if(tareas & TAREA_ACTIVIDADES) trabajar(COSTE_ACTIVIDADES_US);
+
+        std::vector<unsigned long long> tiempos;
+        int eventos = sacarEntradas(tiempos);
+        for(int i = 0; i < eventos; i++) // Cada transición dibuja su pantalla antes de la siguiente
+        {
+            trabajar(costePantallaUs);
+            latencias.push_back((reloj - tiempos[i]) / 1000.0);
+        }
+    }
+    return 100.0 * tiempoDormido / (micros() - inicioVentanaCPU);
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra media, percentil 95 y máximo de las latencias y las reinicia.
+ */
+/*-----------------------------------------------------------------------------*/
+void printLatencias(const char *nombre, double cpu, const char *nombreCpu)
+{
+    std::sort(latencias.begin(), latencias.end());
+    double suma = 0;
+    for(double l : latencias) suma += l;
+    size_t n = latencias.size();
+
+    printf("%-8s  eventos: %5u   latencia media: %6.1f ms   p95: %6.1f ms   max: %6.1f ms   %s: %5.1f %%\n", nombre, (unsigned)n,
+            n ? suma / n : 0.0, n ? latencias[(n * 95) / 100] : 0.0, n ? latencias.back() : 0.0, nombreCpu, cpu);
+    latencias.clear();
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    double segundos = (argc > 1) ? atof(argv[1]) : 600;
+    if(argc > 2) costePantallaUs = (unsigned long long)(atof(argv[2]) * 1000);
+
+    generarEntradas(segundos);
+    unsigned long long fin = (unsigned long long)(segundos * 1e6);
+    printf("Simulados %.0f seg, pantalla de %.1f ms\n", segundos, costePantallaUs / 1000.0);
+
+    reloj = 0; siguienteEntrada = 0;
+    double vueltas = loopAntiguo(fin);
+    printLatencias("Antiguo", vueltas, "espera activa (CPU libre 0 %)");
+
+    reloj = 0; siguienteEntrada = 0;
+    colaEntradas.head = colaEntradas.tail = 0;
+    for(byte i = 0; i < NUM_TEMPORIZADORES; i++) temporizadores[i].ultimo = 0;
+    double libre = loopNuevo(fin);
+    printLatencias("Nuevo", libre, "CPU libre");
+    printf("Despertares por segundo: %.0f\n", nDespertares / segundos);
+
+    return 0;
+}
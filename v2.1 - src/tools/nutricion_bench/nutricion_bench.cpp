@@ -0,0 +1,482 @@
+/**
+ * @file nutricion_bench.cpp
+ * @brief Herramienta de PC que comprueba el redondeo de los valores nutricionales en milésimas y mide
+ *        lo que cuesta sumar una comida con la versión anterior (float) y la actual
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta (con el Arduino.h del simulador):
+ *
+ *      g++ -std=gnu++11 -O2 -DHOST_SIM -DARDUINO=10819 -I../host_sim/hal -I"../../smartcloth_v2" \
+ *          -o nutricion_bench nutricion_bench.cpp ../host_sim/hal/Host.cpp
+ *
+ * Uso:
+ *
+ *      nutricion_bench [dias] [repeticiones]
+ *
+ * Se generan 'dias' días de comidas al azar (semilla fija) con los grupos de Grupos.h y pesos con un
+ * decimal, como los de la báscula, y se comprueba:
+ *
+ *      1. textoMilesimas() y las raciones con una tabla de casos fijos (empates, negativos, ceros).
+ *      2. Que el texto del CSV (2 decimales) y del dashboard (1 decimal, kcal sin decimales) de cada
+ *         comida coincide con el de la versión en float, salvo en una unidad de la última cifra cuando
+ *         el valor está en un empate (p. ej. 1.235) o muy cerca, que antes dependía del error acumulado
+ *         en float. Se cuentan esas diferencias.
+ *      3. Que borrar un plato deja la comida exactamente como estaba.
+ *      4. Que el acumulado de hoy es el mismo que se obtiene al leer el CSV tras reiniciar
+ *         (updateAcumuladoHoyFromHistoryFile()).
+ *
+ * Devuelve 1 si falla alguna de las cuatro comprobaciones.
+ * Después mide la suma Alimento -> Plato -> Comida -> Diario de todos los días con las dos versiones.
+ * En el PC el float va por hardware y la versión anterior sale igual o más rápida; el tiempo solo sirve
+ * para ver que no se ha añadido trabajo de más. En el Due (sin FPU) cada operación en float o double es
+ * una llamada a la librería de coma flotante por software: la versión anterior hacía 18 round() en
+ * double por alimento (6 en Alimento, Plato y Comida) y la actual, 4 multiplicaciones y 4 conversiones
+ * en float (en Alimento) y el resto con enteros.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <chrono>
+
+#include "Arduino.h"
+#include "Diario.h" // Alimento, Plato, Comida, Diario y ValoresNutricionales actuales
+
+
+/*******************************************************************************
+/*******************************************************************************
+                       VERSIÓN ANTERIOR (FLOAT, POR VALOR)
+/******************************************************************************/
+/******************************************************************************/
+// Lo mismo que hacían las clases antes de guardar los valores en milésimas: siete float, raciones
+// recalculadas en cada set y objetos temporales y copias en cada suma.
+namespace anterior
+{
+    class ValoresNutricionales{
+        float _carb, _lip, _prot, _kcal, _carb_R, _lip_R, _prot_R;
+      public:
+        ValoresNutricionales(){ setValores(0.0, 0.0, 0.0, 0.0); }
+        ValoresNutricionales(float carb, float lip, float prot, float kcal){ setValores(carb, lip, prot, kcal); }
+        void setCarbValores(float carb){ _carb = carb; _carb_R = round(10.0*(_carb/10)); _carb_R = _carb_R/10; }
+        void setLipValores(float lip){ _lip = lip; _lip_R = round(10.0*(_lip/10)); _lip_R = _lip_R/10; }
+        void setProtValores(float prot){ _prot = prot; _prot_R = round(10.0*(_prot/10)); _prot_R = _prot_R/10; }
+        void setKcalValores(float kcal){ _kcal = kcal; }
+        float getCarbValores(){ return _carb; }     float getCarbRaciones(){ return _carb_R; }
+        float getLipValores(){ return _lip; }       float getLipRaciones(){ return _lip_R; }
+        float getProtValores(){ return _prot; }     float getProtRaciones(){ return _prot_R; }
+        float getKcalValores(){ return _kcal; }
+        void setValores(ValoresNutricionales val){ setValores(val.getCarbValores(), val.getLipValores(), val.getProtValores(), val.getKcalValores()); }
+        void setValores(float carb, float lip, float prot, float kcal){ setCarbValores(carb); setLipValores(lip); setProtValores(prot); setKcalValores(kcal); }
+    };
+
+    class Alimento{
+        const Grupo *_grupo; float _peso; ValoresNutricionales _valores;
+      public:
+        Alimento(const Grupo *grupo, float peso) : _grupo(grupo), _peso(peso)
+        {
+            ValoresNutricionales valAux(grupo->Carb_g * peso, grupo->Lip_g * peso, grupo->Prot_g * peso, grupo->Kcal_g * peso);
+            _valores.setValores(valAux);
+        }
+        float getPesoAlimento(){ return _peso; }
+        ValoresNutricionales getValoresAlimento(){ return _valores; }
+    };
+
+    class Plato{
+        byte _n; float _peso; ValoresNutricionales _valores;
+      public:
+        Plato() : _n(0), _peso(0.0) {}
+        void addAlimentoPlato(Alimento alimento)
+        {
+            _n++; _peso += alimento.getPesoAlimento();
+            ValoresNutricionales val = alimento.getValoresAlimento();
+            ValoresNutricionales valAux(_valores.getCarbValores() + val.getCarbValores(), _valores.getLipValores() + val.getLipValores(),
+                                        _valores.getProtValores() + val.getProtValores(), _valores.getKcalValores() + val.getKcalValores());
+            _valores.setValores(valAux);
+        }
+        float getPesoPlato(){ return _peso; }
+        ValoresNutricionales getValoresPlato(){ return _valores; }
+        void restorePlato(){ _n = 0; _peso = 0.0; ValoresNutricionales valAux(0.0, 0.0, 0.0, 0.0); _valores.setValores(valAux); }
+    };
+
+    class Comida{
+        byte _nPlatos; float _peso; ValoresNutricionales _valores;
+        void updateValoresComida(bool suma, ValoresNutricionales val)
+        {
+            float s = suma ? 1.0 : -1.0;
+            ValoresNutricionales valAux(_valores.getCarbValores() + s*val.getCarbValores(), _valores.getLipValores() + s*val.getLipValores(),
+                                        _valores.getProtValores() + s*val.getProtValores(), _valores.getKcalValores() + s*val.getKcalValores());
+            _valores.setValores(valAux);
+        }
+      public:
+        Comida() : _nPlatos(1), _peso(0.0) {}
+        void addAlimentoComida(Alimento &alimento){ _peso += alimento.getPesoAlimento(); updateValoresComida(true, alimento.getValoresAlimento()); }
+        void addPlato(Plato /*plato*/){ _nPlatos++; }
+        void deletePlato(Plato &plato){ _peso -= plato.getPesoPlato(); updateValoresComida(false, plato.getValoresPlato()); }
+        float getPesoComida(){ return _peso; }
+        ValoresNutricionales getValoresComida(){ return _valores; }
+        void restoreComida(){ _nPlatos = 0; _peso = 0.0; ValoresNutricionales valAux; _valores.setValores(valAux); }
+    };
+
+    class Diario{
+        byte _n; float _peso; ValoresNutricionales _valores;
+      public:
+        Diario() : _n(0), _peso(0.0) {}
+        void addComida(Comida comida)
+        {
+            _n++; _peso += comida.getPesoComida();
+            ValoresNutricionales val = comida.getValoresComida();
+            ValoresNutricionales valAux(_valores.getCarbValores() + val.getCarbValores(), _valores.getLipValores() + val.getLipValores(),
+                                        _valores.getProtValores() + val.getProtValores(), _valores.getKcalValores() + val.getKcalValores());
+            _valores.setValores(valAux);
+        }
+        ValoresNutricionales getValoresDiario(){ return _valores; }
+    };
+}
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                            COMIDAS DE PRUEBA
+/******************************************************************************/
+/******************************************************************************/
+typedef struct {
+    byte    posGrupo;       // Posición en gruposAlimentos
+    float   peso;           // Con 1 decimal, como el de la báscula
+    bool    borrarPlato;    // Tras este alimento se borra el plato (botón 'borrar')
+    bool    finPlato;       // Tras este alimento se añade el plato (botón 'añadir')
+} paso_t;
+
+typedef std::vector<paso_t> comidaPrueba_t;
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Genera 'dias' días de 3 a 5 comidas de 1 a 3 platos con 1 a 5 alimentos. Uno de cada
+ *        diez platos se borra al terminarlo.
+ */
+/*-----------------------------------------------------------------------------*/
+std::vector< std::vector<comidaPrueba_t> > generarDias(unsigned dias)
+{
+    srand(2024);
+    std::vector< std::vector<comidaPrueba_t> > resultado(dias);
+
+    for(unsigned d = 0; d < dias; d++)
+    {
+        unsigned nComidas = 3 + rand() % 3;
+        for(unsigned c = 0; c < nComidas; c++)
+        {
+            comidaPrueba_t comida;
+            unsigned nPlatos = 1 + rand() % 3;
+            for(unsigned p = 0; p < nPlatos; p++)
+            {
+                unsigned nAlimentos = 1 + rand() % 5;
+                bool borrar = (rand() % 10) == 0;
+                for(unsigned a = 0; a < nAlimentos; a++)
+                {
+                    paso_t paso;
+                    paso.posGrupo = rand() % NUM_GRUPOS;
+                    paso.peso = (1 + rand() % 5000) / 10.0f;      // 0.1 g a 500.0 g
+                    paso.borrarPlato = borrar and (a == nAlimentos - 1);
+                    paso.finPlato = !borrar and (a == nAlimentos - 1);
+                    comida.push_back(paso);
+                }
+            }
+            resultado[d].push_back(comida);
+        }
+    }
+    return resultado;
+}
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*******************************************************************************
+/*******************************************************************************
+                         TEXTO COMO ANTES (FLOAT)
+/******************************************************************************/
+/******************************************************************************/
+// CSV: String(float) del Due (dtostrf) == "%.*f"
+std::string textoCSV(float v){ char t[32]; snprintf(t, sizeof(t), "%.2f", v); return t; }
+
+// Dashboard: Print::printFloat() de Arduino (suma 0.5 en la última cifra y trunca)
+std::string textoDashboard(double v, byte decimales)
+{
+    std::string t;
+    if(v < 0.0){ t += '-'; v = -v; }
+    double redondeo = 0.5;
+    for(byte i = 0; i < decimales; i++) redondeo /= 10.0;
+    v += redondeo;
+    unsigned long entero = (unsigned long)v;
+    t += std::to_string(entero);
+    double resto = v - (double)entero;
+    if(decimales > 0) t += '.';
+    while(decimales-- > 0){ resto *= 10.0; int cifra = (int)resto; t += (char)('0' + cifra); resto -= cifra; }
+    return t;
+}
+
+// Lo que lee el dashboard de unos valores: los cuatro valores (ahora en milésimas, para textoMilesimas())
+// y las tres raciones
+float leerValores(anterior::ValoresNutricionales v)
+{
+    return v.getCarbValores() + v.getLipValores() + v.getProtValores() + v.getKcalValores() + v.getCarbRaciones() + v.getLipRaciones() + v.getProtRaciones();
+}
+
+float leerValores(const ValoresNutricionales &v)
+{
+    return (v.getCarbMilesimas() ^ v.getLipMilesimas() ^ v.getProtMilesimas() ^ v.getKcalMilesimas()) + v.getCarbRaciones() + v.getLipRaciones() + v.getProtRaciones();
+}
+
+std::string textoActual(milesimas_t v, byte decimales){ char t[LONGITUD_TEXTO_MILESIMAS]; return textoMilesimas(t, v, decimales); }
+
+
+// Un texto distinto del de float solo puede serlo en una unidad de la última cifra: cuando el valor está
+// justo a mitad entre dos (empate exacto en milésimas, p. ej. 1.235 con 2 decimales), o muy cerca, y el
+// float acumulado y la suma de alimentos redondeados a mg quedan a lados distintos
+void compararUltimaCifra(milesimas_t v, const std::string &nuevo, const std::string &viejo, byte decimales, unsigned &empates, unsigned &grandes)
+{
+    int32_t d = divisorDecimales[decimales];
+    if((labs(v) % d) == (d / 2)) empates++;
+    if(labs(lround((atof(nuevo.c_str()) - atof(viejo.c_str())) * pow(10, decimales))) > 1) grandes++;
+}
+/******************************************************************************/
+/******************************************************************************/
+
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Casos fijos de textoMilesimas() y de las raciones.
+ * @return Número de casos que fallan
+ */
+/*-----------------------------------------------------------------------------*/
+unsigned comprobarCasosFijos()
+{
+    struct { milesimas_t v; byte dec; const char *texto; } casos[] = {
+        {1235, 2, "1.24"},  {1234, 2, "1.23"},  {-1235, 2, "-1.24"},  {-4, 2, "0.00"},  {5, 2, "0.01"},
+        {0, 2, "0.00"},     {0, 0, "0"},        {499500, 0, "500"},   {499499, 0, "499"}, {50, 1, "0.1"},
+        {49, 1, "0.0"},     {123456789, 2, "123456.79"},              {7, 3, "0.007"},    {-999, 1, "-1.0"},
+    };
+    struct { milesimas_t mg; float raciones; } raciones[] = {
+        {14499, 1.4}, {14500, 1.5}, {14999, 1.5}, {500, 0.1}, {499, 0.0}, {-500, -0.1}, {123456, 12.3},
+    };
+
+    unsigned fallos = 0;
+    for(auto &c : casos)
+    {
+        std::string t = textoActual(c.v, c.dec);
+        if(t != c.texto){ printf("  textoMilesimas(%d, %u) = \"%s\" (esperado \"%s\")\n", c.v, c.dec, t.c_str(), c.texto); fallos++; }
+    }
+    for(auto &r : raciones)
+    {
+        ValoresNutricionales v;
+        v.setValoresMilesimas(r.mg, r.mg, r.mg, 0);
+        if((v.getCarbRaciones() != r.raciones) or (v.getLipRaciones() != r.raciones) or (v.getProtRaciones() != r.raciones))
+        {
+            printf("  Raciones de %d mg = %.1f (esperado %.1f)\n", r.mg, v.getCarbRaciones(), r.raciones);
+            fallos++;
+        }
+    }
+    return fallos;
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    unsigned dias = (argc > 1) ? atoi(argv[1]) : 365;
+    unsigned repeticiones = (argc > 2) ? atoi(argv[2]) : 20;
+
+    std::vector< std::vector<comidaPrueba_t> > comidas = generarDias(dias);
+    unsigned nComidas = 0, nAlimentos = 0;
+    for(auto &dia : comidas) for(auto &c : dia){ nComidas++; nAlimentos += c.size(); }
+    printf("%u dias, %u comidas, %u alimentos\n\n", dias, nComidas, nAlimentos);
+
+
+    // ----- 1. CASOS FIJOS -----
+    unsigned fallosFijos = comprobarCasosFijos();
+    printf("Casos fijos de texto y raciones: %s\n", fallosFijos ? "FALLAN" : "OK");
+
+
+    // ----- 2, 3 y 4. COMIDAS -----
+    unsigned camposCSV = 0, difCSV = 0, difDashboard = 0, difRaciones = 0, difEmpate = 0, difGrandes = 0;
+    unsigned borradosExactos = 0, borradosExactosAntes = 0, nBorrados = 0;
+    unsigned acumuladoIgual = 0, acumuladoIgualAntes = 0;
+
+    for(auto &dia : comidas)
+    {
+        Diario diario;
+        anterior::Diario diarioAntes;
+        milesimas_t csv[4] = { 0, 0, 0, 0 };      // Como updateAcumuladoHoyFromHistoryFile()
+        float csvAntes[4] = { 0, 0, 0, 0 };
+
+        for(auto &c : dia)
+        {
+            Comida comida;
+            Plato plato;
+            anterior::Comida comidaAntes;
+            anterior::Plato platoAntes;
+            ValoresNutricionales antesDelPlato;
+            anterior::ValoresNutricionales antesDelPlatoAntes;
+
+            for(auto &paso : c)
+            {
+                const Grupo *grupo = &gruposAlimentos[paso.posGrupo];
+
+                Alimento alimento(grupo, paso.peso);
+                plato.addAlimentoPlato(alimento);
+                comida.addAlimentoComida(alimento);
+
+                anterior::Alimento alimentoAntes(grupo, paso.peso);
+                platoAntes.addAlimentoPlato(alimentoAntes);
+                comidaAntes.addAlimentoComida(alimentoAntes);
+
+                if(paso.borrarPlato)
+                {
+                    comida.deletePlato(plato);
+                    comidaAntes.deletePlato(platoAntes);
+                    nBorrados++;
+
+                    const ValoresNutricionales &v = comida.getValoresComida();
+                    if((v.getCarbMilesimas() == antesDelPlato.getCarbMilesimas()) and (v.getLipMilesimas() == antesDelPlato.getLipMilesimas()) and
+                       (v.getProtMilesimas() == antesDelPlato.getProtMilesimas()) and (v.getKcalMilesimas() == antesDelPlato.getKcalMilesimas())) borradosExactos++;
+
+                    anterior::ValoresNutricionales va = comidaAntes.getValoresComida();
+                    if((va.getCarbValores() == antesDelPlatoAntes.getCarbValores()) and (va.getLipValores() == antesDelPlatoAntes.getLipValores()) and
+                       (va.getProtValores() == antesDelPlatoAntes.getProtValores()) and (va.getKcalValores() == antesDelPlatoAntes.getKcalValores())) borradosExactosAntes++;
+                }
+                if(paso.finPlato){ comida.addPlato(plato); comidaAntes.addPlato(platoAntes); }
+                if(paso.borrarPlato or paso.finPlato)
+                {
+                    plato.restorePlato();
+                    platoAntes.restorePlato();
+                    antesDelPlato = comida.getValoresComida();
+                    antesDelPlatoAntes = comidaAntes.getValoresComida();
+                }
+            }
+
+            // Texto del CSV y del dashboard de la comida guardada
+            const ValoresNutricionales &v = comida.getValoresComida();
+            anterior::ValoresNutricionales va = comidaAntes.getValoresComida();
+            milesimas_t m[4] = { v.getCarbMilesimas(), v.getLipMilesimas(), v.getProtMilesimas(), v.getKcalMilesimas() };
+            float f[4] = { va.getCarbValores(), va.getLipValores(), va.getProtValores(), va.getKcalValores() };
+
+            for(byte i = 0; i < 4; i++)
+            {
+                std::string nuevo = textoActual(m[i], DECIMALES_CSV), viejo = textoCSV(f[i]);
+                camposCSV++;
+                if(nuevo != viejo){ difCSV++; compararUltimaCifra(m[i], nuevo, viejo, DECIMALES_CSV, difEmpate, difGrandes); }
+
+                byte dec = (i == 3) ? 0 : DECIMALES_DASHBOARD;
+                nuevo = textoActual(m[i], dec); viejo = textoDashboard(f[i], dec);
+                if(nuevo != viejo){ difDashboard++; compararUltimaCifra(m[i], nuevo, viejo, dec, difEmpate, difGrandes); }
+
+                // Lo que se leerá del CSV al reiniciar
+                csv[i] += leerMilesimas(textoActual(m[i], DECIMALES_CSV).c_str());
+                csvAntes[i] += atof(textoCSV(f[i]).c_str());
+            }
+            if((v.getCarbRaciones() != va.getCarbRaciones()) or (v.getLipRaciones() != va.getLipRaciones()) or (v.getProtRaciones() != va.getProtRaciones())) difRaciones++;
+
+            diario.addComida(comida);
+            diarioAntes.addComida(comidaAntes);
+        }
+
+        // Acumulado de hoy en la sesión frente al leído del CSV tras reiniciar
+        const ValoresNutricionales &d = diario.getValoresDiario();
+        if((d.getCarbMilesimas() == csv[0]) and (d.getLipMilesimas() == csv[1]) and (d.getProtMilesimas() == csv[2]) and (d.getKcalMilesimas() == csv[3])) acumuladoIgual++;
+
+        anterior::ValoresNutricionales da = diarioAntes.getValoresDiario();
+        if((textoCSV(da.getCarbValores()) == textoCSV(csvAntes[0])) and (textoCSV(da.getLipValores()) == textoCSV(csvAntes[1])) and
+           (textoCSV(da.getProtValores()) == textoCSV(csvAntes[2])) and (textoCSV(da.getKcalValores()) == textoCSV(csvAntes[3]))) acumuladoIgualAntes++;
+    }
+
+    printf("Texto de las comidas frente a la version en float (%u campos):\n", camposCSV);
+    printf("  CSV:        %u distintos\n", difCSV);
+    printf("  Dashboard:  %u distintos\n", difDashboard);
+    printf("  Raciones:   %u comidas distintas\n", difRaciones);
+    printf("  De ellos, empates exactos en milesimas: %u\n", difEmpate);
+    printf("  Mas de 1 en la ultima cifra: %u\n", difGrandes);
+    printf("Plato borrado, comida exactamente como antes: %u de %u (float: %u)\n", borradosExactos, nBorrados, borradosExactosAntes);
+    printf("Acumulado de hoy igual al leido del CSV tras reiniciar: %u de %u dias (float, a 2 decimales: %u)\n\n", acumuladoIgual, dias, acumuladoIgualAntes);
+
+    bool ok = (fallosFijos == 0) and (difGrandes == 0) and (borradosExactos == nBorrados) and (acumuladoIgual == dias);
+
+
+    // ----- BENCHMARK -----
+    // La suma Alimento -> Plato -> Comida -> Diario (sin texto), como en la máquina de estados, leyendo
+    // tras cada alimento los valores y raciones de la comida, como el dashboard
+    volatile float sumidero = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(unsigned r = 0; r < repeticiones; r++)
+    {
+        for(auto &dia : comidas)
+        {
+            anterior::Diario diario;
+            for(auto &c : dia)
+            {
+                anterior::Comida comida;
+                anterior::Plato plato;
+                for(auto &paso : c)
+                {
+                    anterior::Alimento alimento(&gruposAlimentos[paso.posGrupo], paso.peso);
+                    plato.addAlimentoPlato(alimento);
+                    comida.addAlimentoComida(alimento);
+                    if(paso.borrarPlato) comida.deletePlato(plato);
+                    if(paso.finPlato) comida.addPlato(plato);
+                    if(paso.borrarPlato or paso.finPlato) plato.restorePlato();
+                    sumidero = sumidero + leerValores(comida.getValoresComida());
+                }
+                diario.addComida(comida);
+            }
+            sumidero = sumidero + leerValores(diario.getValoresDiario());
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(unsigned r = 0; r < repeticiones; r++)
+    {
+        for(auto &dia : comidas)
+        {
+            Diario diario;
+            for(auto &c : dia)
+            {
+                Comida comida;
+                Plato plato;
+                for(auto &paso : c)
+                {
+                    Alimento alimento(&gruposAlimentos[paso.posGrupo], paso.peso);
+                    plato.addAlimentoPlato(alimento);
+                    comida.addAlimentoComida(alimento);
+                    if(paso.borrarPlato) comida.deletePlato(plato);
+                    if(paso.finPlato) comida.addPlato(plato);
+                    if(paso.borrarPlato or paso.finPlato) plato.restorePlato();
+                    sumidero = sumidero + leerValores(comida.getValoresComida());
+                }
+                diario.addComida(comida);
+            }
+            sumidero = sumidero + leerValores(diario.getValoresDiario());
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double total = (double)nAlimentos * repeticiones;
+    double nsAntes = std::chrono::duration<double, std::nano>(t1 - t0).count() / total;
+    double nsAhora = std::chrono::duration<double, std::nano>(t2 - t1).count() / total;
+    printf("Suma de comidas (%u repeticiones):\n", repeticiones);
+    printf("  float, por valor:     %6.1f ns por alimento (%5.1f M alimentos/s)\n", nsAntes, 1e3 / nsAntes);
+    printf("  milesimas, en sitio:  %6.1f ns por alimento (%5.1f M alimentos/s)\n", nsAhora, 1e3 / nsAhora);
+
+    printf("\n%s\n", ok ? "OK" : "FALLOS");
+    return ok ? 0 : 1;
+}
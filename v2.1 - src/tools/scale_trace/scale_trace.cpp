@@ -0,0 +1,512 @@
+/**
+ * @file scale_trace.cpp
+ * @brief Herramienta de PC para leer y reproducir la traza binaria de la báscula (Scale_Trace.h)
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta:
+ *
+ *      g++ -std=c++11 -O2 -I"../../smartcloth_v2" -o scale_trace scale_trace.cpp
+ *
+ * Uso (con el fichero data/scale.trc copiado de la SD):
+ *
+ *      scale_trace decode scale.trc        --> Muestra todos los registros en orden
+ *      scale_trace replay scale.trc        --> Vuelve a pasar las muestras brutas por el filtro y el
+ *                                              clasificador del sketch y compara los cambios de peso
+ *                                              obtenidos con los eventos grabados
+ *      scale_trace csv scale.trc           --> Muestras en CSV (tiempo, raw, gramos, estable) para graficar
+ *      scale_trace bench [repeticiones]    --> Reproduce una traza sintética (pesos conocidos, ruido, golpes
+ *                                              y oscilación del plato) y mide la latencia de los eventos,
+ *                                              los eventos falsos y el coste por muestra del filtro
+ *
+ * El filtro (Scale_Filter.h) y el clasificador (Scale_Classifier.h) se incluyen directamente
+ * del sketch, así que al cambiar sus #define basta con recompilar la herramienta y volver a
+ * reproducir la misma traza para ver si desaparece un evento fantasma.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h> // __rdtsc()
+#endif
+
+using std::abs;
+
+
+// ------ ENTORNO MÍNIMO DEL SKETCH ---------------------------------------------
+#define DEBUG_H // No incluir debug.h (SerialPC)
+
+typedef uint8_t byte;
+
+class HX711 { // Solo lo que usa el filtro: offset y escala
+public:
+    long    get_offset(){ return offset; }
+    void    set_offset(long o){ offset = o; }
+    float   get_scale(){ return factor; }
+    void    set_scale(float f){ factor = f; }
+private:
+    long    offset = 0;
+    float   factor = 1.0;
+};
+
+HX711 scale;
+
+#include "Scale_Filter.h"
+#include "Scale_Classifier.h"
+// -----------------------------------------------------------------------------
+
+
+// ------ FORMATO DEL FICHERO (igual que Scale_Trace.h) -----------------------
+#define TRAZA_MAGIC         0x52544353
+#define TRAZA_VERSION       1
+#define TRAZA_TAM_SECTOR    512
+
+#define TRAZA_MUESTRA       1
+#define TRAZA_EVENTO        2
+#define TRAZA_TARA          3
+
+typedef struct __attribute__((packed)) {
+    uint32_t  tiempo;
+    int32_t   raw;
+    int32_t   valor;
+    uint8_t   tipo;
+    uint8_t   dato;
+    uint16_t  evento;
+} registroTraza_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t  magic;
+    uint16_t  version;
+    uint16_t  tamRegistro;
+    uint32_t  nSectores;
+    uint32_t  sectorSiguiente;
+    uint32_t  vueltas;
+    uint32_t  sesiones;
+} cabeceraTraza_t;
+// -----------------------------------------------------------------------------
+
+// Mismo orden que 'event_t' en State_Machine.h (solo los eventos de la báscula)
+const char *nombreEvento(uint16_t evento)
+{
+    switch(evento)
+    {
+        case 11: return "INCREMENTO";
+        case 12: return "DECREMENTO";
+        case 13: return "TARAR";
+        case 14: return "LIBERAR";
+        default: return "OTRO";
+    }
+}
+
+const char *nombreCambio(int cambio)
+{
+    switch(cambio)
+    {
+        case CAMBIO_NINGUNO:        return "NINGUNO";
+        case CAMBIO_INCREMENTO:     return "INCREMENTO";
+        case CAMBIO_DECREMENTO:     return "DECREMENTO";
+        case CAMBIO_LIBERAR:        return "LIBERAR";
+        case CAMBIO_SIN_CLASIFICAR: return "SIN_CLASIFICAR";
+        default:                    return "?";
+    }
+}
+
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee la traza y devuelve sus registros del más antiguo al más reciente.
+ * @return 'false' si el fichero no existe o no es una traza válida
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerTraza(const char *ruta, cabeceraTraza_t &cabecera, std::vector<registroTraza_t> &registros)
+{
+    FILE *f = fopen(ruta, "rb");
+    if(!f){ fprintf(stderr, "No se puede abrir %s\n", ruta); return false; }
+
+    if((fread(&cabecera, sizeof(cabecera), 1, f) != 1) or (cabecera.magic != TRAZA_MAGIC)
+        or (cabecera.version != TRAZA_VERSION) or (cabecera.tamRegistro != sizeof(registroTraza_t)))
+    {
+        fprintf(stderr, "%s no es una traza de la bascula (version %d)\n", ruta, TRAZA_VERSION);
+        fclose(f);
+        return false;
+    }
+
+    // Si ya se ha dado la vuelta, lo más antiguo empieza en el sector siguiente al último escrito
+    uint32_t primero = cabecera.vueltas ? cabecera.sectorSiguiente : 0;
+    uint32_t nSectores = cabecera.vueltas ? cabecera.nSectores : cabecera.sectorSiguiente;
+    const size_t regPorSector = TRAZA_TAM_SECTOR / sizeof(registroTraza_t);
+
+    registroTraza_t sector[TRAZA_TAM_SECTOR / sizeof(registroTraza_t)];
+    for(uint32_t i = 0; i < nSectores; i++)
+    {
+        uint32_t s = (primero + i) % cabecera.nSectores;
+        fseek(f, (long)(s + 1) * TRAZA_TAM_SECTOR, SEEK_SET);
+        if(fread(sector, TRAZA_TAM_SECTOR, 1, f) != 1) break;
+        for(size_t r = 0; r < regPorSector; r++) if(sector[r].tipo != 0) registros.push_back(sector[r]);
+    }
+
+    fclose(f);
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestra todos los registros.
+ */
+/*-----------------------------------------------------------------------------*/
+void decode(const std::vector<registroTraza_t> &registros)
+{
+    for(const registroTraza_t &r : registros)
+    {
+        switch(r.tipo)
+        {
+            case TRAZA_MUESTRA:
+                printf("%10u  MUESTRA  raw=%9d  peso=%9.3f g  %s\n", r.tiempo, r.raw, r.valor / 1000.0, r.dato ? "estable" : "");
+                break;
+            case TRAZA_EVENTO:
+                printf("%10u  EVENTO   %-10s (%s)  filtro=%9d  pesoARetirar=%.3f g\n", r.tiempo, nombreEvento(r.evento),
+                        nombreCambio(r.dato), r.raw, r.valor / 1000.0);
+                break;
+            case TRAZA_TARA:
+                printf("%10u  TARA     offset=%9d  factor=%.3f\n", r.tiempo, r.raw, r.valor / 1000.0);
+                break;
+            default:
+                printf("%10u  ? tipo %u\n", r.tiempo, r.tipo);
+        }
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Muestras en CSV para graficar.
+ */
+/*-----------------------------------------------------------------------------*/
+void csv(const std::vector<registroTraza_t> &registros)
+{
+    printf("tiempo,raw,peso,estable\n");
+    for(const registroTraza_t &r : registros)
+    {
+        if(r.tipo == TRAZA_MUESTRA) printf("%u,%d,%.3f,%u\n", r.tiempo, r.raw, r.valor / 1000.0, r.dato);
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Reproduce la parte de checkBascula() que decide los eventos: filtro, detector de
+ *        estabilidad y clasificador, con la tara y el factor grabados en los registros TARA.
+ *
+ * El 'pesoARetirar' depende de la máquina de estados, así que se toma del evento grabado
+ * más cercano. Cada cambio reproducido se compara con el evento grabado de la misma muestra.
+ *
+ * @return Número de diferencias entre los cambios reproducidos y los eventos grabados
+ */
+/*-----------------------------------------------------------------------------*/
+int replay(const std::vector<registroTraza_t> &registros)
+{
+    float newWeight = 0.0, lastWeight = 0.0;
+    float pesoARetirar = 0.0;
+    uint32_t tiempoAnterior = 0;
+    int diferencias = 0, cambios = 0, eventos = 0;
+
+    for(size_t i = 0; i < registros.size(); i++)
+    {
+        const registroTraza_t &r = registros[i];
+
+        bool nuevaSesion = (i == 0) or (r.tiempo < tiempoAnterior); // millis() vuelve a empezar al arrancar
+        if(nuevaSesion) printf("%10u  --- nueva sesion ---\n", r.tiempo);
+        tiempoAnterior = r.tiempo;
+
+        if(r.tipo == TRAZA_TARA) // El primer registro de cada sesión es la calibración de setupScale()
+        {
+            scale.set_scale(r.valor / 1000.0f);
+            scale.set_offset(r.raw);
+            if(nuevaSesion) setupFiltroPeso();
+            newWeight = (salidaFiltro - scale.get_offset()) / scale.get_scale();
+            continue;
+        }
+
+        if(r.tipo == TRAZA_EVENTO){ eventos++; pesoARetirar = r.valor / 1000.0; continue; }
+
+        bool estable = filtrarMuestra(r.raw);
+        if(!estable) continue;
+
+        float actualWeight = (salidaFiltro - scale.get_offset()) / scale.get_scale();
+
+        // Evento grabado justo tras esta muestra (si lo hay): aporta el 'pesoARetirar' de ese momento
+        const registroTraza_t *grabado = nullptr;
+        if((i + 1 < registros.size()) and (registros[i+1].tipo == TRAZA_EVENTO)) grabado = &registros[i+1];
+        if(grabado) pesoARetirar = grabado->valor / 1000.0;
+
+        lastWeight = newWeight;
+        newWeight = actualWeight;
+        cambio_peso_t cambio = clasificarCambioPeso(lastWeight, newWeight, pesoARetirar);
+
+        if(cambio != CAMBIO_NINGUNO)
+        {
+            cambios++;
+            printf("%10u  %-14s  %9.3f -> %9.3f g", r.tiempo, nombreCambio(cambio), lastWeight, newWeight);
+            if(!grabado){ printf("   <-- no grabado\n"); diferencias++; }
+            else if(grabado->dato != cambio){ printf("   <-- grabado %s\n", nombreCambio(grabado->dato)); diferencias++; }
+            else printf("\n");
+        }
+        else if(grabado)
+        {
+            printf("%10u  (ninguno)       grabado %s   <-- no reproducido\n", r.tiempo, nombreCambio(grabado->dato));
+            diferencias++;
+        }
+    }
+
+    printf("\nEventos grabados: %d   Cambios reproducidos: %d   Diferencias: %d\n", eventos, cambios, diferencias);
+    return diferencias;
+}
+
+
+
+
+// ------ BANCO DE PRUEBAS SINTÉTICO ---------------------------------------------
+#define BENCH_OFFSET        400000          // Cuentas con la báscula vacía (como host_sim)
+#define BENCH_FACTOR        1032.6858f      // SCALE_CALIBRATION_FACTOR
+#define BENCH_PERIODO_MS    100             // HX711 a 10 SPS
+#define BENCH_GOLPE_G       40.0f           // Pico de un golpe en la mesa (una sola muestra)
+#define BENCH_OSCILACION    0.05f           // Amplitud de la oscilación del plato al asentarse (fracción del cambio), si se simula
+#define BENCH_OSC_TAU_MS    300.0f          // Constante de tiempo del amortiguamiento
+#define BENCH_OSC_PERIODO   250.0f          // Periodo de la oscilación (ms)
+#define BENCH_REPOSO_MIN    10              // Minutos de báscula quieta al final de cada repetición (falsos por hora)
+
+typedef struct {
+    uint32_t  espera;     // ms desde el cambio anterior
+    float     gramos;     // Peso final
+    uint32_t  rampa;      // ms hasta alcanzarlo (0 = se deja caer)
+    bool      golpe;      // Golpe sin cambio de peso: no debe dar evento
+} cambioBench_t;
+
+// Misma sesión que el guion por defecto de host_sim, más un golpe, un cambio brusco y una retirada parcial
+const cambioBench_t guionBench[] = {
+    { 2000, 300.0f, 400, false },   // Recipiente
+    { 3000, 420.0f, 600, false },   // Alimento
+    { 3000, 420.0f,   0, true  },   // Golpe en la mesa
+    { 3000, 500.0f,   0, false },   // Alimento dejado caer
+    { 3000, 480.0f, 300, false },   // Retirar un poco
+    { 3000,   0.0f, 300, false },   // Retirar todo
+};
+const byte N_CAMBIOS_BENCH = sizeof(guionBench) / sizeof(guionBench[0]);
+
+typedef struct {
+    uint32_t  inicio;     // ms en que empieza el cambio
+    uint32_t  fin;        // ms en que el peso real llega al final (sin contar la oscilación)
+    float     desde, hasta;
+    bool      golpe;
+} cambioReal_t;
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Peso real sobre la báscula en el instante 't' según los cambios del guion.
+ */
+/*-----------------------------------------------------------------------------*/
+float pesoRealBench(const std::vector<cambioReal_t> &cambios, uint32_t t, float amplitudOscilacion)
+{
+    const cambioReal_t *c = nullptr;
+    for(const cambioReal_t &x : cambios){ if(x.inicio <= t) c = &x; else break; }
+    if(!c) return 0.0f;
+
+    if(c->golpe) return c->hasta + (((t - c->inicio) < BENCH_PERIODO_MS) ? BENCH_GOLPE_G : 0.0f);
+    if(t < c->fin) return c->desde + (c->hasta - c->desde) * (float)(t - c->inicio) / (float)(c->fin - c->inicio);
+
+    float dt = (float)(t - c->fin);
+    float oscilacion = amplitudOscilacion * expf(-dt / BENCH_OSC_TAU_MS) * sinf(2.0f * (float)M_PI * dt / BENCH_OSC_PERIODO);
+    return c->hasta + (c->hasta - c->desde) * oscilacion;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Reproduce el guion con ruido gaussiano de 'ruidoG' gramos (y la oscilación del plato
+ *        si 'oscilacion') por el filtro, el detector y el clasificador del sketch, y compara
+ *        los cambios con los pesos reales.
+ *
+ * Cada cambio del guion debe dar exactamente un evento en el mismo sentido entre su inicio
+ * y el del siguiente (un golpe, ninguno). Los demás son eventos falsos; un cambio sin evento
+ * es un evento perdido. La latencia se mide desde que el peso real llega a su valor final.
+ *
+ * @return Eventos falsos + perdidos
+ */
+/*-----------------------------------------------------------------------------*/
+int benchRuido(float ruidoG, bool oscilacion, int repeticiones)
+{
+    std::mt19937 generador(1234);
+    std::normal_distribution<float> ruido(0.0f, ruidoG * BENCH_FACTOR);
+
+    int falsos = 0, perdidos = 0, detectados = 0, falsosReposo = 0;
+    double sumaLatencia = 0.0, maxLatencia = 0.0, maxError = 0.0;
+    unsigned long muestras = 0;
+    double nsFiltro = 0.0;
+    unsigned long long ciclosFiltro = 0;
+
+    for(int rep = 0; rep < repeticiones; rep++)
+    {
+        // Los cambios empiezan en fases distintas respecto a las muestras del HX711
+        std::vector<cambioReal_t> cambios;
+        uint32_t t = 0;
+        float peso = 0.0f;
+        for(byte i = 0; i < N_CAMBIOS_BENCH; i++)
+        {
+            t += guionBench[i].espera + (uint32_t)((rep * 37 + i * 13) % BENCH_PERIODO_MS);
+            cambioReal_t c = { t, t + guionBench[i].rampa, peso, guionBench[i].gramos, guionBench[i].golpe };
+            cambios.push_back(c);
+            peso = guionBench[i].gramos;
+        }
+        uint32_t finGuion = t + 5000;
+        uint32_t finReposo = finGuion + BENCH_REPOSO_MIN * 60000UL;
+
+        scale.set_offset(BENCH_OFFSET);
+        scale.set_scale(BENCH_FACTOR);
+        setupFiltroPeso();
+        float newWeight = 0.0f, lastWeight = 0.0f;
+
+        std::vector<int> eventosPorCambio(N_CAMBIOS_BENCH, 0);
+        for(uint32_t tm = 0; tm < finReposo; tm += BENCH_PERIODO_MS)
+        {
+            // En reposo se deja el recipiente otra vez para medir los falsos con peso encima
+            float real = (tm < finGuion) ? pesoRealBench(cambios, tm, oscilacion ? BENCH_OSCILACION : 0.0f) : 300.0f;
+            long raw = lround(BENCH_OFFSET + real * BENCH_FACTOR + ruido(generador));
+            if(tm == finGuion){ newWeight = 300.0f; } // El salto al reposo no es un evento del guion
+
+            auto t0 = std::chrono::steady_clock::now();
+            #if defined(__x86_64__) || defined(__i386__)
+                unsigned long long c0 = __rdtsc();
+            #endif
+            bool estable = filtrarMuestra(raw);
+            cambio_peso_t cambio = CAMBIO_NINGUNO;
+            if(estable)
+            {
+                lastWeight = newWeight;
+                newWeight = (salidaFiltro - scale.get_offset()) / scale.get_scale();
+                cambio = clasificarCambioPeso(lastWeight, newWeight, 0.0f);
+            }
+            #if defined(__x86_64__) || defined(__i386__)
+                ciclosFiltro += __rdtsc() - c0;
+            #endif
+            nsFiltro += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            muestras++;
+
+            if(cambio == CAMBIO_NINGUNO) continue;
+            if(tm >= finGuion){ if(tm > finGuion + 2000) falsosReposo++; continue; } // Los 2 primeros segundos se asienta el salto al reposo
+
+            // Cambio del guion al que corresponde: el último que ha empezado
+            int i = -1;
+            for(byte k = 0; k < N_CAMBIOS_BENCH; k++) if(cambios[k].inicio <= tm) i = k;
+            if(i < 0){ falsos++; continue; }
+
+            const cambioReal_t &c = cambios[i];
+            bool sentido = (c.hasta > c.desde) ? (cambio == CAMBIO_INCREMENTO) : (cambio != CAMBIO_INCREMENTO);
+            if(c.golpe or !sentido or (eventosPorCambio[i] > 0)){ falsos++; continue; }
+
+            eventosPorCambio[i]++;
+            detectados++;
+            double latencia = (double)tm - (double)c.fin;
+            sumaLatencia += latencia;
+            if(latencia > maxLatencia) maxLatencia = latencia;
+            double error = fabs(newWeight - c.hasta); // Peso con el que se queda el evento (alimento o recipiente)
+            if(error > maxError) maxError = error;
+        }
+        for(byte k = 0; k < N_CAMBIOS_BENCH; k++) if(!cambios[k].golpe and (eventosPorCambio[k] == 0)) perdidos++;
+    }
+
+    double horasReposo = repeticiones * BENCH_REPOSO_MIN / 60.0;
+    printf("%6.2f g   %9.0f  %9.0f   %9.2f   %6d   %7d   %10.1f   %8.0f", ruidoG, detectados ? sumaLatencia / detectados : 0.0,
+            maxLatencia, maxError, falsos, perdidos, falsosReposo / horasReposo, nsFiltro / muestras);
+    #if defined(__x86_64__) || defined(__i386__)
+        printf("   %8.0f", (double)ciclosFiltro / muestras);
+    #endif
+    printf("\n");
+
+    return falsos + perdidos + falsosReposo;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Banco de pruebas del filtro con varios niveles de ruido.
+ * @return Eventos falsos + perdidos en total
+ */
+/*-----------------------------------------------------------------------------*/
+int bench(int repeticiones)
+{
+    printf("Filtro: mediana %d, EMA 1/%d, ventana %d, desviacion %.2f g, acuerdo con la EMA %.2f g\n",
+            FILTRO_MEDIANA_N, 1 << FILTRO_EMA_SHIFT, FILTRO_ESTABLE_VENTANA, FILTRO_ESTABLE_DESVIACION, FILTRO_ESTABLE_ACUERDO);
+    printf("%d repeticiones de %d cambios a %d SPS. Latencia desde que el peso real llega al final\n",
+            repeticiones, N_CAMBIOS_BENCH, 1000 / BENCH_PERIODO_MS);
+
+    int errores = 0;
+    const float ruidos[] = { 0.02f, 0.1f, 0.2f, 0.3f, 0.5f };
+    for(byte oscilacion = 0; oscilacion < 2; oscilacion++)
+    {
+        printf("\n%s\n", oscilacion ? "Con oscilacion del plato al asentarse:" : "Sin oscilacion:");
+        printf(" ruido   lat.media  lat.max(ms)  error.max(g)  falsos  perdidos  falsos/hora  ns/muestra");
+        #if defined(__x86_64__) || defined(__i386__)
+            printf("  ciclos/muestra");
+        #endif
+        printf("\n");
+        for(float r : ruidos) errores += benchRuido(r, oscilacion, repeticiones);
+    }
+    return errores;
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    if((argc >= 2) and (strcmp(argv[1], "bench") == 0))
+    {
+        int repeticiones = (argc >= 3) ? atoi(argv[2]) : 20;
+        return bench(repeticiones > 0 ? repeticiones : 20) ? 1 : 0;
+    }
+
+    if(argc != 3)
+    {
+        fprintf(stderr, "Uso: %s decode|replay|csv <traza.trc>\n       %s bench [repeticiones]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    cabeceraTraza_t cabecera;
+    std::vector<registroTraza_t> registros;
+    if(!leerTraza(argv[2], cabecera, registros)) return 2;
+
+    if(strcmp(argv[1], "decode") == 0)
+    {
+        printf("Sesiones: %u   Vueltas: %u   Sectores: %u/%u   Registros: %u\n\n", cabecera.sesiones, cabecera.vueltas,
+                cabecera.vueltas ? cabecera.nSectores : cabecera.sectorSiguiente, cabecera.nSectores, (unsigned)registros.size());
+        decode(registros);
+    }
+    else if(strcmp(argv[1], "csv") == 0) csv(registros);
+    else if(strcmp(argv[1], "replay") == 0) return replay(registros) ? 1 : 0;
+    else
+    {
+        fprintf(stderr, "Comando desconocido: %s\n", argv[1]);
+        return 2;
+    }
+
+    return 0;
+}
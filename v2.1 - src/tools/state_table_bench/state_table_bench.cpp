@@ -0,0 +1,178 @@
+/**
+ * @file state_table_bench.cpp
+ * @brief Herramienta de PC que compara la búsqueda lineal de reglas con la tabla de transiciones
+ *
+ * @author Irene Casares Rodríguez
+ * @date 18/10/26
+ * @version 1.0
+ *
+ * Compilar desde esta carpeta (usa la configuración de debug.h, p. ej. BORRADO_INFO_USUARIO):
+ *
+ *      g++ -std=c++11 -O2 -I"../../smartcloth_v2" -o state_table_bench state_table_bench.cpp
+ *
+ * Uso:
+ *
+ *      state_table_bench [eventos.txt] [repeticiones]
+ *
+ * 'eventos.txt' es una secuencia de eventos (número de event_t, uno por línea o separados
+ * por espacios), por ejemplo sacada del log de SM_DEBUG de una comida real. Sin fichero,
+ * se genera una secuencia aleatoria recorriendo la máquina de estados: la mayoría de los
+ * eventos son válidos en el estado actual y algunos no (errores de evento).
+ *
+ * Primero se comprueba que la tabla da el mismo resultado que la búsqueda lineal para
+ * todas las parejas estado/evento, y después se mide el tiempo de las dos sobre la secuencia.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <chrono>
+
+typedef uint8_t byte;
+
+#include "State_Transitions.h"
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Búsqueda lineal de la versión anterior de checkStateConditions().
+ * @return Estado siguiente o SIN_TRANSICION
+ */
+/*-----------------------------------------------------------------------------*/
+byte buscarTransicionLineal(state_t estado, event_t evento)
+{
+    for(unsigned i = 0; i < RULES; i++)
+    {
+        if((rules[i].state_i == estado) and (rules[i].condition == evento)) return rules[i].state_j;
+    }
+    return SIN_TRANSICION;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Genera una secuencia de eventos recorriendo la máquina de estados desde STATE_Init.
+ *        Un 90% de los eventos tiene regla en el estado actual.
+ */
+/*-----------------------------------------------------------------------------*/
+std::vector<event_t> generarEventos(size_t n)
+{
+    std::vector<event_t> eventos;
+    srand(1234);
+    state_t estado = STATE_Init;
+
+    while(eventos.size() < n)
+    {
+        event_t evento;
+        if((rand() % 10) != 0)
+        {
+            std::vector<unsigned> validas;
+            for(unsigned i = 0; i < RULES; i++) if(rules[i].state_i == estado) validas.push_back(i);
+            evento = rules[validas[rand() % validas.size()]].condition;
+        }
+        else evento = (event_t)(1 + rand() % (NUM_EVENTOS - 1));
+
+        eventos.push_back(evento);
+        byte siguiente = buscarTransicionLineal(estado, evento);
+        if(siguiente != SIN_TRANSICION) estado = (state_t)siguiente;
+    }
+    return eventos;
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Lee una secuencia de eventos (números de event_t) de un fichero.
+ */
+/*-----------------------------------------------------------------------------*/
+bool leerEventos(const char *ruta, std::vector<event_t> &eventos)
+{
+    FILE *f = fopen(ruta, "r");
+    if(!f){ fprintf(stderr, "No se puede abrir %s\n", ruta); return false; }
+
+    int evento;
+    while(fscanf(f, "%d", &evento) == 1)
+    {
+        if((evento < 0) or (evento >= NUM_EVENTOS)){ fprintf(stderr, "Evento fuera de rango: %d\n", evento); fclose(f); return false; }
+        eventos.push_back((event_t)evento);
+    }
+    fclose(f);
+    return !eventos.empty();
+}
+
+
+
+/*-----------------------------------------------------------------------------*/
+/**
+ * @brief Recorre la secuencia de eventos con la función de búsqueda dada.
+ * @return Número de errores de evento (sirve también para que el compilador no elimine el bucle)
+ */
+/*-----------------------------------------------------------------------------*/
+template<byte (*buscar)(state_t, event_t)>
+unsigned recorrer(const std::vector<event_t> &eventos, unsigned repeticiones, double &nsPorEvento)
+{
+    unsigned errores = 0;
+    auto inicio = std::chrono::steady_clock::now();
+
+    for(unsigned r = 0; r < repeticiones; r++)
+    {
+        state_t estado = STATE_Init;
+        for(event_t evento : eventos)
+        {
+            byte siguiente = buscar(estado, evento);
+            if(siguiente == SIN_TRANSICION) errores++;
+            else estado = (state_t)siguiente;
+        }
+    }
+
+    auto fin = std::chrono::steady_clock::now();
+    nsPorEvento = std::chrono::duration<double, std::nano>(fin - inicio).count() / ((double)eventos.size() * repeticiones);
+    return errores;
+}
+
+
+
+
+int main(int argc, char *argv[])
+{
+    // ---- Comprobación completa: tabla == búsqueda lineal ----
+    unsigned diferencias = 0, celdas = 0;
+    for(unsigned s = 0; s < NUM_ESTADOS; s++)
+    {
+        for(unsigned e = 0; e < NUM_EVENTOS; e++)
+        {
+            if(buscarTransicion((state_t)s, (event_t)e) != buscarTransicionLineal((state_t)s, (event_t)e))
+            {
+                printf("Diferencia en estado %u, evento %u\n", s, e);
+                diferencias++;
+            }
+            if(buscarTransicion((state_t)s, (event_t)e) != SIN_TRANSICION) celdas++;
+        }
+    }
+    printf("Reglas: %u   Tabla: %u x %u (%u bytes, %u celdas con regla)   Diferencias: %u\n",
+            RULES, NUM_ESTADOS, NUM_EVENTOS, (unsigned)sizeof(tablaTransiciones), celdas, diferencias);
+    if(diferencias) return 1;
+
+
+    // ---- Secuencia de eventos ----
+    std::vector<event_t> eventos;
+    if(argc > 1){ if(!leerEventos(argv[1], eventos)) return 2; }
+    else eventos = generarEventos(10000);
+    unsigned repeticiones = (argc > 2) ? atoi(argv[2]) : 1000;
+
+
+    // ---- Tiempos ----
+    double nsLineal, nsTabla;
+    unsigned erroresLineal = recorrer<buscarTransicionLineal>(eventos, repeticiones, nsLineal);
+    unsigned erroresTabla  = recorrer<buscarTransicion>(eventos, repeticiones, nsTabla);
+
+    printf("Eventos: %u x %u repeticiones\n", (unsigned)eventos.size(), repeticiones);
+    printf("Busqueda lineal: %8.2f ns/evento   (%u errores de evento)\n", nsLineal, erroresLineal);
+    printf("Tabla:           %8.2f ns/evento   (%u errores de evento)\n", nsTabla, erroresTabla);
+    printf("Mejora: x%.1f\n", nsLineal / nsTabla);
+
+    return (erroresLineal != erroresTabla) ? 1 : 0;
+}